@@ -6,6 +6,11 @@
 #define CS_KRYL    100
 #define CS_KRY1    CS_KRYL*(CS_KRYL+3) / 2
 #define CS_OMEGA   1.2   /* >1 to speed up convergence of slow-converging process */
+#define CS_AMGLEV  12    /* max number of multigrid levels */
+#define CS_AMGCRS  400   /* size of the coarsest level */
+#define CS_AMGMAX  1500  /* max size for a direct solve on the coarsest level */
+#define CS_AMGTH   0.08  /* threshold for strong connections */
+#define CS_AMGNU   1     /* number of smoothing iterations */
 
 
 /* SSOR preconditioner to solve (L*d*L^t)x = b
@@ -291,16 +296,625 @@ int csrConjGradGen(pCsr A,double *x,double *b,double *ud,char *udt,char nohom,do
 }
 
 
+/* incomplete Cholesky factorization A + alpha.diag(A) = U^t.U with the
+ * pattern of A; alpha is increased until all pivots are positive
+ * input:  A upper triangular (CS_SYM), diag term first in each row
+ * output: U, same structure as A  */
+static pCsr csrIC0(pCsr A) {
+  pCsr     U;
+  double   dd,uki,alpha;
+  int     *w,i,j,k,l,m;
+
+  U = (Csr*)calloc(1,sizeof(Csr));
+  assert(U);
+  U->typ = A->typ;
+  U->nr  = A->nr;
+  U->nc  = A->nc;
+  U->nbe = U->nmax = A->row[A->nr];
+  U->row = (int*)malloc((U->nr+1)*sizeof(int));
+  U->col = (int*)malloc(U->nbe*sizeof(int));
+  U->val = (double*)malloc(U->nbe*sizeof(double));
+  w      = (int*)malloc(U->nc*sizeof(int));
+  assert(U->row);
+  assert(U->col);
+  assert(U->val);
+  assert(w);
+  memcpy(U->row,A->row,(U->nr+1)*sizeof(int));
+  memcpy(U->col,A->col,U->nbe*sizeof(int));
+  for (i=0; i<U->nc; i++)  w[i] = -1;
+
+  alpha = 0.0;
+  do {
+    memcpy(U->val,A->val,U->nbe*sizeof(double));
+    for (k=0; k<U->nr; k++) {
+      dd = U->val[U->row[k]] + alpha * A->val[A->row[k]];
+      if ( fabs(A->val[A->row[k]]) < CS_EPSD2 ) {
+        U->val[U->row[k]] = 1.0;
+        for (j=U->row[k]+1; j<U->row[k+1]; j++)  U->val[j] = 0.0;
+        continue;
+      }
+      /* breakdown: shift the diagonal and restart */
+      if ( dd <= CS_EPSD * fabs(A->val[A->row[k]]) )  break;
+      dd = sqrt(dd);
+      U->val[U->row[k]] = dd;
+      for (j=U->row[k]+1; j<U->row[k+1]; j++)
+        U->val[j] /= dd;
+
+      /* update rows i > k: u_ij -= u_ki.u_kj, for (i,j) in the pattern */
+      for (j=U->row[k]+1; j<U->row[k+1]; j++) {
+        i   = U->col[j];
+        uki = U->val[j];
+        for (l=U->row[i]; l<U->row[i+1]; l++)  w[U->col[l]] = l;
+        for (l=j; l<U->row[k+1]; l++) {
+          m = w[U->col[l]];
+          if ( m >= 0 )  U->val[m] -= uki * U->val[l];
+        }
+        for (l=U->row[i]; l<U->row[i+1]; l++)  w[U->col[l]] = -1;
+      }
+    }
+    if ( k < U->nr )  alpha = alpha > 0.0 ? 2.0*alpha : 1.e-3;
+  }
+  while ( k < U->nr );
+  free(w);
+
+  return(U);
+}
+
+/* solve (U^t.U)x = b, U incomplete factor */
+static void csrIC0Solve(pCsr U,double *x,double *b) {
+  double   sum;
+  int      i,j;
+
+  /* U^t.y = b */
+  memcpy(x,b,U->nr*sizeof(double));
+  for (i=0; i<U->nr; i++) {
+    x[i] /= U->val[U->row[i]];
+    for (j=U->row[i]+1; j<U->row[i+1]; j++)
+      x[U->col[j]] -= U->val[j] * x[i];
+  }
+  /* U.x = y */
+  for (i=U->nr-1; i>=0; i--) {
+    sum = x[i];
+    for (j=U->row[i]+1; j<U->row[i+1]; j++)
+      sum -= U->val[j] * x[U->col[j]];
+    x[i] = sum / U->val[U->row[i]];
+  }
+}
+
+
+/* smoothed aggregation multigrid: one level of the hierarchy */
+typedef struct {
+  pCsr     A,P,R;     /* operator, prolongation, restriction */
+  double  *dia,*x,*b,*r;
+  int      n;
+} CsLev;
+
+typedef struct {
+  CsLev    lev[CS_AMGLEV];
+  double  *crs;       /* dense Cholesky factor on the coarsest level */
+  int      nlev;
+} CsAmg;
+typedef CsAmg * pCsAmg;
+
+/* C = A.B (Gustavson), general storage */
+static pCsr csrProd(pCsr A,pCsr B) {
+  pCsr     C;
+  double   aij;
+  int     *w,i,j,k,l,nbe;
+
+  w = (int*)malloc(B->nc*sizeof(int));
+  assert(w);
+  for (i=0; i<B->nc; i++)  w[i] = -1;
+
+  /* count number of entries */
+  nbe = 0;
+  for (i=0; i<A->nr; i++) {
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k = A->col[j];
+      for (l=B->row[k]; l<B->row[k+1]; l++) {
+        if ( w[B->col[l]] < i ) {
+          w[B->col[l]] = i;
+          nbe++;
+        }
+      }
+    }
+  }
+  C = (Csr*)calloc(1,sizeof(Csr));
+  assert(C);
+  C->nr  = A->nr;
+  C->nc  = B->nc;
+  C->nbe = C->nmax = nbe;
+  C->row = (int*)malloc((C->nr+1)*sizeof(int));
+  C->col = (int*)malloc(CS_MAX(nbe,1)*sizeof(int));
+  C->val = (double*)malloc(CS_MAX(nbe,1)*sizeof(double));
+  assert(C->row);
+  assert(C->col);
+  assert(C->val);
+
+  /* store entries: w = position in row */
+  for (i=0; i<B->nc; i++)  w[i] = -1;
+  nbe = 0;
+  for (i=0; i<A->nr; i++) {
+    C->row[i] = nbe;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k   = A->col[j];
+      aij = A->val[j];
+      for (l=B->row[k]; l<B->row[k+1]; l++) {
+        if ( w[B->col[l]] < C->row[i] ) {
+          w[B->col[l]] = nbe;
+          C->col[nbe]  = B->col[l];
+          C->val[nbe]  = aij * B->val[l];
+          nbe++;
+        }
+        else
+          C->val[w[B->col[l]]] += aij * B->val[l];
+      }
+    }
+  }
+  C->row[C->nr] = nbe;
+  free(w);
+
+  return(C);
+}
+
+/* diagonal terms of A */
+static void csrDiag(pCsr A,double *dia) {
+  int      i,j;
+
+  for (i=0; i<A->nr; i++) {
+    dia[i] = 0.0;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      if ( A->col[j] == i ) {
+        dia[i] = A->val[j];
+        break;
+      }
+    }
+    if ( fabs(dia[i]) < CS_EPSD2 )  dia[i] = 1.0;
+  }
+}
+
+/* aggregation of the strongly connected unknowns:
+   |a_ij| > theta.sqrt(|a_ii.a_jj|). Return the number of aggregates */
+static int csrAggreg(pCsr A,double *dia,int *agg) {
+  double   th2;
+  int      i,j,k,nc;
+  char     ok;
+
+  th2 = CS_AMGTH * CS_AMGTH;
+  for (i=0; i<A->nr; i++)  agg[i] = -1;
+
+  /* pass 1: unknowns whose strong neighbors are all free */
+  nc = 0;
+  for (i=0; i<A->nr; i++) {
+    if ( agg[i] != -1 )  continue;
+    ok = 0;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k = A->col[j];
+      if ( k == i || A->val[j]*A->val[j] <= th2*fabs(dia[i]*dia[k]) )  continue;
+      if ( agg[k] != -1 )  break;
+      ok = 1;
+    }
+    if ( !ok || j < A->row[i+1] )  continue;
+    agg[i] = nc;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k = A->col[j];
+      if ( k != i && A->val[j]*A->val[j] > th2*fabs(dia[i]*dia[k]) )  agg[k] = nc;
+    }
+    nc++;
+  }
+
+  /* pass 2: join a neighboring aggregate (encoded -2-agg) */
+  for (i=0; i<A->nr; i++) {
+    if ( agg[i] != -1 )  continue;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k = A->col[j];
+      if ( k == i || agg[k] < 0 )  continue;
+      if ( A->val[j]*A->val[j] > th2*fabs(dia[i]*dia[k]) ) {
+        agg[i] = -2 - agg[k];
+        break;
+      }
+    }
+  }
+
+  /* pass 3: new aggregates with the remaining free neighbors */
+  for (i=0; i<A->nr; i++) {
+    if ( agg[i] != -1 )  continue;
+    ok = 0;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k = A->col[j];
+      if ( k == i || agg[k] != -1 )  continue;
+      if ( A->val[j]*A->val[j] > th2*fabs(dia[i]*dia[k]) ) {
+        agg[k] = nc;
+        ok = 1;
+      }
+    }
+    if ( ok )  agg[i] = nc++;
+  }
+  for (i=0; i<A->nr; i++)
+    if ( agg[i] < -1 )  agg[i] = -2 - agg[i];
+
+  return(nc);
+}
+
+/* spectral radius of D^-1.A, power iterations */
+static double csrRadius(pCsr A,double *dia) {
+  double  *x,*y,nn,rho;
+  int      i,it;
+
+  x = (double*)malloc(A->nr*sizeof(double));
+  y = (double*)malloc(A->nr*sizeof(double));
+  assert(x);
+  assert(y);
+  for (i=0; i<A->nr; i++)  x[i] = 1.0 + (double)(i % 7) / 7.0;
+  nn  = sqrt(csrXY(x,x,A->nr));
+  rho = 1.0;
+  for (it=0; it<15; it++) {
+    csrlX(x,x,1.0/nn,A->nr);
+    csrAx(A,x,y);
+    for (i=0; i<A->nr; i++)  x[i] = y[i] / dia[i];
+    nn = sqrt(csrXY(x,x,A->nr));
+    if ( nn < CS_EPSD2 )  break;
+    rho = nn;
+  }
+  free(x);
+  free(y);
+
+  return(rho);
+}
+
+/* smoothed prolongation P = (I - omega/rho D^-1.A).Pt, Pt tentative:
+   nc aggregates of nodes with bs unknowns each */
+static pCsr csrProlong(pCsr A,double *dia,double rho,int *agg,int nc,int bs) {
+  pCsr     Pt,P;
+  double   dd;
+  int     *siz,i,j,ic,nbe;
+
+  siz = (int*)calloc(nc,sizeof(int));
+  assert(siz);
+  nbe = 0;
+  for (i=0; i<A->nr; i++) {
+    if ( agg[i/bs] < 0 )  continue;
+    if ( i % bs == 0 )  siz[agg[i/bs]]++;
+    nbe++;
+  }
+
+  /* tentative: piecewise constant on aggregates, per component */
+  Pt = (Csr*)calloc(1,sizeof(Csr));
+  assert(Pt);
+  Pt->nr  = A->nr;
+  Pt->nc  = nc*bs;
+  Pt->nbe = Pt->nmax = nbe;
+  Pt->row = (int*)malloc((Pt->nr+1)*sizeof(int));
+  Pt->col = (int*)malloc(CS_MAX(nbe,1)*sizeof(int));
+  Pt->val = (double*)malloc(CS_MAX(nbe,1)*sizeof(double));
+  assert(Pt->row);
+  assert(Pt->col);
+  assert(Pt->val);
+  nbe = 0;
+  for (i=0; i<A->nr; i++) {
+    Pt->row[i] = nbe;
+    if ( agg[i/bs] < 0 )  continue;
+    Pt->col[nbe] = bs*agg[i/bs] + i % bs;
+    Pt->val[nbe] = 1.0 / sqrt((double)siz[agg[i/bs]]);
+    nbe++;
+  }
+  Pt->row[Pt->nr] = nbe;
+  free(siz);
+
+  /* A.Pt holds the pattern of Pt, since a_ii != 0 */
+  P = csrProd(A,Pt);
+  for (i=0; i<P->nr; i++) {
+    dd = 4.0 / (3.0 * rho * dia[i]);
+    ic = agg[i/bs] >= 0 ? bs*agg[i/bs] + i % bs : -1;
+    for (j=P->row[i]; j<P->row[i+1]; j++) {
+      P->val[j] *= -dd;
+      if ( P->col[j] == ic )  P->val[j] += Pt->val[Pt->row[i]];
+    }
+  }
+  csrFree(Pt);
+
+  return(P);
+}
+
+/* graph of the nodes (bs unknowns each): n_IJ = |A_IJ| Frobenius norm */
+static pCsr csrNodes(pCsr A,int bs) {
+  pCsr     N;
+  int     *w,i,j,k,ic,nn,nbe;
+
+  nn = A->nr / bs;
+  w  = (int*)malloc(nn*sizeof(int));
+  assert(w);
+  for (i=0; i<nn; i++)  w[i] = -1;
+  nbe = 0;
+  for (i=0; i<nn; i++) {
+    for (k=bs*i; k<bs*(i+1); k++) {
+      for (j=A->row[k]; j<A->row[k+1]; j++) {
+        ic = A->col[j] / bs;
+        if ( w[ic] < i ) {
+          w[ic] = i;
+          nbe++;
+        }
+      }
+    }
+  }
+  N = (Csr*)calloc(1,sizeof(Csr));
+  assert(N);
+  N->nr  = N->nc = nn;
+  N->nbe = N->nmax = nbe;
+  N->row = (int*)malloc((nn+1)*sizeof(int));
+  N->col = (int*)malloc(CS_MAX(nbe,1)*sizeof(int));
+  N->val = (double*)malloc(CS_MAX(nbe,1)*sizeof(double));
+  assert(N->row);
+  assert(N->col);
+  assert(N->val);
+
+  for (i=0; i<nn; i++)  w[i] = -1;
+  nbe = 0;
+  for (i=0; i<nn; i++) {
+    N->row[i] = nbe;
+    for (k=bs*i; k<bs*(i+1); k++) {
+      for (j=A->row[k]; j<A->row[k+1]; j++) {
+        ic = A->col[j] / bs;
+        if ( w[ic] < N->row[i] ) {
+          w[ic] = nbe;
+          N->col[nbe] = ic;
+          N->val[nbe] = 0.0;
+          nbe++;
+        }
+        N->val[w[ic]] += A->val[j] * A->val[j];
+      }
+    }
+  }
+  N->row[nn] = nbe;
+  for (j=0; j<nbe; j++)  N->val[j] = sqrt(N->val[j]);
+  free(w);
+
+  return(N);
+}
+
+/* dense Cholesky factorization of the coarsest operator */
+static double *csrDense(pCsr A) {
+  double  *L,dd;
+  int      i,j,k,n;
+
+  n = A->nr;
+  L = (double*)calloc(n*n,sizeof(double));
+  assert(L);
+  for (i=0; i<n; i++)
+    for (j=A->row[i]; j<A->row[i+1]; j++)
+      L[i*n+A->col[j]] = A->val[j];
+
+  for (k=0; k<n; k++) {
+    dd = L[k*n+k];
+    for (j=0; j<k; j++)  dd -= L[k*n+j] * L[k*n+j];
+    /* singular mode: decoupled */
+    if ( dd <= CS_EPSD * fabs(L[k*n+k]) || dd < CS_EPSD2 ) {
+      for (j=0; j<k; j++)  L[k*n+j] = 0.0;
+      for (i=k+1; i<n; i++)  L[i*n+k] = 0.0;
+      L[k*n+k] = 0.0;
+      continue;
+    }
+    L[k*n+k] = dd = sqrt(dd);
+    for (i=k+1; i<n; i++) {
+      for (j=0; j<k; j++)  L[i*n+k] -= L[i*n+j] * L[k*n+j];
+      L[i*n+k] /= dd;
+    }
+  }
+
+  return(L);
+}
+
+static void csrDenseSolve(double *L,int n,double *x,double *b) {
+  double   sum;
+  int      i,j;
+
+  for (i=0; i<n; i++) {
+    if ( L[i*n+i] == 0.0 ) {
+      x[i] = 0.0;
+      continue;
+    }
+    sum = b[i];
+    for (j=0; j<i; j++)  sum -= L[i*n+j] * x[j];
+    x[i] = sum / L[i*n+i];
+  }
+  for (i=n-1; i>=0; i--) {
+    if ( L[i*n+i] == 0.0 )  continue;
+    sum = x[i];
+    for (j=i+1; j<n; j++)  sum -= L[j*n+i] * x[j];
+    x[i] = sum / L[i*n+i];
+  }
+}
+
+static void csrAmgFree(pCsAmg amg) {
+  CsLev   *pl;
+  int      l;
+
+  for (l=0; l<amg->nlev; l++) {
+    pl = &amg->lev[l];
+    if ( l > 0 ) {
+      csrFree(pl->A);
+      free(pl->x);
+      free(pl->b);
+    }
+    if ( pl->P )  csrFree(pl->P);
+    if ( pl->R )  csrFree(pl->R);
+    free(pl->dia);
+    free(pl->r);
+  }
+  free(amg->crs);
+  free(amg);
+}
+
+/* build the hierarchy of the aggregation multigrid, bs unknowns per node */
+static pCsAmg csrAmg(pCsr A,int bs) {
+  pCsAmg   amg;
+  CsLev   *pl,*pn;
+  pCsr     F,N,AP;
+  double  *ndia,rho;
+  int     *agg,i,l,nc;
+
+  amg = (CsAmg*)calloc(1,sizeof(CsAmg));
+  assert(amg);
+  if ( bs < 1 || A->nr % bs )  bs = 1;
+  pl = &amg->lev[0];
+  pl->A = A;
+  pl->n = A->nr;
+
+  for (l=0; l<CS_AMGLEV; l++) {
+    pl = &amg->lev[l];
+    amg->nlev = l+1;
+    F = ( pl->A->typ & CS_SYM ) ? csrFull(pl->A) : pl->A;
+    pl->dia = (double*)malloc(pl->n*sizeof(double));
+    pl->r   = (double*)malloc(pl->n*sizeof(double));
+    assert(pl->dia);
+    assert(pl->r);
+    csrDiag(F,pl->dia);
+    rho = csrRadius(F,pl->dia);
+    if ( pl->n <= CS_AMGCRS || l == CS_AMGLEV-1 )  break;
+
+    /* aggregation of the nodes */
+    N    = bs > 1 ? csrNodes(F,bs) : F;
+    ndia = (double*)malloc(N->nr*sizeof(double));
+    agg  = (int*)malloc(N->nr*sizeof(int));
+    assert(ndia);
+    assert(agg);
+    csrDiag(N,ndia);
+    nc = csrAggreg(N,ndia,agg);
+    if ( N != F )  csrFree(N);
+    free(ndia);
+
+    /* too slow coarsening: stop here */
+    if ( nc == 0 || nc*bs > 0.8*pl->n ) {
+      free(agg);
+      break;
+    }
+    pl->P = csrProlong(F,pl->dia,rho,agg,nc,bs);
+    pl->R = csrTr(pl->P);
+    free(agg);
+
+    /* Galerkin coarse operator R.A.P */
+    AP = csrProd(F,pl->P);
+    pn = &amg->lev[l+1];
+    pn->A = csrProd(pl->R,AP);
+    pn->n = nc*bs;
+    pn->x = (double*)malloc(pn->n*sizeof(double));
+    pn->b = (double*)malloc(pn->n*sizeof(double));
+    assert(pn->x);
+    assert(pn->b);
+    csrFree(AP);
+    if ( F != pl->A )  csrFree(F);
+
+    /* omega.D^-1 for the Jacobi smoother */
+    for (i=0; i<pl->n; i++)  pl->dia[i] = 4.0 / (3.0 * rho * pl->dia[i]);
+  }
+
+  /* coarsest level: direct solve if small enough, smoother otherwise */
+  if ( pl->n <= CS_AMGMAX )  amg->crs = csrDense(F);
+  if ( F != pl->A )  csrFree(F);
+  for (i=0; i<pl->n; i++)  pl->dia[i] = 4.0 / (3.0 * rho * pl->dia[i]);
+
+  return(amg);
+}
+
+/* V-cycle: x = M^-1.b at level l, x0 = 0 */
+static void csrVcycle(pCsAmg amg,int l) {
+  CsLev   *pl,*pn;
+  int      k;
+
+  pl = &amg->lev[l];
+  if ( l == amg->nlev-1 && amg->crs ) {
+    csrDenseSolve(amg->crs,pl->n,pl->x,pl->b);
+    return;
+  }
+
+  /* pre-smoothing: damped Jacobi */
+  memset(pl->x,0,pl->n*sizeof(double));
+  csrDxpy(pl->dia,pl->b,pl->x,pl->n);
+  for (k=1; k<CS_AMGNU; k++) {
+    csrAxpy(pl->A,pl->x,pl->b,pl->r,-1.,1.);
+    csrDxpy(pl->dia,pl->r,pl->x,pl->n);
+  }
+  if ( l == amg->nlev-1 )  return;
+
+  /* coarse grid correction */
+  pn = &amg->lev[l+1];
+  csrAxpy(pl->A,pl->x,pl->b,pl->r,-1.,1.);
+  csrAx(pl->R,pl->r,pn->b);
+  csrVcycle(amg,l+1);
+  csrAxpy(pl->P,pn->x,pl->x,pl->x,1.,1.);
+
+  /* post-smoothing */
+  for (k=0; k<CS_AMGNU; k++) {
+    csrAxpy(pl->A,pl->x,pl->b,pl->r,-1.,1.);
+    csrDxpy(pl->dia,pl->r,pl->x,pl->n);
+  }
+}
+
+
+/* preconditioner of the conjugate gradient */
+typedef struct {
+  pCsr     L;         /* A^t (SSOR) or incomplete factor (IC0) */
+  pCsAmg   amg;
+  char     typ;
+} CsPrec;
+
+static void csrPrecNew(pCsr A,CsPrec *pc,char typ,int bs) {
+  memset(pc,0,sizeof(CsPrec));
+  /* IC(0) needs the upper part, diagonal first */
+  if ( typ == CS_IC0 && !(A->typ & CS_SYM) )  typ = CS_SSOR;
+  pc->typ = typ;
+  switch(typ) {
+  case CS_IC0:
+    pc->L = csrIC0(A);
+    break;
+  case CS_AMG:
+    pc->amg = csrAmg(A,bs);
+    break;
+  default:
+    pc->L = csrTr(A);
+    break;
+  }
+}
+
+/* x = M^-1.b */
+static void csrPrecSolve(pCsr A,CsPrec *pc,double *x,double *b) {
+  switch(pc->typ) {
+  case CS_IC0:
+    csrIC0Solve(pc->L,x,b);
+    break;
+  case CS_AMG:
+    pc->amg->lev[0].x = x;
+    pc->amg->lev[0].b = b;
+    csrVcycle(pc->amg,0);
+    break;
+  default:
+    csrSSOR(A,pc->L,x,b);
+    break;
+  }
+}
+
+static void csrPrecFree(CsPrec *pc) {
+  if ( pc->L )    csrFree(pc->L);
+  if ( pc->amg )  csrAmgFree(pc->amg);
+}
+
 /* solve Ax = b using preconditionned conjugate gradient method. Return code:
   >0 upon completion, <0 no convergence
   0 memory problem 
  -1 ill conditioned matrix
  -2 max it reached  */
 int csrPrecondGrad(pCsr A,double *x,double *b,double *er,int *ni,char tgv) {
-  pCsr      L;
-  double   *ap,*p,*q,*y;
+  return(csrPCG(A,x,b,er,ni,tgv,CS_SSOR,1));
+}
+
+/* same with preconditioner prec: CS_SSOR, CS_IC0 (incomplete Cholesky) or
+   CS_AMG (smoothed aggregation multigrid, V-cycle, with bs interleaved
+   unknowns per node, e.g. the components of a displacement) */
+int csrPCG(pCsr A,double *x,double *b,double *er,int *ni,char tgv,char prec,int bs) {
+  CsPrec    pc;
+  double   *ap,*p,*q,*y,*xs;
   double    dp,nn,rmp,rm,rm2,alpha,beta,err;
-  int       n,it,ier,nit;
+  int       n,it,ier,nit,nref;
 
   /* allocation */
   if ( !x || !b )  return(0);
@@ -333,49 +947,73 @@ int csrPrecondGrad(pCsr A,double *x,double *b,double *er,int *ni,char tgv) {
   assert(p);
   assert(q);
   assert(ap);
+  xs = 0;
+  if ( csrMixed(A) ) {
+    xs = (double*)calloc(A->nr,sizeof(double));
+    assert(xs);
+  }
 
-  /* incomplete SSOR factorization */
-  L = csrTr(A);
-  csrSSOR(A,L,p,y);
+  /* incomplete factorization */
+  csrPrecNew(A,&pc,prec,bs);
+  csrPrecSolve(A,&pc,p,y);
 
   err = *er;
   err = err * err * rmp;
   nit = *ni;
-  ier = 1;
-  it  = 0;
-  rm  = rmp;
-  while ( (err < rm) && ++it <= nit ) {
-    /* alpha_m = <P^-1.R_m-1,R_m-1> / <AP_m,P_m> */
+  ier  = 1;
+  it   = 0;
+  nref = 0;
+  rm   = rmp;
+  do {
+    while ( (err < rm) && ++it <= nit ) {
+      /* alpha_m = <P^-1.R_m-1,R_m-1> / <AP_m,P_m> */
+      rm = csrXY(p,y,n);
+
+      if ( fabs(rm) <= CS_EPSD2 )  break;
+      dp = csrAxdotx(A,p,ap);
+      if ( fabs(dp) <= CS_EPSD2 )  break;
+
+      /* X_m = X_m-1 + alpha_m.P_m , R_m = R_m-1 - alpha_m AP_m */ 
+      alpha = (rm / dp);
+      csrlXmY(p,x,x,alpha,1.0,n);
+      csrlXmY(ap,y,y,-alpha,1.0,n);
+
+      /* beta_m = <P^-1.R_m,R_m> / <P^-1.R_m-1,R_m-1> */
+      csrPrecSolve(A,&pc,q,y);
+      rm2 = csrXY(q,y,n);
+      if ( fabs(rm2) <= CS_EPSD2 )  break;
+
+      /* P_m+1 = P^-1.R_m + beta_m P_m */
+      beta = rm2 / rm;
+      csrlXmY(p,q,p,beta,1.0,n);
+      //printf("  GC1: it  %d err %E   rm %E\n",it,err,rm2); 
+      rm = rm2;
+    }
+    /* mixed precision: R_m is the residual of the single precision values
+       fl(A), so remove (A - fl(A)).(X_m - X_s) from it, X_s being the
+       solution at the previous correction, and restart on it with the same
+       relative tolerance until it is small enough (iterative refinement) */
+    if ( !xs || it > nit )  break;
+    csrlXmY(x,xs,q,1.0,-1.0,n);
+    csrAxpyRound(A,q,y,y,-1.,1.);
+    memcpy(xs,x,n*sizeof(double));
+    csrPrecSolve(A,&pc,p,y);
     rm = csrXY(p,y,n);
-
-		if ( fabs(rm) <= CS_EPSD2 )  break;
-    dp = csrAxdotx(A,p,ap);
-    if ( fabs(dp) <= CS_EPSD2 )  break;
-
-    /* X_m = X_m-1 + alpha_m.P_m , R_m = R_m-1 - alpha_m AP_m */ 
-    alpha = (rm / dp);
-		csrlXmY(p,x,x,alpha,1.0,n);
-		csrlXmY(ap,y,y,-alpha,1.0,n);
-
-    /* beta_m = <P^-1.R_m,R_m> / <P^-1.R_m-1,R_m-1> */
-    csrSSOR(A,L,q,y);
-    rm2 = csrXY(q,y,n);
-    if ( fabs(rm2) <= CS_EPSD2 )  break;
-
-    /* P_m+1 = P^-1.R_m + beta_m P_m */
-    beta = rm2 / rm;
-    csrlXmY(p,q,p,beta,1.0,n);
-    //printf("  GC1: it  %d err %E   rm %E\n",it,err,rm2); 
-    rm = rm2;
+    if ( rm <= err )  break;
+    err = CS_MAX(err,*er * *er * rm);
+    nref++;
   }
-  if ( it > nit )   ier = -2;
-  *er = sqrt(rm / rmp);
+  while ( err < rm );
+  /* the refinement may stop on nit, the system of fl(A) being solved */
+  if ( it > nit && !nref )   ier = -2;
+  *er = nref ? *er * sqrt(rm / err) : sqrt(rm / rmp);
   *ni = it;
   free(p);
   free(q);
   free(y);
   free(ap);
-  csrFree(L);
+  if ( xs )  free(xs);
+  csrPrecFree(&pc);
   return(ier);
 }
 
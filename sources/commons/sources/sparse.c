@@ -4,6 +4,9 @@
 #include "omp.h"
 #endif
 
+#define CS_SELLC   8      /* rows per chunk: one AVX-512 register of doubles */
+#define CS_SELLS   256    /* sorting window (sigma) */
+
 static int CSR_libId  = 0;
 static int CSR_libCpu = 1;
 
@@ -18,6 +21,17 @@ typedef struct {
   hmat  *item;
 } csHash;
 
+/* sliced ELLPACK storage (SELL-C-sigma): rows sorted by decreasing length
+   within windows of CS_SELLS rows, stored by chunks of CS_SELLC rows in
+   column-major order and padded to the longest row of the chunk. The
+   diagonal is kept apart, in double precision, and summed first as in CSR
+   (penalized rows must stay exact) */
+typedef struct {
+  double  *val,*dia;
+  float   *fval;      /* single precision values (mixed precision) */
+  int     *col,*cs,*cl,*perm,nr,nch;
+} Sell;
+
 /* define hash table for matrix */
 static csHash *cshNew(int nr,int hmax) {
   csHash  *hm;
@@ -336,11 +350,24 @@ void csrAlloc(pCsr M,int nr,int nc,int nmax,char typ) {
   M->nbe  = 0;
   M->nmax = 0;
   M->hm   = cshNew(nr,nmax);
+  M->sl   = 0;
   M->typ  = typ;
 }
 
+static void sellFree(Sell *S) {
+  free(S->val);
+  free(S->dia);
+  free(S->fval);
+  free(S->col);
+  free(S->cs);
+  free(S->cl);
+  free(S->perm);
+  free(S);
+}
+
 /* release memory */
 int csrFree(pCsr M) {
+  if ( M->sl )  sellFree(M->sl);
   free(M->row);
   free(M->col);
   free(M->val);
@@ -506,6 +533,107 @@ int csrSet(pCsr M,int i,int j,double val) {
 
 /*======= Part 3: multi-threaded matrix operators =======*/
 
+static int *_len;
+
+static int complen(const void *a,const void *b) {
+  int  diff = _len[*(int*)b] - _len[*(int*)a];
+  if ( !diff )  diff = *(int*)a - *(int*)b;
+  return(0 < diff) - (diff < 0);
+}
+
+/* build the SELL-C-sigma storage of packed matrix M, used by the products
+   y=A*x (and y=A^t*x, if M symmetric) in place of the CSR storage.
+   mixed=1: single precision values, double precision accumulation (only
+   csrPCG refines its solution to the residual of the double values) */
+int csrSell(pCsr M,char mixed) {
+  Sell    *S;
+  pCsr     F;
+  int     *len,i,j,k,r,ir,ic,nbe;
+
+  if ( M->hm || !M->row )  return(0);
+  if ( M->sl )  sellFree(M->sl);
+
+  /* symmetric matrix stored upper: both parts are stored */
+  F = ( M->typ & CS_SYM ) ? csrFull(M) : M;
+  S = (Sell*)calloc(1,sizeof(Sell));
+  assert(S);
+  S->nr   = F->nr;
+  S->nch  = (F->nr + CS_SELLC - 1) / CS_SELLC;
+  S->perm = (int*)calloc(S->nch*CS_SELLC,sizeof(int));
+  S->dia  = (double*)calloc(S->nch*CS_SELLC,sizeof(double));
+  S->cs   = (int*)malloc((S->nch+1)*sizeof(int));
+  S->cl   = (int*)malloc(S->nch*sizeof(int));
+  len     = (int*)malloc(F->nr*sizeof(int));
+  assert(S->perm);
+  assert(S->dia);
+  assert(S->cs);
+  assert(S->cl);
+  assert(len);
+
+  /* sort rows by decreasing length (off-diagonal terms) in each window */
+  for (i=0; i<F->nr; i++) {
+    len[i] = F->row[i+1] - F->row[i];
+    for (j=F->row[i]; j<F->row[i+1]; j++)
+      if ( F->col[j] == i )  len[i]--;
+    S->perm[i] = i;
+  }
+  _len = len;
+  for (i=0; i<F->nr; i+=CS_SELLS)
+    qsort(&S->perm[i],CS_MIN(CS_SELLS,F->nr-i),sizeof(int),complen);
+
+  /* chunks: width = longest row */
+  nbe = 0;
+  for (k=0; k<S->nch; k++) {
+    S->cs[k] = nbe;
+    S->cl[k] = 0;
+    for (r=0; r<CS_SELLC; r++) {
+      i = k*CS_SELLC + r;
+      if ( i < F->nr )  S->cl[k] = CS_MAX(S->cl[k],len[S->perm[i]]);
+    }
+    nbe += CS_SELLC*S->cl[k];
+  }
+  S->cs[S->nch] = nbe;
+  S->col = (int*)malloc(CS_MAX(nbe,1)*sizeof(int));
+  assert(S->col);
+  if ( mixed ) {
+    S->fval = (float*)calloc(CS_MAX(nbe,1),sizeof(float));
+    assert(S->fval);
+  }
+  else {
+    S->val = (double*)calloc(CS_MAX(nbe,1),sizeof(double));
+    assert(S->val);
+  }
+
+  /* column-major storage in chunks, padding with zeros */
+  for (k=0; k<S->nch; k++) {
+    for (r=0; r<CS_SELLC; r++) {
+      i  = k*CS_SELLC + r;
+      ir = S->perm[i];
+      for (j=0; j<S->cl[k]; j++)  S->col[S->cs[k]+j*CS_SELLC+r] = ir;
+      if ( i >= F->nr )  continue;
+      nbe = 0;
+      for (j=F->row[ir]; j<F->row[ir+1]; j++) {
+        if ( F->col[j] == ir ) {
+          S->dia[i] = F->val[j];
+          continue;
+        }
+        ic = S->cs[k] + nbe*CS_SELLC + r;
+        S->col[ic] = F->col[j];
+        if ( mixed )
+          S->fval[ic] = (float)F->val[j];
+        else
+          S->val[ic]  = F->val[j];
+        nbe++;
+      }
+    }
+  }
+  free(len);
+  if ( F != M )  csrFree(F);
+  M->sl = S;
+
+  return(1);
+}
+
 /* initialize parallel lib with ncpu procs */
 void csrInit(int ncpu) {
 
@@ -564,6 +692,55 @@ pCsr csrTr(pCsr M) {
   return(Mt);
 }
 
+/* full storage of a symmetric matrix stored upper (CS_SYM) */
+pCsr csrFull(pCsr A) {
+  pCsr     F;
+  int     *w,i,j,k,nbe;
+
+  w = (int*)calloc(A->nr+1,sizeof(int));
+  assert(w);
+  for (i=0; i<A->nr; i++) {
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      w[i]++;
+      if ( A->col[j] != i )  w[A->col[j]]++;
+    }
+  }
+  nbe = A->row[A->nr] + A->row[A->nr] - A->nr;
+  F = (Csr*)calloc(1,sizeof(Csr));
+  assert(F);
+  F->nr  = F->nc = A->nr;
+  F->nbe = F->nmax = nbe;
+  F->row = (int*)malloc((F->nr+1)*sizeof(int));
+  F->col = (int*)malloc(nbe*sizeof(int));
+  F->val = (double*)malloc(nbe*sizeof(double));
+  assert(F->row);
+  assert(F->col);
+  assert(F->val);
+
+  nbe = 0;
+  for (i=0; i<F->nr; i++) {
+    F->row[i] = nbe;
+    nbe  += w[i];
+    w[i]  = F->row[i];
+  }
+  F->row[F->nr] = nbe;
+  for (i=0; i<A->nr; i++) {
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      k = w[i]++;
+      F->col[k] = A->col[j];
+      F->val[k] = A->val[j];
+      if ( A->col[j] != i ) {
+        k = w[A->col[j]]++;
+        F->col[k] = i;
+        F->val[k] = A->val[j];
+      }
+    }
+  }
+  free(w);
+
+  return(F);
+}
+
 /* C = l*A + m*B */
 pCsr csrAdd(pCsr A,pCsr B,double l,double m) {
   pCsr     C;
@@ -825,6 +1002,70 @@ static void csr_atx(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
   }
 }
 
+/* acc = rows of chunk k times x, SELL-C-sigma storage */
+static inline void sell_chunk(Sell *S,int k,double *x,double *acc) {
+  double  *v;
+  float   *fv;
+  int     *c,j,r;
+
+  for (r=0; r<CS_SELLC; r++)
+    acc[r] = S->dia[k*CS_SELLC+r] * x[S->perm[k*CS_SELLC+r]];
+  c = &S->col[S->cs[k]];
+  if ( S->fval ) {
+    fv = &S->fval[S->cs[k]];
+    for (j=0; j<S->cl[k]; j++) {
+      #pragma omp simd
+      for (r=0; r<CS_SELLC; r++)
+        acc[r] += (double)fv[j*CS_SELLC+r] * x[c[j*CS_SELLC+r]];
+    }
+  }
+  else {
+    v = &S->val[S->cs[k]];
+    for (j=0; j<S->cl[k]; j++) {
+      #pragma omp simd
+      for (r=0; r<CS_SELLC; r++)
+        acc[r] += v[j*CS_SELLC+r] * x[c[j*CS_SELLC+r]];
+    }
+  }
+}
+
+/* compute y = A.x, on chunks */
+static void sell_ax(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
+  Sell    *S;
+  double  *x,*y,acc[CS_SELLC];
+  int      i,k,r;
+
+  S = arg->A->sl;
+  x = arg->x;
+  y = arg->y;
+  for (k=startAdr-1; k<stopAdr; k++) {
+    sell_chunk(S,k,x,acc);
+    for (r=0; r<CS_SELLC; r++) {
+      i = k*CS_SELLC + r;
+      if ( i < S->nr )  y[S->perm[i]] = acc[r];
+    }
+  }
+}
+
+/* compute z = l.A.x + m.y, on chunks */
+static void sell_axpy(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
+  Sell    *S;
+  double  *x,*y,*z,acc[CS_SELLC];
+  int      i,k,r;
+
+  S = arg->A->sl;
+  x = arg->x;
+  y = arg->y;
+  z = arg->z;
+  for (k=startAdr-1; k<stopAdr; k++) {
+    sell_chunk(S,k,x,acc);
+    for (r=0; r<CS_SELLC; r++) {
+      i = k*CS_SELLC + r;
+      if ( i < S->nr )  z[S->perm[i]] = arg->l*acc[r] + arg->m*y[S->perm[i]];
+    }
+  }
+}
+
 static void csr_lxmy(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
   double  *x,*y,*z,l,m,dd;
   int     i;
@@ -851,6 +1092,17 @@ static void csr_lxy(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
     y[i] = l * x[i];
 }
 
+static void csr_dxpy(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
+  double  *d,*x,*y;
+  int     i;
+
+  d = arg->z;
+  x = arg->x;
+  y = arg->y;
+  for (i=startAdr-1; i<stopAdr; i++)
+    y[i] += d[i] * x[i];
+}
+
 static void csr_xy(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
   double  r,*x,*y;
   int     i;
@@ -864,21 +1116,39 @@ static void csr_xy(int startAdr,int stopAdr,int PthIdx,CsrArg *arg) {
 }
 
 /*--------------- multithreaded part: global ---------------*/
+/* run kernel fun on the chunks of the SELL-C-sigma storage of arg->A */
+static void sellRun(void (*fun)(int,int,int,CsrArg*),CsrArg *arg) {
+  Sell    *S;
+  int      typid;
+
+  S = arg->A->sl;
+  if ( CSR_libId ) {
+    typid = NewType(CSR_libId,S->nch);
+    assert(typid);
+    LaunchParallel(CSR_libId,typid,0,(void *)fun,(void *)arg);
+    FreeType(CSR_libId,typid);
+  }
+  else
+    fun(1,S->nch,0,arg);
+}
+
 /* multithreaded: y = A*x */
 int csrAx(pCsr A,double *x,double *y) {
   CsrArg   arg;
-  float    acc;
   int      typid;
 
   if ( !x || !y )  return (0);
   arg.A = A;
   arg.x = x;
   arg.y = y;
+  if ( A->sl ) {
+    sellRun(sell_ax,&arg);
+    return(1);
+  }
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,A->nr);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_ax,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_ax,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else
@@ -889,19 +1159,21 @@ int csrAx(pCsr A,double *x,double *y) {
 /* multithreaded: y = A^t*x (A transposed directly) */
 int csrAtx(pCsr A,double *x,double *y) {
   CsrArg   arg;
-  float    acc;
   int      typid;
 
   if ( !x || !y )  return (0);
-  memset(y,0,A->nc*sizeof(double));
   arg.A = A;
   arg.x = x;
   arg.y = y;
+  if ( A->sl && (A->typ & CS_SYM) ) {
+    sellRun(sell_ax,&arg);
+    return(1);
+  }
+  memset(y,0,A->nc*sizeof(double));
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,A->nr);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_atx,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_atx,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else
@@ -912,18 +1184,20 @@ int csrAtx(pCsr A,double *x,double *y) {
 /* multithreaded: z = l.A*x + m.y */
 int csrAxpy(pCsr A,double *x,double *y,double *z,double l,double m) {
   CsrArg   arg;
-  float    acc;
   int      typid;
 
   if ( !x || !y || !z )  return (0);
   arg.A = A;
   arg.x = x;  arg.y = y;  arg.z = z;
   arg.l = l;  arg.m = m;
+  if ( A->sl ) {
+    sellRun(sell_axpy,&arg);
+    return(1);
+  }
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,A->nr);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_axpy,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_axpy,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else
@@ -934,19 +1208,23 @@ int csrAxpy(pCsr A,double *x,double *y,double *z,double l,double m) {
 /* multithreaded: z = l.A^t*x + m.y */
 int csrAtxpy(pCsr A,double *x,double *y,double *z,double l,double m) {
   CsrArg   arg;
-  float    acc;
   int      typid;
 
   if ( !x || !y || !z )  return (0);
   arg.A = A;
+  if ( A->sl && (A->typ & CS_SYM) ) {
+    arg.x = x;  arg.y = y;  arg.z = z;
+    arg.l = l;  arg.m = m;
+    sellRun(sell_axpy,&arg);
+    return(1);
+  }
   arg.x = x;
   arg.y = z;
   if ( CSR_libId ) {
 		/* z = arg.y = A^t*x */
     typid = NewType(CSR_libId,A->nr);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_atx,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_atx,(void *)&arg);
     FreeType(CSR_libId,typid);
 
     /* z = l.z + m.y = l.A^t*x + m.y */
@@ -954,8 +1232,7 @@ int csrAtxpy(pCsr A,double *x,double *y,double *z,double l,double m) {
 		arg.l = l;	arg.m = m;
     typid = NewType(CSR_libId,A->nc);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_lxmy,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_lxmy,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else {
@@ -971,11 +1248,43 @@ int csrAtxpy(pCsr A,double *x,double *y,double *z,double l,double m) {
   return(1);
 }
 
+/* z = l.(A - fl(A))*x + m.y, where fl(A) holds the single precision values
+   of the SELL-C-sigma storage of A (diagonal kept exact): rounding error of
+   the products in mixed precision */
+int csrAxpyRound(pCsr A,double *x,double *y,double *z,double l,double m) {
+  double   li;
+  int      i,j,ic;
+
+  if ( !x || !y || !z )  return (0);
+  for (i=0; i<A->nr; i++) {
+    li = 0.0;
+    for (j=A->row[i]; j<A->row[i+1]; j++) {
+      if ( A->col[j] == i )  continue;
+      li += (A->val[j] - (double)(float)A->val[j]) * x[A->col[j]];
+    }
+    z[i] = l*li + m*y[i];
+  }
+  if ( A->typ & CS_SYM ) {
+    for (i=0; i<A->nr; i++) {
+      for (j=A->row[i]; j<A->row[i+1]; j++) {
+        ic = A->col[j];
+        if ( ic == i )  continue;
+        z[ic] += l*((A->val[j] - (double)(float)A->val[j]) * x[i]);
+      }
+    }
+  }
+  return(1);
+}
+
+/* return 1 if the SELL-C-sigma storage of A has single precision values */
+int csrMixed(pCsr A) {
+  return( A->sl && ((Sell*)A->sl)->fval );
+}
+
 /* res = <y=A*x,x> */
 double csrAxdotx(pCsr A,double *x,double *y) {
   CsrArg   arg;
   double   axx;
-  float    acc;
   int      i,typid;
 
   if ( !x || !y )  return (0);
@@ -983,17 +1292,18 @@ double csrAxdotx(pCsr A,double *x,double *y) {
   arg.A = A;
   arg.x = x;
   arg.y = y;
+  if ( A->sl )  sellRun(sell_ax,&arg);
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,A->nr);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_ax,(void *)&arg);
-    assert(acc);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_xy,(void *)&arg);
-    assert(acc);
+    if ( !A->sl ) {
+      LaunchParallel(CSR_libId,typid,0,(void *)csr_ax,(void *)&arg);
+    }
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_xy,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else {
-    csr_ax(1,A->nr,0,&arg);
+    if ( !A->sl )  csr_ax(1,A->nr,0,&arg);
     csr_xy(1,A->nr,0,&arg);
   }
   axx = 0.0;
@@ -1004,7 +1314,6 @@ double csrAxdotx(pCsr A,double *x,double *y) {
 /* z[i] = l*x[i] + m*y[i] */
 void csrlXmY(double *x,double *y,double *z,double l,double m,int n) {
   CsrArg   arg;
-	float    acc;
   int      typid;
 
   arg.x = x;
@@ -1015,8 +1324,7 @@ void csrlXmY(double *x,double *y,double *z,double l,double m,int n) {
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,n);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_lxmy,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_lxmy,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else
@@ -1026,7 +1334,6 @@ void csrlXmY(double *x,double *y,double *z,double l,double m,int n) {
 /* y[i] = l*x[i] */
 void csrlX(double *x,double *y,double l,int n) {
   CsrArg   arg;
-	float    acc;
   int      typid;
 
   arg.x = x;
@@ -1035,19 +1342,35 @@ void csrlX(double *x,double *y,double l,int n) {
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,n);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_lxy,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_lxy,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else
     csr_lxy(1,n,0,&arg);
 }
 
+/* y[i] = y[i] + d[i]*x[i] (diagonal scaling) */
+void csrDxpy(double *d,double *x,double *y,int n) {
+  CsrArg   arg;
+  int      typid;
+
+  arg.z = d;
+  arg.x = x;
+  arg.y = y;
+  if ( CSR_libId ) {
+    typid = NewType(CSR_libId,n);
+    assert(typid);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_dxpy,(void *)&arg);
+    FreeType(CSR_libId,typid);
+  }
+  else
+    csr_dxpy(1,n,0,&arg);
+}
+
 /* r = <x,y> */
 double csrXY(double *x,double *y,int n) {
   CsrArg    arg;
   double    xy;
-  float     acc;
   int       i,typid;
 
   arg.x = x;
@@ -1055,8 +1378,7 @@ double csrXY(double *x,double *y,int n) {
   if ( CSR_libId ) {
     typid = NewType(CSR_libId,n);
     assert(typid);
-    acc = LaunchParallel(CSR_libId,typid,0,(void *)csr_xy,(void *)&arg);
-    assert(acc);
+    LaunchParallel(CSR_libId,typid,0,(void *)csr_xy,(void *)&arg);
     FreeType(CSR_libId,typid);
   }
   else
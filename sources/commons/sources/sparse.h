@@ -26,12 +26,17 @@
 #define CS_LT      (1<<2)
 #define CS_SYM     (1<<3)
 
+/* preconditioners of the conjugate gradient */
+#define CS_SSOR    0
+#define CS_IC0     1
+#define CS_AMG     2
+
 /* compressed sparse row (CSR) format */
 typedef struct {
   double    *val;
   int       *col,*row,nr,nc,nbe,nmax;
 	char       typ;
-	void      *hm;
+	void      *hm,*sl;
 } Csr;
 typedef Csr * pCsr;
 
@@ -70,7 +75,9 @@ int  csrPack(pCsr M);
 int  csrPut(pCsr M,int i,int j,double val);
 int  csrSet(pCsr M,int i,int j,double val);
 int  csrGet(pCsr M,int i,int j,double *val);
+int  csrSell(pCsr M,char mixed);
 pCsr csrTr(pCsr M);
+pCsr csrFull(pCsr A);
 pCsr csrMulAAt(pCsr A);
 pCsr csrMul(pCsr A,pCsr B);
 pCsr csrAdd(pCsr A,pCsr B,double l,double m);
@@ -78,8 +85,11 @@ int  csrAx(pCsr A,double *x,double *y);
 int  csrAtx(pCsr A,double *x,double *y);
 int  csrAxpy(pCsr A,double *x,double *y,double *z,double l,double m); 
 int  csrAtxpy(pCsr A,double *x,double *y,double *z,double l,double m); 
+int  csrAxpyRound(pCsr A,double *x,double *y,double *z,double l,double m);
+int  csrMixed(pCsr A);
 void csrlX(double *x,double *y,double l,int n);
 void csrlXmY(double *x,double *y,double *z,double l,double m,int n);
+void csrDxpy(double *d,double *x,double *y,int n);
 double csrAxdotx(pCsr A,double *x,double *y);
 double csrXY(double *x,double *y,int n);
 double csrNorm(pCsr M);
@@ -97,6 +107,7 @@ int  csrGradient(pCsr A,double *x,double *b,double *err,int *nit);
 int  csrConjGrad(pCsr A,double *x,double *b,double *err,int *nit);
 int  csrConjGradGen(pCsr A,double *x,double *b,double *,char *,char ,double *err,int *nit);
 int  csrPrecondGrad(pCsr A,double *x,double *b,double *er,int *ni,char tgv);
+int  csrPCG(pCsr A,double *x,double *b,double *er,int *ni,char tgv,char prec,int bs);
 int  csrGMRES(pCsr A,double *x,double *b,double *er,int *ni,int krylov,int prec);
 int  csrUzawa(pCsr A,pCsr B,double *u,double *p,double *F,double *er,int *ni,char verb);
 
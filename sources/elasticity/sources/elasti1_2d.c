@@ -327,16 +327,17 @@ int elasti1_2d(LSst *lsst) {
 	}
 
   /* -- Part II: solver */
+  if ( lsst->info.sell )  csrSell(A,lsst->info.sell > 1);
   if ( lsst->info.verb != '0' ) {
     fprintf(stdout,"    Solving linear system:");  fflush(stdout);
-    ier = csrPrecondGrad(A,lsst->sol.u,lsst->sol.F,&lsst->sol.res,&lsst->sol.nit,1);
+    ier = csrPCG(A,lsst->sol.u,lsst->sol.F,&lsst->sol.res,&lsst->sol.nit,1,lsst->info.prec,lsst->info.dim);
     if ( ier <= 0 )
       fprintf(stdout,"\n # convergence problem: %d\n",ier);
     else
       fprintf(stdout," %E in %d iterations\n",lsst->sol.res,lsst->sol.nit);
 	}
   else {
-    ier = csrPrecondGrad(A,lsst->sol.u,lsst->sol.F,&lsst->sol.res,&lsst->sol.nit,1);
+    ier = csrPCG(A,lsst->sol.u,lsst->sol.F,&lsst->sol.res,&lsst->sol.nit,1,lsst->info.prec,lsst->info.dim);
   }
 
   /* free memory */
@@ -45,12 +45,16 @@ static void excfun(int sigid) {
 
 
 static void usage(char *prog) {
-  fprintf(stdout,"usage: %s [+/-v | -h | -x] [-n nit] [-r res] [-t typ] source[.mesh] [-p param[.elas]] [-s data[.sol]] [-o output[.sol]]\n",prog);
+  fprintf(stdout,"usage: %s [+/-v | -h | -x] [-n nit] [-r res] [-t typ] [-prec n] [-sell n] source[.mesh] [-p param[.elas]] [-s data[.sol]] [-o output[.sol]]\n",prog);
   fprintf(stdout,"\nOptions and flags:\n\
   --help       show the syntax and exit.\n\
   --version    show the version and date of release and exit.\n\n\
   -n nit       number of iterations max for convergence\n\
+  -prec n      preconditioner: 0: SSOR, 1: IC(0), 2: AMG (default 0)\n\
   -r res       value of the residual (Krylov space) for convergence\n\
+  -sell n      matrix storage for products: 0: CSR, 1: SELL-C-sigma, 2: SELL-C-sigma\n\
+               with single precision values, refined in double precision by\n\
+               the conjugate gradient (default 0)\n\
   -t typ       specify the type of FE space: 1: P1, 2: P2\n\
   -v           suppress any message (for use with function call).\n\
   +v           increase the verbosity level for output.\n\
@@ -115,7 +119,15 @@ static int parsar(int argc,char *argv[],LSst *lsst) {
         }
         break;
       case 'p':
-        if ( ++i < argc ) {
+        if ( !strcmp(argv[i],"-prec") ) {
+          if ( ++i < argc && isdigit(argv[i][0]) )
+            lsst->info.prec = atoi(argv[i]);
+          else {
+            fprintf(stderr,"%s: missing argument option\n",argv[0]);
+            usage(argv[0]);
+          }
+        }
+        else if ( ++i < argc ) {
           lsst->sol.namepar = argv[i];
           ptr = strstr(lsst->sol.namepar,".elas");
           if ( !ptr )  strcat(lsst->sol.namepar,".elas");
@@ -134,7 +146,15 @@ static int parsar(int argc,char *argv[],LSst *lsst) {
         }
         break;
       case 's':
-        if ( ++i < argc ) {
+        if ( !strcmp(argv[i],"-sell") ) {
+          if ( ++i < argc && isdigit(argv[i][0]) )
+            lsst->info.sell = atoi(argv[i]);
+          else {
+            fprintf(stderr,"%s: missing argument option\n",argv[0]);
+            usage(argv[0]);
+          }
+        }
+        else if ( ++i < argc ) {
           lsst->sol.namein = argv[i];
           ptr = strstr(lsst->sol.namein,".sol");
           if ( !ptr )  strcat(lsst->sol.namein,".sol");
@@ -25,6 +25,8 @@ LSst *LS_init(int dim,int ver,char typ,char mfree) {
   lsst->info.zip    = 0;
   lsst->info.typ    = typ;
   lsst->info.mfree  = mfree;
+  lsst->info.prec   = LS_SSOR;
+  lsst->info.sell   = 0;
 
   /* init timer */
   tminit(lsst->info.ctim,TIMEMAX);
@@ -58,6 +60,17 @@ void LS_setPar(LSst *lsst,char verb,int zip) {
 	lsst->info.zip  = zip;
 }
 
+/* set preconditioner (facultative): prec= LS_SSOR|LS_IC0|LS_AMG */
+void LS_setPrec(LSst *lsst,char prec) {
+  lsst->info.prec = prec;
+}
+
+/* set matrix storage for products (facultative): sell= 0: CSR, 1: SELL-C-sigma,
+   2: SELL-C-sigma, single precision values */
+void LS_setSell(LSst *lsst,char sell) {
+  lsst->info.sell = sell;
+}
+
 /* handle boundary conditions:
   typ= Dirichlet, Load
   ref= integer
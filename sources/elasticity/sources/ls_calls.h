@@ -4,6 +4,7 @@
 enum {Dirichlet=1, Load=2, Gravity=4};
 enum {P0=0, P1, P2};
 enum {LS_ver=1,LS_edg=2,LS_tri=4,LS_tet=8};
+enum {LS_SSOR=0, LS_IC0, LS_AMG};
 
 
 /* data structure */
@@ -30,6 +31,8 @@ int   LS_allTet(LSst *lsst,int ne,int *tet,int *ref);
 void  LS_headMesh(LSst *lsst,int *np,int *na,int *nt,int *ne);
 
 void  LS_setPar(LSst *lsst,char imp,int zip);
+void  LS_setPrec(LSst *lsst,char prec);
+void  LS_setSell(LSst *lsst,char sell);
 int   LS_setBC(LSst *lsst,int typ,int ref,char att,int elt,double *u);
 void  LS_setGra(LSst *lsst, double *gr);
 int   LS_setLame(LSst *lsst,int ref,double lambda,double mu);
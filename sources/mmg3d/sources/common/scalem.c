@@ -109,6 +109,7 @@ int MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
 
   mesh->info.hausd *= dd;
   mesh->info.ls    *= dd;
+  mesh->info.band  *= dd;
   mesh->info.hsiz  *= dd;
 
   /* normalize local parameters */
@@ -277,6 +278,7 @@ int MMG5_unscaleMesh(MMG5_pMesh mesh,MMG5_pSol met) {
   mesh->info.hmax  *= dd;
   mesh->info.hausd *= dd;
   mesh->info.ls    *= dd;
+  mesh->info.band  *= dd;
   mesh->info.hsiz  *=dd;
 
   /* normalize local parameters */
@@ -89,21 +89,23 @@ void MMG3D_Init_parameters(MMG5_pMesh mesh) {
   mesh->info.optimLES = MMG5_OFF;
   /* [0/1]    ,avoid/allow surface modifications */
   mesh->info.nosurf   =  MMG5_OFF;
-#ifdef USE_SCOTCH
-   /* [1/0]    , Turn on/off the renumbering using SCOTCH */
+  /* [0/1]    ,extend/don't extend the input lagrangian displacement */
+  mesh->info.noext    =  MMG5_OFF;
+   /* [1/0]    , Turn on/off the renumbering (using SCOTCH if available and
+    * along a Hilbert curve at the end) */
   mesh->info.renum    = MMG5_ON;
-#else
-   /* [0]    , Turn on/off the renumbering using SCOTCH */
-  mesh->info.renum    = MMG5_OFF;
-#endif
 
   /* default values for doubles */
   /* level set value */
   mesh->info.ls       = MMG5_LS;
+  /* width of the remeshed band (negative: remesh the whole mesh) */
+  mesh->info.band     = -1.0;
 
 #ifndef PATTERN
   mesh->info.PROctree = MMG5_PROCTREE;
 #endif
+  /* [n]    , number of partitions remeshed in parallel */
+  mesh->info.npart    = 1;
 }
 
 int MMG3D_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int typSol) {
@@ -1987,6 +1989,16 @@ int MMG3D_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam,int val){
     mesh->info.PROctree   = val;
     break;
 #endif
+  case MMG3D_IPARAM_nparts :
+    if ( val < 1 ) {
+      fprintf(stderr,"\n  ## Warning: %s: the number of partitions must be"
+              " strictly positive.\n",__func__);
+      fprintf(stderr,"  Reset to default value.\n");
+      mesh->info.npart    = 1;
+    }
+    else
+      mesh->info.npart    = val;
+    break;
   case MMG3D_IPARAM_debug :
     mesh->info.ddebug   = val;
     break;
@@ -2055,6 +2067,9 @@ int MMG3D_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam,int val){
   case MMG3D_IPARAM_nosurf :
     mesh->info.nosurf   = val;
     break;
+  case MMG3D_IPARAM_noext :
+    mesh->info.noext    = val;
+    break;
   case MMG3D_IPARAM_numberOfLocalParam :
     if ( mesh->info.par ) {
       MMG5_DEL_MEM(mesh,mesh->info.par);
@@ -2079,11 +2094,9 @@ int MMG3D_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam,int val){
     }
 
     break;
-#ifdef USE_SCOTCH
   case MMG3D_IPARAM_renum :
     mesh->info.renum    = val;
     break;
-#endif
   case MMG3D_IPARAM_anisosize :
     if ( !MMG3D_Set_solSize(mesh,sol,MMG5_Vertex,0,MMG5_Tensor) )
       return 0;
@@ -2112,6 +2125,9 @@ int MMG3D_Get_iparameter(MMG5_pMesh mesh, int iparam) {
     return  mesh->info.PROctree;
     break;
 #endif
+  case MMG3D_IPARAM_nparts :
+    return  mesh->info.npart;
+    break;
   case MMG3D_IPARAM_debug :
     return  mesh->info.ddebug;
     break;
@@ -2141,14 +2157,15 @@ int MMG3D_Get_iparameter(MMG5_pMesh mesh, int iparam) {
   case MMG3D_IPARAM_nosurf :
     return  mesh->info.nosurf;
     break;
+  case MMG3D_IPARAM_noext :
+    return  mesh->info.noext;
+    break;
   case MMG3D_IPARAM_numberOfLocalParam :
     return  mesh->info.npar;
     break;
-#ifdef USE_SCOTCH
   case MMG3D_IPARAM_renum :
     return  mesh->info.renum;
     break;
-#endif
   default :
     fprintf(stderr,"\n  ## Error: %s: unknown type of parameter\n",__func__);
     return 0;
@@ -2199,6 +2216,9 @@ int MMG3D_Set_dparameter(MMG5_pMesh mesh, MMG5_pSol sol, int dparam, double val)
   case MMG3D_DPARAM_ls :
     mesh->info.ls       = val;
     break;
+  case MMG3D_DPARAM_band :
+    mesh->info.band     = val;
+    break;
   default :
     fprintf(stderr,"\n  ## Error: %s: unknown type of parameter\n", __func__);
     return 0;
@@ -85,6 +85,55 @@ void MMG3D_set_reqBoundaries(MMG5_pMesh mesh) {
   return;
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the level-set or displacement structure.
+ * \return number of frozen tetra.
+ *
+ * Freeze the tetra far from the moving part of the mesh (-band option): in
+ * level-set mode, the ones whose vertices are all farther than info.band from
+ * the isovalue, in lagrangian mode, the ones whose vertices all move less than
+ * info.band. They are set to required with the MG_NOSURF tag, so that their
+ * vertices and edges are not really required (see MMG5_bdryUpdate) and that
+ * the tags are removed before saving the mesh.
+ *
+ */
+int MMG3D_set_reqBand(MMG5_pMesh mesh,MMG5_pSol sol) {
+  MMG5_pTetra    pt;
+  double         *v,band;
+  int            k,nf;
+  char           i;
+
+  if ( mesh->info.band < 0. || !sol->m )  return 0;
+
+  band = mesh->info.band;
+  nf   = 0;
+#pragma omp parallel for private(pt,v,i) reduction(+:nf)
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+
+    for (i=0; i<4; i++) {
+      if ( sol->size == 1 ) {
+        if ( fabs(sol->m[pt->v[i]]-mesh->info.ls) <= band )  break;
+      }
+      else {
+        v = &sol->m[sol->size*pt->v[i]];
+        if ( v[0]*v[0]+v[1]*v[1]+v[2]*v[2] > band*band )  break;
+      }
+    }
+    if ( i < 4 )  continue;
+
+    pt->tag |= MG_REQ + MG_NOSURF;
+    nf++;
+  }
+
+  if ( abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     %d frozen tetrahedra out of the band\n",nf);
+
+  return nf;
+}
+
 
 /**
  * \param mesh pointer towarad the mesh structure.
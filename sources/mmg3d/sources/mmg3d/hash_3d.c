@@ -2007,7 +2007,7 @@ int MMG5_bdryUpdate(MMG5_pMesh mesh) {
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) )  continue;
-    if ( pt->tag & MG_REQ ) {
+    if ( (pt->tag & MG_REQ) && !(pt->tag & MG_NOSURF) ) {
       mesh->point[mesh->tetra[k].v[0]].tag |= MG_REQ;
       mesh->point[mesh->tetra[k].v[1]].tag |= MG_REQ;
       mesh->point[mesh->tetra[k].v[2]].tag |= MG_REQ;
@@ -2043,7 +2043,7 @@ int MMG5_bdryUpdate(MMG5_pMesh mesh) {
         kt = MMG5_hashGetFace(&hash,ia,ib,ic);
         assert(kt);
         ptt = &mesh->tria[kt];
-        if ( pt->tag & MG_REQ ) {
+        if ( (pt->tag & MG_REQ) && !(pt->tag & MG_NOSURF) ) {
           pxt->ftag[i] |= MG_REQ;
           ptt->tag[0]   = MG_REQ;
           ptt->tag[1]   = MG_REQ;
@@ -2063,6 +2063,23 @@ int MMG5_bdryUpdate(MMG5_pMesh mesh) {
       }
     }
   }
+
+  /* tetra frozen out of the band (-band option): their entities are not
+   * really required, except if they already were */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || !(pt->tag & MG_REQ) || !(pt->tag & MG_NOSURF) )
+      continue;
+
+    for (i=0; i<4; i++) {
+      if ( !(mesh->point[pt->v[i]].tag & MG_REQ) )
+        mesh->point[pt->v[i]].tag |= MG_REQ + MG_NOSURF;
+    }
+    for (i=0; i<6; i++) {
+      if ( !MMG5_settag(mesh,k,i,MG_REQ+MG_NOSURF,0) ) return 0;
+    }
+  }
+
   MMG5_DEL_MEM(mesh,hash.item);
   return 1;
 }
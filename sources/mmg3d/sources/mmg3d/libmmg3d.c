@@ -522,6 +522,11 @@ void MMG3D_unset_reqBoundaries(MMG5_pMesh mesh) {
 
   for (k=1; k<=mesh->ne; k++) {
     pt   = &mesh->tetra[k];
+    if ( MG_EOK(pt) && (pt->tag & MG_NOSURF) ) {
+      /* tetra frozen out of the band */
+      pt->tag &= ~MG_REQ;
+      pt->tag &= ~MG_NOSURF;
+    }
     if ( MG_EOK(pt) &&  pt->xt ) {
 
       for (i=0; i<6; i++) {
@@ -586,6 +591,10 @@ int MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
   if ( met  && met->m  ) assert(met->np ==mesh->np);
   if ( disp && disp->m ) assert(disp->np==mesh->np);
 
+  /* renumber vertices and tetrahedra along a Hilbert curve */
+  if ( mesh->info.renum && !MMG3D_hilbertRenumbering(mesh,met,disp) )
+    return 0;
+
   /* create prism adjacency */
   if ( !MMG3D_hashPrism(mesh) ) {
     fprintf(stderr,"\n  ## Error: %s: prism hashing problem. Exit program.\n",
@@ -1108,6 +1117,9 @@ int MMG3D_mmg3dmov(MMG5_pMesh mesh,MMG5_pSol met, MMG5_pSol disp) {
   /* scaling mesh */
   if ( !MMG5_scaleMesh(mesh,disp) ) _LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE);
 
+  /* Freeze the tetra that do not move (-band option) */
+  MMG3D_set_reqBand(mesh,disp);
+
   MMG3D_setfunc(mesh,met);
 
   if ( !MMG3D_tetraQual(mesh,met,0) ) _LIBMMG5_RETURN(mesh,met,MMG5_LOWFAILURE);
@@ -84,9 +84,11 @@ enum MMG3D_Param {
   MMG3D_IPARAM_nomove,            /*!< [1/0], Avoid/allow point relocation */
   MMG3D_IPARAM_nosurf,            /*!< [1/0], Avoid/allow surface modifications */
   MMG3D_IPARAM_numberOfLocalParam,/*!< [n], Number of local parameters */
-  MMG3D_IPARAM_renum,             /*!< [1/0], Turn on/off point relocation with Scotch */
+  MMG3D_IPARAM_renum,             /*!< [1/0], Turn on/off point relocation with Scotch and the final Hilbert renumbering */
   MMG3D_IPARAM_anisosize,         /*!< [1/0], Turn on/off anisotropic metric creation when no metric is provided */
   MMG3D_IPARAM_octree,            /*!< [n], Specify the max number of points per PROctree cell (DELAUNAY) */
+  MMG3D_IPARAM_nparts,            /*!< [n], Number of partitions remeshed in parallel (see MMG3D_mmg3dpart) */
+  MMG3D_IPARAM_noext,             /*!< [1/0], Lagrangian displacement already extended to the whole mesh (skip its first extension) */
   MMG3D_DPARAM_angleDetection,    /*!< [val], Value for angle detection */
   MMG3D_DPARAM_hmin,              /*!< [val], Minimal mesh size */
   MMG3D_DPARAM_hmax,              /*!< [val], Maximal mesh size */
@@ -95,6 +97,7 @@ enum MMG3D_Param {
   MMG3D_DPARAM_hgrad,             /*!< [val], Control gradation */
   MMG3D_DPARAM_hgradreq,          /*!< [val], Control gradation on required entites (advanced usage) */
   MMG3D_DPARAM_ls,                /*!< [val], Value of level-set */
+  MMG3D_DPARAM_band,              /*!< [val], Remesh only near the level-set (distance) or the moving vertices (displacement threshold), negative to remesh everywhere */
   MMG3D_PARAM_size,               /*!< [n], Number of parameters */
 };
 
@@ -1949,6 +1952,28 @@ enum MMG3D_Param {
  */
   int  MMG3D_mmg3dlib(MMG5_pMesh mesh, MMG5_pSol met );
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the sol (metric) structure.
+ * \return \ref MMG5_SUCCESS if success, \ref MMG5_LOWFAILURE if fail but a
+ * conform mesh is saved or \ref MMG5_STRONGFAILURE if fail and we can't save
+ * the mesh.
+ *
+ * Main program for the parallel remesh library: the mesh is cut into
+ * \ref MMG3D_IPARAM_nparts slabs remeshed in parallel by \ref MMG3D_mmg3dlib
+ * with frozen interfaces, then into shifted slabs to remesh the interfaces.
+ * Call \ref MMG3D_mmg3dlib if the mesh is too small, contains prisms or
+ * quadrilaterals.
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE MMG3D_MMG3DPART(mesh,met,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: mesh,met\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int  MMG3D_mmg3dpart(MMG5_pMesh mesh, MMG5_pSol met );
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol (level-set) structure.
@@ -121,6 +121,9 @@ int MMG3D_usage(char *prog) {
   fprintf(stdout,"-A           enable anisotropy (without metric file).\n");
   fprintf(stdout,"-opnbdy      preserve input triangles at the interface of"
           " two domains of the same reference.\n");
+  fprintf(stdout,"-band   val  freeze the elements whose vertices are all farther"
+          " than val\n             from the level-set (-ls) or move less than val"
+          " (-lag).\n");
 
 #ifdef USE_ELAS
   fprintf(stdout,"-lag [n] Lagrangian mesh displacement according to mode [0/1/2]\n");
@@ -128,12 +131,20 @@ int MMG3D_usage(char *prog) {
   fprintf(stdout,"             1: displacement + remeshing (swap and move)\n");
   fprintf(stdout,"             2: displacement + remeshing (split, collapse,"
           " swap and move)\n");
+  fprintf(stdout,"-noext       the displacement (-lag) is already extended to"
+          " the whole mesh\n");
+  fprintf(stdout,"             (only its first extension is skipped)\n");
 #endif
 #ifndef PATTERN
   fprintf(stdout,"-octree val  Specify the max number of points per octree cell \n");
 #endif
+  fprintf(stdout,"-nparts n    remesh n partitions of the mesh in parallel"
+          " (metric mode only)\n");
 #ifdef USE_SCOTCH
-  fprintf(stdout,"-rn [n]      Turn on or off the renumbering using SCOTCH [1/0] \n");
+  fprintf(stdout,"-rn [n]      Turn on or off the renumbering using SCOTCH and"
+          " Hilbert [1/0] \n");
+#else
+  fprintf(stdout,"-rn [n]      Turn on or off the Hilbert renumbering [1/0] \n");
 #endif
   fprintf(stdout,"\n");
 
@@ -198,6 +209,17 @@ int MMG3D_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
         if ( !MMG3D_Set_solSize(mesh,met,MMG5_Vertex,0,MMG5_Tensor) )
           return 0;
         break;
+      case 'b':
+        if ( !strcmp(argv[i],"-band") && ++i < argc ) {
+          if ( !MMG3D_Set_dparameter(mesh,met,MMG3D_DPARAM_band,
+                                     atof(argv[i])) )
+            return 0;
+        }
+        else {
+          MMG3D_usage(argv[0]);
+          return 0;
+        }
+        break;
       case 'd':
         if ( !strcmp(argv[i],"-default") ) {
           mesh->mark=1;
@@ -325,6 +347,22 @@ int MMG3D_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
           if ( !MMG3D_Set_iparameter(mesh,met,MMG3D_IPARAM_nosurf,1) )
             return 0;
         }
+        else if( !strcmp(argv[i],"-noext") ) {
+          if ( !MMG3D_Set_iparameter(mesh,met,MMG3D_IPARAM_noext,1) )
+            return 0;
+        }
+        else if ( !strcmp(argv[i],"-nparts") ) {
+          if ( ++i < argc && isdigit(argv[i][0]) ) {
+            if ( !MMG3D_Set_iparameter(mesh,met,MMG3D_IPARAM_nparts,
+                                       atoi(argv[i])) )
+              return 0;
+          }
+          else {
+            fprintf(stderr,"Missing argument option %s\n",argv[i-1]);
+            MMG3D_usage(argv[0]);
+            return 0;
+          }
+        }
         break;
       case 'o':
         if ( !strcmp(argv[i],"-out") ) {
@@ -358,7 +396,6 @@ int MMG3D_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
             return 0;
         }
         break;
-#ifdef USE_SCOTCH
       case 'r':
         if ( !strcmp(argv[i],"-rn") ) {
           if ( ++i < argc ) {
@@ -379,7 +416,6 @@ int MMG3D_parsar(int argc,char *argv[],MMG5_pMesh mesh,MMG5_pSol met) {
           }
         }
         break;
-#endif
       case 's':
         if ( !strcmp(argv[i],"-sol") ) {
           if ( ++i < argc && isascii(argv[i][0]) && argv[i][0]!='-' ) {
@@ -56,6 +56,18 @@ FORTRAN_NAME(MMG3D_MMG3DLIB,mmg3d_mmg3dlib,(MMG5_pMesh *mesh,MMG5_pSol *met,
   return;
 }
 
+/**
+ * See \ref MMG3D_mmg3dpart function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG3D_MMG3DPART,mmg3d_mmg3dpart,(MMG5_pMesh *mesh,MMG5_pSol *met,
+                                              int* retval),
+             (mesh,met,retval)){
+
+  *retval = MMG3D_mmg3dpart(*mesh,*met);
+
+  return;
+}
+
 /**
  * See \ref MMG3D_mmg3dls function in \ref mmg3d/libmmg3d.h file.
  */
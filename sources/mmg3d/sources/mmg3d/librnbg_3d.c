@@ -23,7 +23,7 @@
 
 /**
  * \file mmg3d/librnbg_3d.c
- * \brief Functions for scotch renumerotation.
+ * \brief Functions for scotch and Hilbert renumerotation.
  * \author Algiane Froehly (Inria/UBordeaux)
  * \author Cedric Lachat (Inria/UBordeaux)
  * \version 5
@@ -390,3 +390,240 @@ int MMG5_mmg3dRenumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
 }
 #endif
 
+
+/** Number of bits of the Hilbert coordinates (3 times this value must fit in
+ * 64 bits) */
+#define MMG3D_HILBERT_BITS 21
+
+/**
+ * \struct MMG3D_hilbertCell
+ * \brief Hilbert key of an entity (vertex or tetrahedron).
+ */
+typedef struct {
+  uint64_t key; /*!< position along the Hilbert curve */
+  int      idx; /*!< index of the entity */
+} MMG3D_hilbertCell;
+
+/**
+ * \param a pointer toward the first cell.
+ * \param b pointer toward the second cell.
+ * \return -1, 0 or 1 following the order of the keys (and indices).
+ *
+ * Comparison function of the qsort of the Hilbert keys.
+ *
+ */
+static int MMG3D_cmpHilbert(const void *a,const void *b) {
+  const MMG3D_hilbertCell *ca = (const MMG3D_hilbertCell*)a;
+  const MMG3D_hilbertCell *cb = (const MMG3D_hilbertCell*)b;
+
+  if ( ca->key < cb->key )  return -1;
+  if ( ca->key > cb->key )  return  1;
+  return ca->idx - cb->idx;
+}
+
+/**
+ * \param c coordinates of the point.
+ * \param min lower corner of the bounding box.
+ * \param dd inverse of the size of the bounding box.
+ * \return the position of \a c along the Hilbert curve of the box.
+ *
+ * Compute the Hilbert key of a point (transposition of the Hilbert index as
+ * proposed by J. Skilling, then interleaving of its bits).
+ *
+ */
+static uint64_t MMG3D_hilbertKey(double c[3],double min[3],double dd) {
+  uint64_t     key;
+  uint32_t     x[3],m,p,q,t;
+  double       dx;
+  int          i,j;
+
+  m = 1u << (MMG3D_HILBERT_BITS-1);
+  for (i=0; i<3; i++) {
+    dx   = (c[i]-min[i])*dd*(double)(2*m);
+    x[i] = (dx <= 0.) ? 0 : ( dx >= (double)(2*m-1) ? 2*m-1 : (uint32_t)dx );
+  }
+
+  /* inverse undo */
+  for (q=m; q>1; q>>=1) {
+    p = q-1;
+    for (i=0; i<3; i++) {
+      if ( x[i] & q )  x[0] ^= p;
+      else {
+        t     = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  /* gray encode */
+  for (i=1; i<3; i++)  x[i] ^= x[i-1];
+  t = 0;
+  for (q=m; q>1; q>>=1)
+    if ( x[2] & q )  t ^= q-1;
+  for (i=0; i<3; i++)  x[i] ^= t;
+
+  key = 0;
+  for (j=MMG3D_HILBERT_BITS-1; j>=0; j--)
+    for (i=0; i<3; i++)
+      key = (key << 1) | ((x[i] >> j) & 1);
+
+  return key;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param perm permutation table (\a perm[k] is the new index of the point k).
+ * \param sol pointer toward a solution structure (or NULL).
+ * \param sol2 pointer toward a second solution structure (or NULL).
+ *
+ * Move the points (and their solution values) to their new position. The
+ * permutation table is reset to the identity.
+ *
+ */
+static void MMG3D_permutePoints(MMG5_pMesh mesh,int *perm,MMG5_pSol sol,
+                                MMG5_pSol sol2) {
+  MMG5_Point  pttmp;
+  double      vtmp;
+  int         k,i,j,tmp;
+
+  for (k=1; k<=mesh->np; k++) {
+    while ( perm[k] != k ) {
+      j = perm[k];
+      memcpy(&pttmp        ,&mesh->point[j],sizeof(MMG5_Point));
+      memcpy(&mesh->point[j],&mesh->point[k],sizeof(MMG5_Point));
+      memcpy(&mesh->point[k],&pttmp        ,sizeof(MMG5_Point));
+      if ( sol && sol->m ) {
+        for (i=0; i<sol->size; i++) {
+          vtmp                       = sol->m[j*sol->size+i];
+          sol->m[j*sol->size+i]      = sol->m[k*sol->size+i];
+          sol->m[k*sol->size+i]      = vtmp;
+        }
+      }
+      if ( sol2 && sol2->m ) {
+        for (i=0; i<sol2->size; i++) {
+          vtmp                       = sol2->m[j*sol2->size+i];
+          sol2->m[j*sol2->size+i]    = sol2->m[k*sol2->size+i];
+          sol2->m[k*sol2->size+i]    = vtmp;
+        }
+      }
+      tmp     = perm[j];
+      perm[j] = j;
+      perm[k] = tmp;
+    }
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the solution (metric or level-set) structure.
+ * \param disp pointer toward the displacement structure (or NULL).
+ * \return 0 if fail and the adjacency can't be rebuilt, 1 otherwise (the mesh
+ * is unchanged if the renumbering fails).
+ *
+ * Renumber the vertices and the tetrahedra of a packed mesh along a Hilbert
+ * curve of its bounding box so that neighbouring entities are close in memory.
+ * The triangles and edges are not renumbered (they are rebuilt from the
+ * tetrahedra) and the adjacency is rebuilt if it was allocated.
+ *
+ */
+int MMG3D_hilbertRenumbering(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
+  MMG5_pTetra        pt;
+  MMG5_pPrism        pp;
+  MMG5_pQuad         pq;
+  MMG5_Tetra         pttmp;
+  MMG3D_hilbertCell  *cell;
+  double             min[3],max[3],c[3],dd;
+  int                *perm,k,i,j,n,tmp;
+
+  if ( mesh->np < 2 || mesh->ne < 2 )  return 1;
+
+  n = MG_MAX(mesh->np,mesh->ne);
+  MMG5_ADD_MEM(mesh,(n+1)*sizeof(MMG3D_hilbertCell),"Hilbert keys",return 1);
+  MMG5_SAFE_CALLOC(cell,n+1,MMG3D_hilbertCell,return 1);
+  MMG5_ADD_MEM(mesh,(n+1)*sizeof(int),"Hilbert permutation",
+               MMG5_DEL_MEM(mesh,cell);return 1);
+  MMG5_SAFE_CALLOC(perm,n+1,int,MMG5_DEL_MEM(mesh,cell);return 1);
+
+  if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+    fprintf(stdout,"  ** HILBERT RENUMBERING\n");
+
+  for (i=0; i<3; i++) {
+    min[i] =  DBL_MAX;
+    max[i] = -DBL_MAX;
+  }
+  for (k=1; k<=mesh->np; k++) {
+    for (i=0; i<3; i++) {
+      min[i] = MG_MIN(min[i],mesh->point[k].c[i]);
+      max[i] = MG_MAX(max[i],mesh->point[k].c[i]);
+    }
+  }
+  dd = MG_MAX(max[0]-min[0],MG_MAX(max[1]-min[1],max[2]-min[2]));
+  if ( dd < MMG5_EPSD ) {
+    MMG5_DEL_MEM(mesh,perm);
+    MMG5_DEL_MEM(mesh,cell);
+    return 1;
+  }
+  dd = 1./dd;
+
+  /* vertices */
+  for (k=1; k<=mesh->np; k++) {
+    cell[k-1].key = MMG3D_hilbertKey(mesh->point[k].c,min,dd);
+    cell[k-1].idx = k;
+  }
+  qsort(cell,mesh->np,sizeof(MMG3D_hilbertCell),MMG3D_cmpHilbert);
+  for (k=1; k<=mesh->np; k++)
+    perm[cell[k-1].idx] = k;
+
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    for (i=0; i<4; i++)  pt->v[i] = perm[pt->v[i]];
+  }
+  for (k=1; k<=mesh->nprism; k++) {
+    pp = &mesh->prism[k];
+    for (i=0; i<6; i++)  pp->v[i] = perm[pp->v[i]];
+  }
+  for (k=1; k<=mesh->nquad; k++) {
+    pq = &mesh->quadra[k];
+    for (i=0; i<4; i++)  pq->v[i] = perm[pq->v[i]];
+  }
+  MMG3D_permutePoints(mesh,perm,met,disp);
+
+  /* tetrahedra, following their barycenter */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    for (i=0; i<3; i++) {
+      c[i] = 0.;
+      for (j=0; j<4; j++)  c[i] += mesh->point[pt->v[j]].c[i];
+      c[i] *= 0.25;
+    }
+    cell[k-1].key = MMG3D_hilbertKey(c,min,dd);
+    cell[k-1].idx = k;
+  }
+  qsort(cell,mesh->ne,sizeof(MMG3D_hilbertCell),MMG3D_cmpHilbert);
+  for (k=1; k<=mesh->ne; k++)
+    perm[cell[k-1].idx] = k;
+
+  for (k=1; k<=mesh->ne; k++) {
+    while ( perm[k] != k ) {
+      j = perm[k];
+      memcpy(&pttmp        ,&mesh->tetra[j],sizeof(MMG5_Tetra));
+      memcpy(&mesh->tetra[j],&mesh->tetra[k],sizeof(MMG5_Tetra));
+      memcpy(&mesh->tetra[k],&pttmp        ,sizeof(MMG5_Tetra));
+      tmp     = perm[j];
+      perm[j] = j;
+      perm[k] = tmp;
+    }
+  }
+
+  MMG5_DEL_MEM(mesh,perm);
+  MMG5_DEL_MEM(mesh,cell);
+
+  /* the adjacency of the tetrahedra is no more valid */
+  if ( mesh->adja ) {
+    MMG5_DEL_MEM(mesh,mesh->adja);
+    if ( !MMG3D_hashTetra(mesh,0) )  return 0;
+  }
+
+  return 1;
+}
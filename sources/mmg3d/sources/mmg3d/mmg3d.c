@@ -646,6 +646,9 @@ int main(int argc,char *argv[]) {
   else if ( mesh->info.iso ) {
     ier = MMG3D_mmg3dls(mesh,met);
   }
+  else if ( mesh->info.npart > 1 ) {
+    ier = MMG3D_mmg3dpart(mesh,met);
+  }
   else {
     ier = MMG3D_mmg3dlib(mesh,met);
   }
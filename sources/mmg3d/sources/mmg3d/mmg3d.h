@@ -296,6 +296,7 @@ int  MMG5_chkmani(MMG5_pMesh mesh);
 int  MMG5_colver(MMG5_pMesh,MMG5_pSol,int *,int,char,char);
 int  MMG3D_analys(MMG5_pMesh mesh);
 void MMG3D_set_reqBoundaries(MMG5_pMesh mesh);
+int  MMG3D_set_reqBand(MMG5_pMesh mesh,MMG5_pSol sol);
 int  MMG5_chkVertexConnectedDomains(MMG5_pMesh mesh);
 int  MMG5_norver(MMG5_pMesh mesh);
 int  MMG5_setadj(MMG5_pMesh mesh);
@@ -442,6 +443,7 @@ void MMG5_printTetra(MMG5_pMesh mesh,char* fileName);
 #ifdef USE_SCOTCH
 int MMG5_mmg3dRenumbering(int vertBoxNbr, MMG5_pMesh mesh, MMG5_pSol sol);
 #endif
+int MMG3D_hilbertRenumbering(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp);
 
 int    MMG5_meancur(MMG5_pMesh mesh,int np,double c[3],int ilist,int *list,double h[3]);
 double MMG5_surftri(MMG5_pMesh,int,int);
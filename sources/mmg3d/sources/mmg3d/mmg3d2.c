@@ -348,6 +348,8 @@ MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
  * Snap values of the level set function very close to 0 to exactly 0,
  * and prevent nonmanifold patterns from being generated.
  *
+ * \remark the tetra adjacency is kept since the mesh is not modified here.
+ *
  */
 static int MMG3D_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
   MMG5_pTetra   pt;
@@ -366,8 +368,10 @@ static int MMG3D_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
   for (k=1; k<=mesh->np; k++)
     mesh->point[k].flag = 0;
 
-  /* Snap values of sol that are close to 0 to 0 exactly */
+  /* Snap values of sol that are close to 0 to 0 exactly (points are
+   * independent) */
   ns = nc = 0;
+#pragma omp parallel for private(p0) reduction(+:ns)
   for (k=1; k<=mesh->np; k++) {
     p0 = &mesh->point[k];
     if ( !MG_VOK(p0) ) continue;
@@ -405,9 +409,6 @@ static int MMG3D_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
   if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && ns+nc > 0 )
     fprintf(stdout,"     %8d points snapped, %d corrected\n",ns,nc);
 
-  /* memory free */
-  MMG5_DEL_MEM(mesh,mesh->adja);
-
   return 1;
 }
 
@@ -419,6 +420,14 @@ static int MMG3D_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
  * Proceed to discretization of the implicit function carried by sol into mesh,
  * once values of sol have been snapped/checked
  *
+ * \remark the tetra crossed by the level set are first marked in parallel, so
+ * that the (serial) creation of points and splitting of tetra only travel
+ * them, in the same order as before. Only this marking is parallel: the edge
+ * hashing (MMG5_hashNew/MMG5_hashEdge), the creation of the intersection
+ * points (MMG3D_newPt) and the splitting (MMG5_split*) update shared counters
+ * and free lists of the mesh and remain sequential, their cost being now
+ * proportional to the number of crossed tetra.
+ *
  */
 static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
   MMG5_pTetra   pt;
@@ -427,7 +436,7 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
   MMG5_Hash     hash;
   double        c[3],v0,v1,s;
   int           vx[6],nb,k,ip0,ip1,np,ns,ne,ier;
-  char          ia,j,npneg;
+  char          *cut,ia,j,npneg;
   static char   mmgWarn = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -438,9 +447,29 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
   for (k=1; k<=mesh->np; k++)
     mesh->point[k].flag = 0;
 
+  /* mark the tetra having an edge with non null values of opposite signs */
+  MMG5_ADD_MEM(mesh,(mesh->ne+1)*sizeof(char),"crossed tetra",
+                fprintf(stderr,"  Exit program.\n");
+                return 0);
+  MMG5_SAFE_CALLOC(cut,mesh->ne+1,char,return 0);
+
+#pragma omp parallel for private(pt,ia,v0,v1)
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    for (ia=0; ia<6; ia++) {
+      v0 = sol->m[pt->v[MMG5_iare[ia][0]]]-mesh->info.ls;
+      v1 = sol->m[pt->v[MMG5_iare[ia][1]]]-mesh->info.ls;
+      if ( fabs(v0) > MMG5_EPSD2 && fabs(v1) > MMG5_EPSD2 && !MG_SMSGN(v0,v1) ) {
+        cut[k] = 1;
+        break;
+      }
+    }
+  }
+
   /* compute the number nb of intersection points on edges */
   nb = 0;
   for (k=1; k<=mesh->ne; k++) {
+    if ( !cut[k] )  continue;
     pt = &mesh->tetra[k];
     for (ia=0; ia<6; ia++) {
       ip0 = pt->v[MMG5_iare[ia][0]];
@@ -462,7 +491,10 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
       }
     }
   }
-  if ( ! nb )  return 1;
+  if ( ! nb ) {
+    MMG5_DEL_MEM(mesh,cut);
+    return 1;
+  }
 
   /* Create intersection points at 0 isovalue and set flags to tetras */
   if ( !MMG5_hashNew(mesh,&hash,nb,7*nb) ) return 0;
@@ -502,7 +534,7 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
 
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
-    if ( !MG_EOK(pt) )  continue;
+    if ( !MG_EOK(pt) || !cut[k] )  continue;
 
     for (ia=0; ia<6; ia++) {
       ip0 = pt->v[MMG5_iare[ia][0]];
@@ -572,6 +604,7 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     pt->flag = 0;
+    if ( !cut[k] )  continue;
     memset(vx,0,6*sizeof(int));
     for (ia=0; ia<6; ia++) {
       vx[ia] = MMG5_hashGet(&hash,pt->v[MMG5_iare[ia][0]],pt->v[MMG5_iare[ia][1]]);
@@ -608,6 +641,7 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
   if ( (mesh->info.ddebug || abs(mesh->info.imprim) > 5) && ns > 0 )
     fprintf(stdout,"     %7d splitted\n",ns);
 
+  MMG5_DEL_MEM(mesh,cut);
   MMG5_DEL_MEM(mesh,hash.item);
   return ns;
 }
@@ -618,7 +652,8 @@ static int MMG3D_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol){
  * \param sol pointer toward the level-set values.
  * \return 1.
  *
- * Set references to tets according to the sign of the level set function.
+ * Set references to tets according to the sign of the level set function
+ * (tetra are independent).
  *
  */
 static int MMG3D_setref_ls(MMG5_pMesh mesh, MMG5_pSol sol) {
@@ -627,6 +662,7 @@ static int MMG3D_setref_ls(MMG5_pMesh mesh, MMG5_pSol sol) {
   int      k,ip;
   char     nmns,npls,nz,i;
 
+#pragma omp parallel for private(pt,v,ip,nmns,npls,nz,i)
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
     nmns = npls = nz = 0;
@@ -1469,6 +1505,7 @@ int MMG3D_mmg3d2(MMG5_pMesh mesh,MMG5_pSol sol) {
   }
   MMG5_DEL_MEM(mesh,tmp);
 
+  /* adjacency built by MMG3D_snpval_ls (nothing to do if still allocated) */
   if ( !MMG3D_hashTetra(mesh,1) ) {
     fprintf(stderr,"\n  ## Hashing problem. Exit program.\n");
     return 0;
@@ -1511,6 +1548,9 @@ int MMG3D_mmg3d2(MMG5_pMesh mesh,MMG5_pSol sol) {
     return 0;
   }
 
+  /* Freeze the tetra far from the isosurface (-band option) */
+  MMG3D_set_reqBand(mesh,sol);
+
   /* Clean memory */
   MMG5_DEL_MEM(mesh,sol->m);
 
@@ -625,8 +625,11 @@ int MMG5_mmg3d3(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met) {
   for (itmn=0; itmn<maxitmn; itmn++) {
     nnnspl = nnnc = nnns = nnnm = 0;
 
-    /* Extension of the velocity field */
-    if ( !MMG5_velextLS(mesh,disp) ) {
+    /* Extension of the velocity field (unless the input one is already
+     * extended): with noext, only the first extension is skipped, the
+     * displacement left after a partial motion being extended again since
+     * the mesh has been modified */
+    if ( (itmn || !mesh->info.noext) && !MMG5_velextLS(mesh,disp) ) {
       fprintf(stderr,"\n  ## Problem in func. MMG5_packLS. Exit program.\n");
       return 0;
     }
@@ -0,0 +1,844 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/CNRS/Inria/UBordeaux/UPMC, 2004-
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/partition_3d.c
+ * \brief Shared memory parallel remeshing by partitions with frozen interfaces.
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The mesh is cut into slabs along the longest side of its bounding box. Each
+ * slab is extracted in a submesh whose faces at the interface with the other
+ * slabs are parallel boundaries (\a MG_PARBDY, thus required), the submeshes
+ * are remeshed in parallel by \ref MMG3D_mmg3dlib and merged back. A second
+ * pass with slabs shifted by half a slab width remeshes the former interfaces.
+ */
+
+#include "mmg3d.h"
+
+/** Minimal number of tetrahedra per partition */
+#define MMG3D_NEPART  5000
+
+/** Number of remeshing passes (the second one remeshes the interfaces of the
+ * first one) */
+#define MMG3D_NPASS      2
+
+static int MMG3D_cmpCoor(const void *a,const void *b) {
+  double da,db;
+
+  da = *(const double*)a;
+  db = *(const double*)b;
+
+  return (da > db) - (da < db);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Compute the default values of hmin/hmax on the whole mesh if they are not
+ * provided by the user, so that all the partitions are remeshed with the same
+ * ones (they would be computed from the partition bounding boxes otherwise).
+ *
+ */
+static int MMG3D_partSizes(MMG5_pMesh mesh,MMG5_pSol met) {
+  double   *m,lambda[3],v[3][3],h,dd;
+  int      k,i;
+  char     sethmin,sethmax;
+
+  sethmin = ( mesh->info.hmin > 0. );
+  sethmax = ( mesh->info.hmax > 0. );
+  if ( sethmin && sethmax )  return 1;
+
+  if ( met->m ) {
+    if ( !sethmin )  mesh->info.hmin = FLT_MAX;
+    if ( !sethmax )  mesh->info.hmax = 0.;
+
+    for (k=1; k<=mesh->np; k++) {
+      if ( !MG_VOK(&mesh->point[k]) )  continue;
+
+      if ( met->size == 1 ) {
+        if ( !sethmin )  mesh->info.hmin = MG_MIN(mesh->info.hmin,met->m[k]);
+        if ( !sethmax )  mesh->info.hmax = MG_MAX(mesh->info.hmax,met->m[k]);
+        continue;
+      }
+      m = &met->m[6*k];
+      /* Wrong metrics are reported by the remeshing of the partitions */
+      if ( !MMG5_eigenv(1,m,lambda,v) )  continue;
+      for (i=0; i<3; i++) {
+        if ( lambda[i] <= 0. )  continue;
+        h = 1./sqrt(lambda[i]);
+        if ( !sethmin )  mesh->info.hmin = MG_MIN(mesh->info.hmin,h);
+        if ( !sethmax )  mesh->info.hmax = MG_MAX(mesh->info.hmax,h);
+      }
+    }
+  }
+  else if ( (!mesh->info.optim) && mesh->info.hsiz <= 0. ) {
+    /* Default values from the bounding box (see MMG5_scaleMesh) */
+    if ( !MMG5_boundingBox(mesh) )  return 0;
+
+    dd = 1./mesh->info.delta;
+    mesh->info.hmin *= dd;
+    mesh->info.hmax *= dd;
+    if ( !MMG5_Set_defaultTruncatureSizes(mesh,sethmin,sethmax) )  return 0;
+    mesh->info.hmin *= mesh->info.delta;
+    mesh->info.hmax *= mesh->info.delta;
+  }
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param npart number of partitions.
+ * \param axis pointer toward the direction of the cuts.
+ * \param cut array of the \a npart-1 cuts of the first pass followed by the
+ * \a npart cuts of the second one.
+ * \return 1 if success, 0 if fail.
+ *
+ * Cut the mesh into \a npart slabs of the same number of tetrahedra along the
+ * longest side of its bounding box. The cuts of the second pass are the
+ * middles of the slabs of the first one.
+ *
+ */
+static int MMG3D_partCuts(MMG5_pMesh mesh,int npart,int *axis,double *cut) {
+  MMG5_pTetra    pt;
+  double         *x,c[2],lmax;
+  int            k,i,ne;
+
+  if ( !MMG5_boundingBox(mesh) )  return 0;
+
+  *axis = 0;
+  lmax  = mesh->info.max[0] - mesh->info.min[0];
+  for (i=1; i<3; i++) {
+    if ( mesh->info.max[i] - mesh->info.min[i] > lmax ) {
+      lmax  = mesh->info.max[i] - mesh->info.min[i];
+      *axis = i;
+    }
+  }
+
+  MMG5_ADD_MEM(mesh,(mesh->ne+1)*sizeof(double),"centers",return 0);
+  MMG5_SAFE_CALLOC(x,mesh->ne+1,double,return 0);
+
+  ne = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    x[ne++] = 0.25 * ( mesh->point[pt->v[0]].c[*axis]
+                       + mesh->point[pt->v[1]].c[*axis]
+                       + mesh->point[pt->v[2]].c[*axis]
+                       + mesh->point[pt->v[3]].c[*axis] );
+  }
+  qsort(x,ne,sizeof(double),MMG3D_cmpCoor);
+
+  for (i=1; i<npart; i++)
+    cut[i-1] = x[(int)((double)i*ne/npart)];
+
+  /* shifted cuts */
+  for (i=0; i<npart; i++) {
+    c[0] = ( i > 0 )        ? cut[i-1] : mesh->info.min[*axis];
+    c[1] = ( i < npart-1 )  ? cut[i]   : mesh->info.max[*axis];
+    cut[npart-1+i] = 0.5 * ( c[0] + c[1] );
+  }
+
+  MMG5_DEL_MEM(mesh,x);
+
+  return 1;
+}
+
+/**
+ * \struct MMG3D_Part
+ * \brief Partitions of the mesh during a remeshing pass.
+ */
+typedef struct {
+  MMG5_pMesh    *sub; /*!< submeshes of the partitions */
+  MMG5_pSol     *met; /*!< metrics of the submeshes */
+  int           **lifc; /*!< interface vertices of each partition (indices
+                          in the mesh, by increasing order) */
+  int           *nifc; /*!< number of interface vertices of each partition */
+  int           *ier; /*!< return value of the remeshing of each partition */
+  int           *part; /*!< partition of each tetrahedron */
+  int           *gifc; /*!< index of each interface vertex in the merged mesh */
+  int           *lmap; /*!< work array on the vertices */
+  int           *emark; /*!< work array on the edges */
+  int           nsub,ng;
+  MMG5_Hash     htri; /*!< triangles of the mesh */
+  MMG5_Hash     hedg; /*!< edges of the mesh */
+  MMG5_Hash     hfac; /*!< interface faces: 1 if the face is removed from the
+                        merged mesh, 2+p if it is a triangle of partition p */
+} MMG3D_Part;
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param prt pointer toward the partitions.
+ *
+ * Free the partitions.
+ *
+ */
+static void MMG3D_partFree(MMG5_pMesh mesh,MMG3D_Part *prt) {
+  int   p;
+
+  for (p=0; p<prt->nsub; p++) {
+    if ( prt->sub && prt->sub[p] )
+      MMG3D_Free_all(MMG5_ARG_start,
+                     MMG5_ARG_ppMesh,&prt->sub[p],MMG5_ARG_ppMet,&prt->met[p],
+                     MMG5_ARG_end);
+    if ( prt->lifc && prt->lifc[p] )
+      MMG5_DEL_MEM(mesh,prt->lifc[p]);
+  }
+  if ( prt->sub )         MMG5_DEL_MEM(mesh,prt->sub);
+  if ( prt->met )         MMG5_DEL_MEM(mesh,prt->met);
+  if ( prt->lifc )        MMG5_DEL_MEM(mesh,prt->lifc);
+  if ( prt->nifc )        MMG5_DEL_MEM(mesh,prt->nifc);
+  if ( prt->ier )         MMG5_DEL_MEM(mesh,prt->ier);
+  if ( prt->part )        MMG5_DEL_MEM(mesh,prt->part);
+  if ( prt->gifc )        MMG5_DEL_MEM(mesh,prt->gifc);
+  if ( prt->lmap )        MMG5_DEL_MEM(mesh,prt->lmap);
+  if ( prt->emark )       MMG5_DEL_MEM(mesh,prt->emark);
+  if ( prt->htri.item )   MMG5_DEL_MEM(mesh,prt->htri.item);
+  if ( prt->hedg.item )   MMG5_DEL_MEM(mesh,prt->hedg.item);
+  if ( prt->hfac.item )   MMG5_DEL_MEM(mesh,prt->hfac.item);
+  if ( mesh->adja )       MMG5_DEL_MEM(mesh,mesh->adja);
+}
+
+/** Allocate an array of the partitions of \a prt during a remeshing pass */
+#define MMG3D_PART_CALLOC(mesh,prt,ptr,n,type,message) do               \
+  {                                                                     \
+    MMG5_ADD_MEM(mesh,(n)*sizeof(type),message,                         \
+                 MMG3D_partFree(mesh,prt);return MMG5_LOWFAILURE);      \
+    MMG5_SAFE_CALLOC(ptr,n,type,                                        \
+                     MMG3D_partFree(mesh,prt);return MMG5_LOWFAILURE);  \
+  }while(0)
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sub pointer toward the submesh of a partition.
+ * \return 1 if success, 0 if fail.
+ *
+ * Copy the parameters of the mesh into a submesh. The renumbering is disabled
+ * since the interface vertices are identified by their order in the remeshed
+ * submesh, and the partitions are remeshed silently.
+ *
+ */
+static int MMG3D_partInfo(MMG5_pMesh mesh,MMG5_pMesh sub) {
+
+  sub->info        = mesh->info;
+  sub->info.par    = NULL;
+  sub->info.mat    = NULL;
+  sub->info.nmat   = 0;
+  sub->info.npart  = 0;
+  sub->info.renum  = MMG5_OFF;
+  sub->info.imprim = -1;
+
+  if ( mesh->info.npar && mesh->info.par ) {
+    MMG5_ADD_MEM(sub,mesh->info.npar*sizeof(MMG5_Par),"parameters",return 0);
+    MMG5_SAFE_CALLOC(sub->info.par,mesh->info.npar,MMG5_Par,return 0);
+    memcpy(sub->info.par,mesh->info.par,mesh->info.npar*sizeof(MMG5_Par));
+  }
+  else
+    sub->info.npar = 0;
+
+  return 1;
+}
+
+/**
+ * \param ptt pointer toward a triangle of the mesh.
+ * \param pttn pointer toward the triangle of the submesh.
+ * \param lmap local index of the vertices.
+ *
+ * Copy a triangle of the mesh into a submesh.
+ *
+ */
+static inline
+void MMG3D_partTria(MMG5_pTria ptt,MMG5_pTria pttn,int *lmap) {
+  int   j;
+
+  for (j=0; j<3; j++) {
+    pttn->v[j]   = lmap[ptt->v[j]];
+    pttn->tag[j] = ptt->tag[j];
+    pttn->edg[j] = ptt->edg[j];
+  }
+  pttn->ref = ptt->ref;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (with adjacency).
+ * \param met pointer toward the metric structure (NULL to remesh the
+ * partitions without metric).
+ * \param prt pointer toward the partitions.
+ * \param p index of the partition to extract.
+ * \return 1 if success, 0 if fail.
+ *
+ * Build the submesh of partition \a p: its tetrahedra, the mesh triangles and
+ * edges lying on them and a triangle tagged \a MG_PARBDY on each face at the
+ * interface with another partition. The vertices keep their relative order.
+ *
+ */
+static int MMG3D_partExtract(MMG5_pMesh mesh,MMG5_pSol met,MMG3D_Part *prt,
+                             int p) {
+  MMG5_pMesh   sub;
+  MMG5_pSol    smet;
+  MMG5_pTetra  pt,ptn;
+  MMG5_pTria   pttn;
+  MMG5_pEdge   pa,pan;
+  MMG5_pPoint  ppt,pptn;
+  int          *lmap,*adja,k,kt,ke,adj,ip,np,ne,nt,na,ni,ia,ib,ic;
+  char         i,j;
+
+  lmap = prt->lmap;
+
+  /* vertices of the partition (-1) and of its interfaces (-2) */
+  ne = nt = na = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || prt->part[k] != p )  continue;
+    ne++;
+    for (j=0; j<4; j++)
+      if ( !lmap[pt->v[j]] )  lmap[pt->v[j]] = -1;
+
+    adja = &mesh->adja[4*(k-1)+1];
+    for (i=0; i<4; i++) {
+      adj = adja[i] / 4;
+      ia  = pt->v[MMG5_idir[i][0]];
+      ib  = pt->v[MMG5_idir[i][1]];
+      ic  = pt->v[MMG5_idir[i][2]];
+      if ( adj && prt->part[adj] != p ) {
+        lmap[ia] = lmap[ib] = lmap[ic] = -2;
+        nt++;
+      }
+      else if ( (!adj || k < adj) && MMG5_hashGetFace(&prt->htri,ia,ib,ic) )
+        nt++;
+    }
+    if ( !prt->hedg.item )  continue;
+    for (i=0; i<6; i++) {
+      ke = MMG5_hashGet(&prt->hedg,pt->v[MMG5_iare[i][0]],pt->v[MMG5_iare[i][1]]);
+      if ( ke && prt->emark[ke] != p+1 ) {
+        prt->emark[ke] = p+1;
+        na++;
+      }
+    }
+  }
+  if ( !ne )  return 1;
+
+  /* local numbering, by increasing index */
+  np = ni = 0;
+  for (ip=1; ip<=mesh->np; ip++) {
+    if ( !lmap[ip] )  continue;
+    np++;
+    if ( lmap[ip] == -2 )  ni++;
+  }
+  MMG5_ADD_MEM(mesh,(ni+1)*sizeof(int),"interface vertices",return 0);
+  MMG5_SAFE_CALLOC(prt->lifc[p],ni+1,int,return 0);
+  prt->nifc[p] = ni;
+
+  np = ni = 0;
+  for (ip=1; ip<=mesh->np; ip++) {
+    if ( !lmap[ip] )  continue;
+    if ( lmap[ip] == -2 )  prt->lifc[p][ni++] = ip;
+    lmap[ip] = ++np;
+  }
+
+  /* submesh */
+  MMG3D_Init_mesh(MMG5_ARG_start,
+                  MMG5_ARG_ppMesh,&prt->sub[p],MMG5_ARG_ppMet,&prt->met[p],
+                  MMG5_ARG_end);
+  sub  = prt->sub[p];
+  smet = prt->met[p];
+  if ( !MMG3D_partInfo(mesh,sub) )  return 0;
+
+  /* the arrays are sized from the partition (and not from the default minimal
+   * sizes) and the partitions share the memory of the mesh */
+  if ( !MMG3D_setMeshSize_initData(sub,np,ne,0,nt,0,na) )  return 0;
+  sub->memMax = mesh->memMax / prt->nsub;
+  sub->npmax  = 1.5*np;
+  sub->nemax  = 1.5*ne;
+  sub->ntmax  = 1.5*nt + 1;
+  if ( !MMG3D_memOption_memRepartition(sub) )  return 0;
+  if ( !MMG3D_setMeshSize_alloc(sub) )  return 0;
+  if ( !MMG3D_Set_solSize(sub,smet,MMG5_Vertex,(met && met->m) ? np : 0,
+                          (met && met->size == 6) ? MMG5_Tensor : MMG5_Scalar) )
+    return 0;
+
+  for (ip=1; ip<=mesh->np; ip++) {
+    if ( !lmap[ip] )  continue;
+    ppt  = &mesh->point[ip];
+    pptn = &sub->point[lmap[ip]];
+    memcpy(pptn->c,ppt->c,3*sizeof(double));
+    pptn->ref = ppt->ref;
+    pptn->tag = ppt->tag & ~MG_NUL;
+    if ( smet->m )
+      memcpy(&smet->m[smet->size*lmap[ip]],&met->m[met->size*ip],
+             met->size*sizeof(double));
+  }
+
+  ne = nt = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || prt->part[k] != p )  continue;
+    ptn = &sub->tetra[++ne];
+    for (j=0; j<4; j++)
+      ptn->v[j] = lmap[pt->v[j]];
+    ptn->ref = pt->ref;
+    ptn->tag = pt->tag;
+
+    adja = &mesh->adja[4*(k-1)+1];
+    for (i=0; i<4; i++) {
+      adj = adja[i] / 4;
+      ia  = pt->v[MMG5_idir[i][0]];
+      ib  = pt->v[MMG5_idir[i][1]];
+      ic  = pt->v[MMG5_idir[i][2]];
+      kt  = MMG5_hashGetFace(&prt->htri,ia,ib,ic);
+      if ( adj && prt->part[adj] != p ) {
+        pttn = &sub->tria[++nt];
+        if ( kt )
+          MMG3D_partTria(&mesh->tria[kt],pttn,lmap);
+        else {
+          pttn->v[0] = lmap[ia];
+          pttn->v[1] = lmap[ib];
+          pttn->v[2] = lmap[ic];
+        }
+        pttn->tag[0] |= MG_PARBDY;
+        pttn->tag[1] |= MG_PARBDY;
+        pttn->tag[2] |= MG_PARBDY;
+      }
+      else if ( kt && (!adj || k < adj) )
+        MMG3D_partTria(&mesh->tria[kt],&sub->tria[++nt],lmap);
+    }
+  }
+
+  na = 0;
+  for (k=1; k<=mesh->na; k++) {
+    if ( prt->emark[k] != p+1 )  continue;
+    pa  = &mesh->edge[k];
+    pan = &sub->edge[++na];
+    pan->a   = lmap[pa->a];
+    pan->b   = lmap[pa->b];
+    pan->ref = pa->ref;
+    pan->tag = pa->tag;
+  }
+
+  for (ip=1; ip<=mesh->np; ip++)
+    lmap[ip] = 0;
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param prt pointer toward the remeshed partitions.
+ * \return 1 if success, 0 if the interfaces have not been preserved (the mesh
+ * is unchanged), -1 if fail.
+ *
+ * Replace the mesh by the union of the remeshed submeshes. The interface
+ * vertices keep their initial coordinates, the interface faces are removed
+ * unless they are triangles of the mesh (kept once) and the interface edges
+ * are kept only if they were edges of the mesh.
+ *
+ */
+static int MMG3D_partMerge(MMG5_pMesh mesh,MMG5_pSol met,MMG3D_Part *prt) {
+  MMG5_pMesh    sub;
+  MMG5_pSol     smet;
+  MMG5_pPoint   opoint,ppt,pptn;
+  MMG5_pEdge    oedge,pa,pan;
+  MMG5_pTria    ptt,pttn;
+  MMG5_pTetra   pt,ptn;
+  int           *lnew,*lold,p,k,ke,ip,np,ne,nt,na,onp,ona,f,j,size;
+  int16_t       tag;
+
+  /* the k-th vertex tagged MG_PARBDY of a remeshed submesh is its k-th
+   * interface vertex */
+  np   = prt->ng;
+  ne   = nt = na = 0;
+  size = 0;
+  for (p=0; p<prt->nsub; p++) {
+    sub = prt->sub[p];
+    if ( !sub )  continue;
+    j = 0;
+    for (k=1; k<=sub->np; k++)
+      if ( sub->point[k].tag & MG_PARBDY )  j++;
+    if ( j != prt->nifc[p] ) {
+      fprintf(stderr,"\n  ## Error: %s: interface of partition %d not"
+              " preserved (%d vertices instead of %d).\n",__func__,p,j,
+              prt->nifc[p]);
+      return 0;
+    }
+    np += sub->np - j;
+    ne += sub->ne;
+    nt += sub->nt;
+    na += sub->na;
+    if ( prt->met[p]->m )  size = prt->met[p]->size;
+  }
+
+  MMG5_DEL_MEM(mesh,mesh->adja);
+  opoint      = mesh->point;
+  oedge       = mesh->edge;
+  onp         = mesh->np;
+  ona         = mesh->na;
+  mesh->point = NULL;
+  mesh->edge  = NULL;
+  if ( !MMG3D_Set_meshSize(mesh,np,ne,0,nt,0,na) )  return -1;
+  if ( size ) {
+    if ( !MMG3D_Set_solSize(mesh,met,MMG5_Vertex,np,
+                            size == 6 ? MMG5_Tensor : MMG5_Scalar) )  return -1;
+  }
+  else if ( met->m ) {
+    MMG5_DEL_MEM(mesh,met->m);
+    met->np = 0;
+  }
+
+  /* interface vertices, with their initial coordinates */
+  for (ip=1; ip<=onp; ip++) {
+    if ( !prt->gifc[ip] )  continue;
+    ppt  = &opoint[ip];
+    pptn = &mesh->point[prt->gifc[ip]];
+    memcpy(pptn->c,ppt->c,3*sizeof(double));
+    pptn->ref = ppt->ref;
+    pptn->tag = ppt->tag & (MG_REQ | MG_CRN);
+  }
+  for (k=1; k<=ona; k++)
+    prt->emark[k] = 0;
+
+  np = prt->ng;
+  ne = nt = na = 0;
+  for (p=0; p<prt->nsub; p++) {
+    sub  = prt->sub[p];
+    smet = prt->met[p];
+    if ( !sub )  continue;
+
+    MMG5_ADD_MEM(mesh,2*(sub->np+1)*sizeof(int),"local indices",return -1);
+    MMG5_SAFE_CALLOC(lnew,2*(sub->np+1),int,return -1);
+    lold = &lnew[sub->np+1];
+
+    j = 0;
+    for (k=1; k<=sub->np; k++) {
+      ppt = &sub->point[k];
+      if ( ppt->tag & MG_PARBDY ) {
+        lold[k] = prt->lifc[p][j++];
+        lnew[k] = prt->gifc[lold[k]];
+        pptn    = &mesh->point[lnew[k]];
+        if ( pptn->flag )  continue;
+      }
+      else {
+        lnew[k] = ++np;
+        pptn    = &mesh->point[np];
+        memcpy(pptn->c,ppt->c,3*sizeof(double));
+        pptn->ref = ppt->ref;
+        pptn->tag = ppt->tag & (MG_REQ | MG_CRN);
+      }
+      pptn->flag = 1;
+      if ( met->m && smet->m )
+        memcpy(&met->m[size*lnew[k]],&smet->m[size*k],size*sizeof(double));
+    }
+
+    for (k=1; k<=sub->ne; k++) {
+      pt = &sub->tetra[k];
+      if ( !MG_EOK(pt) )  continue;
+      ptn = &mesh->tetra[++ne];
+      for (j=0; j<4; j++)
+        ptn->v[j] = lnew[pt->v[j]];
+      ptn->ref = pt->ref;
+      ptn->tag = pt->tag & MG_REQ;
+    }
+
+    for (k=1; k<=sub->nt; k++) {
+      ptt = &sub->tria[k];
+      if ( !MG_EOK(ptt) )  continue;
+      if ( lold[ptt->v[0]] && lold[ptt->v[1]] && lold[ptt->v[2]] ) {
+        f = MMG5_hashGetFace(&prt->hfac,lold[ptt->v[0]],lold[ptt->v[1]],
+                             lold[ptt->v[2]]);
+        if ( f == 1 || (f > 1 && f-2 != p) )  continue;
+      }
+      /* as for a saved mesh, only the required triangles keep a tag */
+      tag  = ptt->tag[0] & ptt->tag[1] & ptt->tag[2] & MG_REQ;
+      pttn = &mesh->tria[++nt];
+      for (j=0; j<3; j++) {
+        pttn->v[j]   = lnew[ptt->v[j]];
+        pttn->tag[j] = tag;
+        pttn->edg[j] = ptt->edg[j];
+      }
+      pttn->ref = ptt->ref;
+    }
+
+    for (k=1; k<=sub->na; k++) {
+      pa  = &sub->edge[k];
+      if ( lold[pa->a] && lold[pa->b] ) {
+        ke = MMG5_hashGet(&prt->hedg,lold[pa->a],lold[pa->b]);
+        if ( !ke || prt->emark[ke] )  continue;
+        prt->emark[ke] = 1;
+        pa = &oedge[ke];
+      }
+      pan = &mesh->edge[++na];
+      pan->a   = lnew[sub->edge[k].a];
+      pan->b   = lnew[sub->edge[k].b];
+      pan->ref = pa->ref;
+      pan->tag = MG_REF | (pa->tag & (MG_GEO | MG_REQ));
+    }
+
+    MMG5_DEL_MEM(mesh,lnew);
+  }
+
+  for (k=1; k<=np; k++)
+    mesh->point[k].flag = 0;
+
+  mesh->nt = mesh->nti = nt;
+  mesh->na = mesh->nai = na;
+
+  MMG5_DEL_MEM(mesh,opoint);
+  if ( oedge )  MMG5_DEL_MEM(mesh,oedge);
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param axis direction of the cuts.
+ * \param cut the \a nsub-1 cuts.
+ * \param nsub number of partitions.
+ * \param usemet 1 if the partitions are remeshed with the metric.
+ * \return \ref MMG5_SUCCESS if success, \ref MMG5_LOWFAILURE if fail but the
+ * mesh is conform, \ref MMG5_STRONGFAILURE otherwise.
+ *
+ * Remeshing pass: cut the mesh into \a nsub slabs, remesh them in parallel
+ * with their interfaces frozen and merge them.
+ *
+ */
+static int MMG3D_partPass(MMG5_pMesh mesh,MMG5_pSol met,int axis,double *cut,
+                          int nsub,int usemet) {
+  MMG3D_Part    prt;
+  MMG5_pTetra   pt,pt1;
+  double        c;
+  int           *adja,k,adj,p,nf,f,ia,ib,ic,ip,ier;
+  char          i;
+
+  memset(&prt,0,sizeof(MMG3D_Part));
+  prt.nsub = nsub;
+
+  MMG3D_Free_topoTables(mesh);
+  if ( !MMG3D_hashTetra(mesh,0) ) {
+    fprintf(stderr,"\n  ## Hashing problem. Exit program.\n");
+    return MMG5_LOWFAILURE;
+  }
+
+  MMG3D_PART_CALLOC(mesh,&prt,prt.sub,nsub,MMG5_pMesh,"submeshes");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.met,nsub,MMG5_pSol,"submetrics");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.lifc,nsub,int*,"interface vertices");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.nifc,nsub,int,"interface vertices");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.ier,nsub,int,"return values");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.part,mesh->ne+1,int,"partition");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.gifc,mesh->np+1,int,"interface vertices");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.lmap,mesh->np+1,int,"local indices");
+  MMG3D_PART_CALLOC(mesh,&prt,prt.emark,mesh->na+1,int,"edges");
+
+  /* partition of the tetrahedra */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    c = 0.25 * ( mesh->point[pt->v[0]].c[axis] + mesh->point[pt->v[1]].c[axis]
+                 + mesh->point[pt->v[2]].c[axis] + mesh->point[pt->v[3]].c[axis] );
+    for (p=0; p<nsub-1 && c >= cut[p]; p++) ;
+    prt.part[k] = p;
+  }
+
+  /* triangles and edges of the mesh */
+  if ( mesh->nt ) {
+    if ( !MMG5_hashNew(mesh,&prt.htri,0.51*mesh->nt,1.51*mesh->nt) ) {
+      MMG3D_partFree(mesh,&prt);
+      return MMG5_LOWFAILURE;
+    }
+    for (k=1; k<=mesh->nt; k++) {
+      if ( !MMG5_hashFace(mesh,&prt.htri,mesh->tria[k].v[0],mesh->tria[k].v[1],
+                          mesh->tria[k].v[2],k) ) {
+        MMG3D_partFree(mesh,&prt);
+        return MMG5_LOWFAILURE;
+      }
+    }
+  }
+  if ( mesh->na ) {
+    if ( !MMG5_hashNew(mesh,&prt.hedg,mesh->na,3*mesh->na) ) {
+      MMG3D_partFree(mesh,&prt);
+      return MMG5_LOWFAILURE;
+    }
+    for (k=1; k<=mesh->na; k++) {
+      if ( !MMG5_hashEdge(mesh,&prt.hedg,mesh->edge[k].a,mesh->edge[k].b,k) ) {
+        MMG3D_partFree(mesh,&prt);
+        return MMG5_LOWFAILURE;
+      }
+    }
+  }
+
+  /* interface faces and vertices */
+  nf = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    adja = &mesh->adja[4*(k-1)+1];
+    for (i=0; i<4; i++) {
+      adj = adja[i] / 4;
+      if ( adj > k && prt.part[adj] != prt.part[k] )  nf++;
+    }
+  }
+  if ( !MMG5_hashNew(mesh,&prt.hfac,0.51*nf,1.51*nf) ) {
+    MMG3D_partFree(mesh,&prt);
+    return MMG5_LOWFAILURE;
+  }
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    adja = &mesh->adja[4*(k-1)+1];
+    for (i=0; i<4; i++) {
+      adj = adja[i] / 4;
+      if ( adj <= k || prt.part[adj] == prt.part[k] )  continue;
+      pt1 = &mesh->tetra[adj];
+      ia  = pt->v[MMG5_idir[i][0]];
+      ib  = pt->v[MMG5_idir[i][1]];
+      ic  = pt->v[MMG5_idir[i][2]];
+
+      /* the faces between two domains are kept by the first partition */
+      if ( pt->ref != pt1->ref ||
+           (mesh->info.opnbdy && MMG5_hashGetFace(&prt.htri,ia,ib,ic)) )
+        f = 2 + MG_MIN(prt.part[k],prt.part[adj]);
+      else
+        f = 1;
+      if ( !MMG5_hashFace(mesh,&prt.hfac,ia,ib,ic,f) ) {
+        MMG3D_partFree(mesh,&prt);
+        return MMG5_LOWFAILURE;
+      }
+      prt.gifc[ia] = prt.gifc[ib] = prt.gifc[ic] = 1;
+    }
+  }
+  prt.ng = 0;
+  for (ip=1; ip<=mesh->np; ip++)
+    if ( prt.gifc[ip] )  prt.gifc[ip] = ++prt.ng;
+
+  /* extraction of the partitions */
+  for (p=0; p<nsub; p++) {
+    if ( !MMG3D_partExtract(mesh,usemet ? met : NULL,&prt,p) ) {
+      fprintf(stderr,"\n  ## Error: %s: unable to extract partition %d.\n",
+              __func__,p);
+      MMG3D_partFree(mesh,&prt);
+      return MMG5_LOWFAILURE;
+    }
+  }
+
+  /* parallel remeshing */
+#pragma omp parallel for schedule(dynamic,1)
+  for (p=0; p<nsub; p++) {
+    if ( prt.sub[p] )
+      prt.ier[p] = MMG3D_mmg3dlib(prt.sub[p],prt.met[p]);
+  }
+
+  ier = MMG5_SUCCESS;
+  for (p=0; p<nsub; p++) {
+    if ( prt.ier[p] == MMG5_STRONGFAILURE ) {
+      fprintf(stderr,"\n  ## Error: %s: unable to remesh partition %d.\n",
+              __func__,p);
+      MMG3D_partFree(mesh,&prt);
+      return MMG5_LOWFAILURE;
+    }
+    ier = MG_MAX(ier,prt.ier[p]);
+  }
+
+  /* merge */
+  k = MMG3D_partMerge(mesh,met,&prt);
+  MMG3D_partFree(mesh,&prt);
+  if ( k < 0 )  return MMG5_STRONGFAILURE;
+  if ( !k )     return MMG5_LOWFAILURE;
+
+  return ier;
+}
+
+int MMG3D_mmg3dpart(MMG5_pMesh mesh,MMG5_pSol met) {
+  mytime    ctim[TIMEMAX];
+  char      stim[32],inputMet;
+  double    *cut;
+  int       npart,axis,ipass,nsub,ier,ret,inmet;
+
+  npart = MG_MIN(mesh->info.npart,mesh->ne/MMG3D_NEPART);
+
+  /* partitioned remeshing of the tetrahedral meshes with a metric only */
+  if ( npart < 2 || mesh->nprism || mesh->nquad || mesh->info.iso ||
+       mesh->info.lag > -1 || (met->size != 1 && met->size != 6) ||
+       (met->np && met->np != mesh->np) ) {
+    if ( mesh->info.imprim > 0 && mesh->info.npart > 1 )
+      fprintf(stdout,"\n  ## Warning: %s: partitioned remeshing unavailable,"
+              " the mesh is remeshed serially.\n",__func__);
+    return MMG3D_mmg3dlib(mesh,met);
+  }
+
+  if ( mesh->info.imprim >= 0 ) {
+    fprintf(stdout,"\n  %s\n   MODULE MMG3D: %s (%s)\n  %s\n",MG_STR,MG_VER,MG_REL,MG_STR);
+  }
+
+  tminit(ctim,TIMEMAX);
+  chrono(ON,&(ctim[0]));
+
+  /* the second pass remeshes without metric if none is provided */
+  inmet    = ( met->m != NULL );
+  inputMet = mesh->info.inputMet;
+
+  if ( !MMG3D_partSizes(mesh,met) )  _LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE);
+
+  MMG5_ADD_MEM(mesh,(2*npart)*sizeof(double),"cuts",
+               _LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE));
+  MMG5_SAFE_CALLOC(cut,2*npart,double,_LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE));
+
+  if ( !MMG3D_partCuts(mesh,npart,&axis,cut) ) {
+    MMG5_DEL_MEM(mesh,cut);
+    _LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE);
+  }
+
+  ret = MMG5_SUCCESS;
+  for (ipass=0; ipass<MMG3D_NPASS; ipass++) {
+    chrono(ON,&(ctim[ipass+1]));
+    nsub = npart + ipass;
+    if ( mesh->info.imprim > 0 )
+      fprintf(stdout,"\n  -- PASS %d : %d PARTITIONS\n",ipass+1,nsub);
+
+    ier = MMG3D_partPass(mesh,met,axis,ipass ? &cut[npart-1] : cut,nsub,
+                         !ipass || inmet);
+    mesh->info.inputMet = inputMet;
+    ret = MG_MAX(ret,ier);
+
+    chrono(OFF,&(ctim[ipass+1]));
+    if ( ier == MMG5_STRONGFAILURE )  break;
+
+    if ( mesh->info.imprim > 0 ) {
+      printim(ctim[ipass+1].gdif,stim);
+      fprintf(stdout,"     NUMBER OF VERTICES   %8d\n",mesh->np);
+      fprintf(stdout,"     NUMBER OF TETRAHEDRA %8d\n",mesh->ne);
+      fprintf(stdout,"  -- PASS %d COMPLETED.     %s\n",ipass+1,stim);
+    }
+  }
+  MMG5_DEL_MEM(mesh,cut);
+
+  chrono(OFF,&ctim[0]);
+  printim(ctim[0].gdif,stim);
+  if ( mesh->info.imprim >= 0 ) {
+    fprintf(stdout,"\n   MMG3DPART: ELAPSED TIME  %s\n",stim);
+    fprintf(stdout,"\n  %s\n   END OF MODULE MMG3D\n  %s\n\n",MG_STR,MG_STR);
+  }
+  _LIBMMG5_RETURN(mesh,met,ret);
+}
@@ -394,7 +394,7 @@ int initializeAdjacency(Parameters* pParameters, Mesh* pMesh)
 /* ************************************************************************** */
 int initializeLevelSetFunction(Parameters* pParameters, Mesh* pMesh)
 {
-    int l=0, lMax=0, lPoint=0;
+    int l=0, lMax=0, lPoint=0, pHexahedronVertex[8]={0};
     double value=0., dx=0., dy=0., dz=0., xMin=0., xMax=0., yMin=0.;
     double yMax=0., zMin=0., zMax=0., r0=0., x0=0., y0=0., z0=0.;
     Point *pPoint=NULL;
@@ -497,7 +497,9 @@ int initializeLevelSetFunction(Parameters* pParameters, Mesh* pMesh)
             for (l=0; l<lMax; l++)
             {
                 pHexahedron=&pMesh->phex[l];
-                lPoint=pHexahedron->p1;
+                getHexahedronVertices(l,pParameters->n_y,pParameters->n_z,
+                                                             pHexahedronVertex);
+                lPoint=pHexahedronVertex[0];
 
                 // Warning here: points are stored thanks to the .mesh file so
                 // do not forget to remove one from these int when calling a
@@ -669,7 +671,9 @@ int initializeLevelSetFunction(Parameters* pParameters, Mesh* pMesh)
             for (l=0; l<lMax; l++)
             {
                 pHexahedron=&pMesh->phex[l];
-                lPoint=pHexahedron->p1;
+                getHexahedronVertices(l,pParameters->n_y,pParameters->n_z,
+                                                             pHexahedronVertex);
+                lPoint=pHexahedronVertex[0];
 
                 // Warning here: points are stored thanks to the .mesh file so
                 // do not forget to remove one from these int when calling a
@@ -764,6 +768,7 @@ int getLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh)
     int i=0, j=0, k=0, l=0, lMax=0, p1=0, p2=0, p3=0, p4=0, p5=0, p6=0;
     int p7=0, p8=0, label=0, lLabel=0, counter=0, lPoint=0;
     int nX=0, nY=0, nZ=0, initialNumberOfQuadrilaterals=0;
+    int pHexahedronVertex[8]={0};
     Quadrilateral *pQuadrilateral=NULL;
     Hexahedron *pHexahedron=NULL;
 
@@ -917,14 +922,15 @@ int getLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh)
     for (l=0; l<lMax; l++)
     {
         pHexahedron=&pMesh->phex[l];
-        p1=pHexahedron->p1;
-        p2=pHexahedron->p2;
-        p3=pHexahedron->p3;
-        p4=pHexahedron->p4;
-        p5=pHexahedron->p5;
-        p6=pHexahedron->p6;
-        p7=pHexahedron->p7;
-        p8=pHexahedron->p8;
+        getHexahedronVertices(l,nY,nZ,pHexahedronVertex);
+        p1=pHexahedronVertex[0];
+        p2=pHexahedronVertex[1];
+        p3=pHexahedronVertex[2];
+        p4=pHexahedronVertex[3];
+        p5=pHexahedronVertex[4];
+        p6=pHexahedronVertex[5];
+        p7=pHexahedronVertex[6];
+        p8=pHexahedronVertex[7];
         label=pHexahedron->label;
 
         k=l%(nZ-1);
@@ -1082,6 +1088,665 @@ int getLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh)
     return 1;
 }
 
+/* ************************************************************************** */
+// The function compareFrontierKeys is the comparison function given to qsort
+// in order to sort the integer keys of the boundary faces (and of the touched
+// hexahedra) in increasing order. It has the two const void* pointers
+// (pointing to the int variables to compare) as input arguments and it returns
+// a negative (respectively zero, positive) integer if the first key is lower
+// than (respectively equal to, greater than) the second one
+/* ************************************************************************** */
+int compareFrontierKeys(const void* pKey1, const void* pKey2)
+{
+    int key1=*(const int*)pKey1, key2=*(const int*)pKey2;
+
+    return (key1>key2)-(key1<key2);
+}
+
+/* ************************************************************************** */
+// The function updateLevelSetQuadrilaterals updates the quadrilaterals
+// corresponding to the boundary of the internal MPD domain (and the Adjacency
+// structures accordingly) after the labels of some hexahedra adjacent to the
+// previous boundary have been changed. Since only the hexahedra referenced in
+// pMesh->padj can have been flipped, the new boundary faces are necessarily
+// faces of these hexahedra, so that only their neighbourhood is inspected
+// instead of the whole grid as done in getLevelSetQuadrilaterals. Each face is
+// identified by the key 6*l+d where l is the exterior hexahedron and d=0...5
+// the direction (i-1,i+1,j-1,j+1,k-1,k+1) of its interior neighbour. Sorting
+// the keys gives back the exact order of getLevelSetQuadrilaterals. It has the
+// Parameters* and Mesh* variables (defined in main.h) as input arguments and it
+// returns one on sucess, otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int updateLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh)
+{
+    size_t length=0;
+    int i=0, j=0, k=0, l=0, d=0, iKey=0, nKey=0, nTouched=0, label=0;
+    int lPoint=0, lLabel=0, nX=0, nY=0, nZ=0, nAdj=0;
+    int initialNumberOfQuadrilaterals=0;
+    int pNeighbour[6]={0}, pHexahedronVertex[8]={0};
+    int *pTouched=NULL, *pKey=NULL;
+    Quadrilateral *pQuadrilateral=NULL;
+    Adjacency *pAdjacency=NULL;
+
+    // Check that the input variables are not pointing to NULL
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In updateLevelSetQuadrilaterals: one of the input ");
+        fprintf(stderr,"variable pParameters=%p or ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p is not a valid address.\n",(void*)pMesh);
+        return 0;
+    }
+
+    // Without any previous boundary, the whole grid must be scanned
+    nAdj=pMesh->nadj;
+    if (nAdj<1 || pMesh->padj==NULL)
+    {
+        free(pMesh->padj);
+        pMesh->padj=NULL;
+        pMesh->nadj=0;
+        if (!getLevelSetQuadrilaterals(pParameters,pMesh))
+        {
+            PRINT_ERROR("In updateLevelSetQuadrilaterals: ");
+            fprintf(stderr,"getLevelSetQuadrilaterals function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+            return 0;
+        }
+        return 1;
+    }
+
+    nX=pParameters->n_x;
+    nY=pParameters->n_y;
+    nZ=pParameters->n_z;
+    if (nX<3 || nY<3 || nZ<3 || pMesh->phex==NULL)
+    {
+        PRINT_ERROR("In updateLevelSetQuadrilaterals: expecting that the n_x ");
+        fprintf(stderr,"(=%d), n_y (=%d), and n_z (=%d) variables ",nX,nY,nZ);
+        fprintf(stderr,"of the structure pointed by pParameters are ");
+        fprintf(stderr,"(strictly) greater than two and that the phex ");
+        fprintf(stderr,"variable (=%p) of the ",(void*)pMesh->phex);
+        fprintf(stderr,"structure pointed by pMesh is a valid address.\n");
+        return 0;
+    }
+    initialNumberOfQuadrilaterals=2*((nX-1)*(nY-1)+(nX-1)*(nZ-1)+(nY-1)*(nZ-1));
+
+    // Allocate memory for the touched hexahedra and the candidate face keys
+    // calloc function returns a pointer to allocated memory, otherwise NULL
+    length=2*nAdj;
+    pTouched=(int*)calloc(length,sizeof(int));
+    length=12*nAdj;
+    pKey=(int*)calloc(length,sizeof(int));
+    if (pTouched==NULL || pKey==NULL)
+    {
+        PRINT_ERROR("In updateLevelSetQuadrilaterals: could not allocate ");
+        fprintf(stderr,"memory for the local pTouched or pKey variables.\n");
+        free(pTouched);
+        free(pKey);
+        return 0;
+    }
+
+    // Collect (without repetition) the hexahedra of the previous boundary
+    for (l=0; l<nAdj; l++)
+    {
+        pTouched[2*l]=pMesh->padj[l].hexout-1;
+        pTouched[2*l+1]=pMesh->padj[l].hexin-1;
+    }
+    qsort(pTouched,2*nAdj,sizeof(int),compareFrontierKeys);
+    nTouched=0;
+    for (l=0; l<2*nAdj; l++)
+    {
+        if (!nTouched || pTouched[l]!=pTouched[nTouched-1])
+        {
+            pTouched[nTouched]=pTouched[l];
+            nTouched++;
+        }
+    }
+
+    // Save the keys of the boundary faces of the touched hexahedra, seen from
+    // the exterior hexahedron (d^1 is the opposite direction of d)
+    nKey=0;
+    for (iKey=0; iKey<nTouched; iKey++)
+    {
+        l=pTouched[iKey];
+        label=pMesh->phex[l].label;
+        k=l%(nZ-1);
+        lPoint=l/(nZ-1);
+        j=lPoint%(nY-1);
+        i=lPoint/(nY-1);
+        pNeighbour[0]=(i>0)?l-(nY-1)*(nZ-1):-1;
+        pNeighbour[1]=(i<nX-2)?l+(nY-1)*(nZ-1):-1;
+        pNeighbour[2]=(j>0)?l-(nZ-1):-1;
+        pNeighbour[3]=(j<nY-2)?l+(nZ-1):-1;
+        pNeighbour[4]=(k>0)?l-1:-1;
+        pNeighbour[5]=(k<nZ-2)?l+1:-1;
+        for (d=0; d<6; d++)
+        {
+            lPoint=pNeighbour[d];
+            if (lPoint<0)
+            {
+                continue;
+            }
+            lLabel=pMesh->phex[lPoint].label;
+            if (label==2 && lLabel==3)
+            {
+                pKey[nKey]=6*l+d;
+                nKey++;
+            }
+            else if (label==3 && lLabel==2)
+            {
+                pKey[nKey]=6*lPoint+(d^1);
+                nKey++;
+            }
+        }
+    }
+    free(pTouched);
+    pTouched=NULL;
+
+    qsort(pKey,nKey,sizeof(int),compareFrontierKeys);
+    nAdj=0;
+    for (iKey=0; iKey<nKey; iKey++)
+    {
+        if (!nAdj || pKey[iKey]!=pKey[nAdj-1])
+        {
+            pKey[nAdj]=pKey[iKey];
+            nAdj++;
+        }
+    }
+
+    // Reallocate memory for the quadrilaterals and the Adjacency structures
+    // realloc function returns a pointer to allocated memory, otherwise NULL
+    length=initialNumberOfQuadrilaterals+nAdj;
+    pQuadrilateral=(Quadrilateral*)realloc(pMesh->pqua,
+                                                  length*sizeof(Quadrilateral));
+    if (pQuadrilateral==NULL)
+    {
+        PRINT_ERROR("In updateLevelSetQuadrilaterals: could not reallocate ");
+        fprintf(stderr,"memory for additional quadrilaterals associated with ");
+        fprintf(stderr,"the internal domain of the structure pointed by ");
+        fprintf(stderr,"pMesh.\n");
+        free(pKey);
+        return 0;
+    }
+    pMesh->pqua=pQuadrilateral;
+
+    length=(nAdj>0)?nAdj:1;
+    pAdjacency=(Adjacency*)realloc(pMesh->padj,length*sizeof(Adjacency));
+    if (pAdjacency==NULL)
+    {
+        PRINT_ERROR("In updateLevelSetQuadrilaterals: could not reallocate ");
+        fprintf(stderr,"memory for the Adjacency structures pointed by ");
+        fprintf(stderr,"pMesh.\n");
+        free(pKey);
+        return 0;
+    }
+    pMesh->padj=pAdjacency;
+    pMesh->nadj=nAdj;
+
+    // Materialize the boundary quadrilaterals (labelled 10) in the same order
+    // and with the same orientation as in getLevelSetQuadrilaterals
+    for (iKey=0; iKey<nAdj; iKey++)
+    {
+        l=pKey[iKey]/6;
+        d=pKey[iKey]%6;
+        switch (d)
+        {
+            case 0:
+                lPoint=l-(nY-1)*(nZ-1);
+                break;
+
+            case 1:
+                lPoint=l+(nY-1)*(nZ-1);
+                break;
+
+            case 2:
+                lPoint=l-(nZ-1);
+                break;
+
+            case 3:
+                lPoint=l+(nZ-1);
+                break;
+
+            case 4:
+                lPoint=l-1;
+                break;
+
+            default:
+                lPoint=l+1;
+                break;
+        }
+
+        // Squares 1584, 2376, 1265, 3487, 1432, and 5678 (trigonometric
+        // orientation when looking from the exterior hexahedron)
+        getHexahedronVertices(l,nY,nZ,pHexahedronVertex);
+        pQuadrilateral=&pMesh->pqua[initialNumberOfQuadrilaterals+iKey];
+        switch (d)
+        {
+            case 0:
+                pQuadrilateral->p1=pHexahedronVertex[0];
+                pQuadrilateral->p2=pHexahedronVertex[4];
+                pQuadrilateral->p3=pHexahedronVertex[7];
+                pQuadrilateral->p4=pHexahedronVertex[3];
+                break;
+
+            case 1:
+                pQuadrilateral->p1=pHexahedronVertex[1];
+                pQuadrilateral->p2=pHexahedronVertex[2];
+                pQuadrilateral->p3=pHexahedronVertex[6];
+                pQuadrilateral->p4=pHexahedronVertex[5];
+                break;
+
+            case 2:
+                pQuadrilateral->p1=pHexahedronVertex[0];
+                pQuadrilateral->p2=pHexahedronVertex[1];
+                pQuadrilateral->p3=pHexahedronVertex[5];
+                pQuadrilateral->p4=pHexahedronVertex[4];
+                break;
+
+            case 3:
+                pQuadrilateral->p1=pHexahedronVertex[2];
+                pQuadrilateral->p2=pHexahedronVertex[3];
+                pQuadrilateral->p3=pHexahedronVertex[7];
+                pQuadrilateral->p4=pHexahedronVertex[6];
+                break;
+
+            case 4:
+                pQuadrilateral->p1=pHexahedronVertex[0];
+                pQuadrilateral->p2=pHexahedronVertex[3];
+                pQuadrilateral->p3=pHexahedronVertex[2];
+                pQuadrilateral->p4=pHexahedronVertex[1];
+                break;
+
+            default:
+                pQuadrilateral->p1=pHexahedronVertex[4];
+                pQuadrilateral->p2=pHexahedronVertex[5];
+                pQuadrilateral->p3=pHexahedronVertex[6];
+                pQuadrilateral->p4=pHexahedronVertex[7];
+                break;
+        }
+        pQuadrilateral->label=10;
+        pMesh->padj[iKey].quad=initialNumberOfQuadrilaterals+iKey+1;
+        pMesh->padj[iKey].hexout=l+1;
+        pMesh->padj[iKey].hexin=lPoint+1;
+    }
+    pMesh->nqua=initialNumberOfQuadrilaterals+nAdj;
+
+    free(pKey);
+    pKey=NULL;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function refineHexahedralMesh replaces the hexahedral grid of pMesh by
+// the one obtained by dividing each hexahedron into eight (the n_x, n_y, n_z
+// and delta_x, delta_y, delta_z variables of pParameters are updated, the
+// computational box remaining the same). The pending labels (-2 or -3) set by
+// the shape gradient on the boundary hexahedra are first undone so that the
+// internal domain of the refined grid is exactly the one of the previous grid
+// (each hexahedron transmitting its label to its eight children). Finally, the
+// boundary quadrilaterals and the Adjacency structures are rebuilt. It has the
+// Parameters* and Mesh* variables (defined in main.h) as input arguments and it
+// returns one on success, otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int refineHexahedralMesh(Parameters* pParameters, Mesh* pMesh)
+{
+    int i=0, j=0, k=0, l=0, nX=0, nY=0, nZ=0, nHex=0, *pLabel=NULL;
+
+    // Check that the input variables are not pointing to NULL
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In refineHexahedralMesh: one of the input ");
+        fprintf(stderr,"variable pParameters=%p or ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p is not a valid address.\n",(void*)pMesh);
+        return 0;
+    }
+
+    // Check that the mesh is the hexahedral grid of pParameters
+    nX=pParameters->n_x;
+    nY=pParameters->n_y;
+    nZ=pParameters->n_z;
+    nHex=(nX-1)*(nY-1)*(nZ-1);
+    if (pParameters->opt_mode>0 || nX<3 || nY<3 || nZ<3 || pMesh->nhex!=nHex
+                 || pMesh->phex==NULL || (pMesh->nadj>0 && pMesh->padj==NULL))
+    {
+        PRINT_ERROR("In refineHexahedralMesh: expecting a hexahedral mesh ");
+        fprintf(stderr,"(opt_mode=%d not positive) ",pParameters->opt_mode);
+        fprintf(stderr,"made of %d hexahedra (instead of ",nHex);
+        fprintf(stderr,"%d) with valid phex and padj variables ",pMesh->nhex);
+        fprintf(stderr,"in the structure pointed by pMesh.\n");
+        return 0;
+    }
+
+    // Undo on labels the shape gradient mode (as done in the main function
+    // when switching from opt_mode=-1 to opt_mode=-2)
+    for (l=0; l<pMesh->nadj; l++)
+    {
+        if (abs(pMesh->phex[pMesh->padj[l].hexout-1].label)==3)
+        {
+            pMesh->phex[pMesh->padj[l].hexout-1].label=2;
+        }
+        if (abs(pMesh->phex[pMesh->padj[l].hexin-1].label)==2)
+        {
+            pMesh->phex[pMesh->padj[l].hexin-1].label=3;
+        }
+    }
+
+    // Save the labels of the hexahedra before freeing the mesh
+    // calloc function returns a pointer to allocated memory, otherwise NULL
+    pLabel=(int*)calloc(nHex,sizeof(int));
+    if (pLabel==NULL)
+    {
+        PRINT_ERROR("In refineHexahedralMesh: could not allocate memory for ");
+        fprintf(stderr,"the local (int*) pLabel variable.\n");
+        return 0;
+    }
+    for (l=0; l<nHex; l++)
+    {
+        pLabel[l]=abs(pMesh->phex[l].label);
+    }
+    freeMeshMemory(pMesh);
+    initializeMeshStructure(pMesh);
+
+    // Update the discretization of the computational box
+    pParameters->n_x=2*nX-1;
+    pParameters->n_y=2*nY-1;
+    pParameters->n_z=2*nZ-1;
+    pParameters->delta_x=(pParameters->x_max-pParameters->x_min)/
+                                                  (double)(pParameters->n_x-1);
+    pParameters->delta_y=(pParameters->y_max-pParameters->y_min)/
+                                                  (double)(pParameters->n_y-1);
+    pParameters->delta_z=(pParameters->z_max-pParameters->z_min)/
+                                                  (double)(pParameters->n_z-1);
+
+    fprintf(stdout,"\nRefining the hexahedral grid from (%d)x(%d)x",nX,nY);
+    fprintf(stdout,"(%d) to (%d)x(%d)x",nZ,pParameters->n_x,pParameters->n_y);
+    fprintf(stdout,"(%d) points.\n",pParameters->n_z);
+
+    // Computing the number of elements thanks to the discretization parameters
+    pMesh->nver=pParameters->n_x*pParameters->n_y*pParameters->n_z;
+    pMesh->nqua=2*((pParameters->n_x-1)*(pParameters->n_y-1)+
+                   (pParameters->n_x-1)*(pParameters->n_z-1)+
+                                 (pParameters->n_y-1)*(pParameters->n_z-1));
+    pMesh->nhex=8*nHex;
+
+    // Dynamically allocating memory for the Mesh structure
+    if (!allocateInitialMeshMemory(pParameters,pMesh))
+    {
+        PRINT_ERROR("In refineHexahedralMesh: allocateInitialMeshMemory ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        free(pLabel);
+        pLabel=NULL;
+        return 0;
+    }
+
+    // Meshing the cube according to the discretization parameters
+    if (!meshCube(pParameters,pMesh))
+    {
+        PRINT_ERROR("In refineHexahedralMesh: meshCube function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        free(pLabel);
+        pLabel=NULL;
+        return 0;
+    }
+
+    // Each hexahedron of the refined grid gets the label of its parent
+    l=0;
+    for (i=0; i<pParameters->n_x-1; i++)
+    {
+        for (j=0; j<pParameters->n_y-1; j++)
+        {
+            for (k=0; k<pParameters->n_z-1; k++)
+            {
+                pMesh->phex[l].label=pLabel[((i/2)*(nY-1)+j/2)*(nZ-1)+k/2];
+                l++;
+            }
+        }
+    }
+
+    // Free the memory allocated for pLabel
+    free(pLabel);
+    pLabel=NULL;
+
+    // Add the boundary quadrilaterals and build the Adjacency structures
+    if (!getLevelSetQuadrilaterals(pParameters,pMesh))
+    {
+        PRINT_ERROR("In refineHexahedralMesh: getLevelSetQuadrilaterals ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function warpHexahedralDomain initializes the internal domain of the
+// hexahedral grid pMesh (geometry of pChemicalSystem) from the one of the grid
+// pOldMesh (geometry of pOldChemicalSystem) moved along the displacements of
+// the nuclei: the displacement of each point is interpolated from the ones of
+// the nuclei (weighted by the inverse of the squared distances to the displaced
+// nuclei), and each hexahedron of pMesh gets the label of the hexahedron of
+// pOldMesh containing the preimage of its center (2 if it lies outside of the
+// old grid). The pending labels set by the shape gradient on the boundary of
+// pOldMesh are first undone. Finally, the boundary quadrilaterals and the
+// Adjacency structures of pMesh are built. It has three Parameters*, Mesh*,
+// and ChemicalSystem* variables (defined in main.h) as input arguments and it
+// returns one on success, otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int warpHexahedralDomain(Parameters* pOldParameters, Mesh* pOldMesh,
+                         ChemicalSystem* pOldChemicalSystem,
+                         Parameters* pParameters, Mesh* pMesh,
+                                                ChemicalSystem* pChemicalSystem)
+{
+    int i=0, j=0, k=0, l=0, n=0, nNucl=0, nX=0, nY=0, nZ=0, oX=0, oY=0, oZ=0;
+    int iOld=0, jOld=0, kOld=0, nInside=0, *pLabel=NULL;
+    double x=0., y=0., z=0., ux=0., uy=0., uz=0., weight=0., sumWeight=0.;
+    double dx=0., dy=0., dz=0., distanceSquared=0., moveMax=0.;
+    double *pMove=NULL;
+
+    // Check that the input variables are not pointing to NULL
+    if (pOldParameters==NULL || pOldMesh==NULL || pOldChemicalSystem==NULL ||
+                   pParameters==NULL || pMesh==NULL || pChemicalSystem==NULL)
+    {
+        PRINT_ERROR("In warpHexahedralDomain: one of the input variables ");
+        fprintf(stderr,"pOldParameters=%p, ",(void*)pOldParameters);
+        fprintf(stderr,"pOldMesh=%p, ",(void*)pOldMesh);
+        fprintf(stderr,"pOldChemicalSystem=%p, ",(void*)pOldChemicalSystem);
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, or ",(void*)pMesh);
+        fprintf(stderr,"pChemicalSystem=%p ",(void*)pChemicalSystem);
+        fprintf(stderr,"is not a valid address.\n");
+        return 0;
+    }
+
+    // Check that the two meshes are the hexahedral grids of their parameters
+    oX=pOldParameters->n_x;
+    oY=pOldParameters->n_y;
+    oZ=pOldParameters->n_z;
+    nX=pParameters->n_x;
+    nY=pParameters->n_y;
+    nZ=pParameters->n_z;
+    if (pOldParameters->opt_mode>0 || pParameters->opt_mode>0 || oX<3 ||
+        oY<3 || oZ<3 || nX<3 || nY<3 || nZ<3 || pOldMesh->phex==NULL ||
+        pOldMesh->nhex!=(oX-1)*(oY-1)*(oZ-1) || pMesh->phex==NULL ||
+        pMesh->nhex!=(nX-1)*(nY-1)*(nZ-1) ||
+                                    (pOldMesh->nadj>0 && pOldMesh->padj==NULL))
+    {
+        PRINT_ERROR("In warpHexahedralDomain: expecting two hexahedral ");
+        fprintf(stderr,"meshes (opt_mode=%d and ",pOldParameters->opt_mode);
+        fprintf(stderr,"%d not positive) made of ",pParameters->opt_mode);
+        fprintf(stderr,"%d and ",(oX-1)*(oY-1)*(oZ-1));
+        fprintf(stderr,"%d hexahedra (instead of ",(nX-1)*(nY-1)*(nZ-1));
+        fprintf(stderr,"%d and %d) with ",pOldMesh->nhex,pMesh->nhex);
+        fprintf(stderr,"valid phex (and padj) variables.\n");
+        return 0;
+    }
+
+    // Check that the two geometries describe the same nuclei
+    nNucl=pChemicalSystem->nnucl;
+    if (nNucl<1 || pOldChemicalSystem->nnucl!=nNucl ||
+                                                pChemicalSystem->pnucl==NULL ||
+                                                pOldChemicalSystem->pnucl==NULL)
+    {
+        PRINT_ERROR("In warpHexahedralDomain: the two chemical systems ");
+        fprintf(stderr,"must have the same (positive) number of nuclei ");
+        fprintf(stderr,"(instead of %d and ",pOldChemicalSystem->nnucl);
+        fprintf(stderr,"%d) stored in valid pnucl variables.\n",nNucl);
+        return 0;
+    }
+    for (n=0; n<nNucl; n++)
+    {
+        if (pChemicalSystem->pnucl[n].charge!=
+                                           pOldChemicalSystem->pnucl[n].charge)
+        {
+            PRINT_ERROR("In warpHexahedralDomain: the ");
+            fprintf(stderr,"%d-th nucleus has not the same charge ",n+1);
+            fprintf(stderr,"(%d instead of ",pChemicalSystem->pnucl[n].charge);
+            fprintf(stderr,"%d) ",pOldChemicalSystem->pnucl[n].charge);
+            fprintf(stderr,"in the two ");
+            fprintf(stderr,"geometries (the nuclei must be given in the same ");
+            fprintf(stderr,"order in the chemical files).\n");
+            return 0;
+        }
+    }
+
+    // Undo on labels the shape gradient mode (as done in the main function
+    // when switching from opt_mode=-1 to opt_mode=-2)
+    for (l=0; l<pOldMesh->nadj; l++)
+    {
+        if (abs(pOldMesh->phex[pOldMesh->padj[l].hexout-1].label)==3)
+        {
+            pOldMesh->phex[pOldMesh->padj[l].hexout-1].label=2;
+        }
+        if (abs(pOldMesh->phex[pOldMesh->padj[l].hexin-1].label)==2)
+        {
+            pOldMesh->phex[pOldMesh->padj[l].hexin-1].label=3;
+        }
+    }
+
+    // calloc function returns a pointer to allocated memory, otherwise NULL
+    pMove=(double*)calloc(3*nNucl,sizeof(double));
+    pLabel=(int*)calloc(pOldMesh->nhex,sizeof(int));
+    if (pMove==NULL || pLabel==NULL)
+    {
+        PRINT_ERROR("In warpHexahedralDomain: could not allocate memory for ");
+        fprintf(stderr,"the local (double*) pMove and (int*) pLabel ");
+        fprintf(stderr,"variables.\n");
+        free(pMove);
+        free(pLabel);
+        return 0;
+    }
+    for (l=0; l<pOldMesh->nhex; l++)
+    {
+        pLabel[l]=abs(pOldMesh->phex[l].label);
+    }
+
+    // Displacements of the nuclei from the old geometry to the new one
+    for (n=0; n<nNucl; n++)
+    {
+        pMove[3*n]=pChemicalSystem->pnucl[n].x-pOldChemicalSystem->pnucl[n].x;
+        pMove[3*n+1]=pChemicalSystem->pnucl[n].y-
+                                                pOldChemicalSystem->pnucl[n].y;
+        pMove[3*n+2]=pChemicalSystem->pnucl[n].z-
+                                                pOldChemicalSystem->pnucl[n].z;
+        distanceSquared=pMove[3*n]*pMove[3*n]+pMove[3*n+1]*pMove[3*n+1]+
+                                                      pMove[3*n+2]*pMove[3*n+2];
+        moveMax=DEF_MAX(moveMax,sqrt(distanceSquared));
+    }
+
+    fprintf(stdout,"\nMoving the domain of the previous geometry along the ");
+    fprintf(stdout,"displacements of the nuclei (%lf at most).\n",moveMax);
+
+    // Each hexahedron (structured as in meshCube function) gets the label of
+    // the old hexahedron containing the preimage of its center
+    l=0;
+    for (i=0; i<nX-1; i++)
+    {
+        for (j=0; j<nY-1; j++)
+        {
+            for (k=0; k<nZ-1; k++)
+            {
+                x=pParameters->x_min+(i+.5)*pParameters->delta_x;
+                y=pParameters->y_min+(j+.5)*pParameters->delta_y;
+                z=pParameters->z_min+(k+.5)*pParameters->delta_z;
+
+                // Interpolate the displacement at the center
+                ux=0.;
+                uy=0.;
+                uz=0.;
+                sumWeight=0.;
+                for (n=0; n<nNucl; n++)
+                {
+                    dx=x-pChemicalSystem->pnucl[n].x;
+                    dy=y-pChemicalSystem->pnucl[n].y;
+                    dz=z-pChemicalSystem->pnucl[n].z;
+                    distanceSquared=dx*dx+dy*dy+dz*dz;
+                    if (distanceSquared<1.e-12)
+                    {
+                        ux=pMove[3*n];
+                        uy=pMove[3*n+1];
+                        uz=pMove[3*n+2];
+                        sumWeight=1.;
+                        break;
+                    }
+                    weight=1./distanceSquared;
+                    ux+=weight*pMove[3*n];
+                    uy+=weight*pMove[3*n+1];
+                    uz+=weight*pMove[3*n+2];
+                    sumWeight+=weight;
+                }
+                if (n==nNucl)
+                {
+                    ux/=sumWeight;
+                    uy/=sumWeight;
+                    uz/=sumWeight;
+                }
+
+                // Locate the preimage of the center in the old grid
+                iOld=(int)floor((x-ux-pOldParameters->x_min)/
+                                                      pOldParameters->delta_x);
+                jOld=(int)floor((y-uy-pOldParameters->y_min)/
+                                                      pOldParameters->delta_y);
+                kOld=(int)floor((z-uz-pOldParameters->z_min)/
+                                                      pOldParameters->delta_z);
+                pMesh->phex[l].label=2;
+                if (iOld>=0 && iOld<oX-1 && jOld>=0 && jOld<oY-1 && kOld>=0 &&
+                                                                  kOld<oZ-1)
+                {
+                    if (pLabel[(iOld*(oY-1)+jOld)*(oZ-1)+kOld]==3)
+                    {
+                        pMesh->phex[l].label=3;
+                        nInside++;
+                    }
+                }
+                l++;
+            }
+        }
+    }
+
+    // Free the memory allocated for pMove and pLabel
+    free(pMove);
+    pMove=NULL;
+    free(pLabel);
+    pLabel=NULL;
+
+    if (!nInside)
+    {
+        PRINT_ERROR("In warpHexahedralDomain: no hexahedron of the new grid ");
+        fprintf(stderr,"belongs to the moved domain (the nuclei may have ");
+        fprintf(stderr,"been moved outside of the computational box).\n");
+        return 0;
+    }
+
+    // Add the boundary quadrilaterals and build the Adjacency structures
+    if (!getLevelSetQuadrilaterals(pParameters,pMesh))
+    {
+        PRINT_ERROR("In warpHexahedralDomain: getLevelSetQuadrilaterals ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    return 1;
+}
+
 /* ************************************************************************** */
 // The function evaluatingHessianAtVertices evaluates a (Gaussian function)
 // primitive of pMolecularOrbital described in pChemicalSystem at pPoint, and
@@ -1510,7 +2175,7 @@ int evaluatingMetricOnMesh(Parameters* pParameters, Mesh* pMesh,
     double value=0., lambda=0., hessian[9]={0.}, eigenvalues[3]={0.};
     double hessianI[6]={0.}, hessianJ[6]={0.}, *pHessian=NULL;
     double *pEigenvalues=NULL, functionI=0., functionJ=0., gradientI[3]={0.};
-    double gradientJ[3]={0.};
+    double gradientJ[3]={0.}, timer=0., work=0.;
     MolecularOrbital *pMolecularOrbitalI=NULL, *pMolecularOrbitalJ=NULL;
     Point *pPoint=NULL;
 
@@ -1717,79 +2382,90 @@ int evaluatingMetricOnMesh(Parameters* pParameters, Mesh* pMesh,
         }
 */
 
-#pragma omp parallel for default(shared) private(pPoint,functionI,l,gradientI,hessianI,hessian,eigenvalues,pHessian,pEigenvalues,info,lambda,value)
         // We now treat the case where i=j
-        for (k=0; k<nVer; k++)
+#pragma omp parallel default(shared) private(pPoint,functionI,l,gradientI,hessianI,hessian,eigenvalues,pHessian,pEigenvalues,info,lambda,value,timer,work)
         {
-            pPoint=&pMesh->pver[k];
-
-            // Re-initialization of the function, gradient and Hessian matrix
-            functionI=0.;
-            for (l=0; l<3; l++)
-            {
-                gradientI[l]=0.;
-                hessianI[l]=0.;
-                hessian[l]=0.;
-                eigenvalues[l]=0.;
-            }
-            for (l=3; l<6; l++)
-            {
-                hessianI[l]=0.;
-                hessian[l]=0.;
-            }
-            for (l=6; l<9; l++)
+            // Add the time spent by the thread on its share of the loop to
+            // its busy time (one call per thread, not per item)
+            timer=beginProfilerThread(&globalProfiler);
+            work=0.;
+#pragma omp for nowait
+            for (k=0; k<nVer; k++)
             {
-                hessian[l]=0.;
-            }
+                pPoint=&pMesh->pver[k];
 
-            for (l=0; l<nGauss; l++)
-            {
-                // Evaluating function, gradient and Hessian for Orbital i
-                // (stored as 0->xx 1->yy 2->zz 3->xy,yx 4->xz,zx 5->yz,zy)
-                functionI+=evaluatingHessianAtVertices(pChemicalSystem,
-                                                       pMolecularOrbitalI,
-                                                       pPoint,gradientI,
+                // Re-initialization of the function, gradient and Hessian
+                // matrix
+                functionI=0.;
+                for (l=0; l<3; l++)
+                {
+                    gradientI[l]=0.;
+                    hessianI[l]=0.;
+                    hessian[l]=0.;
+                    eigenvalues[l]=0.;
+                }
+                for (l=3; l<6; l++)
+                {
+                    hessianI[l]=0.;
+                    hessian[l]=0.;
+                }
+                for (l=6; l<9; l++)
+                {
+                    hessian[l]=0.;
+                }
+
+                for (l=0; l<nGauss; l++)
+                {
+                    // Evaluating function, gradient and Hessian for Orbital i
+                    // (stored as 0->xx 1->yy 2->zz 3->xy,yx 4->xz,zx 5->yz,zy)
+                    functionI+=evaluatingHessianAtVertices(pChemicalSystem,
+                                                           pMolecularOrbitalI,
+                                                           pPoint,gradientI,
                                                                     hessianI,l);
-            }
+                }
+
+                // Evaluating Hessian of Orb(i)^2 for computing metric
+                hessian[0]=2.*(hessianI[0]*functionI+gradientI[0]*gradientI[0]);
+                hessian[4]=2.*(hessianI[1]*functionI+gradientI[1]*gradientI[1]);
+                hessian[8]=2.*(hessianI[2]*functionI+gradientI[2]*gradientI[2]);
+                hessian[1]=2.*(hessianI[3]*functionI+gradientI[0]*gradientI[1]);
+                hessian[2]=2.*(hessianI[4]*functionI+gradientI[0]*gradientI[2]);
+                hessian[5]=2.*(hessianI[5]*functionI+gradientI[1]*gradientI[2]);
 
-            // Evaluating Hessian of Orb(i)^2 for computing metric
-            hessian[0]=2.*(hessianI[0]*functionI+gradientI[0]*gradientI[0]);
-            hessian[4]=2.*(hessianI[1]*functionI+gradientI[1]*gradientI[1]);
-            hessian[8]=2.*(hessianI[2]*functionI+gradientI[2]*gradientI[2]);
-            hessian[1]=2.*(hessianI[3]*functionI+gradientI[0]*gradientI[1]);
-            hessian[2]=2.*(hessianI[4]*functionI+gradientI[0]*gradientI[2]);
-            hessian[5]=2.*(hessianI[5]*functionI+gradientI[1]*gradientI[2]);
-
-            // Diagonalize using lapacke library (lapack interface for c)
-            // LAPACKE_dsyev returns zero if successfull; we refer to
-            // diagonalizeOverlapMatrix in optimization.c file for details
-            pHessian=&(hessian[0]);
-            pEigenvalues=&(eigenvalues[0]);
-            info=LAPACKE_dsyev(LAPACK_COL_MAJOR,'N','L',3,pHessian,3,
+                // Diagonalize using lapacke library (lapack interface for c)
+                // LAPACKE_dsyev returns zero if successfull; we refer to
+                // diagonalizeOverlapMatrix in optimization.c file for details
+                pHessian=&(hessian[0]);
+                pEigenvalues=&(eigenvalues[0]);
+                info=LAPACKE_dsyev(LAPACK_COL_MAJOR,'N','L',3,pHessian,3,
                                                                   pEigenvalues);
-            if (info)
-            {
-                boolean++;
-            }
+                if (info)
+                {
+                    boolean++;
+                }
 
-            // Get the normalized highest eigenvalues
-            lambda=1./(pParameters->met_max*pParameters->met_max);
-            for (l=0; l<3; l++)
-            {
-                value=MET_CST*DEF_ABS(eigenvalues[l])/pParameters->met_err;
-                if (value>lambda)
+                // Get the normalized highest eigenvalues
+                lambda=1./(pParameters->met_max*pParameters->met_max);
+                for (l=0; l<3; l++)
                 {
-                    lambda=value;
+                    value=MET_CST*DEF_ABS(eigenvalues[l])/pParameters->met_err;
+                    if (value>lambda)
+                    {
+                        lambda=value;
+                    }
                 }
-            }
 
-            // Computing the metric (note that the initial values were set to
-            // pParameters->met_max; upper bound was set for the initial lamba)
-            value=DEF_MAX(1./sqrt(lambda),pParameters->met_min);
-            if (value<(pPoint->value))
-            {
-                pPoint->value=value;
+                // Computing the metric (note that the initial values were set
+                // to pParameters->met_max; upper bound was set for the initial
+                // lamba)
+                value=DEF_MAX(1./sqrt(lambda),pParameters->met_min);
+                if (value<(pPoint->value))
+                {
+                    pPoint->value=value;
+                }
+                work+=1.;
             }
+            endProfilerThread(&globalProfiler,PROF_METRIC,timer,work);
         }
         if (boolean)
         {
@@ -1941,11 +2617,15 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
     size_t lengthName=0;
     char* fileLocation=NULL;
 
+    // Time the computation of the metric in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_METRIC);
+
     // Evaluate the orbitals' metric on mesh (NULL pointers are checked here)
     if (!evaluatingMetricOnMesh(pParameters,pMesh,pChemicalSystem))
     {
         PRINT_ERROR("In computeMetric: evaluatingMetricOnMesh function ");
         fprintf(stderr,"returned zero instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
 
@@ -1957,6 +2637,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"integer not (strictly) greater than the maximal ");
         fprintf(stderr,"number of allowed iterations ");
         fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
 
@@ -1965,6 +2646,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
     {
         PRINT_ERROR("In computeMetric: getMeshFormat function did not return ");
         fprintf(stderr,"one, which was the expected value here.\n");
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
 
@@ -1982,12 +2664,14 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
             fprintf(stderr,"keyword or if no such line exists in your ");
             fprintf(stderr,"(input) *.info file, check that it is not ");
             fprintf(stderr,"entitled 'metric.info'.\n");
+            endProfilerPhase(&globalProfiler,PROF_METRIC);
             return 0;
             break;
 
         default:
             PRINT_ERROR("In computeMetric: initialFileExists function ");
             fprintf(stderr,"returned zero instead of (+/-)one.\n");
+            endProfilerPhase(&globalProfiler,PROF_METRIC);
             return 0;
             break;
     }
@@ -2000,6 +2684,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
     {
         PRINT_ERROR("In computeMetric: could not allocate memory for the ");
         fprintf(stderr,"local char* fileLocation variable.\n");
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
 
@@ -2015,6 +2700,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"zero instead of one.\n");
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
     strncpy(pParameters->name_mesh,"metric.mesh",pParameters->name_length);
@@ -2026,6 +2712,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"instead of one.\n");
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
 
@@ -2043,6 +2730,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
                     fprintf(stderr,"function returned zero instead of one.\n");
                     free(fileLocation);
                     fileLocation=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_METRIC);
                     return 0;
                 }
             }
@@ -2057,6 +2745,7 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"zero instead of one.\n");
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_METRIC);
         return 0;
     }
     strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
@@ -2065,6 +2754,8 @@ int computeMetric(Parameters* pParameters, Mesh* pMesh,
     free(fileLocation);
     fileLocation=NULL;
 
+    endProfilerPhase(&globalProfiler,PROF_METRIC);
+
     return 1;
 }
 
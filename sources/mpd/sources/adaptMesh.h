@@ -172,6 +172,159 @@ int initializeLevelSetFunction(Parameters* pParameters, Mesh* pMesh);
 */
 int getLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh);
 
+/**
+* \fn int compareFrontierKeys(const void* pKey1, const void* pKey2)
+* \brief It is the comparison function given to the qsort function in order to
+*        sort in increasing order the integer keys used by the \ref
+*        updateLevelSetQuadrilaterals function.
+*
+* \param[in] pKey1 A pointer that points to the first int variable to compare.
+*
+* \param[in] pKey2 A pointer that points to the second int variable to compare.
+*
+* \return It returns a negative (respectively zero, positive) integer if the
+*         key pointed by pKey1 is lower than (respectively equal to, greater
+*         than) the one pointed by pKey2.
+*
+* The \ref compareFrontierKeys function should be static but has been defined
+* as non-static in order to perform unit-tests on it.
+*/
+int compareFrontierKeys(const void* pKey1, const void* pKey2);
+
+/**
+* \fn int updateLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh)
+* \brief It updates the quadrilaterals of the pMesh hexahedral structure
+*        corresponding to the boundary of the internal MPD domain, and the
+*        associated Adjacency structures, after some hexahedra of the previous
+*        boundary have changed their labels.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function. Its n_x, n_y, and n_z variables
+*                        describe the structured grid of the hexahedral mesh.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure of the \ref
+*                      main function. Its padj variable must still describe the
+*                      boundary of the internal domain before the labels of
+*                      some of the referenced hexahedra (hexin or hexout) have
+*                      been switched between 2 and 3. It is then updated with
+*                      the new boundary and the corresponding quadrilaterals.
+*
+* \return It returns one if the quadrilaterals and the \ref Adjacency
+*         structures associated with the internal domain have been succesfully
+*         updated. Otherwise, zero is returned by the \ref
+*         updateLevelSetQuadrilaterals function if an error is encountered
+*         during the process.
+*
+* Since the labels can only change on the hexahedra adjacent to the previous
+* boundary, the new boundary faces are necessarily faces of these hexahedra. The
+* \ref updateLevelSetQuadrilaterals function thus only inspects their six
+* neighbours, which costs O(nadj*log(nadj)) operations instead of the O(nhex)
+* ones of the \ref getLevelSetQuadrilaterals function that scans the whole
+* grid twice. The faces are sorted so that the quadrilaterals and \ref
+* Adjacency structures are stored exactly in the same order as the ones of the
+* \ref getLevelSetQuadrilaterals function (hence the results of the
+* optimization loop are unchanged). If the previous boundary is empty, the
+* \ref getLevelSetQuadrilaterals function is called instead. The labels of the
+* hexahedra must be positive (i.e. the absolute value of the pending labels -2
+* and -3 must have been previously taken).
+*/
+int updateLevelSetQuadrilaterals(Parameters* pParameters, Mesh* pMesh);
+
+/**
+* \fn int refineHexahedralMesh(Parameters* pParameters, Mesh* pMesh)
+* \brief It replaces the hexahedral grid of pMesh by the one obtained by
+*        dividing each hexahedron into eight, the internal MPD domain being
+*        kept unchanged.
+*
+* \param[in,out] pParameters A pointer that points to the Parameters structure
+*                            of the \ref main function. Its n_x, n_y, n_z
+*                            (respectively delta_x, delta_y, delta_z)
+*                            variables are replaced by 2*n-1 (resp. halved)
+*                            but the computational box remains the same.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure of the \ref
+*                      main function. It must store the structured hexahedral
+*                      grid described by pParameters, where the hexahedra are
+*                      labelled 3 (internal domain) or 2 (its complement), and
+*                      the Adjacency structures of the boundary of the internal
+*                      domain. The hexahedra referenced by the Adjacency
+*                      structures may carry the labels set by the shape
+*                      gradient in the previous iteration (see the \ref
+*                      AddOrRemoveHexahedronToMesh function), which are undone.
+*                      Its content is then freed and replaced by the refined
+*                      grid, whose boundary quadrilaterals (labelled 10) and
+*                      Adjacency structures are rebuilt.
+*
+* \return It returns one if the grid has been successfully refined. Otherwise,
+*         zero is returned by the \ref refineHexahedralMesh function if an error
+*         is encountered during the process.
+*
+* Each hexahedron of the refined grid gets the label of the hexahedron that
+* contains it. Since the overlap-matrix integrals are computed analytically on
+* each hexahedron, the overlap matrix of the internal domain is thus the same
+* on the two grids (up to rounding errors). The refinement is uniform: all the
+* hexahedra are divided, not only the ones near the boundary of the internal
+* domain, so that the memory and the loops over the grid on the finest level
+* cost as much as a run started directly on this grid.
+*/
+int refineHexahedralMesh(Parameters* pParameters, Mesh* pMesh);
+
+/**
+* \fn int warpHexahedralDomain(Parameters* pOldParameters, Mesh* pOldMesh,
+*                              ChemicalSystem* pOldChemicalSystem,
+*                              Parameters* pParameters, Mesh* pMesh,
+*                                               ChemicalSystem* pChemicalSystem)
+* \brief It initializes the internal domain of a hexahedral grid from the one
+*        of another grid, moved along the displacements of the nuclei between
+*        two geometries of the same molecule (scan mode).
+*
+* \param[in] pOldParameters A pointer that points to the Parameters structure
+*                           describing the hexahedral grid of pOldMesh.
+*
+* \param[in,out] pOldMesh A pointer that points to the Mesh structure of the
+*                         previous geometry. It must store the structured
+*                         hexahedral grid described by pOldParameters, where the
+*                         hexahedra are labelled 3 (internal domain) or 2 (its
+*                         complement), and the Adjacency structures of the
+*                         boundary of the internal domain. The labels set by
+*                         the shape gradient in its last iteration (see the
+*                         \ref AddOrRemoveHexahedronToMesh function) are undone.
+*
+* \param[in] pOldChemicalSystem A pointer that points to the ChemicalSystem
+*                               structure of the previous geometry.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        describing the hexahedral grid of pMesh.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure of the new
+*                      geometry, storing the structured hexahedral grid built
+*                      by the \ref loadMesh function. Its hexahedra are
+*                      labelled, and its boundary quadrilaterals (labelled 10)
+*                      and Adjacency structures are built.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the new geometry. It must have the
+*                            same nuclei (same number, charges and order) as
+*                            pOldChemicalSystem.
+*
+* \return It returns one if the internal domain has been successfully moved.
+*         Otherwise, zero is returned by the \ref warpHexahedralDomain function
+*         if an error is encountered during the process (in particular if the
+*         moved domain does not contain any hexahedron of the new grid).
+*
+* The displacement at a point is interpolated from the ones of the nuclei,
+* weighted by the inverse of the squared distances to the displaced nuclei, so
+* that the domain is exactly translated (resp. moved with each nucleus) if the
+* molecule is translated (resp. in the vicinity of the nuclei). Each hexahedron
+* of pMesh gets the label of the hexahedron of pOldMesh containing the preimage
+* of its center (2 if it lies outside of the old grid), so that the two grids
+* may have different discretizations.
+*/
+int warpHexahedralDomain(Parameters* pOldParameters, Mesh* pOldMesh,
+                         ChemicalSystem* pOldChemicalSystem,
+                         Parameters* pParameters, Mesh* pMesh,
+                                               ChemicalSystem* pChemicalSystem);
+
 /**
 * \fn double evaluatingHessianAtVertices(ChemicalSystem* pChemicalSystem,
 *                                        MolecularOrbital* pMolecularOrbital,
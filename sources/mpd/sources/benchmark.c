@@ -0,0 +1,1044 @@
+/**
+* \file benchmark.c
+* \brief It contains the main function of the mpdBenchmark program, which times
+*        separately the hot kernels of the MPD algorithm.
+* \author Jeremy DALPHIN
+* \version 2.0
+* \date September 1st, 2018
+*
+* The mpdBenchmark program is built from the same files as the mpdProgram one
+* (main.c being compiled with the MPD_BENCHMARK preprocessor constant so that
+* its main function is replaced by the one of this file). It loads
+* representative chemical systems of the inputFiles directory, builds fixed
+* grids and initial domains around them, and times separately the evaluation
+* of the Gaussian-type primitives, the overlap matrix (on the hexahedral grid
+* and on tetrahedra), its diagonalization, the probability, the shape gradient
+* and the metric. The results are written in a text file that can be compared
+* with the one of another build.
+*/
+
+#include "loadParameters.h"
+#include "loadChemistry.h"
+#include "loadMesh.h"
+#include "adaptMesh.h"
+#include "optimization.h"
+#include "benchmark.h"
+
+/**
+* \var benchmarkSystems
+* \brief Global array storing the \ref BENCH_SYSTEMS chemical systems of the
+*        benchmark, from the smallest to the largest one. The grids of the
+*        largest systems are coarser so that the whole benchmark stays short.
+*/
+BenchmarkSystem benchmarkSystems[BENCH_SYSTEMS]={
+                                       {"h2-sto6g.wfn",2,41,1.5},
+                                       {"h3m-def2tzvppd.wfn",2,31,1.5},
+                                       {"HHeH-Tri-UHF-def2tzvppd.wfn",2,31,1.5},
+                                       {"lihhhlip-def2tzvppd.wfn",2,31,1.5},
+                                       {"h2o-def2tzvp-rhf.wfn",2,31,1.},
+                                       {"fhfm-rhf-def2tzvppd.wfn",2,25,1.},
+                                       {"c2h4-def2tzvp.wfn",2,25,1.},
+                                       {"f3m-rhf-def2tzvppd.wfn",2,25,1.},
+                                       {"c8h18-MOs.wfn",2,17,.8}};
+
+/* ************************************************************************** */
+// The function getNameOfKernel returns the name of the kernel-th kernel of the
+// benchmark, as written in the result file. It has the int kernel as input
+// argument and it returns "unknown" if kernel is not a valid position
+/* ************************************************************************** */
+char* getNameOfKernel(int kernel)
+{
+    switch (kernel)
+    {
+        case 0:
+            return "primitives";
+            break;
+
+        case 1:
+            return "overlap_grid";
+            break;
+
+        case 2:
+            return "diagonalization";
+            break;
+
+        case 3:
+            return "probability";
+            break;
+
+        case 4:
+            return "shape_gradient";
+            break;
+
+        case 5:
+            return "metric";
+            break;
+
+        case 6:
+            return "overlap_tetra";
+            break;
+
+        default:
+            return "unknown";
+            break;
+    }
+}
+
+/* ************************************************************************** */
+// The function getUnitOfKernel returns the unit of the throughput of the
+// kernel-th kernel of the benchmark. It has the int kernel as input argument
+// and it returns "items/s" if kernel is not a valid position
+/* ************************************************************************** */
+char* getUnitOfKernel(int kernel)
+{
+    switch (kernel)
+    {
+        case 0:
+            return "evaluations/s";
+            break;
+
+        case 4:
+        case 5:
+            return "points/s";
+            break;
+
+        case 1:
+        case 6:
+            return "pairs/s";
+            break;
+
+        case 2:
+            return "matrices/s";
+            break;
+
+        case 3:
+            return "domains/s";
+            break;
+
+        default:
+            return "items/s";
+            break;
+    }
+}
+
+/* ************************************************************************** */
+// The function setupBenchmarkSystem loads the chemical system pointed by
+// pSystem from the inputDirectory and builds its fixed grid and initial domain
+// (the bounding box of the nuclei enlarged by BENCH_MARGIN with the same step
+// in all directions, and the sphere of radius ls_r centered at the first
+// nucleus). It has the char* inputDirectory, BenchmarkSystem* (defined in
+// benchmark.h), int nCpu, Parameters*, ChemicalSystem*, Mesh*, and Data*
+// (defined in main.h) variables as input arguments and it returns one on
+// success, otherwise zero is returned
+/* ************************************************************************** */
+int setupBenchmarkSystem(char* inputDirectory, BenchmarkSystem* pSystem,
+                         int nCpu, Parameters* pParameters,
+                         ChemicalSystem* pChemicalSystem, Mesh* pMesh,
+                                                                    Data* pData)
+{
+    int i=0, length=0;
+    char nameInfo[NAME_LENGTH]={'\0'};
+    double delta=0., pMin[3]={0.}, pMax[3]={0.};
+    Nucleus *pNucleus=NULL;
+
+    // Check the input pointers
+    if (inputDirectory==NULL || pSystem==NULL || pParameters==NULL ||
+                  pChemicalSystem==NULL || pMesh==NULL || pData==NULL || nCpu<1)
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: one of the input pointers ");
+        fprintf(stderr,"inputDirectory=%p, ",(void*)inputDirectory);
+        fprintf(stderr,"pSystem=%p, ",(void*)pSystem);
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pMesh=%p, or pData=%p ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"does not point to a valid address, or the number of ");
+        fprintf(stderr,"threads (=%d) is not positive.\n",nCpu);
+        return 0;
+    }
+
+    // The name of the *.info file gives the ones of the files written here
+    // snprintf returns the number of characters that would have been written
+    length=snprintf(nameInfo,NAME_LENGTH,"%s",pSystem->name);
+    if (length<5 || length>=NAME_LENGTH-11)
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: the name of the chemical ");
+        fprintf(stderr,"file %s is not valid.\n",pSystem->name);
+        return 0;
+    }
+    strcpy(nameInfo+length-4,".bench.info");
+
+    if (!setupDefaultParameters(pParameters,nameInfo))
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: setupDefaultParameters ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+    pParameters->opt_mode=-1;
+    pParameters->verbose=0;
+    pParameters->n_cpu=nCpu;
+    pParameters->nu_electrons=pSystem->nu_electrons;
+    pParameters->ls_type=1;
+    pParameters->ls_r=pSystem->ls_r;
+    pParameters->iter_max=1;
+    pParameters->save_type=0;
+    pParameters->save_mesh=0;
+    pParameters->save_data=0;
+    pParameters->save_print=0;
+
+    // calloc returns a pointer to the allocated memory, otherwise NULL
+    pParameters->name_chem=(char*)calloc(NAME_LENGTH,sizeof(char));
+    pParameters->name_mesh=(char*)calloc(NAME_LENGTH,sizeof(char));
+    if (pParameters->name_chem==NULL || pParameters->name_mesh==NULL)
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: could not allocate memory for ");
+        fprintf(stderr,"the name_chem and name_mesh variables.\n");
+        return 0;
+    }
+    length=snprintf(pParameters->name_chem,NAME_LENGTH,"%s/%s",inputDirectory,
+                                                                 pSystem->name);
+    if (length<0 || length>=NAME_LENGTH)
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: the path of the chemical file ");
+        fprintf(stderr,"%s/%s should have less ",inputDirectory,pSystem->name);
+        fprintf(stderr,"than %d characters.\n",NAME_LENGTH);
+        return 0;
+    }
+    strcpy(pParameters->name_mesh,nameInfo);
+    strcpy(pParameters->name_mesh+strlen(nameInfo)-5,".mesh");
+
+    if (!loadChemistry(pParameters,pChemicalSystem))
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: loadChemistry function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+
+    // Build the computational box around the nuclei
+    if (pChemicalSystem->nnucl<1 || pChemicalSystem->pnucl==NULL ||
+                                                              pSystem->n_grid<3)
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: no nucleus has been loaded ");
+        fprintf(stderr,"or the number of grid points ");
+        fprintf(stderr,"(=%d) is less than three.\n",pSystem->n_grid);
+        return 0;
+    }
+    pNucleus=pChemicalSystem->pnucl;
+    pMin[0]=pNucleus[0].x;
+    pMin[1]=pNucleus[0].y;
+    pMin[2]=pNucleus[0].z;
+    for (i=0; i<3; i++)
+    {
+        pMax[i]=pMin[i];
+    }
+    for (i=1; i<pChemicalSystem->nnucl; i++)
+    {
+        pMin[0]=DEF_MIN(pMin[0],pNucleus[i].x);
+        pMin[1]=DEF_MIN(pMin[1],pNucleus[i].y);
+        pMin[2]=DEF_MIN(pMin[2],pNucleus[i].z);
+        pMax[0]=DEF_MAX(pMax[0],pNucleus[i].x);
+        pMax[1]=DEF_MAX(pMax[1],pNucleus[i].y);
+        pMax[2]=DEF_MAX(pMax[2],pNucleus[i].z);
+    }
+    delta=0.;
+    for (i=0; i<3; i++)
+    {
+        pMin[i]-=BENCH_MARGIN;
+        pMax[i]+=BENCH_MARGIN;
+        delta=DEF_MAX(delta,pMax[i]-pMin[i]);
+    }
+    delta/=(double)(pSystem->n_grid-1);
+
+    // The same step is used in all directions (the sides are centered)
+    pParameters->n_x=(int)ceil((pMax[0]-pMin[0])/delta-1.e-9)+1;
+    pParameters->n_y=(int)ceil((pMax[1]-pMin[1])/delta-1.e-9)+1;
+    pParameters->n_z=(int)ceil((pMax[2]-pMin[2])/delta-1.e-9)+1;
+    pParameters->x_min=.5*(pMin[0]+pMax[0]-(pParameters->n_x-1)*delta);
+    pParameters->y_min=.5*(pMin[1]+pMax[1]-(pParameters->n_y-1)*delta);
+    pParameters->z_min=.5*(pMin[2]+pMax[2]-(pParameters->n_z-1)*delta);
+    pParameters->x_max=pParameters->x_min+(pParameters->n_x-1)*delta;
+    pParameters->y_max=pParameters->y_min+(pParameters->n_y-1)*delta;
+    pParameters->z_max=pParameters->z_min+(pParameters->n_z-1)*delta;
+    pParameters->delta_x=(pParameters->x_max-pParameters->x_min)/
+                                                   (double)(pParameters->n_x-1);
+    pParameters->delta_y=(pParameters->y_max-pParameters->y_min)/
+                                                   (double)(pParameters->n_y-1);
+    pParameters->delta_z=(pParameters->z_max-pParameters->z_min)/
+                                                   (double)(pParameters->n_z-1);
+    pParameters->ls_x=pNucleus[0].x;
+    pParameters->ls_y=pNucleus[0].y;
+    pParameters->ls_z=pNucleus[0].z;
+
+    // Remove the mesh of a previous run so that the grid is always rebuilt
+    if (initialFileExists(pParameters->name_mesh,pParameters->name_length)==1)
+    {
+        remove(pParameters->name_mesh);
+    }
+
+    if (loadMesh(pParameters,pMesh)!=1)
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: loadMesh function did not ");
+        fprintf(stderr,"return one.\n");
+        return 0;
+    }
+
+    if (!adaptMesh(pParameters,pMesh,pChemicalSystem))
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: adaptMesh function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
+
+    if (!allocateMemoryForData(pParameters,pData,pChemicalSystem))
+    {
+        PRINT_ERROR("In setupBenchmarkSystem: allocateMemoryForData ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function buildTetrahedraFromGrid splits each hexahedron of the grid
+// stored in the structure pointed by pMesh into six tetrahedra sharing the
+// diagonal of the hexahedron linking its first and seventh vertices. They are
+// labelled three if their hexahedron is inside the domain, otherwise two. It
+// has the Parameters* and Mesh* variables (both defined in main.h) as input
+// arguments and it returns one on success, otherwise zero is returned
+/* ************************************************************************** */
+int buildTetrahedraFromGrid(Parameters* pParameters, Mesh* pMesh)
+{
+    int k=0, l=0, label=0, pVertex[8]={0};
+    int pSplit[18]={1,2,6,2,3,6,3,7,6,7,4,6,4,5,6,5,1,6};
+    Tetrahedron *pTetrahedron=NULL;
+
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In buildTetrahedraFromGrid: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p ",(void*)pParameters);
+        fprintf(stderr,"or pMesh=%p does not have a ",(void*)pMesh);
+        fprintf(stderr,"valid address.\n");
+        return 0;
+    }
+
+    if (pMesh->nhex!=(pParameters->n_x-1)*(pParameters->n_y-1)*
+                                      (pParameters->n_z-1) || pMesh->phex==NULL)
+    {
+        PRINT_ERROR("In buildTetrahedraFromGrid: the structure pointed by ");
+        fprintf(stderr,"pMesh does not store the %d ",pMesh->nhex);
+        fprintf(stderr,"hexahedra of the grid (phex=%p).\n",
+                                                            (void*)pMesh->phex);
+        return 0;
+    }
+
+    free(pMesh->ptet);
+    pMesh->ntet=0;
+
+    // calloc returns a pointer to the allocated memory, otherwise NULL
+    pMesh->ptet=(Tetrahedron*)calloc(6*pMesh->nhex,sizeof(Tetrahedron));
+    if (pMesh->ptet==NULL)
+    {
+        PRINT_ERROR("In buildTetrahedraFromGrid: could not allocate memory ");
+        fprintf(stderr,"for %d tetrahedra.\n",6*pMesh->nhex);
+        return 0;
+    }
+    pMesh->ntet=6*pMesh->nhex;
+
+    for (k=0; k<pMesh->nhex; k++)
+    {
+        getHexahedronVertices(k,pParameters->n_y,pParameters->n_z,pVertex);
+        label=2;
+        if (abs(pMesh->phex[k].label)==3)
+        {
+            label=3;
+        }
+        for (l=0; l<6; l++)
+        {
+            pTetrahedron=&pMesh->ptet[6*k+l];
+            pTetrahedron->p1=pVertex[0];
+            pTetrahedron->p2=pVertex[pSplit[3*l]];
+            pTetrahedron->p3=pVertex[pSplit[3*l+1]];
+            pTetrahedron->p4=pVertex[pSplit[3*l+2]];
+            pTetrahedron->label=label;
+        }
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function runBenchmarkKernel runs once the kernel-th kernel of the
+// benchmark on the chemical system stored in the structures pointed by
+// pParameters, pChemicalSystem, pMesh, and pData. It has the int kernel, the
+// Parameters*, ChemicalSystem*, Mesh*, Data* variables (defined in main.h),
+// and the two double* pItems and pChecksum as input arguments. It returns one
+// on success (the number of items treated and the checksum of the numerical
+// result of the kernel are then stored in pItems and pChecksum), otherwise
+// zero is returned
+/* ************************************************************************** */
+int runBenchmarkKernel(int kernel, Parameters* pParameters,
+                       ChemicalSystem* pChemicalSystem, Mesh* pMesh,
+                       Data* pData, double* pItems, double* pChecksum)
+{
+    int i=0, j=0, k=0, l=0, nVer=0, nMorb=0, nGauss=0, nCell=0, nPair=0;
+    int *pLabel=NULL;
+    double value=0., checksum=0.;
+    Point *pPoint=NULL;
+    MolecularOrbital *pMolecularOrbital=NULL;
+
+    if (pParameters==NULL || pChemicalSystem==NULL || pMesh==NULL ||
+                                 pData==NULL || pItems==NULL || pChecksum==NULL)
+    {
+        PRINT_ERROR("In runBenchmarkKernel: at least one of the input ");
+        fprintf(stderr,"variables does not have a valid address.\n");
+        return 0;
+    }
+    *pItems=0.;
+    *pChecksum=0.;
+
+    nVer=pMesh->nver;
+    nMorb=pChemicalSystem->nmorb;
+    nGauss=pChemicalSystem->ngauss;
+    if (nVer<1 || nMorb<1 || nGauss<1 || pMesh->pver==NULL ||
+                                   pMesh->phex==NULL || pData->pmat==NULL ||
+                                                   pChemicalSystem->pmorb==NULL)
+    {
+        PRINT_ERROR("In runBenchmarkKernel: the chemical system, the grid ");
+        fprintf(stderr,"or the data have not been properly set up ");
+        fprintf(stderr,"(nver=%d, nmorb=%d, ngauss=%d).\n",nVer,nMorb,nGauss);
+        return 0;
+    }
+
+    // Number of pairs of orbitals whose overlap is integrated (same rules as
+    // in computeOverlapMatrix and computeOverlapMatrixOnGrid functions)
+    for (i=0; i<nMorb; i++)
+    {
+        if (pParameters->orb_rhf && i>=nMorb/2)
+        {
+            continue;
+        }
+        for (j=0; j<=i; j++)
+        {
+            if (pParameters->orb_rhf || pChemicalSystem->pmorb[i].spin==
+                                                 pChemicalSystem->pmorb[j].spin)
+            {
+                nPair++;
+            }
+        }
+    }
+
+    switch (kernel)
+    {
+        // Evaluation of all the Gaussian-type primitives at the grid points
+        case 0:
+#pragma omp parallel for default(shared) private(pPoint,i,l,pMolecularOrbital,value) reduction(+:checksum)
+            for (k=0; k<nVer; k++)
+            {
+                pPoint=&pMesh->pver[k];
+                for (i=0; i<nMorb; i++)
+                {
+                    pMolecularOrbital=&pChemicalSystem->pmorb[i];
+                    value=0.;
+                    for (l=0; l<nGauss; l++)
+                    {
+                        value+=evaluatingPrimitiveAtVertices(pPoint->x,
+                                                             pPoint->y,
+                                                             pPoint->z,
+                                                             pChemicalSystem,
+                                                             pMolecularOrbital,
+                                                                             l);
+                    }
+                    checksum+=value*value;
+                }
+            }
+            *pItems=(double)nVer*(double)nMorb*(double)nGauss;
+            break;
+
+        // Overlap matrix on the hexahedra of the domain
+        case 1:
+            if (!computeOverlapMatrixOnGrid(pParameters,pMesh,pData,
+                                                           pChemicalSystem,2,0))
+            {
+                PRINT_ERROR("In runBenchmarkKernel: ");
+                fprintf(stderr,"computeOverlapMatrixOnGrid function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+            for (k=0; k<pMesh->nhex; k++)
+            {
+                if (pMesh->phex[k].label!=2)
+                {
+                    nCell++;
+                }
+            }
+            for (k=0; k<nMorb*nMorb; k++)
+            {
+                checksum+=pData->pmat[0].coef[k];
+            }
+            *pItems=(double)nPair*(double)nCell;
+            break;
+
+        // Diagonalization of the overlap matrix
+        case 2:
+            if (!diagonalizeOverlapMatrix(pParameters,pData,0))
+            {
+                PRINT_ERROR("In runBenchmarkKernel: diagonalizeOverlapMatrix ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+            for (k=0; k<nMorb; k++)
+            {
+                checksum+=pData->pmat[0].diag[k];
+            }
+            *pItems=1.;
+            break;
+
+        // Probability to find exactly nu_electrons in the domain
+        case 3:
+            if (!computeProbability(pParameters,pData,0))
+            {
+                PRINT_ERROR("In runBenchmarkKernel: computeProbability ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+            checksum=pData->pnu[0];
+            *pItems=1.;
+            break;
+
+        // Shape gradient on the boundary of the domain (the labels of the
+        // hexahedra are restored so that the domain does not change)
+        case 4:
+            // calloc returns a pointer to the allocated memory, otherwise NULL
+            pLabel=(int*)calloc(pMesh->nhex,sizeof(int));
+            if (pLabel==NULL)
+            {
+                PRINT_ERROR("In runBenchmarkKernel: could not allocate ");
+                fprintf(stderr,"memory for the local (int*) variable ");
+                fprintf(stderr,"pLabel.\n");
+                return 0;
+            }
+            for (k=0; k<pMesh->nhex; k++)
+            {
+                pLabel[k]=pMesh->phex[k].label;
+            }
+            if (!computeShapeGradient(pParameters,pMesh,pData,pChemicalSystem,
+                                                                             0))
+            {
+                PRINT_ERROR("In runBenchmarkKernel: computeShapeGradient ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                free(pLabel);
+                pLabel=NULL;
+                return 0;
+            }
+            for (k=0; k<pMesh->nhex; k++)
+            {
+                checksum+=(double)(k+1)*abs(pMesh->phex[k].label-pLabel[k]);
+                pMesh->phex[k].label=pLabel[k];
+            }
+            free(pLabel);
+            pLabel=NULL;
+            *pItems=(double)pMesh->nadj;
+            break;
+
+        // Metric of the molecular orbitals at the grid points
+        case 5:
+            i=pParameters->opt_mode;
+            pParameters->opt_mode=2;
+            j=evaluatingMetricOnMesh(pParameters,pMesh,pChemicalSystem);
+            pParameters->opt_mode=i;
+            if (!j)
+            {
+                PRINT_ERROR("In runBenchmarkKernel: evaluatingMetricOnMesh ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+            for (k=0; k<nVer; k++)
+            {
+                checksum+=pMesh->pver[k].value;
+            }
+            *pItems=(double)nVer;
+            break;
+
+        // Overlap matrix on the tetrahedra of the domain
+        case 6:
+            if (pMesh->ptet==NULL)
+            {
+                if (!buildTetrahedraFromGrid(pParameters,pMesh))
+                {
+                    PRINT_ERROR("In runBenchmarkKernel: ");
+                    fprintf(stderr,"buildTetrahedraFromGrid function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+            i=pParameters->opt_mode;
+            pParameters->opt_mode=2;
+            j=computeOverlapMatrix(pParameters,pMesh,pData,pChemicalSystem,2,
+                                                                             0);
+            pParameters->opt_mode=i;
+            if (!j)
+            {
+                PRINT_ERROR("In runBenchmarkKernel: computeOverlapMatrix ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+            for (k=0; k<pMesh->ntet; k++)
+            {
+                if (pMesh->ptet[k].label!=2)
+                {
+                    nCell++;
+                }
+            }
+            for (k=0; k<nMorb*nMorb; k++)
+            {
+                checksum+=pData->pmat[0].coef[k];
+            }
+            *pItems=(double)nPair*(double)nCell;
+            break;
+
+        default:
+            PRINT_ERROR("In runBenchmarkKernel: the input kernel variable ");
+            fprintf(stderr,"(=%d) should be a non-negative integer ",kernel);
+            fprintf(stderr,"(strictly) less than %d.\n",BENCH_KERNELS);
+            return 0;
+            break;
+    }
+    *pChecksum=checksum;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function runBenchmarkSystem times all the kernels of the benchmark on
+// the chemical system pointed by pSystem and writes a line in resultFile for
+// each kernel (best time of at most BENCH_REPEAT runs, stopped once BENCH_TIME
+// seconds have been spent on the kernel). It has the char* inputDirectory, the
+// BenchmarkSystem* (defined in benchmark.h), the int nCpu and the FILE*
+// resultFile variables as input arguments and it returns one on success,
+// otherwise zero is returned
+/* ************************************************************************** */
+int runBenchmarkSystem(char* inputDirectory, BenchmarkSystem* pSystem,
+                                                     int nCpu, FILE* resultFile)
+{
+    int kernel=0, repeat=0, boolean=0, length=0;
+    char nameSystem[NAME_LENGTH]={'\0'};
+    double items=0., checksum=0., timer=0., timeRun=0., timeBest=0., timeSum=0.;
+    Parameters parameters;
+    ChemicalSystem chemicalSystem;
+    Mesh mesh;
+    Data data;
+
+    if (pSystem==NULL || pSystem->name==NULL || resultFile==NULL)
+    {
+        PRINT_ERROR("In runBenchmarkSystem: at least one of the input ");
+        fprintf(stderr,"variables pSystem=%p ",(void*)pSystem);
+        fprintf(stderr,"or resultFile=%p does not ",(void*)resultFile);
+        fprintf(stderr,"have a valid address.\n");
+        return 0;
+    }
+
+    // The name of the system is the one of the *.wfn file without extension
+    length=snprintf(nameSystem,NAME_LENGTH,"%s",pSystem->name);
+    if (length>4 && length<NAME_LENGTH)
+    {
+        nameSystem[length-4]='\0';
+    }
+
+    initializeParameterStructure(&parameters);
+    initializeChemicalStructure(&chemicalSystem);
+    initializeMeshStructure(&mesh);
+    initializeDataStructure(&data);
+
+    boolean=setupBenchmarkSystem(inputDirectory,pSystem,nCpu,&parameters,
+                                                   &chemicalSystem,&mesh,&data);
+    if (!boolean)
+    {
+        PRINT_ERROR("In runBenchmarkSystem: setupBenchmarkSystem function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+    }
+    else
+    {
+        fprintf(stdout,"\nBenchmarking %s (%d orbitals, ",nameSystem,
+                                                          chemicalSystem.nmorb);
+        fprintf(stdout,"%d primitives) on a ",chemicalSystem.ngauss);
+        fprintf(stdout,"%dx%dx%d grid ",parameters.n_x,parameters.n_y,
+                                                                parameters.n_z);
+        fprintf(stdout,"with %d thread(s).\n",nCpu);
+    }
+
+    for (kernel=0; boolean && kernel<BENCH_KERNELS; kernel++)
+    {
+        timeBest=0.;
+        timeSum=0.;
+        for (repeat=0; repeat<BENCH_REPEAT && timeSum<BENCH_TIME; repeat++)
+        {
+            timer=getMonotonicTime();
+            if (!runBenchmarkKernel(kernel,&parameters,&chemicalSystem,&mesh,
+                                                        &data,&items,&checksum))
+            {
+                PRINT_ERROR("In runBenchmarkSystem: runBenchmarkKernel ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                boolean=0;
+                break;
+            }
+            timeRun=getMonotonicTime()-timer;
+            timeSum+=timeRun;
+            if (!repeat || timeRun<timeBest)
+            {
+                timeBest=timeRun;
+            }
+        }
+        if (!boolean)
+        {
+            break;
+        }
+        if (timeBest<=0.)
+        {
+            timeBest=1.e-9;
+        }
+
+        fprintf(resultFile,"%s %s %.0lf %d %.9lf %.6le %s %.15le\n",nameSystem,
+                           getNameOfKernel(kernel),items,repeat,timeBest,
+                               items/timeBest,getUnitOfKernel(kernel),checksum);
+        fflush(resultFile);
+        fprintf(stdout,"%-28s %-16s %12.6lf s %14.6le %s\n",nameSystem,
+                       getNameOfKernel(kernel),timeBest,items/timeBest,
+                                                       getUnitOfKernel(kernel));
+    }
+
+    // Remove the files written in the current directory for the system (the
+    // *.chem file converted from the *.wfn one has the name of the *.info one)
+    if (parameters.name_mesh!=NULL)
+    {
+        remove(parameters.name_mesh);
+    }
+    if (parameters.name_info!=NULL && strlen(parameters.name_info)>5)
+    {
+        length=strlen(parameters.name_info);
+        strcpy(&parameters.name_info[length-5],".chem");
+        remove(parameters.name_info);
+    }
+    freeMeshMemory(&mesh);
+    freeDataMemory(&data);
+    freeChemicalMemory(&chemicalSystem);
+    freeParameterMemory(&parameters);
+
+    return boolean;
+}
+
+/* ************************************************************************** */
+// The function readBenchmarkFile reads the result file of a benchmark located
+// at fileLocation, skipping the lines starting with #, and stores its lines in
+// an array of BenchmarkResult structures allocated here. It has the char*
+// fileLocation, the BenchmarkResult** pResult (defined in benchmark.h) and the
+// int* pNumberOfResults variables as input arguments and it returns one on
+// success, otherwise zero is returned
+/* ************************************************************************** */
+int readBenchmarkFile(char* fileLocation, BenchmarkResult** pResult,
+                                                          int* pNumberOfResults)
+{
+    int nResult=0, nMax=0;
+    char line[4*NAME_LENGTH]={'\0'};
+    double throughput=0.;
+    char unit[NAME_LENGTH]={'\0'};
+    BenchmarkResult *pNew=NULL, *pCurrent=NULL;
+    FILE *benchmarkFile=NULL;
+
+    if (fileLocation==NULL || pResult==NULL || pNumberOfResults==NULL)
+    {
+        PRINT_ERROR("In readBenchmarkFile: at least one of the input ");
+        fprintf(stderr,"variables does not have a valid address.\n");
+        return 0;
+    }
+    *pResult=NULL;
+    *pNumberOfResults=0;
+
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    benchmarkFile=fopen(fileLocation,"r");
+    if (benchmarkFile==NULL)
+    {
+        PRINT_ERROR("In readBenchmarkFile: could not read the ");
+        fprintf(stderr,"%s file.\n",fileLocation);
+        return 0;
+    }
+
+    // fgets returns NULL at the end of the file or if an error occurs
+    while (fgets(line,4*NAME_LENGTH,benchmarkFile)!=NULL)
+    {
+        if (line[0]=='#' || line[0]=='\n')
+        {
+            continue;
+        }
+
+        if (nResult==nMax)
+        {
+            // realloc returns a pointer to the reallocated memory or NULL
+            nMax=2*nMax+BENCH_KERNELS;
+            pNew=(BenchmarkResult*)realloc(*pResult,
+                                                  nMax*sizeof(BenchmarkResult));
+            if (pNew==NULL)
+            {
+                PRINT_ERROR("In readBenchmarkFile: could not reallocate ");
+                fprintf(stderr,"memory for %d results.\n",nMax);
+                free(*pResult);
+                *pResult=NULL;
+                fclose(benchmarkFile);
+                return 0;
+            }
+            *pResult=pNew;
+        }
+        pCurrent=&(*pResult)[nResult];
+
+        // sscanf returns the number of input items successfully matched
+        if (sscanf(line,"%100s %100s %lf %d %lf %lf %100s %lf",
+                   pCurrent->system,pCurrent->kernel,&pCurrent->items,
+                   &pCurrent->repeat,&pCurrent->time,&throughput,unit,
+                                                        &pCurrent->checksum)!=8)
+        {
+            PRINT_ERROR("In readBenchmarkFile: wrong format of the line ");
+            fprintf(stderr,"%d of the %s file:\n%s",nResult+1,fileLocation,
+                                                                          line);
+            free(*pResult);
+            *pResult=NULL;
+            fclose(benchmarkFile);
+            return 0;
+        }
+        nResult++;
+    }
+
+    // fclose returns zero if the input FILE* variable is successfully closed
+    if (fclose(benchmarkFile))
+    {
+        PRINT_ERROR("In readBenchmarkFile: could not close the ");
+        fprintf(stderr,"%s file properly.\n",fileLocation);
+        free(*pResult);
+        *pResult=NULL;
+        return 0;
+    }
+    *pNumberOfResults=nResult;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function compareBenchmarkFiles compares the result file located at
+// resultFile with the one located at referenceFile (e.g. written by another
+// build). For each kernel, it prints the speedup with respect to the reference
+// time and checks that the checksums agree up to BENCH_TOLERANCE. It has the
+// two char* referenceFile and resultFile as input arguments and it returns one
+// if all the kernels agree, minus one if one of them disagrees or is missing
+// in the reference file, and zero if an error occurs
+/* ************************************************************************** */
+int compareBenchmarkFiles(char* referenceFile, char* resultFile)
+{
+    int i=0, j=0, nReference=0, nResult=0, returnValue=1;
+    double difference=0., speedup=0.;
+    BenchmarkResult *pReference=NULL, *pResult=NULL, *pCurrent=NULL;
+
+    if (!readBenchmarkFile(referenceFile,&pReference,&nReference))
+    {
+        PRINT_ERROR("In compareBenchmarkFiles: readBenchmarkFile function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+
+    if (!readBenchmarkFile(resultFile,&pResult,&nResult))
+    {
+        PRINT_ERROR("In compareBenchmarkFiles: readBenchmarkFile function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        free(pReference);
+        pReference=NULL;
+        return 0;
+    }
+
+    fprintf(stdout,"\nComparing %s with the reference %s.\n",resultFile,
+                                                                 referenceFile);
+    fprintf(stdout,"%-28s %-16s %12s %12s %9s %10s\n","system","kernel",
+                                     "reference","time","speedup","difference");
+    for (i=0; i<nResult; i++)
+    {
+        pCurrent=&pResult[i];
+        for (j=0; j<nReference; j++)
+        {
+            if (!strcmp(pReference[j].system,pCurrent->system) &&
+                                !strcmp(pReference[j].kernel,pCurrent->kernel))
+            {
+                break;
+            }
+        }
+        if (j==nReference)
+        {
+            fprintf(stdout,"%-28s %-16s %12s %12.6lf %9s %10s MISSING\n",
+                           pCurrent->system,pCurrent->kernel,"-",
+                                                        pCurrent->time,"-","-");
+            returnValue=-1;
+            continue;
+        }
+
+        difference=fabs(pCurrent->checksum-pReference[j].checksum);
+        if (fabs(pReference[j].checksum)>1.)
+        {
+            difference/=fabs(pReference[j].checksum);
+        }
+        speedup=pReference[j].time/DEF_MAX(pCurrent->time,1.e-9);
+
+        fprintf(stdout,"%-28s %-16s %12.6lf %12.6lf %9.3lf %10.3le ",
+                       pCurrent->system,pCurrent->kernel,pReference[j].time,
+                                             pCurrent->time,speedup,difference);
+        if (difference>BENCH_TOLERANCE ||
+                                           pCurrent->items!=pReference[j].items)
+        {
+            fprintf(stdout,"DIFF\n");
+            returnValue=-1;
+        }
+        else
+        {
+            fprintf(stdout,"OK\n");
+        }
+    }
+
+    free(pReference);
+    pReference=NULL;
+    free(pResult);
+    pResult=NULL;
+
+    return returnValue;
+}
+
+/* ************************************************************************** */
+// The function main of the mpdBenchmark program times the kernels of the MPD
+// algorithm on the chemical systems of the benchmarkSystems array. It has the
+// usual int argc, char *argv[] command line as input arguments and it returns
+// EXIT_FAILURE if an error occurs or if the checksums disagree with the
+// reference file, otherwise EXIT_SUCCESS is returned. The command line must be
+// 'mpdBenchmark inputDirectory resultFile [-cpu n] [-only name]
+// [-reference file]', where inputDirectory contains the *.wfn files, or
+// 'mpdBenchmark -compare referenceFile resultFile' to compare two result files
+/* ************************************************************************** */
+int main(int argc, char *argv[])
+{
+    int i=0, nCpu=1, returnValue=1, nSystem=0;
+    char *nameOnly=NULL, *referenceFile=NULL;
+    FILE *resultFile=NULL;
+
+    if (argc==4 && !strcmp(argv[1],"-compare"))
+    {
+        returnValue=compareBenchmarkFiles(argv[2],argv[3]);
+        if (!returnValue)
+        {
+            PRINT_ERROR("In main: compareBenchmarkFiles function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+        }
+        return (returnValue==1) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Read the options of the command line
+    if (argc<3 || argv[1][0]=='-' || argv[2][0]=='-')
+    {
+        returnValue=0;
+    }
+    for (i=3; returnValue && i<argc; i+=2)
+    {
+        if (i+1>=argc)
+        {
+            returnValue=0;
+        }
+        else if (!strcmp(argv[i],"-cpu"))
+        {
+            nCpu=atoi(argv[i+1]);
+            if (nCpu<1)
+            {
+                returnValue=0;
+            }
+        }
+        else if (!strcmp(argv[i],"-only"))
+        {
+            nameOnly=argv[i+1];
+        }
+        else if (!strcmp(argv[i],"-reference"))
+        {
+            referenceFile=argv[i+1];
+        }
+        else
+        {
+            returnValue=0;
+        }
+    }
+    if (!returnValue)
+    {
+        PRINT_ERROR("In main: the mpdBenchmark program must be called as ");
+        fprintf(stderr,"'%s inputDirectory resultFile [-cpu n] ",argv[0]);
+        fprintf(stderr,"[-only name] [-reference file]', where ");
+        fprintf(stderr,"inputDirectory contains the *.wfn files and the ");
+        fprintf(stderr,"number n of threads is positive, or as '%s ",argv[0]);
+        fprintf(stderr,"-compare referenceFile resultFile'.\n");
+        return EXIT_FAILURE;
+    }
+    omp_set_num_threads(nCpu);
+
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    resultFile=fopen(argv[2],"w");
+    if (resultFile==NULL)
+    {
+        PRINT_ERROR("In main: could not write the ");
+        fprintf(stderr,"%s file.\n",argv[2]);
+        return EXIT_FAILURE;
+    }
+    fprintf(resultFile,"# system kernel items repeat time throughput unit ");
+    fprintf(resultFile,"checksum\n");
+
+    for (i=0; returnValue && i<BENCH_SYSTEMS; i++)
+    {
+        // The -only name must match the whole *.wfn file name, with or
+        // without its extension (a prefix such as h2 would select h2o too)
+        if (nameOnly!=NULL && strcmp(benchmarkSystems[i].name,nameOnly) &&
+            (strncmp(benchmarkSystems[i].name,nameOnly,strlen(nameOnly)) ||
+                  strcmp(benchmarkSystems[i].name+strlen(nameOnly),".wfn")))
+        {
+            continue;
+        }
+        nSystem++;
+        if (!runBenchmarkSystem(argv[1],&benchmarkSystems[i],nCpu,resultFile))
+        {
+            PRINT_ERROR("In main: runBenchmarkSystem function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+            returnValue=0;
+        }
+    }
+
+    // fclose returns zero if the input FILE* variable is successfully closed
+    if (fclose(resultFile))
+    {
+        PRINT_ERROR("In main: could not close the ");
+        fprintf(stderr,"%s file properly.\n",argv[2]);
+        return EXIT_FAILURE;
+    }
+    if (!returnValue)
+    {
+        return EXIT_FAILURE;
+    }
+    if (!nSystem)
+    {
+        PRINT_ERROR("In main: no chemical system of the benchmark is ");
+        fprintf(stderr,"named %s (give the whole name of its *.wfn ",nameOnly);
+        fprintf(stderr,"file, e.g. h2-sto6g).\n");
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout,"\nResults written in %s.\n",argv[2]);
+
+    if (referenceFile!=NULL)
+    {
+        returnValue=compareBenchmarkFiles(referenceFile,argv[2]);
+        if (!returnValue)
+        {
+            PRINT_ERROR("In main: compareBenchmarkFiles function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+        }
+        if (returnValue!=1)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
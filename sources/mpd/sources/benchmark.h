@@ -0,0 +1,304 @@
+#ifndef DEF_BENCHMARK
+#define DEF_BENCHMARK
+
+/**
+* \file benchmark.h
+* \brief Macros, structures and prototypes of the micro-benchmark of the hot
+*        kernels of the MPD algorithm.
+* \author Jeremy DALPHIN
+* \version 2.0
+* \date September 1st, 2018
+*
+* This file contains the description of all the preprocessor constants,
+* structures and non-static function prototypes that are used by the
+* mpdBenchmark program. It times separately the hot kernels of the MPD
+* algorithm on fixed grids built around representative chemical systems of the
+* inputFiles directory, checks their numerical results against a reference
+* file, and compares the results of two builds.
+*/
+
+#include "main.h"
+
+/**
+* \def BENCH_REPEAT
+* \brief Maximal number of times each kernel is run (the best time is kept).
+*/
+#define BENCH_REPEAT 5
+
+/**
+* \def BENCH_TIME
+* \brief Time (in seconds) after which a kernel is not run again, even if it
+*        has been run less than \ref BENCH_REPEAT times.
+*/
+#define BENCH_TIME 2.0
+
+/**
+* \def BENCH_MARGIN
+* \brief Distance (in bohr) added around the nuclei to build the computational
+*        box of a chemical system.
+*/
+#define BENCH_MARGIN 3.0
+
+/**
+* \def BENCH_TOLERANCE
+* \brief Relative tolerance used when the checksum of a kernel is compared with
+*        the one of a reference file (the OpenMP reductions may change the
+*        order of the sums between two runs).
+*/
+#define BENCH_TOLERANCE 1.e-10
+
+/**
+* \def BENCH_KERNELS
+* \brief Number of kernels timed for each chemical system (see
+*        \ref getNameOfKernel).
+*/
+#define BENCH_KERNELS 7
+
+/**
+* \def BENCH_SYSTEMS
+* \brief Number of chemical systems in the \ref benchmarkSystems array.
+*/
+#define BENCH_SYSTEMS 9
+
+/**
+* \struct BenchmarkSystem benchmark.h
+* \brief It describes a chemical system of the benchmark and the fixed grid and
+*        initial domain on which its kernels are timed.
+*/
+typedef struct {
+    char* name;              /*!< Name of the *.wfn file in the inputFiles
+                             *    directory. */
+
+    int nu_electrons;        /*!< Number of electrons to look for. */
+
+    int n_grid;              /*!< Number of points of the grid in the longest
+                             *    direction of the computational box (the
+                             *    grid step is the same in all directions). */
+
+    double ls_r;             /*!< Radius of the initial sphere, centered at the
+                             *    first nucleus of the chemical system. */
+} BenchmarkSystem;
+
+/**
+* \struct BenchmarkResult benchmark.h
+* \brief It stores the result of a kernel for a chemical system, as written in
+*        (or read from) the result file of the benchmark.
+*/
+typedef struct {
+    char system[NAME_LENGTH]; /*!< Name of the chemical system. */
+
+    char kernel[NAME_LENGTH]; /*!< Name of the kernel (see
+                              *    \ref getNameOfKernel). */
+
+    double items;            /*!< Number of items (points or pairs) treated by
+                             *    one run of the kernel. */
+
+    int repeat;              /*!< Number of times the kernel has been run. */
+
+    double time;             /*!< Best time (in seconds) of the runs. */
+
+    double checksum;         /*!< Checksum of the numerical result of the
+                             *    kernel. */
+} BenchmarkResult;
+
+/**
+* \var benchmarkSystems
+* \brief Global array storing the \ref BENCH_SYSTEMS chemical systems of the
+*        benchmark, from the smallest to the largest one.
+*/
+extern BenchmarkSystem benchmarkSystems[BENCH_SYSTEMS];
+
+/**
+* \fn char* getNameOfKernel(int kernel)
+* \brief It gives the name of a kernel of the benchmark.
+*
+* \param[in] kernel The position of the kernel (between zero and
+*                   \ref BENCH_KERNELS minus one).
+*
+* \return It returns the name of the kernel (written in the result file), or
+*         "unknown" if the kernel input variable is not valid.
+*/
+char* getNameOfKernel(int kernel);
+
+/**
+* \fn char* getUnitOfKernel(int kernel)
+* \brief It gives the unit of the throughput of a kernel of the benchmark.
+*
+* \param[in] kernel The position of the kernel (between zero and
+*                   \ref BENCH_KERNELS minus one).
+*
+* \return It returns the unit of the throughput of the kernel (points/s,
+*         pairs/s, evaluations/s of primitives, ...), or "items/s" if the
+*         kernel input variable is not valid.
+*/
+char* getUnitOfKernel(int kernel);
+
+/**
+* \fn int setupBenchmarkSystem(char* inputDirectory, BenchmarkSystem* pSystem,
+*                              int nCpu, Parameters* pParameters,
+*                              ChemicalSystem* pChemicalSystem, Mesh* pMesh,
+*                                                                   Data* pData)
+* \brief It loads a chemical system of the benchmark and builds the fixed grid
+*        and initial domain on which its kernels are timed.
+*
+* \param[in] inputDirectory A pointer to the string storing the path of the
+*                           directory containing the *.wfn files.
+*
+* \param[in] pSystem A pointer that points to the BenchmarkSystem structure
+*                    (defined in benchmark.h) to load.
+*
+* \param[in] nCpu The number of OpenMP threads used by the kernels.
+*
+* \param[out] pParameters A pointer that points to the Parameters structure
+*                         (defined in main.h) to fill.
+*
+* \param[out] pChemicalSystem A pointer that points to the ChemicalSystem
+*                             structure (defined in main.h) to fill.
+*
+* \param[out] pMesh A pointer that points to the Mesh structure (defined in
+*                   main.h) to fill.
+*
+* \param[out] pData A pointer that points to the Data structure (defined in
+*                   main.h) to allocate.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* The computational box is the bounding box of the nuclei enlarged by
+* \ref BENCH_MARGIN in all directions, discretized with the same step in all
+* directions so that its longest side has n_grid points. The initial domain is
+* the sphere of radius ls_r centered at the first nucleus. The grid and domain
+* only depend on the chemical system, so that two builds always time the
+* kernels on the same inputs. The *.info file is not read (its name is only
+* used to build the ones of the files written in the current directory) and
+* the paths of the external softwares are not checked since they are not used.
+*/
+int setupBenchmarkSystem(char* inputDirectory, BenchmarkSystem* pSystem,
+                         int nCpu, Parameters* pParameters,
+                         ChemicalSystem* pChemicalSystem, Mesh* pMesh,
+                                                                   Data* pData);
+
+/**
+* \fn int buildTetrahedraFromGrid(Parameters* pParameters, Mesh* pMesh)
+* \brief It splits each hexahedron of the grid into six tetrahedra.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        (defined in main.h) storing the size of the grid.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure (defined in
+*                      main.h) of the hexahedral grid.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* The tetrahedra share the diagonal linking the first and seventh vertices of
+* their hexahedron (see \ref getHexahedronVertices) and they are labelled three
+* if their hexahedron is inside the domain, otherwise two, so that the
+* tetrahedral kernels can be timed without calling the mmg3d software.
+*/
+int buildTetrahedraFromGrid(Parameters* pParameters, Mesh* pMesh);
+
+/**
+* \fn int runBenchmarkKernel(int kernel, Parameters* pParameters,
+*                            ChemicalSystem* pChemicalSystem, Mesh* pMesh,
+*                            Data* pData, double* pItems, double* pChecksum)
+* \brief It runs once a kernel of the benchmark.
+*
+* \param[in] kernel The position of the kernel (between zero and
+*                   \ref BENCH_KERNELS minus one).
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        (defined in main.h) of the chemical system.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure (defined in main.h) of the system.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure (defined in
+*                      main.h) of the chemical system.
+*
+* \param[in,out] pData A pointer that points to the Data structure (defined in
+*                      main.h) of the chemical system.
+*
+* \param[out] pItems A pointer to the double variable storing the number of
+*                    items treated by the kernel.
+*
+* \param[out] pChecksum A pointer to the double variable storing the checksum
+*                       of the numerical result of the kernel.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* The kernels must be run in their order since each one uses the results of
+* the previous ones (e.g. the probability needs the diagonalized overlap
+* matrix). The labels of the hexahedra modified by the shape gradient kernel
+* are restored so that it can be run again on the same domain.
+*/
+int runBenchmarkKernel(int kernel, Parameters* pParameters,
+                       ChemicalSystem* pChemicalSystem, Mesh* pMesh,
+                       Data* pData, double* pItems, double* pChecksum);
+
+/**
+* \fn int runBenchmarkSystem(char* inputDirectory, BenchmarkSystem* pSystem,
+*                                             int nCpu, FILE* resultFile)
+* \brief It times all the kernels of the benchmark on a chemical system.
+*
+* \param[in] inputDirectory A pointer to the string storing the path of the
+*                           directory containing the *.wfn files.
+*
+* \param[in] pSystem A pointer that points to the BenchmarkSystem structure
+*                    (defined in benchmark.h) to time.
+*
+* \param[in] nCpu The number of OpenMP threads used by the kernels.
+*
+* \param[in] resultFile The FILE* variable of the result file where a line is
+*                       written for each kernel.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* Each kernel is run at most \ref BENCH_REPEAT times (and not anymore once
+* \ref BENCH_TIME seconds have been spent on it) and its best time is kept. The
+* files written in the current directory for the chemical system are removed
+* at the end.
+*/
+int runBenchmarkSystem(char* inputDirectory, BenchmarkSystem* pSystem,
+                                                    int nCpu, FILE* resultFile);
+
+/**
+* \fn int readBenchmarkFile(char* fileLocation, BenchmarkResult** pResult,
+*                                                         int* pNumberOfResults)
+* \brief It reads the result file of a benchmark.
+*
+* \param[in] fileLocation A pointer to the string storing the path of the
+*                         result file.
+*
+* \param[out] pResult A pointer to the BenchmarkResult* variable (defined in
+*                     benchmark.h) that points to the array of results
+*                     allocated here (to be freed).
+*
+* \param[out] pNumberOfResults A pointer to the int variable storing the
+*                              number of results read.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* The lines starting with # are skipped.
+*/
+int readBenchmarkFile(char* fileLocation, BenchmarkResult** pResult,
+                                                         int* pNumberOfResults);
+
+/**
+* \fn int compareBenchmarkFiles(char* referenceFile, char* resultFile)
+* \brief It compares the result file of a benchmark with a reference one.
+*
+* \param[in] referenceFile A pointer to the string storing the path of the
+*                          reference file (e.g. the results of another build).
+*
+* \param[in] resultFile A pointer to the string storing the path of the result
+*                       file to check.
+*
+* \return It returns one if all the kernels of the result file agree with the
+*         reference ones, minus one if at least one disagrees or is missing in
+*         the reference file, and zero if an error occurs.
+*
+* For each kernel, the speedup with respect to the reference time is printed,
+* and the checksums must agree up to the relative \ref BENCH_TOLERANCE.
+*/
+int compareBenchmarkFiles(char* referenceFile, char* resultFile);
+
+#endif
@@ -172,7 +172,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
     int returnValue=0;
     double readDouble=0.;
     MolecularOrbital *pMolecularOrbital=NULL, *pMolecularOrbital2=NULL;
-    FILE *chemicalFile=NULL;
+    MappedFile chemicalFile={NULL,0,0};
 
     // Check if the input pChemicalSystem variable is pointing to NULL
     if (pChemicalSystem==NULL)
@@ -198,11 +198,10 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         return 0;
     }
 
-    // Check if the *.chem file is well opened: fopen function returns a FILE
-    // pointer on success, otherwise NULL is returned
+    // Map the content of the *.chem file into memory: openMappedFile returns
+    // one on success, otherwise zero is returned
     fprintf(stdout,"\nOpening %s file. ",fileLocation);
-    chemicalFile=fopen(fileLocation,"r");
-    if (chemicalFile==NULL)
+    if (!openMappedFile(fileLocation,nameLength,&chemicalFile))
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: could not ");
         fprintf(stderr,"read the content of %s file.\n",fileLocation);
@@ -210,36 +209,35 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
     }
     fprintf(stdout,"Reading chemical data. ");
 
-    // fscanf function returns the number of input items successfully matched
-    // and assigned, which can be fewer than provided for. Important remark:
-    // white space characters, such as blanks and newline characters, causes
-    // fscanf (scanf and sscanf) to read, but not to store, all consecutive
-    // white space characters in the input up to the next character that is not
-    // white space. One white space character in format-string matches any
-    // combination of white space characters in the input
-    readIntegerOut=fscanf(chemicalFile," ");
+    // The scan*InMappedFile functions return one if an item has been read and
+    // assigned, zero otherwise (EOF at the end of the file). As the fscanf
+    // c-function with a white space in the format-string, they skip (without
+    // storing them) all the consecutive white space characters of the input
+    readIntegerOut=skipSpacesInMappedFile(&chemicalFile);
     if (readIntegerOut)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"(=%d) of the fscanf function ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
+        fprintf(stderr,"function ");
         fprintf(stderr,"(EOF=%d) while attempting to read the ",EOF);
         fprintf(stderr,"first white space characters (in case there was ");
         fprintf(stderr,"some) of the %s file.\n",fileLocation);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     // Read number of molecular orbitals and store it in pChemicalSystem->nmorb
-    // fgets returns NULL if it fails, otherwise the same (char*) input address
-    readStringOut=fgets(readStringIn,18,chemicalFile);
-    readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+    // getStringInMappedFile returns NULL if it fails, otherwise readStringIn
+    readStringOut=getStringInMappedFile(readStringIn,18,&chemicalFile);
+    readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the number of molecular orbitals.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -250,7 +248,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
         fprintf(stderr,"MolecularOrbitals Nmorb instead of %s ",readStringIn);
         fprintf(stderr,"%d (positive value).\n",readIntegerIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
     pChemicalSystem->nmorb=readIntegerIn;
@@ -265,20 +263,21 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: could not ");
         fprintf(stderr,"allocate memory for the (MolecularOrbital*) ");
         fprintf(stderr,"pChemicalSystem->pmorb variable.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     // Read number of primitives and store it in pChemicalSystem->ngauss
-    readStringOut=fgets(readStringIn,11,chemicalFile);
-    readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,11,&chemicalFile);
+    readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the number of primitives.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -287,7 +286,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
         fprintf(stderr,"Primitives Ngauss instead of %s ",readStringIn);
         fprintf(stderr,"%d (positive value).\n",readIntegerIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
     pChemicalSystem->ngauss=readIntegerIn;
@@ -316,21 +315,22 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
             PRINT_ERROR("In readChemFileandAllocateChemicalSystem: could not ");
             fprintf(stderr,"allocate memory for %d primitives ",readIntegerIn);
             fprintf(stderr,"in the %d-th MolecularOrbital structure.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
     }
 
     // Read the number of nuclei and store it in pChemicalSystem->nnucl
-    readStringOut=fgets(readStringIn,7,chemicalFile);
-    readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,7,&chemicalFile);
+    readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the number of nuclei.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -339,7 +339,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
         fprintf(stderr,"Nuclei Nnucl instead of %s ",readStringIn);
         fprintf(stderr,"%d (positive value).\n",readIntegerIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
     pChemicalSystem->nnucl=readIntegerIn;
@@ -352,7 +352,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: could not ");
         fprintf(stderr,"allocate memory for the (Nucleus*) ");
         fprintf(stderr,"pChemicalSystem->pnucl variable.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -361,13 +361,13 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
     for (i=0; i<iMax; i++)
     {
         j=0;
-        j+=fscanf(chemicalFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&chemicalFile,&readDouble);
         pChemicalSystem->pnucl[i].x=readDouble;
 
-        j+=fscanf(chemicalFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&chemicalFile,&readDouble);
         pChemicalSystem->pnucl[i].y=readDouble;
 
-        j+=fscanf(chemicalFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&chemicalFile,&readDouble);
         pChemicalSystem->pnucl[i].z=readDouble;
 
         if (j!=3)
@@ -376,18 +376,19 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"not able to properly save the three-coordinate ");
             fprintf(stderr,"positions of the %d-th Nucleus (only %d ",i+1,j);
             fprintf(stderr,"values properly saved instead of three).\n");
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
-        readIntegerOut=fscanf(chemicalFile,"%d ",&readIntegerIn);
+        readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"(=%d) return of the fscanf ",readIntegerOut);
+            fprintf(stderr,"(=%d) return of the ",readIntegerOut);
+            fprintf(stderr,"scan*InMappedFile ");
             fprintf(stderr,"function while attempting to read the charge of ");
             fprintf(stderr,"the %d-th Nucleus structure.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -397,21 +398,22 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"charge (=%d) of the %d-th ",readIntegerIn,i+1);
             fprintf(stderr,"Nucleus must be a positive integer that is not ");
             fprintf(stderr,"(strictly) greater than one hundred.\n");
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
         pChemicalSystem->pnucl[i].charge=readIntegerIn;
     }
 
     // Read the line containing the keywords Coefficient Exponent Center Type
-    readStringOut=fgets(readStringIn,33,chemicalFile);
+    readStringOut=getStringInMappedFile(readStringIn,33,&chemicalFile);
     if (readStringOut==NULL)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"%p of the fgets function ",(void*)readStringOut);
+        fprintf(stderr,"%p of the getStringInMappedFile ",(void*)readStringOut);
+        fprintf(stderr,"function ");
         fprintf(stderr,"while attempting to read the keywords Coefficient, ");
         fprintf(stderr,"Exponent, Center, and Type.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -420,37 +422,39 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
         fprintf(stderr,"'Coefficient Exponent Center Type' instead of ");
         fprintf(stderr,"'%s' at this line.\n",readStringIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     // For each MocularOrbital, read and save successively the spin followed
     // by the enumeration of the gaussian coefficients, exponents, center
     // references, and associated types
-    readIntegerOut=fscanf(chemicalFile," ");
+    readIntegerOut=skipSpacesInMappedFile(&chemicalFile);
     if (readIntegerOut)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"(=%d) of the fscanf function ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
+        fprintf(stderr,"function ");
         fprintf(stderr,"(EOF=%d) while attempting to read the ",EOF);
         fprintf(stderr,"white space characters (in case there was some) ");
         fprintf(stderr,"after the keywords %s.\n",readStringIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     iMax=pChemicalSystem->nmorb;
     for (i=0; i<iMax; i++)
     {
-        readIntegerOut=fscanf(chemicalFile,"%d ",&readIntegerIn);
+        readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"(=%d) return of the fscanf ",readIntegerOut);
+            fprintf(stderr,"(=%d) return of the ",readIntegerOut);
+            fprintf(stderr,"scan*InMappedFile ");
             fprintf(stderr,"function while attempting to read the ");
             fprintf(stderr,"description of the %d-th MolecularOrbital ",i+1);
             fprintf(stderr,"structure.\n");
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -459,21 +463,23 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
             PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
             fprintf(stderr,"to read the %d-th MolecularOrbital structure ",i+1);
             fprintf(stderr,"instead of the %d-th one.\n",readIntegerIn);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
         // Read and check the spin of the (i+1)-th MolecularOrbital structure
-        readStringOut=fgets(readStringIn,5,chemicalFile);
-        readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+        readStringOut=getStringInMappedFile(readStringIn,5,&chemicalFile);
+        readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the fgets %p or ",(void*)readStringOut);
-            fprintf(stderr,"fscanf (=%d) function while ",readIntegerOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or ",(void*)readStringOut);
+            fprintf(stderr,"scan*InMappedFile ");
+            fprintf(stderr,"(=%d) function while ",readIntegerOut);
             fprintf(stderr,"attempting to read the spin of the %d-th ",i+1);
             fprintf(stderr,"MolecularOrbital structure.\n");
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -482,7 +488,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
             PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
             fprintf(stderr,"Spin (+/-)1 instead of %s ",readStringIn);
             fprintf(stderr,"%d (unitary value).\n",readIntegerIn);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
         pChemicalSystem->pmorb[i].spin=readIntegerIn;
@@ -493,29 +499,31 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         for (j=0; j<jMax; j++)
         {
             // Read coefficient
-            readIntegerOut=fscanf(chemicalFile,"%lf ",&readDouble);
+            readIntegerOut=scanDoubleInMappedFile(&chemicalFile,&readDouble);
             if (readIntegerOut!=1)
             {
                 PRINT_ERROR("In readChemFileandAllocateChemicalSystem: ");
                 fprintf(stderr,"wrong return (=%d) of the ",readIntegerOut);
-                fprintf(stderr,"fscanf function while attempting to read the ");
+                fprintf(stderr,"scan*InMappedFile function while attempting ");
+                fprintf(stderr,"to read the ");
                 fprintf(stderr,"%d-th coefficient of the %d-th ",j+1,i+1);
                 fprintf(stderr,"MolecularOrbital structure.\n");
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
             pMolecularOrbital->coeff[j]=readDouble;
 
             // Read and check exponent
-            readIntegerOut=fscanf(chemicalFile,"%lf ",&readDouble);
+            readIntegerOut=scanDoubleInMappedFile(&chemicalFile,&readDouble);
             if (readIntegerOut!=1)
             {
                 PRINT_ERROR("In readChemFileandAllocateChemicalSystem: ");
                 fprintf(stderr,"wrong return (=%d) of the ",readIntegerOut);
-                fprintf(stderr,"fscanf function while attempting to read the ");
+                fprintf(stderr,"scan*InMappedFile function while attempting ");
+                fprintf(stderr,"to read the ");
                 fprintf(stderr,"%d-th Gaussian exponent of the %d-th ",j+1,i+1);
                 fprintf(stderr,"MolecularOrbital structure.\n");
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
 
@@ -526,21 +534,23 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
                 fprintf(stderr,"MolecularOrbital structure should be a ");
                 fprintf(stderr,"positive double value (instead of ");
                 fprintf(stderr,"%lf).\n",readDouble);
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
             pMolecularOrbital->exp[j]=readDouble;
 
             // Read and check center assignments
-            readIntegerOut=fscanf(chemicalFile,"%d ",&readIntegerIn);
+            readIntegerOut=scanIntegerInMappedFile(&chemicalFile,
+                                                                &readIntegerIn);
             if (readIntegerOut!=1)
             {
                 PRINT_ERROR("In readChemFileandAllocateChemicalSystem: ");
                 fprintf(stderr,"wrong return (=%d) of the ",readIntegerOut);
-                fprintf(stderr,"fscanf function while attempting to read the ");
+                fprintf(stderr,"scan*InMappedFile function while attempting ");
+                fprintf(stderr,"to read the ");
                 fprintf(stderr,"%d-th center assignment of the %d-th ",j+1,i+1);
                 fprintf(stderr,"MolecularOrbital structure.\n");
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
 
@@ -552,21 +562,23 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
                 fprintf(stderr,"positive integer less than the total number ");
                 fprintf(stderr,"of nuclei %d ",pChemicalSystem->nnucl);
                 fprintf(stderr,"(instead of %d).\n",readIntegerIn);
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
             pMolecularOrbital->nucl[j]=readIntegerIn;
 
             // Read and check type assignments
-            readIntegerOut=fscanf(chemicalFile,"%d ",&readIntegerIn);
+            readIntegerOut=scanIntegerInMappedFile(&chemicalFile,
+                                                                &readIntegerIn);
             if (readIntegerOut!=1)
             {
                 PRINT_ERROR("In readChemFileandAllocateChemicalSystem: ");
                 fprintf(stderr,"wrong return (=%d) of the ",readIntegerOut);
-                fprintf(stderr,"fscanf function while attempting to read the ");
+                fprintf(stderr,"scan*InMappedFile function while attempting ");
+                fprintf(stderr,"to read the ");
                 fprintf(stderr,"%d-th type assignment of the %d-th ",j+1,i+1);
                 fprintf(stderr,"MolecularOrbital structure.\n");
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
 
@@ -577,7 +589,7 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
                 fprintf(stderr,"MolecularOrbital structure should be a ");
                 fprintf(stderr,"positive integer less than 20 (instead of ");
                 fprintf(stderr,"%d).\n",readIntegerIn);
-                closeTheFile(&chemicalFile);
+                closeMappedFile(&chemicalFile);
                 return 0;
             }
             pMolecularOrbital->type[j]=readIntegerIn;
@@ -586,13 +598,14 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
 
     // Check that the "End" keyword is ending the file (everything after that
     // is considered as a comment)
-    readStringOut=fgets(readStringIn,4,chemicalFile);
+    readStringOut=getStringInMappedFile(readStringIn,4,&chemicalFile);
     if (readStringOut==NULL)
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"%p of the fgets function ",(void*)readStringOut);
+        fprintf(stderr,"%p of the getStringInMappedFile ",(void*)readStringOut);
+        fprintf(stderr,"function ");
         fprintf(stderr,"while attempting to read the End keyword.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -601,21 +614,19 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: expecting ");
         fprintf(stderr,"the 'End' keyword instead of '%s' at ",readStringIn);
         fprintf(stderr,"this line.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
-    // Closing the *.chem file: fclose function returns zero if the input FILE*
-    // variable is successfully closed, otherwise EOF (end-of-file) is returned
-    if (fclose(chemicalFile))
+    // Closing the *.chem file: closeMappedFile returns zero if the memory is
+    // successfully unmapped, otherwise EOF (end-of-file) is returned
+    if (closeMappedFile(&chemicalFile))
     {
         PRINT_ERROR("In readChemFileandAllocateChemicalSystem: the ");
         fprintf(stderr,"%s file has not been closed properly.\n",fileLocation);
-        chemicalFile=NULL;
         return 0;
     }
     fprintf(stdout,"Closing file.\n");
-    chemicalFile=NULL;
 
     // Check if the loaded chemical data are restricted Hartree-Fock ones or not
     returnValue=1;
@@ -685,101 +696,6 @@ int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
     return returnValue;
 }
 
-/* ************************************************************************** */
-// The function readAndConvertWfnFile reads a *.temp file (which is intended
-// to be the copy of a *.wfn file) at fileLocation (such a file must have been
-// previously created), except the first line, and converts all charToRemove
-// encountered into charToPutInstead. It has a char* variable (fileLocation)
-// and two char variables (charToRemove, charToPutInstead) as input arguments
-// and it returns zero if an error occurred, otherwise one in case of success
-/* ************************************************************************** */
-int readAndConvertWfnFile(char* fileLocation, char charToRemove,
-                                          char charToPutInstead, int nameLength)
-{
-    int readChar=0;
-    FILE *wfnFile=NULL;
-
-    // Check if the file have been previously created
-    if (initialFileExists(fileLocation,nameLength)!=1)
-    {
-        PRINT_ERROR("In readAndConvertWfnFile: initialFileExists function ");
-        fprintf(stderr,"did not return one, which was the expected value ");
-        fprintf(stderr,"here, after having checked that the (char*) ");
-        fprintf(stderr,"fileLocation variable is not storing the name of an ");
-        fprintf(stderr,"existing and valid wfn-format file.\n");
-        return 0;
-    }
-
-    // Check if the file is well opened (file must have been previously created)
-    // fopen returns a FILE pointer on success, otherwise NULL is returned
-    fprintf(stdout,"Opening %s file. ",fileLocation);
-    wfnFile=fopen(fileLocation,"r+");
-    if (wfnFile==NULL)
-    {
-        PRINT_ERROR("In readAndConvertWfnFile: could not open and write into ");
-        fprintf(stderr,"the %s file.\n",fileLocation);
-        return 0;
-    }
-    fprintf(stdout,"Converting data (any '%c' ",charToRemove);
-    fprintf(stdout,"into '%c'). ",charToPutInstead);
-
-    // Skip the first line: fgetc function returns the character read as an
-    // unsigned char cast to an int or EOF on the end of file or error (because
-    // EOF can't be stored as a char)
-    do {
-        readChar=fgetc(wfnFile);
-    } while (readChar!='\n' && readChar!=EOF);
-    if (readChar==EOF)
-    {
-        PRINT_ERROR("In readAndConvertWfnFile: problem encountered with the ");
-        fprintf(stderr,"fgetc function or end-of-file reached without any ");
-        fprintf(stderr,"data written in the %s file.\n",fileLocation);
-        closeTheFile(&wfnFile);
-        return 0;
-    }
-
-    // Remark: the 'D' symbol now only appears in *.wfn at fileLocation either
-    // for scientific notation (Fortran 1.0D+01) or for the END DATA keyword so
-    // it can now be easily converted into the C syntax (1.0e+01)
-    do {
-        readChar=fgetc(wfnFile);
-        if (readChar==(int)charToRemove)
-        {
-            // fseek returns zero on success, otherwise a non-zero value
-            if (fseek(wfnFile,-1,SEEK_CUR))
-            {
-                PRINT_ERROR("In readAndConvertWfnFile: wrong return of the ");
-                fprintf(stderr,"fseek function in the %s file.\n",fileLocation);
-                closeTheFile(&wfnFile);
-                return 0;
-            }
-
-            // fputc returns the same character on success, otherwise EOF value
-            if (fputc(charToPutInstead,wfnFile)==EOF)
-            {
-                PRINT_ERROR("In readAndConvertWfnFile: wrong return of the ");
-                fprintf(stderr,"fputc function in the %s file.\n",fileLocation);
-                closeTheFile(&wfnFile);
-                return 0;
-            }
-        }
-    } while (readChar!=EOF);
-
-    // Testing if the file is well closed: close returns zero if the input
-    // FILE* variable is successfully closed, otherwise EOF is returned
-    if (fclose(wfnFile))
-    {
-        PRINT_ERROR("In readAndConvertWfnFile: we were not able to close the ");
-        fprintf(stderr,"%s file properly.\n",fileLocation);
-        wfnFile=NULL;
-        return 0;
-    }
-    wfnFile=NULL;
-    fprintf(stdout,"Closing file.");
-
-    return 1;
-}
-
 /* ************************************************************************** */
 // The function readWfnFileAndAllocateChemicalSystem reads the file at
 // fileLocation (file must exist with length (strictly) lower than nameLength),
@@ -799,7 +715,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     int returnValue=0, deltaSpin=0;
     double readDouble=0.;
     MolecularOrbital *pMolecularOrbital=NULL, *pMolecularOrbitalI=NULL;
-    FILE *wfnFile=NULL;
+    MappedFile wfnFile={NULL,0,0};
 
     // Check if the input pChemicalSystem variable is pointing to NULL
     if (pChemicalSystem==NULL)
@@ -831,34 +747,33 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         return 0;
     }
 
-    // Check that its size can at least contain the *.chem or *.wfn extension
+    // Check that its size can at least contain the *.wfn extension
     // strlen returns the length of the string, but not including the char '\0'
     length=strlen(fileLocation);
-    if (length<6)
+    if (length<5)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: the input ");
         fprintf(stderr,"fileLocation variable (=%s) should have ",fileLocation);
-        fprintf(stderr,"a length that at least equals six in order to end ");
-        fprintf(stderr,"with something more than the '.temp' extension.\n");
+        fprintf(stderr,"a length that at least equals five in order to end ");
+        fprintf(stderr,"with something more than the '.wfn' extension.\n");
         return 0;
     }
 
-    // Check that fileLocation ends with the '.temp' extension
-    if (fileLocation[length-5]!='.' || fileLocation[length-4]!='t' ||
-                   fileLocation[length-3]!='e' || fileLocation[length-2]!='m' ||
-                      fileLocation[length-1]!='p' || fileLocation[length]!='\0')
+    // Check that fileLocation ends with the '.wfn' extension
+    if (fileLocation[length-4]!='.' || fileLocation[length-3]!='w' ||
+                   fileLocation[length-2]!='f' || fileLocation[length-1]!='n' ||
+                                                     fileLocation[length]!='\0')
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: the input ");
         fprintf(stderr,"fileLocation variable (=%s) does not ",fileLocation);
-        fprintf(stderr,"end with the '.temp' extension.\n");
+        fprintf(stderr,"end with the '.wfn' extension.\n");
         return 0;
     }
 
-    // Check if the *.temp file is well opened: fopen function returns a FILE
-    // pointer on success, otherwise NULL is returned
+    // Map the content of the *.wfn file into memory: openMappedFile returns
+    // one on success, otherwise zero is returned
     fprintf(stdout,"\nOpening %s file. ",fileLocation);
-    wfnFile=fopen(fileLocation,"r");
-    if (wfnFile==NULL)
+    if (!openMappedFile(fileLocation,nameLength,&wfnFile))
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: could not ");
         fprintf(stderr,"read the content of %s file.\n",fileLocation);
@@ -866,32 +781,32 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     }
     fprintf(stdout,"Reading and saving chemical data. ");
 
-    // Skip the first line of the (copy *.temp of the) *.wfn file: fgetc returns
-    // the character read as an unsigned char cast to an int or EOF on the end
-    // of file or error (because EOF can't be stored as a char)
+    // Skip the first line of the *.wfn file: getCharInMappedFile returns the
+    // character read as an unsigned char cast to an int or EOF on the end of
+    // file (because EOF can't be stored as a char)
     do {
-        readChar=fgetc(wfnFile);
+        readChar=getCharInMappedFile(&wfnFile);
     } while (readChar!='\n' && readChar!=EOF);
     if (readChar==EOF)
     {
         PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: problem ");
-        fprintf(stderr,"encountered with the (standard) fgetc c-function or ");
+        fprintf(stderr,"encountered with the getCharInMappedFile function or ");
         fprintf(stderr,"end-of-file reached without any data read in ");
         fprintf(stderr,"%s file.\n",fileLocation);
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
     // Read the expected word GAUSSIAN in the second line
-    // fgets returns NULL if it fails, otherwise the same (char*) input address
-    readStringOut=fgets(readStringIn,9,wfnFile);
+    // getStringInMappedFile returns NULL if it fails, otherwise readStringIn
+    readStringOut=getStringInMappedFile(readStringIn,9,&wfnFile);
     if (readStringOut==NULL)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"%p of the (standard) fgets ",(void*)readStringOut);
+        fprintf(stderr,"%p of the getStringInMappedFile ",(void*)readStringOut);
         fprintf(stderr,"c-function while attempting to read the GAUSSIAN ");
         fprintf(stderr,"keyword.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
@@ -901,29 +816,27 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: expecting ");
         fprintf(stderr,"the keyword GAUSSIAN instead of %s.\n",readStringIn);
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
     // Read number of molecular orbitals and store it in pChemicalSystem->nmorb
-    // fscanf function returns the number of input items successfully matched
-    // and assigned, which can be fewer than provided for. Important remark:
-    // white space characters, such as blanks and newline characters, causes
-    // fscanf (scanf and sscanf) to read, but not to store, all consecutive
-    // white space characters in the input up to the next character that is not
-    // white space. One white space character in format-string matches any
-    // combination of white space characters in the input
-    readIntegerOut=fscanf(wfnFile," %d ",&readIntegerIn);
-    readStringOut=fgets(readStringIn,13,wfnFile);
+    // The scan*InMappedFile functions return one if an item has been read and
+    // assigned, zero otherwise (EOF at the end of the file). As the fscanf
+    // c-function with a white space in the format-string, they skip (without
+    // storing them) all the consecutive white space characters of the input
+    readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,13,&wfnFile);
 
     if (readIntegerOut!=1 || readStringOut==NULL)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the (standard) fscanf (=%d) or ",readIntegerOut);
-        fprintf(stderr,"fgets %p c-function while ",(void*)readStringOut);
+        fprintf(stderr,"of the scan*InMappedFile (=%d) or ",readIntegerOut);
+        fprintf(stderr,"getStringInMappedFile ");
+        fprintf(stderr,"%p function while ",(void*)readStringOut);
         fprintf(stderr,"attempting to read the number of molecular ");
         fprintf(stderr,"orbitals.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
@@ -932,7 +845,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: expecting ");
         fprintf(stderr,"Nmorb MOL ORBITALS instead of %d ",readIntegerIn);
         fprintf(stderr,"%s (positive value).\n",readStringIn);
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
     pChemicalSystem->nmorb=readIntegerIn;
@@ -947,21 +860,22 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: could not ");
         fprintf(stderr,"allocate memory for the (MolecularOrbital*) ");
         fprintf(stderr,"pChemicalSystem->pmorb variable.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
     // Read the number of primitives and store it in pChemicalSystem->ngauss
-    readIntegerOut=fscanf(wfnFile," %d ",&readIntegerIn);
-    readStringOut=fgets(readStringIn,11,wfnFile);
+    readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,11,&wfnFile);
 
     if (readIntegerOut!=1 || readStringOut==NULL)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the (standard) fscanf (=%d) or ",readIntegerOut);
-        fprintf(stderr,"fgets %p c-function while ",(void*)readStringOut);
+        fprintf(stderr,"of the scan*InMappedFile (=%d) or ",readIntegerOut);
+        fprintf(stderr,"getStringInMappedFile ");
+        fprintf(stderr,"%p function while ",(void*)readStringOut);
         fprintf(stderr,"attempting to read the number of primitives.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
@@ -970,7 +884,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: expecting ");
         fprintf(stderr,"Ngauss PRIMITIVES instead of %d ",readIntegerIn);
         fprintf(stderr,"%s (positive value).\n",readStringIn);
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
     pChemicalSystem->ngauss=readIntegerIn;
@@ -999,22 +913,23 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: could not ");
             fprintf(stderr,"allocate memory for %d primitives ",readIntegerIn);
             fprintf(stderr,"in the %d-th MolecularOrbital structure.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
     }
 
     // Read the number of nuclei and store it in pChemicalSystem->nnucl
-    readIntegerOut=fscanf(wfnFile," %d ",&readIntegerIn);
-    readStringOut=fgets(readStringIn,7,wfnFile);
+    readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,7,&wfnFile);
 
     if (readIntegerOut!=1 || readStringOut==NULL)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the (standard) fscanf (=%d) or ",readIntegerOut);
-        fprintf(stderr,"fgets %p c-function while ",(void*)readStringOut);
+        fprintf(stderr,"of the scan*InMappedFile (=%d) or ",readIntegerOut);
+        fprintf(stderr,"getStringInMappedFile ");
+        fprintf(stderr,"%p function while ",(void*)readStringOut);
         fprintf(stderr,"attempting to read the number of nuclei.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
@@ -1023,7 +938,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: expecting ");
         fprintf(stderr,"Nnucl NUCLEI instead of %d ",readIntegerIn);
         fprintf(stderr,"%s (positive value).\n",readStringIn);
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
     pChemicalSystem->nnucl=readIntegerIn;
@@ -1036,20 +951,21 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: could not ");
         fprintf(stderr,"allocate memory for the (Nucleus*) ");
         fprintf(stderr,"pChemicalSystem->pnucl variable.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
     // Saving the Nucleus data in pMesh->pnucl and check if it worked
-    readIntegerOut=fscanf(wfnFile," ");
+    readIntegerOut=skipSpacesInMappedFile(&wfnFile);
     if (readIntegerOut)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"(=%d) of the fscanf function ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
+        fprintf(stderr,"function ");
         fprintf(stderr,"(EOF=%d) while attempting to read the ",EOF);
         fprintf(stderr,"white space characters (in case there was some) ");
         fprintf(stderr,"after the number of nuclei (=%d).\n",readIntegerIn);
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
@@ -1057,17 +973,21 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     for (i=0; i<iMax; i++)
     {
         // Read the name of the molecule and check its number
-        readStringOut=fgets(readStringIn,3,wfnFile);
-        readIntegerOut=fscanf(wfnFile," %d (",&readIntegerIn);
+        readStringOut=getStringInMappedFile(readStringIn,3,&wfnFile);
+        readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
+        if (readIntegerOut==1)
+        {
+            readIntegerOut=scanCharacterInMappedFile(&wfnFile,'(');
+        }
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the symbol of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1077,23 +997,28 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"%s %d instead of ",readStringIn,i+1);
             fprintf(stderr,"%s %d while scanning ",readStringIn,readIntegerIn);
             fprintf(stderr,"the %d-th Nucleus.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
         // Read the centre reference and store its number in readIntegerIn
-        readStringOut=fgets(readStringIn,7,wfnFile);
-        readIntegerOut=fscanf(wfnFile," %d) ",&readIntegerIn);
+        readStringOut=getStringInMappedFile(readStringIn,7,&wfnFile);
+        readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
+        if (readIntegerOut==1)
+        {
+            readIntegerOut=scanCharacterInMappedFile(&wfnFile,')');
+            skipSpacesInMappedFile(&wfnFile);
+        }
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the center reference of the ");
             fprintf(stderr,"%d-th Nucleus.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1106,7 +1031,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"strictly less than %d), while scanning the ",iMax);
             fprintf(stderr,"number of the center related to the ");
             fprintf(stderr,"%d-th Nucleus.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1120,13 +1045,13 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         }
 
         j=0;
-        j+=fscanf(wfnFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&wfnFile,&readDouble);
         pChemicalSystem->pnucl[readIntegerIn-1].x=readDouble;
 
-        j+=fscanf(wfnFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&wfnFile,&readDouble);
         pChemicalSystem->pnucl[readIntegerIn-1].y=readDouble;
 
-        j+=fscanf(wfnFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&wfnFile,&readDouble);
         pChemicalSystem->pnucl[readIntegerIn-1].z=readDouble;
 
         if (j!=3)
@@ -1135,23 +1060,27 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"not able to properly save the three-coordinate ");
             fprintf(stderr,"positions of the %d-th Nucleus ",readIntegerIn);
             fprintf(stderr,"(only %d values properly saved instead of 3).\n",j);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
         // Read the charge number of the current nucleus
-        readStringOut=fgets(readStringIn,7,wfnFile);
-        readIntegerOut=fscanf(wfnFile," = %lf ",&readDouble);
+        readStringOut=getStringInMappedFile(readStringIn,7,&wfnFile);
+        readIntegerOut=scanCharacterInMappedFile(&wfnFile,'=');
+        if (readIntegerOut==1)
+        {
+            readIntegerOut=scanDoubleInMappedFile(&wfnFile,&readDouble);
+        }
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the charge number associated with the ");
             fprintf(stderr,"%d-th Nucleus.\n",readIntegerIn);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1162,7 +1091,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"the %d-th Nucleus must be a ",readIntegerIn);
             fprintf(stderr,"positive value that is not (strictly) greater ");
             fprintf(stderr,"one hundred and should represent an integer.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         pChemicalSystem->pnucl[readIntegerIn-1].charge=(int)readDouble;
@@ -1175,27 +1104,28 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     jMax=pChemicalSystem->ngauss;
     for (j=0; j<jMax; j++)
     {
-        readChar=fgetc(wfnFile);
+        readChar=getCharInMappedFile(&wfnFile);
         if (readChar==EOF)
         {
             PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: problem ");
-            fprintf(stderr,"encountered with the (standard) fgetc c-function ");
+            fprintf(stderr,"encountered with the getCharInMappedFile ");
+            fprintf(stderr,"function ");
             fprintf(stderr,"or end-of-file reached without all the data ");
             fprintf(stderr,"saved for the %d-th Centre Assignment.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         else if (readChar=='C')
         {
-            readStringOut=fgets(readStringIn,18,wfnFile);
+            readStringOut=getStringInMappedFile(readStringIn,18,&wfnFile);
             if (readStringOut==NULL)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fgets ");
+                fprintf(stderr,"return of the getStringInMappedFile ");
                 fprintf(stderr,"%p c-function while ",(void*)readStringOut);
                 fprintf(stderr,"attempting to read the %d-th Center ",j+1);
                 fprintf(stderr,"Assignment.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
             if (strcmp(readStringIn,"ENTRE ASSIGNMENTS"))
@@ -1204,45 +1134,47 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
                 fprintf(stderr,"expecting CENTRE ASSIGNMENTS instead of ");
                 fprintf(stderr,"C%s while reading the %d-th ",readStringIn,j+1);
                 fprintf(stderr,"one.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
 
-            readIntegerOut=fscanf(wfnFile," ");
+            readIntegerOut=skipSpacesInMappedFile(&wfnFile);
             if (readIntegerOut)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return (=%d) of the fscanf ",readIntegerOut);
+                fprintf(stderr,"return ");
+                fprintf(stderr,"(=%d) of the ",readIntegerOut);
+                fprintf(stderr,"scan*InMappedFile ");
                 fprintf(stderr,"function (EOF=%d) while attempting to ",EOF);
                 fprintf(stderr,"read the white space characters (in case ");
                 fprintf(stderr,"there was some) after the %d-th keyword ",j+1);
                 fprintf(stderr,"C%s.\n",readStringIn);
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
         }
         else
         {
-            // fseek returns zero on success, otherwise a non-zero value
-            if (fseek(wfnFile,-1,SEEK_CUR))
+            // ungetCharInMappedFile returns zero on success, otherwise -1
+            if (ungetCharInMappedFile(&wfnFile))
             {
                 PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fseek c-function ");
+                fprintf(stderr,"return of the ungetCharInMappedFile function ");
                 fprintf(stderr,"while reading the %d-th Centre ",j+1);
                 fprintf(stderr,"Assignment.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
         }
 
-        readIntegerOut=fscanf(wfnFile,"%d ",&readIntegerIn);
+        readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fscanf ");
+            fprintf(stderr,"return of the scan*InMappedFile ");
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the %d-th Center Assignment.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1253,7 +1185,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"greater than the total number of nuclei %d ",iMax);
             fprintf(stderr,"instead of %d while reading the ",readIntegerIn);
             fprintf(stderr,"%d-th Centre Assignment.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         pMolecularOrbital->nucl[j]=readIntegerIn;
@@ -1278,27 +1210,28 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     jMax=pChemicalSystem->ngauss;
     for (j=0; j<jMax; j++)
     {
-        readChar=fgetc(wfnFile);
+        readChar=getCharInMappedFile(&wfnFile);
         if (readChar==EOF)
         {
             PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: problem ");
-            fprintf(stderr,"encountered with the (standard) fgetc c-function ");
+            fprintf(stderr,"encountered with the getCharInMappedFile ");
+            fprintf(stderr,"function ");
             fprintf(stderr,"or end-of-file reached without all the data ");
             fprintf(stderr,"saved for the %d-th Type Assignment.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         else if (readChar=='T')
         {
-            readStringOut=fgets(readStringIn,16,wfnFile);
+            readStringOut=getStringInMappedFile(readStringIn,16,&wfnFile);
             if (readStringOut==NULL)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fgets ");
+                fprintf(stderr,"return of the getStringInMappedFile ");
                 fprintf(stderr,"%p c-function while ",(void*)readStringOut);
                 fprintf(stderr,"attempting to read the %d-th Type ",j+1);
                 fprintf(stderr,"Assignment.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
             if (strcmp(readStringIn,"YPE ASSIGNMENTS"))
@@ -1307,45 +1240,47 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
                 fprintf(stderr,"expecting TYPE ASSIGNMENTS instead of ");
                 fprintf(stderr,"T%s while reading the %d-th ",readStringIn,j+1);
                 fprintf(stderr,"one.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
 
-            readIntegerOut=fscanf(wfnFile," ");
+            readIntegerOut=skipSpacesInMappedFile(&wfnFile);
             if (readIntegerOut)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return (=%d) of the fscanf ",readIntegerOut);
+                fprintf(stderr,"return ");
+                fprintf(stderr,"(=%d) of the ",readIntegerOut);
+                fprintf(stderr,"scan*InMappedFile ");
                 fprintf(stderr,"function (EOF=%d) while attempting to ",EOF);
                 fprintf(stderr,"read the white space characters (in case ");
                 fprintf(stderr,"there was some) after the %d-th keyword ",j+1);
                 fprintf(stderr,"T%s.\n",readStringIn);
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
         }
         else
         {
-            // fseek returns zero on success, otherwise a non-zero value
-            if (fseek(wfnFile,-1,SEEK_CUR))
+            // ungetCharInMappedFile returns zero on success, otherwise -1
+            if (ungetCharInMappedFile(&wfnFile))
             {
                 PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fseek c-function ");
+                fprintf(stderr,"return of the ungetCharInMappedFile function ");
                 fprintf(stderr,"while reading the %d-th Type ",j+1);
                 fprintf(stderr,"Assignment.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
         }
 
-        readIntegerOut=fscanf(wfnFile,"%d ",&readIntegerIn);
+        readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fscanf ");
+            fprintf(stderr,"return of the scan*InMappedFile ");
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the %d-th Type Assignment.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1355,7 +1290,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"a positive integer that is not (strictly) ");
             fprintf(stderr,"greater than twenty instead of %d ",readIntegerIn);
             fprintf(stderr,"while reading the %d-th Centre Assignment.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         pMolecularOrbital->type[j]=readIntegerIn;
@@ -1380,27 +1315,28 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     jMax=pChemicalSystem->ngauss;
     for (j=0; j<jMax; j++)
     {
-        readChar=fgetc(wfnFile);
+        readChar=getCharInMappedFile(&wfnFile);
         if (readChar==EOF)
         {
             PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: problem ");
-            fprintf(stderr,"encountered with the (standard) fgetc c-function ");
+            fprintf(stderr,"encountered with the getCharInMappedFile ");
+            fprintf(stderr,"function ");
             fprintf(stderr,"or end-of-file reached without all the data ");
             fprintf(stderr,"saved for the %d-th Gaussian Exponent.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         else if (readChar=='E')
         {
-            readStringOut=fgets(readStringIn,9,wfnFile);
+            readStringOut=getStringInMappedFile(readStringIn,9,&wfnFile);
             if (readStringOut==NULL)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fgets ");
+                fprintf(stderr,"return of the getStringInMappedFile ");
                 fprintf(stderr,"%p c-function while ",(void*)readStringOut);
                 fprintf(stderr,"attempting to read the %d-th Gaussian",j+1);
                 fprintf(stderr,"Exponent.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
             if (strcmp(readStringIn,"XPONENTS"))
@@ -1409,45 +1345,47 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
                 fprintf(stderr,"expecting EXPONENTS instead of ");
                 fprintf(stderr,"E%s while reading the %d-th ",readStringIn,j+1);
                 fprintf(stderr,"Gaussian one.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
 
-            readIntegerOut=fscanf(wfnFile," ");
+            readIntegerOut=skipSpacesInMappedFile(&wfnFile);
             if (readIntegerOut)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return (=%d) of the fscanf ",readIntegerOut);
+                fprintf(stderr,"return ");
+                fprintf(stderr,"(=%d) of the ",readIntegerOut);
+                fprintf(stderr,"scan*InMappedFile ");
                 fprintf(stderr,"function (EOF=%d) while attempting to ",EOF);
                 fprintf(stderr,"read the white space characters (in case ");
                 fprintf(stderr,"there was some) after the %d-th keyword ",j+1);
                 fprintf(stderr,"E%s.\n",readStringIn);
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
         }
         else
         {
-            // fseek returns zero on success, otherwise a non-zero value
-            if (fseek(wfnFile,-1,SEEK_CUR))
+            // ungetCharInMappedFile returns zero on success, otherwise -1
+            if (ungetCharInMappedFile(&wfnFile))
             {
                 PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fseek c-function ");
+                fprintf(stderr,"return of the ungetCharInMappedFile function ");
                 fprintf(stderr,"while reading the %d-th Gaussian ",j+1);
                 fprintf(stderr,"Exponent.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
         }
 
-        readIntegerOut=fscanf(wfnFile,"%lf ",&readDouble);
+        readIntegerOut=scanDoubleInMappedFile(&wfnFile,&readDouble);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fscanf ");
+            fprintf(stderr,"return of the scan*InMappedFile ");
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the %d-th Gaussian Exponent.\n",j+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1457,7 +1395,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"a positive (double) value instead of ");
             fprintf(stderr,"%lf while reading the %d-th ",readDouble,j+1);
             fprintf(stderr,"Gaussian exponent.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
         pMolecularOrbital->exp[j]=readDouble;
@@ -1484,18 +1422,18 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
     for (i=0; i<iMax; i++)
     {
         // Read the first line associated with the i-th orbital
-        readStringOut=fgets(readStringIn,3,wfnFile);
-        readIntegerOut=fscanf(wfnFile," %d ",&readIntegerIn);
+        readStringOut=getStringInMappedFile(readStringIn,3,&wfnFile);
+        readIntegerOut=scanIntegerInMappedFile(&wfnFile,&readIntegerIn);
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the primitive coefficients associated ");
             fprintf(stderr,"with the %d-th MolecularOrbital structure.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1506,7 +1444,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"one, while attempting to read the primitive ");
             fprintf(stderr,"coefficients of the %d-th MolecularOrbital ",i+1);
             fprintf(stderr,"structure.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1525,22 +1463,22 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"while attempting to read the primitive ");
             fprintf(stderr,"coefficients of the %d-th MolecularOrbital ",i+1);
             fprintf(stderr,"structure.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
-        readStringOut=fgets(readStringIn,3,wfnFile);
-        readIntegerOut=fscanf(wfnFile," %lf ",&readDouble);
+        readStringOut=getStringInMappedFile(readStringIn,3,&wfnFile);
+        readIntegerOut=scanDoubleInMappedFile(&wfnFile,&readDouble);
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the primitive coefficients associated ");
             fprintf(stderr,"with the %d-th MolecularOrbital structure.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1551,22 +1489,26 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"while attempting to read the primitive ");
             fprintf(stderr,"coefficients of the %d-th MolecularOrbital ",i+1);
             fprintf(stderr,"structure.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
-        readStringOut=fgets(readStringIn,7,wfnFile);
-        readIntegerOut=fscanf(wfnFile," = %lf ",&readDouble);
+        readStringOut=getStringInMappedFile(readStringIn,7,&wfnFile);
+        readIntegerOut=scanCharacterInMappedFile(&wfnFile,'=');
+        if (readIntegerOut==1)
+        {
+            readIntegerOut=scanDoubleInMappedFile(&wfnFile,&readDouble);
+        }
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the occupation number associated with ");
             fprintf(stderr,"the %d-th MolecularOrbital structure.\n",i+1);
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1578,7 +1520,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"attempting to read the occupation number ");
             fprintf(stderr,"associated with the %d-th ",readIntegerIn);
             fprintf(stderr,"MolecularOrbital structure.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1602,18 +1544,22 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             }
         }
 
-        readStringOut=fgets(readStringIn,12,wfnFile);
-        readIntegerOut=fscanf(wfnFile," = %lf ",&readDouble);
+        readStringOut=getStringInMappedFile(readStringIn,12,&wfnFile);
+        readIntegerOut=scanCharacterInMappedFile(&wfnFile,'=');
+        if (readIntegerOut==1)
+        {
+            readIntegerOut=scanDoubleInMappedFile(&wfnFile,&readDouble);
+        }
 
         if (readStringOut==NULL || readIntegerOut!=1)
         {
             PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-            fprintf(stderr,"return of the (standard) fgets ");
-            fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+            fprintf(stderr,"return of the getStringInMappedFile ");
+            fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
             fprintf(stderr,"(=%d) c-function while attempting ",readIntegerOut);
             fprintf(stderr,"to read the energy associated with the %d-th ",i+1);
             fprintf(stderr,"MolecularOrbital structure.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1629,7 +1575,7 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
             fprintf(stderr,"value) while attempting to read the energy ");
             fprintf(stderr,"associated with the %d-th ",readIntegerIn);
             fprintf(stderr,"MolecularOrbital structure.\n");
-            closeTheFile(&wfnFile);
+            closeMappedFile(&wfnFile);
             return 0;
         }
 
@@ -1637,55 +1583,52 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
         // j=1...pChemicalSystem->ngauss
         for (j=0; j<jMax; j++)
         {
-            readIntegerOut=fscanf(wfnFile,"%lf ",&readDouble);
+            readIntegerOut=scanDoubleInMappedFile(&wfnFile,&readDouble);
             if (readIntegerOut!=1)
             {
                 PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong ");
-                fprintf(stderr,"return of the (standard) fscanf ");
+                fprintf(stderr,"return of the scan*InMappedFile ");
                 fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                 fprintf(stderr,"attempting to read the %d-th primitive ",j+1);
                 fprintf(stderr,"coefficient of the %d-th ",i+1);
                 fprintf(stderr,"MolecularOrbital structure.\n");
-                closeTheFile(&wfnFile);
+                closeMappedFile(&wfnFile);
                 return 0;
             }
             pMolecularOrbitalI->coeff[j]=readDouble;
         }
     }
 
-    // Check that the END DATA keyword follows (transformed into ENe eATA here
-    // by the readAndConvertWfnFile function so as to read scientific notation)
-    readStringOut=fgets(readStringIn,9,wfnFile);
+    // Check that the END DATA keyword follows
+    readStringOut=getStringInMappedFile(readStringIn,9,&wfnFile);
     if (readStringOut==NULL)
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: wrong return ");
-        fprintf(stderr,"of the (standard) fgets %p ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile %p ",(void*)readStringOut);
         fprintf(stderr,"c-function while attempting to read the END DATA ");
         fprintf(stderr,"keyword.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
-    if (strcmp(readStringIn,"ENe eATA"))
+    if (strcmp(readStringIn,"END DATA"))
     {
         PRINT_ERROR("In readWfnFileAndAllocateChemicalSystem: expecting ");
-        fprintf(stderr,"ENe eATA instead of %s while attempting ",readStringIn);
+        fprintf(stderr,"END DATA instead of %s while attempting ",readStringIn);
         fprintf(stderr,"to read the END DATA keyword.\n");
-        closeTheFile(&wfnFile);
+        closeMappedFile(&wfnFile);
         return 0;
     }
 
-    // Closing the (copy *.temp of the) *.wfn file: fclose returns zero if the
-    // input FILE* variable is successfully closed, otherwise EOF (end-of-file)
-    if (fclose(wfnFile))
+    // Closing the *.wfn file: closeMappedFile returns zero if the memory is
+    // successfully unmapped, otherwise EOF (end-of-file) is returned
+    if (closeMappedFile(&wfnFile))
     {
         PRINT_ERROR("In readWfnFileandAllocateChemicalSystem: the ");
         fprintf(stderr,"%s file has not been closed properly.\n",fileLocation);
-        wfnFile=NULL;
         return 0;
     }
     fprintf(stdout,"Closing file.\n");
-    wfnFile=NULL;
 
     // Check the number of molecular orbitals that have a spin number equal to
     // two, and duplicate them in the pChemicalSystem structure
@@ -1979,6 +1922,575 @@ int writingChemicalFile(char* fileLocation, int nameLength,
     return 1;
 }
 
+/* ************************************************************************** */
+// The function getSizeOfChemicalCacheFile evaluates the size in bytes of a
+// binary chemical cache (*.chemb) file storing numberOfNuclei nuclei and
+// numberOfMolecularOrbitals molecular orbitals expanded on numberOfPrimitives
+// primitives. It has three int variables as input arguments and it returns the
+// expected size (all blocks of the file are padded to a multiple of 8 bytes)
+/* ************************************************************************** */
+size_t getSizeOfChemicalCacheFile(int numberOfNuclei, int numberOfPrimitives,
+                                                  int numberOfMolecularOrbitals)
+{
+    size_t sizeOfFile=0, numberOfItems=0;
+
+    // Header: magic number, version, orbRhf, hash, and the three dimensions
+    sizeOfFile=CHEM_CACHE_HEADER;
+
+    // Nuclei: coordinates (3 doubles) then the charges (int padded to 8 bytes)
+    numberOfItems=(size_t)numberOfNuclei;
+    sizeOfFile+=3*numberOfItems*sizeof(double);
+    sizeOfFile+=((numberOfItems*sizeof(int)+7)/8)*8;
+
+    // Spins of the molecular orbitals (int padded to 8 bytes)
+    numberOfItems=(size_t)numberOfMolecularOrbitals;
+    sizeOfFile+=((numberOfItems*sizeof(int)+7)/8)*8;
+
+    // Coefficients and exponents, then centers and types of the primitives
+    numberOfItems*=(size_t)numberOfPrimitives;
+    sizeOfFile+=2*numberOfItems*sizeof(double);
+    sizeOfFile+=2*numberOfItems*sizeof(int);
+
+    return sizeOfFile;
+}
+
+/* ************************************************************************** */
+// The function getChemicalCacheLocation builds in cacheLocation the path name
+// of the binary chemical cache associated with the *.chem or *.wfn file located
+// at fileLocation, by adding the hash of its absolute path and the *.chemb
+// extension to its file name (without its directory), and placing it in the
+// directory given by the environment variable CHEM_CACHE_DIRECTORY (current
+// working directory if it is not set).
+// It has two char* variables (fileLocation and cacheLocation, both of size
+// nameLength) and an int nameLength variable as input arguments and it returns
+// one on success, otherwise zero if the cache name cannot be built
+/* ************************************************************************** */
+int getChemicalCacheLocation(char* fileLocation, int nameLength,
+                                                            char* cacheLocation)
+{
+    size_t i=0, length=0;
+    unsigned long long hashValue=14695981039346656037ULL;
+    char *fileName=NULL, *cacheDirectory=NULL, *absoluteLocation=NULL;
+
+    // Check that fileLocation ends with the *.chem or *.wfn extension
+    // (getChemicalFormat returns zero if it is not the case)
+    if (cacheLocation==NULL || !getChemicalFormat(fileLocation,nameLength))
+    {
+        PRINT_ERROR("In getChemicalCacheLocation: the input cacheLocation ");
+        fprintf(stderr,"variable is pointing to the %p ",(void*)cacheLocation);
+        fprintf(stderr,"address or the getChemicalFormat function returned ");
+        fprintf(stderr,"zero instead of (+/-) one.\n");
+        return 0;
+    }
+
+    // Remove the directory (before the last '/') but keep the extension so
+    // that the *.chem and *.wfn files of the same name get different caches
+    // (strrchr returns a pointer to the last occurrence of the character)
+    fileName=strrchr(fileLocation,'/');
+    fileName=(fileName==NULL) ? fileLocation : fileName+1;
+
+    // Two chemical files of the same name in different directories must not
+    // share their cache, so the 64-bit FNV-1a hash of the absolute path is
+    // added to the cache name (realpath returns NULL if the path is invalid)
+    absoluteLocation=realpath(fileLocation,NULL);
+    if (absoluteLocation==NULL)
+    {
+        fprintf(stdout,"\nWarning in getChemicalCacheLocation function: the ");
+        fprintf(stdout,"absolute path of the %s file ",fileLocation);
+        fprintf(stdout,"could not be resolved. No cache is used.\n");
+        return 0;
+    }
+    for (i=0; absoluteLocation[i]!='\0'; i++)
+    {
+        hashValue^=(unsigned long long)(unsigned char)absoluteLocation[i];
+        hashValue*=1099511628211ULL;
+    }
+    free(absoluteLocation);
+    absoluteLocation=NULL;
+
+    // getenv returns a pointer to the value of the environment variable if it
+    // exists, otherwise NULL (an empty value stands for the working directory)
+    cacheDirectory=getenv(CHEM_CACHE_DIRECTORY);
+    if (cacheDirectory==NULL)
+    {
+        cacheDirectory="";
+    }
+    length=strlen(cacheDirectory);
+
+    if (length+strlen(fileName)+25>(size_t)nameLength)
+    {
+        fprintf(stdout,"\nWarning in getChemicalCacheLocation function: the ");
+        fprintf(stdout,"name of the binary cache associated with the ");
+        fprintf(stdout,"%s file would be longer than the ",fileLocation);
+        fprintf(stdout,"%d characters allowed. No cache is used.\n",nameLength);
+        return 0;
+    }
+    strcpy(cacheLocation,cacheDirectory);
+    if (length && cacheLocation[length-1]!='/')
+    {
+        strcat(cacheLocation,"/");
+    }
+    strcat(cacheLocation,fileName);
+    sprintf(cacheLocation+strlen(cacheLocation),".%016llx.chemb",hashValue);
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function readChemicalCacheFile maps into memory the binary chemical cache
+// located at fileLocation and, if it has been built from a chemical file whose
+// content hash is hashValue, allocates and fills the structure pointed by
+// pChemicalSystem. It has the char* fileLocation, int nameLength, unsigned long
+// long hashValue, and ChemicalSystem* (defined in main.h) variables as input
+// arguments and it returns one (resp. minus one) if a restricted (resp.
+// unrestricted) Hartree-Fock structure has been loaded, otherwise zero is
+// returned if the cache does not exist, is outdated, or is not valid
+/* ************************************************************************** */
+int readChemicalCacheFile(char* fileLocation, int nameLength,
+                  unsigned long long hashValue, ChemicalSystem* pChemicalSystem)
+{
+    size_t offset=0, offsetInt=0;
+    int i=0, j=0, iMax=0, jMax=0, orbRhf=0, boolean=0, header[5]={0};
+    unsigned long long storedHash=0;
+    MolecularOrbital *pMolecularOrbital=NULL;
+    MappedFile cacheFile={NULL,0,0};
+
+    // Check if the input pChemicalSystem variable is pointing to NULL
+    if (pChemicalSystem==NULL)
+    {
+        PRINT_ERROR("In readChemicalCacheFile: the input pChemicalSystem ");
+        fprintf(stderr,"variable is pointing to the ");
+        fprintf(stderr,"%p adress.\n",(void*)pChemicalSystem);
+        return 0;
+    }
+
+    // A missing cache is not an error: the chemical file is simply parsed
+    if (initialFileExists(fileLocation,nameLength)!=1)
+    {
+        return 0;
+    }
+
+    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    if (!openMappedFile(fileLocation,nameLength,&cacheFile))
+    {
+        PRINT_ERROR("In readChemicalCacheFile: could not read the content ");
+        fprintf(stderr,"of %s file.\n",fileLocation);
+        return 0;
+    }
+
+    // Check the magic number, the version, and the hash of the chemical file
+    // memcpy is used everywhere since the mapped data may not be aligned
+    boolean=(cacheFile.size>=CHEM_CACHE_HEADER);
+    if (boolean)
+    {
+        boolean=(!memcmp(cacheFile.data,"MPDCHEMB",8));
+        memcpy(header,&cacheFile.data[8],2*sizeof(int));
+        memcpy(&storedHash,&cacheFile.data[16],sizeof(unsigned long long));
+        memcpy(&header[2],&cacheFile.data[24],3*sizeof(int));
+        boolean=(boolean && header[0]==CHEM_CACHE_VERSION);
+        boolean=(boolean && abs(header[1])==1 && storedHash==hashValue);
+        boolean=(boolean && header[2]>0 && header[3]>0 && header[4]>0);
+    }
+    if (boolean)
+    {
+        boolean=(cacheFile.size==getSizeOfChemicalCacheFile(header[2],
+                                                         header[3],header[4]));
+    }
+    if (!boolean)
+    {
+        fprintf(stdout,"Outdated or invalid cache (ignored). ");
+        closeMappedFile(&cacheFile);
+        return 0;
+    }
+    orbRhf=header[1];
+    fprintf(stdout,"Reading cached chemical data. ");
+
+    // Allocate and fill the Nucleus structures
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    iMax=header[2];
+    pChemicalSystem->nnucl=iMax;
+    pChemicalSystem->pnucl=(Nucleus*)calloc(iMax,sizeof(Nucleus));
+    if (pChemicalSystem->pnucl==NULL)
+    {
+        PRINT_ERROR("In readChemicalCacheFile: could not allocate memory ");
+        fprintf(stderr,"for the pChemicalSystem->pnucl variable.\n");
+        closeMappedFile(&cacheFile);
+        freeChemicalMemory(pChemicalSystem);
+        initializeChemicalStructure(pChemicalSystem);
+        return 0;
+    }
+    offset=CHEM_CACHE_HEADER;
+    offsetInt=offset+3*(size_t)iMax*sizeof(double);
+    for (i=0; i<iMax; i++)
+    {
+        memcpy(&pChemicalSystem->pnucl[i].x,&cacheFile.data[offset],
+                                                                sizeof(double));
+        offset+=sizeof(double);
+        memcpy(&pChemicalSystem->pnucl[i].y,&cacheFile.data[offset],
+                                                                sizeof(double));
+        offset+=sizeof(double);
+        memcpy(&pChemicalSystem->pnucl[i].z,&cacheFile.data[offset],
+                                                                sizeof(double));
+        offset+=sizeof(double);
+        memcpy(&pChemicalSystem->pnucl[i].charge,&cacheFile.data[offsetInt],
+                                                                   sizeof(int));
+        offsetInt+=sizeof(int);
+    }
+    offset=((offsetInt+7)/8)*8;
+
+    // Allocate the MolecularOrbital structures and read their spins
+    iMax=header[4];
+    jMax=header[3];
+    pChemicalSystem->ngauss=jMax;
+    pChemicalSystem->nmorb=iMax;
+    pChemicalSystem->pmorb=(MolecularOrbital*)calloc(iMax,
+                                                      sizeof(MolecularOrbital));
+    if (pChemicalSystem->pmorb==NULL)
+    {
+        PRINT_ERROR("In readChemicalCacheFile: could not allocate memory ");
+        fprintf(stderr,"for the pChemicalSystem->pmorb variable.\n");
+        closeMappedFile(&cacheFile);
+        freeChemicalMemory(pChemicalSystem);
+        initializeChemicalStructure(pChemicalSystem);
+        return 0;
+    }
+    for (i=0; i<iMax; i++)
+    {
+        memcpy(&pChemicalSystem->pmorb[i].spin,&cacheFile.data[offset],
+                                                                   sizeof(int));
+        offset+=sizeof(int);
+    }
+    offset=((offset+7)/8)*8;
+
+    // Read the primitive data: the coefficients and exponents of all orbitals
+    // are stored first (double blocks), followed by their centers and types
+    offsetInt=offset+2*(size_t)iMax*(size_t)jMax*sizeof(double);
+    boolean=1;
+    for (i=0; i<iMax; i++)
+    {
+        pMolecularOrbital=&pChemicalSystem->pmorb[i];
+        pMolecularOrbital->coeff=(double*)calloc(jMax,sizeof(double));
+        pMolecularOrbital->exp=(double*)calloc(jMax,sizeof(double));
+        pMolecularOrbital->nucl=(int*)calloc(jMax,sizeof(int));
+        pMolecularOrbital->type=(int*)calloc(jMax,sizeof(int));
+        if (pMolecularOrbital->coeff==NULL || pMolecularOrbital->exp==NULL ||
+                 pMolecularOrbital->nucl==NULL || pMolecularOrbital->type==NULL)
+        {
+            PRINT_ERROR("In readChemicalCacheFile: could not allocate memory ");
+            fprintf(stderr,"for the %d-th MolecularOrbital structure.\n",i+1);
+            closeMappedFile(&cacheFile);
+            freeChemicalMemory(pChemicalSystem);
+            initializeChemicalStructure(pChemicalSystem);
+            return 0;
+        }
+        memcpy(pMolecularOrbital->coeff,&cacheFile.data[offset],
+                                                   (size_t)jMax*sizeof(double));
+        offset+=(size_t)jMax*sizeof(double);
+        memcpy(pMolecularOrbital->exp,&cacheFile.data[offset],
+                                                   (size_t)jMax*sizeof(double));
+        offset+=(size_t)jMax*sizeof(double);
+        memcpy(pMolecularOrbital->nucl,&cacheFile.data[offsetInt],
+                                                      (size_t)jMax*sizeof(int));
+        offsetInt+=(size_t)jMax*sizeof(int);
+        memcpy(pMolecularOrbital->type,&cacheFile.data[offsetInt],
+                                                      (size_t)jMax*sizeof(int));
+        offsetInt+=(size_t)jMax*sizeof(int);
+
+        // Check the values as the writingChemicalFile function would do
+        boolean=(boolean && abs(pMolecularOrbital->spin)==1);
+        for (j=0; j<jMax; j++)
+        {
+            boolean=(boolean && pMolecularOrbital->exp[j]>0.);
+            boolean=(boolean && pMolecularOrbital->nucl[j]>0 &&
+                                  pMolecularOrbital->nucl[j]<=header[2]);
+            boolean=(boolean && pMolecularOrbital->type[j]>0 &&
+                                                 pMolecularOrbital->type[j]<21);
+        }
+    }
+
+    // closeMappedFile returns zero on success, otherwise EOF is returned
+    if (closeMappedFile(&cacheFile))
+    {
+        PRINT_ERROR("In readChemicalCacheFile: the ");
+        fprintf(stderr,"%s file has not been closed properly.\n",fileLocation);
+        return 0;
+    }
+    fprintf(stdout,"Closing file.\n");
+
+    // Invalid content: reset the structure so that the chemical file is parsed
+    if (!boolean)
+    {
+        fprintf(stdout,"\nWarning in readChemicalCacheFile function: the ");
+        fprintf(stdout,"%s file stores invalid chemical data ",fileLocation);
+        fprintf(stdout,"and is ignored.\n");
+        freeChemicalMemory(pChemicalSystem);
+        initializeChemicalStructure(pChemicalSystem);
+        return 0;
+    }
+
+    return orbRhf;
+}
+
+/* ************************************************************************** */
+// The function writingChemicalCacheFile writes the content of the structure
+// pointed by pChemicalSystem in the binary chemical cache located at
+// fileLocation, together with the hashValue of the chemical file it comes from
+// and the orbRhf value (restricted or not Hartree-Fock structure). The file is
+// first written under a temporary name and then renamed, so that concurrent MPD
+// runs never read a partially written cache. It has the char* fileLocation, int
+// nameLength, unsigned long long hashValue, int orbRhf, and ChemicalSystem*
+// variables as input arguments and it returns one on success, otherwise zero
+/* ************************************************************************** */
+int writingChemicalCacheFile(char* fileLocation, int nameLength,
+                                      unsigned long long hashValue, int orbRhf,
+                                                ChemicalSystem* pChemicalSystem)
+{
+    size_t length=0, numberOfItems=0;
+    char *temporaryLocation=NULL, padding[8]={'\0'};
+    int i=0, iMax=0, jMax=0, header[5]={0}, boolean=0;
+    FILE *cacheFile=NULL;
+
+    // Check the input variables
+    if (pChemicalSystem==NULL || abs(orbRhf)!=1)
+    {
+        PRINT_ERROR("In writingChemicalCacheFile: the input pChemicalSystem ");
+        fprintf(stderr,"variable is pointing to the ");
+        fprintf(stderr,"%p adress or orbRhf ",(void*)pChemicalSystem);
+        fprintf(stderr,"(=%d) is not (+/-) one.\n",orbRhf);
+        return 0;
+    }
+
+    if (!checkStringFromLength(fileLocation,8,nameLength))
+    {
+        PRINT_ERROR("In writingChemicalCacheFile: checkStringFromLength ");
+        fprintf(stderr,"function returned zero, which is not the expected ");
+        fprintf(stderr,"value here, after having checked that the char* ");
+        fprintf(stderr,"fileLocation variable is not a string of length ");
+        fprintf(stderr,"(strictly) less than %d (and more than 6 ",nameLength);
+        fprintf(stderr,"in order to store at least something more than the ");
+        fprintf(stderr,"*.chemb extension).\n");
+        return 0;
+    }
+
+    header[0]=CHEM_CACHE_VERSION;
+    header[1]=orbRhf;
+    header[2]=pChemicalSystem->nnucl;
+    header[3]=pChemicalSystem->ngauss;
+    header[4]=pChemicalSystem->nmorb;
+    if (header[2]<1 || header[3]<1 || header[4]<1 ||
+                   pChemicalSystem->pnucl==NULL || pChemicalSystem->pmorb==NULL)
+    {
+        PRINT_ERROR("In writingChemicalCacheFile: the structure pointed by ");
+        fprintf(stderr,"pChemicalSystem does not store valid data ");
+        fprintf(stderr,"(%d nuclei, %d primitives, ",header[2],header[3]);
+        fprintf(stderr,"%d molecular orbitals).\n",header[4]);
+        return 0;
+    }
+
+    // The temporary name is made of fileLocation followed by the process
+    // identifier (getpid never fails) and the '~' character, so that two runs
+    // building the same cache at the same time never share their temporary file
+    length=strlen(fileLocation);
+    temporaryLocation=(char*)calloc(length+24,sizeof(char));
+    if (temporaryLocation==NULL)
+    {
+        PRINT_ERROR("In writingChemicalCacheFile: could not allocate memory ");
+        fprintf(stderr,"for the local (char*) temporaryLocation variable.\n");
+        return 0;
+    }
+    sprintf(temporaryLocation,"%s.%ld~",fileLocation,(long)getpid());
+
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    fprintf(stdout,"Opening %s file. ",fileLocation);
+    cacheFile=fopen(temporaryLocation,"wb");
+    if (cacheFile==NULL)
+    {
+        PRINT_ERROR("In writingChemicalCacheFile: could not open and write ");
+        fprintf(stderr,"into the %s file.\n",temporaryLocation);
+        free(temporaryLocation);
+        return 0;
+    }
+    fprintf(stdout,"Writing cached chemical data. ");
+
+    // fwrite returns the number of items successfully written
+    iMax=pChemicalSystem->nmorb;
+    jMax=pChemicalSystem->ngauss;
+    boolean=(fwrite("MPDCHEMB",1,8,cacheFile)==8);
+    boolean=(boolean && fwrite(header,sizeof(int),2,cacheFile)==2);
+    boolean=(boolean &&
+               fwrite(&hashValue,sizeof(unsigned long long),1,cacheFile)==1);
+    boolean=(boolean && fwrite(&header[2],sizeof(int),3,cacheFile)==3);
+    boolean=(boolean && fwrite(padding,1,4,cacheFile)==4);
+
+    for (i=0; i<header[2]; i++)
+    {
+        boolean=(boolean &&
+                 fwrite(&pChemicalSystem->pnucl[i].x,sizeof(double),1,cacheFile)
+                                                                           ==1);
+        boolean=(boolean &&
+                 fwrite(&pChemicalSystem->pnucl[i].y,sizeof(double),1,cacheFile)
+                                                                           ==1);
+        boolean=(boolean &&
+                 fwrite(&pChemicalSystem->pnucl[i].z,sizeof(double),1,cacheFile)
+                                                                           ==1);
+    }
+    for (i=0; i<header[2]; i++)
+    {
+        boolean=(boolean && fwrite(&pChemicalSystem->pnucl[i].charge,
+                                                   sizeof(int),1,cacheFile)==1);
+    }
+    numberOfItems=((size_t)header[2]*sizeof(int))%8;
+    if (numberOfItems)
+    {
+        numberOfItems=8-numberOfItems;
+        boolean=(boolean &&
+                     fwrite(padding,1,numberOfItems,cacheFile)==numberOfItems);
+    }
+
+    for (i=0; i<iMax; i++)
+    {
+        boolean=(boolean && fwrite(&pChemicalSystem->pmorb[i].spin,
+                                                   sizeof(int),1,cacheFile)==1);
+    }
+    numberOfItems=((size_t)iMax*sizeof(int))%8;
+    if (numberOfItems)
+    {
+        numberOfItems=8-numberOfItems;
+        boolean=(boolean &&
+                     fwrite(padding,1,numberOfItems,cacheFile)==numberOfItems);
+    }
+
+    numberOfItems=(size_t)jMax;
+    for (i=0; i<iMax; i++)
+    {
+        boolean=(boolean && fwrite(pChemicalSystem->pmorb[i].coeff,
+                        sizeof(double),numberOfItems,cacheFile)==numberOfItems);
+        boolean=(boolean && fwrite(pChemicalSystem->pmorb[i].exp,
+                        sizeof(double),numberOfItems,cacheFile)==numberOfItems);
+    }
+    for (i=0; i<iMax; i++)
+    {
+        boolean=(boolean && fwrite(pChemicalSystem->pmorb[i].nucl,
+                           sizeof(int),numberOfItems,cacheFile)==numberOfItems);
+        boolean=(boolean && fwrite(pChemicalSystem->pmorb[i].type,
+                           sizeof(int),numberOfItems,cacheFile)==numberOfItems);
+    }
+
+    // fclose returns zero if the input FILE* variable is successfully closed
+    if (fclose(cacheFile))
+    {
+        boolean=0;
+    }
+    cacheFile=NULL;
+
+    // rename returns zero on success, otherwise -1 (errno is set)
+    if (!boolean || rename(temporaryLocation,fileLocation))
+    {
+        PRINT_ERROR("In writingChemicalCacheFile: we were not able to write ");
+        fprintf(stderr,"the %s file properly.\n",fileLocation);
+        remove(temporaryLocation);
+        free(temporaryLocation);
+        return 0;
+    }
+    free(temporaryLocation);
+    fprintf(stdout,"Closing file.\n");
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function readChemicalFileOrCache loads the chemical data of the *.chem
+// (chemicalFormat=1) or *.wfn (chemicalFormat=-1) file located at fileLocation
+// in the structure pointed by pChemicalSystem. If a binary cache (*.chemb)
+// built from the same file content (same hash) exists in the cache directory
+// (see getChemicalCacheLocation), it is loaded instead of parsing the file,
+// otherwise the file is parsed and the cache is (re)built for the next MPD
+// runs. It has the char* fileLocation, two int variables (nameLength and
+// chemicalFormat), the ChemicalSystem* variable (defined in main.h) and the
+// int* pCacheHit variable (set to one if the cache was loaded, zero otherwise,
+// and ignored if NULL) as input arguments and it returns one (resp. minus one)
+// for a restricted (resp. unrestricted) Hartree-Fock chemical structure,
+// otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int readChemicalFileOrCache(char* fileLocation, int nameLength,
+                            int chemicalFormat, ChemicalSystem* pChemicalSystem,
+                                                                int* pCacheHit)
+{
+    char *cacheLocation=NULL;
+    int orbRhf=0, boolean=0;
+    unsigned long long hashValue=0;
+
+    // Check the chemicalFormat variable
+    if (abs(chemicalFormat)!=1)
+    {
+        PRINT_ERROR("In readChemicalFileOrCache: the input chemicalFormat ");
+        fprintf(stderr,"variable (=%d) should be (+/-) one.\n",chemicalFormat);
+        return 0;
+    }
+
+    // calloc returns a pointer to the allocated memory, otherwise NULL
+    if (nameLength>0)
+    {
+        cacheLocation=(char*)calloc(nameLength,sizeof(char));
+    }
+    if (cacheLocation==NULL)
+    {
+        PRINT_ERROR("In readChemicalFileOrCache: could not allocate memory ");
+        fprintf(stderr,"for the local (char*) cacheLocation variable.\n");
+        return 0;
+    }
+
+    // Try to load the binary cache if its name can be built and if the hash of
+    // the chemical file can be computed (the cache is simply skipped otherwise)
+    boolean=getChemicalCacheLocation(fileLocation,nameLength,cacheLocation);
+    if (boolean)
+    {
+        boolean=computeHashOfFile(fileLocation,nameLength,&hashValue);
+    }
+    if (boolean)
+    {
+        orbRhf=readChemicalCacheFile(cacheLocation,nameLength,hashValue,
+                                                               pChemicalSystem);
+    }
+    if (pCacheHit!=NULL)
+    {
+        *pCacheHit=(orbRhf!=0);
+    }
+
+    // Parse the chemical file if the cache could not be used
+    if (!orbRhf)
+    {
+        if (chemicalFormat==1)
+        {
+            orbRhf=readChemFileandAllocateChemicalSystem(fileLocation,
+                                                   nameLength,pChemicalSystem);
+        }
+        else
+        {
+            orbRhf=readWfnFileAndAllocateChemicalSystem(fileLocation,
+                                                   nameLength,pChemicalSystem);
+        }
+
+        // A cache that cannot be written (e.g. read-only directory) only
+        // prevents the next MPD runs from skipping the parsing step
+        if (boolean && abs(orbRhf)==1)
+        {
+            if (!writingChemicalCacheFile(cacheLocation,nameLength,hashValue,
+                                                       orbRhf,pChemicalSystem))
+            {
+                fprintf(stdout,"\nWarning in readChemicalFileOrCache ");
+                fprintf(stdout,"function: the binary cache ");
+                fprintf(stdout,"%s could not be written.\n",cacheLocation);
+            }
+        }
+    }
+
+    free(cacheLocation);
+    cacheLocation=NULL;
+
+    return orbRhf;
+}
+
 /* ************************************************************************** */
 // The function loadChemistry extracts the chemical data from a *.chem or *.wfn
 // file (warning: reset and overwrite chemicalOut.chem file if it already
@@ -1991,7 +2503,8 @@ int loadChemistry(Parameters* pParameters, ChemicalSystem *pChemicalSystem)
 {
     size_t length=0;
     char *fileLocation=NULL;
-    int orbRhf=0;
+    int orbRhf=0, cacheHit=0;
+    struct stat chemStatus, wfnStatus;
 
     // Testing if pParameters or pChemicalSystem is pointing to NULL
     if (pParameters==NULL || pChemicalSystem==NULL)
@@ -2052,16 +2565,15 @@ int loadChemistry(Parameters* pParameters, ChemicalSystem *pChemicalSystem)
             fprintf(stdout,"\nChemistry will be loaded from ");
             fprintf(stdout,"%s file.",pParameters->name_chem);
 
-            // Reading the *.chem file
-            orbRhf=readChemFileandAllocateChemicalSystem(pParameters->name_chem,
-                                                       pParameters->name_length,
-                                                               pChemicalSystem);
+            // Reading the *.chem file (or its binary cache if it is up to date)
+            orbRhf=readChemicalFileOrCache(pParameters->name_chem,
+                                                   pParameters->name_length,1,
+                                                         pChemicalSystem,NULL);
 
             // Check the pParameters->orb_rhf variable
             if (abs(orbRhf)!=1)
             {
-                PRINT_ERROR("In loadChemistry: ");
-                fprintf(stderr,"readChemFileandAllocateChemicalSystem ");
+                PRINT_ERROR("In loadChemistry: readChemicalFileOrCache ");
                 fprintf(stderr,"function returned %d instead of ",orbRhf);
                 fprintf(stderr,"(+/-)1.\n");
                 free(fileLocation);   // free function does not any return value
@@ -2152,65 +2664,16 @@ int loadChemistry(Parameters* pParameters, ChemicalSystem *pChemicalSystem)
             fprintf(stdout,"\nChemistry will be loaded from ");
             fprintf(stdout,"%s file.",pParameters->name_chem);
 
-            // Copy the *.wfn file into a (previously removed if exists) *.temp
-            strncpy(fileLocation,pParameters->name_info,length);
-            length=strlen(fileLocation);
-            fileLocation[length-5]='.';
-            fileLocation[length-4]='t';
-            fileLocation[length-3]='e';
-            fileLocation[length-2]='m';
-            fileLocation[length-1]='p';
-            fileLocation[length]='\0';
-
-            if (initialFileExists(fileLocation,pParameters->name_length)==1)
-            {
-                if (remove(fileLocation))
-                {
-                    PRINT_ERROR("In loadChemistry: wrong return (=-1) of the ");
-                    fprintf(stderr,"standard remove c-function in the ");
-                    fprintf(stderr,"attempt of removing the ");
-                    fprintf(stderr,"%s file.\n",fileLocation);
-                    free(fileLocation);
-                    fileLocation=NULL;
-                    return 0;
-                }
-            }
-
-            if (!copyFileLocation(pParameters->name_chem,
-                                         pParameters->name_length,fileLocation))
-            {
-                PRINT_ERROR("In loadChemistry: copyFileLocation function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
-                return 0;
-            }
-
-            // Update the *.temp name in the name_chem variable of pParameters
-            strncpy(pParameters->name_chem,fileLocation,
-                                                      pParameters->name_length);
-
-            // Converting the Fortran scientific notation (1.0D+01) into the C
-            // format (1.0e+01) in the *.temp file (the copy of the *.wfn file)
-            if (!readAndConvertWfnFile(fileLocation,'D','e',
-                                                      pParameters->name_length))
-            {
-                PRINT_ERROR("In loadChemistry: readAndConvertWfnFile ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
-                return 0;
-            }
-
-            // Reading the (copy *.temp of the) *.wfn file
-            orbRhf=readWfnFileAndAllocateChemicalSystem(fileLocation,
-                                                       pParameters->name_length,
-                                                               pChemicalSystem);
+            // Reading the *.wfn file (or its binary cache if it is up to date)
+            // The Fortran scientific notation 1.0D+01 is directly handled so
+            // that the file is neither copied nor altered here
+            orbRhf=readChemicalFileOrCache(pParameters->name_chem,
+                                                   pParameters->name_length,-1,
+                                                     pChemicalSystem,&cacheHit);
             // Check the pParameters->orb_rhf variable
             if (abs(orbRhf)!=1)
             {
-                PRINT_ERROR("In loadChemistry: ");
-                fprintf(stderr,"readWfnFileandAllocateChemicalSystem ");
+                PRINT_ERROR("In loadChemistry: readChemicalFileOrCache ");
                 fprintf(stderr,"function returned %d instead of ",orbRhf);
                 fprintf(stderr,"(+/-)1.\n");
                 free(fileLocation);
@@ -2250,19 +2713,9 @@ int loadChemistry(Parameters* pParameters, ChemicalSystem *pChemicalSystem)
                 }
             }
 
-            // Overwrite the *.temp file to save the *.wfn into a *.chem format
-            if (!writingChemicalFile(fileLocation,
-                                      pParameters->name_length,pChemicalSystem))
-            {
-                PRINT_ERROR("In loadChemistry: writingChemicalFile function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
-                return 0;
-            }
-
-            // Change the *.temp extension into an *.chem one (warning: the
-            // corresponding *.chem file will be next deleted if it exists)
+            // Set the default *.chem name in fileLocation from the *.info one
+            // strncpy function returns a pointer to the string (not used here)
+            strncpy(fileLocation,pParameters->name_info,length);
             length=strlen(fileLocation);
             fileLocation[length-5]='.';
             fileLocation[length-4]='c';
@@ -2271,26 +2724,22 @@ int loadChemistry(Parameters* pParameters, ChemicalSystem *pChemicalSystem)
             fileLocation[length-1]='m';
             fileLocation[length]='\0';
 
-            if (initialFileExists(fileLocation,pParameters->name_length)==1)
+            // Save the *.wfn data into the *.chem format (warning: the
+            // corresponding *.chem file is overwritten if it already exists),
+            // except if the *.wfn data come from the cache and if the *.chem
+            // file already exists and is not older than the *.wfn file (stat
+            // returns zero on success)
+            if (cacheHit && !stat(fileLocation,&chemStatus) &&
+                                    !stat(pParameters->name_chem,&wfnStatus) &&
+                                      chemStatus.st_mtime>=wfnStatus.st_mtime)
             {
-                // remove returns zero on success, otherwise -1 and errno is set
-                if (remove(fileLocation))
-                {
-                    PRINT_ERROR("In loadChemistry: wrong return (=-1) of the ");
-                    fprintf(stderr,"standard remove c-function in the ");
-                    fprintf(stderr,"attempt of removing the ");
-                    fprintf(stderr,"%s file.\n",fileLocation);
-                    free(fileLocation);
-                    fileLocation=NULL;
-                    return 0;
-                }
+                fprintf(stdout,"\nThe %s file is up to date ",fileLocation);
+                fprintf(stdout,"(chemistry loaded from the cache).");
             }
-
-            // Rename the *.temp file into an *.chem one
-            if (!renameFileLocation(pParameters->name_chem,
-                                         pParameters->name_length,fileLocation))
+            else if (!writingChemicalFile(fileLocation,
+                                      pParameters->name_length,pChemicalSystem))
             {
-                PRINT_ERROR("In loadChemistry: rename FileLocation function ");
+                PRINT_ERROR("In loadChemistry: writingChemicalFile function ");
                 fprintf(stderr,"returned zero instead of one.\n");
                 free(fileLocation);
                 fileLocation=NULL;
@@ -16,6 +16,29 @@
 
 #include "main.h"
 
+/**
+* \def CHEM_CACHE_VERSION
+* \brief Version of the layout used for the binary chemical cache (*.chemb).
+*
+* It must be incremented each time the layout of the *.chemb file is modified,
+* so that the caches written by a previous version are ignored and rebuilt.
+*/
+#define CHEM_CACHE_VERSION 1
+
+/**
+* \def CHEM_CACHE_HEADER
+* \brief Size (in bytes) of the header of the binary chemical cache (*.chemb).
+*/
+#define CHEM_CACHE_HEADER 40
+
+/**
+* \def CHEM_CACHE_DIRECTORY
+* \brief Name of the environment variable that may store the directory where
+*        the binary chemical caches (*.chemb) are written (the current working
+*        directory is used if it is not set).
+*/
+#define CHEM_CACHE_DIRECTORY "MPD_CACHE_DIR"
+
 /* ************************************************************************** */
 // Prototypes of non-static functions
 /* ************************************************************************** */
@@ -135,68 +158,6 @@ int getChemicalFormat(char* fileLocation, int nameLength);
 int readChemFileandAllocateChemicalSystem(char* fileLocation, int nameLength,
                                                ChemicalSystem* pChemicalSystem);
 
-/**
-* \fn int readAndConvertWfnFile(char* fileLocation, char charToRemove,
-*                                         char charToPutInstead, int nameLength)
-* \brief It tries to read an existing file specified at fileLocation (a path
-*        name of (positive) length (strictly) less than nameLength). Such a file
-*        is expected to have the *.wfn format and then, except for the first
-*        line (commnet line in the *.wfn file), all charToRemove encountered is
-*        replaced by charToPutInstead.
-*
-* \param[in] fileLocation A pointer that points to a string that is intended to
-*                         store the path name of an existing chemical file
-*                         having the *.wfn format. Its length must not be
-*                         (strictly) greater than the nameLength variable
-*                         (including the terminating nul character '\0'), and
-*                         lower than one (to be able to store at least
-*                         something more than the terminating nul character
-*                         '\0'). Otherwise, an error is returned by the \ref
-*                         readAndConvertWfnFile function.
-*
-* \param[in] nameLength A positive integer representing the maximal length
-*                       allowed for the name pointed by the fileLocation
-*                       variable (including the terminating nul character '\0').
-*                       It must be (strictly) greater than one, otherwise an
-*                       error is returned by the \ref readAndConvertWfnFile
-*                       function.
-*
-* \param[in] charToRemove Except for the first line, which corresponds to a
-*                         comment line in the *.wfn format, it represents the
-*                         character that is going to be tracked throughout the
-*                         file pointed by the fileLocation variable, and that
-*                         is intended to be replace by the charToPutInstead
-*                         character.
-*
-* \param[in] charToPutInstead It corresponds to the character that is going to
-*                             replace each charToRemove encountered in the file
-*                             specified at fileLocation, except for the first
-*                             line, which is a comment line in the *.wfn format.
-*
-* \return It returns one if every charToRemove has been successfully replaced by
-*         charToPutInstead in the file located at fileLocation. Otherwise, an
-*         error is returned in the standard error stream an zero is returned by
-*         the \ref readAndConvertWfnFile function.
-*
-* First, we recall that in the \ref loadChemistry function, the string pointed
-* by fileLocation in the \ref readAndConvertWfnFile function is intended to
-* have the *.wfn format. Since we wish to modify the original *.wfn file, we
-* have introduced a security here and copied the original *.wfn file into an
-* *.temp file in the case an error would occur in the process. We also recall
-* that we need to modify the (copy *.temp of the) *.wfn file because such a file
-* is the output of the Gaussian software, which is written in Fortran. In
-* particular, the scientific notation uses the 'D' symbol, which is not
-* recognized by the standard fscanf c-function. Fortunately, one can notice that
-* apart form the first line, which is a comment in the *.wfn format, the 'D'
-* symbol now only appears either for scientific notation (Fortran 1.0D+01) or
-* for the END DATA keyword so it can be easily converted into the C syntax
-* (1.0e+01). We finally recall that the \ref readAndConvertWfnFile function
-* should be static but has been defined as non-static in order to perform
-* unit-test on it.
-*/
-int readAndConvertWfnFile(char* fileLocation, char charToRemove,
-                                         char charToPutInstead, int nameLength);
-
 /**
 * \fn int readWfnFileAndAllocateChemicalSystem(char* fileLocation,
 *                                              int nameLength,
@@ -208,36 +169,33 @@ int readAndConvertWfnFile(char* fileLocation, char charToRemove,
 *        contained in the .wfn-format file.
 *
 * \param[in] fileLocation A pointer that points to a string that is intended to
-*                         store the path name of an existing *.temp (chemical)
-*                         file. We recall that for technical purpose, we have
-*                         copied the *.wfn file into an *.temp file in order not
-*                         to alter the original file in case of error. Its
-*                         length must not be (strictly) greater than the
-*                         nameLength variable (including the terminating nul
-*                         character '\0'), and lower than six (to be able to
-*                         store at least something more than the *.temp
+*                         store the path name of an existing *.wfn (chemical)
+*                         file. Its length must not be (strictly) greater than
+*                         the nameLength variable (including the terminating
+*                         nul character '\0'), and lower than five (to be able
+*                         to store at least something more than the *.wfn
 *                         extension). Otherwise, an error is returned by the
 *                         \ref readWfnFileAndAllocateChemicalSystem function.
 *
 * \param[in] nameLength A positive integer representing the maximal length
 *                       allowed for the name pointed by the fileLocation
 *                       variable (including the terminating nul character '\0').
-*                       It must be (strictly) greater than six, otherwise an
+*                       It must be (strictly) greater than five, otherwise an
 *                       error is returned by the \ref
 *                       readWfnFileAndAllocateChemicalSystem function.
 *
 * \param[out] pChemicalSystem A pointer that points to the ChemicalSystem
 *                             structure (defined in main.h file) of the \ref
 *                             main function, and that is intended to be filled
-*                             with the values contained in the (copy *.temp of
-*                             the) *.wfn file pointed by the fileLocation
-*                             variable. It must not point to NULL otherwise an
-*                             error is returned by the \ref
+*                             with the values contained in the *.wfn file
+*                             pointed by the fileLocation variable. It must
+*                             not point to NULL otherwise an error is returned
+*                             by the \ref
 *                             readWfnFileAndAllocateChemicalSystem function.
 *
 * \return It returns one (respectively minus one) if the chemical data contained
-*         in the (copy *.temp of the) *.wfn file pointed by the fileLocation
-*         variable have been successfully loaded in the structure pointed by
+*         in the *.wfn file pointed by the fileLocation variable have been
+*         successfully loaded in the structure pointed by
 *         pChemicalSystem, and if the underlying chemical structure corresponds
 *         to a restricted (resp. unrestricted) Hartree-Fock one. In any other
 *         situation (i.e. if the input variables, including the syntax inside
@@ -245,8 +203,13 @@ int readAndConvertWfnFile(char* fileLocation, char charToRemove,
 *         displayed in the standard error stream and zero is returned by the
 *         \ref readWfnFileAndAllocateChemicalSystem function.
 *
-* The \ref readWfnFileAndAllocateChemicalSystem function should be static but
-* has been defined as non-static in order to perform unit-test on it.
+* The *.wfn file is the output of the Gaussian software, which is written in
+* Fortran, so that its scientific notation uses the 'D' symbol (1.0D+01). The
+* file is mapped into memory (see the \ref openMappedFile function) and such
+* numbers are directly read by the \ref scanDoubleInMappedFile function, so
+* the original *.wfn file is never copied nor altered. The \ref
+* readWfnFileAndAllocateChemicalSystem function should be static but has been
+* defined as non-static in order to perform unit-test on it.
 */
 int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
                                                ChemicalSystem* pChemicalSystem);
@@ -300,6 +263,199 @@ int readWfnFileAndAllocateChemicalSystem(char* fileLocation, int nameLength,
 int writingChemicalFile(char* fileLocation, int nameLength,
                                                ChemicalSystem* pChemicalSystem);
 
+/**
+* \fn size_t getSizeOfChemicalCacheFile(int numberOfNuclei,
+*                                        int numberOfPrimitives,
+*                                        int numberOfMolecularOrbitals)
+* \brief It evaluates the size (in bytes) of a binary chemical cache (*.chemb)
+*        file storing the given number of nuclei, primitives, and molecular
+*        orbitals.
+*
+* \param[in] numberOfNuclei The number of nuclei of the chemical system.
+*
+* \param[in] numberOfPrimitives The number of primitives used in the expansion
+*                               of each molecular orbital.
+*
+* \param[in] numberOfMolecularOrbitals The number of molecular orbitals of the
+*                                      chemical system.
+*
+* \return It returns the expected size of the *.chemb file.
+*
+* The *.chemb layout is made of a header of \ref CHEM_CACHE_HEADER bytes (magic
+* number MPDCHEMB, version, orb_rhf, hash of the chemical file, and the three
+* dimensions) followed by the nucleus coordinates and charges, the spins of the
+* molecular orbitals, their coefficients and exponents, and finally their center
+* and type assignments. Each block starts at a multiple of 8 bytes so that the
+* file can be used directly once mapped into memory.
+*/
+size_t getSizeOfChemicalCacheFile(int numberOfNuclei, int numberOfPrimitives,
+                                                 int numberOfMolecularOrbitals);
+
+/**
+* \fn int getChemicalCacheLocation(char* fileLocation, int nameLength,
+*                                                           char* cacheLocation)
+* \brief It builds the path name of the binary chemical cache (*.chemb)
+*        associated with the *.chem or *.wfn file located at fileLocation.
+*
+* The cache is named after the chemical file (including its extension so that
+* e.g. h2.chem and h2.wfn get two different caches) followed by the 64-bit
+* FNV-1a hash of its absolute path written in hexadecimal (so that two files of
+* the same name in different directories get two different caches, e.g.
+* h2.wfn.0123456789abcdef.chemb). It is placed in the directory given by the
+* environment variable \ref CHEM_CACHE_DIRECTORY if it is set, otherwise in the
+* current working directory (and never next to the input file).
+*
+* \param[in] fileLocation A pointer that points to a string that is intended to
+*                         store the path name of an existing *.chem or *.wfn
+*                         file, of length (strictly) less than nameLength.
+*
+* \param[in] nameLength A positive integer representing the maximal length
+*                       allowed for the fileLocation and cacheLocation names
+*                       (including the terminating nul character '\0').
+*
+* \param[out] cacheLocation A pointer that points to an array of (at least)
+*                           nameLength characters, intended to store the path
+*                           name of the cache, made of the cache directory and
+*                           of the file name of fileLocation followed by the
+*                           hash of its absolute path and the *.chemb
+*                           extension.
+*
+* \return It returns one if the cache name has been successfully built.
+*         Otherwise (too long name, unresolved absolute path or invalid input
+*         variables), zero is returned by the \ref getChemicalCacheLocation
+*         function.
+*/
+int getChemicalCacheLocation(char* fileLocation, int nameLength,
+                                                           char* cacheLocation);
+
+/**
+* \fn int readChemicalCacheFile(char* fileLocation, int nameLength,
+*                 unsigned long long hashValue, ChemicalSystem* pChemicalSystem)
+* \brief It loads the chemical data stored in the binary cache (*.chemb) located
+*        at fileLocation in the structure pointed by pChemicalSystem, provided
+*        that the cache has been built from a chemical file whose content has
+*        the hashValue hash.
+*
+* \param[in] fileLocation A pointer that points to a string that is intended to
+*                         store the path name of the *.chemb file.
+*
+* \param[in] nameLength A positive integer representing the maximal length
+*                       allowed for the name pointed by the fileLocation
+*                       variable (including the terminating nul character '\0').
+*
+* \param[in] hashValue The hash of the *.chem or *.wfn file content (see the
+*                      \ref computeHashOfFile function).
+*
+* \param[out] pChemicalSystem A pointer that points to the ChemicalSystem
+*                             structure (defined in main.h file) of the \ref
+*                             main function, which is intended to be allocated
+*                             and filled with the cached values.
+*
+* \return It returns one (respectively minus one) if the cached data have been
+*         successfully loaded and correspond to a restricted (resp.
+*         unrestricted) Hartree-Fock chemical structure. It returns zero if the
+*         cache does not exist, has been built with another \ref
+*         CHEM_CACHE_VERSION or from another file content, or does not store
+*         valid data (the structure pointed by pChemicalSystem is then left
+*         empty so that the chemical file can be parsed instead).
+*
+* The *.chemb file is read through the \ref openMappedFile function and each
+* block is copied with a single memcpy, which makes the loading of a chemical
+* system essentially free compared with the parsing of the *.wfn file.
+*/
+int readChemicalCacheFile(char* fileLocation, int nameLength,
+                 unsigned long long hashValue, ChemicalSystem* pChemicalSystem);
+
+/**
+* \fn int writingChemicalCacheFile(char* fileLocation, int nameLength,
+*                                      unsigned long long hashValue, int orbRhf,
+*                                               ChemicalSystem* pChemicalSystem)
+* \brief It writes the content of the structure pointed by pChemicalSystem in
+*        the binary cache (*.chemb) located at fileLocation.
+*
+* \param[in] fileLocation A pointer that points to a string that is intended to
+*                         store the path name of the *.chemb file (created if
+*                         it does not exist, overwritten otherwise).
+*
+* \param[in] nameLength A positive integer representing the maximal length
+*                       allowed for the name pointed by the fileLocation
+*                       variable (including the terminating nul character '\0').
+*
+* \param[in] hashValue The hash of the *.chem or *.wfn file content from which
+*                      the data of the structure pointed by pChemicalSystem
+*                      have been loaded.
+*
+* \param[in] orbRhf It must be one (respectively minus one) if the chemical
+*                   structure is a restricted (resp. unrestricted) Hartree-Fock
+*                   one.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure (defined in main.h file) of the \ref main
+*                            function, whose content is saved in the cache.
+*
+* \return It returns one if the *.chemb file has been successfully written.
+*         Otherwise, an error is displayed in the standard error stream and zero
+*         is returned by the \ref writingChemicalCacheFile function.
+*
+* The data are first written in a temporary file (fileLocation followed by the
+* process identifier and the '~' character) which is then renamed, so that MPD
+* runs sharing the same chemical file never read a partially written cache nor
+* write into the same temporary file.
+*/
+int writingChemicalCacheFile(char* fileLocation, int nameLength,
+                                      unsigned long long hashValue, int orbRhf,
+                                               ChemicalSystem* pChemicalSystem);
+
+/**
+* \fn int readChemicalFileOrCache(char* fileLocation, int nameLength,
+*                           int chemicalFormat, ChemicalSystem* pChemicalSystem,
+*                                                                int* pCacheHit)
+* \brief It loads the chemical data of the *.chem or *.wfn file located at
+*        fileLocation in the structure pointed by pChemicalSystem, using its
+*        binary cache (*.chemb) whenever it is up to date.
+*
+* \param[in] fileLocation A pointer that points to a string that is intended to
+*                         store the path name of an existing *.chem or *.wfn
+*                         file, of length (strictly) less than nameLength.
+*
+* \param[in] nameLength A positive integer representing the maximal length
+*                       allowed for the name pointed by the fileLocation
+*                       variable (including the terminating nul character '\0').
+*
+* \param[in] chemicalFormat It must be one for a *.chem file and minus one for
+*                           a *.wfn file (see the \ref getChemicalFormat
+*                           function).
+*
+* \param[out] pChemicalSystem A pointer that points to the ChemicalSystem
+*                             structure (defined in main.h file) of the \ref
+*                             main function, intended to be filled with the
+*                             chemical data.
+*
+* \param[out] pCacheHit A pointer that points to an integer set to one if the
+*                       chemical data have been loaded from the cache, zero
+*                       otherwise (it is ignored if it points to NULL).
+*
+* \return It returns one (respectively minus one) if the chemical data have been
+*         successfully loaded and correspond to a restricted (resp.
+*         unrestricted) Hartree-Fock chemical structure. Otherwise, an error is
+*         displayed in the standard error stream and zero is returned by the
+*         \ref readChemicalFileOrCache function.
+*
+* The cache is stored in the directory given by \ref getChemicalCacheLocation
+* (file name of the chemical file followed by the hash of its absolute path
+* and the *.chemb extension) and is
+* identified by the hash of the chemical file content, so that all the MPD
+* runs performed on the same molecule (in the same cache directory) share it
+* and that any modification of the chemical file automatically invalidates it.
+* If the cache is missing or outdated, the chemical file is parsed by the \ref
+* readChemFileandAllocateChemicalSystem or \ref
+* readWfnFileAndAllocateChemicalSystem function and the cache is rebuilt (a
+* failure at this step only produces a warning).
+*/
+int readChemicalFileOrCache(char* fileLocation, int nameLength,
+                            int chemicalFormat, ChemicalSystem* pChemicalSystem,
+                                                                int* pCacheHit);
+
 /**
 * \fn int loadChemistry(Parameters* pParameters,
 *                                               ChemicalSystem* pChemicalSystem)
@@ -328,7 +484,10 @@ int writingChemicalFile(char* fileLocation, int nameLength,
 * structure associated with the \ref main funtion and pointed by pParameters,
 * in order to initialize all the (double/integer) variables of the
 * ChemicalSystem structure of the \ref main function, pointed by the
-* pChemicalSystem variable.
+* pChemicalSystem variable. A *.wfn file is converted into the *.chem file
+* named after the *.info file, except if its data have been loaded from the
+* binary cache and if this *.chem file exists and is not older than the *.wfn
+* file (in order to skip the writing of the *.chem file at each run).
 */
 int loadChemistry(Parameters* pParameters, ChemicalSystem *pChemicalSystem);
 
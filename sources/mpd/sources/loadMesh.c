@@ -97,6 +97,171 @@ void freeMeshMemory(Mesh* pMesh)
     return;
 }
 
+/* ************************************************************************** */
+// The function copyMeshStructure performs a deep copy of the Mesh structure
+// pointed by pMesh into the one pointed by pMeshCopy (whose previous content
+// is overwritten without being freed). Every array that is not pointing to
+// NULL in pMesh is duplicated with malloc/memcpy so that the copy can be used
+// independently of the original (e.g. by the background thread writing the
+// snapshots of the optimization loop). It has the two Mesh* variables (defined
+// in main.h) as input arguments and it returns one on success, otherwise zero
+// (and the memory allocated for pMeshCopy is then freed up)
+/* ************************************************************************** */
+int copyMeshStructure(Mesh* pMesh, Mesh* pMeshCopy)
+{
+    // Check the input pointers
+    if (pMesh==NULL || pMeshCopy==NULL)
+    {
+        PRINT_ERROR("In copyMeshStructure: at least one of the input ");
+        fprintf(stderr,"variables (pMesh=%p, pMeshCopy=%p) ",(void*)pMesh,
+                                                              (void*)pMeshCopy);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
+
+    // Copy the sizes (pointers are reset to NULL until their array is copied,
+    // so that freeMeshMemory can be safely called on pMeshCopy at any time)
+    *pMeshCopy=*pMesh;
+    pMeshCopy->pver=NULL;
+    pMeshCopy->pnorm=NULL;
+    pMeshCopy->ptan=NULL;
+    pMeshCopy->pedg=NULL;
+    pMeshCopy->ptri=NULL;
+    pMeshCopy->ptet=NULL;
+    pMeshCopy->pqua=NULL;
+    pMeshCopy->phex=NULL;
+    pMeshCopy->padj=NULL;
+
+    if (pMesh->pver!=NULL && pMesh->nver>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->pver=(Point*)malloc(pMesh->nver*sizeof(Point));
+        if (pMeshCopy->pver==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the pver variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->pver,pMesh->pver,pMesh->nver*sizeof(Point));
+    }
+
+    if (pMesh->pnorm!=NULL && pMesh->nnorm>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->pnorm=(Vector*)malloc(pMesh->nnorm*sizeof(Vector));
+        if (pMeshCopy->pnorm==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the pnorm variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->pnorm,pMesh->pnorm,pMesh->nnorm*sizeof(Vector));
+    }
+
+    if (pMesh->ptan!=NULL && pMesh->ntan>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->ptan=(Vector*)malloc(pMesh->ntan*sizeof(Vector));
+        if (pMeshCopy->ptan==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the ptan variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->ptan,pMesh->ptan,pMesh->ntan*sizeof(Vector));
+    }
+
+    if (pMesh->pedg!=NULL && pMesh->nedg>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->pedg=(Edge*)malloc(pMesh->nedg*sizeof(Edge));
+        if (pMeshCopy->pedg==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the pedg variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->pedg,pMesh->pedg,pMesh->nedg*sizeof(Edge));
+    }
+
+    if (pMesh->ptri!=NULL && pMesh->ntri>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->ptri=(Triangle*)malloc(pMesh->ntri*sizeof(Triangle));
+        if (pMeshCopy->ptri==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the ptri variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->ptri,pMesh->ptri,pMesh->ntri*sizeof(Triangle));
+    }
+
+    if (pMesh->ptet!=NULL && pMesh->ntet>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->ptet=(Tetrahedron*)malloc(pMesh->ntet*sizeof(Tetrahedron));
+        if (pMeshCopy->ptet==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the ptet variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->ptet,pMesh->ptet,pMesh->ntet*sizeof(Tetrahedron));
+    }
+
+    if (pMesh->pqua!=NULL && pMesh->nqua>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->pqua=(Quadrilateral*)malloc(pMesh->nqua*
+                                                         sizeof(Quadrilateral));
+        if (pMeshCopy->pqua==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the pqua variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->pqua,pMesh->pqua,pMesh->nqua*sizeof(Quadrilateral));
+    }
+
+    if (pMesh->phex!=NULL && pMesh->nhex>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->phex=(Hexahedron*)malloc(pMesh->nhex*sizeof(Hexahedron));
+        if (pMeshCopy->phex==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the phex variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->phex,pMesh->phex,pMesh->nhex*sizeof(Hexahedron));
+    }
+
+    if (pMesh->padj!=NULL && pMesh->nadj>0)
+    {
+        // malloc function returns a pointer to allocated memory, otherwise NULL
+        pMeshCopy->padj=(Adjacency*)malloc(pMesh->nadj*sizeof(Adjacency));
+        if (pMeshCopy->padj==NULL)
+        {
+            PRINT_ERROR("In copyMeshStructure: could not allocate memory ");
+            fprintf(stderr,"for the padj variable of the copy.\n");
+            freeMeshMemory(pMeshCopy);
+            return 0;
+        }
+        memcpy(pMeshCopy->padj,pMesh->padj,pMesh->nadj*sizeof(Adjacency));
+    }
+
+    return 1;
+}
+
 /* ************************************************************************** */
 // The function initializeCubeDiscretization loads some default parameters in
 // the structure pointed by pParameters in order to initialize the meshing of
@@ -542,6 +707,41 @@ int labelPoint(int i, int j, int k, int nX, int nY, int nZ)
     return returnValue;
 }
 
+/* ************************************************************************** */
+// The function getHexahedronVertices computes the references of the eight
+// vertices of the l-th hexahedron of the structured grid used when opt_mode is
+// not positive, the hexahedra and their vertices being respectively ordered as
+// l=(i*(nY-1)+j)*(nZ-1)+k and 1+(a*nY+b)*nZ+c (see the meshCube function). It
+// has the hexahedron index l, the number of points nY and nZ in the second and
+// third coordinate directions, and the int[8] pVertex array, where the point
+// references (as in *.mesh files, i.e. starting from one) are stored, as input
+// arguments. It does not return any value (void output). Warning here: be sure
+// that l lies between 0 and (nX-1)*(nY-1)*(nZ-1)-1 before using this function
+/* ************************************************************************** */
+void getHexahedronVertices(int l, int nY, int nZ, int pVertex[8])
+{
+    int i=0, j=0, k=0;
+
+    k=l%(nZ-1);
+    l/=(nZ-1);
+    j=l%(nY-1);
+    i=l/(nY-1);
+
+    // Point reference (a,b,c) in a cube cell: 1=(i,j,k); 2=(i+1,j,k);
+    // 3=(i+1,j+1,k); 4=(i,j+1,k); 5=(i,j,k+1); 6=(i+1,j,k+1); 7=(i+1,j+1,k+1)
+    // 8=(i,j+1,k+1)
+    pVertex[0]=1+(i*nY+j)*nZ+k;
+    pVertex[1]=pVertex[0]+nY*nZ;
+    pVertex[2]=pVertex[1]+nZ;
+    pVertex[3]=pVertex[0]+nZ;
+    pVertex[4]=pVertex[0]+1;
+    pVertex[5]=pVertex[1]+1;
+    pVertex[6]=pVertex[2]+1;
+    pVertex[7]=pVertex[3]+1;
+
+    return;
+}
+
 /* ************************************************************************** */
 // The function meshCube fills the structure pointed by pMesh, whose memory
 // has already been allocated thanks to the allocateInitialMeshMemory function
@@ -688,7 +888,8 @@ int meshCube(Parameters* pParameters, Mesh* pMesh)
         // saved as 1+(a*nY+b)*nZ+c a=0...nX-1, b=0...nY-1, c=0...nZ-1
         // Point reference (a,b,c) in a cube cell: 1=(i-1,j-1,k-1);
         // 2=(i,j-1,k-1); 3=(i,j,k-1); 4=(i-1,j,k-1); 5=(i-1,j-1,k); 6=(i,j-1,k)
-        // 7=(i,j,k); 8=(i-1,j,k); i=1...nX-1, j=1...nY-1, k=1...nZ-1
+        // 7=(i,j,k); 8=(i-1,j,k); i=1...nX-1, j=1...nY-1, k=1...nZ-1. These
+        // references are not stored but recovered with getHexahedronVertices
         if (pParameters->verbose)
         {
             fprintf(stdout,"Saving hexahedra. ");
@@ -710,14 +911,6 @@ int meshCube(Parameters* pParameters, Mesh* pMesh)
             {
                 for (k=1; k<nZ; k++)
                 {
-                    pMesh->phex[counter].p1=1+((i-1)*nY+(j-1))*nZ+(k-1);
-                    pMesh->phex[counter].p2=1+(i*nY+(j-1))*nZ+(k-1);
-                    pMesh->phex[counter].p3=1+(i*nY+j)*nZ+(k-1);
-                    pMesh->phex[counter].p4=1+((i-1)*nY+j)*nZ+(k-1);
-                    pMesh->phex[counter].p5=1+((i-1)*nY+(j-1))*nZ+k;
-                    pMesh->phex[counter].p6=1+(i*nY+(j-1))*nZ+k;
-                    pMesh->phex[counter].p7=1+(i*nY+j)*nZ+k;
-                    pMesh->phex[counter].p8=1+((i-1)*nY+j)*nZ+k;
                     pMesh->phex[counter].label=0;
                     counter++;
                 }
@@ -1388,7 +1581,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
 {
     size_t lengthName=0;
     char *fileLocation=NULL;
-    int i=0, iMax=0;
+    int i=0, iMax=0, pHexahedronVertex[8]={0};
     double delta=0.;
     FILE *meshFile=NULL;
 
@@ -1400,6 +1593,9 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
     Quadrilateral *pQuadrilateral=NULL;
     Hexahedron *pHexahedron=NULL;
 
+    // Time the writing of the mesh in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_IO);
+
     // Check if the input variables are not pointing to NULL
     if (pParameters==NULL || pMesh==NULL)
     {
@@ -1407,6 +1603,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"(pParameters=%p, ",(void*)pParameters);
         fprintf(stderr,"pMesh=%p) does not have a valid ",(void*)pMesh);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -1435,6 +1632,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"pMesh->ptri=%p\n",(void*)pMesh->ptri);
             fprintf(stderr,"pMesh->ptet=%p\n",(void*)pMesh->ptet);
             fprintf(stderr,"does not have a valid allocated adress.\n");
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
     }
@@ -1447,6 +1645,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"pMesh->pqua=%p\n",(void*)pMesh->pqua);
             fprintf(stderr,"pMesh->phex=%p\n",(void*)pMesh->phex);
             fprintf(stderr,"does not have a valid allocated adress.\n");
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
     }
@@ -1459,6 +1658,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"pointed by pParameters must be an integer (strictly) ");
         fprintf(stderr,"greater than six (to store at least something more ");
         fprintf(stderr,"than the *.mesh extension).\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -1470,6 +1670,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
     {
         PRINT_ERROR("In writingMeshFile: could not allocate memory for the ");
         fprintf(stderr,"char* fileLocation (local) variable.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -1484,6 +1685,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"the char* pParameters->name_mesh variable.\n");
             free(fileLocation); // free function does not return any value
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1501,6 +1703,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"than the *.info extension).\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1519,6 +1722,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"end with with the '.info' extension.\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1552,6 +1756,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"than the *.mesh or *.cube extension).\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1594,6 +1799,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"with with the '.mesh' or '.cube' extension.\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
     }
@@ -1624,7 +1830,10 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
 
     // Opening *.mesh file (warning: reset and overwrite file if already exists)
     // fopen returns a FILE pointer on success, otherwise NULL is returned
-    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    if (pParameters->verbose>=0)
+    {
+        fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    }
     meshFile=fopen(fileLocation,"w+");
     if (meshFile==NULL)
     {
@@ -1632,9 +1841,13 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"into the %s file",fileLocation);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
-    fprintf(stdout,"Writing mesh data. ");
+    if (pParameters->verbose>=0)
+    {
+        fprintf(stdout,"Writing mesh data. ");
+    }
 
     // Writing *.mesh file starting by Vertices
     fprintf(meshFile,"MeshVersionFormatted 2\n\nDimension 3\n");
@@ -1649,6 +1862,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
         closeTheFile(&meshFile);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -1674,6 +1888,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+           endProfilerPhase(&globalProfiler,PROF_IO);
            return 0;
         }
         fprintf(meshFile,"%.8le %.8le ",pVertex->x,pVertex->y);
@@ -1701,6 +1916,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1723,6 +1939,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1745,6 +1962,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1759,6 +1977,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1776,6 +1995,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1802,6 +2022,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
                 closeTheFile(&meshFile);
                 free(fileLocation);
                 fileLocation=NULL;
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
             fprintf(meshFile,"%d %d ",pQuadrilateral->p1,pQuadrilateral->p2);
@@ -1820,6 +2041,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1827,36 +2049,16 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
         for (i=0; i<iMax; i++)
         {
             pHexahedron=&pMesh->phex[i];
-            if (pHexahedron->p1<1 || pHexahedron->p1>pMesh->nver ||
-                             pHexahedron->p2<1 || pHexahedron->p2>pMesh->nver ||
-                             pHexahedron->p3<1 || pHexahedron->p3>pMesh->nver ||
-                             pHexahedron->p4<1 || pHexahedron->p4>pMesh->nver ||
-                             pHexahedron->p5<1 || pHexahedron->p5>pMesh->nver ||
-                             pHexahedron->p6<1 || pHexahedron->p6>pMesh->nver ||
-                             pHexahedron->p7<1 || pHexahedron->p7>pMesh->nver ||
-                               pHexahedron->p8<1 || pHexahedron->p8>pMesh->nver)
-            {
-                PRINT_ERROR("In writingMeshFile: the point references ");
-                fprintf(stderr,"(%d,%d,",pHexahedron->p1,pHexahedron->p2);
-                fprintf(stderr,"(%d,%d,",pHexahedron->p3,pHexahedron->p4);
-                fprintf(stderr,"(%d,%d,",pHexahedron->p5,pHexahedron->p6);
-                fprintf(stderr,"%d,%d) ",pHexahedron->p7,pHexahedron->p8);
-                fprintf(stderr,"associated with the vertices of the ");
-                fprintf(stderr,"%d-th hexahedron must be positive ",i+1);
-                fprintf(stderr,"integers not (strictly) greater than the ");
-                fprintf(stderr,"total number of vertices %d ",pMesh->nver);
-                fprintf(stderr,"related to the mesh discretization stored ");
-                fprintf(stderr,"in the structure pointed by pMesh.\n");
-                fprintf(meshFile,"\nEnd");
-                closeTheFile(&meshFile);
-                free(fileLocation);
-                fileLocation=NULL;
-                return 0;
-            }
-            fprintf(meshFile,"%d %d ",pHexahedron->p1,pHexahedron->p2);
-            fprintf(meshFile,"%d %d ",pHexahedron->p3,pHexahedron->p4);
-            fprintf(meshFile,"%d %d ",pHexahedron->p5,pHexahedron->p6);
-            fprintf(meshFile,"%d %d ",pHexahedron->p7,pHexahedron->p8);
+            getHexahedronVertices(i,pParameters->n_y,pParameters->n_z,
+                                                             pHexahedronVertex);
+            fprintf(meshFile,"%d ",pHexahedronVertex[0]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[1]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[2]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[3]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[4]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[5]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[6]);
+            fprintf(meshFile,"%d ",pHexahedronVertex[7]);
 
             // Change the negative label into their previous value
             if (pHexahedron->label==-3)
@@ -1910,6 +2112,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1934,6 +2137,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
                 closeTheFile(&meshFile);
                 free(fileLocation);
                 fileLocation=NULL;
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
             fprintf(meshFile,"%d %d ",pTriangle->p1,pTriangle->p2);
@@ -1951,6 +2155,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -1975,6 +2180,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
                     closeTheFile(&meshFile);
                     free(fileLocation);
                     fileLocation=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 fprintf(meshFile,"%d %d ",pEdge->p1,pEdge->p2);
@@ -1999,11 +2205,12 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
         else if (iMax!=8)
         {
-            if (pParameters->verbose)
+            if (pParameters->verbose>0)
             {
                 fprintf(stdout,"\nWarning in writingMeshFile function: the ");
                 fprintf(stdout,"number of corners should be 8 (corresponding ");
@@ -2057,6 +2264,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -2082,6 +2290,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
                 closeTheFile(&meshFile);
                 free(fileLocation);
                 fileLocation=NULL;
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
             fprintf(meshFile,"%d %d ",pTetrahedron->p1,pTetrahedron->p2);
@@ -2100,6 +2309,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -2131,6 +2341,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
                     closeTheFile(&meshFile);
                     free(fileLocation);
                     fileLocation=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 fprintf(meshFile,"%d %d \n",pNormal->p,i+1);
@@ -2148,6 +2359,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
             closeTheFile(&meshFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -2172,6 +2384,7 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
                     closeTheFile(&meshFile);
                     free(fileLocation);
                     fileLocation=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 fprintf(meshFile,"%.8le %.8le ",pTangent->x,pTangent->y);
@@ -2187,6 +2400,9 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
     }
     fprintf(meshFile,"\nEnd");
 
+    // Count the written bytes in the profiler before closing the file
+    addProfilerBytes(&globalProfiler,0.,(double)ftell(meshFile));
+
     // Closing the *.mesh file: fclose function returns zero if the input FILE*
     // variable is successfully closed, otherwise EOF (end-of-file) is returned
     if (fclose(meshFile))
@@ -2196,15 +2412,21 @@ int writingMeshFile(Parameters* pParameters, Mesh* pMesh)
         meshFile=NULL;
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
     meshFile=NULL;
-    fprintf(stdout,"Closing file.\n");
+    if (pParameters->verbose>=0)
+    {
+        fprintf(stdout,"Closing file.\n");
+    }
 
     // Free the memory dynamically allocated for fileLocation
     free(fileLocation);
     fileLocation=NULL;
 
+    endProfilerPhase(&globalProfiler,PROF_IO);
+
     return 1;
 }
 
@@ -2290,9 +2512,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
 {
     size_t length=0;
     char readStringIn[21]={'\0'}, *readStringOut=NULL, keyword[4]={'\0'};
-    int readIntegerIn=0, readIntegerOut=0, i=0, j=0, k=0;
+    int readIntegerIn=0, readIntegerOut=0, i=0, j=0, k=0, nY=0, nZ=0;
+    int pVertexRead[8]={0}, pVertex[8]={0};
     double readDouble=0.;
-    FILE *meshFile=NULL;
+    MappedFile meshFile={NULL,0,0};
+
+    // Time the reading of the mesh in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_IO);
 
     // Check if the input variables are not pointing to NULL
     if (pParameters==NULL || pMesh==NULL)
@@ -2301,6 +2527,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"variables (pParameters=%p, ",(void*)pParameters);
         fprintf(stderr,"pMesh=%p) does not have a valid ",(void*)pMesh);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -2313,20 +2540,22 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         PRINT_ERROR("In readMeshFileAndAllocateMesh: getMeshFormat function ");
         fprintf(stderr,"did not return one, which was the expected value ");
         fprintf(stderr,"here.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    // Opening *.mesh file (warning: reset and overwrite file if already exists)
-    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    // Map the content of the *.mesh file into memory: openMappedFile returns
+    // one on success, otherwise zero is returned
     if (pParameters->opt_mode!=1 || pParameters->verbose)
     {
         fprintf(stdout,"\nOpening %s file. ",pParameters->name_mesh);
     }
-    meshFile=fopen(pParameters->name_mesh,"r");
-    if (meshFile==NULL)
+    if (!openMappedFile(pParameters->name_mesh,pParameters->name_length,
+                                                                     &meshFile))
     {
         PRINT_ERROR("In readMeshFileAndAllocateMesh: we were not able to ");
         fprintf(stderr,"read the %s file.\n",pParameters->name_mesh);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
     if (pParameters->opt_mode!=1 || pParameters->verbose)
@@ -2336,27 +2565,25 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
 
     // Read the precision (expecting MeshVersionFormatted 2): in general
     // 1=single, 2=double, MeshVersionUnformatted for binary (.meshb) file
-    // (not considered here). We recall that fgets returns a null pointer if it
-    // failed, otherwise it returns the same readStringIn parameters while
-    // fscanf function returns the number of input items successfully matched
-    // and assigned, which can be fewer than provided for. Important remark:
-    //  white space characters, such as blanks and newline characters, causes
-    // fscanf (scanf and sscanf) to read, but not to store, all consecutive
-    // white space characters in the input up to the next character that is not
-    // white space. One white space character in format-string matches any
-    // combination of white space characters in the input.
-    readStringOut=fgets(readStringIn,21,meshFile);
-    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+    // (not considered here). We recall that getStringInMappedFile returns a
+    // null pointer if it failed, otherwise it returns the same readStringIn
+    // parameters while scanIntegerInMappedFile returns one if an integer has
+    // been read (it behaves like the fscanf(" %d ") c-function, i.e. all the
+    // consecutive white space characters surrounding the integer are skipped)
+    readStringOut=getStringInMappedFile(readStringIn,21,&meshFile);
+    readIntegerOut=scanIntegerInMappedFile(&meshFile,&readIntegerIn);
 
     // strcmp returns 0 if the two strings are equal, otherwise <0 (resp. >0)
     // if the 1st string argument is shorter (resp. longer) than the 2nd one
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong return of the ");
-        fprintf(stderr,"standard fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) c-function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the precision of the value in the mesh file.\n");
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -2365,21 +2592,24 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         PRINT_ERROR("In readMeshFileAndAllocateMesh: expecting ");
         fprintf(stderr,"MeshVersionFormatted 2 instead of %s ",readStringIn);
         fprintf(stderr,"%d.\n",readIntegerIn);
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
     // Readthe space dimension (expecting Dimension 3)
-    readStringOut=fgets(readStringIn,10,meshFile);
-    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,10,&meshFile);
+    readIntegerOut=scanIntegerInMappedFile(&meshFile,&readIntegerIn);
 
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong return of the ");
-        fprintf(stderr,"standard fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) c-function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the dimension of the mesh discretization.\n");
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -2387,7 +2617,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     {
         PRINT_ERROR("In readMeshFileAndAllocateMesh: expecting Dimension 3 ");
         fprintf(stderr,"instead of %s %d.\n",readStringIn,readIntegerIn);
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -2395,16 +2626,18 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     // that the keyword Vertices appears first (i.e. just after the dimension in
     // the *.mesh file so as to be able to check then the validity of integers
     // referring to the vertex positions of the element vertices in the mesh
-    readStringOut=fgets(readStringIn,9,meshFile);
-    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,9,&meshFile);
+    readIntegerOut=scanIntegerInMappedFile(&meshFile,&readIntegerIn);
 
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong return of the ");
-        fprintf(stderr,"standard fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) c-function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the total number of vertices in the mesh.\n");
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -2413,7 +2646,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         PRINT_ERROR("In readMeshFileAndAllocateMesh: expecting Vertices Nver ");
         fprintf(stderr,"instead of %s %d ",readStringIn,readIntegerIn);
         fprintf(stderr,"(a positive integer value).\n");
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
     pMesh->nver=readIntegerIn;
@@ -2427,7 +2661,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         PRINT_ERROR("In readMeshFileAndAllocateMesh: could not allocate ");
         fprintf(stderr,"memory for %d vertices in the ",readIntegerIn);
         fprintf(stderr,"structure pointed by pMesh.\n");
-        closeTheFile(&meshFile);
+        closeMappedFile(&meshFile);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -2435,16 +2670,16 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     for (k=0; k<readIntegerIn; k++)
     {
         j=0;
-        j+=fscanf(meshFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
         pMesh->pver[k].x=readDouble;
 
-        j+=fscanf(meshFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
         pMesh->pver[k].y=readDouble;
 
-        j+=fscanf(meshFile,"%lf ",&readDouble);
+        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
         pMesh->pver[k].z=readDouble;
 
-        j+=fscanf(meshFile,"%d ",&readIntegerOut);
+        j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
         pMesh->pver[k].label=readIntegerOut;
 
         pMesh->pver[k].value=0.;
@@ -2454,7 +2689,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"to properly save the Point data associated with ");
             fprintf(stderr,"with the %d-th vertex of the mesh (only %d ",k+1,j);
             fprintf(stderr,"values properly saved instead of four).\n");
-            closeTheFile(&meshFile);
+            closeMappedFile(&meshFile);
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
     }
@@ -2465,15 +2701,17 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         // Read 3 letters and study the different cases until the End keyword
         i=0;
         do {
-            readStringOut=fgets(keyword,4,meshFile);
+            readStringOut=getStringInMappedFile(keyword,4,&meshFile);
             if (readStringOut==NULL)
             {
                 PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong return ");
                 fprintf(stderr,"%p of the standard ",(void*)readStringOut);
-                fprintf(stderr,"fgets c-function while attempting to read ");
+                fprintf(stderr,"getStringInMappedFile function while ");
+                fprintf(stderr,"attempting to read ");
                 fprintf(stderr,"the first three letters of a *.mesh-format ");
                 fprintf(stderr,"keyword.\n");
-                closeTheFile(&meshFile);
+                closeMappedFile(&meshFile);
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
             i++;
@@ -2481,18 +2719,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             if (!strcmp(keyword,"Qua"))
             {
                 // Read the number of quadrilaterals and store it in pMesh->nqua
-                readStringOut=fgets(readStringIn,12,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,12,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"(boundary) quadrilaterals in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2502,7 +2743,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"Quadrilaterals Nqua instead of ");
                     fprintf(stderr,"Qua%s %d ",readStringIn,readIntegerIn);
                     fprintf(stderr,"(a positive integer value).\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 pMesh->nqua=readIntegerIn;
@@ -2517,7 +2759,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"allocate memory for %d ",readIntegerIn);
                     fprintf(stderr,"quadrilaterals in the structure pointed ");
                     fprintf(stderr,"by pMesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2525,7 +2768,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 for (k=0; k<readIntegerIn; k++)
                 {
                     j=0;
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2535,12 +2778,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->pqua[k].p1=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2550,12 +2794,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->pqua[k].p2=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2565,12 +2810,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->pqua[k].p3=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2580,12 +2826,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->pqua[k].p4=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     pMesh->pqua[k].label=readIntegerOut;
                     if (j!=5)
                     {
@@ -2595,7 +2842,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"with the %d-th vertex of the ",k+1);
                         fprintf(stderr,"mesh (only %d values properly ",j);
                         fprintf(stderr,"saved instead of five).\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -2603,18 +2851,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             else if (!strcmp(keyword,"Hex"))
             {
                 // Read the number of Hexahedra and store it in pMesh->nhex
-                readStringOut=fgets(readStringIn,7,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,7,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"hexahedra in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2624,7 +2875,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"Hexahedra Nhex instead of ");
                     fprintf(stderr,"Hex%s %d ",readStringIn,readIntegerIn);
                     fprintf(stderr,"(a positive integer value).\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 pMesh->nhex=readIntegerIn;
@@ -2638,7 +2890,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"allocate memory for %d ",readIntegerIn);
                     fprintf(stderr,"hexahedra in the structure pointed ");
                     fprintf(stderr,"by pMesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2646,7 +2899,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 for (k=0; k<readIntegerIn; k++)
                 {
                     j=0;
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2656,12 +2909,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p1=readIntegerOut;
+                    pVertexRead[0]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2671,12 +2925,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p2=readIntegerOut;
+                    pVertexRead[1]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2686,12 +2941,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p3=readIntegerOut;
+                    pVertexRead[2]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2701,12 +2957,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p4=readIntegerOut;
+                    pVertexRead[3]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2716,12 +2973,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p5=readIntegerOut;
+                    pVertexRead[4]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2731,12 +2989,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p6=readIntegerOut;
+                    pVertexRead[5]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2746,12 +3005,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p7=readIntegerOut;
+                    pVertexRead[6]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2761,12 +3021,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
-                    pMesh->phex[k].p8=readIntegerOut;
+                    pVertexRead[7]=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     pMesh->phex[k].label=readIntegerOut;
                     if (j!=9)
                     {
@@ -2776,10 +3037,71 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"with the %d-th vertex of the ",k+1);
                         fprintf(stderr,"mesh (only %d values properly ",j);
                         fprintf(stderr,"saved instead of nine).\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
+                        return 0;
+                    }
+
+                    // The vertices of the hexahedra are not stored but
+                    // recovered from the structured grid (getHexahedronVertices
+                    // function), whose sizes are deduced from the first one
+                    if (!k)
+                    {
+                        nZ=pVertexRead[3]-pVertexRead[0];
+                        nY=0;
+                        if (nZ>2 && (pVertexRead[1]-pVertexRead[0])%nZ==0)
+                        {
+                            nY=(pVertexRead[1]-pVertexRead[0])/nZ;
+                        }
+                    }
+                    if (nY>2)
+                    {
+                        getHexahedronVertices(k,nY,nZ,pVertex);
+                    }
+                    if (nY<3 || memcmp(pVertex,pVertexRead,8*sizeof(int)))
+                    {
+                        PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
+                        fprintf(stderr,"vertices (%d,%d,",pVertexRead[0],
+                                                                pVertexRead[1]);
+                        fprintf(stderr,"%d,%d,",pVertexRead[2],pVertexRead[3]);
+                        fprintf(stderr,"%d,%d,",pVertexRead[4],pVertexRead[5]);
+                        fprintf(stderr,"%d,%d) ",pVertexRead[6],pVertexRead[7]);
+                        fprintf(stderr,"of the %d-th hexahedron do not ",k+1);
+                        fprintf(stderr,"correspond to the ones of a ");
+                        fprintf(stderr,"structured grid ordered as the ones ");
+                        fprintf(stderr,"saved by the MPD program (the ");
+                        fprintf(stderr,"hexahedral meshes can only be ");
+                        fprintf(stderr,"structured grids when opt_mode is ");
+                        fprintf(stderr,"not positive).\n");
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
+
+                // Check that the hexahedra fill the whole grid of vertices
+                // and save its sizes in pParameters since writingMeshFile
+                // recovers the hexahedra from n_y and n_z (they are compared
+                // with the ones deduced from the vertex coordinates in the
+                // updateDiscretizationParameters function)
+                k=pMesh->nhex/((nY-1)*(nZ-1))+1;
+                if (pMesh->nhex!=(k-1)*(nY-1)*(nZ-1) || k<3 ||
+                                                       pMesh->nver!=k*nY*nZ)
+                {
+                    PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
+                    fprintf(stderr,"%d hexahedra and %d ",pMesh->nhex,
+                                                                  pMesh->nver);
+                    fprintf(stderr,"vertices of the mesh do not form a ");
+                    fprintf(stderr,"structured grid with %d points ",nY);
+                    fprintf(stderr,"in the second and %d in the third ",nZ);
+                    fprintf(stderr,"direction.\n");
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
+                    return 0;
+                }
+                pParameters->n_x=k;
+                pParameters->n_y=nY;
+                pParameters->n_z=nZ;
             }
             else if (!strcmp(keyword,"End"))
             {
@@ -2791,7 +3113,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 fprintf(stderr,"%d-th string read (=%s) does not ",i,keyword);
                 fprintf(stderr,"correspond to any known keyword in the ");
                 fprintf(stderr,"hexahedral mesh structure pointed by pMesh.\n");
-                closeTheFile(&meshFile);
+                closeMappedFile(&meshFile);
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
         } while (i<3);
@@ -2801,15 +3124,17 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         // Read 3 letters and study the different cases until the End keyword
         i=0;
         do {
-            readStringOut=fgets(keyword,4,meshFile);
+            readStringOut=getStringInMappedFile(keyword,4,&meshFile);
             if (readStringOut==NULL)
             {
                 PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong return ");
                 fprintf(stderr,"%p of the standard ",(void*)readStringOut);
-                fprintf(stderr,"fgets c-function while attempting to read ");
+                fprintf(stderr,"getStringInMappedFile function while ");
+                fprintf(stderr,"attempting to read ");
                 fprintf(stderr,"the first three letters of a *.mesh-format ");
                 fprintf(stderr,"keyword.\n");
-                closeTheFile(&meshFile);
+                closeMappedFile(&meshFile);
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
             i++;
@@ -2817,18 +3142,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             if (!strcmp(keyword,"Tri"))
             {
                 // Read the number of Triangles and store it in pMesh->ntri
-                readStringOut=fgets(readStringIn,7,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,7,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"triangles in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2838,7 +3166,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"Triangles Ntri instead of ");
                     fprintf(stderr,"Tri%s %d ",readStringIn,readIntegerIn);
                     fprintf(stderr,"(a positive integer value).\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 pMesh->ntri=readIntegerIn;
@@ -2852,7 +3181,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"allocate memory for %d ",readIntegerIn);
                     fprintf(stderr,"triangles in the structure pointed ");
                     fprintf(stderr,"by pMesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2860,7 +3190,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 for (k=0; k<readIntegerIn; k++)
                 {
                     j=0;
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2870,12 +3200,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptri[k].p1=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2885,12 +3216,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptri[k].p2=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2900,12 +3232,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptri[k].p3=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     pMesh->ptri[k].label=readIntegerOut;
                     if (j!=4)
                     {
@@ -2915,7 +3248,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"with the %d-th vertex of the ",k+1);
                         fprintf(stderr,"mesh (only %d values properly ",j);
                         fprintf(stderr,"saved instead of four).\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -2923,18 +3257,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             else if (!strcmp(keyword,"Edg"))
             {
                 // Read the number of edges and store it in pMesh->nedg
-                readStringOut=fgets(readStringIn,3,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,3,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"edges in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2944,7 +3281,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"Edges Nedg instead of ");
                     fprintf(stderr,"Edg%s %d ",readStringIn,readIntegerIn);
                     fprintf(stderr,"(a positive integer value).\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -2957,7 +3295,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"should not be different from the ");
                         fprintf(stderr,"number of edges (=%d) ",readIntegerIn);
                         fprintf(stderr,"in the mesh discretization.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -2974,7 +3313,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"not allocate memory for ");
                         fprintf(stderr,"%d edges in the ",readIntegerIn);
                         fprintf(stderr,"structure pointed by pMesh.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -2983,7 +3323,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 for (k=0; k<readIntegerIn; k++)
                 {
                     j=0;
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -2993,12 +3333,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->pedg[k].p1=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3008,12 +3349,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->pedg[k].p2=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     pMesh->pedg[k].label=readIntegerOut;
                     if (j!=3)
                     {
@@ -3023,7 +3365,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"with the %d-th vertex of the ",k+1);
                         fprintf(stderr,"mesh (only %d values properly ",j);
                         fprintf(stderr,"saved instead of three).\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -3031,18 +3374,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             else if (!strcmp(keyword,"Rid"))
             {
                 // Read the number of Ridges and store it in pMesh->nedg
-                readStringOut=fgets(readStringIn,4,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,4,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"ridges in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3052,7 +3398,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"Ridges Nri instead of ");
                     fprintf(stderr,"Rid%s %d ",readStringIn,readIntegerIn);
                     fprintf(stderr,"(a positive integer value).\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3065,7 +3412,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"should not be different from the ");
                         fprintf(stderr,"number of ridges (=%d) ",readIntegerIn);
                         fprintf(stderr,"in the mesh discretization.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -3082,7 +3430,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"not allocate memory for ");
                         fprintf(stderr,"%d ridges in the ",readIntegerIn);
                         fprintf(stderr,"structure pointed by pMesh.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -3090,15 +3439,17 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 // Checking if the ridges are well stored in increasing order
                 for (k=0; k<readIntegerIn; k++)
                 {
-                    j=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (j!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                         fprintf(stderr,"return (=%d) of the standard ",j);
-                        fprintf(stderr,"fscanf c-function in the attempt of ");
+                        fprintf(stderr,"scan*InMappedFile function in the ");
+                        fprintf(stderr,"attempt of ");
                         fprintf(stderr,"reading the %d-th ridge of the ",k+1);
                         fprintf(stderr,"mesh discretization.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     if (readIntegerOut!=k+1)
@@ -3127,18 +3478,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             else if (!strcmp(keyword,"Cor"))
             {
                 // Read the number of Corners and store it in pMesh->ncor
-                readStringOut=fgets(readStringIn,5,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,5,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"corners in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3151,7 +3505,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"(a positive integer value that cannot be ");
                     fprintf(stderr,"(strictly) greater than the total number ");
                     fprintf(stderr,"of points %d in the mesh).\n",pMesh->nver);
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3177,15 +3532,17 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 // Check the number of corners by scanning all the values
                 for (k=0; k<readIntegerIn; k++)
                 {
-                    j=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (j!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                         fprintf(stderr,"return (=%d) of the standard ",j);
-                        fprintf(stderr,"fscanf c-function in the attempt of ");
+                        fprintf(stderr,"scan*InMappedFile function in the ");
+                        fprintf(stderr,"attempt of ");
                         fprintf(stderr,"reading the %d-th corner of the ",k+1);
                         fprintf(stderr,"mesh discretization.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -3193,18 +3550,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             else if (!strcmp(keyword,"Req"))
             {
                 // Read number of RequiredVertices and store it in pMesh->ncor
-                readStringOut=fgets(readStringIn,14,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,14,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"required vertices in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3217,7 +3577,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"(a positive integer value that cannot be ");
                     fprintf(stderr,"(strictly) greater than the total number ");
                     fprintf(stderr,"of points %d in the mesh).\n",pMesh->nver);
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3246,16 +3607,18 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 // Check the number of required vertices
                 for (k=0; k<readIntegerIn; k++)
                 {
-                    j=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (j!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                         fprintf(stderr,"return (=%d) of the standard ",j);
-                        fprintf(stderr,"fscanf c-function in the attempt of ");
+                        fprintf(stderr,"scan*InMappedFile function in the ");
+                        fprintf(stderr,"attempt of ");
                         fprintf(stderr,"reading the %d-th required ",k+1);
                         fprintf(stderr,"vertices of the mesh ");
                         fprintf(stderr,"discretization.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
@@ -3263,18 +3626,21 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             else if (!strcmp(keyword,"Tet"))
             {
                 // Read the number of tetrahedra and store it in pMesh->ntet
-                readStringOut=fgets(readStringIn,8,meshFile);
-                readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                readStringOut=getStringInMappedFile(readStringIn,8,&meshFile);
+                readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                 if (readStringOut==NULL || readIntegerOut!=1)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                    fprintf(stderr,"return of the standard fgets ");
-                    fprintf(stderr,"%p or fscanf ",(void*)readStringOut);
+                    fprintf(stderr,"return of the getStringInMappedFile ");
+                    fprintf(stderr,"%p or ",(void*)readStringOut);
+                    fprintf(stderr,"scan*InMappedFile ");
                     fprintf(stderr,"(=%d) c-function while ",readIntegerOut);
                     fprintf(stderr,"attempting to read the total number of ");
                     fprintf(stderr,"tetrahedra in the mesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3284,7 +3650,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"Tetrahedra Ntet instead of ");
                     fprintf(stderr,"Tet%s %d ",readStringIn,readIntegerIn);
                     fprintf(stderr,"(a positive integer value).\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
                 pMesh->ntet=readIntegerIn;
@@ -3298,7 +3665,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"allocate memory for %d ",readIntegerIn);
                     fprintf(stderr,"tetrahedra in the structure pointed ");
                     fprintf(stderr,"by pMesh.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
@@ -3306,7 +3674,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 for (k=0; k<readIntegerIn; k++)
                 {
                     j=0;
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3316,12 +3684,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptet[k].p1=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3331,12 +3700,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptet[k].p2=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3346,12 +3716,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptet[k].p3=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3361,12 +3732,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"a positive integer not (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh.\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                     pMesh->ptet[k].p4=readIntegerOut;
 
-                    j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                    j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                     pMesh->ptet[k].label=readIntegerOut;
                     if (j!=5)
                     {
@@ -3376,43 +3748,50 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"with the %d-th vertex of the ",k+1);
                         fprintf(stderr,"mesh (only %d values properly ",j);
                         fprintf(stderr,"saved instead of five).\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
                 }
             }
             else if (!strcmp(keyword,"Nor"))
             {
-                readStringOut=fgets(readStringIn,5,meshFile);
+                readStringOut=getStringInMappedFile(readStringIn,5,&meshFile);
                 if (readStringOut==NULL)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                     fprintf(stderr,"return %p of the ",(void*)readStringOut);
-                    fprintf(stderr,"standard fgets c-function in the attempt ");
+                    fprintf(stderr,"getStringInMappedFile function in the ");
+                    fprintf(stderr,"attempt ");
                     fprintf(stderr,"of reading the keywords related to the ");
                     fprintf(stderr,"normal vectors of the mesh ");
                     fprintf(stderr,"discretization.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
                 if (!strcmp(readStringIn,"malA"))
                 {
                     // Read number of NormalAtVertices, store it in pMesh->nnorm
-                    readStringOut=fgets(readStringIn,10,meshFile);
-                    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                    readStringOut=getStringInMappedFile(readStringIn,
+                                                                  10,&meshFile);
+                    readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                     if (readStringOut==NULL || readIntegerOut!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                        fprintf(stderr,"return of the standard fgets ");
+                        fprintf(stderr,"return of the getStringInMappedFile ");
                         fprintf(stderr,"%p or ",(void*)readStringOut);
-                        fprintf(stderr,"fscanf (=%d) ",readIntegerOut);
+                        fprintf(stderr,"scan*InMappedFile ");
+                        fprintf(stderr,"(=%d) ",readIntegerOut);
                         fprintf(stderr,"c-function while attempting to read ");
                         fprintf(stderr,"the total number of normal vectors ");
                         fprintf(stderr,"prescribed at some vertices of the ");
                         fprintf(stderr,"mesh.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3426,7 +3805,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"value that cannot be (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh).\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3441,7 +3821,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"number of normal vectors ");
                             fprintf(stderr,"(=%d) prescribed ",readIntegerIn);
                             fprintf(stderr,"at some vertices of the mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3460,7 +3841,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"prescribed at some vertices of ");
                             fprintf(stderr,"the mesh structure pointed by ");
                             fprintf(stderr,"pMesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3470,7 +3852,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     for (k=0; k<readIntegerIn; k++)
                     {
                         j=0;
-                        j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                        j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                         if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                         {
                             PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3482,12 +3864,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"(strictly) greater than the ");
                             fprintf(stderr,"total number of points ");
                             fprintf(stderr,"%d in the mesh.\n",pMesh->nver);
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                         pMesh->pnorm[k].p=readIntegerOut;
 
-                        j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                        j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                         if (readIntegerOut!=k+1)
                         {
                             if (pParameters->verbose)
@@ -3517,12 +3900,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         {
                             PRINT_ERROR("In readMeshFileAndAllocateMesh: ");
                             fprintf(stderr,"wrong return (=%d instead of ",j);
-                            fprintf(stderr,"two) of the standard fscanf ");
+                            fprintf(stderr,"two) of the scan*InMappedFile ");
                             fprintf(stderr,"c-function in the attempt of ");
                             fprintf(stderr,"reading the %d-th ",k+1);
                             fprintf(stderr,"normal vector prescribed at a ");
                             fprintf(stderr,"vertex of the mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3530,15 +3914,17 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 else if (!strcmp(readStringIn,"mals"))
                 {
                     // Read and store number of normal vectors in pMesh->nnorm
-                    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                    readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
                     if (readIntegerOut!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                         fprintf(stderr,"return (=%d) of the ",readIntegerOut);
-                        fprintf(stderr,"standard fscanf c-function in the ");
+                        fprintf(stderr,"scan*InMappedFile function in the ");
                         fprintf(stderr,"attempt of reading the number of ");
                         fprintf(stderr,"normal vectors.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3551,7 +3937,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"the mesh instead of %d ",readIntegerIn);
                         fprintf(stderr,"for the total number of normal ");
                         fprintf(stderr,"vectors.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3567,7 +3954,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"total number of normal vectors ");
                             fprintf(stderr,"(=%d) defined in ",readIntegerIn);
                             fprintf(stderr,"the mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3585,7 +3973,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"%d normal vectors ",readIntegerIn);
                             fprintf(stderr,"in the structure pointed by ");
                             fprintf(stderr,"pMesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3594,26 +3983,27 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     for (k=0; k<readIntegerIn; k++)
                     {
                         j=0;
-                        j+=fscanf(meshFile,"%lf ",&readDouble);
+                        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
                         pMesh->pnorm[k].x=readDouble;
 
-                        j+=fscanf(meshFile,"%lf ",&readDouble);
+                        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
                         pMesh->pnorm[k].y=readDouble;
 
-                        j+=fscanf(meshFile,"%lf ",&readDouble);
+                        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
                         pMesh->pnorm[k].z=readDouble;
 
                         if (j!=3)
                         {
                             PRINT_ERROR("In readMeshFileAndAllocateMesh: ");
                             fprintf(stderr,"wrong return (=%d instead of ",j);
-                            fprintf(stderr,"three) of the standard fscanf ");
+                            fprintf(stderr,"three) of the scan*InMappedFile ");
                             fprintf(stderr,"c-function in the attempt of ");
                             fprintf(stderr,"reading the displacement ");
                             fprintf(stderr,"of the %d-th normal vector ",k+1);
                             fprintf(stderr,"prescribed at a vertex of the ");
                             fprintf(stderr,"mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3623,42 +4013,49 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: expecting ");
                     fprintf(stderr,"the keyword Normals or NormalAtVertices ");
                     fprintf(stderr,"instead of Nor%s.\n",readStringIn);
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
             }
             else if (!strcmp(keyword,"Tan"))
             {
-                readStringOut=fgets(readStringIn,6,meshFile);
+                readStringOut=getStringInMappedFile(readStringIn,6,&meshFile);
                 if (readStringOut==NULL)
                 {
                     PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                     fprintf(stderr,"return %p of the ",(void*)readStringOut);
-                    fprintf(stderr,"standard fgets c-function in the attempt ");
+                    fprintf(stderr,"getStringInMappedFile function in the ");
+                    fprintf(stderr,"attempt ");
                     fprintf(stderr,"of reading the keywords related to the ");
                     fprintf(stderr,"tangent vectors of the mesh ");
                     fprintf(stderr,"discretization.\n");
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
 
                 if (!strcmp(readStringIn,"gentA"))
                 {
                     // Read number of TangentAtVertices, store it in pMesh->ntan
-                    readStringOut=fgets(readStringIn,10,meshFile);
-                    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                    readStringOut=getStringInMappedFile(readStringIn,
+                                                                  10,&meshFile);
+                    readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
 
                     if (readStringOut==NULL || readIntegerOut!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
-                        fprintf(stderr,"return of the standard fgets ");
+                        fprintf(stderr,"return of the getStringInMappedFile ");
                         fprintf(stderr,"%p or ",(void*)readStringOut);
-                        fprintf(stderr,"fscanf (=%d) ",readIntegerOut);
+                        fprintf(stderr,"scan*InMappedFile ");
+                        fprintf(stderr,"(=%d) ",readIntegerOut);
                         fprintf(stderr,"c-function while attempting to read ");
                         fprintf(stderr,"the total number of tangent vectors ");
                         fprintf(stderr,"prescribed at some vertices of the ");
                         fprintf(stderr,"mesh.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3672,7 +4069,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"value that cannot be (strictly) ");
                         fprintf(stderr,"greater than the total number of ");
                         fprintf(stderr,"points %d in the mesh).\n",pMesh->nver);
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3687,7 +4085,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"of tangent vectors ");
                             fprintf(stderr,"(=%d) prescribed ",readIntegerIn);
                             fprintf(stderr,"at some vertices of the mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3706,7 +4105,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"prescribed at some vertices of ");
                             fprintf(stderr,"the mesh structure pointed by ");
                             fprintf(stderr,"pMesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3716,7 +4116,7 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     for (k=0; k<readIntegerIn; k++)
                     {
                         j=0;
-                        j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                        j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                         if (readIntegerOut<1 || readIntegerOut>pMesh->nver)
                         {
                             PRINT_ERROR("In readMeshFileAndAllocateMesh: the ");
@@ -3728,12 +4128,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"(strictly) greater than the ");
                             fprintf(stderr,"total number of points ");
                             fprintf(stderr,"%d in the mesh.\n",pMesh->nver);
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                         pMesh->ptan[k].p=readIntegerOut;
 
-                        j+=fscanf(meshFile,"%d ",&readIntegerOut);
+                        j+=scanIntegerInMappedFile(&meshFile,&readIntegerOut);
                         if (readIntegerOut!=k+1)
                         {
                             if (pParameters->verbose)
@@ -3763,12 +4164,13 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         {
                             PRINT_ERROR("In readMeshFileAndAllocateMesh: ");
                             fprintf(stderr,"wrong return (=%d instead of ",j);
-                            fprintf(stderr,"two) of the standard fscanf ");
+                            fprintf(stderr,"two) of the scan*InMappedFile ");
                             fprintf(stderr,"c-function in the attempt of ");
                             fprintf(stderr,"reading the %d-th ",k+1);
                             fprintf(stderr,"tangent vector prescribed at ");
                             fprintf(stderr,"a vertex of the mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3776,15 +4178,17 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 else if (!strcmp(readStringIn,"gents"))
                 {
                     // Read and store number of tangent vectors in pMesh->ntan
-                    readIntegerOut=fscanf(meshFile," %d ",&readIntegerIn);
+                    readIntegerOut=scanIntegerInMappedFile(&meshFile,
+                                                                &readIntegerIn);
                     if (readIntegerOut!=1)
                     {
                         PRINT_ERROR("In readMeshFileAndAllocateMesh: wrong ");
                         fprintf(stderr,"return (=%d) of the ",readIntegerOut);
-                        fprintf(stderr,"standard fscanf c-function in the ");
+                        fprintf(stderr,"scan*InMappedFile function in the ");
                         fprintf(stderr,"attempt of reading the number of ");
                         fprintf(stderr,"tangent vectors.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3797,7 +4201,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                         fprintf(stderr,"the mesh instead of %d ",readIntegerIn);
                         fprintf(stderr,"for the total number of tangent ");
                         fprintf(stderr,"vectors.\n");
-                        closeTheFile(&meshFile);
+                        closeMappedFile(&meshFile);
+                        endProfilerPhase(&globalProfiler,PROF_IO);
                         return 0;
                     }
 
@@ -3813,7 +4218,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"total number of tangent vectors ");
                             fprintf(stderr,"(=%d) defined in ",readIntegerIn);
                             fprintf(stderr,"the mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3831,7 +4237,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                             fprintf(stderr,"%d tangent vectors ",readIntegerIn);
                             fprintf(stderr,"in the structure pointed by ");
                             fprintf(stderr,"pMesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3840,26 +4247,27 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     for (k=0; k<readIntegerIn; k++)
                     {
                         j=0;
-                        j+=fscanf(meshFile,"%lf ",&readDouble);
+                        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
                         pMesh->ptan[k].x=readDouble;
 
-                        j+=fscanf(meshFile,"%lf ",&readDouble);
+                        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
                         pMesh->ptan[k].y=readDouble;
 
-                        j+=fscanf(meshFile,"%lf ",&readDouble);
+                        j+=scanDoubleInMappedFile(&meshFile,&readDouble);
                         pMesh->ptan[k].z=readDouble;
 
                         if (j!=3)
                         {
                             PRINT_ERROR("In readMeshFileAndAllocateMesh: ");
                             fprintf(stderr,"wrong return (=%d instead of ",j);
-                            fprintf(stderr,"three) of the standard fscanf ");
+                            fprintf(stderr,"three) of the scan*InMappedFile ");
                             fprintf(stderr,"c-function in the attempt of ");
                             fprintf(stderr,"reading the displacement ");
                             fprintf(stderr,"of the %d-th tangent vector ",k+1);
                             fprintf(stderr,"prescribed at a vertex of the ");
                             fprintf(stderr,"mesh.\n");
-                            closeTheFile(&meshFile);
+                            closeMappedFile(&meshFile);
+                            endProfilerPhase(&globalProfiler,PROF_IO);
                             return 0;
                         }
                     }
@@ -3870,7 +4278,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                     fprintf(stderr,"the keyword Tangents or ");
                     fprintf(stderr,"TangentAtVertices instead of ");
                     fprintf(stderr,"Tan%s.\n",readStringIn);
-                    closeTheFile(&meshFile);
+                    closeMappedFile(&meshFile);
+                    endProfilerPhase(&globalProfiler,PROF_IO);
                     return 0;
                 }
             }
@@ -3885,22 +4294,22 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 fprintf(stderr,"correspond to any known keyword in the ");
                 fprintf(stderr,"tetrahedral mesh structure pointed by ");
                 fprintf(stderr,"pMesh.\n");
-                closeTheFile(&meshFile);
+                closeMappedFile(&meshFile);
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
         } while (i<11);
     }
 
     // Testing if file is well closed
-    if (fclose(meshFile))
+    if (closeMappedFile(&meshFile))
     {
         PRINT_ERROR("In readMeshFileAndAllocateMesh: the");
         fprintf(stderr,"%s file has not been closed ",pParameters->name_mesh);
         fprintf(stderr,"properly.\n");
-        meshFile=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
-    meshFile=NULL;
     if (pParameters->opt_mode!=1 || pParameters->verbose)
     {
         fprintf(stdout,"Closing file.\n");
@@ -3926,6 +4335,8 @@ int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         }
     }
 
+    endProfilerPhase(&globalProfiler,PROF_IO);
+
     return 1;
 }
 
@@ -4119,6 +4530,22 @@ int updateDiscretizationParameters(Parameters* pParameters, Mesh* pMesh)
             return 0;
         }
 
+        // The hexahedra are recovered from n_y and n_z (getHexahedronVertices
+        // function) so the grid of the vertices must be the one of the
+        // hexahedra read by the readMeshFileAndAllocateMesh function
+        if (pParameters->opt_mode<=0 && pMesh->nhex>0 &&
+             (nX!=pParameters->n_x || nY!=pParameters->n_y ||
+                                                      nZ!=pParameters->n_z))
+        {
+            PRINT_ERROR("In updateDiscretizationParameters: the ");
+            fprintf(stderr,"(%d)x(%d)x(%d) grid of the vertices ",nX,nY,nZ);
+            fprintf(stderr,"does not match the (%d)x",pParameters->n_x);
+            fprintf(stderr,"(%d)x(%d) one ",pParameters->n_y,pParameters->n_z);
+            fprintf(stderr,"of the hexahedra stored in the structure ");
+            fprintf(stderr,"pointed by pMesh.\n");
+            return 0;
+        }
+
         // Get a guess for the delta_x, delta_y and delta_z variables of pMesh
         deltaX=(xMax-xMin)/(double)(nX-1);
         deltaY=(yMax-yMin)/(double)(nY-1);
@@ -4237,7 +4664,7 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
     char *readStringOut=NULL, readStringIn[18]={'\0'};
     int readIntegerIn=0, readIntegerOut=0, i=0;
     double readDouble=0.;
-    FILE *chemicalFile=NULL;
+    MappedFile chemicalFile={NULL,0,0};
 
     // Check that pNucl is not pointing to NULL and that nNucl is positive
     if (pNucl==NULL)
@@ -4293,11 +4720,10 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
         return 0;
     }
 
-    // Check if the *.chem file is well opened: fopen function returns a FILE
-    // pointer on success, otherwise NULL is returned
+    // Map the content of the *.chem file into memory: openMappedFile returns
+    // one on success, otherwise zero is returned
     fprintf(stdout,"Opening %s file. ",fileLocation);
-    chemicalFile=fopen(fileLocation,"r");
-    if (chemicalFile==NULL)
+    if (!openMappedFile(fileLocation,nameLength,&chemicalFile))
     {
         PRINT_ERROR("In checkCompatibilityOfChemicalData: could not ");
         fprintf(stderr,"read the content of %s file.\n",fileLocation);
@@ -4305,36 +4731,35 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
     }
     fprintf(stdout,"Checking Nucleus data. ");
 
-    // fscanf function returns the number of input items successfully matched
-    // and assigned, which can be fewer than provided for. Important remark:
-    // white space characters, such as blanks and newline characters, causes
-    // fscanf (scanf and sscanf) to read, but not to store, all consecutive
-    // white space characters in the input up to the next character that is not
-    // white space. One white space character in format-string matches any
-    // combination of white space characters in the input
-    readIntegerOut=fscanf(chemicalFile," ");
+    // The scan*InMappedFile functions return one if an item has been read and
+    // assigned, zero otherwise (EOF at the end of the file). As the fscanf
+    // c-function with a white space in the format-string, they skip (without
+    // storing them) all the consecutive white space characters of the input
+    readIntegerOut=skipSpacesInMappedFile(&chemicalFile);
     if (readIntegerOut)
     {
         PRINT_ERROR("In checkCompatibilityOfChemicalData: wrong return ");
-        fprintf(stderr,"(=%d) of the fscanf function ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
+        fprintf(stderr,"function ");
         fprintf(stderr,"(EOF=%d) while attempting to read the first ",EOF);
         fprintf(stderr,"white space characters (in case there was some) ");
         fprintf(stderr,"of the %s file.\n",fileLocation);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
-    // Read number of molecular orbitals: fgets returns NULL if it fails,
-    // otherwise the same (char*) input address
-    readStringOut=fgets(readStringIn,18,chemicalFile);
-    readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+    // Read number of molecular orbitals: getStringInMappedFile returns NULL if
+    // it fails, otherwise the same (char*) input address
+    readStringOut=getStringInMappedFile(readStringIn,18,&chemicalFile);
+    readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In checkCompatibilityOfChemicalData: wrong return ");
-        fprintf(stderr,"of the fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the number of molecular orbitals.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -4345,20 +4770,21 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
         PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
         fprintf(stderr,"MolecularOrbitals Nmorb instead of %s ",readStringIn);
         fprintf(stderr,"%d (positive value).\n",readIntegerIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     // Read number of primitives
-    readStringOut=fgets(readStringIn,11,chemicalFile);
-    readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,11,&chemicalFile);
+    readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In checkCompatibilityOfChemicalData: wrong return ");
-        fprintf(stderr,"of the fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the number of primitives.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -4367,20 +4793,21 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
         PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
         fprintf(stderr,"Primitives Ngauss instead of %s ",readStringIn);
         fprintf(stderr,"%d (positive value).\n",readIntegerIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     // Read the number of nuclei and compare it to the nNucl variable
-    readStringOut=fgets(readStringIn,7,chemicalFile);
-    readIntegerOut=fscanf(chemicalFile," %d ",&readIntegerIn);
+    readStringOut=getStringInMappedFile(readStringIn,7,&chemicalFile);
+    readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
     if (readStringOut==NULL || readIntegerOut!=1)
     {
         PRINT_ERROR("In checkCompatibilityOfChemicalData: wrong return ");
-        fprintf(stderr,"of the fgets %p or fscanf ",(void*)readStringOut);
+        fprintf(stderr,"of the getStringInMappedFile ");
+        fprintf(stderr,"%p or scan*InMappedFile ",(void*)readStringOut);
         fprintf(stderr,"(=%d) function while attempting to ",readIntegerOut);
         fprintf(stderr,"read the number of nuclei.\n");
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
@@ -4389,20 +4816,20 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
         PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
         fprintf(stderr,"Nuclei %d instead of %s ",nNucl,readStringIn);
         fprintf(stderr,"%d.\n",readIntegerIn);
-        closeTheFile(&chemicalFile);
+        closeMappedFile(&chemicalFile);
         return 0;
     }
 
     // Saving the Nucleus data in pMesh->pnucl and check if it worked
     for (i=0; i<nNucl; i++)
     {
-        readIntegerOut=fscanf(chemicalFile,"%lf ",&readDouble);
+        readIntegerOut=scanDoubleInMappedFile(&chemicalFile,&readDouble);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In checkCompatibilityOfChemicalData: we were ");
             fprintf(stderr,"not able to properly read the first-coordinate ");
             fprintf(stderr,"position of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -4411,17 +4838,17 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
             PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
             fprintf(stderr,"%lf instead of %lf for the ",pNucl[i].x,readDouble);
             fprintf(stderr,"first coordinate of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
-        readIntegerOut=fscanf(chemicalFile,"%lf ",&readDouble);
+        readIntegerOut=scanDoubleInMappedFile(&chemicalFile,&readDouble);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In checkCompatibilityOfChemicalData: we were ");
             fprintf(stderr,"not able to properly read the second-coordinate ");
             fprintf(stderr,"position of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -4430,17 +4857,17 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
             PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
             fprintf(stderr,"%lf instead of %lf for the ",pNucl[i].y,readDouble);
             fprintf(stderr,"second coordinate of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
-        readIntegerOut=fscanf(chemicalFile,"%lf ",&readDouble);
+        readIntegerOut=scanDoubleInMappedFile(&chemicalFile,&readDouble);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In checkCompatibilityOfChemicalData: we were ");
             fprintf(stderr,"not able to properly read the third-coordinate ");
             fprintf(stderr,"position of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -4449,18 +4876,19 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
             PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
             fprintf(stderr,"%lf instead of %lf for the ",pNucl[i].z,readDouble);
             fprintf(stderr,"third coordinate of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
-        readIntegerOut=fscanf(chemicalFile,"%d ",&readIntegerIn);
+        readIntegerOut=scanIntegerInMappedFile(&chemicalFile,&readIntegerIn);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In checkCompatibilityOfChemicalData: wrong ");
-            fprintf(stderr,"(=%d) return of the fscanf ",readIntegerOut);
+            fprintf(stderr,"(=%d) return of the ",readIntegerOut);
+            fprintf(stderr,"scan*InMappedFile ");
             fprintf(stderr,"function while attempting to read the charge of ");
             fprintf(stderr,"the %d-th Nucleus structure.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -4470,7 +4898,7 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
             fprintf(stderr,"charge (=%d) of the %d-th ",readIntegerIn,i+1);
             fprintf(stderr,"Nucleus must be a positive integer that is not ");
             fprintf(stderr,"(strictly) greater than one hundred.\n");
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
 
@@ -4479,22 +4907,20 @@ int checkCompatibilityOfChemicalData(char* fileLocation, int nameLength,
             PRINT_ERROR("In checkCompatibilityOfChemicalData: expecting ");
             fprintf(stderr,"%d instead of %d ",pNucl[i].charge,readIntegerIn);
             fprintf(stderr,"for the charge of the %d-th Nucleus.\n",i+1);
-            closeTheFile(&chemicalFile);
+            closeMappedFile(&chemicalFile);
             return 0;
         }
     }
 
-    // Closing the *.chem file: fclose function returns zero if the input FILE*
-    // variable is successfully closed, otherwise EOF (end-of-file) is returned
-    if (fclose(chemicalFile))
+    // Closing the *.chem file: closeMappedFile returns zero if the memory is
+    // successfully unmapped, otherwise EOF (end-of-file) is returned
+    if (closeMappedFile(&chemicalFile))
     {
         PRINT_ERROR("In checkCompatibilityOfChemicalData: the ");
         fprintf(stderr,"%s file has not been closed properly.\n",fileLocation);
-        chemicalFile=NULL;
         return 0;
     }
     fprintf(stdout,"Closing file.\n");
-    chemicalFile=NULL;
 
     return 1;
 }
@@ -4518,7 +4944,7 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     Nucleus *pNucl=NULL;
     Triangle *pTriangle=NULL;
     Vector *pNormal=NULL;
-    FILE *cubeFile=NULL;
+    MappedFile cubeFile={NULL,0,0};
 
     // Define a normal vector in case we need to re-order the mesh ones
     Vector normal;
@@ -4549,11 +4975,11 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         return 0;
     }
 
-    // Opening *.cube file (warning: reset and overwrite file if already exists)
-    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    // Map the content of the *.cube file into memory: openMappedFile returns
+    // one on success, otherwise zero is returned
     fprintf(stdout,"\nOpening %s file. ",pParameters->name_mesh);
-    cubeFile=fopen(pParameters->name_mesh,"r");
-    if (cubeFile==NULL)
+    if (!openMappedFile(pParameters->name_mesh,pParameters->name_length,
+                                                                     &cubeFile))
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: we were not able to ");
         fprintf(stderr,"read the %s file.\n",pParameters->name_mesh);
@@ -4561,50 +4987,47 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     }
     fprintf(stdout,"Reading cube data. ");
 
-    // Skip the first 2 lines of the *.cube file: fgetc returns the character
-    // read as unsigned char cast to an int or EOF on the end of file or error
+    // Skip the first 2 lines of the *.cube file: getCharInMappedFile returns
+    // the character read as unsigned char cast to an int or EOF at the end
     do {
-        readChar=fgetc(cubeFile);
+        readChar=getCharInMappedFile(&cubeFile);
     } while (readChar!='\n' && readChar!=EOF);
     if (readChar==EOF)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh problem ");
-        fprintf(stderr,"encountered with the (standard) fgetc c-function or ");
+        fprintf(stderr,"encountered with the getCharInMappedFile function or ");
         fprintf(stderr,"end-of-file reached without any data read in ");
         fprintf(stderr,"%s file.\n",pParameters->name_mesh);
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
     do {
-        readChar=fgetc(cubeFile);
+        readChar=getCharInMappedFile(&cubeFile);
     } while (readChar!='\n' && readChar!=EOF);
     if (readChar==EOF)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: problem ");
-        fprintf(stderr,"encountered with the (standard) fgetc c-function or ");
+        fprintf(stderr,"encountered with the getCharInMappedFile function or ");
         fprintf(stderr,"end-of-file reached without any data read in ");
         fprintf(stderr,"%s file.\n",pParameters->name_mesh);
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
     // Read the number of nuclei and store it in the nNucl variable
-    // fscanf function returns the number of input items successfully matched
-    // and assigned, which can be fewer than provided for. Important remark:
-    //  white space characters, such as blanks and newline characters, causes
-    // fscanf (scanf and sscanf) to read, but not to store, all consecutive
-    // white space characters in the input up to the next character that is not
-    // white space. One white space character in format-string matches any
-    // combination of white space characters in the input.
-    readIntegerOut=fscanf(cubeFile," %d ",&readIntegerIn);
+    // The scan*InMappedFile functions return one if an item has been read and
+    // assigned, zero otherwise (EOF at the end of the file). As the fscanf
+    // c-function with a white space in the format-string, they skip (without
+    // storing them) all the consecutive white space characters of the input
+    readIntegerOut=scanIntegerInMappedFile(&cubeFile,&readIntegerIn);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the total ");
         fprintf(stderr,"number of nuclei.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4614,60 +5037,60 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"number of nuclei instead of %d for the ",readIntegerIn);
         fprintf(stderr,"total number of nuclei saved in the ");
         fprintf(stderr,"%s file.\n",pParameters->name_mesh);
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     nNucl=readIntegerIn;
 
     // Read the minimal vertex value in the first-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the minimal ");
         fprintf(stderr,"vertex value in the first-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     pParameters->x_min=readDouble;
 
     // Read the minimal vertex value in the second-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the minimal ");
         fprintf(stderr,"vertex value in the second-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     pParameters->y_min=readDouble;
 
     // Read the minimal vertex value in the third-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the minimal ");
         fprintf(stderr,"vertex value in the third-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     pParameters->z_min=readDouble;
 
     // Read number of discretization points in the first-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%d ",&readIntegerIn);
+    readIntegerOut=scanIntegerInMappedFile(&cubeFile,&readIntegerIn);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the ");
         fprintf(stderr,"number of discretization points in the ");
         fprintf(stderr,"first-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4681,39 +5104,39 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"box) in the attempt of reading the number of ");
         fprintf(stderr,"discretization points in the first-coordinate ");
         fprintf(stderr,"direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     nX=readIntegerIn;
 
     // Read the discretization step value in the first-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble<=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: expecting a positive ");
         fprintf(stderr,"value instead of %lf in the attempt of ",readDouble);
         fprintf(stderr,"reading the discretization step in the ");
         fprintf(stderr,"first-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     pParameters->delta_x=readDouble;
 
-    readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble!=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: only orthogonal ");
         fprintf(stderr,"basis are supported for the mesh discretization.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
-    readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble!=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: only orthogonal ");
         fprintf(stderr,"basis are supported for the mesh discretization.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4721,23 +5144,24 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
         fprintf(stderr,"(%d instead of three) of the standard ",readIntegerOut);
-        fprintf(stderr,"fscanf c-function in the attempt of reading the ");
+        fprintf(stderr,"scan*InMappedFile function in the attempt of reading ");
+        fprintf(stderr,"the ");
         fprintf(stderr,"discretization step in the first-coordinate ");
         fprintf(stderr,"direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
     // Read number of discretization points in the second-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%d ",&readIntegerIn);
+    readIntegerOut=scanIntegerInMappedFile(&cubeFile,&readIntegerIn);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the ");
         fprintf(stderr,"number of discretization points in the ");
         fprintf(stderr,"second-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4751,39 +5175,39 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"box) in the attempt of reading the number of ");
         fprintf(stderr,"discretization points in the second-coordinate ");
         fprintf(stderr,"direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     nY=readIntegerIn;
 
     // Read the discretization step value in the second-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble!=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: only orthogonal ");
         fprintf(stderr,"basis are supported for the mesh discretization.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
-    readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble<=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: expecting a positive ");
         fprintf(stderr,"value instead of %lf in the attempt of ",readDouble);
         fprintf(stderr,"reading the discretization step in the ");
         fprintf(stderr,"second-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     pParameters->delta_y=readDouble;
 
-    readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble!=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: only orthogonal ");
         fprintf(stderr,"basis are supported for the mesh discretization.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4791,23 +5215,24 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
         fprintf(stderr,"(%d instead of three) of the standard ",readIntegerOut);
-        fprintf(stderr,"fscanf c-function in the attempt of reading the ");
+        fprintf(stderr,"scan*InMappedFile function in the attempt of reading ");
+        fprintf(stderr,"the ");
         fprintf(stderr,"discretization step in the second-coordinate ");
         fprintf(stderr,"direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
     // Read number of discretization points in the third-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%d ",&readIntegerIn);
+    readIntegerOut=scanIntegerInMappedFile(&cubeFile,&readIntegerIn);
     if (readIntegerOut!=1)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-        fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+        fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
         fprintf(stderr,"c-function in the attempt of reading the ");
         fprintf(stderr,"number of discretization points in the ");
         fprintf(stderr,"third-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4821,38 +5246,38 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         fprintf(stderr,"box) in the attempt of reading the number of ");
         fprintf(stderr,"discretization points in the third-coordinate ");
         fprintf(stderr,"direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     nZ=readIntegerIn;
 
     // Read the discretization step value in the third-coordinate direction
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble!=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: only orthogonal ");
         fprintf(stderr,"basis are supported for the mesh discretization.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
-    readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble!=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: only orthogonal ");
         fprintf(stderr,"basis are supported for the mesh discretization.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
-    readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readDouble<=0.)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: expecting a positive ");
         fprintf(stderr,"value instead of %lf in the attempt of ",readDouble);
         fprintf(stderr,"reading the discretization step in the ");
         fprintf(stderr,"third-coordinate direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
     pParameters->delta_z=readDouble;
@@ -4861,10 +5286,11 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
         fprintf(stderr,"(%d instead of three) of the standard ",readIntegerOut);
-        fprintf(stderr,"fscanf c-function in the attempt of reading the ");
+        fprintf(stderr,"scan*InMappedFile function in the attempt of reading ");
+        fprintf(stderr,"the ");
         fprintf(stderr,"discretization step in the third-coordinate ");
         fprintf(stderr,"direction.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4889,7 +5315,7 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: could not allocate ");
         fprintf(stderr,"memory for the local (Nucleus*) pNucl variable.\n");
-        closeTheFile(&cubeFile);
+        closeMappedFile(&cubeFile);
         return 0;
     }
 
@@ -4897,17 +5323,17 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
     for (i=0; i<iMax; i++)
     {
         // Read the charge number of each nuclei as an integer value
-        readIntegerOut=fscanf(cubeFile,"%d ",&readIntegerIn);
+        readIntegerOut=scanIntegerInMappedFile(&cubeFile,&readIntegerIn);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-            fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+            fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
             fprintf(stderr,"c-function in the attempt of reading the ");
             fprintf(stderr,"charge number associated with the %d-th ",i+1);
             fprintf(stderr,"nuclei.\n");
             free(pNucl); // free function does not return any value
             pNucl=NULL;
-            closeTheFile(&cubeFile);
+            closeMappedFile(&cubeFile);
             return 0;
         }
 
@@ -4920,23 +5346,23 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"hundred.\n");
             free(pNucl);
             pNucl=NULL;
-            closeTheFile(&cubeFile);
+            closeMappedFile(&cubeFile);
             return 0;
         }
         pNucl[i].charge=readIntegerIn;
 
         // Read the charge number of each nuclei as a double value
-        readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+        readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
         if (readIntegerOut!=1)
         {
             PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-            fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+            fprintf(stderr,"(=%d) of the scan*InMappedFile ",readIntegerOut);
             fprintf(stderr,"c-function in the attempt of reading the ");
             fprintf(stderr,"charge number associated with the %d-th ",i+1);
             fprintf(stderr,"nuclei.\n");
             free(pNucl);
             pNucl=NULL;
-            closeTheFile(&cubeFile);
+            closeMappedFile(&cubeFile);
             return 0;
         }
 
@@ -4949,36 +5375,36 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"(=%d).\n",pNucl[i].charge);
             free(pNucl);
             pNucl=NULL;
-            closeTheFile(&cubeFile);
+            closeMappedFile(&cubeFile);
             return 0;
         }
 
         // Read the three coordinates of each nuclei
-        readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+        readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
         pNucl[i].x=readDouble;
 
-        readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+        readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
         pNucl[i].y=readDouble;
 
-        readIntegerOut+=fscanf(cubeFile,"%lf ",&readDouble);
+        readIntegerOut+=scanDoubleInMappedFile(&cubeFile,&readDouble);
         pNucl[i].z=readDouble;
 
         if (readIntegerOut!=3)
         {
             PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
             fprintf(stderr,"(%d instead of three) of the ",readIntegerOut);
-            fprintf(stderr,"standard fscanfc-function in the attempt of ");
+            fprintf(stderr,"scan*InMappedFile function in the attempt of ");
             fprintf(stderr,"reading the three coordinates associated with ");
             fprintf(stderr,"the %d-th nuclei.\n",i+1);
             free(pNucl);
             pNucl=NULL;
-            closeTheFile(&cubeFile);
+            closeMappedFile(&cubeFile);
             return 0;
         }
     }
 
     // Distinguish the case where no label are saved after the Nucleus data
-    readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+    readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
     if (readIntegerOut!=1)
     {
         if (pParameters->verbose)
@@ -5003,18 +5429,19 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
             fprintf(stderr,"the mesh elements.\n");
             free(pNucl);
             pNucl=NULL;
-            closeTheFile(&cubeFile);
+            closeMappedFile(&cubeFile);
             return 0;
         }
         pLabel[0]=(int)readDouble;
         iMax=length;
         for (i=1; i<iMax; i++)
         {
-            readIntegerOut=fscanf(cubeFile,"%lf ",&readDouble);
+            readIntegerOut=scanDoubleInMappedFile(&cubeFile,&readDouble);
             if (readIntegerOut!=1)
             {
                 PRINT_ERROR("In readCubeFileAndAllocateMesh: wrong return ");
-                fprintf(stderr,"(=%d) of the standard fscanf ",readIntegerOut);
+                fprintf(stderr,"(=%d) of the ",readIntegerOut);
+                fprintf(stderr,"scan*InMappedFile ");
                 fprintf(stderr,"c-function in the attempt of reading the ");
                 fprintf(stderr,"the %d-th label associated with the mesh ",i+1);
                 fprintf(stderr,"elements.\n");
@@ -5022,16 +5449,16 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
                 pNucl=NULL;
                 free(pLabel);
                 pLabel=NULL;
-                closeTheFile(&cubeFile);
+                closeMappedFile(&cubeFile);
                 return 0;
             }
             pLabel[i]=(int)readDouble;
         }
     }
 
-    // Closing the *.cube file: fclose function returns zero if the input FILE*
-    // variable is successfully closed, otherwise EOF (end-of-file) is returned
-    if (fclose(cubeFile))
+    // Closing the *.cube file: closeMappedFile returns zero if the memory is
+    // successfully unmapped, otherwise EOF (end-of-file) is returned
+    if (closeMappedFile(&cubeFile))
     {
         PRINT_ERROR("In readCubeFileAndAllocateMesh: the ");
         fprintf(stderr,"%s file has not been closed ",pParameters->name_mesh);
@@ -5040,10 +5467,8 @@ int readCubeFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh)
         pNucl=NULL;
         free(pLabel);
         pLabel=NULL;
-        cubeFile=NULL;
         return 0;
     }
-    cubeFile=NULL;
     fprintf(stdout,"Closing file.\n");
 
     // Check if the Nucleus data are compatible with the one of the *.chem file
@@ -6033,6 +6458,9 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
     double delta=0.;
     FILE *cubeFile=NULL;
 
+    // Time the writing of the cube file in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_IO);
+
     // Check if the input variables are not pointing to NULL
     if (pParameters==NULL || pChemicalSystem==NULL || pMesh==NULL)
     {
@@ -6040,6 +6468,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         fprintf(stderr,"(pParameters=%p, ",(void*)pParameters);
         fprintf(stderr,"pChemicalSystem=%p, pMesh=",(void*)pChemicalSystem);
         fprintf(stderr,"%p) does not have a valid address.\n",(void*)pMesh);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6051,6 +6480,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         fprintf(stderr,"pointed by pParameters must be an integer (strictly) ");
         fprintf(stderr,"greater than six (to store at least something more ");
         fprintf(stderr,"than the *.cube extension).\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6062,6 +6492,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
     {
         PRINT_ERROR("In writingCubeFile: could not allocate memory for the ");
         fprintf(stderr,"char* fileLocation (local) variable.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6076,6 +6507,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             fprintf(stderr,"the char* pParameters->name_mesh variable.\n");
             free(fileLocation); // free function does not return any value
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -6093,6 +6525,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             fprintf(stderr,"than the *.info extension).\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -6111,6 +6544,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             fprintf(stderr,"end with with the '.info' extension.\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -6144,6 +6578,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             fprintf(stderr,"than the *.mesh or *.cube extension).\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -6182,13 +6617,17 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             fprintf(stderr,"with with the '.mesh' or '.cube' extension.\n");
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
     }
 
     // Opening *.cube file (warning: reset and overwrite file if already exists)
     // fopen returns a FILE pointer on success, otherwise NULL is returned
-    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    if (pParameters->verbose>=0)
+    {
+        fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    }
     cubeFile=fopen(fileLocation,"w+");
     if (cubeFile==NULL)
     {
@@ -6196,9 +6635,13 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         fprintf(stderr,"into the %s file",fileLocation);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
-    fprintf(stdout,"Writing cube data. ");
+    if (pParameters->verbose>=0)
+    {
+        fprintf(stdout,"Writing cube data. ");
+    }
 
     // Check the number of nuclei
     if (pChemicalSystem->nnucl<1)
@@ -6209,6 +6652,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         closeTheFile(&cubeFile);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6232,6 +6676,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         closeTheFile(&cubeFile);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6255,6 +6700,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         closeTheFile(&cubeFile);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6278,6 +6724,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         closeTheFile(&cubeFile);
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
@@ -6313,6 +6760,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             closeTheFile(&cubeFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
         fprintf(cubeFile,"    %d",pChemicalSystem->pnucl[i].charge);
@@ -6334,6 +6782,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             closeTheFile(&cubeFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
 
@@ -6350,6 +6799,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             closeTheFile(&cubeFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
         if (pMesh->nhex!=iMax)
@@ -6360,6 +6810,7 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
             closeTheFile(&cubeFile);
             free(fileLocation);
             fileLocation=NULL;
+            endProfilerPhase(&globalProfiler,PROF_IO);
             return 0;
         }
     }
@@ -6392,6 +6843,9 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         }
     }
 
+    // Count the written bytes in the profiler before closing the file
+    addProfilerBytes(&globalProfiler,0.,(double)ftell(cubeFile));
+
     // Closing the *.cube file: fclose function returns zero if the input FILE*
     // variable is successfully closed, otherwise EOF (end-of-file) is returned
     if (fclose(cubeFile))
@@ -6401,15 +6855,21 @@ int writingCubeFile(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
         cubeFile=NULL;
         free(fileLocation);
         fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
     cubeFile=NULL;
-    fprintf(stdout,"Closing file.\n");
+    if (pParameters->verbose>=0)
+    {
+        fprintf(stdout,"Closing file.\n");
+    }
 
     // Free the memory dynamically allocated for fileLocation
     free(fileLocation);
     fileLocation=NULL;
 
+    endProfilerPhase(&globalProfiler,PROF_IO);
+
     return 1;
 }
 
@@ -49,6 +49,30 @@ void initializeMeshStructure(Mesh* pMesh);
 */
 void freeMeshMemory(Mesh* pMesh);
 
+/**
+* \fn int copyMeshStructure(Mesh* pMesh, Mesh* pMeshCopy)
+* \brief It performs a deep copy of the Mesh structure pointed by pMesh into
+*        the one pointed by pMeshCopy.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure (defined in
+*                  main.h file) that is intended to be copied.
+*
+* \param[out] pMeshCopy A pointer that points to the Mesh structure (defined in
+*                       main.h file) that will store the copy. Its previous
+*                       content is overwritten without being freed up.
+*
+* The function \ref copyMeshStructure duplicates with malloc/memcpy every array
+* of the structure pointed by pMesh that is not pointing to NULL, so that the
+* copy can be used independently of the original one (it is used by the
+* background thread that writes the snapshots of the optimization loop, see
+* \ref pushSnapshotInWriter). The memory allocated for the copy must be freed
+* up with the \ref freeMeshMemory function.
+*
+* \return It returns one on success, otherwise zero is returned and the memory
+*         that may have been allocated for pMeshCopy is freed up.
+*/
+int copyMeshStructure(Mesh* pMesh, Mesh* pMeshCopy);
+
 /**
 * \fn int initializeCubeDiscretization(Parameters* pParameters, Mesh* pMesh)
 * \brief It suggests for approval to the user the mesh discretization of a
@@ -194,6 +218,38 @@ int allocateInitialMeshMemory(Parameters* pParameters, Mesh* pMesh);
 */
 int labelPoint(int i, int j, int k, int nX, int nY, int nZ);
 
+/**
+* \fn void getHexahedronVertices(int l, int nY, int nZ, int pVertex[8])
+* \brief It computes the references of the eight vertices of an hexahedron of
+*        the structured grid used when opt_mode is not positive.
+*
+* \param[in] l The index of the hexahedron, which is related to the position
+*              (i,j,k) of its first vertex in the grid (i=0...nX-2, j=0...nY-2,
+*              k=0...nZ-2) by l=(i*(nY-1)+j)*(nZ-1)+k. Before using the \ref
+*              getHexahedronVertices function, please be sure that l lies
+*              between zero and (nX-1)*(nY-1)*(nZ-1)-1.
+*
+* \param[in] nY The number of points in the second coordinate direction (it is
+*               intended to store the n_y variable of the Parameters structure).
+*               It should be strictly greater than two.
+*
+* \param[in] nZ The number of points in the third coordinate direction (it is
+*               intended to store the n_z variable of the Parameters structure).
+*               It should be strictly greater than two.
+*
+* \param[out] pVertex The array where the eight point references of the l-th
+*                     hexahedron are stored, referred to as their positions in
+*                     the array of the mesh vertices plus one (as in *.mesh
+*                     files), and ordered as in the \ref meshCube function.
+*
+* Since the hexahedral meshes are always structured grids when opt_mode is not
+* positive (the ones loaded from *.mesh files are checked by the \ref
+* readMeshFileAndAllocateMesh function), the Hexahedron structure does not
+* store its vertices: they are recovered on the fly thanks to the \ref
+* getHexahedronVertices function. It does not return any value (void output).
+*/
+void getHexahedronVertices(int l, int nY, int nZ, int pVertex[8]);
+
 /**
 * \fn int meshCube(Parameters* pParameters, Mesh* pMesh)
 * \brief According to the parameters stored in the structure pointed by
@@ -318,7 +374,12 @@ int getMeshFormat(char* fileLocation, int nameLength);
 * memory for the structure pointed by pMesh, and stores in it the mesh data
 * contained in the *.mesh file, updating some variables of the structure
 * pointed by pParameters and related to the mesh discretization and its bounding
-* computational box values.
+* computational box values. The vertices and elements keep the numbering of the
+* *.mesh file: they are not renumbered here since the *.sol files written by the
+* external softwares (mshdist, elastic, advect) refer to it. Only the meshes
+* written by mmg3d are sorted along a Hilbert curve (see its -rn option), so a
+* *.mesh file given by the user (name_mesh keyword) keeps its own ordering
+* until its first remeshing.
 */
 int readMeshFileAndAllocateMesh(Parameters* pParameters, Mesh* pMesh);
 
@@ -21,7 +21,7 @@
 /* ************************************************************************** */
 void initializeParameterStructure(Parameters* pParameters)
 {
-    // 70 parameters
+    // 76 parameters
     if (pParameters!=NULL)
     {
         pParameters->opt_mode=0;
@@ -67,6 +67,12 @@ void initializeParameterStructure(Parameters* pParameters)
 
         pParameters->trick_matrix=0;
         pParameters->approx_mode=0;
+        pParameters->n_level=0;
+        pParameters->n_prune=0;
+        pParameters->n_start=0;
+        pParameters->ls_start=NULL;
+        pParameters->n_geom=0;
+        pParameters->name_geom=NULL;
 
         pParameters->iter_max=0;
         pParameters->iter_told0p=0.;
@@ -76,6 +82,8 @@ void initializeParameterStructure(Parameters* pParameters)
         pParameters->save_type=0;
         pParameters->save_mesh=0;
         pParameters->save_data=0;
+        pParameters->save_check=0;
+        pParameters->save_prof=0;
         pParameters->save_print=0;
         pParameters->save_where=0;
 
@@ -124,6 +132,8 @@ void initializeParameterStructure(Parameters* pParameters)
 /* ************************************************************************** */
 void freeParameterMemory(Parameters* pParameters)
 {
+    int i=0;
+
     if (pParameters!=NULL)
     {
         // The free function does not return any value (void output)
@@ -156,6 +166,20 @@ void freeParameterMemory(Parameters* pParameters)
 
         free(pParameters->path_advect);
         pParameters->path_advect=NULL;
+
+        free(pParameters->ls_start);
+        pParameters->ls_start=NULL;
+
+        if (pParameters->name_geom!=NULL)
+        {
+            for (i=0; i<pParameters->n_geom; i++)
+            {
+                free(pParameters->name_geom[i]);
+                pParameters->name_geom[i]=NULL;
+            }
+        }
+        free(pParameters->name_geom);
+        pParameters->name_geom=NULL;
     }
 
     return;
@@ -252,6 +276,10 @@ int setupDefaultParameters(Parameters* pParameters, char* nameInfo)
 
     pParameters->trick_matrix=TRICK_MATRIX;
     pParameters->approx_mode=APPROX_MODE;
+    pParameters->n_level=N_LEVEL;
+    pParameters->n_prune=N_PRUNE;
+    pParameters->n_start=N_START;
+    pParameters->n_geom=N_GEOM;
 
     pParameters->iter_max=ITER_MAX;
     pParameters->iter_told0p=ITER_TOLD0P;
@@ -261,6 +289,8 @@ int setupDefaultParameters(Parameters* pParameters, char* nameInfo)
     pParameters->save_type=SAVE_TYPE;
     pParameters->save_mesh=SAVE_MESH;
     pParameters->save_data=SAVE_DATA;
+    pParameters->save_check=SAVE_CHECK;
+    pParameters->save_prof=SAVE_PROF;
     pParameters->save_print=SAVE_PRINT;
     pParameters->save_where=SAVE_WHERE;
 
@@ -351,13 +381,14 @@ int getLengthAfterKeywordBeginning(char keywordBeginning[3], int counter)
 {
     int returnValue=0;
 
-    // Check that counter is between 1 and 70 (total number of keywords)
-    if (counter<1 || counter>70)
+    // Check that counter is between 1 and 76 (total number of keywords)
+    if (counter<1 || counter>76)
     {
         PRINT_ERROR("In getLengthAfterKeywordBeginning: the input variable ");
         fprintf(stderr,"counter, corresponding to the %d-th keyword ",counter);
-        fprintf(stderr,"read, should be an integer between one and seventy ");
-        fprintf(stderr,"(the total number of different possible keywords).\n");
+        fprintf(stderr,"read, should be an integer between one and ");
+        fprintf(stderr,"seventy-six (the total number of different ");
+        fprintf(stderr,"possible keywords).\n");
         return 0;
     }
 
@@ -447,12 +478,13 @@ int getTypeAfterKeyword(char keywordMiddle[11], int lengthMiddle, int counter)
 {
     int returnValue=0, boolean1=0, boolean2=0, boolean3=0;
 
-    // Check that counter is between 1 and 70 (total number of keywords)
-    if (counter<1 || counter>70)
+    // Check that counter is between 1 and 76 (total number of keywords)
+    if (counter<1 || counter>76)
     {
         PRINT_ERROR("In getTypeAfterKeyword: the input variable counter, ");
         fprintf(stderr,"corresponding to the %d-th keyword read, ",counter);
-        fprintf(stderr,"should be an integer between one and and seventy ");
+        fprintf(stderr,"should be an integer between one and and ");
+        fprintf(stderr,"seventy-six ");
         fprintf(stderr,"(the total number of different possible keywords).\n");
         return 0;
     }
@@ -499,12 +531,18 @@ int getTypeAfterKeyword(char keywordMiddle[11], int lengthMiddle, int counter)
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_type"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_mesh"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_data"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_prof"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_prin"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_chec"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_wher"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"th_lengt"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ode_l"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"i"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"_cfl"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"l"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"p"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"s"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"g"));
 
     boolean2=(!strcmp(keywordMiddle,"min"));
     boolean2=(boolean2 || !strcmp(keywordMiddle,"max"));
@@ -592,13 +630,14 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 {
     int returnValue=0, boolean1=0, boolean2=0, boolean3=0, boolean4=0;
 
-    // Check that counter is between 1 and 70 (total number of keywords)
-    if (counter<1 || counter>70)
+    // Check that counter is between 1 and 76 (total number of keywords)
+    if (counter<1 || counter>76)
     {
         PRINT_ERROR("In getLengthAfterKeywordMiddle: the input variable ");
         fprintf(stderr,"counter, corresponding to the %d-th keyword ",counter);
-        fprintf(stderr,"read, should be an integer between one and seventy ");
-        fprintf(stderr,"(the total number of different possible keywords).\n");
+        fprintf(stderr,"read, should be an integer between one and ");
+        fprintf(stderr,"seventy-six (the total number of different ");
+        fprintf(stderr,"possible keywords).\n");
         return 0;
     }
 
@@ -659,6 +698,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_type"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_mesh"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_data"));
+    boolean1=(boolean1 || !strcmp(keywordMiddle,"ve_prof"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"th_medit"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"th_mmg3d"));
     boolean1=(boolean1 || !strcmp(keywordMiddle,"in_ls"));
@@ -671,6 +711,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 
     boolean2=(!strcmp(keywordMiddle,"ve_prin"));
     boolean2=(boolean2 || !strcmp(keywordMiddle,"ve_wher"));
+    boolean2=(boolean2 || !strcmp(keywordMiddle,"ve_chec"));
     boolean2=(boolean2 || !strcmp(keywordMiddle,"th_lengt"));
     boolean2=(boolean2 || !strcmp(keywordMiddle,"th_advec"));
     boolean2=(boolean2 || !strcmp(keywordMiddle,"in_is"));
@@ -695,11 +736,17 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
     boolean4=(!strcmp(keywordMiddle,"_t"));
     boolean4=(boolean4 || !strcmp(keywordMiddle,"er_tol"));
     boolean4=(boolean4 || !strcmp(keywordMiddle,"i"));
+    boolean4=(boolean4 || !strcmp(keywordMiddle,"g"));
 
     if (!strcmp(keywordMiddle,"_elec"))
     {
         returnValue=6;
     }
+    else if (!strcmp(keywordMiddle,"l") || !strcmp(keywordMiddle,"p") ||
+                                                   !strcmp(keywordMiddle,"s"))
+    {
+        returnValue=5;
+    }
     else if (boolean4)
     {
         returnValue=4;
@@ -735,21 +782,22 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 // location corresponding to the (counter)-th keyword in the *.info file read as
 // the concatenation of the strings keywordBeginning+keywordMiddle(+keywordEnd)
 // where keywordMiddle has size lengthMiddle and keywordEnd has size lengthEnd
-// It has the int[70] repetition, three char[] variables (keywordBeginning[3],
+// It has the int[76] repetition, three char[] variables (keywordBeginning[3],
 // keywordMiddle[11], and keywordEnd[6]), and three int variables (lengthMiddle,
 // lengthEnd, and counter) as input arguments and it returns one on success,
 // otherwise zero is returned if an error occurred
 /* ************************************************************************** */
-int detectRepetition(int repetition[70], char keywordBeginning[3],
+int detectRepetition(int repetition[76], char keywordBeginning[3],
                      char keywordMiddle[11], char keywordEnd[6],
                                    int lengthMiddle, int lengthEnd, int counter)
 {
-    // Check that counter is between 1 and 70 (total number of keywords)
-    if (counter<1 || counter>70)
+    // Check that counter is between 1 and 76 (total number of keywords)
+    if (counter<1 || counter>76)
     {
         PRINT_ERROR("In detectRepetition: the input variable counter ");
         fprintf(stderr,"corresponding to the %d-th keyword read, ",counter);
-        fprintf(stderr,"should be an integer between one and and seventy ");
+        fprintf(stderr,"should be an integer between one and and ");
+        fprintf(stderr,"seventy-six ");
         fprintf(stderr,"(the total number of different possible keywords).\n");
         return 0;
     }
@@ -814,7 +862,7 @@ int detectRepetition(int repetition[70], char keywordBeginning[3],
         }
     }
 
-    // Distinguishing the 70 different cases and excluding non-valid keywords
+    // Distinguishing the 76 different cases and excluding non-valid keywords
     // strcmp returns 0 if the two strings are equal, otherwise <0 (resp. >0)
     // if the 1st string argument is shorter (resp. longer) than the 2nd one
     if (!strcmp(keywordBeginning,"op") && !strcmp(keywordMiddle,"t_mode"))
@@ -1128,6 +1176,35 @@ int detectRepetition(int repetition[70], char keywordBeginning[3],
     {
         repetition[69]++;
     }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"l") &&
+                                                     !strcmp(keywordEnd,"evel"))
+    {
+        repetition[70]++;
+    }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"p") &&
+                                                     !strcmp(keywordEnd,"rune"))
+    {
+        repetition[71]++;
+    }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"s") &&
+                                                     !strcmp(keywordEnd,"tart"))
+    {
+        repetition[72]++;
+    }
+    else if (!strcmp(keywordBeginning,"sa") && !strcmp(keywordMiddle,"ve_chec")
+                                                     && !strcmp(keywordEnd,"k"))
+    {
+        repetition[73]++;
+    }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"g") &&
+                                                      !strcmp(keywordEnd,"eom"))
+    {
+        repetition[74]++;
+    }
+    else if (!strcmp(keywordBeginning,"sa") && !strcmp(keywordMiddle,"ve_prof"))
+    {
+        repetition[75]++;
+    }
     else
     {
         PRINT_ERROR("In detectRepetition: the string ");
@@ -1165,7 +1242,7 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
 {
     size_t size=0;
     char *stringCopy=NULL;
-    int boolean=0;
+    int boolean=0, i=0;
 
     // Test if the input variable pParameters is pointing to NULL
     if (pParameters==NULL)
@@ -1201,12 +1278,13 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
         return 0;
     }
 
-    // Check that counter is between 1 and 70 (total number of keywords)
-    if (counter<1 || counter>70)
+    // Check that counter is between 1 and 76 (total number of keywords)
+    if (counter<1 || counter>76)
     {
         PRINT_ERROR("In changeValuesOfParameters: the input variable counter ");
         fprintf(stderr,"corresponding to the %d-th keyword read, ",counter);
-        fprintf(stderr,"should be an integer between one and and seventy ");
+        fprintf(stderr,"should be an integer between one and and ");
+        fprintf(stderr,"seventy-six ");
         fprintf(stderr,"(the total number of different possible keywords).\n");
         return 0;
     }
@@ -1275,7 +1353,7 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
         }
     }
 
-    // Change the values of pParameters depending on the 70 different cases
+    // Change the values of pParameters depending on the 76 different cases
     // strcmp returns 0 if the two strings are equal, otherwise <0 (resp. >0)
     // if the 1st string argument is shorter (resp. longer) than the 2nd one
     if (!strcmp(keywordBeginning,"op") && !strcmp(keywordMiddle,"t_mode"))
@@ -1385,6 +1463,25 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
                 pParameters->name_elas=stringCopy;
             }
 
+            // Reallocate memory for the chemical files of the scan if any
+            if (pParameters->name_geom!=NULL)
+            {
+                for (i=0; i<pParameters->n_geom; i++)
+                {
+                    stringCopy=(char*)realloc(pParameters->name_geom[i],
+                                                             size*sizeof(char));
+                    if (stringCopy==NULL)
+                    {
+                        PRINT_ERROR("In changeValuesOfParameters: could not ");
+                        fprintf(stderr,"reallocate memory for the char* ");
+                        fprintf(stderr,"pParameters->name_geom[%d] ",i);
+                        fprintf(stderr,"variable.\n");
+                        return 0;
+                    }
+                    pParameters->name_geom[i]=stringCopy;
+                }
+            }
+
             // We do not forget here to update the name_length variable
             pParameters->name_length=readIntegerIn;
         }
@@ -1659,6 +1756,26 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
     {
         pParameters->approx_mode=readIntegerIn;
     }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"l") &&
+                                                     !strcmp(keywordEnd,"evel"))
+    {
+        pParameters->n_level=readIntegerIn;
+    }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"p") &&
+                                                     !strcmp(keywordEnd,"rune"))
+    {
+        pParameters->n_prune=readIntegerIn;
+    }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"s") &&
+                                                     !strcmp(keywordEnd,"tart"))
+    {
+        pParameters->n_start=readIntegerIn;
+    }
+    else if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"g") &&
+                                                      !strcmp(keywordEnd,"eom"))
+    {
+        pParameters->n_geom=readIntegerIn;
+    }
     else if (!strcmp(keywordBeginning,"it") && !strcmp(keywordMiddle,"er_max"))
     {
         pParameters->iter_max=readIntegerIn;
@@ -1690,6 +1807,15 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
     {
         pParameters->save_data=readIntegerIn;
     }
+    else if (!strcmp(keywordBeginning,"sa") && !strcmp(keywordMiddle,"ve_chec")
+                                                     && !strcmp(keywordEnd,"k"))
+    {
+        pParameters->save_check=readIntegerIn;
+    }
+    else if (!strcmp(keywordBeginning,"sa") && !strcmp(keywordMiddle,"ve_prof"))
+    {
+        pParameters->save_prof=readIntegerIn;
+    }
     else if (!strcmp(keywordBeginning,"sa") && !strcmp(keywordMiddle,"ve_prin")
                                                      && !strcmp(keywordEnd,"t"))
     {
@@ -2006,6 +2132,161 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
     return 1;
 }
 
+/* ************************************************************************** */
+// The function readListOfStarts reads, just after the n_start keyword and its
+// value, the n_start lines "ls_type ls_x ls_y ls_z ls_r" describing the initial
+// domains of a multi-start run, and stores them in the ls_start variable of the
+// structure pointed by pParameters. It has the Parameters* variable (defined in
+// main.h) and the FILE* variable of the opened *.info file as input arguments,
+// and it returns zero if an error occurs, otherwise one is returned
+/* ************************************************************************** */
+int readListOfStarts(Parameters* pParameters, FILE* infoFile)
+{
+    int i=0, readIntegerIn=0, readIntegerOut=0;
+
+    // Testing if the input variables are pointing to NULL
+    if (pParameters==NULL || infoFile==NULL)
+    {
+        PRINT_ERROR("In readListOfStarts: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p ",(void*)pParameters);
+        fprintf(stderr,"or infoFile=%p does not ",(void*)infoFile);
+        fprintf(stderr,"point to a valid address.\n");
+        return 0;
+    }
+
+    // Nothing to read if the multi-start mode is not used
+    if (pParameters->n_start<1)
+    {
+        return 1;
+    }
+
+    // Allocating memory for the initial domains (five values per start)
+    pParameters->ls_start=(double*)calloc(5*pParameters->n_start,
+                                                                sizeof(double));
+    if (pParameters->ls_start==NULL)
+    {
+        PRINT_ERROR("In readListOfStarts: could not allocate memory for ");
+        fprintf(stderr,"the (double*) ls_start variable of the structure ");
+        fprintf(stderr,"pointed by pParameters.\n");
+        return 0;
+    }
+
+    // Reading the n_start lines: fscanf function returns the number of input
+    // items successfully matched and assigned, which can be fewer than provided
+    for (i=0; i<pParameters->n_start; i++)
+    {
+        readIntegerOut=fscanf(infoFile," %d %lf %lf %lf %lf ",&readIntegerIn,
+                              &pParameters->ls_start[5*i+1],
+                              &pParameters->ls_start[5*i+2],
+                              &pParameters->ls_start[5*i+3],
+                                                 &pParameters->ls_start[5*i+4]);
+        if (readIntegerOut!=5)
+        {
+            PRINT_ERROR("In readListOfStarts: wrong return ");
+            fprintf(stderr,"(=%d) of the fscanf function ",readIntegerOut);
+            fprintf(stderr,"in the attempt of reading the %d-th line ",i+1);
+            fprintf(stderr,"(over %d) ",pParameters->n_start);
+            fprintf(stderr,"following the 'n_start' keyword (five values ");
+            fprintf(stderr,"'ls_type ls_x ls_y ls_z ls_r' are expected ");
+            fprintf(stderr,"here).\n");
+            return 0;
+        }
+        pParameters->ls_start[5*i]=(double)readIntegerIn;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function readListOfGeometries reads, just after the n_geom keyword and
+// its value, the n_geom lines giving the name of the chemical (*.chem/ *.wfn)
+// file of each next geometry of a scan, and stores them in the name_geom
+// variable of the structure pointed by pParameters. It has the Parameters*
+// variable (defined in main.h) and the FILE* variable of the opened *.info file
+// as input arguments, and it returns zero if an error occurs, otherwise one
+/* ************************************************************************** */
+int readListOfGeometries(Parameters* pParameters, FILE* infoFile)
+{
+    int i=0, j=0, readChar=0, readIntegerOut=0, lengthName=0;
+
+    // Testing if the input variables are pointing to NULL
+    if (pParameters==NULL || infoFile==NULL)
+    {
+        PRINT_ERROR("In readListOfGeometries: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p ",(void*)pParameters);
+        fprintf(stderr,"or infoFile=%p does not ",(void*)infoFile);
+        fprintf(stderr,"point to a valid address.\n");
+        return 0;
+    }
+
+    // Nothing to read if the scan mode is not used
+    if (pParameters->n_geom<1)
+    {
+        return 1;
+    }
+
+    // Allocating memory for the names of the chemical files
+    lengthName=pParameters->name_length;
+    pParameters->name_geom=(char**)calloc(pParameters->n_geom,sizeof(char*));
+    if (pParameters->name_geom==NULL)
+    {
+        PRINT_ERROR("In readListOfGeometries: could not allocate memory for ");
+        fprintf(stderr,"the (char**) name_geom variable of the structure ");
+        fprintf(stderr,"pointed by pParameters.\n");
+        return 0;
+    }
+
+    // Reading the n_geom names, character by character (fscanf function
+    // returns zero here, or EOF if the end of the file is reached)
+    for (i=0; i<pParameters->n_geom; i++)
+    {
+        pParameters->name_geom[i]=(char*)calloc(lengthName,sizeof(char));
+        if (pParameters->name_geom[i]==NULL)
+        {
+            PRINT_ERROR("In readListOfGeometries: could not allocate memory ");
+            fprintf(stderr,"for the (char*) name_geom[%d] variable ",i);
+            fprintf(stderr,"of the structure pointed by pParameters.\n");
+            return 0;
+        }
+
+        readIntegerOut=fscanf(infoFile," ");
+        j=0;
+        readChar=fgetc(infoFile);
+        while (!readIntegerOut && readChar!=EOF && readChar!=' ' &&
+                                                                readChar!='\n')
+        {
+            if (j==lengthName-1)
+            {
+                PRINT_ERROR("In readListOfGeometries: the name of the ");
+                fprintf(stderr,"%d-th chemical file following the ",i+1);
+                fprintf(stderr,"'n_geom' keyword has more than ");
+                fprintf(stderr,"%d letters, which is the maximum ",j);
+                fprintf(stderr,"size allowed here.\nPlease extend properly ");
+                fprintf(stderr,"the allowed length thanks to the ");
+                fprintf(stderr,"'name_length' keyword (placed before the ");
+                fprintf(stderr,"'n_geom' one).\n");
+                return 0;
+            }
+            pParameters->name_geom[i][j]=(char)readChar;
+            j++;
+            readChar=fgetc(infoFile);
+        }
+
+        if (readIntegerOut || !j)
+        {
+            PRINT_ERROR("In readListOfGeometries: wrong return ");
+            fprintf(stderr,"(=%d) of the fscanf function ",readIntegerOut);
+            fprintf(stderr,"or no name read in the attempt of reading the ");
+            fprintf(stderr,"%d-th line (over %d) ",i+1,pParameters->n_geom);
+            fprintf(stderr,"following the 'n_geom' keyword (the name of a ");
+            fprintf(stderr,"*.chem or *.wfn file is expected here).\n");
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 /* ************************************************************************** */
 // The function readInfoFileAndGetParameters reads the *.info file whose name
 // has already been stored in the name_info variable of the structure pointed
@@ -2020,7 +2301,7 @@ int readInfoFileAndGetParameters(Parameters* pParameters)
     char *fileName=NULL;
     size_t lengthString=0;
     int lengthMiddle=0, lengthEnd=0, readIntegerIn=0, readIntegerOut=0;
-    int readChar=0, lengthName=0, keywordType=0, repetition[70]={0}, i=0;
+    int readChar=0, lengthName=0, keywordType=0, repetition[76]={0}, i=0;
     int counter=0, boolean=0;
     double readDouble=.0;
     FILE *infoFile=NULL;
@@ -2133,7 +2414,7 @@ int readInfoFileAndGetParameters(Parameters* pParameters)
     }
 
     counter=0;
-    while (counter<70)
+    while (counter<76)
     {
         counter++;
 
@@ -2291,7 +2572,7 @@ int readInfoFileAndGetParameters(Parameters* pParameters)
             readStringIn=NULL;
             return 0;
         }
-        for (i=0; i<70; i++)
+        for (i=0; i<76; i++)
         {
             if (repetition[i]>1)
             {
@@ -2317,7 +2598,7 @@ int readInfoFileAndGetParameters(Parameters* pParameters)
         switch (keywordType)
         {
             case -1:
-                counter=70;
+                counter=76;
                 break;
 
             case 1:
@@ -2513,6 +2794,38 @@ int readInfoFileAndGetParameters(Parameters* pParameters)
             readStringIn=NULL;
             return 0;
         }
+
+        // The n_start keyword is followed by the list of the initial domains
+        if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"s") &&
+                                                     !strcmp(keywordEnd,"tart"))
+        {
+            if (!readListOfStarts(pParameters,infoFile))
+            {
+                PRINT_ERROR("In readInfoFileAndGetParameters: ");
+                fprintf(stderr,"readListOfStarts function returned zero ");
+                fprintf(stderr,"instead of one.\n");
+                closeTheFile(&infoFile);
+                free(readStringIn);
+                readStringIn=NULL;
+                return 0;
+            }
+        }
+
+        // The n_geom keyword is followed by the chemical files of the scan
+        if (!strcmp(keywordBeginning,"n_") && !strcmp(keywordMiddle,"g") &&
+                                                      !strcmp(keywordEnd,"eom"))
+        {
+            if (!readListOfGeometries(pParameters,infoFile))
+            {
+                PRINT_ERROR("In readInfoFileAndGetParameters: ");
+                fprintf(stderr,"readListOfGeometries function returned zero ");
+                fprintf(stderr,"instead of one.\n");
+                closeTheFile(&infoFile);
+                free(readStringIn);
+                readStringIn=NULL;
+                return 0;
+            }
+        }
     } // This is the end of the while loop for keyword
 
     // Free the memory allocated for readStringIn
@@ -2544,7 +2857,7 @@ int checkValuesOfAllParameters(Parameters* pParameters)
 {
     size_t lengthName=0;
     char* fileLocation=NULL;
-    int boolean=0;
+    int boolean=0, i=0;
     double dx=0., dy=0., dz=0.;
 
     // Testing if the input variable pParameters is pointing to NULL
@@ -3219,6 +3532,206 @@ int checkValuesOfAllParameters(Parameters* pParameters)
         }
     }
 
+    // Check pParameters->n_level (the number of hexahedra of the finest grid
+    // must remain a valid int and the *.hist file assumes a fixed grid)
+    if (pParameters->opt_mode<=0)
+    {
+        boolean=(pParameters->n_level>=0 && pParameters->n_level<=10);
+        if (boolean)
+        {
+            boolean=((double)(pParameters->n_x-1)*(pParameters->n_y-1)*
+                       (pParameters->n_z-1)*pow(8.,pParameters->n_level)<
+                                                                  2147483647.);
+        }
+        boolean=(boolean && (!pParameters->n_level ||
+                                                   pParameters->save_type!=3));
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_level ");
+            fprintf(stderr,"variable (=%d) of the ",pParameters->n_level);
+            fprintf(stderr,"structure pointed by pParameters must be a ");
+            fprintf(stderr,"non-negative integer such that the refined grid ");
+            fprintf(stderr,"has less than 2^31 hexahedra, and it must be set ");
+            fprintf(stderr,"to zero if the save_type variable ");
+            fprintf(stderr,"(=%d) is set to three.\n",pParameters->save_type);
+            fprintf(stderr,"Please modify the value accordingly after the ");
+            fprintf(stderr,"'n_level' keyword in ");
+            fprintf(stderr,"%s file.\n",pParameters->name_info);
+            return 0;
+        }
+    }
+    else
+    {
+        boolean=(pParameters->n_level==N_LEVEL);
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_level ");
+            fprintf(stderr,"variable of the structure pointed by ");
+            fprintf(stderr,"pParameters is not set to its default value ");
+            fprintf(stderr,"(=%d) although the current ",N_LEVEL);
+            fprintf(stderr,"optimization mode (=%d) ",pParameters->opt_mode);
+            fprintf(stderr,"does not require it.\nPlease delete the line ");
+            fprintf(stderr,"containing the 'n_level' keyword in ");
+            fprintf(stderr,"%s file.\n",pParameters->name_info);
+            return 0;
+        }
+    }
+
+    // Check pParameters->n_prune
+    if (pParameters->opt_mode==-2 || pParameters->opt_mode==0)
+    {
+        boolean=(pParameters->n_prune>=0);
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_prune ");
+            fprintf(stderr,"variable (=%d) of the ",pParameters->n_prune);
+            fprintf(stderr,"structure pointed by pParameters must be a ");
+            fprintf(stderr,"non-negative integer.\nPlease modify the value ");
+            fprintf(stderr,"accordingly after the 'n_prune' keyword in ");
+            fprintf(stderr,"%s file.\n",pParameters->name_info);
+            return 0;
+        }
+    }
+    else
+    {
+        boolean=(pParameters->n_prune==N_PRUNE);
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_prune ");
+            fprintf(stderr,"variable of the structure pointed by ");
+            fprintf(stderr,"pParameters is not set to its default value ");
+            fprintf(stderr,"(=%d) although the current ",N_PRUNE);
+            fprintf(stderr,"optimization mode (=%d) ",pParameters->opt_mode);
+            fprintf(stderr,"does not require it.\nPlease delete the line ");
+            fprintf(stderr,"containing the 'n_prune' keyword in ");
+            fprintf(stderr,"%s file.\n",pParameters->name_info);
+            return 0;
+        }
+    }
+
+    // Check pParameters->n_start and the associated list of initial domains
+    if (pParameters->opt_mode<1)
+    {
+        boolean=(pParameters->n_start>=0);
+        if (boolean && pParameters->n_start>0)
+        {
+            boolean=(pParameters->ls_start!=NULL &&
+                                               pParameters->name_mesh==NULL);
+        }
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_start ");
+            fprintf(stderr,"variable (=%d) of the ",pParameters->n_start);
+            fprintf(stderr,"structure pointed by pParameters must be a ");
+            fprintf(stderr,"non-negative integer and, if positive, the ");
+            fprintf(stderr,"ls_start variable must have been read (and no ");
+            fprintf(stderr,"'name_mesh' keyword must be given since each ");
+            fprintf(stderr,"start builds its own cube).\nPlease modify the ");
+            fprintf(stderr,"values accordingly after the 'n_start' keyword ");
+            fprintf(stderr,"in %s file.\n",pParameters->name_info);
+            return 0;
+        }
+        for (i=0; i<pParameters->n_start; i++)
+        {
+            boolean=((int)pParameters->ls_start[5*i]==0 ||
+                                        (int)pParameters->ls_start[5*i]==1);
+            boolean=(boolean && pParameters->ls_start[5*i+4]>0.);
+            if (!boolean)
+            {
+                PRINT_ERROR("In checkValuesOfAllParameters: the ");
+                fprintf(stderr,"%d-th initial domain given after the ",i+1);
+                fprintf(stderr,"'n_start' keyword in ");
+                fprintf(stderr,"%s file must have ",pParameters->name_info);
+                fprintf(stderr,"its ls_type ");
+                fprintf(stderr,"(=%d) ",(int)pParameters->ls_start[5*i]);
+                fprintf(stderr,"set to 0 or 1 and its ls_r ");
+                fprintf(stderr,"(=%lf) ",pParameters->ls_start[5*i+4]);
+                fprintf(stderr,"strictly positive.\n");
+                return 0;
+            }
+        }
+    }
+    else
+    {
+        boolean=(pParameters->n_start==N_START);
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_start ");
+            fprintf(stderr,"variable of the structure pointed by ");
+            fprintf(stderr,"pParameters is not set to its default value ");
+            fprintf(stderr,"(=%d) although the current ",N_START);
+            fprintf(stderr,"optimization mode (=%d) ",pParameters->opt_mode);
+            fprintf(stderr,"does not require it.\nPlease delete the lines ");
+            fprintf(stderr,"containing the 'n_start' keyword and its list ");
+            fprintf(stderr,"of initial domains in ");
+            fprintf(stderr,"%s file.\n",pParameters->name_info);
+            return 0;
+        }
+    }
+
+    // Check pParameters->n_geom and the chemical files of the scan
+    if (pParameters->opt_mode<1)
+    {
+        boolean=(pParameters->n_geom>=0);
+        if (boolean && pParameters->n_geom>0)
+        {
+            boolean=(pParameters->name_geom!=NULL &&
+                     pParameters->name_mesh==NULL && pParameters->n_start==0);
+        }
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_geom ");
+            fprintf(stderr,"variable (=%d) of the ",pParameters->n_geom);
+            fprintf(stderr,"structure pointed by pParameters must be a ");
+            fprintf(stderr,"non-negative integer and, if positive, the ");
+            fprintf(stderr,"name_geom variable must have been read (and no ");
+            fprintf(stderr,"'name_mesh' nor 'n_start' keyword must be given ");
+            fprintf(stderr,"since the first geometry starts from the domain ");
+            fprintf(stderr,"of the ls_* keywords).\nPlease modify the ");
+            fprintf(stderr,"values accordingly after the 'n_geom' keyword ");
+            fprintf(stderr,"in %s file.\n",pParameters->name_info);
+            return 0;
+        }
+        for (i=0; i<pParameters->n_geom; i++)
+        {
+            lengthName=strlen(pParameters->name_geom[i]);
+            boolean=(lengthName>5);
+            if (boolean)
+            {
+                boolean=(!strcmp(pParameters->name_geom[i]+lengthName-5,
+                                                                   ".chem") ||
+                      !strcmp(pParameters->name_geom[i]+lengthName-4,".wfn"));
+            }
+            if (!boolean)
+            {
+                PRINT_ERROR("In checkValuesOfAllParameters: the ");
+                fprintf(stderr,"%d-th name ",i+1);
+                fprintf(stderr,"(=%s) given after ",pParameters->name_geom[i]);
+                fprintf(stderr,"the 'n_geom' keyword in ");
+                fprintf(stderr,"%s file must refer ",pParameters->name_info);
+                fprintf(stderr,"to a *.chem or *.wfn chemical file.\n");
+                return 0;
+            }
+        }
+    }
+    else
+    {
+        boolean=(pParameters->n_geom==N_GEOM);
+        if (!boolean)
+        {
+            PRINT_ERROR("In checkValuesOfAllParameters: the n_geom ");
+            fprintf(stderr,"variable of the structure pointed by ");
+            fprintf(stderr,"pParameters is not set to its default value ");
+            fprintf(stderr,"(=%d) although the current ",N_GEOM);
+            fprintf(stderr,"optimization mode (=%d) ",pParameters->opt_mode);
+            fprintf(stderr,"does not require it.\nPlease delete the lines ");
+            fprintf(stderr,"containing the 'n_geom' keyword and its list ");
+            fprintf(stderr,"of chemical files in ");
+            fprintf(stderr,"%s file.\n",pParameters->name_info);
+            return 0;
+        }
+    }
+
     // Check the variables related to the stop criteria
     boolean=(pParameters->iter_max>=0 && pParameters->iter_told0p>=0.);
     boolean=(boolean && pParameters->iter_told1p>=0.);
@@ -3241,12 +3754,15 @@ int checkValuesOfAllParameters(Parameters* pParameters)
     // Check the variables related to the saving of data
     boolean=(pParameters->save_type==0 || pParameters->save_type==1);
     boolean=(boolean || pParameters->save_type==2);
+    boolean=(boolean ||
+                      (pParameters->save_type==3 && pParameters->opt_mode<=0));
     if (!boolean)
     {
         PRINT_ERROR("In checkValuesOfAllParameters: the save_type variable ");
         fprintf(stderr,"(=%d) of the structure ",pParameters->save_type);
-        fprintf(stderr,"pointed by pParameters can only be set to 0, 1 or ");
-        fprintf(stderr,"2.\nPlease modify the value accordingly after the ");
+        fprintf(stderr,"pointed by pParameters can only be set to 0, 1, 2 ");
+        fprintf(stderr,"or 3 (the latter only if opt_mode is not positive).");
+        fprintf(stderr,"\nPlease modify the value accordingly after the ");
         fprintf(stderr,"'save_type' keyword in %s ",pParameters->name_info);
         fprintf(stderr,"file.\n");
         return 0;
@@ -3254,12 +3770,14 @@ int checkValuesOfAllParameters(Parameters* pParameters)
 
     boolean=(pParameters->save_mesh>=0 && pParameters->save_data>=0);
     boolean=(boolean && pParameters->save_print>=0);
+    boolean=(boolean && pParameters->save_check>=0);
     if (!boolean)
     {
         PRINT_ERROR("In checkValuesOfAllParameters: the save_mesh ");
         fprintf(stderr,"(=%d), save_data ",pParameters->save_mesh);
-        fprintf(stderr,"(=%d), and save_print ",pParameters->save_data);
-        fprintf(stderr,"(=%d) variables of the ",pParameters->save_print);
+        fprintf(stderr,"(=%d), save_print ",pParameters->save_data);
+        fprintf(stderr,"(=%d), and save_check ",pParameters->save_print);
+        fprintf(stderr,"(=%d) variables of the ",pParameters->save_check);
         fprintf(stderr,"structure pointed by pParameters must be ");
         fprintf(stderr,"non-negative integers.\nPlease modify the values ");
         fprintf(stderr,"accordingly after the corresponding keywords in ");
@@ -3279,6 +3797,19 @@ int checkValuesOfAllParameters(Parameters* pParameters)
         return 0;
     }
 
+    boolean=(pParameters->save_prof>=0 && pParameters->save_prof<3);
+    if (!boolean)
+    {
+        PRINT_ERROR("In checkValuesOfAllParameters: the save_prof variable ");
+        fprintf(stderr,"(=%d) of the structure ",pParameters->save_prof);
+        fprintf(stderr,"pointed by pParameters can only be set to 0 (no ");
+        fprintf(stderr,"profiling), 1 (JSON report), or 2 (CSV report).\n");
+        fprintf(stderr,"Please modify the value accordingly after the ");
+        fprintf(stderr,"'save_prof' keyword in ");
+        fprintf(stderr,"%s file.\n",pParameters->name_info);
+        return 0;
+    }
+
     // Check pParameters->path_length
     boolean=(pParameters->path_length>=DEF_MAX(2,PATH_LENGTH));
     if (!boolean)
@@ -4190,6 +4721,7 @@ int writingDefaultElasticFile(Parameters* pParameters)
 /* ************************************************************************** */
 int writingRestartFile(Parameters* pParameters)
 {
+    int i=0;
     size_t lengthName=0;
     char *fileName=NULL;
     FILE *restartFile=NULL;
@@ -4402,7 +4934,31 @@ int writingRestartFile(Parameters* pParameters)
     else
     {
         fprintf(restartFile,"trick_matrix %d \n",pParameters->trick_matrix);
-        fprintf(restartFile,"approx_mode %d \n\n",pParameters->approx_mode);
+        fprintf(restartFile,"approx_mode %d \n",pParameters->approx_mode);
+        fprintf(restartFile,"n_level %d \n",pParameters->n_level);
+        fprintf(restartFile,"n_prune %d \n\n",pParameters->n_prune);
+        if (pParameters->n_start>0)
+        {
+            fprintf(restartFile,"n_start %d \n",pParameters->n_start);
+            for (i=0; i<pParameters->n_start; i++)
+            {
+                fprintf(restartFile,"%d ",(int)pParameters->ls_start[5*i]);
+                fprintf(restartFile,"%.8le ",pParameters->ls_start[5*i+1]);
+                fprintf(restartFile,"%.8le ",pParameters->ls_start[5*i+2]);
+                fprintf(restartFile,"%.8le ",pParameters->ls_start[5*i+3]);
+                fprintf(restartFile,"%.8le \n",pParameters->ls_start[5*i+4]);
+            }
+            fprintf(restartFile,"\n");
+        }
+        if (pParameters->n_geom>0)
+        {
+            fprintf(restartFile,"n_geom %d \n",pParameters->n_geom);
+            for (i=0; i<pParameters->n_geom; i++)
+            {
+                fprintf(restartFile,"%s \n",pParameters->name_geom[i]);
+            }
+            fprintf(restartFile,"\n");
+        }
     }
 
     // Write variables related to the stop criteria
@@ -4415,6 +4971,8 @@ int writingRestartFile(Parameters* pParameters)
     fprintf(restartFile,"save_type %d \n",pParameters->save_type);
     fprintf(restartFile,"save_mesh %d \n",pParameters->save_mesh);
     fprintf(restartFile,"save_data %d \n",pParameters->save_data);
+    fprintf(restartFile,"save_check %d \n",pParameters->save_check);
+    fprintf(restartFile,"save_prof %d \n",pParameters->save_prof);
     fprintf(restartFile,"save_print %d \n",pParameters->save_print);
     fprintf(restartFile,"save_where %d \n\n",pParameters->save_where);
     fprintf(restartFile,"path_length %d \n",pParameters->path_length);
@@ -4650,3 +5208,284 @@ int loadParameters(Parameters* pParameters, char* nameInfo)
    return 1;
 }
 
+
+/* ************************************************************************** */
+// The function duplicateStringWithTag allocates a string of size lengthMax and
+// copies stringIn into it. If iTag is positive, a dot followed by tag and iTag
+// is inserted before the extension of the copied file name (e.g. h2.info
+// becomes h2.start3.info for tag="start" and iTag=3). It has the char* stringIn
+// variable, the address of the char* variable to allocate, the maximal length
+// allowed, the tag and its position as input arguments. It returns zero if an
+// error occurs, otherwise one is returned (*pStringOut points to NULL if
+// stringIn does)
+/* ************************************************************************** */
+int duplicateStringWithTag(char* stringIn, char** pStringOut, int lengthMax,
+                                                          char* tag, int iTag)
+{
+    int lengthIn=0, lengthBase=0, lengthOut=0;
+    char *pExtension=NULL;
+
+    // Testing if the input pStringOut and tag variables are pointing to NULL
+    if (pStringOut==NULL || tag==NULL)
+    {
+        PRINT_ERROR("In duplicateStringWithTag: the input pStringOut ");
+        fprintf(stderr,"(=%p) or tag ",(void*)pStringOut);
+        fprintf(stderr,"(=%p) variable does not point ",(void*)tag);
+        fprintf(stderr,"to a valid address.\n");
+        return 0;
+    }
+    *pStringOut=NULL;
+
+    // Nothing to copy if stringIn is pointing to NULL
+    if (stringIn==NULL)
+    {
+        return 1;
+    }
+
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    *pStringOut=(char*)calloc(lengthMax,sizeof(char));
+    if (*pStringOut==NULL)
+    {
+        PRINT_ERROR("In duplicateStringWithTag: could not allocate memory ");
+        fprintf(stderr,"for the (local) char* variable copying ");
+        fprintf(stderr,"%s string.\n",stringIn);
+        return 0;
+    }
+
+    // Locate the extension of the file name (if any) and copy the string
+    lengthIn=(int)strlen(stringIn);
+    lengthBase=lengthIn;
+    if (iTag>0)
+    {
+        pExtension=strrchr(stringIn,'.');
+        if (pExtension!=NULL)
+        {
+            lengthBase=(int)(pExtension-stringIn);
+        }
+        lengthOut=snprintf(*pStringOut,lengthMax,"%.*s.%s%d%s",lengthBase,
+                                  stringIn,tag,iTag,stringIn+lengthBase);
+    }
+    else
+    {
+        lengthOut=snprintf(*pStringOut,lengthMax,"%s",stringIn);
+    }
+
+    // snprintf function returns the number of characters that would have been
+    // written if the size had been large enough (not counting the final '\0')
+    if (lengthOut<0 || lengthOut>=lengthMax)
+    {
+        PRINT_ERROR("In duplicateStringWithTag: the copy of the ");
+        fprintf(stderr,"%s string tagged with %s%d ",stringIn,tag,iTag);
+        fprintf(stderr,"would have more than %d ",lengthMax-1);
+        fprintf(stderr,"letters, which is ");
+        fprintf(stderr,"the maximum size allowed here.\nPlease extend ");
+        fprintf(stderr,"properly the allowed length thanks to the ");
+        fprintf(stderr,"'name_length' or 'path_length' keyword.\n");
+        free(*pStringOut);
+        *pStringOut=NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function copyParametersWithTag copies the structure pointed by
+// pParameters into the one pointed by pCopyParameters, where the name_info,
+// name_data (and name_mesh) file names are tagged with a dot followed by tag
+// and iTag, and where all the strings are duplicated in order to be freed
+// independently (the lists of the multi-start and scan modes are not copied).
+// It has the two Parameters* variables (defined in main.h), the tag and its
+// (positive) position as input arguments and it returns zero if an error
+// occurs, otherwise one is returned in case of success
+/* ************************************************************************** */
+int copyParametersWithTag(Parameters* pParameters, Parameters* pCopyParameters,
+                                                          char* tag, int iTag)
+{
+    int boolean=0, nameLength=0, pathLength=0;
+
+    // Testing if the input variables are pointing to NULL
+    if (pParameters==NULL || pCopyParameters==NULL || tag==NULL || iTag<1)
+    {
+        PRINT_ERROR("In copyParametersWithTag: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pCopyParameters=%p, ",(void*)pCopyParameters);
+        fprintf(stderr,"or tag=%p does not point ",(void*)tag);
+        fprintf(stderr,"to a valid address, or iTag (=%d) is not ",iTag);
+        fprintf(stderr,"positive.\n");
+        return 0;
+    }
+
+    // Copy all the variables (without the lists of starts and geometries)
+    *pCopyParameters=*pParameters;
+    pCopyParameters->n_start=0;
+    pCopyParameters->ls_start=NULL;
+    pCopyParameters->n_geom=0;
+    pCopyParameters->name_geom=NULL;
+
+    // The pointers must not be shared with the structure pointed by pParameters
+    pCopyParameters->name_info=NULL;
+    pCopyParameters->name_data=NULL;
+    pCopyParameters->name_chem=NULL;
+    pCopyParameters->name_mesh=NULL;
+    pCopyParameters->name_elas=NULL;
+    pCopyParameters->path_medit=NULL;
+    pCopyParameters->path_mmg3d=NULL;
+    pCopyParameters->path_mshdist=NULL;
+    pCopyParameters->path_elastic=NULL;
+    pCopyParameters->path_advect=NULL;
+
+    // Duplicate the strings (the file names written with the copy are tagged)
+    nameLength=pParameters->name_length;
+    pathLength=pParameters->path_length;
+    boolean=duplicateStringWithTag(pParameters->name_info,
+                                   &pCopyParameters->name_info,nameLength,tag,
+                                                                          iTag);
+    boolean=(boolean && duplicateStringWithTag(pParameters->name_data,
+                                               &pCopyParameters->name_data,
+                                                      nameLength,tag,iTag));
+    boolean=(boolean && duplicateStringWithTag(pParameters->name_chem,
+                                               &pCopyParameters->name_chem,
+                                                         nameLength,tag,0));
+    boolean=(boolean && duplicateStringWithTag(pParameters->name_mesh,
+                                               &pCopyParameters->name_mesh,
+                                                      nameLength,tag,iTag));
+    boolean=(boolean && duplicateStringWithTag(pParameters->name_elas,
+                                               &pCopyParameters->name_elas,
+                                                         nameLength,tag,0));
+    boolean=(boolean && duplicateStringWithTag(pParameters->path_medit,
+                                               &pCopyParameters->path_medit,
+                                                         pathLength,tag,0));
+    boolean=(boolean && duplicateStringWithTag(pParameters->path_mmg3d,
+                                               &pCopyParameters->path_mmg3d,
+                                                         pathLength,tag,0));
+    boolean=(boolean && duplicateStringWithTag(pParameters->path_mshdist,
+                                             &pCopyParameters->path_mshdist,
+                                                         pathLength,tag,0));
+    boolean=(boolean && duplicateStringWithTag(pParameters->path_elastic,
+                                             &pCopyParameters->path_elastic,
+                                                         pathLength,tag,0));
+    boolean=(boolean && duplicateStringWithTag(pParameters->path_advect,
+                                              &pCopyParameters->path_advect,
+                                                         pathLength,tag,0));
+    if (!boolean)
+    {
+        PRINT_ERROR("In copyParametersWithTag: duplicateStringWithTag ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function copyParametersForStart copies the structure pointed by
+// pParameters into the one pointed by pStartParameters for the iStart-th start
+// of a multi-start run: the ls_* variables are set to the iStart-th initial
+// domain stored in pParameters->ls_start, the name_info, name_data (and
+// name_mesh) file names are tagged with '.start' followed by iStart, and all
+// the strings are duplicated in order to be freed independently. It has the two
+// Parameters* variables (defined in main.h) and the position of the start
+// (between one and pParameters->n_start) as input arguments and it returns zero
+// if an error occurs, otherwise one is returned in case of success
+/* ************************************************************************** */
+int copyParametersForStart(Parameters* pParameters,
+                                      Parameters* pStartParameters, int iStart)
+{
+    // Testing if the input variables are pointing to NULL
+    if (pParameters==NULL || pStartParameters==NULL)
+    {
+        PRINT_ERROR("In copyParametersForStart: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p ",(void*)pParameters);
+        fprintf(stderr,"or pStartParameters=%p ",(void*)pStartParameters);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
+
+    // Testing the position of the start
+    if (pParameters->ls_start==NULL || iStart<1 ||
+                                                  iStart>pParameters->n_start)
+    {
+        PRINT_ERROR("In copyParametersForStart: the input iStart variable ");
+        fprintf(stderr,"(=%d) should be an integer between one and ",iStart);
+        fprintf(stderr,"%d, and the ls_start ",pParameters->n_start);
+        fprintf(stderr,"variable (=%p) ",(void*)pParameters->ls_start);
+        fprintf(stderr,"of the structure pointed by pParameters must not ");
+        fprintf(stderr,"point to NULL.\n");
+        return 0;
+    }
+
+    // Copy all the variables and duplicate the strings
+    if (!copyParametersWithTag(pParameters,pStartParameters,"start",iStart))
+    {
+        PRINT_ERROR("In copyParametersForStart: copyParametersWithTag ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    // Set up the initial domain of the start
+    pStartParameters->ls_type=(int)pParameters->ls_start[5*(iStart-1)];
+    pStartParameters->ls_x=pParameters->ls_start[5*(iStart-1)+1];
+    pStartParameters->ls_y=pParameters->ls_start[5*(iStart-1)+2];
+    pStartParameters->ls_z=pParameters->ls_start[5*(iStart-1)+3];
+    pStartParameters->ls_r=pParameters->ls_start[5*(iStart-1)+4];
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function copyParametersForGeometry copies the structure pointed by
+// pParameters into the one pointed by pGeomParameters for the iGeom-th
+// geometry of a scan: the name_chem variable is set to the chemical file of
+// this geometry (the one of pParameters for the first geometry, the
+// (iGeom-1)-th one of pParameters->name_geom otherwise), the name_info,
+// name_data (and name_mesh) file names are tagged with '.geom' followed by
+// iGeom, and all the strings are duplicated in order to be freed
+// independently. It has the two Parameters* variables (defined in main.h) and
+// the position of the geometry (between one and pParameters->n_geom+1) as input
+// arguments and it returns zero if an error occurs, otherwise one is returned
+/* ************************************************************************** */
+int copyParametersForGeometry(Parameters* pParameters,
+                                        Parameters* pGeomParameters, int iGeom)
+{
+    // Testing if the input variables are pointing to NULL
+    if (pParameters==NULL || pGeomParameters==NULL)
+    {
+        PRINT_ERROR("In copyParametersForGeometry: at least one of the ");
+        fprintf(stderr,"input variables pParameters=%p ",(void*)pParameters);
+        fprintf(stderr,"or pGeomParameters=%p ",(void*)pGeomParameters);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
+
+    // Testing the position of the geometry
+    if (pParameters->name_geom==NULL || iGeom<1 ||
+                                                 iGeom>pParameters->n_geom+1)
+    {
+        PRINT_ERROR("In copyParametersForGeometry: the input iGeom variable ");
+        fprintf(stderr,"(=%d) should be an integer between one and ",iGeom);
+        fprintf(stderr,"%d, and the name_geom ",pParameters->n_geom+1);
+        fprintf(stderr,"variable (=%p) ",(void*)pParameters->name_geom);
+        fprintf(stderr,"of the structure pointed by pParameters must not ");
+        fprintf(stderr,"point to NULL.\n");
+        return 0;
+    }
+
+    // Copy all the variables and duplicate the strings
+    if (!copyParametersWithTag(pParameters,pGeomParameters,"geom",iGeom))
+    {
+        PRINT_ERROR("In copyParametersForGeometry: copyParametersWithTag ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    // Set up the chemical file of the geometry (the string has a size of
+    // name_length and name_geom has been checked in checkValuesOfAllParameters)
+    if (iGeom>1)
+    {
+        strncpy(pGeomParameters->name_chem,pParameters->name_geom[iGeom-2],
+                                                 pParameters->name_length-1);
+    }
+
+    return 1;
+}
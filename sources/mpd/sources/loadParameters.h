@@ -431,6 +431,73 @@
 */
 #define APPROX_MODE 0
 
+/**
+* \def N_LEVEL
+* \brief Used to set the default value for the n_level variable of the
+*        Parameters structure, which rules the coarse-to-fine mode of the
+*        hexahedral optimization.
+*
+* If set to a positive integer, the optimization starts on the grid given by
+* n_x, n_y, and n_z, and each time the stop criteria are satisfied, every
+* hexahedron is divided into eight (at most N_LEVEL times) before continuing the
+* optimization. The final grid thus has (n_x-1)*2^N_LEVEL+1 points in the
+* first-coordinate direction (and similarly in the other directions). We must
+* have (int)\ref N_LEVEL >= 0 (zero means that the grid is never refined).
+* Although we checked this condition, it will only be used if opt_mode=-2/-1/0
+* in the Parameters structure.
+*/
+#define N_LEVEL 0
+
+/**
+* \def N_PRUNE
+* \brief Used to set the default value for the n_prune variable of the
+*        Parameters structure, which rules the pruned version of the exhaustive
+*        search (opt_mode=-2) in the hexahedral optimization.
+*
+* If set to zero, every hexahedron touching the boundary of the domain is tried
+* at each iteration of the exhaustive search. Otherwise, the candidates are
+* sorted by decreasing order of the variation of the probability predicted by
+* the shape gradient at the boundary quadrilaterals, and the search stops after
+* N_PRUNE consecutive candidates that do not increase the probability. We must
+* have (int)\ref N_PRUNE >= 0. Although we checked this condition, it will only
+* be used if opt_mode=-2/0 in the Parameters structure.
+*/
+#define N_PRUNE 0
+
+/**
+* \def N_START
+* \brief Used to set the default value for the n_start variable of the
+*        Parameters structure, which is the number of initial domains optimized
+*        in the same run (multi-start mode) in the hexahedral optimization.
+*
+* If set to zero, only the initial domain given by the ls_* variables is
+* optimized. Otherwise, the 'n_start' keyword in the *.info file must be
+* followed by N_START lines 'ls_type ls_x ls_y ls_z ls_r', each one describing
+* an initial domain; all these domains are optimized in turn (one iteration
+* each) sharing the loaded chemistry, and the ones that cannot reach anymore the
+* best probability are cut off. We must have (int)\ref N_START >= 0. Although
+* we checked this condition, it will only be used if opt_mode=-2/-1/0 in the
+* Parameters structure.
+*/
+#define N_START 0
+
+/**
+* \def N_GEOM
+* \brief Used to set the default value for the n_geom variable of the
+*        Parameters structure, which is the number of next geometries of a scan
+*        (reaction path, bond scan) in the hexahedral optimization.
+*
+* If set to zero, only the geometry of the name_chem file is optimized.
+* Otherwise, the 'n_geom' keyword in the *.info file must be followed by N_GEOM
+* lines, each one giving the name of the (*.chem/ *.wfn) chemical file of the
+* next geometry. The geometries are optimized in the given order, each one
+* starting from the domain of the previous one, moved along the displacements
+* of the nuclei. We must have (int)\ref N_GEOM >= 0. Although we checked this
+* condition, it will only be used if opt_mode=-2/-1/0 in the Parameters
+* structure.
+*/
+#define N_GEOM 0
+
 
 // Related to the default stop criteria in the optimization loop
 /**
@@ -496,9 +563,10 @@
 *        format used by the MPD algorithm.
 *
 * If set to 1, then any output mesh is saved using the *.mesh format. If set
-* to 0, then any output mesh is saved using the *.cube format. Otherwise, it
-* must be set to 2 and in this case, any output mesh is saved in both *.cube and
-* *.mesh format.
+* to 0, then any output mesh is saved using the *.cube format. If set to 2, any
+* output mesh is saved in both *.cube and *.mesh format. Otherwise, it must be
+* set to 3 (only for hexahedral meshes) and in this case, the output meshes of
+* the optimization loop are appended in a compact *.hist history file.
 */
 #define SAVE_TYPE 1
 
@@ -527,6 +595,30 @@
 */
 #define SAVE_DATA 1
 
+/**
+* \def SAVE_CHECK
+* \brief Used to set the default value for the save_check variable of the
+*        Parameters structure, which thus rules the default frequency at which
+*        a binary checkpoint of the optimization loop is written.
+*
+* We must have (int)\ref SAVE_CHECK >= 0 (zero means that no checkpoint is
+* written). The *.chk file written every \ref SAVE_CHECK iterations stores the
+* parameters, the mesh, the data and the state of the loop so that the MPD
+* program launched on it resumes the optimization at the next iteration.
+*/
+#define SAVE_CHECK 0
+
+/**
+* \def SAVE_PROF
+* \brief Used to set the default value for the save_prof variable of the
+*        Parameters structure, which thus rules whether the run is profiled.
+*
+* We must have (int)\ref SAVE_PROF equal to zero (the run is not profiled), one
+* (the timings of the phases are written in the *.prof.json file at each
+* iteration) or two (same in the *.prof.csv file).
+*/
+#define SAVE_PROF 0
+
 /**
 * \def SAVE_PRINT
 * \brief Used to set the default value for the save_print variable of the
@@ -1048,7 +1140,7 @@ int setupDefaultParameters(Parameters* pParameters, char* nameInfo);
 *                             terminating nul one '\0'. They represents the
 *                             beginning of the (counter)-th keyword whose end
 *                             needs to be read properly. This keyword can be the
-*                             name of any variables (70 possibilities except
+*                             name of any variables (76 possibilities except
 *                             name_info which is replaced by the end_data
 *                             keyword, ending the reading in the *.info
 *                             file; any other information placed after will not
@@ -1065,7 +1157,7 @@ int setupDefaultParameters(Parameters* pParameters, char* nameInfo);
 *                    to the number of keywords that have already been
 *                    successfully read and the counter variable to the one whose
 *                    first two letters are stored in keywordBeginning. The
-*                    integer must be comprised between one and seventy
+*                    integer must be comprised between one and seventy-six
 *                    (case where all the variables of the Parameters structure
 *                    are specified, except the name_info one, already storing
 *                    the name of the *.info file given in the input command line
@@ -1137,7 +1229,7 @@ int getLengthAfterKeywordBeginning(char keywordBeginning[3], int counter);
 *                          needs to be specified in order to be read after
 *                          properly and securely the by fscanf standard
 *                          c-function. This keyword can be the name of any
-*                          variables (70 possibilities except name_info which
+*                          variables (76 possibilities except name_info which
 *                          is replaced by the end_data keyword, ending the
 *                          reading in the *.info file; any other information
 *                          placed after will not be read and considered as a
@@ -1163,11 +1255,11 @@ int getLengthAfterKeywordBeginning(char keywordBeginning[3], int counter);
 *                    successfully read and the counter variable to the one whose
 *                    is being evaluated by the \ref getTypeAfterKeyword
 *                    function. The integer must be comprised between one and
-*                    seventy (case where all the variables of the Parameters
-*                    structure are specified, except the name_info one, already
-*                    storing the name of the*.info file given in the input
-*                    command line of the MPD program, and replaced by the
-*                    end_data keyword, which ends the reading in the *.info
+*                    seventy-six (case where all the variables of the
+*                    Parameters structure are specified, except the name_info
+*                    one, already storing the name of the*.info file given in
+*                    the input command line of the MPD program, and replaced by
+*                    the end_data keyword, which ends the reading in the *.info
 *                    file; any other information placed after will not be read
 *                    and considered as a comment). Otherwise, an error is
 *                    returned by the \ref getTypeAfterKeyword function.
@@ -1220,7 +1312,7 @@ int getTypeAfterKeyword(char keywordMiddle[11], int lengthMiddle, int counter);
 *                          They represent the second part of the (counter)-th
 *                          keyword, whose third and final part needs to be read
 *                          properly. This keyword can be the name of any
-*                          variables (70 possibilities except name_info which
+*                          variables (76 possibilities except name_info which
 *                          is replaced by the end_data keyword, ending the
 *                          reading in the *.info file; any other information
 *                          placed after will not be read and considered as a
@@ -1246,7 +1338,7 @@ int getTypeAfterKeyword(char keywordMiddle[11], int lengthMiddle, int counter);
 *                    successfully read and the counter variable to the one whose
 *                    last letters need to be read properly by the \ref
 *                    getLengthAfterKeywordMiddle function. The integer must be
-*                    comprised between one and seventy (case where all the
+*                    comprised between one and seventy-six (case where all the
 *                    variables of the Parameters structure are specified, except
 *                    the name_info one, already storing the name of the*.info
 *                    file given in the input command line of the MPD program,
@@ -1297,7 +1389,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
                                                                    int counter);
 
 /**
-* \fn int detectRepetition(int repetition[70], char keywordBeginning[3],
+* \fn int detectRepetition(int repetition[76], char keywordBeginning[3],
 *                          char keywordMiddle[11], char keywordEnd[6],
 *                                  int lengthMiddle, int lengthEnd, int counter)
 * \brief It adds one in the array repetition at the location corresponding to
@@ -1306,7 +1398,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 *        keywordBeginning has length two, keywordMiddle has lengthMiddle and
 *        keywordEnd has lengthEnd.
 *
-* \param[out] repetition An array of seventy integers saving the number of
+* \param[out] repetition An array of seventy-six integers saving the number of
 *                        occurences of the corresponding keywords in the *.info
 *                        file. The keyword position in the array is the one
 *                        given in the structure Parameters, except for the
@@ -1323,7 +1415,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 *                             beginning of the (counter)-th keyword whose
 *                             potential repetition in the upper part of the
 *                             *.info file is intended to be detected. This
-*                             keyword can be the name of any variables (70
+*                             keyword can be the name of any variables (76
 *                             possibilities except name_info which is replaced
 *                             by the end_data keyword, ending the reading in
 *                             the *.info file; any other information placed
@@ -1338,7 +1430,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 *                          They represent the second part of the (counter)-th
 *                          keyword, whose final part is stored in keywordEnd
 *                          (only if lengthEnd>1). This keyword can be the name
-*                          of any variables (70 possibilities except name_info
+*                          of any variables (76 possibilities except name_info
 *                          which is replaced by the end_data keyword, ending
 *                          the reading in the *.info file; any other information
 *                          placed after will not be read and considered as a
@@ -1353,7 +1445,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 *                       lengthEnd>1, they represent the third part of the
 *                       (counter)-th keyword, whose occurence is intented to be
 *                       incremented by one in the array repetition. This
-*                       keyword can be the name of any variables (70
+*                       keyword can be the name of any variables (76
 *                       possibilities except name_info which is replaced by the
 *                       end_data keyword, ending the reading in the *.info file;
 *                       any other information placed after will not be read and
@@ -1389,7 +1481,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 *                    to the number of keywords that have already been
 *                    successfully read and the counter variable to the one *                    whose occurence is intented to be incremented by one in
 *                    the array repetition by the \ref detectRepetition function.
-*                    The integer must be comprised between one and seventy
+*                    The integer must be comprised between one and seventy-six
 *                    (case where all the variables of the Parameters structure
 *                    are specified, except the name_info one, already storing
 *                    the name of the*.info file given in the input command line
@@ -1409,7 +1501,7 @@ int getLengthAfterKeywordMiddle(char keywordMiddle[11], int lengthMiddle,
 * The \ref detectRepetition function should be static but has been defined as
 * non-static in order to perform unit-test on it.
 */
-int detectRepetition(int repetition[70], char keywordBeginning[3],
+int detectRepetition(int repetition[76], char keywordBeginning[3],
                      char keywordMiddle[11], char keywordEnd[6],
                                   int lengthMiddle, int lengthEnd, int counter);
 
@@ -1453,7 +1545,7 @@ int detectRepetition(int repetition[70], char keywordBeginning[3],
 *                             beginning of the (counter)-th keyword whose
 *                             associated value needs to be properly stored in
 *                             the structure pointed by pParameters. This
-*                             keyword can be the name of any variables (70
+*                             keyword can be the name of any variables (76
 *                             possibilities except name_info, already storing
 *                             the name of the *.info file given in the input
 *                             command line of the MPD program, and which is
@@ -1471,7 +1563,7 @@ int detectRepetition(int repetition[70], char keywordBeginning[3],
 *                          They represent the second part of the (counter)-th
 *                          keyword, whose final part is stored in keywordEnd
 *                          (only if lengthEnd>1). This keyword can be the name
-*                          of any variables (70 possibilities except name_info
+*                          of any variables (76 possibilities except name_info
 *                          which is replaced by the end_data keyword, ending
 *                          the reading in the *.info file; any other information
 *                          placed after will not be read and considered as a
@@ -1487,7 +1579,7 @@ int detectRepetition(int repetition[70], char keywordBeginning[3],
 *                       (counter)-th keyword, whose associated value needs to
 *                       be properly stored in the structure pointed by
 *                       pParameters. This keyword can be the name of any
-*                       variables (70 possibilities except name_info which is
+*                       variables (76 possibilities except name_info which is
 *                       replaced by the end_data keyword, ending the reading in
 *                       the *.info file; any other information placed after will
 *                       not be read and considered as a comment) stored in the
@@ -1532,8 +1624,8 @@ int detectRepetition(int repetition[70], char keywordBeginning[3],
 *                    to the number of keywords that have already been
 *                    successfully read and the counter variable to the one, *                    whose values is intended to be stored in the structure
 *                    pointed by pParameters. The integer must be comprised
-*                    between one and seventy (case where all the variables of
-*                    the Parameters structure are specified, except the
+*                    between one and seventy-six (case where all the variables
+*                    of the Parameters structure are specified, except the
 *                    name_info one, already storing the name of the*.info file
 *                    given in the input command line of the MPD program, and
 *                    replaced by the end_data keyword, which ends the reading
@@ -1576,6 +1668,61 @@ int changeValuesOfParameters(Parameters* pParameters, char keywordBeginning[3],
                              int lengthEnd, int counter, int readIntegerIn,
                                                              double readDouble);
 
+/**
+* \fn int readListOfStarts(Parameters* pParameters, FILE* infoFile)
+* \brief It reads the list of initial domains following the 'n_start' keyword
+*        (and its value) in the *.info file, and stores it in the ls_start
+*        variable of the structure pointed by pParameters.
+*
+* \param[in,out] pParameters A pointer that points to the Parameters structure
+*                            (defined in main.h file) of the \ref main function.
+*                            Its n_start variable must have been read before;
+*                            if it is positive, the ls_start variable is
+*                            allocated and filled with the n_start lines
+*                            'ls_type ls_x ls_y ls_z ls_r' read in infoFile.
+*
+* \param[in] infoFile A pointer to the *.info file opened by the \ref
+*                     readInfoFileAndGetParameters function, just after the
+*                     value of the 'n_start' keyword.
+*
+* \return It returns one if the list of initial domains has been successfully
+*         read (or if n_start is not positive). Otherwise, zero is returned if
+*         the allocation of memory failed or if one of the n_start lines does
+*         not contain the five expected values.
+*
+* The \ref readListOfStarts function should be static but has been defined as
+* non-static in order to perform unit-test on it.
+*/
+int readListOfStarts(Parameters* pParameters, FILE* infoFile);
+
+/**
+* \fn int readListOfGeometries(Parameters* pParameters, FILE* infoFile)
+* \brief It reads the list of chemical files following the 'n_geom' keyword
+*        (and its value) in the *.info file, and stores it in the name_geom
+*        variable of the structure pointed by pParameters.
+*
+* \param[in,out] pParameters A pointer that points to the Parameters structure
+*                            (defined in main.h file) of the \ref main function.
+*                            Its n_geom variable must have been read before;
+*                            if it is positive, the name_geom variable is
+*                            allocated and filled with the n_geom names read in
+*                            infoFile (one per line, each one having less than
+*                            name_length characters).
+*
+* \param[in] infoFile A pointer to the *.info file opened by the \ref
+*                     readInfoFileAndGetParameters function, just after the
+*                     value of the 'n_geom' keyword.
+*
+* \return It returns one if the list of chemical files has been successfully
+*         read (or if n_geom is not positive). Otherwise, zero is returned if
+*         the allocation of memory failed, or if one of the n_geom names is
+*         missing or too long.
+*
+* The \ref readListOfGeometries function should be static but has been defined
+* as non-static in order to perform unit-test on it.
+*/
+int readListOfGeometries(Parameters* pParameters, FILE* infoFile);
+
 /**
 * \fn int readInfoFileAndGetParameters(Parameters* pParameters)
 * \brief It tries to read the content of an existing the *.info (input) file
@@ -1711,5 +1858,124 @@ int writingDefaultElasticFile(Parameters* pParameters);
 */
 int writingRestartFile(Parameters* pParameters);
 
-#endif
+/**
+* \fn int duplicateStringWithTag(char* stringIn, char** pStringOut,
+*                                          int lengthMax, char* tag, int iTag)
+* \brief It allocates a new string and copies the input one into it, tagging
+*        the file name with a tag and a position (multi-start and scan modes).
+*
+* \param[in] stringIn A pointer to the string to copy (it can point to NULL).
+*
+* \param[out] pStringOut A pointer to the char* variable which is allocated
+*                        (with a size of lengthMax) and filled with the copy of
+*                        stringIn; it is set to NULL if stringIn is NULL.
+*
+* \param[in] lengthMax The maximal length allowed for the copied string (the
+*                      name_length or path_length variable of the Parameters
+*                      structure).
+*
+* \param[in] tag A pointer to the tag ("start" or "geom") of the file name.
+*
+* \param[in] iTag If positive, a dot followed by tag and iTag is inserted
+*                 before the extension of the copied file name (e.g. h2.info
+*                 becomes h2.start3.info for tag="start" and iTag=3).
+*                 Otherwise, stringIn is simply copied.
+*
+* \return It returns one if the string has been successfully copied. Otherwise,
+*         zero is returned if the allocation of memory failed or if the copied
+*         string does not fit in lengthMax characters.
+*/
+int duplicateStringWithTag(char* stringIn, char** pStringOut, int lengthMax,
+                                                          char* tag, int iTag);
 
+/**
+* \fn int copyParametersWithTag(Parameters* pParameters,
+*                           Parameters* pCopyParameters, char* tag, int iTag)
+* \brief It copies the Parameters structure of the run into a new one whose
+*        output files are tagged (used by the multi-start and scan modes).
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        (defined in main.h file) of the \ref main function.
+*
+* \param[out] pCopyParameters A pointer that points to the Parameters structure
+*                             to fill. All the variables of pParameters are
+*                             copied, except n_start and n_geom (set to zero)
+*                             and their lists (set to NULL). The strings are
+*                             duplicated, and the name_info, name_data (and
+*                             name_mesh) file names are tagged with a dot
+*                             followed by tag and iTag.
+*
+* \param[in] tag A pointer to the tag ("start" or "geom") of the file names.
+*
+* \param[in] iTag The (positive) position added after the tag.
+*
+* \return It returns one if the Parameters structure has been successfully
+*         copied. Otherwise, zero is returned if an error is encountered in the
+*         process (the strings already duplicated must still be freed with the
+*         \ref freeParameterMemory function).
+*/
+int copyParametersWithTag(Parameters* pParameters, Parameters* pCopyParameters,
+                                                          char* tag, int iTag);
+
+/**
+* \fn int copyParametersForStart(Parameters* pParameters,
+*                                     Parameters* pStartParameters, int iStart)
+* \brief It builds the Parameters structure of one start in multi-start mode
+*        (n_start positive) from the one of the run.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        (defined in main.h file) of the \ref main function.
+*                        Its ls_start variable must store the n_start initial
+*                        domains read in the *.info file.
+*
+* \param[out] pStartParameters A pointer that points to the Parameters
+*                              structure of the start. It is filled by the
+*                              \ref copyParametersWithTag function with the
+*                              '.start' tag followed by iStart, so that each
+*                              start writes its own output files, and its ls_*
+*                              variables are set to the iStart-th initial
+*                              domain.
+*
+* \param[in] iStart The position of the start, which must be an integer
+*                   between one and pParameters->n_start.
+*
+* \return It returns one if the Parameters structure of the start has been
+*         successfully built. Otherwise, zero is returned if an error is
+*         encountered in the process (the strings already duplicated must still
+*         be freed with the \ref freeParameterMemory function).
+*/
+int copyParametersForStart(Parameters* pParameters,
+                                     Parameters* pStartParameters, int iStart);
+
+/**
+* \fn int copyParametersForGeometry(Parameters* pParameters,
+*                                       Parameters* pGeomParameters, int iGeom)
+* \brief It builds the Parameters structure of one geometry in scan mode
+*        (n_geom positive) from the one of the run.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        (defined in main.h file) of the \ref main function.
+*                        Its name_geom variable must store the n_geom chemical
+*                        files read in the *.info file.
+*
+* \param[out] pGeomParameters A pointer that points to the Parameters structure
+*                             of the geometry. It is filled by the \ref
+*                             copyParametersWithTag function with the '.geom'
+*                             tag followed by iGeom, so that each geometry
+*                             writes its own output files, and its name_chem
+*                             variable is set to the chemical file of the
+*                             geometry.
+*
+* \param[in] iGeom The position of the geometry, which must be an integer
+*                  between one (the geometry of the name_chem file) and
+*                  pParameters->n_geom+1.
+*
+* \return It returns one if the Parameters structure of the geometry has been
+*         successfully built. Otherwise, zero is returned if an error is
+*         encountered in the process (the strings already duplicated must still
+*         be freed with the \ref freeParameterMemory function).
+*/
+int copyParametersForGeometry(Parameters* pParameters,
+                                       Parameters* pGeomParameters, int iGeom);
+
+#endif
@@ -44,6 +44,20 @@
 */
 time_t globalInitialTimer=0;
 
+/**
+* \var globalSnapshotWriter
+* \brief Global variable storing the background writer of the mesh snapshots
+*        of the optimization loop (inactive until \ref startSnapshotWriter).
+*/
+SnapshotWriter globalSnapshotWriter;
+
+/**
+* \var globalProfiler
+* \brief Global variable storing the profiler of the run (inactive until
+*        \ref startProfiler is called with a positive save_prof value).
+*/
+Profiler globalProfiler;
+
 /**
 * \def STR_PHASE
 * \brief Used to frame some important informations during the MPD algorithm.
@@ -79,17 +93,21 @@ time_t globalInitialTimer=0;
 // Macro functions to initialize and end properly the main function
 /* ************************************************************************** */
 /**
-* \def INITIALIZE_MAIN_STRUCTURES(parameters,chemicalSystem,data,mesh,argc)
+* \def INITIALIZE_MAIN_STRUCTURES(parameters,chemicalSystem,data,mesh,argc,
+*                                                                        argv)
 * \brief Used to initialize the \ref main function of the MPD program.
 *
 * It starts the global timer, sets up the tracking of anormal-stop signals via
 * the \ref commentAnormalEnd function, forces the program to execute \ref
 * endTimerAtExit function when the program stops, prints some basic informations
 * about the MPD program, checks that the standard input stream (argc and argv
-* arguments of the \ref main function) contain only one argument, and sets to
-* zero all the main structures (Parameters, ChemicalSystem, Data, and Mesh).
+* arguments of the \ref main function) contain only one argument (or the
+* '-batch' option followed by a manifest file and optionally the number of
+* cores), and sets to zero all the main structures (Parameters, ChemicalSystem,
+* Data, and Mesh).
 */
-#define INITIALIZE_MAIN_STRUCTURES(parameters,chemicalSystem,data,mesh,argc)   \
+#define INITIALIZE_MAIN_STRUCTURES(parameters,chemicalSystem,data,mesh,argc,   \
+                                                                       argv)   \
 do {                                                                           \
     time(&globalInitialTimer);                                                 \
     atexit(endTimerAtExit);                                                    \
@@ -103,7 +121,7 @@ do {                                                                           \
     fprintf(stdout,"Released version %s ",STR_VERSION);                        \
     fprintf(stdout,"(%s).\nCopyright (c) %s. ",STR_RELEASE,STR_COPYRIGHT);     \
     fprintf(stdout,"Author: %s.\n%s\n",STR_AUTHOR,STR_PHASE);                  \
-    if ((argc)!=2)                                                             \
+    if ((argc)!=2 && ((argc)<3 || (argc)>4 || strcmp((argv)[1],"-batch")))     \
     {                                                                          \
         fprintf(stderr,"\nError encountered at line %d in ",__LINE__);         \
         fprintf(stderr,"%s file on %s",__FILE__,ctime(&globalInitialTimer));   \
@@ -118,7 +136,14 @@ do {                                                                           \
         fprintf(stderr,"start with, preceded by the 'name_mesh' keyword. ");   \
         fprintf(stderr,"The *.info file must end with the 'end_data' ");       \
         fprintf(stderr,"keyword and any other informations placed after ");    \
-        fprintf(stderr,"will not be read and considered as comments.\n");      \
+        fprintf(stderr,"will not be read and considered as comments. In ");    \
+        fprintf(stderr,"batch mode, the '-batch' option must be followed ");   \
+        fprintf(stderr,"by the manifest file listing the *.info files, and "); \
+        fprintf(stderr,"optionally by the number of cores to use. The ");      \
+        fprintf(stderr,"binary caches of the chemical files (*.chemb) are ");  \
+        fprintf(stderr,"written in the current working directory, unless ");   \
+        fprintf(stderr,"the %s environment variable ",CHEM_CACHE_DIRECTORY);   \
+        fprintf(stderr,"gives another directory.\n");                         \
     }                                                                          \
     initializeParameterStructure(parameters);                                  \
     initializeChemicalStructure(chemicalSystem);                               \
@@ -130,12 +155,17 @@ do {                                                                           \
 * \def FREE_AND_RETURN(parameters,chemicalSystem,data,mesh,valueToReturn)
 * \brief Used to end the \ref main function of the MPD program.
 *
-* It frees the memory dynamically allocated for the main structures (Parameters,
+* It first waits for the mesh snapshots still queued in the
+* \ref globalSnapshotWriter variable (they point to the ChemicalSystem
+* structure), writes the summary of the \ref globalProfiler variable, frees
+* the memory dynamically allocated for the main structures (Parameters,
 * ChemicalSystem, Data, and Mesh) and finally returns the ouput value
 * (valueToReturn) of the \ref main function.
 */
 #define FREE_AND_RETURN(parameters,chemicalSystem,data,mesh,valueToReturn)     \
 do {                                                                           \
+    stopSnapshotWriter(&globalSnapshotWriter);                                 \
+    stopProfiler(&globalProfiler);                                             \
     freeMeshMemory(mesh);                                                      \
     freeDataMemory(data);                                                      \
     freeChemicalMemory(chemicalSystem);                                        \
@@ -156,6 +186,9 @@ do {                                                                           \
     fprintf(stdout,".\n");                                                     \
 } while (0)
 
+// The mpdBenchmark program (benchmark.c) is built from the same files with
+// the MPD_BENCHMARK preprocessor constant and provides its own main function
+#ifndef MPD_BENCHMARK
 /* ************************************************************************** */
 // The function main performs on a given initial domain in a computational box
 // (mesh variable) (parameter.)iter_max deformations to maximize the probability
@@ -175,16 +208,19 @@ int main(int argc, char *argv[])
     time_t startLocalTimer=0, endLocalTimer=0;
     size_t lengthName=0;
     char* fileLocation=NULL;
-    int i=0, j=0, optMode=0, iStop=0, jPlus=0, jMoins=0;
+    int i=0, j=0, optMode=0, iStop=0, jPlus=0, jMoins=0, nCore=0;
+    int iProfile=0, returnValue=0;
     double d0p=0., d1p=0., d2p=0., deltaT=0.;
     Parameters parameters;
     ChemicalSystem chemicalSystem;
     Data data;
     Mesh mesh;
+    Checkpoint checkpoint;
 
     // Initialize the main structures to zero (nothing should be placed before)
-    INITIALIZE_MAIN_STRUCTURES(&parameters,&chemicalSystem,&data,&mesh,argc);
-    if (argc!=2)
+    INITIALIZE_MAIN_STRUCTURES(&parameters,&chemicalSystem,&data,&mesh,argc,
+                                                                          argv);
+    if (argc!=2 && (argc<3 || argc>4 || strcmp(argv[1],"-batch")))
     {
         FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
     }
@@ -224,6 +260,33 @@ int main(int argc, char *argv[])
         FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
     }
 
+    // Batch mode: the *.info files listed in the manifest file argv[2] are run
+    // on a pool of argv[3] cores (the number of online processors by default)
+    if (argc!=2)
+    {
+        nCore=0;
+        if (argc==4)
+        {
+            nCore=atoi(argv[3]);
+            if (nCore<1)
+            {
+                PRINT_ERROR("In main: the number of cores (=");
+                fprintf(stderr,"%s) given after the manifest file ",argv[3]);
+                fprintf(stderr,"should be a positive integer.\n");
+                FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+            }
+        }
+        if (!runBatchOfJobs(argv[0],argv[2],nCore))
+        {
+            PRINT_ERROR("In main: runBatchOfJobs function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
+        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_SUCCESS);
+    }
+
     // NEW: change if necessary the name of the *.input file into a *.info one
     // calloc returns a pointer to the allocated memory, or NULL if it fails
     // strlen returns the length of the string but not including the '\0'
@@ -274,8 +337,24 @@ int main(int argc, char *argv[])
         }
     }
 
-    // Load parameters from a *.info (input) file pointed by argv[1]
-    if (!loadParameters(&parameters,fileLocation))
+    // Load parameters from a *.info (input) file pointed by argv[1], or the
+    // whole state of an interrupted run from a *.chk (checkpoint) file
+    checkpoint.iter=0;
+    lengthName=strlen(fileLocation);
+    if (lengthName>4 && !strcmp(fileLocation+lengthName-4,".chk"))
+    {
+        if (!readCheckpointFile(fileLocation,&parameters,&mesh,&data,
+                                                                  &checkpoint))
+        {
+            PRINT_ERROR("In main: readCheckpointFile function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            free(fileLocation);
+            fileLocation=NULL;
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
+    }
+    else if (!loadParameters(&parameters,fileLocation))
     {
         PRINT_ERROR("In main: loadParameters function returned zero instead ");
         fprintf(stderr,"of one.\n");
@@ -296,98 +375,240 @@ int main(int argc, char *argv[])
     }
     omp_set_num_threads(parameters.n_cpu);
 
+    // Start the profiler of the run (inactive if parameters.save_prof is zero)
+    if (!startProfiler(&globalProfiler,&parameters))
+    {
+        PRINT_ERROR("In main: startProfiler function returned zero instead ");
+        fprintf(stderr,"of one.\n");
+        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
+    }
+    beginProfilerPhase(&globalProfiler,PROF_SETUP);
+
+    // In scan mode, keep the name of the chemical file of the first geometry
+    // for its summary since loadChemistry replaces it by its *.chem copy
+    // (calloc function returns a pointer to the allocated memory, otherwise
+    // NULL)
+    if (parameters.n_geom>0)
+    {
+        fileLocation=(char*)calloc(parameters.name_length,sizeof(char));
+        if (fileLocation==NULL)
+        {
+            PRINT_ERROR("In main: could not allocate memory for the local ");
+            fprintf(stderr,"(char*) fileLocation variable.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
+        strncpy(fileLocation,parameters.name_chem,parameters.name_length-1);
+    }
+
     // Load chemistry from a *.chem/ *.wfn file pointed by parameters.name_chem
     if (!loadChemistry(&parameters,&chemicalSystem))
     {
         PRINT_ERROR("In main: loadChemistry function returned zero instead ");
         fprintf(stderr,"of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
         FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
     }
 
-    // Load default mesh or from the *.mesh/ *.cube file of parameters.name_mesh
-    switch (loadMesh(&parameters,&mesh))
+    // Multi-start mode: the n_start initial domains share the chemistry (the
+    // setup of each start is recorded separately by the profiler)
+    if (parameters.n_start>0)
     {
-        case -1:
-            if (!writingCubeFile(&parameters,&chemicalSystem,&mesh))
-            {
-                PRINT_ERROR("In main: writingCubeFile function returned zero ");
-                fprintf(stderr,"instead of one.\n");
-                FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
-                                                                  EXIT_FAILURE);
-            }
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        if (!startSnapshotWriter(&globalSnapshotWriter))
+        {
+            fprintf(stdout,"\nWarning in main function: startSnapshotWriter ");
+            fprintf(stdout,"function returned zero instead of one. The mesh ");
+            fprintf(stdout,"snapshots will be written synchronously.\n");
+        }
+
+        if (!multiStartOptimization(&parameters,&chemicalSystem,
+                                                           &globalInitialTimer))
+        {
+            PRINT_ERROR("In main: multiStartOptimization function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+            stopSnapshotWriter(&globalSnapshotWriter);
             FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
-                                                                  EXIT_SUCCESS);
-            break;
+                                                                  EXIT_FAILURE);
+        }
 
-        case 1:
-            if (!writingCubeFile(&parameters,&chemicalSystem,&mesh))
-            {
-                PRINT_ERROR("In main: writingCubeFile function returned zero ");
-                fprintf(stderr,"instead of one.\n");
-                FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+        if (!stopSnapshotWriter(&globalSnapshotWriter))
+        {
+            PRINT_ERROR("In main: stopSnapshotWriter function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
                                                                   EXIT_FAILURE);
-            }
+        }
 
-            PRINT_LOCAL_TIME(-1,STR_PHASE,globalInitialTimer,endLocalTimer);
-            fprintf(stdout,"PARAMETERS, CHEMISTRY, AND MESH STRUCTURES ");
-            fprintf(stdout,"SUCCESSFULLY INITIALIZED.\n%s\n",STR_PHASE);
+        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_SUCCESS);
+    }
 
-            // If pParameters->save_print==0, graphic and prompt mode is off
-            if (parameters.save_print)
-            {
-                // Vizualize the mesh of the initial cube with medit (Warning:
-                // the medit software must have been previously installed)
-                if (!plotMeshWithMeditSoftware(&parameters))
-                {
-                    PRINT_ERROR("In main: plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+    // Scan mode: each geometry starts from the domain of the previous one
+    if (parameters.n_geom>0)
+    {
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        if (!startSnapshotWriter(&globalSnapshotWriter))
+        {
+            fprintf(stdout,"\nWarning in main function: startSnapshotWriter ");
+            fprintf(stdout,"function returned zero instead of one. The mesh ");
+            fprintf(stdout,"snapshots will be written synchronously.\n");
+        }
+
+        returnValue=scanOptimization(&parameters,&chemicalSystem,
+                                             fileLocation,&globalInitialTimer);
+        free(fileLocation);
+        fileLocation=NULL;
+        if (!returnValue)
+        {
+            PRINT_ERROR("In main: scanOptimization function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
                                                                   EXIT_FAILURE);
-                }
-            }
-        break;
+        }
 
-        default:
-            PRINT_ERROR("In main: loadMesh function returned zero instead ");
-            fprintf(stderr,"of (+/-)one.\n");
+        if (!stopSnapshotWriter(&globalSnapshotWriter))
+        {
+            PRINT_ERROR("In main: stopSnapshotWriter function returned zero ");
+            fprintf(stderr,"instead of one.\n");
             FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
                                                                   EXIT_FAILURE);
-            break;
+        }
+
+        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_SUCCESS);
     }
 
-    // Prepare the mesh for the optimization loop (initialize the level-set
-    // function and perform some mesh adaptations if necessary)
-    time(&startLocalTimer);
-    if (!adaptMesh(&parameters,&mesh,&chemicalSystem))
+    // Start the background thread writing the mesh snapshots of the loop (if
+    // it fails, the snapshots are simply written by the main thread)
+    if (!startSnapshotWriter(&globalSnapshotWriter))
     {
-        PRINT_ERROR("In main: adaptMesh function returned zero instead of ");
-        fprintf(stderr,"one.\n");
-        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
+        fprintf(stdout,"\nWarning in main function: startSnapshotWriter ");
+        fprintf(stdout,"function returned zero instead of one. The mesh ");
+        fprintf(stdout,"snapshots will be written synchronously.\n");
     }
 
-    if (!setupInitialData(&parameters,&mesh,&data,&chemicalSystem,
-                           &globalInitialTimer,&startLocalTimer,&endLocalTimer))
+    // Restart the optimization loop from the state saved in the *.chk file
+    if (checkpoint.iter>0)
     {
-        PRINT_ERROR("In main: setupInitialData function returned zero ");
-        fprintf(stderr,"instead of one.\n");
-        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
+        if (!restartFromCheckpoint(&parameters,&mesh,&data,&chemicalSystem,
+                                             &checkpoint,&globalInitialTimer))
+        {
+            PRINT_ERROR("In main: restartFromCheckpoint function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
+        optMode=checkpoint.optMode;
+        iStop=checkpoint.iStop;
+        d0p=checkpoint.d0p;
+        d1p=checkpoint.d1p;
+        d2p=checkpoint.d2p;
+        deltaT=checkpoint.deltaT;
+
+        fprintf(stdout,"\n%s\nOPTIMIZATION LOOP RESTARTED AFTER ",STR_PHASE);
+        fprintf(stdout,"ITERATION %d (PROBABILITY: ",checkpoint.iter);
+        fprintf(stdout,"%.8lf).\n%s\n",data.pnu[checkpoint.iter],STR_PHASE);
     }
+    else
+    {
+        // Load default mesh or from the *.mesh/ *.cube file of
+        // parameters.name_mesh
+        switch (loadMesh(&parameters,&mesh))
+        {
+            case -1:
+                if (!writingCubeFile(&parameters,&chemicalSystem,&mesh))
+                {
+                    PRINT_ERROR("In main: writingCubeFile function returned ");
+                    fprintf(stderr,"zero instead of one.\n");
+                    FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+                }
+                FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_SUCCESS);
+                break;
+
+            case 1:
+                if (!writingCubeFile(&parameters,&chemicalSystem,&mesh))
+                {
+                    PRINT_ERROR("In main: writingCubeFile function returned ");
+                    fprintf(stderr,"zero instead of one.\n");
+                    FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+                }
+
+                PRINT_LOCAL_TIME(-1,STR_PHASE,globalInitialTimer,endLocalTimer);
+                fprintf(stdout,"PARAMETERS, CHEMISTRY, AND MESH STRUCTURES ");
+                fprintf(stdout,"SUCCESSFULLY INITIALIZED.\n%s\n",STR_PHASE);
+
+                // If pParameters->save_print==0, graphic and prompt mode is off
+                if (parameters.save_print)
+                {
+                    // Vizualize the mesh of the initial cube with medit
+                    // (Warning: the medit software must have been previously
+                    // installed)
+                    if (!plotMeshWithMeditSoftware(&parameters))
+                    {
+                        PRINT_ERROR("In main: plotMeshWithMeditSoftware ");
+                        fprintf(stderr,"function returned zero instead of ");
+                        fprintf(stderr,"one.\n");
+                        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+                    }
+                }
+            break;
+
+            default:
+                PRINT_ERROR("In main: loadMesh function returned zero ");
+                fprintf(stderr,"instead of (+/-)one.\n");
+                FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+                break;
+        }
+
+        // Prepare the mesh for the optimization loop (initialize the level-set
+        // function and perform some mesh adaptations if necessary)
+        time(&startLocalTimer);
+        if (!adaptMesh(&parameters,&mesh,&chemicalSystem))
+        {
+            PRINT_ERROR("In main: adaptMesh function returned zero instead ");
+            fprintf(stderr,"of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
 
-    PRINT_LOCAL_TIME(0,STR_PHASE,startLocalTimer,endLocalTimer);
-    fprintf(stdout,"MESH ADAPTED AND INITIAL DOMAIN READY FOR THE ");
-    fprintf(stdout,"OPTIMIZATION LOOP.\n%s\n",STR_PHASE);
+        if (!setupInitialData(&parameters,&mesh,&data,&chemicalSystem,
+                           &globalInitialTimer,&startLocalTimer,&endLocalTimer))
+        {
+            PRINT_ERROR("In main: setupInitialData function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
+
+        PRINT_LOCAL_TIME(0,STR_PHASE,startLocalTimer,endLocalTimer);
+        fprintf(stdout,"MESH ADAPTED AND INITIAL DOMAIN READY FOR THE ");
+        fprintf(stdout,"OPTIMIZATION LOOP.\n%s\n",STR_PHASE);
 
-    // Start the optimization depending on the different mode
-    optMode=-1;
-    if (!parameters.opt_mode)
+        // Start the optimization depending on the different mode
+        optMode=-1;
+        if (!parameters.opt_mode)
+        {
+            optMode=parameters.opt_mode;
+            parameters.opt_mode=-1;
+        }
+    }
+    endProfilerPhase(&globalProfiler,PROF_SETUP);
+    if (!writeProfilerRecord(&globalProfiler,0,0))
     {
-        optMode=parameters.opt_mode;
-        parameters.opt_mode=-1;
+        PRINT_ERROR("In main: writeProfilerRecord function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
     }
 
-    for (i=1; i<=parameters.iter_max; i++)
+    for (i=checkpoint.iter+1; i<=parameters.iter_max; i++)
     {
         time(&startLocalTimer);
+        iProfile=i;
 
         if (data.pnu[i-1]<0.15 && parameters.opt_mode==1)
         {
@@ -438,8 +659,11 @@ int main(int argc, char *argv[])
             }
         }
 
-        switch (optimization(&parameters,&mesh,&data,&chemicalSystem,i,
-                           &globalInitialTimer,&startLocalTimer,&endLocalTimer))
+        beginProfilerPhase(&globalProfiler,PROF_ITERATION);
+        returnValue=optimization(&parameters,&mesh,&data,&chemicalSystem,i,
+                           &globalInitialTimer,&startLocalTimer,&endLocalTimer);
+        endProfilerPhase(&globalProfiler,PROF_ITERATION);
+        switch (returnValue)
         {
             case 1:
                 PRINT_LOCAL_TIME(i,STR_PHASE,startLocalTimer,endLocalTimer);
@@ -511,6 +735,37 @@ int main(int argc, char *argv[])
                                                                   EXIT_FAILURE);
                 break;
         }
+
+        // Write the binary checkpoint of the loop every save_check iterations
+        // (i is the last iteration completed, which may differ from the one
+        // just performed when the optimization mode has been switched)
+        if (parameters.save_check>0 && i>0 && i<parameters.iter_max &&
+                                                     i%parameters.save_check==0)
+        {
+            checkpoint.iter=i;
+            checkpoint.optMode=optMode;
+            checkpoint.iStop=iStop;
+            checkpoint.d0p=d0p;
+            checkpoint.d1p=d1p;
+            checkpoint.d2p=d2p;
+            checkpoint.deltaT=deltaT;
+            if (!writingCheckpointFile(&parameters,&mesh,&data,&checkpoint))
+            {
+                fprintf(stdout,"\nWarning in main function: ");
+                fprintf(stdout,"writingCheckpointFile function returned zero ");
+                fprintf(stdout,"instead of one. The run goes on with the ");
+                fprintf(stdout,"previous checkpoint.\n");
+            }
+        }
+
+        // Write the record of the iteration in the report of the profiler
+        if (!writeProfilerRecord(&globalProfiler,0,iProfile))
+        {
+            PRINT_ERROR("In main: writeProfilerRecord function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,
+                                                                  EXIT_FAILURE);
+        }
     }
 
     if (!optMode)
@@ -521,8 +776,17 @@ int main(int argc, char *argv[])
         data.d2p[iStop]=d2p;
     }
 
+    // Barrier ensuring that all the mesh snapshots have been written
+    if (!stopSnapshotWriter(&globalSnapshotWriter))
+    {
+        PRINT_ERROR("In main: stopSnapshotWriter function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_FAILURE);
+    }
+
     FREE_AND_RETURN(&parameters,&chemicalSystem,&data,&mesh,EXIT_SUCCESS);
 }
+#endif
 
 /* ************************************************************************** */
 // The function printTimer takes the difference between the finalTimer and
@@ -587,14 +851,22 @@ void printTimer(time_t finalTimer, time_t initialTimer)
 
 /* ************************************************************************** */
 // The function endTimerAtExit is only called by atexit i.e. when the program
-// will stop. It uses the global variable globalInitialTimer in order to print
-// properly the total execution time of the MPD program. It has no argument and
-// it returns no argument (void input and output)
+// will stop. It first waits for the mesh snapshots still queued in the global
+// variable globalSnapshotWriter, stops the global variable globalProfiler, and
+// uses the global variable
+// globalInitialTimer in order to print properly the total execution time of
+// the MPD program. It has no argument and it returns no argument (void input
+// and output)
 /* ************************************************************************** */
 void endTimerAtExit(void)
 {
     time_t localFinalTimer=0;
 
+    // Wait for the mesh snapshots that may still be queued (error exit) and
+    // write the summary of the profiler if it has not been done yet
+    stopSnapshotWriter(&globalSnapshotWriter);
+    stopProfiler(&globalProfiler);
+
     fprintf(stdout,"\n%s\nTotal memory freed up. ",STR_PHASE);
     fprintf(stdout,"MPD program ends.\nTotal execution time: ");
 
@@ -625,8 +897,10 @@ char* endTimerAtError(void)
 // standard output stream when an anormal end of the MPD program occurred. It is
 // meant to describe the type of anormal error encountered and it is only called
 // when one of the standard signal is caught (SIGABRT, SIGFPE, SIGILL, SIGSEGV,
-// SIGTERM, SIGINT). It has the int typeOfSignal variable as input argument and
-// it does not return any value (void output)
+// SIGTERM, SIGINT). Before exiting, it lets the background thread finish to
+// write the queued mesh snapshots (for a bounded time). It has the int
+// typeOfSignal variable as input argument and it does not return any value
+// (void output)
 /* ************************************************************************** */
 void commentAnormalEnd(int typeOfSignal)
 {
@@ -658,7 +932,677 @@ void commentAnormalEnd(int typeOfSignal)
             fprintf(stdout,"signal %d caught.\n",typeOfSignal);
             break;
     }
-    exit(EXIT_FAILURE);
+
+    // Give a chance to the queued mesh snapshots to be completely written
+    waitForSnapshotWriterAtSignal(&globalSnapshotWriter);
+    exit(EXIT_FAILURE);
+}
+
+/* ************************************************************************** */
+// The function getMonotonicTime returns the time (in seconds) given by the
+// monotonic clock of the system (thanks to the standard POSIX clock_gettime
+// c-function), which is not affected by the changes of the system time and has
+// a (much) better resolution than the time standard c-function. It has no
+// argument (void input) and it returns zero if the clock cannot be read
+/* ************************************************************************** */
+double getMonotonicTime(void)
+{
+    struct timespec timer;
+
+    // clock_gettime returns zero on success, otherwise -1
+    if (clock_gettime(CLOCK_MONOTONIC,&timer))
+    {
+        return 0.;
+    }
+
+    return (double)timer.tv_sec+1.e-9*(double)timer.tv_nsec;
+}
+
+/* ************************************************************************** */
+// The function getNameOfPhase returns the name used in the profiling reports
+// for the phase identified by the preprocessor constants PROF_SETUP ...
+// PROF_IO (defined in main.h). It has the int phase as input argument and it
+// returns the name of the phase (or "unknown" if it does not refer to a phase)
+/* ************************************************************************** */
+char* getNameOfPhase(int phase)
+{
+    switch (phase)
+    {
+        case PROF_SETUP:
+            return "setup";
+
+        case PROF_ITERATION:
+            return "iteration";
+
+        case PROF_OVERLAP:
+            return "overlap";
+
+        case PROF_DIAGONALIZATION:
+            return "diagonalization";
+
+        case PROF_GRADIENT:
+            return "shape_gradient";
+
+        case PROF_SEARCH:
+            return "search";
+
+        case PROF_METRIC:
+            return "metric";
+
+        case PROF_MMG3D:
+            return "mmg3d";
+
+        case PROF_MSHDIST:
+            return "mshdist";
+
+        case PROF_ELASTIC:
+            return "elastic";
+
+        case PROF_ADVECT:
+            return "advect";
+
+        case PROF_IO:
+            return "file_io";
+
+        default:
+            return "unknown";
+    }
+}
+
+/* ************************************************************************** */
+// The function startProfiler initializes the structure pointed by pProfiler
+// according to the save_prof variable of the structure pointed by pParameters:
+// if it is set to zero, the profiler stays inactive (all the other profiling
+// functions then return immediately), otherwise the *.prof.json (save_prof=1)
+// or *.prof.csv (save_prof=2) report associated with pParameters->name_info
+// (the '.info' extension is replaced) is created and its header is written.
+// The calling thread becomes the owner of the profiler. It has the Profiler*
+// and Parameters* variables (defined in main.h) as input arguments and it
+// returns one on success, otherwise zero is returned if an error occurs
+/* ************************************************************************** */
+int startProfiler(Profiler* pProfiler, Parameters* pParameters)
+{
+    size_t lengthName=0, length=0;
+    char *fileLocation=NULL;
+
+    // Check the input pointers
+    if (pProfiler==NULL || pParameters==NULL)
+    {
+        PRINT_ERROR("In startProfiler: one of the input variables ");
+        fprintf(stderr,"pProfiler=%p or ",(void*)pProfiler);
+        fprintf(stderr,"pParameters=%p does not ",(void*)pParameters);
+        fprintf(stderr,"point to a valid address.\n");
+        return 0;
+    }
+    memset(pProfiler,0,sizeof(Profiler));
+
+    // Nothing else to do if the run is not profiled
+    if (!pParameters->save_prof)
+    {
+        return 1;
+    }
+    if (pParameters->save_prof<0 || pParameters->save_prof>2 ||
+                                                        pParameters->n_cpu<1)
+    {
+        PRINT_ERROR("In startProfiler: the save_prof variable ");
+        fprintf(stderr,"(=%d) of the structure ",pParameters->save_prof);
+        fprintf(stderr,"pointed by pParameters can only be set to zero, ");
+        fprintf(stderr,"one, or two, and its n_cpu variable (=");
+        fprintf(stderr,"%d) must be a positive integer.\n",pParameters->n_cpu);
+        return 0;
+    }
+
+    // Build the *.prof.json/ *.prof.csv file name from the *.info one
+    if (!checkStringFromLength(pParameters->name_info,7,
+                                                      pParameters->name_length))
+    {
+        PRINT_ERROR("In startProfiler: checkStringFromLength function ");
+        fprintf(stderr,"returned zero, which is not the expected value ");
+        fprintf(stderr,"here.\n");
+        return 0;
+    }
+    lengthName=strlen(pParameters->name_info);
+    if (strcmp(pParameters->name_info+lengthName-5,".info"))
+    {
+        PRINT_ERROR("In startProfiler: ");
+        fprintf(stderr,"%s file name does not end ",pParameters->name_info);
+        fprintf(stderr,"with the '.info' extension.\n");
+        return 0;
+    }
+
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    fileLocation=(char*)calloc(lengthName+6,sizeof(char));
+    length=2*PROF_PHASES*pParameters->n_cpu*PROF_STRIDE;
+    pProfiler->pbusy=(double*)calloc(length,sizeof(double));
+    pProfiler->pwork=(double*)calloc(length,sizeof(double));
+    if (fileLocation==NULL || pProfiler->pbusy==NULL || pProfiler->pwork==NULL)
+    {
+        PRINT_ERROR("In startProfiler: could not allocate memory for the ");
+        fprintf(stderr,"local fileLocation variable or for the pbusy and ");
+        fprintf(stderr,"pwork variables of the structure pointed by ");
+        fprintf(stderr,"pProfiler.\n");
+        free(fileLocation);
+        free(pProfiler->pbusy);
+        free(pProfiler->pwork);
+        memset(pProfiler,0,sizeof(Profiler));
+        return 0;
+    }
+    strncpy(fileLocation,pParameters->name_info,lengthName+6);
+    if (pParameters->save_prof==1)
+    {
+        strcpy(fileLocation+lengthName-5,".prof.json");
+    }
+    else
+    {
+        strcpy(fileLocation+lengthName-5,".prof.csv");
+    }
+
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    fprintf(stdout,"\nProfiling the run in the %s file.\n",fileLocation);
+    pProfiler->report=fopen(fileLocation,"w");
+    if (pProfiler->report==NULL)
+    {
+        PRINT_ERROR("In startProfiler: could not write in the ");
+        fprintf(stderr,"%s file.\n",fileLocation);
+        free(fileLocation);
+        free(pProfiler->pbusy);
+        free(pProfiler->pwork);
+        memset(pProfiler,0,sizeof(Profiler));
+        return 0;
+    }
+    free(fileLocation);
+    fileLocation=NULL;
+
+    if (pParameters->save_prof==1)
+    {
+        fprintf(pProfiler->report,"{\n  \"program\": \"mpd\",\n");
+        fprintf(pProfiler->report,"  \"version\": \"%s\",\n",STR_VERSION);
+        fprintf(pProfiler->report,"  \"input\": ");
+        fprintf(pProfiler->report,"\"%s\",\n",pParameters->name_info);
+        fprintf(pProfiler->report,"  \"opt_mode\": ");
+        fprintf(pProfiler->report,"%d,\n",pParameters->opt_mode);
+        fprintf(pProfiler->report,"  \"n_cpu\": %d,\n",pParameters->n_cpu);
+        fprintf(pProfiler->report,"  \"clock\": \"monotonic\",\n");
+        fprintf(pProfiler->report,"  \"unit\": \"second\",\n");
+        fprintf(pProfiler->report,"  \"records\": [");
+    }
+    else
+    {
+        fprintf(pProfiler->report,"record,start,iteration,time,wall,phase,");
+        fprintf(pProfiler->report,"thread,calls,inclusive,self,read,written,");
+        fprintf(pProfiler->report,"busy,work\n");
+    }
+    fflush(pProfiler->report);
+
+    pProfiler->active=pParameters->save_prof;
+    pProfiler->nthread=pParameters->n_cpu;
+    pProfiler->owner=pthread_self();
+    pProfiler->origin=getMonotonicTime();
+    pProfiler->last=pProfiler->origin;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function beginProfilerPhase opens a new (nested) phase in the structure
+// pointed by pProfiler. Nothing is done if the profiler is inactive, if the
+// calling thread is not its owner, or if PROF_DEPTH phases are already opened.
+// It has the Profiler* variable (defined in main.h) and the int phase (one of
+// the PROF_SETUP ... PROF_IO constants) as input arguments and it does not
+// return any value (void output)
+/* ************************************************************************** */
+void beginProfilerPhase(Profiler* pProfiler, int phase)
+{
+    int depth=0;
+
+    if (pProfiler==NULL || !pProfiler->active || phase<0 ||
+                                                          phase>=PROF_PHASES)
+    {
+        return;
+    }
+    if (!pthread_equal(pthread_self(),pProfiler->owner))
+    {
+        return;
+    }
+
+    depth=pProfiler->depth;
+    if (depth<PROF_DEPTH)
+    {
+        pProfiler->pstack[depth]=phase;
+        pProfiler->pbegin[depth]=getMonotonicTime();
+        pProfiler->pchild[depth]=0.;
+        pProfiler->depth++;
+    }
+
+    return;
+}
+
+/* ************************************************************************** */
+// The function endProfilerPhase closes the last opened occurrence of the phase
+// in the structure pointed by pProfiler and adds its duration to the counters
+// of the current record: its inclusive time (only if the phase is not nested
+// in itself), and its self time (without the time spent in its nested phases).
+// The phases opened after it and still opened (e.g. after an error) are closed
+// first. Nothing is done if the profiler is inactive, if the calling thread is
+// not its owner, or if the phase is not opened. It has the Profiler* variable
+// (defined in main.h) and the int phase as input arguments and it does not
+// return any value (void output)
+/* ************************************************************************** */
+void endProfilerPhase(Profiler* pProfiler, int phase)
+{
+    int i=0, j=0, target=0, current=0, nested=0;
+    double timer=0., elapsed=0.;
+
+    if (pProfiler==NULL || !pProfiler->active)
+    {
+        return;
+    }
+    if (!pthread_equal(pthread_self(),pProfiler->owner))
+    {
+        return;
+    }
+
+    // Look for the last opened occurrence of the phase
+    for (target=pProfiler->depth-1; target>=0; target--)
+    {
+        if (pProfiler->pstack[target]==phase)
+        {
+            break;
+        }
+    }
+    if (target<0)
+    {
+        return;
+    }
+
+    timer=getMonotonicTime();
+    for (i=pProfiler->depth-1; i>=target; i--)
+    {
+        current=pProfiler->pstack[i];
+        elapsed=timer-pProfiler->pbegin[i];
+        nested=0;
+        for (j=0; j<i; j++)
+        {
+            nested=(nested || pProfiler->pstack[j]==current);
+        }
+
+        pProfiler->pcall[current]++;
+        if (!nested)
+        {
+            pProfiler->pinclusive[current]+=elapsed;
+        }
+        pProfiler->pself[current]+=elapsed-pProfiler->pchild[i];
+        if (i>0)
+        {
+            pProfiler->pchild[i-1]+=elapsed;
+        }
+    }
+    pProfiler->depth=target;
+
+    return;
+}
+
+/* ************************************************************************** */
+// The function addProfilerBytes adds the numbers of bytes read and written to
+// the counters of the last opened phase (or of the PROF_IO phase if none is
+// opened) in the structure pointed by pProfiler. Nothing is done if the
+// profiler is inactive or if the calling thread is not its owner. It has the
+// Profiler* variable (defined in main.h) and the two double variables
+// (bytesRead, bytesWritten) as input arguments and it does not return any
+// value (void output)
+/* ************************************************************************** */
+void addProfilerBytes(Profiler* pProfiler, double bytesRead,
+                                                            double bytesWritten)
+{
+    int phase=PROF_IO;
+
+    if (pProfiler==NULL || !pProfiler->active)
+    {
+        return;
+    }
+    if (!pthread_equal(pthread_self(),pProfiler->owner))
+    {
+        return;
+    }
+
+    if (pProfiler->depth>0)
+    {
+        phase=pProfiler->pstack[pProfiler->depth-1];
+    }
+    pProfiler->pread[phase]+=bytesRead;
+    pProfiler->pwritten[phase]+=bytesWritten;
+
+    return;
+}
+
+/* ************************************************************************** */
+// The function beginProfilerThread is called by each thread at the beginning
+// of its share of a parallelized loop. It has the Profiler* variable (defined
+// in main.h) as input argument and it returns the current monotonic time if the
+// profiler is active, otherwise zero is returned
+/* ************************************************************************** */
+double beginProfilerThread(Profiler* pProfiler)
+{
+    if (pProfiler==NULL || !pProfiler->active)
+    {
+        return 0.;
+    }
+
+    return getMonotonicTime();
+}
+
+/* ************************************************************************** */
+// The function endProfilerThread is called by each thread at the end of its
+// share of a parallelized loop of the phase. It adds the time elapsed since
+// timer (given by beginProfilerThread) and the number of loop items treated to
+// the per-thread counters of the current record of the structure pointed by
+// pProfiler (each thread only modifies its own counters). It has the Profiler*
+// variable (defined in main.h), the int phase, and the two double variables
+// (timer, work) as input arguments and it does not return any value (void
+// output)
+/* ************************************************************************** */
+void endProfilerThread(Profiler* pProfiler, int phase, double timer,
+                                                                    double work)
+{
+    int iThread=0;
+
+    if (pProfiler==NULL || !pProfiler->active || phase<0 ||
+                                                          phase>=PROF_PHASES)
+    {
+        return;
+    }
+
+    iThread=omp_get_thread_num();
+    if (iThread<0 || iThread>=pProfiler->nthread)
+    {
+        return;
+    }
+    pProfiler->pbusy[(phase*pProfiler->nthread+iThread)*PROF_STRIDE]+=
+                                                     getMonotonicTime()-timer;
+    pProfiler->pwork[(phase*pProfiler->nthread+iThread)*PROF_STRIDE]+=work;
+
+    return;
+}
+
+/* ************************************************************************** */
+// The function writeProfilerCounters writes in the report of the structure
+// pointed by pProfiler the counters of all the phases that have been used,
+// either those of the current record (run=0) or those of the whole run
+// (run=1), as a JSON object (save_prof=1) or as CSV lines (save_prof=2) whose
+// first fields are built with the record, iStart, iteration, timer, and wall
+// variables. It has the Profiler* variable (defined in main.h), the int run,
+// the char* record, the two int variables (iStart, iteration) and the two
+// double variables (timer, wall) as input arguments and it returns one on
+// success, otherwise zero is returned if an error occurs
+/* ************************************************************************** */
+int writeProfilerCounters(Profiler* pProfiler, int run, char* record,
+                           int iStart, int iteration, double timer, double wall)
+{
+    int phase=0, i=0, j=0, k=0, iThread=0, nThread=0, counter=0;
+    double busy=0., work=0.;
+    FILE *report=NULL;
+
+    if (pProfiler==NULL || pProfiler->report==NULL || record==NULL)
+    {
+        PRINT_ERROR("In writeProfilerCounters: one of the input variables ");
+        fprintf(stderr,"pProfiler=%p or record=%p ",(void*)pProfiler,
+                                                                 (void*)record);
+        fprintf(stderr,"(or its report file) does not point to a valid ");
+        fprintf(stderr,"address.\n");
+        return 0;
+    }
+    report=pProfiler->report;
+    nThread=pProfiler->nthread;
+
+    counter=0;
+    for (phase=0; phase<PROF_PHASES; phase++)
+    {
+        i=run*PROF_PHASES+phase;
+        j=i*nThread*PROF_STRIDE;
+        busy=0.;
+        work=0.;
+        for (iThread=0; iThread<nThread; iThread++)
+        {
+            busy+=pProfiler->pbusy[j+iThread*PROF_STRIDE];
+            work+=pProfiler->pwork[j+iThread*PROF_STRIDE];
+        }
+        if (!pProfiler->pcall[i] && busy<=0. && pProfiler->pread[i]<=0. &&
+                                                    pProfiler->pwritten[i]<=0.)
+        {
+            continue;
+        }
+
+        if (pProfiler->active==1)
+        {
+            if (counter)
+            {
+                fprintf(report,",");
+            }
+            fprintf(report,"\n        \"%s\": {",getNameOfPhase(phase));
+            fprintf(report,"\"calls\": %d, ",pProfiler->pcall[i]);
+            fprintf(report,"\"inclusive\": %.6lf, ",pProfiler->pinclusive[i]);
+            fprintf(report,"\"self\": %.6lf, ",pProfiler->pself[i]);
+            fprintf(report,"\"read\": %.0lf, ",pProfiler->pread[i]);
+            fprintf(report,"\"written\": %.0lf",pProfiler->pwritten[i]);
+            if (busy>0.)
+            {
+                for (k=0; k<2; k++)
+                {
+                    fprintf(report,(k)? ", \"work\": [": ", \"busy\": [");
+                    for (iThread=0; iThread<nThread; iThread++)
+                    {
+                        if (iThread)
+                        {
+                            fprintf(report,", ");
+                        }
+                        if (k)
+                        {
+                            fprintf(report,"%.0lf",
+                                      pProfiler->pwork[j+iThread*PROF_STRIDE]);
+                        }
+                        else
+                        {
+                            fprintf(report,"%.6lf",
+                                      pProfiler->pbusy[j+iThread*PROF_STRIDE]);
+                        }
+                    }
+                    fprintf(report,"]");
+                }
+            }
+            fprintf(report,"}");
+        }
+        else
+        {
+            fprintf(report,"%s,%d,%d,%.6lf,%.6lf,",record,iStart,iteration,
+                                                                    timer,wall);
+            fprintf(report,"%s,-1,%d,",getNameOfPhase(phase),
+                                                           pProfiler->pcall[i]);
+            fprintf(report,"%.6lf,%.6lf,",pProfiler->pinclusive[i],
+                                                           pProfiler->pself[i]);
+            fprintf(report,"%.0lf,%.0lf,",pProfiler->pread[i],
+                                                        pProfiler->pwritten[i]);
+            fprintf(report,"%.6lf,%.0lf\n",busy,work);
+            for (iThread=0; busy>0. && iThread<nThread; iThread++)
+            {
+                fprintf(report,"%s,%d,%d,%.6lf,%.6lf,",record,iStart,
+                                                         iteration,timer,wall);
+                fprintf(report,"%s,%d,0,0,0,0,0,",getNameOfPhase(phase),
+                                                                       iThread);
+                fprintf(report,"%.6lf,%.0lf\n",
+                                      pProfiler->pbusy[j+iThread*PROF_STRIDE],
+                                      pProfiler->pwork[j+iThread*PROF_STRIDE]);
+            }
+        }
+        counter++;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function writeProfilerRecord writes in the report of the structure
+// pointed by pProfiler the record of the iteration (zero for the setup) of the
+// iStart-th start or geometry (zero for a single run), i.e. the counters of
+// the phases closed since the previous record together with the wall time
+// elapsed since then. These counters are then added to the ones of the whole
+// run and reset. Nothing is done if the profiler is inactive. It has the
+// Profiler* variable (defined in main.h) and the two int variables (iStart,
+// iteration) as input arguments and it returns one on success, otherwise zero
+// is returned if an error occurs
+/* ************************************************************************** */
+int writeProfilerRecord(Profiler* pProfiler, int iStart, int iteration)
+{
+    int i=0, j=0, nThread=0;
+    double timer=0., wall=0.;
+
+    if (pProfiler==NULL || !pProfiler->active)
+    {
+        return 1;
+    }
+
+    timer=getMonotonicTime();
+    wall=timer-pProfiler->last;
+    pProfiler->last=timer;
+    timer-=pProfiler->origin;
+
+    if (pProfiler->active==1)
+    {
+        if (pProfiler->nrecord)
+        {
+            fprintf(pProfiler->report,",");
+        }
+        fprintf(pProfiler->report,"\n    {\"start\": %d, ",iStart);
+        fprintf(pProfiler->report,"\"iteration\": %d, ",iteration);
+        fprintf(pProfiler->report,"\"time\": %.6lf, ",timer);
+        fprintf(pProfiler->report,"\"wall\": %.6lf, \"phases\": {",wall);
+    }
+    if (!writeProfilerCounters(pProfiler,0,"iteration",iStart,iteration,
+                                                                   timer,wall))
+    {
+        PRINT_ERROR("In writeProfilerRecord: writeProfilerCounters ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+    if (pProfiler->active==1)
+    {
+        fprintf(pProfiler->report,"\n      }}");
+    }
+    fflush(pProfiler->report);
+    pProfiler->nrecord++;
+
+    // Add the counters of the record to the ones of the whole run
+    nThread=pProfiler->nthread;
+    for (i=0; i<PROF_PHASES; i++)
+    {
+        pProfiler->pcall[PROF_PHASES+i]+=pProfiler->pcall[i];
+        pProfiler->pinclusive[PROF_PHASES+i]+=pProfiler->pinclusive[i];
+        pProfiler->pself[PROF_PHASES+i]+=pProfiler->pself[i];
+        pProfiler->pread[PROF_PHASES+i]+=pProfiler->pread[i];
+        pProfiler->pwritten[PROF_PHASES+i]+=pProfiler->pwritten[i];
+        pProfiler->pcall[i]=0;
+        pProfiler->pinclusive[i]=0.;
+        pProfiler->pself[i]=0.;
+        pProfiler->pread[i]=0.;
+        pProfiler->pwritten[i]=0.;
+    }
+    j=PROF_PHASES*nThread*PROF_STRIDE;
+    for (i=0; i<j; i+=PROF_STRIDE)
+    {
+        pProfiler->pbusy[j+i]+=pProfiler->pbusy[i];
+        pProfiler->pwork[j+i]+=pProfiler->pwork[i];
+        pProfiler->pbusy[i]=0.;
+        pProfiler->pwork[i]=0.;
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function stopProfiler closes the phases still opened in the structure
+// pointed by pProfiler, adds the counters not yet recorded to the ones of the
+// whole run, writes the summary of the run at the end of the report, prints it
+// in the standard output stream, closes the report, and frees the memory of
+// the profiler, which becomes inactive (so that it can safely be called
+// several times). It has the Profiler* variable (defined in main.h) as input
+// argument and it returns one on success, otherwise zero is returned if an
+// error occurs
+/* ************************************************************************** */
+int stopProfiler(Profiler* pProfiler)
+{
+    int i=0, j=0, returnValue=1;
+    double timer=0.;
+
+    if (pProfiler==NULL || !pProfiler->active)
+    {
+        return 1;
+    }
+
+    // Close the phases still opened (error) and gather the last counters
+    if (pProfiler->depth>0)
+    {
+        endProfilerPhase(pProfiler,pProfiler->pstack[0]);
+    }
+    timer=getMonotonicTime()-pProfiler->origin;
+    if (pProfiler->active==1)
+    {
+        fprintf(pProfiler->report,"\n  ],\n  \"summary\": {");
+        fprintf(pProfiler->report,"\"records\": %d, ",pProfiler->nrecord);
+        fprintf(pProfiler->report,"\"time\": %.6lf, \"phases\": {",timer);
+    }
+    for (i=0; i<PROF_PHASES; i++)
+    {
+        pProfiler->pcall[PROF_PHASES+i]+=pProfiler->pcall[i];
+        pProfiler->pinclusive[PROF_PHASES+i]+=pProfiler->pinclusive[i];
+        pProfiler->pself[PROF_PHASES+i]+=pProfiler->pself[i];
+        pProfiler->pread[PROF_PHASES+i]+=pProfiler->pread[i];
+        pProfiler->pwritten[PROF_PHASES+i]+=pProfiler->pwritten[i];
+    }
+    j=PROF_PHASES*pProfiler->nthread*PROF_STRIDE;
+    for (i=0; i<j; i+=PROF_STRIDE)
+    {
+        pProfiler->pbusy[j+i]+=pProfiler->pbusy[i];
+        pProfiler->pwork[j+i]+=pProfiler->pwork[i];
+    }
+    if (!writeProfilerCounters(pProfiler,1,"summary",-1,-1,timer,timer))
+    {
+        PRINT_ERROR("In stopProfiler: writeProfilerCounters function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        returnValue=0;
+    }
+    if (pProfiler->active==1)
+    {
+        fprintf(pProfiler->report,"\n      }}\n}\n");
+    }
+
+    // Print the summary of the run in the standard output stream
+    fprintf(stdout,"\nProfile of the run (%.3lf seconds): ",timer);
+    fprintf(stdout,"calls, self and inclusive times (in seconds), ");
+    fprintf(stdout,"and megabytes read and written per phase.\n");
+    for (i=PROF_PHASES; i<2*PROF_PHASES; i++)
+    {
+        if (!pProfiler->pcall[i])
+        {
+            continue;
+        }
+        fprintf(stdout,"%-16s %8d %12.3lf %12.3lf %10.2lf %10.2lf\n",
+                       getNameOfPhase(i-PROF_PHASES),pProfiler->pcall[i],
+                       pProfiler->pself[i],pProfiler->pinclusive[i],
+                      1.e-6*pProfiler->pread[i],1.e-6*pProfiler->pwritten[i]);
+    }
+
+    // fclose returns zero if the input FILE* variable is successfully closed,
+    // otherwise EOF (end-of-file) is returned
+    if (fclose(pProfiler->report))
+    {
+        PRINT_ERROR("In stopProfiler: could not close the report file ");
+        fprintf(stderr,"properly.\n");
+        returnValue=0;
+    }
+    free(pProfiler->pbusy);
+    free(pProfiler->pwork);
+    memset(pProfiler,0,sizeof(Profiler));
+
+    return returnValue;
 }
 
 /* ************************************************************************** */
@@ -1318,6 +2262,509 @@ void closeTheFile(FILE** pFileToClose)
     return;
 }
 
+/* ************************************************************************** */
+// The function openMappedFile maps into memory the content of an existing file
+// located at fileLocation (a path name of length strictly less than nameLength)
+// and stores it in the structure pointed by pMappedFile with its cursor set at
+// the beginning of the file. It has the char* fileLocation, int nameLength, and
+// MappedFile* (defined in main.h) variables as input arguments and it returns
+// one on success, otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int openMappedFile(char* fileLocation, int nameLength, MappedFile* pMappedFile)
+{
+    int fileDescriptor=0;
+    struct stat fileStatus;
+    void* pMapping=NULL;
+
+    // Check if the input pMappedFile variable is pointing to NULL
+    if (pMappedFile==NULL)
+    {
+        PRINT_ERROR("In openMappedFile: the input pMappedFile variable is ");
+        fprintf(stderr,"pointing to the %p address.\n",(void*)pMappedFile);
+        return 0;
+    }
+    pMappedFile->data=NULL;
+    pMappedFile->size=0;
+    pMappedFile->pos=0;
+
+    // Check if the file exists at fileLocation
+    if (initialFileExists(fileLocation,nameLength)!=1)
+    {
+        PRINT_ERROR("In openMappedFile: initialFileExists function did not ");
+        fprintf(stderr,"return one, which was the expected value here.\n");
+        return 0;
+    }
+
+    // open returns a file descriptor on success, otherwise -1 (errno is set)
+    fileDescriptor=open(fileLocation,O_RDONLY);
+    if (fileDescriptor==-1)
+    {
+        PRINT_ERROR("In openMappedFile: wrong return (=-1) of the standard ");
+        fprintf(stderr,"open c-function in the attempt of opening the ");
+        fprintf(stderr,"%s file.\n",fileLocation);
+        return 0;
+    }
+
+    // fstat returns zero on success, otherwise -1 (errno is set)
+    if (fstat(fileDescriptor,&fileStatus))
+    {
+        PRINT_ERROR("In openMappedFile: wrong return (=-1) of the standard ");
+        fprintf(stderr,"fstat c-function in the attempt of getting the size ");
+        fprintf(stderr,"of the %s file.\n",fileLocation);
+        close(fileDescriptor);
+        return 0;
+    }
+
+    // An empty file cannot be mapped but it is not an error here (the parsing
+    // functions simply return EOF as the fgetc or fscanf c-functions would do)
+    if (fileStatus.st_size>0)
+    {
+        // mmap returns a pointer to the mapped area, otherwise MAP_FAILED
+        pMapping=mmap(NULL,(size_t)fileStatus.st_size,PROT_READ,MAP_PRIVATE,
+                                                              fileDescriptor,0);
+        if (pMapping==MAP_FAILED)
+        {
+            PRINT_ERROR("In openMappedFile: wrong return of the standard ");
+            fprintf(stderr,"mmap c-function in the attempt of mapping the ");
+            fprintf(stderr,"%s file into memory.\n",fileLocation);
+            close(fileDescriptor);
+            return 0;
+        }
+
+        // The file is read once from its beginning to its end: madvise is only
+        // a hint for the kernel read-ahead so its return value is not checked
+        madvise(pMapping,(size_t)fileStatus.st_size,MADV_SEQUENTIAL);
+        pMappedFile->data=(char*)pMapping;
+        pMappedFile->size=(size_t)fileStatus.st_size;
+    }
+
+    // The mapping stays valid after the file descriptor has been closed
+    if (close(fileDescriptor))
+    {
+        PRINT_ERROR("In openMappedFile: wrong return (=-1) of the standard ");
+        fprintf(stderr,"close c-function for the %s file.\n",fileLocation);
+        closeMappedFile(pMappedFile);
+        return 0;
+    }
+
+    // Count the mapped bytes as read in the profiler
+    addProfilerBytes(&globalProfiler,(double)pMappedFile->size,0.);
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function closeMappedFile unmaps the content of the file stored in the
+// structure pointed by pMappedFile and resets it to zero. It has the
+// MappedFile* variable (defined in main.h) as input argument and it returns
+// zero on success, otherwise EOF (as the fclose standard c-function does)
+/* ************************************************************************** */
+int closeMappedFile(MappedFile* pMappedFile)
+{
+    int returnValue=0;
+
+    if (pMappedFile!=NULL)
+    {
+        // munmap returns zero on success, otherwise -1 (errno is set)
+        if (pMappedFile->data!=NULL)
+        {
+            if (munmap(pMappedFile->data,pMappedFile->size))
+            {
+                returnValue=EOF;
+            }
+        }
+        pMappedFile->data=NULL;
+        pMappedFile->size=0;
+        pMappedFile->pos=0;
+    }
+
+    return returnValue;
+}
+
+/* ************************************************************************** */
+// The function getCharInMappedFile reads the character at the cursor of the
+// structure pointed by pMappedFile and moves the cursor forward. It has the
+// MappedFile* variable (defined in main.h) as input argument and it returns
+// the character read as an unsigned char cast to an int, otherwise EOF if the
+// end of file has been reached (as the fgetc standard c-function does)
+/* ************************************************************************** */
+int getCharInMappedFile(MappedFile* pMappedFile)
+{
+    if (pMappedFile->pos>=pMappedFile->size)
+    {
+        return EOF;
+    }
+
+    return (int)(unsigned char)pMappedFile->data[pMappedFile->pos++];
+}
+
+/* ************************************************************************** */
+// The function ungetCharInMappedFile moves the cursor of the structure pointed
+// by pMappedFile one character backward. It has the MappedFile* variable
+// (defined in main.h) as input argument and it returns zero on success,
+// otherwise -1 (as the fseek(-1,SEEK_CUR) standard c-function does)
+/* ************************************************************************** */
+int ungetCharInMappedFile(MappedFile* pMappedFile)
+{
+    if (pMappedFile->pos==0)
+    {
+        return -1;
+    }
+    pMappedFile->pos--;
+
+    return 0;
+}
+
+/* ************************************************************************** */
+// The function getStringInMappedFile reads at most (sizeMax-1) characters from
+// the cursor of the structure pointed by pMappedFile and stores them in the
+// array pointed by stringToFill, stopping after a newline character and adding
+// the terminating nul character. It has the char* stringToFill, int sizeMax
+// and MappedFile* (defined in main.h) variables as input arguments and it
+// returns stringToFill on success, otherwise NULL if the end of file has been
+// reached before any character has been read (as fgets c-function does)
+/* ************************************************************************** */
+char* getStringInMappedFile(char* stringToFill, int sizeMax,
+                                                        MappedFile* pMappedFile)
+{
+    int i=0;
+    char readChar='\0';
+
+    if (stringToFill==NULL || sizeMax<1 ||
+                                        pMappedFile->pos>=pMappedFile->size)
+    {
+        return NULL;
+    }
+
+    while (i<sizeMax-1 && pMappedFile->pos<pMappedFile->size)
+    {
+        readChar=pMappedFile->data[pMappedFile->pos++];
+        stringToFill[i++]=readChar;
+        if (readChar=='\n')
+        {
+            break;
+        }
+    }
+    stringToFill[i]='\0';
+
+    return stringToFill;
+}
+
+/* ************************************************************************** */
+// The function skipSpacesInMappedFile moves the cursor of the structure pointed
+// by pMappedFile after all the consecutive white space characters. It has the
+// MappedFile* variable (defined in main.h) as input argument and it returns
+// zero (no item is assigned, as the fscanf(" ") standard c-function does)
+/* ************************************************************************** */
+int skipSpacesInMappedFile(MappedFile* pMappedFile)
+{
+    const char* data=pMappedFile->data;
+    size_t pos=pMappedFile->pos, size=pMappedFile->size;
+
+    while (pos<size && (data[pos]==' ' || data[pos]=='\n' || data[pos]=='\t' ||
+                   data[pos]=='\r' || data[pos]=='\v' || data[pos]=='\f'))
+    {
+        pos++;
+    }
+    pMappedFile->pos=pos;
+
+    return 0;
+}
+
+/* ************************************************************************** */
+// The function scanCharacterInMappedFile skips the white space characters and
+// then reads the charToRead character at the cursor of the structure pointed by
+// pMappedFile. It has the MappedFile* variable (defined in main.h) and the
+// char charToRead as input arguments and it returns one if charToRead has been
+// read, zero if another character was found (the cursor is left on it) or EOF
+// if the end of the file has been reached
+/* ************************************************************************** */
+int scanCharacterInMappedFile(MappedFile* pMappedFile, char charToRead)
+{
+    skipSpacesInMappedFile(pMappedFile);
+    if (pMappedFile->pos>=pMappedFile->size)
+    {
+        return EOF;
+    }
+    if (pMappedFile->data[pMappedFile->pos]!=charToRead)
+    {
+        return 0;
+    }
+    pMappedFile->pos++;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function scanIntegerInMappedFile reads an integer at the cursor of the
+// structure pointed by pMappedFile, together with the white space characters
+// surrounding it. It has the MappedFile* (defined in main.h) and int* pInteger
+// variables as input arguments and it returns one on success, zero if no
+// integer can be read, otherwise EOF if the end of the file has been reached
+// (as the fscanf(" %d ") standard c-function does)
+/* ************************************************************************** */
+int scanIntegerInMappedFile(MappedFile* pMappedFile, int* pInteger)
+{
+    const char* data=NULL;
+    size_t pos=0, size=0;
+    long value=0;
+    int sign=1;
+
+    skipSpacesInMappedFile(pMappedFile);
+    data=pMappedFile->data;
+    pos=pMappedFile->pos;
+    size=pMappedFile->size;
+    if (pos>=size)
+    {
+        return EOF;
+    }
+
+    if (data[pos]=='-' || data[pos]=='+')
+    {
+        if (data[pos]=='-')
+        {
+            sign=-1;
+        }
+        pos++;
+    }
+    if (pos>=size || data[pos]<'0' || data[pos]>'9')
+    {
+        return 0;
+    }
+
+    // Saturate the value (as strtol does) instead of overflowing the long
+    while (pos<size && data[pos]>='0' && data[pos]<='9')
+    {
+        if (value<2147483648L)
+        {
+            value=10*value+(long)(data[pos]-'0');
+        }
+        pos++;
+    }
+    value*=sign;
+    if (value>2147483647L)
+    {
+        value=2147483647L;
+    }
+    else if (value<-2147483647L-1L)
+    {
+        value=-2147483647L-1L;
+    }
+    *pInteger=(int)value;
+
+    pMappedFile->pos=pos;
+    skipSpacesInMappedFile(pMappedFile);
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function scanDoubleInMappedFile reads a real number at the cursor of the
+// structure pointed by pMappedFile, together with the white space characters
+// surrounding it. The Fortran scientific notation (1.0D+01) is accepted as well
+// as the C one (1.0e+01). It has the MappedFile* (defined in main.h) and the
+// double* pDouble variables as input arguments and it returns one on success,
+// zero if no number can be read, otherwise EOF if the end of file is reached
+/* ************************************************************************** */
+int scanDoubleInMappedFile(MappedFile* pMappedFile, double* pDouble)
+{
+    // Exact powers of ten in double precision (up to 10^22 included)
+    static const double powerOfTen[23]={1.e0,1.e1,1.e2,1.e3,1.e4,1.e5,1.e6,
+                                        1.e7,1.e8,1.e9,1.e10,1.e11,1.e12,1.e13,
+                                        1.e14,1.e15,1.e16,1.e17,1.e18,1.e19,
+                                        1.e20,1.e21,1.e22};
+    char copyOfNumber[64]={'\0'}, *endOfNumber=NULL;
+    const char* data=NULL;
+    size_t pos=0, size=0, start=0, i=0;
+    unsigned long long mantissa=0;
+    int sign=1, nDigits=0, exponent=0, exponentSign=1, exponentValue=0;
+    int digitsRead=0, digitsLost=0;
+    double value=0.;
+
+    skipSpacesInMappedFile(pMappedFile);
+    data=pMappedFile->data;
+    pos=pMappedFile->pos;
+    size=pMappedFile->size;
+    if (pos>=size)
+    {
+        return EOF;
+    }
+
+    // Read the sign, the integer part, and the decimal part of the mantissa
+    start=pos;
+    if (data[pos]=='-' || data[pos]=='+')
+    {
+        if (data[pos]=='-')
+        {
+            sign=-1;
+        }
+        pos++;
+    }
+    while (pos<size && data[pos]>='0' && data[pos]<='9')
+    {
+        if (nDigits<19)
+        {
+            mantissa=10*mantissa+(unsigned long long)(data[pos]-'0');
+            if (mantissa)
+            {
+                nDigits++;
+            }
+        }
+        else
+        {
+            exponent++;
+            digitsLost=1;
+        }
+        pos++;
+        digitsRead=1;
+    }
+    if (pos<size && data[pos]=='.')
+    {
+        pos++;
+        while (pos<size && data[pos]>='0' && data[pos]<='9')
+        {
+            if (nDigits<19)
+            {
+                mantissa=10*mantissa+(unsigned long long)(data[pos]-'0');
+                if (mantissa)
+                {
+                    nDigits++;
+                }
+                exponent--;
+            }
+            else
+            {
+                digitsLost=1;
+            }
+            pos++;
+            digitsRead=1;
+        }
+    }
+    if (!digitsRead)
+    {
+        return 0;
+    }
+
+    // Read the exponent (Fortran D/d or C E/e notation)
+    if (pos<size && (data[pos]=='e' || data[pos]=='E' || data[pos]=='d' ||
+                                                               data[pos]=='D'))
+    {
+        i=pos+1;
+        if (i<size && (data[i]=='-' || data[i]=='+'))
+        {
+            if (data[i]=='-')
+            {
+                exponentSign=-1;
+            }
+            i++;
+        }
+        if (i<size && data[i]>='0' && data[i]<='9')
+        {
+            exponentValue=0;
+            while (i<size && data[i]>='0' && data[i]<='9')
+            {
+                if (exponentValue<100000)
+                {
+                    exponentValue=10*exponentValue+(int)(data[i]-'0');
+                }
+                i++;
+            }
+            exponent+=exponentSign*exponentValue;
+            pos=i;
+        }
+    }
+
+    // Fast path (Clinger): the mantissa and the power of ten are both exactly
+    // representable so that a single multiplication/division is correctly
+    // rounded; otherwise strtod is applied on a copy where D is turned into e
+    if (!digitsLost && mantissa<=9007199254740992ULL && exponent>=-22 &&
+                                                                  exponent<=22)
+    {
+        value=(double)mantissa;
+        if (exponent<0)
+        {
+            value/=powerOfTen[-exponent];
+        }
+        else
+        {
+            value*=powerOfTen[exponent];
+        }
+        value*=(double)sign;
+    }
+    else
+    {
+        if (pos-start>=sizeof(copyOfNumber))
+        {
+            return 0;
+        }
+        for (i=start; i<pos; i++)
+        {
+            copyOfNumber[i-start]=data[i];
+            if (data[i]=='d' || data[i]=='D')
+            {
+                copyOfNumber[i-start]='e';
+            }
+        }
+        copyOfNumber[pos-start]='\0';
+        value=strtod(copyOfNumber,&endOfNumber);
+    }
+    *pDouble=value;
+
+    pMappedFile->pos=pos;
+    skipSpacesInMappedFile(pMappedFile);
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function computeHashOfFile evaluates the 64-bit FNV-1a hash of the whole
+// content of the file located at fileLocation (a path name of length strictly
+// less than nameLength) and stores it in pHashValue. It has the char*
+// fileLocation, int nameLength, and unsigned long long* pHashValue variables as
+// input arguments and it returns one on success, otherwise zero is returned
+/* ************************************************************************** */
+int computeHashOfFile(char* fileLocation, int nameLength,
+                                                 unsigned long long* pHashValue)
+{
+    size_t i=0;
+    unsigned long long hashValue=14695981039346656037ULL;
+    MappedFile mappedFile={NULL,0,0};
+
+    // Check if the input pHashValue variable is pointing to NULL
+    if (pHashValue==NULL)
+    {
+        PRINT_ERROR("In computeHashOfFile: the input pHashValue variable is ");
+        fprintf(stderr,"pointing to the %p address.\n",(void*)pHashValue);
+        return 0;
+    }
+
+    // openMappedFile returns one on success, otherwise zero is returned
+    if (!openMappedFile(fileLocation,nameLength,&mappedFile))
+    {
+        PRINT_ERROR("In computeHashOfFile: openMappedFile function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
+
+    // FNV-1a: xor each byte into the hash then multiply by the FNV prime
+    for (i=0; i<mappedFile.size; i++)
+    {
+        hashValue^=(unsigned long long)(unsigned char)mappedFile.data[i];
+        hashValue*=1099511628211ULL;
+    }
+    *pHashValue=hashValue;
+
+    // closeMappedFile returns zero on success, otherwise EOF is returned
+    if (closeMappedFile(&mappedFile))
+    {
+        PRINT_ERROR("In computeHashOfFile: closeMappedFile function did not ");
+        fprintf(stderr,"return zero, which was the expected value here.\n");
+        return 0;
+    }
+
+    return 1;
+}
+
 /* ************************************************************************** */
 // The function copyFileLocation tries to copy a file (using system function)
 // located at fileLocation (a path name of length strictly less than nameLength)
@@ -1476,20 +2923,90 @@ int renameFileLocation(char* fileLocation, int nameLength,
     {
         fprintf(stdout,"\n%s\n",commandLine);
     }
-    if (system(commandLine))
+    if (system(commandLine))
+    {
+        PRINT_ERROR("In renameFileLocation: wrong return of the system ");
+        fprintf(stderr,"(standard) c-function.\n");
+        free(commandLine);
+        commandLine=NULL;
+        return 0;
+    }
+
+    // Free the dynamically allocated memory
+    free(commandLine);
+    commandLine=NULL;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function runExternalCommand executes the commandLine thanks to the
+// standard system c-function inside the given phase of the global profiler
+// (globalProfiler variable). When the profiler is active, the sizes of the
+// *.mesh file located at nameMesh and of its associated *.sol file are also
+// counted as read bytes if they exist before the call, and as written bytes if
+// they have been created or modified by the command. It has the two char*
+// variables (commandLine, nameMesh) and the int phase as input arguments and it
+// returns the value returned by the system c-function (zero on success)
+/* ************************************************************************** */
+int runExternalCommand(char* commandLine, int phase, char* nameMesh)
+{
+    size_t length=0;
+    int i=0, returnValue=0, pBefore[2]={0}, pAfter[2]={0};
+    double bytesRead=0., bytesWritten=0.;
+    char *pFileLocation[2]={NULL};
+    struct stat pStatusBefore[2], pStatusAfter[2];
+
+    if (!globalProfiler.active || nameMesh==NULL)
+    {
+        return system(commandLine);
+    }
+
+    // Build the *.sol file name associated with the *.mesh one
+    length=strlen(nameMesh);
+    pFileLocation[0]=nameMesh;
+    if (length>5 && !strcmp(nameMesh+length-5,".mesh"))
+    {
+        // calloc returns a pointer to the allocated memory, otherwise NULL
+        pFileLocation[1]=(char*)calloc(length+1,sizeof(char));
+        if (pFileLocation[1]!=NULL)
+        {
+            strcpy(pFileLocation[1],nameMesh);
+            strcpy(pFileLocation[1]+length-5,".sol");
+        }
+    }
+
+    // stat returns zero on success, otherwise -1
+    for (i=0; i<2; i++)
+    {
+        pBefore[i]=(pFileLocation[i]!=NULL &&
+                                     !stat(pFileLocation[i],&pStatusBefore[i]));
+        if (pBefore[i])
+        {
+            bytesRead+=(double)pStatusBefore[i].st_size;
+        }
+    }
+
+    beginProfilerPhase(&globalProfiler,phase);
+    returnValue=system(commandLine);
+    for (i=0; i<2; i++)
     {
-        PRINT_ERROR("In renameFileLocation: wrong return of the system ");
-        fprintf(stderr,"(standard) c-function.\n");
-        free(commandLine);
-        commandLine=NULL;
-        return 0;
+        pAfter[i]=(pFileLocation[i]!=NULL &&
+                                      !stat(pFileLocation[i],&pStatusAfter[i]));
+        if (pAfter[i] && (!pBefore[i] ||
+                   pStatusAfter[i].st_mtime!=pStatusBefore[i].st_mtime ||
+                          pStatusAfter[i].st_size!=pStatusBefore[i].st_size))
+        {
+            bytesWritten+=(double)pStatusAfter[i].st_size;
+        }
     }
+    addProfilerBytes(&globalProfiler,bytesRead,bytesWritten);
+    endProfilerPhase(&globalProfiler,phase);
 
-    // Free the dynamically allocated memory
-    free(commandLine);
-    commandLine=NULL;
+    free(pFileLocation[1]);
+    pFileLocation[1]=NULL;
 
-    return 1;
+    return returnValue;
 }
 
 /* ************************************************************************** */
@@ -1598,8 +3115,11 @@ int plotMeshWithMeditSoftware(Parameters* pParameters)
 // been previously installed and whose path is stored in the
 // pParameters->path_mmg3d variable, in order to adapt the mesh according to the
 // adaptMode and the parameters stored in the structure pointed by pParameters.
-// It has the Parameters* (defined in main.h) and the char[4] adaptMode as
-// input arguments and it returns one on success otherwise zero is returned
+// In the Lagrangian mode, the -noext option of mmg3d is not used since the
+// shape gradient is only saved at the boundary vertices (writingShapeSolFile
+// function) and must be extended by mmg3d. It has the Parameters* (defined in
+// main.h) and the char[4] adaptMode as input arguments and it returns one on
+// success otherwise zero is returned
 /* ************************************************************************** */
 int adaptMeshWithMmg3dSoftware(Parameters* pParameters, char adaptMode[4])
 {
@@ -1832,7 +3352,7 @@ int adaptMeshWithMmg3dSoftware(Parameters* pParameters, char adaptMode[4])
             }
         }
     }
-    if (system(commandLine))
+    if (runExternalCommand(commandLine,PROF_MMG3D,pParameters->name_mesh))
     {
         PRINT_ERROR("In adaptMeshWithMmg3dSoftware: wrong return of the ");
         fprintf(stderr,"system (standard) c-function.\n");
@@ -2062,7 +3582,7 @@ int renormalizeWithMshdistSoftware(Parameters* pParameters, char mode[4])
         }
     }
 
-    if (system(commandLine))
+    if (runExternalCommand(commandLine,PROF_MSHDIST,pParameters->name_mesh))
     {
         PRINT_ERROR("In renormalizeWithMshdistSoftware: wrong return of the ");
         fprintf(stderr,"system (standard) c-function.\n");
@@ -2229,7 +3749,7 @@ int extendShapeGradientWithElasticSoftware(Parameters* pParameters)
     {
         fprintf(stdout,"\n%s\n",commandLine);
     }
-    if (system(commandLine))
+    if (runExternalCommand(commandLine,PROF_ELASTIC,pParameters->name_mesh))
     {
         PRINT_ERROR("In extendShapeGradientWithElasticSoftware: wrong ");
         fprintf(stderr,"return of the system (standard) c-function.\n");
@@ -2390,7 +3910,7 @@ int advectLevelSetWithAdvectSoftware(Parameters* pParameters)
     {
         fprintf(stdout,"\n%s\n",commandLine);
     }
-    if (system(commandLine))
+    if (runExternalCommand(commandLine,PROF_ADVECT,pParameters->name_mesh))
     {
         PRINT_ERROR("In advectLevelSetWithAdvectSoftware: wrong return of ");
         fprintf(stderr,"the system (standard) c-function.\n");
@@ -2422,3 +3942,645 @@ int advectLevelSetWithAdvectSoftware(Parameters* pParameters)
 }
 
 
+
+/* ************************************************************************** */
+// The function freeJobMemory frees the memory dynamically allocated for the
+// array of nJob Job structures (defined in main.h) pointed by pJob, including
+// the array itself. It has the Job* variable and its size as input arguments
+// and it does not return any value (void output)
+/* ************************************************************************** */
+void freeJobMemory(Job* pJob, int nJob)
+{
+    int i=0;
+
+    if (pJob!=NULL)
+    {
+        for (i=0; i<nJob; i++)
+        {
+            // The free function does not return any value (void output)
+            free(pJob[i].directory);
+            pJob[i].directory=NULL;
+
+            free(pJob[i].name);
+            pJob[i].name=NULL;
+
+            free(pJob[i].chemistry);
+            pJob[i].chemistry=NULL;
+        }
+        free(pJob);
+    }
+
+    return;
+}
+
+/* ************************************************************************** */
+// The function readManifestOfJobs reads the manifest file of the batch mode,
+// where each line gives the path of one *.info file (empty lines and lines
+// starting with '#' are skipped), and allocates the corresponding array of Job
+// structures (defined in main.h). It has the char* fileLocation variable, the
+// address of the Job* variable to allocate and the address of the int variable
+// storing its size as input arguments, and it returns zero if an error occurs,
+// otherwise one is returned
+/* ************************************************************************** */
+int readManifestOfJobs(char* fileLocation, Job** ppJob, int* pNumberOfJobs)
+{
+    size_t lengthLine=0;
+    ssize_t readLength=0;
+    char *line=NULL, *pSlash=NULL;
+    int nJob=0, nMax=0, length=0;
+    Job *pJob=NULL, *pNewJob=NULL;
+    FILE *manifestFile=NULL;
+
+    // Check the input variables
+    if (fileLocation==NULL || ppJob==NULL || pNumberOfJobs==NULL)
+    {
+        PRINT_ERROR("In readManifestOfJobs: at least one of the input ");
+        fprintf(stderr,"variables fileLocation=%p, ",(void*)fileLocation);
+        fprintf(stderr,"ppJob=%p, or ",(void*)ppJob);
+        fprintf(stderr,"pNumberOfJobs=%p does not ",(void*)pNumberOfJobs);
+        fprintf(stderr,"point to a valid address.\n");
+        return 0;
+    }
+    *ppJob=NULL;
+    *pNumberOfJobs=0;
+
+    // fopen function returns a FILE pointer on success, otherwise NULL
+    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    manifestFile=fopen(fileLocation,"r");
+    if (manifestFile==NULL)
+    {
+        PRINT_ERROR("In readManifestOfJobs: we were not able to open the ");
+        fprintf(stderr,"%s manifest file.\n",fileLocation);
+        return 0;
+    }
+    fprintf(stdout,"Reading jobs. ");
+
+    // getline function returns the number of characters read (including the
+    // '\n' one but not the final '\0'), otherwise -1 at the end of the file
+    while ((readLength=getline(&line,&lengthLine,manifestFile))!=-1)
+    {
+        // Remove the final white-space characters and skip comments
+        length=(int)readLength;
+        while (length>0 && (line[length-1]=='\n' || line[length-1]=='\r' ||
+                                line[length-1]==' ' || line[length-1]=='\t'))
+        {
+            length--;
+        }
+        line[length]='\0';
+        if (!length || line[0]=='#')
+        {
+            continue;
+        }
+
+        // Check that the job refers to a *.info file
+        if (length<6 || strcmp(&line[length-5],".info"))
+        {
+            PRINT_ERROR("In readManifestOfJobs: the line ");
+            fprintf(stderr,"*%s* of the %s manifest ",line,fileLocation);
+            fprintf(stderr,"file does not end with the '.info' extension.\n");
+            free(line);
+            line=NULL;
+            closeTheFile(&manifestFile);
+            freeJobMemory(pJob,nJob);
+            return 0;
+        }
+
+        // realloc function returns a pointer to the reallocated memory,
+        // otherwise NULL (the initial memory is then left untouched)
+        if (nJob==nMax)
+        {
+            nMax=2*nMax+8;
+            pNewJob=(Job*)realloc(pJob,nMax*sizeof(Job));
+            if (pNewJob==NULL)
+            {
+                PRINT_ERROR("In readManifestOfJobs: could not reallocate ");
+                fprintf(stderr,"memory for the local (Job*) pJob ");
+                fprintf(stderr,"variable.\n");
+                free(line);
+                line=NULL;
+                closeTheFile(&manifestFile);
+                freeJobMemory(pJob,nJob);
+                return 0;
+            }
+            pJob=pNewJob;
+        }
+
+        // Split the path into the directory and the *.info file name
+        pJob[nJob].directory=(char*)calloc(length+3,sizeof(char));
+        pJob[nJob].name=(char*)calloc(length+1,sizeof(char));
+        pJob[nJob].chemistry=NULL;
+        pJob[nJob].group=-1;
+        pJob[nJob].ncpu=0;
+        pJob[nJob].status=-1;
+        pJob[nJob].pid=0;
+        pJob[nJob].start=0;
+        pJob[nJob].end=0;
+        nJob++;
+        if (pJob[nJob-1].directory==NULL || pJob[nJob-1].name==NULL)
+        {
+            PRINT_ERROR("In readManifestOfJobs: could not allocate memory ");
+            fprintf(stderr,"for the names of the %d-th job.\n",nJob);
+            free(line);
+            line=NULL;
+            closeTheFile(&manifestFile);
+            freeJobMemory(pJob,nJob);
+            return 0;
+        }
+        pSlash=strrchr(line,'/');
+        if (pSlash==NULL)
+        {
+            strcpy(pJob[nJob-1].directory,"./");
+            strcpy(pJob[nJob-1].name,line);
+        }
+        else
+        {
+            strcpy(pJob[nJob-1].name,pSlash+1);
+            *(pSlash+1)='\0';
+            strcpy(pJob[nJob-1].directory,line);
+        }
+    }
+    free(line);
+    line=NULL;
+
+    // Closing the manifest file: fclose function returns zero if the input
+    // FILE* variable is successfully closed, otherwise EOF is returned
+    if (fclose(manifestFile))
+    {
+        PRINT_ERROR("In readManifestOfJobs: the ");
+        fprintf(stderr,"%s file has not been closed properly.\n",fileLocation);
+        manifestFile=NULL;
+        freeJobMemory(pJob,nJob);
+        return 0;
+    }
+    fprintf(stdout,"Closing file.\n");
+    manifestFile=NULL;
+
+    if (!nJob)
+    {
+        PRINT_ERROR("In readManifestOfJobs: no *.info file has been found ");
+        fprintf(stderr,"in the %s manifest file.\n",fileLocation);
+        return 0;
+    }
+
+    *ppJob=pJob;
+    *pNumberOfJobs=nJob;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function prepareJobsOfBatch loads the parameters of each job (in its own
+// directory) in order to get its number of threads and the absolute path of
+// its chemical file, groups the jobs sharing the same chemical file (the jobs
+// of a group are then launched one after the other), and loads once the
+// chemistry of each group so that its binary cache (*.chemb) is built (in the
+// initial directory unless MPD_CACHE_DIR is set) before the jobs are launched.
+// It has the Job* variable (defined in main.h), its size and the number of
+// cores of the pool as input arguments, and it returns zero if an error occurs,
+// otherwise one is returned
+/* ************************************************************************** */
+int prepareJobsOfBatch(Job* pJob, int nJob, int nCore)
+{
+    int i=0, j=0, nGroup=0, format=0, initialDirectory=-1, boolean=0;
+    char *cacheDirectory=NULL;
+    Job job;
+    Parameters parameters;
+    ChemicalSystem chemicalSystem;
+
+    // Check the input variables
+    if (pJob==NULL || nJob<1 || nCore<1)
+    {
+        PRINT_ERROR("In prepareJobsOfBatch: the input pJob variable ");
+        fprintf(stderr,"(=%p) must point to an array of ",(void*)pJob);
+        fprintf(stderr,"nJob (=%d) jobs and nCore ",nJob);
+        fprintf(stderr,"(=%d) must be positive.\n",nCore);
+        return 0;
+    }
+
+    // open function returns a file descriptor on success, otherwise -1
+    initialDirectory=open(".",O_RDONLY);
+    if (initialDirectory==-1)
+    {
+        PRINT_ERROR("In prepareJobsOfBatch: wrong return (=-1) of the ");
+        fprintf(stderr,"open c-function in the attempt of opening the ");
+        fprintf(stderr,"current directory.\n");
+        return 0;
+    }
+
+    // Unless a cache directory is already set, the binary caches are written
+    // in the initial directory so that the jobs (run in their own directory)
+    // of a group all read the cache built here (getcwd returns the allocated
+    // absolute path name on success, otherwise NULL)
+    if (getenv(CHEM_CACHE_DIRECTORY)==NULL)
+    {
+        cacheDirectory=getcwd(NULL,0);
+        if (cacheDirectory==NULL ||
+                                 setenv(CHEM_CACHE_DIRECTORY,cacheDirectory,1))
+        {
+            PRINT_ERROR("In prepareJobsOfBatch: wrong return of the getcwd ");
+            fprintf(stderr,"or setenv c-function in the attempt of setting ");
+            fprintf(stderr,"the %s environment ",CHEM_CACHE_DIRECTORY);
+            fprintf(stderr,"variable to the current directory.\n");
+            free(cacheDirectory);
+            close(initialDirectory);
+            return 0;
+        }
+        free(cacheDirectory);
+        cacheDirectory=NULL;
+    }
+
+    for (i=0; i<nJob; i++)
+    {
+        // chdir function returns zero on success, otherwise -1
+        if (chdir(pJob[i].directory))
+        {
+            PRINT_ERROR("In prepareJobsOfBatch: wrong return (=-1) of the ");
+            fprintf(stderr,"chdir c-function in the attempt of entering the ");
+            fprintf(stderr,"%s directory.\n",pJob[i].directory);
+            close(initialDirectory);
+            return 0;
+        }
+
+        // Load the parameters of the job (as it will be done by the job)
+        if (!loadParameters(&parameters,pJob[i].name))
+        {
+            PRINT_ERROR("In prepareJobsOfBatch: loadParameters function ");
+            fprintf(stderr,"returned zero instead of one for the ");
+            fprintf(stderr,"%s%s file.\n",pJob[i].directory,pJob[i].name);
+            freeParameterMemory(&parameters);
+            fchdir(initialDirectory);
+            close(initialDirectory);
+            return 0;
+        }
+        pJob[i].ncpu=DEF_MIN(DEF_MAX(parameters.n_cpu,1),nCore);
+
+        // realpath function returns the (allocated) absolute path name on
+        // success, otherwise NULL
+        pJob[i].chemistry=realpath(parameters.name_chem,NULL);
+        if (pJob[i].chemistry==NULL)
+        {
+            PRINT_ERROR("In prepareJobsOfBatch: wrong return (=NULL) of the ");
+            fprintf(stderr,"realpath c-function in the attempt of locating ");
+            fprintf(stderr,"the %s chemical file ",parameters.name_chem);
+            fprintf(stderr,"of the %s%s job.\n",pJob[i].directory,pJob[i].name);
+            freeParameterMemory(&parameters);
+            fchdir(initialDirectory);
+            close(initialDirectory);
+            return 0;
+        }
+
+        // Look for a previous job sharing the same chemical file
+        for (j=0; j<i; j++)
+        {
+            if (!strcmp(pJob[j].chemistry,pJob[i].chemistry))
+            {
+                pJob[i].group=pJob[j].group;
+                break;
+            }
+        }
+
+        // Otherwise, a new group is created and its chemistry is loaded once
+        // in order to build the binary cache read by all the jobs of the group
+        if (j==i)
+        {
+            pJob[i].group=nGroup;
+            nGroup++;
+            initializeChemicalStructure(&chemicalSystem);
+            format=getChemicalFormat(parameters.name_chem,
+                                                        parameters.name_length);
+            boolean=(abs(format)==1);
+            if (boolean)
+            {
+                boolean=abs(readChemicalFileOrCache(parameters.name_chem,
+                                                    parameters.name_length,
+                                                    format,&chemicalSystem,
+                                                                        NULL));
+            }
+            freeChemicalMemory(&chemicalSystem);
+            if (boolean!=1)
+            {
+                PRINT_ERROR("In prepareJobsOfBatch: the chemistry of the ");
+                fprintf(stderr,"%s file could not be ",parameters.name_chem);
+                fprintf(stderr,"loaded (getChemicalFormat or ");
+                fprintf(stderr,"readChemicalFileOrCache function failed).\n");
+                freeParameterMemory(&parameters);
+                fchdir(initialDirectory);
+                close(initialDirectory);
+                return 0;
+            }
+        }
+        freeParameterMemory(&parameters);
+
+        // fchdir function returns zero on success, otherwise -1
+        if (fchdir(initialDirectory))
+        {
+            PRINT_ERROR("In prepareJobsOfBatch: wrong return (=-1) of the ");
+            fprintf(stderr,"fchdir c-function in the attempt of going back ");
+            fprintf(stderr,"to the initial directory.\n");
+            close(initialDirectory);
+            return 0;
+        }
+    }
+    close(initialDirectory);
+
+    // Stable insertion sort of the jobs by group
+    for (i=1; i<nJob; i++)
+    {
+        job=pJob[i];
+        j=i;
+        while (j>0 && pJob[j-1].group>job.group)
+        {
+            pJob[j]=pJob[j-1];
+            j--;
+        }
+        pJob[j]=job;
+    }
+
+    fprintf(stdout,"\n%d job",nJob);
+    if (nJob>1)
+    {
+        fprintf(stdout,"s");
+    }
+    fprintf(stdout," sharing %d chemical file",nGroup);
+    if (nGroup>1)
+    {
+        fprintf(stdout,"s");
+    }
+    fprintf(stdout," will be run on a pool of %d core",nCore);
+    if (nCore>1)
+    {
+        fprintf(stdout,"s");
+    }
+    fprintf(stdout,".\n");
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function launchJobOfBatch runs the job pointed by pJob in a child process
+// that enters the directory of the job, redirects its standard output and error
+// streams into a *.log file (the *.info file name where the '.info' extension
+// is replaced by the '.log' one), and executes the MPD program on its *.info
+// file. It has the Job* variable (defined in main.h) and the path name of the
+// MPD program as input arguments, and it returns zero if an error occurs,
+// otherwise one is returned (the child process never returns)
+/* ************************************************************************** */
+int launchJobOfBatch(Job* pJob, char* programLocation)
+{
+    size_t length=0;
+    char *logLocation=NULL, *argumentList[3]={NULL};
+
+    // Check the input variables
+    if (pJob==NULL || programLocation==NULL)
+    {
+        PRINT_ERROR("In launchJobOfBatch: at least one of the input ");
+        fprintf(stderr,"variables pJob=%p or ",(void*)pJob);
+        fprintf(stderr,"programLocation=%p does not ",(void*)programLocation);
+        fprintf(stderr,"point to a valid address.\n");
+        return 0;
+    }
+
+    // Build the name of the *.log file
+    length=strlen(pJob->name);
+    logLocation=(char*)calloc(length+1,sizeof(char));
+    if (logLocation==NULL)
+    {
+        PRINT_ERROR("In launchJobOfBatch: could not allocate memory for the ");
+        fprintf(stderr,"local (char*) logLocation variable.\n");
+        return 0;
+    }
+    memcpy(logLocation,pJob->name,(length-5)*sizeof(char));
+    strcat(logLocation,".log");
+
+    // fflush avoids writing twice the buffered outputs (parent and child), and
+    // fork function returns the process identifier of the child to the parent,
+    // zero to the child, and -1 on error (no child process is created)
+    fflush(NULL);
+    time(&pJob->start);
+    pJob->pid=fork();
+    if (pJob->pid==-1)
+    {
+        PRINT_ERROR("In launchJobOfBatch: wrong return (=-1) of the fork ");
+        fprintf(stderr,"c-function for the %s%s ",pJob->directory,pJob->name);
+        fprintf(stderr,"job.\n");
+        free(logLocation);
+        logLocation=NULL;
+        return 0;
+    }
+
+    // Child process: execvp function only returns if an error occurs
+    if (!pJob->pid)
+    {
+        if (chdir(pJob->directory) || freopen(logLocation,"w",stdout)==NULL ||
+                                   dup2(fileno(stdout),STDERR_FILENO)==-1)
+        {
+            _exit(EXIT_FAILURE);
+        }
+        argumentList[0]=programLocation;
+        argumentList[1]=pJob->name;
+        argumentList[2]=NULL;
+        execvp(programLocation,argumentList);
+        _exit(EXIT_FAILURE);
+    }
+
+    pJob->status=0;
+    fprintf(stdout,"\nJob %s%s launched ",pJob->directory,pJob->name);
+    fprintf(stdout,"(process %d, %d thread",(int)pJob->pid,pJob->ncpu);
+    if (pJob->ncpu>1)
+    {
+        fprintf(stdout,"s");
+    }
+    fprintf(stdout,", outputs in %s%s).\n",pJob->directory,logLocation);
+
+    free(logLocation);
+    logLocation=NULL;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function runBatchOfJobs runs all the jobs listed in the manifest file on
+// a pool of nCore cores: a job is launched as soon as the number of threads of
+// the running jobs allows it (at least one job is always running), so that the
+// cores freed by a job are immediately taken by the next ones and the machine
+// is never oversubscribed. It has the name of the MPD program (argv[0]), the
+// manifest file name, and the number of cores (if not positive, the number of
+// online processors is used) as input arguments. It returns one if all the jobs
+// ended successfully, otherwise zero is returned
+/* ************************************************************************** */
+int runBatchOfJobs(char* programName, char* manifestLocation, int nCore)
+{
+    int i=0, nJob=0, nextJob=0, nRunning=0, nUsed=0, nFailed=0, status=0;
+    char *programLocation=NULL;
+    pid_t pid=0;
+    Job *pJob=NULL;
+
+    // Check the input variables
+    if (programName==NULL || manifestLocation==NULL)
+    {
+        PRINT_ERROR("In runBatchOfJobs: at least one of the input variables ");
+        fprintf(stderr,"programName=%p or ",(void*)programName);
+        fprintf(stderr,"manifestLocation=%p does ",(void*)manifestLocation);
+        fprintf(stderr,"not point to a valid address.\n");
+        return 0;
+    }
+
+    // sysconf function returns the number of online processors, otherwise -1
+    if (nCore<1)
+    {
+        nCore=(int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (nCore<1)
+        {
+            nCore=1;
+        }
+    }
+
+    // The jobs are run in other directories so the MPD program is located
+    // now (a name without '/' is searched in the PATH directories by execvp)
+    if (strchr(programName,'/')!=NULL)
+    {
+        programLocation=realpath(programName,NULL);
+    }
+    else
+    {
+        programLocation=(char*)calloc(strlen(programName)+1,sizeof(char));
+        if (programLocation!=NULL)
+        {
+            strcpy(programLocation,programName);
+        }
+    }
+    if (programLocation==NULL)
+    {
+        PRINT_ERROR("In runBatchOfJobs: the location of the ");
+        fprintf(stderr,"%s program could not be stored.\n",programName);
+        return 0;
+    }
+
+    if (!readManifestOfJobs(manifestLocation,&pJob,&nJob))
+    {
+        PRINT_ERROR("In runBatchOfJobs: readManifestOfJobs function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        free(programLocation);
+        programLocation=NULL;
+        return 0;
+    }
+
+    if (!prepareJobsOfBatch(pJob,nJob,nCore))
+    {
+        PRINT_ERROR("In runBatchOfJobs: prepareJobsOfBatch function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        freeJobMemory(pJob,nJob);
+        free(programLocation);
+        programLocation=NULL;
+        return 0;
+    }
+
+    // Launch the jobs in order as soon as enough cores are free
+    while (nextJob<nJob || nRunning>0)
+    {
+        while (nextJob<nJob && (!nRunning || nUsed+pJob[nextJob].ncpu<=nCore))
+        {
+            if (!launchJobOfBatch(&pJob[nextJob],programLocation))
+            {
+                PRINT_ERROR("In runBatchOfJobs: launchJobOfBatch function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                pJob[nextJob].status=2;
+                nFailed++;
+                nextJob++;
+                continue;
+            }
+            nUsed+=pJob[nextJob].ncpu;
+            nRunning++;
+            nextJob++;
+        }
+        if (!nRunning)
+        {
+            continue;
+        }
+
+        // waitpid function returns the process identifier of the ended child,
+        // otherwise -1 (errno is set to EINTR if interrupted by a signal)
+        pid=waitpid(-1,&status,0);
+        if (pid==-1)
+        {
+            if (errno==EINTR)
+            {
+                continue;
+            }
+            PRINT_ERROR("In runBatchOfJobs: wrong return (=-1) of the ");
+            fprintf(stderr,"waitpid c-function while %d job",nRunning);
+            fprintf(stderr,"(s) should still be running.\n");
+            for (i=0; i<nJob; i++)
+            {
+                if (!pJob[i].status)
+                {
+                    pJob[i].status=2;
+                    nFailed++;
+                }
+            }
+            nRunning=0;
+            nextJob=nJob;
+            continue;
+        }
+        for (i=0; i<nJob; i++)
+        {
+            if (!pJob[i].status && pJob[i].pid==pid)
+            {
+                break;
+            }
+        }
+        if (i==nJob)
+        {
+            continue;
+        }
+        time(&pJob[i].end);
+        pJob[i].status=2;
+        if (WIFEXITED(status) && WEXITSTATUS(status)==EXIT_SUCCESS)
+        {
+            pJob[i].status=1;
+        }
+        else
+        {
+            nFailed++;
+        }
+        nUsed-=pJob[i].ncpu;
+        nRunning--;
+        fprintf(stdout,"\nJob %s%s ",pJob[i].directory,pJob[i].name);
+        if (pJob[i].status==1)
+        {
+            fprintf(stdout,"ended successfully in ");
+        }
+        else
+        {
+            fprintf(stdout,"FAILED after ");
+        }
+        printTimer(pJob[i].end,pJob[i].start);
+        fprintf(stdout,".\n");
+    }
+
+    // Summary of the batch
+    fprintf(stdout,"\n%d job",nJob);
+    if (nJob>1)
+    {
+        fprintf(stdout,"s");
+    }
+    fprintf(stdout," run, %d failed",nFailed);
+    if (nFailed)
+    {
+        fprintf(stdout,":");
+        for (i=0; i<nJob; i++)
+        {
+            if (pJob[i].status!=1)
+            {
+                fprintf(stdout," %s%s",pJob[i].directory,pJob[i].name);
+            }
+        }
+    }
+    fprintf(stdout,".\n");
+
+    freeJobMemory(pJob,nJob);
+    free(programLocation);
+    programLocation=NULL;
+
+    return (!nFailed);
+}
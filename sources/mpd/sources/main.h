@@ -28,6 +28,28 @@
 #include <lapacke.h> // if it is not in comment add -llapacke with gcc command
 #include <omp.h>     // if it is not in comment add -fopenmp with gcc command
 
+/* ************************************************************************** */
+// POSIX header files used to map the input files (*.wfn, *.chem, *.mesh, and
+// *.cube) directly into memory instead of reading them through a FILE* stream
+/* ************************************************************************** */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+/* ************************************************************************** */
+// POSIX header file used to write the mesh snapshots of the optimization loop
+// in a background thread (if it is not in comment add -pthread with gcc)
+/* ************************************************************************** */
+#include <pthread.h>
+
+/* ************************************************************************** */
+// POSIX header files used to wait for the child processes running the jobs of
+// the batch mode (several *.info files listed in a manifest file)
+/* ************************************************************************** */
+#include <errno.h>
+#include <sys/wait.h>
+
 
 /* ************************************************************************** */
 // Macro functions to initialize the diagnostic of an error, to get the
@@ -350,7 +372,9 @@ typedef struct {
                              *    details in the standard output stream;
                              *    otherwise, it must be set to zero and very
                              *    little is shown during the execution of the
-                             *    MPD algorithm. */
+                             *    MPD algorithm (minus one is only used for the
+                             *    copies handed to the background snapshot
+                             *    writer, which must not print anything). */
 
     int n_cpu;               /*!< Number of cpu/threads required for the
                              *    parallelization by openmp in the MPD program
@@ -572,6 +596,56 @@ typedef struct {
                              *    times the integrand value at the cube element
                              *    center). */
 
+    int n_level;             /*!< Only used if \ref opt_mode=-(two/one/zero):
+                             *    number of times the hexahedral grid is
+                             *    refined (each hexahedron being divided into
+                             *    eight) when the stop criteria are satisfied
+                             *    on the current grid, instead of stopping the
+                             *    optimization loop; it must not be negative
+                             *    (zero means that the optimization is only
+                             *    performed on the initial grid). */
+
+    int n_prune;             /*!< Only used if \ref opt_mode=-(two/zero): if
+                             *    set to zero, all the hexahedra touching the
+                             *    boundary of the domain are tried in the
+                             *    exhaustive search; otherwise, they are tried
+                             *    by decreasing order of the first-order
+                             *    variation of the probability given by the
+                             *    shape gradient, and the search stops after
+                             *    n_prune consecutive candidates that do not
+                             *    increase the probability. */
+
+    int n_start;             /*!< Only used if \ref opt_mode=-(two/one/zero):
+                             *    number of initial domains optimized in the
+                             *    same run (multi-start mode), sharing the
+                             *    loaded chemistry and the grid; if set to
+                             *    zero, only the domain given by the ls_*
+                             *    keywords is optimized. It must not be
+                             *    negative. */
+
+    double* ls_start;        /*!< Only used if \ref n_start is positive:
+                             *    array of size 5*\ref n_start storing, for
+                             *    each start, the values (ls_type, ls_x, ls_y,
+                             *    ls_z, ls_r) of its initial domain, read in
+                             *    the n_start lines following the 'n_start'
+                             *    keyword in the *.info file. */
+
+    int n_geom;              /*!< Only used if \ref opt_mode=-(two/one/zero):
+                             *    number of next geometries of a scan (reaction
+                             *    path, bond scan), each one starting from the
+                             *    converged domain of the previous one moved
+                             *    along the displacements of the nuclei; if set
+                             *    to zero, only the geometry of \ref name_chem
+                             *    is optimized. It must not be negative. */
+
+    char** name_geom;        /*!< Only used if \ref n_geom is positive: array
+                             *    of size \ref n_geom storing the names of the
+                             *    (*.chem/ *.wfn) chemical files of the next
+                             *    geometries (each one of size \ref
+                             *    name_length), read in the n_geom lines
+                             *    following the 'n_geom' keyword in the *.info
+                             *    file. */
+
 
     // Parameters ruling the stop criteria in the optimization loop
     int iter_max;            /*!< Maximum number of iterations allowed in the
@@ -609,10 +683,14 @@ typedef struct {
     // Parameters ruling the saving of data in the optimization loop
     int save_type;           /*!< If set to one, then the mesh is saved using
                              *    the *.mesh format; if set to zero, then the
-                             *    mesh is saved using the *.cube format;
-                             *    otherwise, it must be set to two, and in this
-                             *    case, the mesh is saved in both *.cube and
-                             *    *.mesh format. */
+                             *    mesh is saved using the *.cube format; if set
+                             *    to two, the mesh is saved in both *.cube and
+                             *    *.mesh format; otherwise, it must be set to
+                             *    three (only if \ref opt_mode is not
+                             *    positive), and in this case, the labels of
+                             *    the hexahedra are appended with the data in
+                             *    a compact *.hist history file instead (see
+                             *    \ref writingHistoryFile). */
 
     int save_mesh;           /*!< Frequency at which the mesh is saved in the
                              *    optimization loop: it cannot be negative
@@ -623,6 +701,21 @@ typedef struct {
                              *    structure for further details): it must not be
                              *    negative (zero means data are never saved). */
 
+    int save_check;          /*!< Frequency at which a binary checkpoint of the
+                             *    whole state of the optimization loop is
+                             *    written in the *.chk file associated with
+                             *    \ref name_info (see \ref
+                             *    writingCheckpointFile): it must not be
+                             *    negative (zero means that no checkpoint is
+                             *    written). */
+
+    int save_prof;           /*!< Type of the report written by the profiler of
+                             *    the run in the *.prof.json/ *.prof.csv file
+                             *    associated with \ref name_info (see \ref
+                             *    startProfiler): zero means that the run is
+                             *    not profiled, one (resp. two) that the report
+                             *    is written in the JSON (resp. CSV) format. */
+
     int save_print;          /*!< Frequency at which the mesh is displayed with
                              *    medit (warning: the software must have been
                              *    previously installed and every time that medit
@@ -1102,11 +1195,10 @@ typedef struct {
                              *    of the MPD algorithm (stored in the iter_max
                              *    variable of the Parameters structure); for any
                              *    \ref pnu, \ref pop, \ref d0p, \ref d1p, \ref
-                             *    d2p, \ref tim, \ref ctim, \ref pprob, and \ref
-                             *    pmat variable that is not pointing to NULL,
-                             *    \ref ndata should always correspond to the
-                             *    (common) size of the array such a variable is
-                             *    pointing to. */
+                             *    d2p, \ref tim, and \ref ctim variable that is
+                             *    not pointing to NULL, \ref ndata should
+                             *    always correspond to the (common) size of the
+                             *    array such a variable is pointing to. */
 
     int niter;               /*!< Number of iterations properly saved in the
                              *    Data Structure since the MPD program is
@@ -1190,6 +1282,17 @@ typedef struct {
                              *    always be positive and its size should
                              *    always correspond to the \ref ndata value. */
 
+    int nring;               /*!< Number of Probabilities and OverlapMatrix
+                             *    structures stored in the arrays pointed by
+                             *    \ref pprob and \ref pmat (if they are not
+                             *    NULL): they are used as a ring buffer, the
+                             *    ones of the (i)-th iteration in the
+                             *    optimization loop being stored at the
+                             *    (i)%(\ref nring) position; it should always be
+                             *    positive and not (strictly) less than two,
+                             *    since the current and previous iterations
+                             *    are needed in the optimization loop. */
+
     int nprob;               /*!< Common value used to size the arrays pointed
                              *    by the non-NULL variables pk and pkl of the
                              *    Probabilities structures stored in the array
@@ -1202,10 +1305,11 @@ typedef struct {
 
     Probabilities* pprob;    /*!< Pointer used to dynamically define the array
                              *    storing all the different types of
-                             *    probabilities during the iterative process; if
-                             *    it is not pointing to NULL, the size of the
-                             *    array it is pointing to should always
-                             *    correspond to the \ref ndata value. */
+                             *    probabilities during the last iterations of
+                             *    the process; if it is not pointing to NULL,
+                             *    the size of the array it is pointing to
+                             *    should always correspond to the \ref nring
+                             *    value. */
 
     int nmat;                /*!< Common value used to size the arrays pointed
                              *    by the non-NULL variables coef, diag, and vect
@@ -1218,11 +1322,11 @@ typedef struct {
 
     OverlapMatrix* pmat;     /*!< Pointer used to dynamically define the array
                              *    storing all the overlap-matrix coefficients,
-                             *    eigenvalues, and eigenvectors during the
-                             *    iterative process; if it is not pointing to
-                             *    NULL, the size of the  array it is pointing to
-                             *    should always correspond to the \ref ndata
-                             *    value. */
+                             *    eigenvalues, and eigenvectors during the last
+                             *    iterations of the process; if it is not
+                             *    pointing to NULL, the size of the array it is
+                             *    pointing to should always correspond to the
+                             *    \ref nring value. */
 } Data;
 
 /* ************************************************************************** */
@@ -1399,66 +1503,16 @@ typedef struct {
 
 /**
 * \struct Hexahedron main.h
-* \brief It can store the label and eight point references of an hexahedron
-*        (only used if opt_mode=-(two/one/zero) in the Parameters structure).
+* \brief It can store the label of an hexahedron (only used if
+*        opt_mode=-(two/one/zero) in the Parameters structure). Since the
+*        hexahedral meshes are always structured grids, the eight point
+*        references of the hexahedron are not stored but recovered from its
+*        position in the array of hexahedra thanks to the getHexahedronVertices
+*        function. The vertices of the grid (Point structures) and the integer
+*        labels are still stored, so that the memory of the hexahedral mode
+*        remains dominated by the vertices.
 */
 typedef struct {
-    int p1;                  /*!< First point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p2;                  /*!< Second point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p3;                  /*!< Third point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p4;                  /*!< Fourth point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p5;                  /*!< Fifth point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p6;                  /*!< Sixth point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p7;                  /*!< Seventh point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
-    int p8;                  /*!< Eighth point of the hexahedron referred to as
-                             *    its position in the array associated with the
-                             *    vertices of the mesh; its value should always
-                             *    be positive and not (strictly) greater than
-                             *    the total number of mesh vertices (stored in
-                             *    the nver variable of the Mesh structure). */
-
    int label;                /*!< Integer value associated with the
                              *    hexahedron. */
 } Hexahedron;
@@ -1498,6 +1552,34 @@ typedef struct {
                              *    the nhex variable of the Mesh structure). */
 } Adjacency;
 
+// Only used if opt_mode=-2/0 and n_prune is positive: Candidate structure is
+// used to sort the hexahedra touching the boundary of the domain in the pruned
+// version of the exhaustive search algorithm
+/**
+* \struct Candidate main.h
+* \brief It stores an hexahedron touching the boundary of the domain together
+*        with the first-order variation of the probability (predicted by the
+*        shape gradient) when the hexahedron is added to or removed from the
+*        domain (only used if opt_mode=-(two/zero) and n_prune is positive in
+*        the Parameters structure).
+*/
+typedef struct {
+    int hex;                 /*!< Integer referring to the position of the
+                             *    hexahedron in the array associated with the
+                             *    hexahedra of the mesh; its value should always
+                             *    be positive and not (strictly) greater than
+                             *    the total number of mesh hexahedra (stored in
+                             *    the nhex variable of the Mesh structure). */
+
+    double dp;               /*!< First-order variation of the probability if
+                             *    the hexahedron is added to the domain (when it
+                             *    is located outside) or removed from it (when
+                             *    it is located inside), i.e. the sum over its
+                             *    boundary quadrilaterals of the shape gradient
+                             *    at their center times their area (with a
+                             *    negative sign for removal). */
+} Candidate;
+
 /**
 * \struct Mesh main.h
 * \brief It can store all the mesh informations needed in the MPD algorithm.
@@ -1665,6 +1747,490 @@ typedef struct {
                              *    value. */
 } Mesh;
 
+/* ************************************************************************** */
+// Definition of the structure used to optimize several initial domains or
+// geometries in the same run (only used if opt_mode=-2/-1/0 and n_start or
+// n_geom is positive)
+/* ************************************************************************** */
+/**
+* \struct Start main.h
+* \brief It can store the parameters, the mesh, and the data of one initial
+*        domain optimized in multi-start mode (or of one geometry optimized in
+*        scan mode), together with the state of its optimization loop (only
+*        used if opt_mode=-(two/one/zero) and n_start or n_geom is positive in
+*        Parameters structure).
+*/
+typedef struct {
+    Parameters parameters;   /*!< Copy of the Parameters structure of the run,
+                             *    where the ls_* variables describe the initial
+                             *    domain of the start, and where the name_info
+                             *    and name_data file names are tagged with
+                             *    '.start' followed by the position of the
+                             *    start (so are thus all its output files). */
+
+    Mesh mesh;               /*!< Mesh structure of the start (all the starts
+                             *    are built on the same hexahedral grid). */
+
+    Data data;               /*!< Data structure of the start. */
+
+    int status;              /*!< Integer set to zero while the optimization
+                             *    loop of the start is running, to one if it
+                             *    has stopped because the stop criteria were
+                             *    satisfied, to two if it has reached the
+                             *    iter_max iterations, and to minus one if it
+                             *    has been cut off because it could not reach
+                             *    anymore the best probability of the run. */
+
+    int iter;                /*!< Next iteration to perform in the optimization
+                             *    loop of the start. */
+
+    int last;                /*!< Last iteration of the optimization loop of
+                             *    the start whose probability has been computed
+                             *    (zero refers to the initial domain). */
+
+    int optMode;             /*!< Saves the opt_mode variable of the structure
+                             *    \ref parameters when opt_mode=0, in order to
+                             *    switch from the shape gradient (opt_mode=-1)
+                             *    to the exhaustive search (opt_mode=-2). */
+
+    int iStop;               /*!< Iteration at which the switch from opt_mode=-1
+                             *    to opt_mode=-2 occurred (only used if
+                             *    \ref optMode is zero). */
+
+    double d0p;              /*!< Saves the d0p value of the \ref data
+                             *    structure at the \ref iStop iteration. */
+
+    double d1p;              /*!< Saves the d1p value of the \ref data
+                             *    structure at the \ref iStop iteration. */
+
+    double d2p;              /*!< Saves the d2p value of the \ref data
+                             *    structure at the \ref iStop iteration. */
+} Start;
+
+/* ************************************************************************** */
+// Definition of the structure used to restart the optimization loop from a
+// binary checkpoint (only used if save_check is positive)
+/* ************************************************************************** */
+/**
+* \struct Checkpoint main.h
+* \brief It can store the local variables of the optimization loop of the
+*        \ref main function that are not saved in the Parameters, Mesh, or Data
+*        structures, so that a run restarted from a *.chk file continues
+*        exactly where the checkpoint has been written.
+*/
+typedef struct {
+    int iter;                /*!< Last iteration completed in the optimization
+                             *    loop when the checkpoint was written (zero if
+                             *    the run does not restart from a checkpoint).
+                             */
+
+    int optMode;             /*!< Saves the optMode variable of the \ref main
+                             *    function, which stores the opt_mode variable
+                             *    of the Parameters structure while it is
+                             *    temporarily switched to another mode. */
+
+    int iStop;               /*!< Iteration at which the switch from opt_mode=-1
+                             *    to opt_mode=-2 occurred (only used if
+                             *    \ref optMode is zero). */
+
+    double d0p;              /*!< Saves the d0p value of the Data structure at
+                             *    the \ref iStop iteration. */
+
+    double d1p;              /*!< Saves the d1p value of the Data structure at
+                             *    the \ref iStop iteration. */
+
+    double d2p;              /*!< Saves the d2p value of the Data structure at
+                             *    the \ref iStop iteration. */
+
+    double deltaT;           /*!< Saves the delta_t variable of the Parameters
+                             *    structure while opt_mode=1 is temporarily
+                             *    switched to opt_mode=2. */
+
+    long dataSize;           /*!< Size (in bytes) of the *.data file when the
+                             *    checkpoint was written (minus one if it did
+                             *    not exist): the file is truncated back to it
+                             *    when the run is restarted. */
+
+    long histSize;           /*!< Size (in bytes) of the *.hist file when the
+                             *    checkpoint was written (minus one if it did
+                             *    not exist or if save_type is not set to 3):
+                             *    the file is truncated back to it when the run
+                             *    is restarted. */
+} Checkpoint;
+
+/* ************************************************************************** */
+// Definition of the structure used to run several *.info files in batch mode
+/* ************************************************************************** */
+/**
+* \struct Job main.h
+* \brief It can store one of the jobs listed in the manifest file of the batch
+*        mode, each job being an MPD run on one *.info file.
+*/
+typedef struct {
+    char* directory;         /*!< Pointer to the (allocated) name of the
+                             *    directory containing the *.info file, where
+                             *    the job is run and writes all its outputs. */
+
+    char* name;              /*!< Pointer to the (allocated) name of the *.info
+                             *    file (relative to \ref directory). */
+
+    char* chemistry;         /*!< Pointer to the (allocated) absolute path of
+                             *    the chemical file of the job (name_chem
+                             *    keyword), used to group the jobs sharing the
+                             *    same chemistry. */
+
+    int group;               /*!< Position of the group of jobs sharing the same
+                             *    \ref chemistry (starting from zero). */
+
+    int ncpu;                /*!< Number of threads used by the job (n_cpu
+                             *    keyword of its *.info file), bounded by the
+                             *    number of cores of the pool. */
+
+    int status;              /*!< Integer set to minus one if the job has not
+                             *    been launched yet, to zero while it is
+                             *    running, to one if it has ended successfully,
+                             *    and to two if it has failed. */
+
+    pid_t pid;               /*!< Process identifier of the child process
+                             *    running the job. */
+
+    time_t start;            /*!< Time at which the job has been launched. */
+
+    time_t end;              /*!< Time at which the job has ended. */
+} Job;
+
+/* ************************************************************************** */
+// Definition of the structure used to read the input files of the MPD program
+/* ************************************************************************** */
+/**
+* \struct MappedFile main.h
+* \brief It can store the content of a file mapped into memory with a reading
+*        cursor, in order to parse its data in one pass without any copy.
+*/
+typedef struct {
+    char* data;              /*!< Pointer to the (read-only) content of the file
+                             *    mapped into memory by the mmap standard
+                             *    (POSIX) c-function; it points to NULL if the
+                             *    file is empty or if the structure has not been
+                             *    opened with the \ref openMappedFile function.
+                             *    Warning: the content is not terminated by a
+                             *    nul character '\0' so it must never be read
+                             *    beyond the \ref size position. */
+
+    size_t size;             /*!< Size (in bytes) of the content pointed by the
+                             *    \ref data variable, which corresponds to the
+                             *    size of the file that has been mapped. */
+
+    size_t pos;              /*!< Current position of the reading cursor in the
+                             *    content pointed by the \ref data variable: it
+                             *    is always comprised between zero and the \ref
+                             *    size value, the latter meaning that the end
+                             *    of the file has been reached. */
+} MappedFile;
+
+/* ************************************************************************** */
+// Definition of the structures used to write the mesh snapshots of the
+// optimization loop in a background thread
+/* ************************************************************************** */
+/**
+* \struct SnapshotJob main.h
+* \brief It can store an immutable snapshot of the mesh taken at one iteration
+*        of the optimization loop, together with the file operations that the
+*        background writer thread has to perform with it.
+*/
+typedef struct {
+    int booleanForSave;      /*!< Integer set to one if the snapshot must be
+                             *    saved, or to zero if the file stored in the
+                             *    \ref fileLocation variable must be removed
+                             *    (in this case the \ref mesh is empty). */
+
+    int booleanForCurrent;   /*!< Integer set to one if the mesh must also be
+                             *    written in the (current) *.mesh file whose
+                             *    name is stored in the name_mesh variable of
+                             *    the \ref parameters structure. */
+
+    char* fileLocation;      /*!< Pointer to the (allocated) name of the
+                             *    *.(iteration).mesh file associated with the
+                             *    snapshot; the *.(iteration).cube/ *.obj file
+                             *    names are built on it. */
+
+    Parameters parameters;   /*!< Copy of the Parameters structure taken when
+                             *    the snapshot was queued; only its name_mesh
+                             *    pointer is owned by the job (allocated copy)
+                             *    and all the other pointers are shared with
+                             *    the Parameters structure of the \ref main
+                             *    function (read only). */
+
+    Mesh mesh;               /*!< Deep copy of the Mesh structure taken when
+                             *    the snapshot was queued (see \ref
+                             *    copyMeshStructure); it is freed by the writer
+                             *    thread once the files have been written. */
+
+    ChemicalSystem* pchem;   /*!< Pointer to the ChemicalSystem structure of
+                             *    the \ref main function (read only), which is
+                             *    not modified during the optimization loop. */
+} SnapshotJob;
+
+/**
+* \struct SnapshotWriter main.h
+* \brief It can store the bounded queue of snapshots and the synchronization
+*        variables of the background thread writing them.
+*/
+typedef struct {
+    int active;              /*!< Integer set to one when the background thread
+                             *    has been started, zero otherwise (in this
+                             *    case the snapshots are written synchronously
+                             *    by the calling thread). */
+
+    int stop;                /*!< Integer set to one to ask the background
+                             *    thread to end once the queue is empty. */
+
+    int error;               /*!< Integer set to one if the background thread
+                             *    failed to write or remove a snapshot; it is
+                             *    reported (and reset) at the next queuing or
+                             *    barrier. */
+
+    int capacity;            /*!< Maximal number of snapshots that can be
+                             *    queued at the same time (size of the array
+                             *    \ref pjob is pointing to). */
+
+    int head;                /*!< Position in \ref pjob of the oldest queued
+                             *    snapshot (the queue is a circular buffer). */
+
+    int count;               /*!< Number of snapshots currently queued (not
+                             *    including the one being written). */
+
+    volatile sig_atomic_t pending;
+                             /*!< Number of snapshots queued or being written;
+                             *    it can be read without locking the mutex
+                             *    (e.g. from the \ref commentAnormalEnd
+                             *    function). */
+
+    SnapshotJob* pjob;       /*!< Pointer used to dynamically define the array
+                             *    storing the queued snapshots. */
+
+    pthread_t thread;        /*!< Identifier of the background writer thread. */
+
+    pthread_mutex_t mutex;   /*!< Mutex protecting all the variables above. */
+
+    pthread_cond_t notEmpty; /*!< Condition signaled when a snapshot is queued
+                             *    or when the thread is asked to stop. */
+
+    pthread_cond_t notFull;  /*!< Condition signaled when a slot of the queue
+                             *    is released. */
+
+    pthread_cond_t allDone;  /*!< Condition signaled when the \ref pending
+                             *    variable reaches zero. */
+} SnapshotWriter;
+
+/**
+* \var globalSnapshotWriter
+* \brief Global variable storing the background writer of mesh snapshots; it is
+*        global in order to be flushed by \ref endTimerAtExit and \ref
+*        commentAnormalEnd when the program stops.
+*/
+extern SnapshotWriter globalSnapshotWriter;
+
+/* ************************************************************************** */
+// Preprocessor constants identifying the phases timed by the profiler of the
+// MPD program (see the save_prof keyword and the Profiler structure)
+/* ************************************************************************** */
+/**
+* \def PROF_SETUP
+* \brief Phase gathering the loading of the chemistry and of the initial mesh,
+*        and the preparation of the initial domain for the optimization loop.
+*/
+#define PROF_SETUP 0
+
+/**
+* \def PROF_ITERATION
+* \brief Phase corresponding to one call of the optimization function (i.e. to
+*        one iteration of the optimization loop).
+*/
+#define PROF_ITERATION 1
+
+/**
+* \def PROF_OVERLAP
+* \brief Phase corresponding to the computation of the overlap matrix (see
+*        computeOverlapMatrix and computeOverlapMatrixOnGrid).
+*/
+#define PROF_OVERLAP 2
+
+/**
+* \def PROF_DIAGONALIZATION
+* \brief Phase corresponding to the diagonalization of the overlap matrix (see
+*        diagonalizeOverlapMatrix).
+*/
+#define PROF_DIAGONALIZATION 3
+
+/**
+* \def PROF_GRADIENT
+* \brief Phase corresponding to the computation of the shape gradient and of
+*        the shape residual (see computeShapeGradient and computeShapeResidual).
+*/
+#define PROF_GRADIENT 4
+
+/**
+* \def PROF_SEARCH
+* \brief Phase corresponding to the search of the best hexahedra to add or to
+*        remove (opt_mode=-2, see exhaustiveSearchAlgorithm and
+*        prunedSearchAlgorithm).
+*/
+#define PROF_SEARCH 5
+
+/**
+* \def PROF_METRIC
+* \brief Phase corresponding to the computation of the metric used to adapt
+*        the mesh with mmg3d (see computeMetric).
+*/
+#define PROF_METRIC 6
+
+/**
+* \def PROF_MMG3D
+* \brief Phase corresponding to the calls of the external mmg3d software.
+*/
+#define PROF_MMG3D 7
+
+/**
+* \def PROF_MSHDIST
+* \brief Phase corresponding to the calls of the external mshdist software.
+*/
+#define PROF_MSHDIST 8
+
+/**
+* \def PROF_ELASTIC
+* \brief Phase corresponding to the calls of the external elastic software.
+*/
+#define PROF_ELASTIC 9
+
+/**
+* \def PROF_ADVECT
+* \brief Phase corresponding to the calls of the external advect software.
+*/
+#define PROF_ADVECT 10
+
+/**
+* \def PROF_IO
+* \brief Phase corresponding to the reading and writing of the *.mesh, *.cube,
+*        *.data, *.hist, and *.chk files by the main thread.
+*/
+#define PROF_IO 11
+
+/**
+* \def PROF_PHASES
+* \brief Total number of phases timed by the profiler.
+*/
+#define PROF_PHASES 12
+
+/**
+* \def PROF_DEPTH
+* \brief Maximal number of nested phases that can be opened at the same time
+*        (the deeper ones are not timed).
+*/
+#define PROF_DEPTH 16
+
+/**
+* \def PROF_STRIDE
+* \brief Number of doubles between two per-thread counters of the profiler
+*        (\ref pbusy and \ref pwork variables of the Profiler structure), so
+*        that the counters updated by different threads never share a cache
+*        line of 64 bytes (false sharing).
+*/
+#define PROF_STRIDE 8
+
+/* ************************************************************************** */
+// Definition of the structure used to profile the phases of the MPD program
+/* ************************************************************************** */
+/**
+* \struct Profiler main.h
+* \brief It can store the monotonic timings of the (nested) phases of the MPD
+*        program, the bytes read and written in each phase, and the busy time
+*        of each thread in the parallelized loops, both for the current record
+*        (one iteration of the optimization loop) and for the whole run.
+*
+* All the counters are arrays of size 2*\ref PROF_PHASES (or
+* 2*\ref PROF_PHASES*\ref nthread for the per-thread ones, each of them being
+* followed by \ref PROF_STRIDE-1 unused doubles): the first half
+* stores the values of the current record, which are added to the second half
+* (the values of the whole run) and reset when the record is written (see
+* \ref writeProfilerRecord).
+*/
+typedef struct {
+    int active;              /*!< Zero if the run is not profiled, otherwise the
+                             *    format of the report (one for JSON and two for
+                             *    CSV, see \ref save_prof). */
+
+    int nthread;             /*!< Number of threads of the parallelized loops
+                             *    (\ref n_cpu variable of the Parameters
+                             *    structure). */
+
+    int depth;               /*!< Number of phases currently opened (the nested
+                             *    ones beyond \ref PROF_DEPTH are ignored). */
+
+    int nrecord;             /*!< Number of records already written. */
+
+    pthread_t owner;         /*!< Identifier of the thread that started the
+                             *    profiler: the phases opened by any other
+                             *    thread (e.g. the background writer of the
+                             *    mesh snapshots) are not timed. */
+
+    double origin;           /*!< Monotonic time (in seconds) at which the
+                             *    profiler has been started. */
+
+    double last;             /*!< Monotonic time (in seconds) at which the last
+                             *    record has been written. */
+
+    int pstack[PROF_DEPTH];  /*!< Phases currently opened (\ref depth first
+                             *    ones). */
+
+    double pbegin[PROF_DEPTH];
+                             /*!< Monotonic times at which the phases of
+                             *    \ref pstack have been opened. */
+
+    double pchild[PROF_DEPTH];
+                             /*!< Time spent in the phases nested in the ones
+                             *    of \ref pstack. */
+
+    int pcall[2*PROF_PHASES];
+                             /*!< Number of times each phase has been closed. */
+
+    double pinclusive[2*PROF_PHASES];
+                             /*!< Time spent in each phase, including its nested
+                             *    phases (a phase nested in itself is counted
+                             *    once). */
+
+    double pself[2*PROF_PHASES];
+                             /*!< Time spent in each phase, excluding its nested
+                             *    phases. */
+
+    double pread[2*PROF_PHASES];
+                             /*!< Number of bytes read in each phase. */
+
+    double pwritten[2*PROF_PHASES];
+                             /*!< Number of bytes written in each phase. */
+
+    double* pbusy;           /*!< Pointer used to dynamically define the array
+                             *    storing the time spent by each thread in the
+                             *    parallelized loops of each phase (the value
+                             *    of the k-th thread for the phase p of the
+                             *    current record is stored at the position
+                             *    (p*\ref nthread+k)*\ref PROF_STRIDE). */
+
+    double* pwork;           /*!< Pointer used to dynamically define the array
+                             *    storing the number of loop items treated by
+                             *    each thread (same positions as \ref pbusy). */
+
+    FILE* report;            /*!< File in which the records are written. */
+} Profiler;
+
+/**
+* \var globalProfiler
+* \brief Global variable storing the profiler of the run; it is global in order
+*        to be reached by all the profiled functions and to be flushed by
+*        \ref endTimerAtExit when the program stops.
+*/
+extern Profiler globalProfiler;
+
 /* ************************************************************************** */
 // Prototype of non-static functions (many functions here sould be static but
 // they are defined as non-static in order to unit-test them)
@@ -1697,7 +2263,9 @@ void printTimer(time_t finalTimer, time_t initialTimer);
 * \brief Function called by atexit to print the execution time when the program
 *        will stop.
 *
-* The function \ref endTimerAtExit uses the \ref globalInitialTimer variable in
+* The function \ref endTimerAtExit first waits for the mesh snapshots still
+* queued in the \ref globalSnapshotWriter variable (see \ref
+* stopSnapshotWriter) and then uses the \ref globalInitialTimer variable in
 * order to print properly the total execution time of the MPD program. It has
 * no argument and it returns no argument (void input and output). This function
 * should be static but it is defined as non-static in order to unit-test it.
@@ -1734,11 +2302,244 @@ char* endTimerAtError(void);
 * error encountered when the MPD program anormally stops. It is only called by
 * the signal function (cf. \ref INITIALIZE_MAIN_STRUCTURES code for further
 * details) when one of a standard signal is caught (SIGABRT, SIGFPE, SIGILL,
-* SIGSEGV, SIGTERM, SIGINT). This function returns no argument (void output) and
+* SIGSEGV, SIGTERM, SIGINT). Before exiting, it lets the background thread of
+* the \ref globalSnapshotWriter variable finish to write the queued mesh
+* snapshots for a bounded time (see \ref waitForSnapshotWriterAtSignal).
+* This function returns no argument (void output) and
 * should be static but it is defined as non-static in order to unit-test it.
 */
 void commentAnormalEnd(int typeOfSignal);
 
+/**
+* \fn double getMonotonicTime(void)
+* \brief It returns the time (in seconds) given by the monotonic clock of the
+*        system.
+*
+* \return It returns the time given by the clock_gettime standard (POSIX)
+*         c-function with the CLOCK_MONOTONIC clock, which is not affected by
+*         the changes of the system time and has a (much) better resolution
+*         than the time standard c-function, or zero if the clock cannot be
+*         read. Only the differences between two values are meaningful.
+*
+* It has no argument (void input).
+*/
+double getMonotonicTime(void);
+
+/**
+* \fn char* getNameOfPhase(int phase)
+* \brief It returns the name used in the reports of the profiler for the phase.
+*
+* \param[in] phase It is expected to be one of the \ref PROF_SETUP ...
+*                  \ref PROF_IO preprocessor constants.
+*
+* \return It returns the (constant) name of the phase, or "unknown" if the
+*         phase variable does not refer to a phase of the profiler.
+*/
+char* getNameOfPhase(int phase);
+
+/**
+* \fn int startProfiler(Profiler* pProfiler, Parameters* pParameters)
+* \brief It initializes the profiler and creates its report if the run is
+*        profiled.
+*
+* \param[out] pProfiler A pointer that points to the Profiler structure
+*                       (defined in main.h) to initialize (usually the
+*                       \ref globalProfiler variable).
+*
+* \param[in] pParameters A pointer that points to the Parameters structure
+*                        (defined in main.h) of the \ref main function. Its
+*                        save_prof variable selects the format of the report
+*                        (zero if the run is not profiled), its name_info
+*                        variable gives the name of the report, and its n_cpu
+*                        variable the number of threads of the parallelized
+*                        loops.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered.
+*
+* If save_prof is zero, the profiler stays inactive and all the other profiling
+* functions return immediately. Otherwise, the *.prof.json (save_prof=1) or
+* *.prof.csv (save_prof=2) file is created (its name is the one of the *.info
+* file with the .info extension replaced) and the calling thread becomes the
+* owner of the profiler: only the phases opened and closed by this thread are
+* timed (the background writer of the mesh snapshots is thus not profiled).
+*/
+int startProfiler(Profiler* pProfiler, Parameters* pParameters);
+
+/**
+* \fn void beginProfilerPhase(Profiler* pProfiler, int phase)
+* \brief It opens a new (nested) phase in the profiler.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \param[in] phase One of the \ref PROF_SETUP ... \ref PROF_IO preprocessor
+*                  constants.
+*
+* Nothing is done if the profiler is inactive, if the calling thread is not
+* its owner, or if \ref PROF_DEPTH phases are already opened. This function
+* does not return any value (void output).
+*/
+void beginProfilerPhase(Profiler* pProfiler, int phase);
+
+/**
+* \fn void endProfilerPhase(Profiler* pProfiler, int phase)
+* \brief It closes the last opened occurrence of the phase in the profiler.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \param[in] phase One of the \ref PROF_SETUP ... \ref PROF_IO preprocessor
+*                  constants.
+*
+* The duration of the phase is added to the counters of the current record:
+* its inclusive time (only if the phase is not nested in itself) and its self
+* time (without the time spent in its nested phases). The phases opened after
+* it and still opened (e.g. because a function returned early on an error) are
+* closed first, so that the profiler stays consistent. Nothing is done if the
+* profiler is inactive, if the calling thread is not its owner, or if the phase
+* is not opened. This function does not return any value (void output).
+*/
+void endProfilerPhase(Profiler* pProfiler, int phase);
+
+/**
+* \fn void addProfilerBytes(Profiler* pProfiler, double bytesRead,
+*                                                           double bytesWritten)
+* \brief It adds a number of bytes read and written to the last opened phase of
+*        the profiler (or to the \ref PROF_IO phase if none is opened).
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \param[in] bytesRead Number of bytes read.
+*
+* \param[in] bytesWritten Number of bytes written.
+*
+* Nothing is done if the profiler is inactive or if the calling thread is not
+* its owner. This function does not return any value (void output).
+*/
+void addProfilerBytes(Profiler* pProfiler, double bytesRead,
+                                                           double bytesWritten);
+
+/**
+* \fn double beginProfilerThread(Profiler* pProfiler)
+* \brief It is called by each thread at the beginning of its share of a
+*        parallelized loop.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \return It returns the current monotonic time if the profiler is active,
+*         otherwise zero is returned.
+*/
+double beginProfilerThread(Profiler* pProfiler);
+
+/**
+* \fn void endProfilerThread(Profiler* pProfiler, int phase, double timer,
+*                                                                   double work)
+* \brief It is called by each thread at the end of its share of a parallelized
+*        loop to update its own counters.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \param[in] phase One of the \ref PROF_SETUP ... \ref PROF_IO preprocessor
+*                  constants (the phase of the parallelized loop).
+*
+* \param[in] timer The value returned by \ref beginProfilerThread at the
+*                  beginning of the share of the thread.
+*
+* \param[in] work The number of loop items treated by the thread.
+*
+* The time elapsed since timer (busy time) and the number of items are added
+* to the counters of the calling thread (given by the omp_get_thread_num
+* function) for the current record. Each thread only modifies its own counters
+* so that no synchronization is needed. This function does not return any
+* value (void output).
+*/
+void endProfilerThread(Profiler* pProfiler, int phase, double timer,
+                                                                   double work);
+
+/**
+* \fn int writeProfilerCounters(Profiler* pProfiler, int run, char* record,
+*                          int iStart, int iteration, double timer, double wall)
+* \brief It writes the counters of the phases used in the current record (or
+*        in the whole run) in the report of the profiler.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \param[in] run Zero for the counters of the current record, one for those of
+*                the whole run.
+*
+* \param[in] record The name of the record ("iteration" or "summary") used as
+*                   first field of the CSV lines.
+*
+* \param[in] iStart The position of the start or geometry of the record (zero
+*                   for a single run).
+*
+* \param[in] iteration The iteration of the record (zero for the setup).
+*
+* \param[in] timer The time elapsed since the start of the profiler.
+*
+* \param[in] wall The time elapsed since the previous record.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered.
+*
+* The counters are written as a JSON object whose keys are the names of the
+* phases (save_prof=1), or as one CSV line per phase (with thread=-1 and the
+* busy time and work summed over the threads) followed, for the phases with
+* parallelized loops, by one line per thread (save_prof=2). Only the phases
+* that have been used are written.
+*/
+int writeProfilerCounters(Profiler* pProfiler, int run, char* record,
+                          int iStart, int iteration, double timer, double wall);
+
+/**
+* \fn int writeProfilerRecord(Profiler* pProfiler, int iStart, int iteration)
+* \brief It writes the record of an iteration in the report of the profiler.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \param[in] iStart The position of the start (multi-start mode) or of the
+*                   geometry (scan mode) of the record, zero for a single run.
+*
+* \param[in] iteration The iteration of the optimization loop that has been
+*                      performed, zero for the setup of the run (or of the
+*                      start).
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered.
+*
+* The record gathers the counters of the phases closed since the previous
+* record, together with the wall time elapsed since then. These counters are
+* then added to the ones of the whole run and reset. Nothing is done if the
+* profiler is inactive.
+*/
+int writeProfilerRecord(Profiler* pProfiler, int iStart, int iteration);
+
+/**
+* \fn int stopProfiler(Profiler* pProfiler)
+* \brief It writes the summary of the run and closes the report of the
+*        profiler.
+*
+* \param[in] pProfiler A pointer that points to the Profiler structure
+*                      (defined in main.h) of the run.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered.
+*
+* The phases still opened are closed, the counters not yet recorded are added
+* to the ones of the whole run, and the summary is written at the end of the
+* report and printed in the standard output stream. The report is closed and
+* the memory of the profiler is freed, so that it becomes inactive and the
+* function can safely be called several times (it is also called by \ref
+* endTimerAtExit).
+*/
+int stopProfiler(Profiler* pProfiler);
+
 /**
 * \fn int checkStringFromLength(char* stringToCheck, int minimumLength,
 *                                                             int maximumLength)
@@ -2437,6 +3238,196 @@ int initialFileExists(char* fileLocation, int nameLength);
 */
 void closeTheFile(FILE** pFileToClose);
 
+/**
+* \fn int openMappedFile(char* fileLocation, int nameLength,
+*                                                      MappedFile* pMappedFile)
+* \brief It maps into memory the content of the existing file located at
+*        fileLocation (a path name of length (strictly) less than nameLength)
+*        and stores it in the structure pointed by pMappedFile.
+*
+* \param[in] fileLocation It is expected to point to the path name of an
+*                         existing file. Otherwise, an error is returned by the
+*                         \ref openMappedFile function.
+*
+* \param[in] nameLength The maximal length allowed for the string pointed by
+*                       fileLocation (including the terminating nul character
+*                       '\0'). It must be an integer (strictly) greater than
+*                       one.
+*
+* \param[out] pMappedFile A pointer to the MappedFile structure (defined in
+*                         main.h) that will store the content of the file with
+*                         its reading cursor set at the beginning of the file.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered.
+*
+* The function \ref openMappedFile uses the open, fstat, and mmap standard
+* (POSIX) c-functions so that the operating system directly pages the file into
+* memory: no copy of the file is created and the data can then be parsed in one
+* pass with the getCharInMappedFile, getStringInMappedFile,
+* scanIntegerInMappedFile, and scanDoubleInMappedFile functions, which mimic
+* respectively the behaviour of the fgetc, fgets, and fscanf(" %d ") /
+* fscanf(" %lf ") standard c-functions.
+*/
+int openMappedFile(char* fileLocation, int nameLength, MappedFile* pMappedFile);
+
+/**
+* \fn int closeMappedFile(MappedFile* pMappedFile)
+* \brief It unmaps the content of the file stored in the structure pointed by
+*        pMappedFile and resets it to zero.
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) that has been filled by the \ref
+*                        openMappedFile function (or reset to zero).
+*
+* \return It returns zero on success, otherwise EOF is returned, in order to
+*         behave as the fclose standard c-function.
+*/
+int closeMappedFile(MappedFile* pMappedFile);
+
+/**
+* \fn int getCharInMappedFile(MappedFile* pMappedFile)
+* \brief It reads the character at the cursor of the structure pointed by
+*        pMappedFile and moves the cursor forward.
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \return It returns the character read as an unsigned char cast to an int or
+*         EOF if the end of file has been reached (fgetc behaviour).
+*/
+int getCharInMappedFile(MappedFile* pMappedFile);
+
+/**
+* \fn int ungetCharInMappedFile(MappedFile* pMappedFile)
+* \brief It moves the cursor of the structure pointed by pMappedFile one
+*        character backward.
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \return It returns zero on success, otherwise a non-zero value if the cursor
+*         is already at the beginning of the file (fseek(-1,SEEK_CUR)
+*         behaviour).
+*/
+int ungetCharInMappedFile(MappedFile* pMappedFile);
+
+/**
+* \fn char* getStringInMappedFile(char* stringToFill, int sizeMax,
+*                                                     MappedFile* pMappedFile)
+* \brief It reads at most (sizeMax-1) characters from the cursor of the
+*        structure pointed by pMappedFile and stores them in stringToFill,
+*        stopping after a newline character (fgets behaviour).
+*
+* \param[out] stringToFill A pointer to an array of (at least) sizeMax char.
+*
+* \param[in] sizeMax The size of the array pointed by stringToFill: it must be
+*                    a positive integer.
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \return It returns stringToFill on success, otherwise NULL if the end of file
+*         has been reached before any character has been read.
+*/
+char* getStringInMappedFile(char* stringToFill, int sizeMax,
+                                                      MappedFile* pMappedFile);
+
+/**
+* \fn int skipSpacesInMappedFile(MappedFile* pMappedFile)
+* \brief It moves the cursor of the structure pointed by pMappedFile after all
+*        the consecutive white space characters (fscanf(" ") behaviour).
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \return It returns zero (no item is assigned).
+*/
+int skipSpacesInMappedFile(MappedFile* pMappedFile);
+
+/**
+* \fn int scanCharacterInMappedFile(MappedFile* pMappedFile, char charToRead)
+* \brief It skips the white space characters and then reads the charToRead
+*        character at the cursor of the structure pointed by pMappedFile.
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \param[in] charToRead The character that is expected to be read.
+*
+* \return It returns one if the charToRead character has been read, zero if
+*         another character was found (the cursor is then left on it), and EOF
+*         if the end of file has been reached.
+*/
+int scanCharacterInMappedFile(MappedFile* pMappedFile, char charToRead);
+
+/**
+* \fn int scanIntegerInMappedFile(MappedFile* pMappedFile, int* pInteger)
+* \brief It reads an integer at the cursor of the structure pointed by
+*        pMappedFile, together with the white space characters that surround
+*        it (fscanf(" %d ") behaviour).
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \param[out] pInteger A pointer to the int variable that will store the value.
+*
+* \return It returns one on success, zero if no integer can be read at the
+*         cursor, and EOF if the end of file has been reached.
+*/
+int scanIntegerInMappedFile(MappedFile* pMappedFile, int* pInteger);
+
+/**
+* \fn int scanDoubleInMappedFile(MappedFile* pMappedFile, double* pDouble)
+* \brief It reads a real number at the cursor of the structure pointed by
+*        pMappedFile, together with the white space characters that surround
+*        it (fscanf(" %lf ") behaviour), the Fortran exponent ('D' or 'd') being
+*        accepted as well as the C one ('E' or 'e').
+*
+* \param[in] pMappedFile A pointer to the MappedFile structure (defined in
+*                        main.h) storing the file content.
+*
+* \param[out] pDouble A pointer to the double variable that will store the
+*                     value.
+*
+* \return It returns one on success, zero if no real number can be read at the
+*         cursor, and EOF if the end of file has been reached.
+*
+* The function \ref scanDoubleInMappedFile accumulates the (at most nineteen)
+* significant digits in an integer and scales it by an exact power of ten when
+* this is possible (the result is then correctly rounded), otherwise it falls
+* back on the strtod standard c-function applied to a local copy of the number.
+*/
+int scanDoubleInMappedFile(MappedFile* pMappedFile, double* pDouble);
+
+/**
+* \fn int computeHashOfFile(char* fileLocation, int nameLength,
+*                                                unsigned long long* pHashValue)
+* \brief It computes the 64-bit FNV-1a hash of the content of the file located
+*        at fileLocation, a path name of (positive) length (strictly) less than
+*        nameLength.
+*
+* \param[in] fileLocation A pointer that points to a string that is intended to
+*                         store the path name of an existing file.
+*
+* \param[in] nameLength A positive integer representing the maximal length
+*                       allowed for the name pointed by the fileLocation
+*                       variable (including the terminating nul character '\0').
+*
+* \param[out] pHashValue A pointer to the unsigned long long variable that will
+*                        store the hash of the file content.
+*
+* \return It returns one if the hash has been successfully computed. Otherwise,
+*         an error is displayed in the standard error stream and zero is
+*         returned by the \ref computeHashOfFile function.
+*
+* The file is read through the \ref openMappedFile function. The hash is only
+* intended to detect if a file has changed (e.g. for the binary chemical cache
+* of the \ref loadChemistry function), not for any cryptographic purpose.
+*/
+int computeHashOfFile(char* fileLocation, int nameLength,
+                                                unsigned long long* pHashValue);
+
 /**
 * \fn int copyFileLocation(char* fileLocation, int nameLength,
 *                                                     char* fileLocationForCopy)
@@ -2515,6 +3506,30 @@ int copyFileLocation(char* fileLocation, int nameLength,
 int renameFileLocation(char* fileLocation, int nameLength,
                                                          char* newFileLocation);
 
+/**
+* \fn int runExternalCommand(char* commandLine, int phase, char* nameMesh)
+* \brief It executes a command line calling an external software inside a
+*        phase of the profiler.
+*
+* \param[in] commandLine The command line to execute with the standard system
+*                        c-function.
+*
+* \param[in] phase One of the \ref PROF_MMG3D ... \ref PROF_ADVECT preprocessor
+*                  constants.
+*
+* \param[in] nameMesh The name of the *.mesh file used by the command.
+*
+* \return It returns the value returned by the system c-function (zero on
+*         success).
+*
+* When the \ref globalProfiler variable is active, the wall time of the command
+* is counted in the phase, and the sizes of the *.mesh file located at nameMesh
+* and of its associated *.sol file are counted as read bytes if they exist
+* before the call, and as written bytes if they have been created or modified
+* by the command.
+*/
+int runExternalCommand(char* commandLine, int phase, char* nameMesh);
+
 /**
 * \fn int plotMeshWithMeditSoftware(Parameters* pParameters)
 * \brief It tries to execute medit software, whose path name is stored in the
@@ -2730,6 +3745,125 @@ int extendShapeGradientWithElasticSoftware(Parameters* pParameters);
 */
 int advectLevelSetWithAdvectSoftware(Parameters* pParameters);
 
+/**
+* \fn void freeJobMemory(Job* pJob, int nJob)
+* \brief It frees the memory dynamically allocated for the array of Job
+*        structures used in batch mode (including the array itself).
+*
+* \param[in] pJob A pointer that points to the array of Job structures (defined
+*                 in main.h file) of the \ref runBatchOfJobs function.
+*
+* \param[in] nJob The size of the array pointed by pJob.
+*
+* This function does not return any value (void output).
+*/
+void freeJobMemory(Job* pJob, int nJob);
+
+/**
+* \fn int readManifestOfJobs(char* fileLocation, Job** ppJob,
+*                                                       int* pNumberOfJobs)
+* \brief It reads the manifest file of the batch mode and allocates the array
+*        of Job structures accordingly.
+*
+* \param[in] fileLocation A pointer that points to the name of the manifest
+*                         file. Each of its lines gives the path name of one
+*                         *.info file (empty lines and lines starting with '#'
+*                         are skipped), the directory of the *.info file being
+*                         the one where the job is run.
+*
+* \param[out] ppJob A pointer to the Job* variable that is allocated and filled
+*                   with the jobs of the manifest file (the chemistry, group,
+*                   and ncpu variables are set by the \ref prepareJobsOfBatch
+*                   function).
+*
+* \param[out] pNumberOfJobs A pointer to the integer storing the number of jobs
+*                           read.
+*
+* \return It returns one if at least one job has been successfully read.
+*         Otherwise, zero is returned if an error is encountered (e.g. if a
+*         line does not end with the '.info' extension).
+*/
+int readManifestOfJobs(char* fileLocation, Job** ppJob, int* pNumberOfJobs);
+
+/**
+* \fn int prepareJobsOfBatch(Job* pJob, int nJob, int nCore)
+* \brief It loads the parameters of each job of the batch mode, groups the jobs
+*        sharing the same chemical file, and loads once the chemistry of each
+*        group in order to build its binary cache (*.chemb) before the jobs are
+*        launched.
+*
+* Unless the \ref CHEM_CACHE_DIRECTORY environment variable is already set, it
+* is set to the initial (current) directory so that all the jobs of a group,
+* which are run in their own directory, read the same binary cache.
+*
+* \param[in,out] pJob A pointer that points to the array of Job structures
+*                     (defined in main.h file) read by the \ref
+*                     readManifestOfJobs function. Its ncpu, chemistry, and
+*                     group variables are set, and the jobs are (stably)
+*                     sorted by group so that the jobs sharing the same
+*                     chemistry are launched one after the other.
+*
+* \param[in] nJob The size of the array pointed by pJob (positive integer).
+*
+* \param[in] nCore The (positive) number of cores of the pool; the number of
+*                  threads of each job is bounded by nCore.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered (e.g. if the *.info file of a job is not valid, in which
+*         case no job is launched).
+*/
+int prepareJobsOfBatch(Job* pJob, int nJob, int nCore);
+
+/**
+* \fn int launchJobOfBatch(Job* pJob, char* programLocation)
+* \brief It runs a job of the batch mode in a child process.
+*
+* \param[in,out] pJob A pointer that points to the Job structure (defined in
+*                     main.h file) to launch. Its pid, start, and status
+*                     variables are updated.
+*
+* \param[in] programLocation A pointer to the path name of the MPD program.
+*
+* \return It returns one if the child process has been successfully created.
+*         Otherwise, zero is returned if an error is encountered.
+*
+* The child process enters the directory of the job, redirects its standard
+* output and error streams into a *.log file (the *.info file name where the
+* '.info' extension is replaced by the '.log' one), and executes the MPD program
+* on the *.info file of the job, so that each job writes its outputs in its own
+* directory exactly as a single MPD run would do.
+*/
+int launchJobOfBatch(Job* pJob, char* programLocation);
+
+/**
+* \fn int runBatchOfJobs(char* programName, char* manifestLocation, int nCore)
+* \brief It runs all the jobs listed in the manifest file of the batch mode on
+*        a pool of cores.
+*
+* \param[in] programName A pointer to the name of the MPD program (argv[0]).
+*
+* \param[in] manifestLocation A pointer to the name of the manifest file (see
+*                             \ref readManifestOfJobs).
+*
+* \param[in] nCore The number of cores of the pool; if it is not positive, the
+*                  number of online processors of the machine is used.
+*
+* \return It returns one if all the jobs have ended successfully. Otherwise,
+*         zero is returned (the failed jobs are listed in the standard output).
+*
+* The jobs are launched in the order given by the \ref prepareJobsOfBatch
+* function as soon as the sum of the threads (n_cpu) of the running jobs plus
+* the threads of the next job does not exceed nCore (at least one job is always
+* running). Hence, the cores freed by a job are immediately taken by the next
+* jobs and the machine is never oversubscribed. The jobs run in separated
+* processes rather than in a pool of threads because an MPD run relies on
+* global variables (timers, snapshot writer) and on relative file names. Each
+* process then reads its chemistry back from the binary cache built by the
+* \ref prepareJobsOfBatch function (see \ref readChemicalFileOrCache) and
+* keeps its own copy of it in memory.
+*/
+int runBatchOfJobs(char* programName, char* manifestLocation, int nCore);
+
 /**
 * \fn int main(int argc, char *argv[])
 * \brief Main function of the MPD program.
@@ -2738,7 +3872,9 @@ int advectLevelSetWithAdvectSoftware(Parameters* pParameters);
 *                 for executing the MPD program. Here, we must have argc=2, i.e.
 *                 the command line must specify only one input argument: the
 *                 *.info file used to load the parameters into the Parameters
-*                 structure. Otherwise, (zero or more than one argument) an
+*                 structure, or argc=3 (resp. argc=4) in batch mode, i.e. the
+*                 '-batch' option followed by the manifest file (resp. and the
+*                 number of cores, see \ref runBatchOfJobs). Otherwise, an
 *                 error is returned by the MPD program.
 *
 * \param[in] argv An array of pointers (of type char*) that points to the
@@ -12,6 +12,7 @@
 */
 
 #include "loadParameters.h"
+#include "loadChemistry.h"
 #include "loadMesh.h"
 #include "adaptMesh.h"
 #include "optimization.h"
@@ -38,6 +39,7 @@ void initializeDataStructure(Data* pData)
         pData->tim=NULL;
         pData->ctim=NULL;
 
+        pData->nring=0;
         pData->nprob=0;
         pData->pprob=NULL;
 
@@ -60,11 +62,11 @@ void freeDataMemory(Data* pData)
 
     if (pData!=NULL)
     {
-        iMax=pData->ndata;
+        iMax=pData->nring;
         if (iMax<1 && (pData->pprob!=NULL || pData->pmat!=NULL))
         {
              fprintf(stdout,"\nWarning in freeDataMemory function: ");
-             fprintf(stdout,"%d iterations are saved in pData (input) ",iMax);
+             fprintf(stdout,"%d iterations are kept in pData (input) ",iMax);
              fprintf(stdout,"variable. Some allocated pointers may not be ");
              fprintf(stdout,"freed up correctly.\n");
         }
@@ -228,6 +230,9 @@ int allocateMemoryForData(Parameters* pParameters, Data* pData,
         return 0;
     }
 
+    // Only the last DATA_RING_SIZE probabilities and overlap matrices are kept
+    pData->nring=DATA_RING_SIZE;
+    length=pData->nring;
     pData->pprob=(Probabilities*)calloc(length,sizeof(Probabilities));
     if (pData->pprob==NULL)
     {
@@ -246,7 +251,7 @@ int allocateMemoryForData(Parameters* pParameters, Data* pData,
 
     pData->nprob=pChemicalSystem->nmorb+1;
     length=pData->nprob;
-    iMax=pData->ndata;
+    iMax=pData->nring;
     for (i=0; i<iMax; i++)
     {
         pProbabilities=&pData->pprob[i];
@@ -841,7 +846,7 @@ double computeVolumeTetrahedron(Point* pp1, Point* pp2, Point* pp3, Point* pp4)
 // corresponds to the tetrahedra of pMesh that are not labelled by labelToAvoid
 // and the coefficients of the overlap matrix are stored in the coef array
 // variable of the OverlapMatrix structure located at
-// pData->pmat[iterationInTheLoop]. It has the Parameters*, Mesh*, Data*,
+// pData->pmat[iterationInTheLoop%nring]. It has the Parameters*, Mesh*, Data*,
 // ChemicalSystem* variables (both defined in main.h), and the two integers
 // labelToAvoid and iterationInTheLoop as input arguments. It returns one if
 // the coefficients of the overlap matrix have been successfully computed,
@@ -854,11 +859,14 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
     int i=0, j=0, k=0, ip1=0, ip2=0, ip3=0, ip4=0, nTet=0, nMorb=0, nGauss=0;
     int *pOmega=NULL, kMax=0;
     double integral=0., integralK=0., volumeTetrahedron=0., value=0., px=0.;
-    double py=0., pz=0.;
+    double py=0., pz=0., timer=0., work=0.;
     MolecularOrbital *pMolecularOrbitalI=NULL, *pMolecularOrbitalJ=NULL;
     Point  *pp1=NULL, *pp2=NULL, *pp3=NULL, *pp4=NULL;
     OverlapMatrix *pOverlapMatrix=NULL;
 
+    // Time the computation of the overlap matrix in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_OVERLAP);
+
     // Check input pointers
     if (pParameters==NULL || pMesh==NULL || pData==NULL ||
                                                           pChemicalSystem==NULL)
@@ -868,6 +876,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
         fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
         fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -877,6 +886,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("computeOverlapMatrix: the input labelToAvoid variable ");
         fprintf(stderr,"(=%d) can only be set to minus one, ",labelToAvoid);
         fprintf(stderr,"two or three.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -888,6 +898,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"the maximal number of allowed iterations ");
         fprintf(stderr,"(=%d) in the optimization ",pParameters->iter_max);
         fprintf(stderr,"loop.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -899,6 +910,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"(=%d) is positive i.e. the ",pParameters->opt_mode);
         fprintf(stderr," structure pointed by pMesh is made of tetrahedra ");
         fprintf(stderr,"(pMesh->ptet=%p).\n",(void*)pMesh->ptet);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -926,9 +938,10 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the pmat variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pmat);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
     // Check the coef pointer variable of pOverlapMatrix
     if (pOverlapMatrix->coef==NULL)
@@ -937,6 +950,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"%d-th OverlapMatrix structure ",iterationInTheLoop+1);
         fprintf(stderr,"is pointing to the %p ",(void*)pOverlapMatrix->coef);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -946,6 +960,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the total number of vertices ");
         fprintf(stderr,"(=%d) in the mesh should be a positive ",pMesh->nver);
         fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -954,6 +969,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the pver variable of the ");
         fprintf(stderr,"structure pointed by pMesh is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pMesh->pver);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -963,6 +979,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the total number of tetrahedra ");
         fprintf(stderr,"(=%d) in the mesh should be a positive ",nTet);
         fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -971,6 +988,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
     {
         PRINT_ERROR("In computeOverlapMatrix: the total number of molecular ");
         fprintf(stderr,"orbitals (=%d) should be a positive integer.\n",nMorb);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -979,6 +997,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the pmorb variable of the ");
         fprintf(stderr,"structure pointed by pChemicalSystem is pointing to ");
         fprintf(stderr,"the %p address.\n",(void*)pChemicalSystem->pmorb);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -988,6 +1007,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the total number of ");
         fprintf(stderr,"Gaussian-type primitives (=%d) should be a ",nGauss);
         fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -996,6 +1016,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeOverlapMatrix: the size of the overlap matrix ");
         fprintf(stderr,"should be (%d)x(%d) instead of ",nMorb,nMorb);
         fprintf(stderr,"(%d)x(%d).\n",pData->nmat,pData->nmat);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1008,6 +1029,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
             fprintf(stderr,"(pParameters->orb_rhf=%d) ",pParameters->orb_rhf);
             fprintf(stderr,"the total number of molecular orbitals ");
             fprintf(stderr," (=%d) should be an even number.\n",nMorb);
+            endProfilerPhase(&globalProfiler,PROF_OVERLAP);
             return 0;
         }
     }
@@ -1028,6 +1050,7 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
     {
         PRINT_ERROR("In computeOverlapMatrix: we could not allocate memory ");
         fprintf(stderr,"for the local (int*) variable pOmega.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1075,7 +1098,174 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
             }
 
             integralK=0.;
-#pragma omp parallel for default(shared) private(integral,volumeTetrahedron,value,ip1,ip2,ip3,ip4,pp1,pp2,pp3,pp4,px,py,pz) reduction(+:integralK)
+#pragma omp parallel default(shared) private(integral,volumeTetrahedron,value,ip1,ip2,ip3,ip4,pp1,pp2,pp3,pp4,px,py,pz,timer,work)
+            {
+                // Add the time spent by the thread on its share of the loop to
+                // its busy time (one call per thread, not per item)
+                timer=beginProfilerThread(&globalProfiler);
+                work=0.;
+#pragma omp for nowait reduction(+:integralK)
+                for (k=0; k<kMax; k++)
+                {
+                    // Get the vertex adresses of the k-th tetrahedron with a
+                    // label different from the labelToAvoid variable (faster
+                    // with OpenMP)
+                    ip1=pMesh->ptet[pOmega[k]].p1;
+                    ip2=pMesh->ptet[pOmega[k]].p2;
+                    ip3=pMesh->ptet[pOmega[k]].p3;
+                    ip4=pMesh->ptet[pOmega[k]].p4;
+
+                    // Warning here: we have stored point reference as given in
+                    // the *.mesh file so do not forget to remove one from these
+                    // integers when calling the pMesh->pver variables
+                    pp1=&pMesh->pver[ip1-1];
+                    pp2=&pMesh->pver[ip2-1];
+                    pp3=&pMesh->pver[ip3-1];
+                    pp4=&pMesh->pver[ip4-1];
+
+                    // 1st to 6th point estimation
+                    px=CST_a*((pp1->x)+(pp2->x))+CST_aa*((pp3->x)+(pp4->x));
+                    py=CST_a*((pp1->y)+(pp2->y))+CST_aa*((pp3->y)+(pp4->y));
+                    pz=CST_a*((pp1->z)+(pp2->z))+CST_aa*((pp3->z)+(pp4->z));
+                    value=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                         pMolecularOrbitalI,pMolecularOrbitalJ);
+
+                    px=CST_a*((pp1->x)+(pp3->x))+CST_aa*((pp2->x)+(pp4->x));
+                    py=CST_a*((pp1->y)+(pp3->y))+CST_aa*((pp2->y)+(pp4->y));
+                    pz=CST_a*((pp1->z)+(pp3->z))+CST_aa*((pp2->z)+(pp4->z));
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_a*((pp1->x)+(pp4->x))+CST_aa*((pp2->x)+(pp3->x));
+                    py=CST_a*((pp1->y)+(pp4->y))+CST_aa*((pp2->y)+(pp3->y));
+                    pz=CST_a*((pp1->z)+(pp4->z))+CST_aa*((pp2->z)+(pp3->z));
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_a*((pp2->x)+(pp3->x))+CST_aa*((pp1->x)+(pp4->x));
+                    py=CST_a*((pp2->y)+(pp3->y))+CST_aa*((pp1->y)+(pp4->y));
+                    pz=CST_a*((pp2->z)+(pp3->z))+CST_aa*((pp1->z)+(pp4->z));
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_a*((pp2->x)+(pp4->x))+CST_aa*((pp1->x)+(pp3->x));
+                    py=CST_a*((pp2->y)+(pp4->y))+CST_aa*((pp1->y)+(pp3->y));
+                    pz=CST_a*((pp2->z)+(pp4->z))+CST_aa*((pp1->z)+(pp3->z));
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_a*((pp3->x)+(pp4->x))+CST_aa*((pp1->x)+(pp2->x));
+                    py=CST_a*((pp3->y)+(pp4->y))+CST_aa*((pp1->y)+(pp2->y));
+                    pz=CST_a*((pp3->z)+(pp4->z))+CST_aa*((pp1->z)+(pp2->z));
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    value*=CST_A;
+                    integral=value;
+
+                    // 7th to 10th point estimation
+                    px=CST_b*((pp1->x)+(pp2->x)+(pp3->x))+CST_bb*(pp4->x);
+                    py=CST_b*((pp1->y)+(pp2->y)+(pp3->y))+CST_bb*(pp4->y);
+                    pz=CST_b*((pp1->z)+(pp2->z)+(pp3->z))+CST_bb*(pp4->z);
+                    value=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                         pMolecularOrbitalI,pMolecularOrbitalJ);
+
+                    px=CST_b*((pp1->x)+(pp2->x)+(pp4->x))+CST_bb*(pp3->x);
+                    py=CST_b*((pp1->y)+(pp2->y)+(pp4->y))+CST_bb*(pp3->y);
+                    pz=CST_b*((pp1->z)+(pp2->z)+(pp4->z))+CST_bb*(pp3->z);
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_b*((pp1->x)+(pp3->x)+(pp4->x))+CST_bb*(pp2->x);
+                    py=CST_b*((pp1->y)+(pp3->y)+(pp4->y))+CST_bb*(pp2->y);
+                    pz=CST_b*((pp1->z)+(pp3->z)+(pp4->z))+CST_bb*(pp2->z);
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_b*((pp2->x)+(pp3->x)+(pp4->x))+CST_bb*(pp1->x);
+                    py=CST_b*((pp2->y)+(pp3->y)+(pp4->y))+CST_bb*(pp1->y);
+                    pz=CST_b*((pp2->z)+(pp3->z)+(pp4->z))+CST_bb*(pp1->z);
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    value*=CST_B;
+                    integral+=value;
+
+                    // 10th to 14th point estimation
+                    px=CST_c*((pp1->x)+(pp2->x)+(pp3->x))+CST_cc*(pp4->x);
+                    py=CST_c*((pp1->y)+(pp2->y)+(pp3->y))+CST_cc*(pp4->y);
+                    pz=CST_c*((pp1->z)+(pp2->z)+(pp3->z))+CST_cc*(pp4->z);
+                    value=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                         pMolecularOrbitalI,pMolecularOrbitalJ);
+
+                    px=CST_c*((pp1->x)+(pp2->x)+(pp4->x))+CST_cc*(pp3->x);
+                    py=CST_c*((pp1->y)+(pp2->y)+(pp4->y))+CST_cc*(pp3->y);
+                    pz=CST_c*((pp1->z)+(pp2->z)+(pp4->z))+CST_cc*(pp3->z);
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_c*((pp1->x)+(pp3->x)+(pp4->x))+CST_cc*(pp2->x);
+                    py=CST_c*((pp1->y)+(pp3->y)+(pp4->y))+CST_cc*(pp2->y);
+                    pz=CST_c*((pp1->z)+(pp3->z)+(pp4->z))+CST_cc*(pp2->z);
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    px=CST_c*((pp2->x)+(pp3->x)+(pp4->x))+CST_cc*(pp1->x);
+                    py=CST_c*((pp2->y)+(pp3->y)+(pp4->y))+CST_cc*(pp1->y);
+                    pz=CST_c*((pp2->z)+(pp3->z)+(pp4->z))+CST_cc*(pp1->z);
+                    value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
+                                              pMolecularOrbitalI,
+                                                            pMolecularOrbitalJ);
+
+                    value*=CST_C;
+                    integral+=value;
+
+                    // Multiply by (six times) the volume of the tetrahedron
+                    volumeTetrahedron=computeVolumeTetrahedron(pp1,pp2,pp3,pp4);
+                    integral*=volumeTetrahedron;
+                    integralK=integralK+integral;
+                    work+=1.;
+                }
+                endProfilerThread(&globalProfiler,PROF_OVERLAP,timer,work);
+            }
+
+            // End of the parallelization for the loop for
+            pOverlapMatrix->coef[i*nMorb+j]=integralK;
+            if (pParameters->opt_mode!=1 || pParameters->verbose ||
+                                                            !iterationInTheLoop)
+            {
+                if (pParameters->orb_rhf || pParameters->verbose)
+                {
+                    fprintf(stdout,"%d %% done.\n",
+                               (int)(100.*(i*.5*nMorb+j+1.)/(.25*nMorb*nMorb)));
+                }
+                else
+                {
+                    fprintf(stdout,"%d %% done.\n",
+                                      (int)(100.*(i*nMorb+j+1.)/(nMorb*nMorb)));
+                }
+            }
+        }
+
+        // Treat the particular case i=j
+        integralK=0.;
+#pragma omp parallel default(shared) private(integral,volumeTetrahedron,value,ip1,ip2,ip3,ip4,pp1,pp2,pp3,pp4,px,py,pz,timer,work)
+        {
+            // Add the time spent by the thread on its share of the loop to
+            // its busy time (one call per thread, not per item)
+            timer=beginProfilerThread(&globalProfiler);
+            work=0.;
+#pragma omp for nowait reduction(+:integralK)
             for (k=0; k<kMax; k++)
             {
                 // Get the vertex adresses of the k-th tetrahedron with a label
@@ -1085,9 +1275,9 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 ip3=pMesh->ptet[pOmega[k]].p3;
                 ip4=pMesh->ptet[pOmega[k]].p4;
 
-                // Warning here: we have stored point reference as given
-                // in the *.mesh file so do not forget to remove one from these
-                // integers when calling the pMesh->pver variables
+                // Warning here: we have stored point reference as given in the
+                // *.mesh file so do not forget to remove one from these
+                // integers when calling the pMesh->pver variable
                 pp1=&pMesh->pver[ip1-1];
                 pp2=&pMesh->pver[ip2-1];
                 pp3=&pMesh->pver[ip3-1];
@@ -1097,43 +1287,38 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 px=CST_a*((pp1->x)+(pp2->x))+CST_aa*((pp3->x)+(pp4->x));
                 py=CST_a*((pp1->y)+(pp2->y))+CST_aa*((pp3->y)+(pp4->y));
                 pz=CST_a*((pp1->z)+(pp2->z))+CST_aa*((pp3->z)+(pp4->z));
-                value=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                         pMolecularOrbitalI,pMolecularOrbitalJ);
+                value=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_a*((pp1->x)+(pp3->x))+CST_aa*((pp2->x)+(pp4->x));
                 py=CST_a*((pp1->y)+(pp3->y))+CST_aa*((pp2->y)+(pp4->y));
                 pz=CST_a*((pp1->z)+(pp3->z))+CST_aa*((pp2->z)+(pp4->z));
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_a*((pp1->x)+(pp4->x))+CST_aa*((pp2->x)+(pp3->x));
                 py=CST_a*((pp1->y)+(pp4->y))+CST_aa*((pp2->y)+(pp3->y));
                 pz=CST_a*((pp1->z)+(pp4->z))+CST_aa*((pp2->z)+(pp3->z));
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_a*((pp2->x)+(pp3->x))+CST_aa*((pp1->x)+(pp4->x));
                 py=CST_a*((pp2->y)+(pp3->y))+CST_aa*((pp1->y)+(pp4->y));
                 pz=CST_a*((pp2->z)+(pp3->z))+CST_aa*((pp1->z)+(pp4->z));
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_a*((pp2->x)+(pp4->x))+CST_aa*((pp1->x)+(pp3->x));
                 py=CST_a*((pp2->y)+(pp4->y))+CST_aa*((pp1->y)+(pp3->y));
                 pz=CST_a*((pp2->z)+(pp4->z))+CST_aa*((pp1->z)+(pp3->z));
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_a*((pp3->x)+(pp4->x))+CST_aa*((pp1->x)+(pp2->x));
                 py=CST_a*((pp3->y)+(pp4->y))+CST_aa*((pp1->y)+(pp2->y));
                 pz=CST_a*((pp3->z)+(pp4->z))+CST_aa*((pp1->z)+(pp2->z));
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 value*=CST_A;
                 integral=value;
@@ -1142,29 +1327,26 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 px=CST_b*((pp1->x)+(pp2->x)+(pp3->x))+CST_bb*(pp4->x);
                 py=CST_b*((pp1->y)+(pp2->y)+(pp3->y))+CST_bb*(pp4->y);
                 pz=CST_b*((pp1->z)+(pp2->z)+(pp3->z))+CST_bb*(pp4->z);
-                value=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                         pMolecularOrbitalI,pMolecularOrbitalJ);
+                value=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_b*((pp1->x)+(pp2->x)+(pp4->x))+CST_bb*(pp3->x);
                 py=CST_b*((pp1->y)+(pp2->y)+(pp4->y))+CST_bb*(pp3->y);
                 pz=CST_b*((pp1->z)+(pp2->z)+(pp4->z))+CST_bb*(pp3->z);
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_b*((pp1->x)+(pp3->x)+(pp4->x))+CST_bb*(pp2->x);
                 py=CST_b*((pp1->y)+(pp3->y)+(pp4->y))+CST_bb*(pp2->y);
                 pz=CST_b*((pp1->z)+(pp3->z)+(pp4->z))+CST_bb*(pp2->z);
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_b*((pp2->x)+(pp3->x)+(pp4->x))+CST_bb*(pp1->x);
                 py=CST_b*((pp2->y)+(pp3->y)+(pp4->y))+CST_bb*(pp1->y);
                 pz=CST_b*((pp2->z)+(pp3->z)+(pp4->z))+CST_bb*(pp1->z);
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 value*=CST_B;
                 integral+=value;
@@ -1173,29 +1355,26 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 px=CST_c*((pp1->x)+(pp2->x)+(pp3->x))+CST_cc*(pp4->x);
                 py=CST_c*((pp1->y)+(pp2->y)+(pp3->y))+CST_cc*(pp4->y);
                 pz=CST_c*((pp1->z)+(pp2->z)+(pp3->z))+CST_cc*(pp4->z);
-                value=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                         pMolecularOrbitalI,pMolecularOrbitalJ);
+                value=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_c*((pp1->x)+(pp2->x)+(pp4->x))+CST_cc*(pp3->x);
                 py=CST_c*((pp1->y)+(pp2->y)+(pp4->y))+CST_cc*(pp3->y);
                 pz=CST_c*((pp1->z)+(pp2->z)+(pp4->z))+CST_cc*(pp3->z);
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_c*((pp1->x)+(pp3->x)+(pp4->x))+CST_cc*(pp2->x);
                 py=CST_c*((pp1->y)+(pp3->y)+(pp4->y))+CST_cc*(pp2->y);
                 pz=CST_c*((pp1->z)+(pp3->z)+(pp4->z))+CST_cc*(pp2->z);
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 px=CST_c*((pp2->x)+(pp3->x)+(pp4->x))+CST_cc*(pp1->x);
                 py=CST_c*((pp2->y)+(pp3->y)+(pp4->y))+CST_cc*(pp1->y);
                 pz=CST_c*((pp2->z)+(pp3->z)+(pp4->z))+CST_cc*(pp1->z);
-                value+=evaluateOrbitalsIJ(px,py,pz,pChemicalSystem,
-                                          pMolecularOrbitalI,
-                                                            pMolecularOrbitalJ);
+                value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
+                                                            pMolecularOrbitalI);
 
                 value*=CST_C;
                 integral+=value;
@@ -1204,146 +1383,9 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 volumeTetrahedron=computeVolumeTetrahedron(pp1,pp2,pp3,pp4);
                 integral*=volumeTetrahedron;
                 integralK=integralK+integral;
+                work+=1.;
             }
-
-            // End of the parallelization for the loop for
-            pOverlapMatrix->coef[i*nMorb+j]=integralK;
-            if (pParameters->opt_mode!=1 || pParameters->verbose ||
-                                                            !iterationInTheLoop)
-            {
-                if (pParameters->orb_rhf || pParameters->verbose)
-                {
-                    fprintf(stdout,"%d %% done.\n",
-                               (int)(100.*(i*.5*nMorb+j+1.)/(.25*nMorb*nMorb)));
-                }
-                else
-                {
-                    fprintf(stdout,"%d %% done.\n",
-                                      (int)(100.*(i*nMorb+j+1.)/(nMorb*nMorb)));
-                }
-            }
-        }
-
-        // Treat the particular case i=j
-        integralK=0.;
-#pragma omp parallel for default(shared) private(integral,volumeTetrahedron,value,ip1,ip2,ip3,ip4,pp1,pp2,pp3,pp4,px,py,pz) reduction(+:integralK)
-        for (k=0; k<kMax; k++)
-        {
-            // Get the vertex adresses of the k-th tetrahedron with a label
-            // different from the labelToAvoid variable (faster with OpenMP)
-            ip1=pMesh->ptet[pOmega[k]].p1;
-            ip2=pMesh->ptet[pOmega[k]].p2;
-            ip3=pMesh->ptet[pOmega[k]].p3;
-            ip4=pMesh->ptet[pOmega[k]].p4;
-
-            // Warning here: we have stored point reference as given in the
-            // *.mesh file so do not forget to remove one from these integers
-            // when calling the pMesh->pver variable
-            pp1=&pMesh->pver[ip1-1];
-            pp2=&pMesh->pver[ip2-1];
-            pp3=&pMesh->pver[ip3-1];
-            pp4=&pMesh->pver[ip4-1];
-
-            // 1st to 6th point estimation
-            px=CST_a*((pp1->x)+(pp2->x))+CST_aa*((pp3->x)+(pp4->x));
-            py=CST_a*((pp1->y)+(pp2->y))+CST_aa*((pp3->y)+(pp4->y));
-            pz=CST_a*((pp1->z)+(pp2->z))+CST_aa*((pp3->z)+(pp4->z));
-            value=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_a*((pp1->x)+(pp3->x))+CST_aa*((pp2->x)+(pp4->x));
-            py=CST_a*((pp1->y)+(pp3->y))+CST_aa*((pp2->y)+(pp4->y));
-            pz=CST_a*((pp1->z)+(pp3->z))+CST_aa*((pp2->z)+(pp4->z));
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_a*((pp1->x)+(pp4->x))+CST_aa*((pp2->x)+(pp3->x));
-            py=CST_a*((pp1->y)+(pp4->y))+CST_aa*((pp2->y)+(pp3->y));
-            pz=CST_a*((pp1->z)+(pp4->z))+CST_aa*((pp2->z)+(pp3->z));
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_a*((pp2->x)+(pp3->x))+CST_aa*((pp1->x)+(pp4->x));
-            py=CST_a*((pp2->y)+(pp3->y))+CST_aa*((pp1->y)+(pp4->y));
-            pz=CST_a*((pp2->z)+(pp3->z))+CST_aa*((pp1->z)+(pp4->z));
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_a*((pp2->x)+(pp4->x))+CST_aa*((pp1->x)+(pp3->x));
-            py=CST_a*((pp2->y)+(pp4->y))+CST_aa*((pp1->y)+(pp3->y));
-            pz=CST_a*((pp2->z)+(pp4->z))+CST_aa*((pp1->z)+(pp3->z));
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_a*((pp3->x)+(pp4->x))+CST_aa*((pp1->x)+(pp2->x));
-            py=CST_a*((pp3->y)+(pp4->y))+CST_aa*((pp1->y)+(pp2->y));
-            pz=CST_a*((pp3->z)+(pp4->z))+CST_aa*((pp1->z)+(pp2->z));
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            value*=CST_A;
-            integral=value;
-
-            // 7th to 10th point estimation
-            px=CST_b*((pp1->x)+(pp2->x)+(pp3->x))+CST_bb*(pp4->x);
-            py=CST_b*((pp1->y)+(pp2->y)+(pp3->y))+CST_bb*(pp4->y);
-            pz=CST_b*((pp1->z)+(pp2->z)+(pp3->z))+CST_bb*(pp4->z);
-            value=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_b*((pp1->x)+(pp2->x)+(pp4->x))+CST_bb*(pp3->x);
-            py=CST_b*((pp1->y)+(pp2->y)+(pp4->y))+CST_bb*(pp3->y);
-            pz=CST_b*((pp1->z)+(pp2->z)+(pp4->z))+CST_bb*(pp3->z);
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_b*((pp1->x)+(pp3->x)+(pp4->x))+CST_bb*(pp2->x);
-            py=CST_b*((pp1->y)+(pp3->y)+(pp4->y))+CST_bb*(pp2->y);
-            pz=CST_b*((pp1->z)+(pp3->z)+(pp4->z))+CST_bb*(pp2->z);
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_b*((pp2->x)+(pp3->x)+(pp4->x))+CST_bb*(pp1->x);
-            py=CST_b*((pp2->y)+(pp3->y)+(pp4->y))+CST_bb*(pp1->y);
-            pz=CST_b*((pp2->z)+(pp3->z)+(pp4->z))+CST_bb*(pp1->z);
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            value*=CST_B;
-            integral+=value;
-
-            // 10th to 14th point estimation
-            px=CST_c*((pp1->x)+(pp2->x)+(pp3->x))+CST_cc*(pp4->x);
-            py=CST_c*((pp1->y)+(pp2->y)+(pp3->y))+CST_cc*(pp4->y);
-            pz=CST_c*((pp1->z)+(pp2->z)+(pp3->z))+CST_cc*(pp4->z);
-            value=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_c*((pp1->x)+(pp2->x)+(pp4->x))+CST_cc*(pp3->x);
-            py=CST_c*((pp1->y)+(pp2->y)+(pp4->y))+CST_cc*(pp3->y);
-            pz=CST_c*((pp1->z)+(pp2->z)+(pp4->z))+CST_cc*(pp3->z);
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_c*((pp1->x)+(pp3->x)+(pp4->x))+CST_cc*(pp2->x);
-            py=CST_c*((pp1->y)+(pp3->y)+(pp4->y))+CST_cc*(pp2->y);
-            pz=CST_c*((pp1->z)+(pp3->z)+(pp4->z))+CST_cc*(pp2->z);
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            px=CST_c*((pp2->x)+(pp3->x)+(pp4->x))+CST_cc*(pp1->x);
-            py=CST_c*((pp2->y)+(pp3->y)+(pp4->y))+CST_cc*(pp1->y);
-            pz=CST_c*((pp2->z)+(pp3->z)+(pp4->z))+CST_cc*(pp1->z);
-            value+=evaluateOrbitalsII(px,py,pz,pChemicalSystem,
-                                                            pMolecularOrbitalI);
-
-            value*=CST_C;
-            integral+=value;
-
-            // Multiply by (six times) the volume of the tetrahedron
-            volumeTetrahedron=computeVolumeTetrahedron(pp1,pp2,pp3,pp4);
-            integral*=volumeTetrahedron;
-            integralK=integralK+integral;
+            endProfilerThread(&globalProfiler,PROF_OVERLAP,timer,work);
         }
 
         // End of the parallelization for the loop for
@@ -1395,6 +1437,8 @@ int computeOverlapMatrix(Parameters* pParameters, Mesh* pMesh, Data* pData,
         }
     }
 
+    endProfilerPhase(&globalProfiler,PROF_OVERLAP);
+
     return 1;
 }
 
@@ -1828,8 +1872,10 @@ double evaluateTripleIntegralIJ(Parameters* pParameters, Mesh *pMesh,
 
     // Warning: we stored Point reference as in *.mesh file so do not forget
     // to remove one from these integers when calling pMesh->pver
-    iNucleus=pMesh->phex[kHexahedron].p1;
-    Point *pPoint=&pMesh->pver[iNucleus-1];
+    int pHexahedronVertex[8];
+    getHexahedronVertices(kHexahedron,pParameters->n_y,pParameters->n_z,
+                                                             pHexahedronVertex);
+    Point *pPoint=&pMesh->pver[pHexahedronVertex[0]-1];
 
     double dxI=(pPoint->x)-(pCenterI->x);
     double dyI=(pPoint->y)-(pCenterI->y);
@@ -1892,7 +1938,7 @@ double evaluateTripleIntegralIJ(Parameters* pParameters, Mesh *pMesh,
 // pParameters->trick_matrix is set to zero, otherwise Omega corresponds to the
 // hexahedra of pMesh labelled labelToConsiderOrAvoid. The coefficients of the
 // overlap matrix are stored in the coef array variable of the OverlapMatrix
-// structure located at pData->pmat[iterationInTheLoop]. It has the
+// structure located at pData->pmat[iterationInTheLoop%nring]. It has the
 // Parameters*, Mesh*, Data*, ChemicalSystem* variables (both defined in
 // main.h), and the two integers labelToConsiderOrAvoid and iterationInTheLoop
 // as input arguments. It returns one if the coefficients of the overlap matrix
@@ -1905,10 +1951,13 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
 {
     int i=0, j=0, k=0, lI=0, lJ=0, nHex=0, nMorb=0, nGauss=0, kMax=0;
     int *pOmega=NULL;
-    double integral=0., integralK=0.;
+    double integral=0., integralK=0., timer=0., work=0.;
     MolecularOrbital *pMolecularOrbitalI=NULL, *pMolecularOrbitalJ=NULL;
     OverlapMatrix *pOverlapMatrix=NULL, *pOverlapMatrixOld=NULL;
 
+    // Time the computation of the overlap matrix in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_OVERLAP);
+
     // Check input pointers
     if (pParameters==NULL || pMesh==NULL || pData==NULL ||
                                                           pChemicalSystem==NULL)
@@ -1918,6 +1967,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
         fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
         fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1929,6 +1979,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"labelToConsiderOrAvoid variable ");
         fprintf(stderr,"(=%d) can only be set to ",labelToConsiderOrAvoid);
         fprintf(stderr,"minus one, (+/-)two or (+/-)three.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1939,6 +1990,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"should be a non-negative integer not (strictly) ");
         fprintf(stderr,"greater than the maximal number of allowed ");
         fprintf(stderr,"iterations (=%d).\n",pParameters->iter_max);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1950,6 +2002,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"(=%d) is not positive i.e. the ",pParameters->opt_mode);
         fprintf(stderr," structure pointed by pMesh is made of hexahedra ");
         fprintf(stderr,"(pMesh->phex=%p).\n",(void*)pMesh->phex);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1962,9 +2015,10 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the pmat variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pmat);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
     // Check the coef pointer variable of pOverlapMatrix
     if (pOverlapMatrix->coef==NULL)
@@ -1973,6 +2027,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         fprintf(stderr,"%d-th OverlapMatrix structure ",iterationInTheLoop+1);
         fprintf(stderr,"is pointing to the %p ",(void*)pOverlapMatrix->coef);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1982,6 +2037,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the total number of ");
         fprintf(stderr,"vertices (=%d) in the mesh should be a ",pMesh->nver);
         fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1990,6 +2046,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the pver variable of the ");
         fprintf(stderr,"structure pointed by pMesh is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pMesh->pver);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -1999,6 +2056,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the total number of ");
         fprintf(stderr,"hexahedra (=%d) in the mesh should be a ",nHex);
         fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -2008,6 +2066,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the total number of ");
         fprintf(stderr,"molecular orbitals (=%d) should be a positive ",nMorb);
         fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -2016,6 +2075,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the pmorb variable of ");
         fprintf(stderr,"the structure pointed by pChemicalSystem is pointing ");
         fprintf(stderr,"to the %p address.\n",(void*)pChemicalSystem->pmorb);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -2025,6 +2085,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the total number of ");
         fprintf(stderr,"Gaussian-type primitives (=%d) should be a ",nGauss);
         fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -2033,6 +2094,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         PRINT_ERROR("In computeOverlapMatrixOnGrid: the size of the ");
         fprintf(stderr,"overlap matrix should be (%d)x(%d) ",nMorb,nMorb);
         fprintf(stderr,"instead of (%d)x(%d).\n",pData->nmat,pData->nmat);
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -2045,6 +2107,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
             fprintf(stderr,"(pParameters->orb_rhf=%d) ",pParameters->orb_rhf);
             fprintf(stderr,"the total number of molecular orbitals ");
             fprintf(stderr," (=%d) should be an even number.\n",nMorb);
+            endProfilerPhase(&globalProfiler,PROF_OVERLAP);
             return 0;
         }
     }
@@ -2068,6 +2131,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
     {
         PRINT_ERROR("In computeOverlapMatrixOnGrid: we could not allocate ");
         fprintf(stderr,"memory for the local (int*) variable pOmega.\n");
+        endProfilerPhase(&globalProfiler,PROF_OVERLAP);
         return 0;
     }
 
@@ -2137,6 +2201,7 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
                     }
                     free(pOmega);
                     pOmega=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_OVERLAP);
                     return 0;
                 }
 
@@ -2145,7 +2210,8 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
                 // compute S(-2) followed by S(-3) (and not the contrary)
                 if (labelToConsiderOrAvoid==-2)
                 {
-                    pOverlapMatrixOld=&pData->pmat[iterationInTheLoop-1];
+                    pOverlapMatrixOld=
+                              &pData->pmat[(iterationInTheLoop-1)%pData->nring];
                     pOverlapMatrix->coef[i*nMorb+j]=
                                              pOverlapMatrixOld->coef[i*nMorb+j];
                 }
@@ -2167,24 +2233,33 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
             }
 
             integralK=0.;
-#pragma omp parallel for default(shared) private(integral,lI,lJ) reduction(+:integralK)
-            for (k=0; k<kMax; k++)
-            {
-                integral=0.;
-
-                // Compute the three-dimensional integral analytically
-                for (lI=0; lI<nGauss; lI++)
+#pragma omp parallel default(shared) private(integral,lI,lJ,timer,work)
+            {
+                // Add the time spent by the thread on its share of the loop to
+                // its busy time (one call per thread, not per item)
+                timer=beginProfilerThread(&globalProfiler);
+                work=0.;
+#pragma omp for nowait reduction(+:integralK)
+                for (k=0; k<kMax; k++)
                 {
-                    for (lJ=0; lJ<nGauss; lJ++)
+                    integral=0.;
+
+                    // Compute the three-dimensional integral analytically
+                    for (lI=0; lI<nGauss; lI++)
                     {
-                        integral+=evaluateTripleIntegralIJ(pParameters,pMesh,
-                                                           pChemicalSystem,
-                                                           pMolecularOrbitalI,
-                                                           pMolecularOrbitalJ,
+                        for (lJ=0; lJ<nGauss; lJ++)
+                        {
+                           integral+=evaluateTripleIntegralIJ(pParameters,pMesh,
+                                                               pChemicalSystem,
+                                                             pMolecularOrbitalI,
+                                                             pMolecularOrbitalJ,
                                                                lI,lJ,pOmega[k]);
+                        }
                     }
+                    integralK=integralK+integral;
+                    work+=1.;
                 }
-                integralK=integralK+integral;
+                endProfilerThread(&globalProfiler,PROF_OVERLAP,timer,work);
             }
 
             // End of the parallelization for the loop for. Update the overlap
@@ -2242,16 +2317,19 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
         }
     }
 
+    endProfilerPhase(&globalProfiler,PROF_OVERLAP);
+
     return 1;
 }
 
 /* ************************************************************************** */
 // The function diagonalizeOverlapMatrix diagonalize the (square symmetric)
-// matrix whose coefficients are stored in pData->pmat[iterationInTheLoop]
-// and if verbose is not set to zero, its prints the eigenvalues and
-// eigenvectors in the standard output stream. It has the Parameters*, the Data*
-// variable (both defined in main.h), and the int iterationInTheLoop as input
-// arguments and it returns one on success, otherwise zero for an error
+// matrix whose coefficients are stored in
+// pData->pmat[iterationInTheLoop%nring] and if verbose is not set to zero, its
+// prints the eigenvalues and eigenvectors in the standard output stream. It has
+// the Parameters*, the Data* variable (both defined in main.h), and the int
+// iterationInTheLoop as input arguments and it returns one on success,
+// otherwise zero for an error
 /* ************************************************************************** */
 int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
                                                          int iterationInTheLoop)
@@ -2263,6 +2341,9 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
     // LAPACK_COL_MAJOR instead of LAPACK_ROW_MAJOR to avoid transposition step
     int matrixLayout=LAPACK_COL_MAJOR;
 
+    // Time the diagonalization of the overlap matrix in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
+
     // If jobz='N', it only computes the eigenvalues and if jobz='V', it
     // computes also the (orthonormal) eigenvectors on exit. Check that each
     // line (i.e. column for LAPACK) is a eigenvector if LAPACK_COL_MAJOR is set
@@ -2290,6 +2371,7 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         fprintf(stderr,"variable pParameters=%p ",(void*)pParameters);
         fprintf(stderr,"or pData=%p does not have a valid ",(void*)pData);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
         return 0;
     }
 
@@ -2302,6 +2384,7 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         fprintf(stderr,"greater than the maximal number of iterations ");
         fprintf(stderr,"(=%d) allowed in the ",pParameters->iter_max);
         fprintf(stderr,"optimization loop.\n");
+        endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
         return 0;
     }
 
@@ -2312,6 +2395,7 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         PRINT_ERROR("In diagonalizeOverlapMatrix: the size of the overlap ");
         fprintf(stderr,"matrix (=%d) should be a positive ",nMorb);
         fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
         return 0;
     }
 
@@ -2324,6 +2408,7 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
             fprintf(stderr,"(pParameters->orb_rhf=%d) ",pParameters->orb_rhf);
             fprintf(stderr,"the total number of molecular orbitals ");
             fprintf(stderr," (=%d) should be an even number.\n",nMorb);
+            endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
             return 0;
         }
         n=nMorb/2;
@@ -2341,9 +2426,10 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         PRINT_ERROR("In diagonalizeOverlapMatrix: the pmat variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pmat);
+        endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
         return 0;
     }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
     // Check the pointers variable of pOverlapMatrix
     if (pOverlapMatrix->coef==NULL || pOverlapMatrix->diag==NULL ||
@@ -2356,6 +2442,7 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         fprintf(stderr,"diag=%p, ",(void*)pOverlapMatrix->diag);
         fprintf(stderr,"vect=%p) does not point ",(void*)pOverlapMatrix->vect);
         fprintf(stderr,"to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
         return 0;
     }
 
@@ -2405,6 +2492,7 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         PRINT_ERROR("In diagonalizeOverlapMatrix: dsyev function ");
         fprintf(stderr,"in Lapacke library failed and returned %d ",info);
         fprintf(stderr,"instead of zero.\n");
+        endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
         return 0;
     }
 
@@ -2461,6 +2549,8 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
         }
     }
 
+    endProfilerPhase(&globalProfiler,PROF_DIAGONALIZATION);
+
     return 1;
 }
 
@@ -2469,10 +2559,11 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
 // a certain number nu of electrons in the domain Omega and in the complement
 // the total number of electrons minus nu by using the eigenvalues of the
 // associated overlap matrix (Cancès et al. formula). All these probabilities
-// are also saved in the structure pointed by pData->pprob[iterationInTheLoop]
-// and the total population of electrons inside the domain is also computed and
-// saved in pData->pop[iterationInTheLoop], while the probability to find
-// the pParameters->nu_electrons in the domain is saved in
+// are also saved in the structure pointed by
+// pData->pprob[iterationInTheLoop%nring] and the total population of electrons
+// inside the domain is also computed and saved in
+// pData->pop[iterationInTheLoop], while the probability to find the
+// pParameters->nu_electrons in the domain is saved in
 // pData->pnu[iterationInTheLoop]. It has the Parameters*, the Data* variables
 // (both defined in main.h), and the integer iterationInTheLoop as input
 // arguments. It returns one if the probabilities have been successfully
@@ -2558,7 +2649,7 @@ int computeProbability(Parameters* pParameters, Data* pData,
         fprintf(stderr,"%p address.\n",(void*)pData->pprob);
         return 0;
     }
-    pProbabilities=&pData->pprob[iterationInTheLoop];
+    pProbabilities=&pData->pprob[iterationInTheLoop%pData->nring];
 
     // Check the pointers variable of pProbabilities
     if (pProbabilities->pk==NULL || pProbabilities->pkl==NULL)
@@ -2580,7 +2671,7 @@ int computeProbability(Parameters* pParameters, Data* pData,
         fprintf(stderr,"%p address.\n",(void*)pData->pmat);
         return 0;
     }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
     // Check the diag pointer variable of pOverlapMatrix
     if (pOverlapMatrix->diag==NULL)
@@ -2934,8 +3025,8 @@ double evaluateShapeGradientAtThePoint(double px, double py, double pz,
 // internal domain. In the latter case, it also directly modifies the mesh
 // depending on the sign of the shape gradient, which is computed thanks to the
 // eigenvalues and eigenvectors of the overlap matrix associated with
-// pChemicalSystem and stored in pData->pmat[iterationInTheLoop]. It has the
-// Parameters*, the Mesh*, the Data*, the ChemicalSystem* variables (both
+// pChemicalSystem and stored in pData->pmat[iterationInTheLoop%nring]. It has
+// the Parameters*, the Mesh*, the Data*, the ChemicalSystem* variables (both
 // defined in main.h) and the integer iterationInTheLoop as input argument.
 // It returns one if the shape gradient has been successfully computed (and the
 // domain succesfully modified in the case of hexahedral meshes) otherwise zero
@@ -2946,12 +3037,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                                          int iterationInTheLoop)
 {
     int i1=0, i3=0, j1=0, j3=0, k=0, l=0, p=0, p1=0, p3=0, nProb=0, nMorb=0;
-    int nu=0, nVer=0, nTri=0, nAdj=0;
+    int nu=0, nVer=0, nTri=0, nAdj=0, pIn=0, pOut=0, pHexahedronVertex[8]={0};
     double value=0., px=0., py=0., pz=0.;
     Probabilities* pProbabilities=NULL;
     OverlapMatrix* pOverlapMatrix=NULL;
     Point *pVertex=NULL;
 
+    // Time the computation of the shape gradient in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_GRADIENT);
+
     // Check input pointers
     if (pParameters==NULL || pMesh==NULL || pData==NULL ||
                                                           pChemicalSystem==NULL)
@@ -2961,6 +3055,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
         fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
         fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -2972,6 +3067,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"non-negative integer not (strictly) greater than the ");
         fprintf(stderr,"maximal number of allowed iterations ");
         fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -2982,6 +3078,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the total number of vertices ");
         fprintf(stderr,"(=%d) in the mesh should be a positive ",nVer);
         fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -2991,6 +3088,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the ");
         fprintf(stderr,"pver=%p variable of the structure ",(void*)pMesh->pver);
         fprintf(stderr,"pointed by pMesh does not have a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3005,6 +3103,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
             fprintf(stderr,"interior of the domain should be a positive ");
             fprintf(stderr,"integer as well as the total number of ");
             fprintf(stderr,"quadrilaterals (=%d) in the mesh.\n",pMesh->nqua);
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
 
@@ -3016,6 +3115,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
             fprintf(stderr,"(pMesh->padj=%p) or no ",(void*)pMesh->padj);
             fprintf(stderr,"quadrilaterals has been found ");
             fprintf(stderr,"(pMesh->pqua=%p).\n",(void*)pMesh->pqua);
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
     }
@@ -3028,6 +3128,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
             PRINT_ERROR("In computeShapeGradient: the total number of ");
             fprintf(stderr,"triangles (=%d) in the mesh should be a ",nTri);
             fprintf(stderr,"positive integer.\n");
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
 
@@ -3037,6 +3138,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
             PRINT_ERROR("In computeShapeGradient: the boundary structures ");
             fprintf(stderr,"have not been set up in the tetrahedral mesh: ");
             fprintf(stderr,"pMesh->ptri=%p.\n",(void*)pMesh->ptri);
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
     }
@@ -3048,6 +3150,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the total number of electrons ");
         fprintf(stderr,"(=%d) in the chemical system should be a ",nMorb);
         fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3056,6 +3159,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the pmorb variable of the ");
         fprintf(stderr,"structure pointed by pChemicalSystem is pointing to ");
         fprintf(stderr,"the %p address.\n",(void*)pChemicalSystem->pmorb);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3068,6 +3172,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"a (positive) integer not (strictly) greater than ");
         fprintf(stderr,"the total number of electrons (=%d) in the ",nMorb);
         fprintf(stderr,"chemical system.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3078,6 +3183,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the size of the array storing ");
         fprintf(stderr,"the different probabilities should be set to ");
         fprintf(stderr,"%d instead of %d.\n",nMorb+1,nProb);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3087,9 +3193,10 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the pprob variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pprob);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
-    pProbabilities=&pData->pprob[iterationInTheLoop];
+    pProbabilities=&pData->pprob[iterationInTheLoop%pData->nring];
 
     // Check the pkl variable of pProbabilities
     if (pProbabilities->pkl==NULL)
@@ -3098,6 +3205,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"%d-th Probabilities structure ",iterationInTheLoop+1);
         fprintf(stderr,"is pointing to the %p ",(void*)pProbabilities->pkl);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3108,6 +3216,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"arrays of the different OverlapMatrix structures ");
         fprintf(stderr,"should be set to %d instead of ",nMorb);
         fprintf(stderr,"%d.\n",pData->nmat);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3117,9 +3226,10 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeGradient: the pmat variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pmat);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
     // Check the diag and vect pointer variables of pOverlapMatrix
     if (pOverlapMatrix->diag==NULL || pOverlapMatrix->vect==NULL)
@@ -3130,6 +3240,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"(diag=%p, ",(void*)pOverlapMatrix->diag);
         fprintf(stderr,"vect=%p) does not point ",(void*)pOverlapMatrix->vect);
         fprintf(stderr,"to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3329,6 +3440,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 i3=l/pParameters->n_y;
                 j3=l%pParameters->n_y;
 
+                // First vertices of the hexahedra sharing the k-th
+                // quadrilateral (inside and outside the domain, respectively)
+                getHexahedronVertices(pMesh->padj[k].hexin-1,pParameters->n_y,
+                                           pParameters->n_z,pHexahedronVertex);
+                pIn=pHexahedronVertex[0];
+                getHexahedronVertices(pMesh->padj[k].hexout-1,pParameters->n_y,
+                                           pParameters->n_z,pHexahedronVertex);
+                pOut=pHexahedronVertex[0];
+
                 // Change labels of the hexahedra sharing the k-th quadrilateral
                 if (pParameters->trick_matrix)
                 {
@@ -3336,7 +3456,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                     {
                         if (i1==i3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexout-1].p1)
+                            if (p1==pOut)
                             {
                                 px+=pParameters->delta_x;
                             }
@@ -3359,13 +3479,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else if (j1==j3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexout-1].p1)
+                            if (p1==pOut)
                             {
                                 py+=pParameters->delta_y;
                             }
@@ -3388,13 +3510,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexout-1].p1)
+                            if (p1==pOut)
                             {
                                 pz+=pParameters->delta_z;
                             }
@@ -3417,6 +3541,8 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
@@ -3426,7 +3552,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                     {
                         if (i1==i3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexin-1].p1)
+                            if (p1==pIn)
                             {
                                 px+=pParameters->delta_x;
                             }
@@ -3449,13 +3575,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else if (j1==j3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexin-1].p1)
+                            if (p1==pIn)
                             {
                                 py+=pParameters->delta_y;
                             }
@@ -3478,13 +3606,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexin-1].p1)
+                            if (p1==pIn)
                             {
                                 pz+=pParameters->delta_z;
                             }
@@ -3507,6 +3637,8 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
@@ -3519,7 +3651,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                     {
                         if (i1==i3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexout-1].p1)
+                            if (p1==pOut)
                             {
                                 px+=pParameters->delta_x;
                             }
@@ -3542,13 +3674,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else if (j1==j3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexout-1].p1)
+                            if (p1==pOut)
                             {
                                 py+=pParameters->delta_y;
                             }
@@ -3571,13 +3705,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexout-1].p1)
+                            if (p1==pOut)
                             {
                                 pz+=pParameters->delta_z;
                             }
@@ -3600,6 +3736,8 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
@@ -3609,7 +3747,7 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                     {
                         if (i1==i3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexin-1].p1)
+                            if (p1==pIn)
                             {
                                 px+=pParameters->delta_x;
                             }
@@ -3632,13 +3770,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else if (j1==j3)
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexin-1].p1)
+                            if (p1==pIn)
                             {
                                 py+=pParameters->delta_y;
                             }
@@ -3661,13 +3801,15 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
                         }
                         else
                         {
-                            if (p1==pMesh->phex[pMesh->padj[k].hexin-1].p1)
+                            if (p1==pIn)
                             {
                                 pz+=pParameters->delta_z;
                             }
@@ -3690,6 +3832,8 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
                                     fprintf(stderr,"function returned zero, ");
                                     fprintf(stderr,"which is not the ");
                                     fprintf(stderr,"expected value here.\n");
+                                    endProfilerPhase(&globalProfiler,
+                                                                 PROF_GRADIENT);
                                     return 0;
                                 }
                             }
@@ -3700,6 +3844,8 @@ int computeShapeGradient(Parameters* pParameters, Mesh* pMesh, Data* pData,
         }
     }
 
+    endProfilerPhase(&globalProfiler,PROF_GRADIENT);
+
     return 1;
 }
 
@@ -3760,6 +3906,9 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
     OverlapMatrix* pOverlapMatrix=NULL;
     Point *pp1=NULL, *pp2=NULL, *pp3=NULL;
 
+    // Time the computation of the shape residual in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_GRADIENT);
+
     // Check input pointers
     if (pParameters==NULL || pMesh==NULL || pData==NULL ||
                                                           pChemicalSystem==NULL)
@@ -3769,6 +3918,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
         fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
         fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3780,6 +3930,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"non-negative integer not (strictly) greater than the ");
         fprintf(stderr,"maximal number of allowed iterations ");
         fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3790,6 +3941,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the total number of vertices ");
         fprintf(stderr,"(=%d) in the mesh should be a positive ",nVer);
         fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3799,6 +3951,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the ");
         fprintf(stderr,"pver=%p variable of the structure ",(void*)pMesh->pver);
         fprintf(stderr,"pointed by pMesh does not have a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3813,6 +3966,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
             fprintf(stderr,"interior of the domain should be a positive ");
             fprintf(stderr,"integer as well as the total number of ");
             fprintf(stderr,"quadrilaterals (=%d) in the mesh.\n",pMesh->nqua);
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
 
@@ -3824,6 +3978,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
             fprintf(stderr,"(pMesh->padj=%p) or no ",(void*)pMesh->padj);
             fprintf(stderr,"quadrilaterals has been found ");
             fprintf(stderr,"(pMesh->pqua=%p).\n",(void*)pMesh->pqua);
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
     }
@@ -3836,6 +3991,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
             PRINT_ERROR("In computeShapeResidual: the total number of ");
             fprintf(stderr,"triangles (=%d) in the mesh should be a ",nTri);
             fprintf(stderr,"positive integer.\n");
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
 
@@ -3845,6 +4001,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
             PRINT_ERROR("In computeShapeResidual: the boundary structures ");
             fprintf(stderr,"have not been set up in the tetrahedral mesh: ");
             fprintf(stderr,"pMesh->ptri=%p.\n",(void*)pMesh->ptri);
+            endProfilerPhase(&globalProfiler,PROF_GRADIENT);
             return 0;
         }
     }
@@ -3856,6 +4013,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the total number of electrons ");
         fprintf(stderr,"(=%d) in the chemical system should be a ",nMorb);
         fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3864,6 +4022,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the pmorb variable of the ");
         fprintf(stderr,"structure pointed by pChemicalSystem is pointing to ");
         fprintf(stderr,"the %p address.\n",(void*)pChemicalSystem->pmorb);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3876,6 +4035,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"a (positive) integer not (strictly) greater than ");
         fprintf(stderr,"the total number of electrons (=%d) in the ",nMorb);
         fprintf(stderr,"chemical system.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3886,6 +4046,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the size of the array storing ");
         fprintf(stderr,"the different probabilities should be set to ");
         fprintf(stderr,"%d instead of %d.\n",nMorb+1,nProb);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3895,6 +4056,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the d1p variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->d1p);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3904,9 +4066,10 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the pprob variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pprob);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
-    pProbabilities=&pData->pprob[iterationInTheLoop];
+    pProbabilities=&pData->pprob[iterationInTheLoop%pData->nring];
 
     // Check the pkl variable of pProbabilities
     if (pProbabilities->pkl==NULL)
@@ -3915,6 +4078,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"%d-th Probabilities structure ",iterationInTheLoop+1);
         fprintf(stderr,"is pointing to the %p ",(void*)pProbabilities->pkl);
         fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3925,6 +4089,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"arrays of the different OverlapMatrix structures ");
         fprintf(stderr,"should be set to %d instead of ",nMorb);
         fprintf(stderr,"%d.\n",pData->nmat);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -3934,9 +4099,10 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         PRINT_ERROR("In computeShapeResidual: the pmat variable of the ");
         fprintf(stderr,"structure pointed by pData is pointing to the ");
         fprintf(stderr,"%p address.\n",(void*)pData->pmat);
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
     // Check the diag and vect pointer variables of pOverlapMatrix
     if (pOverlapMatrix->diag==NULL || pOverlapMatrix->vect==NULL)
@@ -3947,6 +4113,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         fprintf(stderr,"(diag=%p, ",(void*)pOverlapMatrix->diag);
         fprintf(stderr,"vect=%p) does not point ",(void*)pOverlapMatrix->vect);
         fprintf(stderr,"to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_GRADIENT);
         return 0;
     }
 
@@ -4216,6 +4383,8 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
         pData->d1p[iterationInTheLoop]=integral;
     }
 
+    endProfilerPhase(&globalProfiler,PROF_GRADIENT);
+
     return 1;
 }
 
@@ -4231,7 +4400,7 @@ int computeShapeResidual(Parameters* pParameters, Mesh* pMesh, Data* pData,
 int shapeDerivative(Parameters* pParameters, Mesh* pMesh, Data* pData,
                         ChemicalSystem* pChemicalSystem, int iterationInTheLoop)
 {
-    int i=0, iMax=0, sizeMemory=0;
+    int i=0, iMax=0;
 
     // Check that the pParameters variable is not pointing to NULL
     if (pParameters==NULL)
@@ -4378,23 +4547,15 @@ int shapeDerivative(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 }
             }
 
-            // Free the memory allocated for Adjacency table
-            sizeMemory=sizeof(int)+(pMesh->nadj)*sizeof(Adjacency);
-            fprintf(stdout,"\nCleaning allocated memory ");
-            fprintf(stdout,"(%d,",sizeMemory/1000000);
-            fprintf(stdout,"%d Mo) for the ",sizeMemory%1000000);
-            fprintf(stdout,"Adjacency structures. ");
-            free(pMesh->padj);
-            pMesh->padj=NULL;
-            pMesh->nadj=0;
-
-            // Rebuild the Adjacency structures and boundary quandrilaterals
-            fprintf(stdout,"\nBuild the new Adjacency structures to get the ");
-            fprintf(stdout,"updated domain.\n");
-            if (!getLevelSetQuadrilaterals(pParameters,pMesh))
+            // Update the Adjacency structures and boundary quandrilaterals
+            // locally (only the previous boundary hexahedra may have changed)
+            fprintf(stdout,"\nUpdate the Adjacency structures to get the ");
+            fprintf(stdout,"new domain.\n");
+            if (!updateLevelSetQuadrilaterals(pParameters,pMesh))
             {
-                PRINT_ERROR("In shapeDerivative: getLevelSetQuadrilaterals ");
-                fprintf(stderr,"function returned zero instead of one.\n");
+                PRINT_ERROR("In shapeDerivative: ");
+                fprintf(stderr,"updateLevelSetQuadrilaterals function ");
+                fprintf(stderr,"returned zero instead of one.\n");
                 return 0;
             }
         }
@@ -4827,7 +4988,8 @@ int writingObjFile(Parameters* pParameters, Mesh* pMesh)
 
     // Opening *.obj file (warning: reset and overwrite file if already exists)
     // fopen returns a FILE pointer on success, otherwise NULL is returned
-    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    if (pParameters->verbose>0 ||
+                          (pParameters->opt_mode!=1 && !pParameters->verbose))
     {
         fprintf(stdout,"\nOpening %s file. ",fileLocation);
     }
@@ -4840,7 +5002,8 @@ int writingObjFile(Parameters* pParameters, Mesh* pMesh)
         fileLocation=NULL;
         return 0;
     }
-    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    if (pParameters->verbose>0 ||
+                          (pParameters->opt_mode!=1 && !pParameters->verbose))
     {
         fprintf(stdout,"Start writing object data. ");
     }
@@ -4997,7 +5160,8 @@ int writingObjFile(Parameters* pParameters, Mesh* pMesh)
         return 0;
     }
     objFile=NULL;
-    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    if (pParameters->verbose>0 ||
+                          (pParameters->opt_mode!=1 && !pParameters->verbose))
     {
         fprintf(stdout,"Closing file.\n");
     }
@@ -5010,1219 +5174,1396 @@ int writingObjFile(Parameters* pParameters, Mesh* pMesh)
 }
 
 /* ************************************************************************** */
-// The function saveOrRemoveMeshInTheLoop is used in the optimization loop
-// to either save the mesh in the *.mesh and/or *.cube/*.obj format according to
-// the pParameters->save_type and iterationInTheLoop variables, or remove the
-// *.(iterationInTheLoop).mesh file if it already exists, depending if the
-// booleanForSave input variable is set to one or zero. In the latter case, the
-// file must already exists as well as its associated *.mesh one whose path
-// name is stored in the Parameters->name_mesh variable. We recall that the
-// *.cube format requires the charge and center coordinates of the nuclei
-// associated with the chemical system. The function has the Parameters*,
-// Mesh*, ChemicalSystem* (both defined in main.h) and the integer variable
-// iterationInTheLoop as input arguments. It returns one one success, otherwise
-// zero is returned uf an error is encountered during the process
+// The function writingSnapshotFiles performs the file operations associated
+// with one snapshot of the optimization loop. If booleanForSave is set to zero,
+// it removes the fileLocation (*.(iteration).mesh) file if it exists.
+// Otherwise, it writes (if booleanForCurrent is set to one) the mesh in the
+// current *.mesh file whose name is stored in pParameters->name_mesh and,
+// depending on pParameters->save_type, in the *.(iteration).mesh file and/or
+// in the *.(iteration).cube/ *.obj file whose name is built on fileLocation.
+// It is called either by the background writer thread or directly by the
+// saveOrRemoveMeshInTheLoop function if the latter has not been started (in
+// the former case, pParameters->verbose is set to minus one so that nothing is
+// printed in the standard output stream, shared with the main thread). It
+// has the Parameters*, Mesh*, ChemicalSystem* (defined in main.h), the char*
+// fileLocation, and the two integers booleanForSave and booleanForCurrent as
+// input arguments. It returns one on success, otherwise zero
 /* ************************************************************************** */
-int saveOrRemoveMeshInTheLoop(Parameters* pParameters, Mesh* pMesh,
-                              ChemicalSystem* pChemicalSystem,
-                                     int booleanForSave, int iterationInTheLoop)
+int writingSnapshotFiles(Parameters* pParameters, Mesh* pMesh,
+                         ChemicalSystem* pChemicalSystem, char* fileLocation,
+                                      int booleanForSave, int booleanForCurrent)
 {
     size_t lengthName=0;
-    char *fileLocation=NULL;
+    char *currentLocation=NULL;
+    Parameters parameters;
 
     // Check the input pointers
-    if (pParameters==NULL || pMesh==NULL || pChemicalSystem==NULL)
+    if (pParameters==NULL || pMesh==NULL || pChemicalSystem==NULL ||
+                                                             fileLocation==NULL)
     {
-        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: at least one of the input ");
+        PRINT_ERROR("In writingSnapshotFiles: at least one of the input ");
         fprintf(stderr,"variables (pParameters=%p, ",(void*)pParameters);
         fprintf(stderr,"pMesh=%p, ",(void*)pMesh);
-        fprintf(stderr,"pChemicalSystem=%p) ",(void*)pChemicalSystem);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"fileLocation=%p) ",(void*)fileLocation);
         fprintf(stderr,"does not point to a valid address.\n");
         return 0;
     }
 
-    if (booleanForSave)
+    // Remove the previous *.(iteration).mesh file if it exists
+    if (!booleanForSave)
     {
-        // Saving the mesh discretization in a *.mesh file
-        if (!writingMeshFile(pParameters,pMesh))
+        if (initialFileExists(fileLocation,pParameters->name_length)==1)
         {
-            PRINT_ERROR("In saveOrRemoveMeshInTheLoop: writingMeshFile ");
-            fprintf(stderr,"function returned zero instead of one.\n");
-            return 0;
+            // remove returns 0 on success, otherwise -1
+            if (remove(fileLocation))
+            {
+                PRINT_ERROR("In writingSnapshotFiles: wrong return (=-1) of ");
+                fprintf(stderr,"the standard remove c-function in the ");
+                fprintf(stderr,"attempt of removing the %s ",fileLocation);
+                fprintf(stderr,"file.\n");
+                return 0;
+            }
         }
+        return 1;
     }
-    else
+
+    // Saving the mesh discretization in the current *.mesh file
+    if (booleanForCurrent)
     {
-        // Check pParameters->name_mesh variable
-        if (getMeshFormat(pParameters->name_mesh,pParameters->name_length)!=1)
+        if (!writingMeshFile(pParameters,pMesh))
         {
-            PRINT_ERROR("In saveOrRemoveMeshInTheLoop: getMeshFormat ");
-            fprintf(stderr,"function did not returned one, which was the ");
-            fprintf(stderr,"expected value here.\n");
+            PRINT_ERROR("In writingSnapshotFiles: writingMeshFile ");
+            fprintf(stderr,"function returned zero instead of one.\n");
             return 0;
         }
     }
 
-    // strlen returns the length of the string without the terminating '\0'
-    lengthName=strlen(pParameters->name_mesh);
-    if ((int)lengthName>pParameters->name_length-11)
-    {
-        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: the maximal size ");
-        fprintf(stderr,"(=%d) allocated for the ",pParameters->name_length-11);
-        fprintf(stderr,"names has not been increased from ten.\n");
-        return 0;
-    }
-
-    // calloc function returns a pointer to the allocated memory, otherwise NULL
-    lengthName=pParameters->name_length;
-    fileLocation=(char*)calloc(lengthName,sizeof(char));
-    if (fileLocation==NULL)
-    {
-        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: could not allocate memory ");
-        fprintf(stderr,"for the local char* fileLocation variable.\n");
-        return 0;
-    }
-
-    // sprintf returns the total number of characters written is returned
-    // not including the char '\0', otherwise a negative number on failure
-    lengthName=strlen(pParameters->name_mesh);
-    pParameters->name_mesh[lengthName-5]='\0';
-    if (sprintf(fileLocation,"%s.%d.mesh",pParameters->name_mesh,
-                                                          iterationInTheLoop)<0)
-    {
-        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: the standard sprintf ");
-        fprintf(stderr,"c-function returned an unexpected negative ");
-        fprintf(stderr,"value, while attempting to save the mesh at the ");
-        fprintf(stderr,"%d-th iteration of the ",iterationInTheLoop);
-        fprintf(stderr,"optimization loop.\n");
-        free(fileLocation);    // free function does not return any value
-        fileLocation=NULL;
-        return 0;
-    }
-    pParameters->name_mesh[lengthName-5]='.';
+    // The writing functions build their file name on the name_mesh variable
+    // so we work on a copy of pParameters pointing to fileLocation instead
+    parameters=*pParameters;
+    parameters.name_mesh=fileLocation;
 
-    if (initialFileExists(fileLocation,pParameters->name_length)==1)
+    // Saving the *.(iteration).mesh file (the *.obj format needs an existing
+    // *.mesh file so it is always written in the case of tetrahedral meshes)
+    if (parameters.save_type==1 || parameters.save_type==2 ||
+                                                         parameters.opt_mode>0)
     {
-        // remove returns 0 on success, otherwise -1
-        if (remove(fileLocation))
+        if (!writingMeshFile(&parameters,pMesh))
         {
-            PRINT_ERROR("In saveOrRemoveMeshInTheLoop: wrong return (=-1) of ");
-            fprintf(stderr,"the standard remove c-function in the ");
-            fprintf(stderr,"attempt of removing the %s ",fileLocation);
-            fprintf(stderr,"file.\n");
-            free(fileLocation);
-            fileLocation=NULL;
+            PRINT_ERROR("In writingSnapshotFiles: writingMeshFile ");
+            fprintf(stderr,"function returned zero instead of one.\n");
             return 0;
         }
     }
 
-    if (booleanForSave)
+    if (parameters.save_type==0 || parameters.save_type==2)
     {
-        if (!copyFileLocation(pParameters->name_mesh,pParameters->name_length,
-                                                                  fileLocation))
+        if (parameters.opt_mode<=0)
         {
-            PRINT_ERROR("In saveOrRemoveMeshInTheLoop: copyFileLocation ");
-            fprintf(stderr,"function returned zero instead of one.\n");
-            free(fileLocation);
-            fileLocation=NULL;
-            return 0;
+            if (!writingCubeFile(&parameters,pChemicalSystem,pMesh))
+            {
+                PRINT_ERROR("In writingSnapshotFiles: writingCubeFile ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
         }
-
-        if (pParameters->opt_mode<=0 && pParameters->save_type!=1)
+        else
         {
-            if (!writingCubeFile(pParameters,pChemicalSystem,pMesh))
+            if (!writingObjFile(&parameters,pMesh))
             {
-                PRINT_ERROR("In saveOrRemoveMeshInTheLoop: writingCubeFile ");
+                PRINT_ERROR("In writingSnapshotFiles: writingObjFile ");
                 fprintf(stderr,"function returned zero instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
                 return 0;
             }
 
-            if (!pParameters->save_type)
+            if (!parameters.save_type)
             {
-                fprintf(stdout,"rm %s",fileLocation);
+                if (parameters.verbose>=0)
+                {
+                    fprintf(stdout,"rm %s",fileLocation);
+                }
                 if (remove(fileLocation))
                 {
-                    PRINT_ERROR("In saveOrRemoveMeshInTheLoop: wrong return ");
+                    PRINT_ERROR("In writingSnapshotFiles: wrong return ");
                     fprintf(stderr,"(=-1) of the standard remove c-function ");
                     fprintf(stderr,"in the attempt of removing the ");
                     fprintf(stderr,"%s file.\n",fileLocation);
-                    free(fileLocation);
-                    fileLocation=NULL;
                     return 0;
                 }
             }
+        }
 
-            lengthName=strlen(fileLocation);
-            fileLocation[lengthName-5]='.';
-            fileLocation[lengthName-4]='c';
-            fileLocation[lengthName-3]='u';
-            fileLocation[lengthName-2]='b';
-            fileLocation[lengthName-1]='e';
-            fileLocation[lengthName]='\0';
-
-            lengthName=strlen(pParameters->name_mesh);
-            pParameters->name_mesh[lengthName-5]='.';
-            pParameters->name_mesh[lengthName-4]='c';
-            pParameters->name_mesh[lengthName-3]='u';
-            pParameters->name_mesh[lengthName-2]='b';
-            pParameters->name_mesh[lengthName-1]='e';
-            pParameters->name_mesh[lengthName]='\0';
-
-            if (initialFileExists(fileLocation,pParameters->name_length)==1)
-            {
-                if (remove(fileLocation))
-                {
-                    PRINT_ERROR("In saveOrRemoveMeshInTheLoop: wrong return ");
-                    fprintf(stderr,"(=-1) of the standard remove c-function ");
-                    fprintf(stderr,"in the attempt of removing the ");
-                    fprintf(stderr,"%s file.\n",fileLocation);
-                    free(fileLocation);
-                    fileLocation=NULL;
-                    return 0;
-                }
-            }
-
-            if (!renameFileLocation(pParameters->name_mesh,
-                                         pParameters->name_length,fileLocation))
-            {
-                PRINT_ERROR("In saveOrRemoveMeshInTheLoop: ");
-                fprintf(stderr,"renameFileLocation function returned zero ");
-                fprintf(stderr,"instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
-                return 0;
-            }
-
-            lengthName=strlen(pParameters->name_mesh);
-            pParameters->name_mesh[lengthName-5]='.';
-            pParameters->name_mesh[lengthName-4]='m';
-            pParameters->name_mesh[lengthName-3]='e';
-            pParameters->name_mesh[lengthName-2]='s';
-            pParameters->name_mesh[lengthName-1]='h';
-            pParameters->name_mesh[lengthName]='\0';
+        // The *.(iteration).cube/ *.obj file supersedes the one associated
+        // with the current *.mesh file (e.g. written at initialization) so
+        // the latter is removed if it exists (calloc function returns a pointer
+        // to the allocated memory, otherwise NULL)
+        currentLocation=(char*)calloc(parameters.name_length,sizeof(char));
+        if (currentLocation==NULL)
+        {
+            PRINT_ERROR("In writingSnapshotFiles: could not allocate memory ");
+            fprintf(stderr,"for the local char* currentLocation variable.\n");
+            return 0;
+        }
+        strncpy(currentLocation,pParameters->name_mesh,parameters.name_length);
+        lengthName=strlen(currentLocation);
+        if (parameters.opt_mode<=0)
+        {
+            strcpy(currentLocation+lengthName-5,".cube");
         }
-        else if (pParameters->opt_mode>0 && pParameters->save_type!=1)
+        else
+        {
+            strcpy(currentLocation+lengthName-5,".obj");
+        }
+        if (initialFileExists(currentLocation,parameters.name_length)==1)
         {
-            if (!writingObjFile(pParameters,pMesh))
+            // remove returns 0 on success, otherwise -1
+            if (remove(currentLocation))
             {
-                PRINT_ERROR("In saveOrRemoveMeshInTheLoop: writingObjFile ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
+                PRINT_ERROR("In writingSnapshotFiles: wrong return (=-1) of ");
+                fprintf(stderr,"the standard remove c-function in the ");
+                fprintf(stderr,"attempt of removing the %s ",currentLocation);
+                fprintf(stderr,"file.\n");
+                free(currentLocation);
                 return 0;
             }
+        }
+        free(currentLocation);    // free function does not return any value
+        currentLocation=NULL;
+    }
 
-            if (!pParameters->save_type)
-            {
-                fprintf(stdout,"rm %s",fileLocation);
-                if (remove(fileLocation))
-                {
-                    PRINT_ERROR("In saveOrRemoveMeshInTheLoop: wrong return ");
-                    fprintf(stderr,"(=-1) of the standard remove c-function ");
-                    fprintf(stderr,"in the attempt of removing the ");
-                    fprintf(stderr,"%s file.\n",fileLocation);
-                    free(fileLocation);
-                    fileLocation=NULL;
-                    return 0;
-                }
-            }
+    return 1;
+}
 
-            lengthName=strlen(fileLocation);
-            fileLocation[lengthName-5]='.';
-            fileLocation[lengthName-4]='o';
-            fileLocation[lengthName-3]='b';
-            fileLocation[lengthName-2]='j';
-            fileLocation[lengthName-1]='\0';
+/* ************************************************************************** */
+// The function runSnapshotWriter is the main function of the background thread
+// writing the snapshots of the optimization loop. It waits for snapshots in
+// the queue of the SnapshotWriter structure, writes them in the order they
+// were queued thanks to the writingSnapshotFiles function (silently, the main
+// thread being the only one to print in the standard output stream), and frees
+// their memory. Any error is recorded in the error variable of the structure.
+// It ends when the stop variable is set to one and the queue is empty. It has
+// the void* pointer to the SnapshotWriter structure (defined in main.h) as
+// input argument and it returns NULL (as expected by the pthread_create
+// function)
+/* ************************************************************************** */
+void* runSnapshotWriter(void* pSnapshotWriter)
+{
+    int returnValue=0;
+    SnapshotWriter* pWriter=(SnapshotWriter*)pSnapshotWriter;
+    SnapshotJob job;
 
-            lengthName=strlen(pParameters->name_mesh);
-            pParameters->name_mesh[lengthName-5]='.';
-            pParameters->name_mesh[lengthName-4]='o';
-            pParameters->name_mesh[lengthName-3]='b';
-            pParameters->name_mesh[lengthName-2]='j';
-            pParameters->name_mesh[lengthName-1]='\0';
+    while (1)
+    {
+        // Wait for a snapshot to be queued (or for the writer to be stopped)
+        pthread_mutex_lock(&pWriter->mutex);
+        while (!pWriter->count && !pWriter->stop)
+        {
+            pthread_cond_wait(&pWriter->notEmpty,&pWriter->mutex);
+        }
+        if (!pWriter->count)
+        {
+            pthread_mutex_unlock(&pWriter->mutex);
+            break;
+        }
+        job=pWriter->pjob[pWriter->head];
+        pWriter->head=(pWriter->head+1)%pWriter->capacity;
+        pWriter->count--;
+        pthread_cond_signal(&pWriter->notFull);
+        pthread_mutex_unlock(&pWriter->mutex);
+
+        // Perform the file operations outside of the lock
+        returnValue=writingSnapshotFiles(&job.parameters,&job.mesh,job.pchem,
+                                            job.fileLocation,job.booleanForSave,
+                                                         job.booleanForCurrent);
+
+        freeMeshMemory(&job.mesh);
+        free(job.parameters.name_mesh);
+        job.parameters.name_mesh=NULL;
+        free(job.fileLocation);
+        job.fileLocation=NULL;
+
+        pthread_mutex_lock(&pWriter->mutex);
+        if (!returnValue)
+        {
+            pWriter->error=1;
+        }
+        pWriter->pending--;
+        if (!pWriter->pending)
+        {
+            pthread_cond_broadcast(&pWriter->allDone);
+        }
+        pthread_mutex_unlock(&pWriter->mutex);
+    }
 
-            if (initialFileExists(fileLocation,pParameters->name_length)==1)
-            {
-                if (remove(fileLocation))
-                {
-                    PRINT_ERROR("In saveOrRemoveMeshInTheLoop: wrong return ");
-                    fprintf(stderr,"(=-1) of the standard remove c-function ");
-                    fprintf(stderr,"in the attempt of removing the ");
-                    fprintf(stderr,"%s file.\n",fileLocation);
-                    free(fileLocation);
-                    fileLocation=NULL;
-                    return 0;
-                }
-            }
+    return NULL;
+}
 
-            if (!renameFileLocation(pParameters->name_mesh,
-                                         pParameters->name_length,fileLocation))
-            {
-                PRINT_ERROR("In saveOrRemoveMeshInTheLoop: ");
-                fprintf(stderr,"renameFileLocation function returned zero ");
-                fprintf(stderr,"instead of one.\n");
-                free(fileLocation);
-                fileLocation=NULL;
-                return 0;
-            }
+/* ************************************************************************** */
+// The function startSnapshotWriter allocates the bounded queue (of size
+// SNAPSHOT_QUEUE_SIZE) of the SnapshotWriter structure, initializes its
+// synchronization variables, and starts the background writer thread. It has
+// the SnapshotWriter* variable (defined in main.h) as input argument and it
+// returns one on success, otherwise zero (the structure then remains inactive
+// and the snapshots are written synchronously)
+/* ************************************************************************** */
+int startSnapshotWriter(SnapshotWriter* pWriter)
+{
+    // Check the input pointer
+    if (pWriter==NULL)
+    {
+        PRINT_ERROR("In startSnapshotWriter: the input variable pWriter=");
+        fprintf(stderr,"%p does not point to a valid ",(void*)pWriter);
+        fprintf(stderr,"address.\n");
+        return 0;
+    }
 
-            lengthName=strlen(pParameters->name_mesh);
-            pParameters->name_mesh[lengthName-4]='.';
-            pParameters->name_mesh[lengthName-3]='m';
-            pParameters->name_mesh[lengthName-2]='e';
-            pParameters->name_mesh[lengthName-1]='s';
-            pParameters->name_mesh[lengthName]='h';
-            pParameters->name_mesh[lengthName+1]='\0';
-        }
+    if (pWriter->active)
+    {
+        return 1;
     }
 
-    // Free the memory allocated for fileLocation
-    free(fileLocation);
-    fileLocation=NULL;
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    pWriter->capacity=SNAPSHOT_QUEUE_SIZE;
+    pWriter->pjob=(SnapshotJob*)calloc(pWriter->capacity,sizeof(SnapshotJob));
+    if (pWriter->pjob==NULL)
+    {
+        PRINT_ERROR("In startSnapshotWriter: could not allocate memory for ");
+        fprintf(stderr,"the queue of the snapshot writer.\n");
+        return 0;
+    }
+    pWriter->stop=0;
+    pWriter->error=0;
+    pWriter->head=0;
+    pWriter->count=0;
+    pWriter->pending=0;
+
+    // pthread_* functions return zero on success, otherwise an error number
+    if (pthread_mutex_init(&pWriter->mutex,NULL))
+    {
+        PRINT_ERROR("In startSnapshotWriter: pthread_mutex_init function ");
+        fprintf(stderr,"did not return zero.\n");
+        free(pWriter->pjob);
+        pWriter->pjob=NULL;
+        return 0;
+    }
+    pthread_cond_init(&pWriter->notEmpty,NULL);
+    pthread_cond_init(&pWriter->notFull,NULL);
+    pthread_cond_init(&pWriter->allDone,NULL);
+
+    if (pthread_create(&pWriter->thread,NULL,runSnapshotWriter,pWriter))
+    {
+        PRINT_ERROR("In startSnapshotWriter: pthread_create function did ");
+        fprintf(stderr,"not return zero.\n");
+        pthread_cond_destroy(&pWriter->allDone);
+        pthread_cond_destroy(&pWriter->notFull);
+        pthread_cond_destroy(&pWriter->notEmpty);
+        pthread_mutex_destroy(&pWriter->mutex);
+        free(pWriter->pjob);
+        pWriter->pjob=NULL;
+        return 0;
+    }
+    pWriter->active=1;
 
     return 1;
 }
 
 /* ************************************************************************** */
-// The function saveDataInTheLoop finishes to evaluate the non-already-computed
-// data at the (iterationInTheLoop)-th iteration of the optimization loop, saves
-// the mesh in a *.(iterationInTheLoop).mesh/ *.(iterationInTheLoop).cube file
-// thanks to the saveOrRemoveMeshInTheLoop function (since saveDataInTheLoop is
-// performed at the end of the optimization loop, this mesh will correspond to
-// the one of the next iteration, thus getting a copy in case of crash), and
-// deletes the *.(iterationInTheLoop-1).mesh/*.(iterationInTheLoop-1).cube
-// previous mesh file except if the pParameters->save_mesh variable is positive
-// and a multiple of (iterationInTheLoop-1). Similarly, if
-// pParameters->save_data is positive and a multiple of iterationInTheLoop,
-// it saves all the calculated values stored in the structure pointed by pData,
-// appending them in the *.data file whose name is stored in the
-// pParameters->name_data variable. It has the Parameters*, Mesh*, Data*,
-// ChemicalSystem* structures (both defined in main.h), the integer
-// iterationInTheLoop as input arguments, and also the three time_t* variables
-// (pGlobalInitialTimer, pStartLocalTimer, pEndLocalTimer) that are used to
-// compute the execution time of one iteration and the cumulated time. The
-// function returns one on success, otherwise zero is returned in case of error
+// The function pushSnapshotInWriter queues a snapshot in the SnapshotWriter
+// structure: the mesh is deep copied (if booleanForSave is set to one), as
+// well as the name_mesh and fileLocation strings, so that the optimization
+// loop can go on modifying the structure pointed by pMesh while the background
+// thread writes the files. If the queue is full, it waits until a slot is
+// released. It has the SnapshotWriter*, Parameters*, Mesh*, ChemicalSystem*
+// (defined in main.h), the char* fileLocation, and the two integers
+// booleanForSave and booleanForCurrent as input arguments. It returns one on
+// success, otherwise zero (including if a previous snapshot failed)
 /* ************************************************************************** */
-int saveDataInTheLoop(Parameters* pParameters, Mesh* pMesh, Data* pData,
-                      ChemicalSystem* pChemicalSystem, int iterationInTheLoop,
-                      time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
-                                                         time_t* pEndLocalTimer)
+int pushSnapshotInWriter(SnapshotWriter* pWriter, Parameters* pParameters,
+                                   Mesh* pMesh, ChemicalSystem* pChemicalSystem,
+                                         char* fileLocation, int booleanForSave,
+                                                          int booleanForCurrent)
 {
+    int iJob=0, booleanError=0;
     size_t lengthName=0;
-    FILE *dataFile=NULL;
+    SnapshotJob job;
 
     // Check the input pointers
-    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
-                           pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
-                                 pStartLocalTimer==NULL || pEndLocalTimer==NULL)
+    if (pWriter==NULL || pParameters==NULL || pMesh==NULL ||
+                                    pChemicalSystem==NULL || fileLocation==NULL)
     {
-        PRINT_ERROR("In saveDataInTheLoop: one of the input pointers ");
+        PRINT_ERROR("In pushSnapshotInWriter: at least one of the input ");
+        fprintf(stderr,"variables (pWriter=%p, ",(void*)pWriter);
         fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
-        fprintf(stderr,"pData=%p, pMesh=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pMesh=%p, ",(void*)pMesh);
         fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
-        fprintf(stderr,"pGlobalInitialTimer=%p, ",(void*)pGlobalInitialTimer);
-        fprintf(stderr,"pStartLocalTimer=%p or ",(void*)pStartLocalTimer);
-        fprintf(stderr,"pEndLocalTimer=%p, ",(void*)pEndLocalTimer);
+        fprintf(stderr,"fileLocation=%p) ",(void*)fileLocation);
         fprintf(stderr,"does not point to a valid address.\n");
         return 0;
     }
 
-    // Check the iterationInTheLoop variable
-    if (iterationInTheLoop<0 || iterationInTheLoop>pParameters->iter_max)
+    if (!pWriter->active)
     {
-        PRINT_ERROR("In saveDataInTheLoop: the input iterationInTheLoop ");
-        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
-        fprintf(stderr,"non-negative integer not (strictly) greater than ");
-        fprintf(stderr,"the maximal number (=%d) ",pParameters->iter_max);
-        fprintf(stderr,"of iterations allowed in the optimizationn loop.\n");
+        PRINT_ERROR("In pushSnapshotInWriter: the background writer has not ");
+        fprintf(stderr,"been started.\n");
         return 0;
     }
 
-    // Check the pointers variables of the structure pointed by pData
-    if (pData->pnu==NULL || pData->pop==NULL || pData->d0p==NULL ||
-                     pData->d1p==NULL || pData->d2p==NULL || pData->tim==NULL ||
-                                                              pData->ctim==NULL)
+    // Build the snapshot (outside of the lock)
+    job.booleanForSave=booleanForSave;
+    job.booleanForCurrent=booleanForCurrent;
+    job.parameters=*pParameters;
+    job.parameters.verbose=-1;
+    job.pchem=pChemicalSystem;
+    initializeMeshStructure(&job.mesh);
+
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    lengthName=pParameters->name_length;
+    job.fileLocation=(char*)calloc(lengthName,sizeof(char));
+    job.parameters.name_mesh=(char*)calloc(lengthName,sizeof(char));
+    if (job.fileLocation==NULL || job.parameters.name_mesh==NULL)
     {
-        PRINT_ERROR("In saveDataInTheLoop: at least one of the input pointers");
-        fprintf(stderr,"pData->pnu=%p, ",(void*)pData->pnu);
-        fprintf(stderr,"pData->pop=%p, ",(void*)pData->pop);
-        fprintf(stderr,"pData->d0p=%p, ",(void*)pData->d0p);
-        fprintf(stderr,"pData->d1p=%p, ",(void*)pData->d1p);
-        fprintf(stderr,"pData->d2p=%p, ",(void*)pData->d2p);
-        fprintf(stderr,"pData->tim=%p, ",(void*)pData->tim);
-        fprintf(stderr,"pData->ctim=%p, ",(void*)pData->ctim);
-        fprintf(stderr,"does not point to a valid address.\n");
+        PRINT_ERROR("In pushSnapshotInWriter: could not allocate memory for ");
+        fprintf(stderr,"the file names of the snapshot.\n");
+        free(job.fileLocation);
+        free(job.parameters.name_mesh);
         return 0;
     }
+    strncpy(job.fileLocation,fileLocation,lengthName);
+    strncpy(job.parameters.name_mesh,pParameters->name_mesh,lengthName);
 
-    // Update the d0p and d1p variables of the structure pointed by pData
-    if (!iterationInTheLoop)
+    if (booleanForSave)
     {
-        pData->d0p[iterationInTheLoop]=pParameters->iter_told0p;
-        pData->d2p[iterationInTheLoop]=pParameters->iter_told2p;
+        if (!copyMeshStructure(pMesh,&job.mesh))
+        {
+            PRINT_ERROR("In pushSnapshotInWriter: copyMeshStructure ");
+            fprintf(stderr,"function returned zero instead of one.\n");
+            free(job.fileLocation);
+            free(job.parameters.name_mesh);
+            return 0;
+        }
+    }
 
-//        if (pParameters->opt_mode>0)
-//        {
-//            pData->d2p[iterationInTheLoop]=pData->d1p[iterationInTheLoop];
-//        }
-//        else
-//        {
-//            pData->d2p[iterationInTheLoop]=pData->d0p[iterationInTheLoop];
-//        }
+    // Wait for a free slot in the queue and check previous errors
+    pthread_mutex_lock(&pWriter->mutex);
+    while (pWriter->count==pWriter->capacity && !pWriter->error)
+    {
+        pthread_cond_wait(&pWriter->notFull,&pWriter->mutex);
     }
-    else
+    booleanError=pWriter->error;
+    pWriter->error=0;
+    if (!booleanError)
     {
-        pData->d0p[iterationInTheLoop]=DEF_ABS(pData->pnu[iterationInTheLoop]
-                                             -pData->pnu[iterationInTheLoop-1]);
-        if (pParameters->opt_mode>0)
-        {
-            pData->d2p[iterationInTheLoop]=
-                                          DEF_ABS(pData->d1p[iterationInTheLoop]
-                                             -pData->d1p[iterationInTheLoop-1]);
-        }
-        else
-        {
-            pData->d2p[iterationInTheLoop]=
-                                          DEF_ABS(pData->d0p[iterationInTheLoop]
-                                             -pData->d0p[iterationInTheLoop-1]);
-        }
+        iJob=(pWriter->head+pWriter->count)%pWriter->capacity;
+        pWriter->pjob[iJob]=job;
+        pWriter->count++;
+        pWriter->pending++;
+        pthread_cond_signal(&pWriter->notEmpty);
     }
+    pthread_mutex_unlock(&pWriter->mutex);
 
-    // Save the mesh in case of crash. Important remark: since saveDataInTheLoop
-    // will be placed at the end of the optimization loop, the mesh saved
-    // correspond in fact to the (iterationInTheLoop+1) one in the loop (an
-    // *.0.mesh file is automatically saved at initialization). Hence, if the
-    // program crash, a mesh will be there, and if it do not crash, it will be
-    // deleted at the next iteration by this function (see below) except of
-    // course if the saving options stored in pParameters->save_print is
-    // positive and a multiple of the iterationInTheLoop variable
-    if (!saveOrRemoveMeshInTheLoop(pParameters,pMesh,pChemicalSystem,1,
-                                                            iterationInTheLoop))
+    if (booleanError)
     {
-        PRINT_ERROR("In saveDataInTheLoop: saveOrRemoveMeshInTheLoop ");
-        fprintf(stderr,"function returned zero instead of one.\n");
+        PRINT_ERROR("In pushSnapshotInWriter: the background writer failed ");
+        fprintf(stderr,"to save or remove a previous snapshot.\n");
+        freeMeshMemory(&job.mesh);
+        free(job.fileLocation);
+        free(job.parameters.name_mesh);
         return 0;
     }
 
-    // Delete the mesh of the previous iteration if not specified in pParameters
-    if (iterationInTheLoop>1)
+    // The background writer prints nothing so the main thread reports here
+    if (booleanForSave)
     {
-        if (pParameters->save_mesh<=0)
-        {
-            if (!saveOrRemoveMeshInTheLoop(pParameters,pMesh,pChemicalSystem,0,
-                                                          iterationInTheLoop-1))
-            {
-                PRINT_ERROR("In saveDataInTheLoop: ");
-                fprintf(stderr,"saveOrRemoverMeshInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
-        }
-        else
-        {
-            if ((iterationInTheLoop-1)%pParameters->save_mesh)
-            {
-                if (!saveOrRemoveMeshInTheLoop(pParameters,pMesh,
-                                               pChemicalSystem,0,
-                                                          iterationInTheLoop-1))
-                {
-                    PRINT_ERROR("In saveDataInTheLoop: ");
-                    fprintf(stderr,"saveOrRemoverMeshInTheLoop function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
-                }
-            }
-        }
+        fprintf(stdout,"\nSnapshot %s queued for writing.\n",fileLocation);
     }
 
-    // Check the pParameters->name_data variable
-    if (!checkStringFromLength(pParameters->name_data,7,
-                                                      pParameters->name_length))
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function waitForSnapshotWriter is a barrier: it waits until all the
+// snapshots queued in the SnapshotWriter structure have been written. It has
+// the SnapshotWriter* variable (defined in main.h) as input argument and it
+// returns one on success, otherwise zero if one snapshot could not be written
+/* ************************************************************************** */
+int waitForSnapshotWriter(SnapshotWriter* pWriter)
+{
+    int booleanError=0;
+
+    if (pWriter==NULL || !pWriter->active)
     {
-        PRINT_ERROR("In saveDataInTheLoop: checkStringFromLength function ");
-        fprintf(stderr,"returned zero, which is not the expected value here, ");
-        fprintf(stderr,"after having checked that the charù name_data ");
-        fprintf(stderr,"variable of the structure pointed by pParameters is ");
-        fprintf(stderr,"not a string of length (strictly) less than ");
-        fprintf(stderr,"%d (and more than 5 ",pParameters->name_length);
-        fprintf(stderr,"in order to store at least something more ");
-        fprintf(stderr,"than the *.data extension).\n");
-        return 0;
+        return 1;
     }
 
-    // Check the total number of electrons
-    if (pChemicalSystem->nmorb<1)
+    pthread_mutex_lock(&pWriter->mutex);
+    while (pWriter->pending)
     {
-        PRINT_ERROR("In saveDataInTheLoop: the total number of electrons ");
-        fprintf(stderr,"(=%d) in the chemical system ",pChemicalSystem->nmorb);
-        fprintf(stderr,"should be a positive integer.\n");
-        return 0;
+        pthread_cond_wait(&pWriter->allDone,&pWriter->mutex);
     }
-    // Check the number of electrons
-    if (pParameters->nu_electrons<1 ||
-                               pParameters->nu_electrons>pChemicalSystem->nmorb)
+    booleanError=pWriter->error;
+    pWriter->error=0;
+    pthread_mutex_unlock(&pWriter->mutex);
+
+    if (booleanError)
     {
-        PRINT_ERROR("In saveDataInTheLoop: the number ");
-        fprintf(stderr,"nu=%d of electrons we are ",pParameters->nu_electrons);
-        fprintf(stderr,"looking for should be a positive integer not ");
-        fprintf(stderr,"(strictly) greater than the total number of ");
-        fprintf(stderr,"electrons (=%d) in the ",pChemicalSystem->nmorb);
-        fprintf(stderr,"chemical system.\n");
+        PRINT_ERROR("In waitForSnapshotWriter: the background writer failed ");
+        fprintf(stderr,"to save or remove at least one snapshot.\n");
         return 0;
     }
 
-    // Check if the *.data name ends with the ".data" extension
-    // strlen returns the length of the string, but not including the char '\0'
-    lengthName=strlen(pParameters->name_data);
-    if (pParameters->name_data[lengthName-5]!='.' ||
-                                    pParameters->name_data[lengthName-4]!='d' ||
-                                    pParameters->name_data[lengthName-3]!='a' ||
-                                    pParameters->name_data[lengthName-2]!='t' ||
-                                    pParameters->name_data[lengthName-1]!='a' ||
-                                       pParameters->name_data[lengthName]!='\0')
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function stopSnapshotWriter waits until all the queued snapshots have
+// been written, ends the background thread, and frees the memory of the
+// SnapshotWriter structure. It has the SnapshotWriter* variable (defined in
+// main.h) as input argument and it returns one on success, otherwise zero if
+// one snapshot could not be written
+/* ************************************************************************** */
+int stopSnapshotWriter(SnapshotWriter* pWriter)
+{
+    int returnValue=0;
+
+    if (pWriter==NULL || !pWriter->active)
     {
-        PRINT_ERROR("In saveDataInTheLoop: ");
-        fprintf(stderr,"%s file name does not end ",pParameters->name_data);
-        fprintf(stderr,"with the '.data' extension.\n");
-        return 0;
+        return 1;
     }
 
-    // Update the tim and ctim variables of the structure pointed by pData
-    time(pEndLocalTimer);
-    pData->tim[iterationInTheLoop]=difftime(*pEndLocalTimer,*pStartLocalTimer);
-    pData->ctim[iterationInTheLoop]=
-                                 difftime(*pEndLocalTimer,*pGlobalInitialTimer);
+    returnValue=waitForSnapshotWriter(pWriter);
 
-    if (pParameters->save_data>0)
-    {
-        if (iterationInTheLoop%pParameters->save_data==0)
-        {
-            // Opening *.data file (append file if already exists otherwise
-            // created) fopen returns a FILE pointer on success, otherwise NULL
-            fprintf(stdout,"\nOpening %s file. ",pParameters->name_data);
-            dataFile=fopen(pParameters->name_data,"a");
-            if (dataFile==NULL)
-            {
-                PRINT_ERROR("In saveDataInTheLoop: could not open and append ");
-                fprintf(stderr,"in %s file.\n",pParameters->name_data);
-                return 0;
-            }
-            fprintf(stdout,"Appending data. ");
+    pthread_mutex_lock(&pWriter->mutex);
+    pWriter->stop=1;
+    pthread_cond_broadcast(&pWriter->notEmpty);
+    pthread_mutex_unlock(&pWriter->mutex);
 
-            if (!iterationInTheLoop)
-            {
-                fprintf(dataFile,"\n\n%sMaximizing the ",endTimerAtError());
-                fprintf(dataFile,"probability to find ");
-                fprintf(dataFile,"%d electrons ",pParameters->nu_electrons);
-                fprintf(dataFile,"inside the domain and ");
-                fprintf(dataFile,"%d",
-                              pChemicalSystem->nmorb-pParameters->nu_electrons);
-                fprintf(dataFile," outside.\n\nIter. Prob. Pop. Dprob. Res. ");
-                if (pParameters->opt_mode>0)
-                {
-                     fprintf(dataFile,"Dres. ");
-                }
-                else
-                {
-                    fprintf(dataFile,"D2prob. ");
-                }
-                fprintf(dataFile,"Time (in min.) Cumulated time (in min.)\n\n");
-            }
+    pthread_join(pWriter->thread,NULL);
+    pthread_cond_destroy(&pWriter->allDone);
+    pthread_cond_destroy(&pWriter->notFull);
+    pthread_cond_destroy(&pWriter->notEmpty);
+    pthread_mutex_destroy(&pWriter->mutex);
+    free(pWriter->pjob);
+    pWriter->pjob=NULL;
+    pWriter->active=0;
 
-            fprintf(dataFile,"%d ",iterationInTheLoop);
-            fprintf(dataFile,"%.8lf ",pData->pnu[iterationInTheLoop]);
-            fprintf(dataFile,"%.8lf ",pData->pop[iterationInTheLoop]);
-            fprintf(dataFile,"%.8le ",pData->d0p[iterationInTheLoop]);
-            fprintf(dataFile,"%.8le ",pData->d1p[iterationInTheLoop]);
-            fprintf(dataFile,"%.8le ",pData->d2p[iterationInTheLoop]);
-            fprintf(dataFile,"%.2lf ",pData->tim[iterationInTheLoop]/60.);
-            fprintf(dataFile,"%.2lf \n",pData->ctim[iterationInTheLoop]/60.);
+    return returnValue;
+}
 
-            // Closing the *.data file: fclose returns zero if the input FILE*
-            // variable is successfully closed, otherwise EOF (end-of-file)
-            if (fclose(dataFile))
-            {
-                PRINT_ERROR("In saveDataInTheLoop: the ");
-                fprintf(stderr,"%s file has not been ",pParameters->name_data);
-                fprintf(stderr,"closed properly.\n");
-                dataFile=NULL;
-                return 0;
-            }
-            dataFile=NULL;
-            fprintf(stdout,"Closing file.\n");
-        }
+/* ************************************************************************** */
+// The function waitForSnapshotWriterAtSignal is the barrier used when a signal
+// is caught (commentAnormalEnd function). Since the mutex may be held by the
+// interrupted thread, it never blocks on it: it reads the pending variable
+// under the mutex only if pthread_mutex_trylock acquires it (a busy mutex
+// counts as a pending snapshot), for at most SNAPSHOT_SIGNAL_WAIT periods of
+// ten milliseconds (nothing is done if the signal was raised in the writer
+// thread itself) and then deactivates the SnapshotWriter structure so that the
+// exit process does not wait for it anymore. It has the SnapshotWriter*
+// variable (defined in main.h) as input argument and it does not return any
+// value (void output)
+/* ************************************************************************** */
+void waitForSnapshotWriterAtSignal(SnapshotWriter* pWriter)
+{
+    int i=0, pending=1;
+    struct timespec waitingTime;
+
+    if (pWriter==NULL || !pWriter->active)
+    {
+        return;
     }
-    else
+
+    if (!pthread_equal(pthread_self(),pWriter->thread))
     {
-        if (!iterationInTheLoop)
+        waitingTime.tv_sec=0;
+        waitingTime.tv_nsec=10000000;
+        for (i=0; i<SNAPSHOT_SIGNAL_WAIT; i++)
         {
-            fprintf(stdout,"\nOpening %s file. ",pParameters->name_data);
-            dataFile=fopen(pParameters->name_data,"a");
-            if (dataFile==NULL)
-            {
-                PRINT_ERROR("In saveDataInTheLoop: could not open and append ");
-                fprintf(stderr,"in %s file.\n",pParameters->name_data);
-                return 0;
-            }
-            fprintf(stdout,"Appending data. ");
-
-            fprintf(dataFile,"\n\n%sMaximizing the ",endTimerAtError());
-            fprintf(dataFile,"probability to find ");
-            fprintf(dataFile,"%d electrons ",pParameters->nu_electrons);
-            fprintf(dataFile,"inside the domain and ");
-            fprintf(dataFile,"%d",
-                              pChemicalSystem->nmorb-pParameters->nu_electrons);
-            fprintf(dataFile," outside.\n\nIter. Prob. Pop. Dprob. Res. ");
-            if (pParameters->opt_mode>0)
-            {
-                 fprintf(dataFile,"Dres. ");
-            }
-            else
+            // pthread_mutex_trylock returns zero if the mutex is acquired
+            if (!pthread_mutex_trylock(&pWriter->mutex))
             {
-                fprintf(dataFile,"D2prob. ");
+                pending=pWriter->pending;
+                pthread_mutex_unlock(&pWriter->mutex);
             }
-            fprintf(dataFile,"Time (in sec.) Cumulated time (in sec.)\n\n");
-
-            fprintf(dataFile,"%d ",iterationInTheLoop);
-            fprintf(dataFile,"%.8lf ",pData->pnu[iterationInTheLoop]);
-            fprintf(dataFile,"%.8lf ",pData->pop[iterationInTheLoop]);
-            fprintf(dataFile,"%.8le ",pData->d0p[iterationInTheLoop]);
-            fprintf(dataFile,"%.8le ",pData->d1p[iterationInTheLoop]);
-            fprintf(dataFile,"%.8le ",pData->d2p[iterationInTheLoop]);
-            fprintf(dataFile,"%d ",(int)pData->tim[iterationInTheLoop]);
-            fprintf(dataFile,"%d \n",(int)pData->ctim[iterationInTheLoop]);
-
-            if (fclose(dataFile))
+            if (!pending)
             {
-                PRINT_ERROR("In saveDataInTheLoop: the ");
-                fprintf(stderr,"%s file has not been ",pParameters->name_data);
-                fprintf(stderr,"closed properly.\n");
-                dataFile=NULL;
-                return 0;
+                break;
             }
-            dataFile=NULL;
-            fprintf(stdout,"Closing file.\n");
+            nanosleep(&waitingTime,NULL);
         }
     }
+    pWriter->active=0;
 
-    // At the end of the optimization loop, we keep track of iterationInTheLoop
-    // thanks to the pData->niter
-    pData->niter++;
-
-    return 1;
+    return;
 }
 
-
 /* ************************************************************************** */
-// The function setupInitialData successively allocates memory for the structure
-// pointed by pData i.e. for the saving of data, enlarge of 10 letters the
-// maximal length allowed for path names, reallocates the memory accordingly
-// in the structure pointed by pParameters, write an *.restart file restating
-// all the parameters used (default ones and those prescribed by the user in
-// the *.info file, the name being similar but where the '.info' extension is
-// replaced by the '.restart one), compute all the quantities
-// (probability, ...), save them in the *.data file given by the
-// pParameters->name_data variable, and save also the mesh in a *.0.mesh file.
-// It allows the user to always keep track of all the parameters with the
-// *.info file, always get the initial mesh saved before the optimization loop,
-// and terminates the setting up of the initialization process of the MPD
-// algorithm. It has the Parameters*, Mesh*, Data*, ChemicalSystem* structures
-// (both defined in main.h) as input arguments, and also the three time_t*
-// variables (pGlobalInitialTimer, pStartLocalTimer, pEndLocalTimer) that are
-// used to compute the execution time of the initialization and the one needed
-// for both loading the data, and initialize them. The function returns one on
-// success, otherwise zero is returned if an error is encountered in the process
+// The function saveOrRemoveMeshInTheLoop is used in the optimization loop
+// to either save the mesh in the *.mesh and/or *.cube/*.obj format according to
+// the pParameters->save_type and iterationInTheLoop variables, or remove the
+// *.(iterationInTheLoop).mesh file if it already exists, depending if the
+// booleanForSave input variable is set to one or zero. The file operations are
+// handed over to the background writer thread (globalSnapshotWriter) with an
+// immutable copy of the mesh if it has been started, otherwise they are
+// performed here by the writingSnapshotFiles function. For tetrahedral meshes,
+// the current *.mesh file (pParameters->name_mesh) is always written here since
+// it is then read by the external softwares. We recall that the *.cube format
+// requires the charge and center coordinates of the nuclei associated with the
+// chemical system. The function has the Parameters*, Mesh*, ChemicalSystem*
+// (both defined in main.h) and the integer variable iterationInTheLoop as
+// input arguments. It returns one one success, otherwise zero is returned if
+// an error is encountered during the process
 /* ************************************************************************** */
-int setupInitialData(Parameters* pParameters, Mesh* pMesh, Data* pData,
-                     ChemicalSystem* pChemicalSystem,
-                     time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
-                                                         time_t* pEndLocalTimer)
+int saveOrRemoveMeshInTheLoop(Parameters* pParameters, Mesh* pMesh,
+                              ChemicalSystem* pChemicalSystem,
+                                     int booleanForSave, int iterationInTheLoop)
 {
+    int booleanForCurrent=0, returnValue=0;
+    size_t lengthName=0;
+    char *fileLocation=NULL;
+
     // Check the input pointers
-    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
-                           pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
-                                 pStartLocalTimer==NULL || pEndLocalTimer==NULL)
+    if (pParameters==NULL || pMesh==NULL || pChemicalSystem==NULL)
     {
-        PRINT_ERROR("In setupInitialData: one of the input pointers ");
-        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
-        fprintf(stderr,"pData=%p, pMesh=%p, ",(void*)pMesh,(void*)pData);
-        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
-        fprintf(stderr,"pGlobalInitialTimer=%p, ",(void*)pGlobalInitialTimer);
-        fprintf(stderr,"pStartLocalTimer=%p or ",(void*)pStartLocalTimer);
-        fprintf(stderr,"pEndLocalTimer=%p, ",(void*)pEndLocalTimer);
+        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: at least one of the input ");
+        fprintf(stderr,"variables (pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, ",(void*)pMesh);
+        fprintf(stderr,"pChemicalSystem=%p) ",(void*)pChemicalSystem);
         fprintf(stderr,"does not point to a valid address.\n");
         return 0;
     }
 
-    // Allocate memory for the saving of data
-    if (!allocateMemoryForData(pParameters,pData,pChemicalSystem))
+    // Check pParameters->name_mesh variable (the file itself may not exist yet
+    // if its writing is still queued in the background writer)
+    if (!checkStringFromLength(pParameters->name_mesh,7,
+                                                      pParameters->name_length))
     {
-        PRINT_ERROR("In setupInitialData: allocateMemoryForData function ");
-        fprintf(stderr,"returned zero instead of one.\n");
+        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: checkStringFromLength ");
+        fprintf(stderr,"function returned zero, which is not the expected ");
+        fprintf(stderr,"value here.\n");
         return 0;
     }
-
-    // Check we can add 10 letters to the file names for the saving of meshes
-    if (!addLengthForFileName(pParameters,10))
+    lengthName=strlen(pParameters->name_mesh);
+    if (strcmp(pParameters->name_mesh+lengthName-5,".mesh"))
     {
-        PRINT_ERROR("In setupInitialData: addLengthForFileName function ");
-        fprintf(stderr,"returned zero instead of one.\n");
+        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: ");
+        fprintf(stderr,"%s file name does not end ",pParameters->name_mesh);
+        fprintf(stderr,"with the '.mesh' extension.\n");
         return 0;
     }
 
-    // Write the *.restart file before starting the optimization loop
-    if (!writingRestartFile(pParameters))
+    if (booleanForSave)
     {
-        PRINT_ERROR("In setupInitialData: writingRestartFile function ");
-        fprintf(stderr,"returned zero instead of one.\n");
-        return 0;
+        if (pParameters->opt_mode>0)
+        {
+            // Saving the mesh discretization in the current *.mesh file
+            if (!writingMeshFile(pParameters,pMesh))
+            {
+                PRINT_ERROR("In saveOrRemoveMeshInTheLoop: writingMeshFile ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+        }
+        else
+        {
+            booleanForCurrent=1;
+        }
     }
 
-    // Compute the overlap matrix, probability, shape gradient, and residual
-    // for the initial domain
-    if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,0))
+    // strlen returns the length of the string without the terminating '\0'
+    if ((int)lengthName>pParameters->name_length-11)
     {
-        PRINT_ERROR("In setupInitialData: shapeDerivative function returned ");
-        fprintf(stderr,"zero instead of one.\n");
+        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: the maximal size ");
+        fprintf(stderr,"(=%d) allocated for the ",pParameters->name_length-11);
+        fprintf(stderr,"names has not been increased from ten.\n");
         return 0;
     }
 
-    // Save initial data and mesh
-    if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,0,
-                           pGlobalInitialTimer,pStartLocalTimer,pEndLocalTimer))
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    lengthName=pParameters->name_length;
+    fileLocation=(char*)calloc(lengthName,sizeof(char));
+    if (fileLocation==NULL)
     {
-        PRINT_ERROR("In setupInitialData: saveDataInTheLoop function ");
-        fprintf(stderr,"returned zero instead of one.\n");
+        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: could not allocate memory ");
+        fprintf(stderr,"for the local char* fileLocation variable.\n");
         return 0;
     }
 
-    return 1;
-}
-
-/* ************************************************************************** */
-// The function exhaustiveSearchAlgorithm computes the pParameters->opt_mode=-2
-// of the optimization function. It tries to add or remove the hexahedra that
-// are touching the boundary of the domain. Only those increasing the
-// probability are retained. It has the Parameters*, Mesh*, Data*,
-// ChemicalSystem* (both defined in main.h) and the int iterationInTheLoop
-// variables as input arguments. It returns one on success otherwise zero
+    // sprintf returns the total number of characters written is returned
+    // not including the char '\0', otherwise a negative number on failure
+    lengthName=strlen(pParameters->name_mesh);
+    pParameters->name_mesh[lengthName-5]='\0';
+    if (sprintf(fileLocation,"%s.%d.mesh",pParameters->name_mesh,
+                                                          iterationInTheLoop)<0)
+    {
+        PRINT_ERROR("In saveOrRemoveMeshInTheLoop: the standard sprintf ");
+        fprintf(stderr,"c-function returned an unexpected negative ");
+        fprintf(stderr,"value, while attempting to save the mesh at the ");
+        fprintf(stderr,"%d-th iteration of the ",iterationInTheLoop);
+        fprintf(stderr,"optimization loop.\n");
+        pParameters->name_mesh[lengthName-5]='.';
+        free(fileLocation);    // free function does not return any value
+        fileLocation=NULL;
+        return 0;
+    }
+    pParameters->name_mesh[lengthName-5]='.';
+
+    // Hand over the snapshot to the background writer (if started)
+    if (globalSnapshotWriter.active)
+    {
+        returnValue=pushSnapshotInWriter(&globalSnapshotWriter,pParameters,
+                                                          pMesh,pChemicalSystem,
+                                                    fileLocation,booleanForSave,
+                                                             booleanForCurrent);
+        if (!returnValue)
+        {
+            PRINT_ERROR("In saveOrRemoveMeshInTheLoop: pushSnapshotInWriter ");
+            fprintf(stderr,"function returned zero instead of one.\n");
+        }
+    }
+    else
+    {
+        returnValue=writingSnapshotFiles(pParameters,pMesh,pChemicalSystem,
+                                                    fileLocation,booleanForSave,
+                                                             booleanForCurrent);
+        if (!returnValue)
+        {
+            PRINT_ERROR("In saveOrRemoveMeshInTheLoop: writingSnapshotFiles ");
+            fprintf(stderr,"function returned zero instead of one.\n");
+        }
+    }
+
+    // Free the memory allocated for fileLocation
+    free(fileLocation);
+    fileLocation=NULL;
+
+    return returnValue;
+}
+
 /* ************************************************************************** */
-int exhaustiveSearchAlgorithm(Parameters* pParameters, Mesh* pMesh,
-                               Data* pData, ChemicalSystem* pChemicalSystem,
-                                                         int iterationInTheLoop)
+// The function writingHistoryFile appends the (iterationInTheLoop)-th record in
+// the *.hist history file associated with pParameters->name_mesh (the '.mesh'
+// extension is replaced by the '.hist' one). It is only used for hexahedral
+// meshes (pParameters->save_type=3) where the grid never changes: the header
+// (grid discretization and nuclei) is written once when iterationInTheLoop is
+// zero (the file is then reset), and each record stores the data computed at
+// this iteration followed by the labels of the hexahedra encoded as a list of
+// (label, length) runs. It has the Parameters*, Mesh*, Data*, ChemicalSystem*
+// (defined in main.h) and the int iterationInTheLoop variables as input
+// arguments. It returns one on success, otherwise zero
+/* ************************************************************************** */
+int writingHistoryFile(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                       ChemicalSystem* pChemicalSystem, int iterationInTheLoop)
 {
-    int i=0, j=0, k=0, kHexahedron=0, l=0, lI=0, lJ=0, nHex=0, nAdj=0, nMorb=0;
-    int nGauss=0, sizeMemory=0, lPrint=0;
-    double integral=0., *pCoefficient=NULL, *pProbabilityOld=NULL;
-    double *pProbability=NULL, probability=0.;
-    MolecularOrbital *pMolecularOrbitalI=NULL, *pMolecularOrbitalJ=NULL;
-    OverlapMatrix *pOverlapMatrix=NULL, *pOverlapMatrixOld=NULL;
+    size_t lengthName=0, counter=0, expected=0;
+    int i=0, iMax=0, nRuns=0, *pRuns=NULL, pInteger[8]={0};
+    long offset=0;
+    double pDouble[7]={0.};
+    char *fileLocation=NULL;
+    FILE *historyFile=NULL;
 
-    // Check input pointers
+    // Time the writing of the history file in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_IO);
+
+    // Check the input pointers
     if (pParameters==NULL || pMesh==NULL || pData==NULL ||
-                                                          pChemicalSystem==NULL)
+                                                         pChemicalSystem==NULL)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: at least one of the ");
-        fprintf(stderr,"input variables pParameters=%p, ",(void*)pParameters);
+        PRINT_ERROR("In writingHistoryFile: at least one of the input ");
+        fprintf(stderr,"variables (pParameters=%p, ",(void*)pParameters);
         fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
-        fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
+        fprintf(stderr,"pChemicalSystem=%p) ",(void*)pChemicalSystem);
         fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    // Check the iterationInTheLoopVariable variable
-    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    // Check that the mesh is the hexahedral grid of pParameters
+    iMax=(pParameters->n_x-1)*(pParameters->n_y-1)*(pParameters->n_z-1);
+    if (pParameters->opt_mode>0 || pMesh->phex==NULL || pMesh->nhex!=iMax ||
+                                                      pChemicalSystem->nnucl<1)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the input ");
-        fprintf(stderr,"iterationInTheLoop variable (=%d) ",iterationInTheLoop);
-        fprintf(stderr,"should be a positive integer not (strictly) ");
-        fprintf(stderr,"greater than the maximal number of allowed ");
-        fprintf(stderr,"iterations (=%d).\n",pParameters->iter_max);
+        PRINT_ERROR("In writingHistoryFile: expecting a hexahedral mesh ");
+        fprintf(stderr,"(opt_mode=%d not positive) ",pParameters->opt_mode);
+        fprintf(stderr,"made of %d hexahedra instead of ",iMax);
+        fprintf(stderr,"%d (phex=%p) ",pMesh->nhex,(void*)pMesh->phex);
+        fprintf(stderr,"and a positive number of nuclei ");
+        fprintf(stderr,"(=%d).\n",pChemicalSystem->nnucl);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    // Check that we are dealing with the right optimization mode
-    if (pParameters->opt_mode!=-2)
+    // Build the *.hist file name from the *.mesh one
+    if (!checkStringFromLength(pParameters->name_mesh,7,
+                                                      pParameters->name_length))
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the function can only be ");
-        fprintf(stderr,"used when the optimization mode ");
-        fprintf(stderr,"(=%d) is set to minus two.\n",pParameters->opt_mode);
+        PRINT_ERROR("In writingHistoryFile: checkStringFromLength function ");
+        fprintf(stderr,"returned zero, which is not the expected value ");
+        fprintf(stderr,"here.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
-
-    // Check the number of hexahedra and its associated pointer
-    nHex=pMesh->nhex;
-    if (nHex<1)
+    lengthName=strlen(pParameters->name_mesh);
+    if (strcmp(pParameters->name_mesh+lengthName-5,".mesh"))
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
-        fprintf(stderr,"hexahedra (=%d) in the structure pointed ",nHex);
-        fprintf(stderr,"by pMesh should be a positive integer.\n");
+        PRINT_ERROR("In writingHistoryFile: ");
+        fprintf(stderr,"%s file name does not end ",pParameters->name_mesh);
+        fprintf(stderr,"with the '.mesh' extension.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    if (pMesh->phex==NULL)
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    fileLocation=(char*)calloc(pParameters->name_length,sizeof(char));
+    pRuns=(int*)calloc(2*iMax,sizeof(int));
+    if (fileLocation==NULL || pRuns==NULL)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the structure pointed by ");
-        fprintf(stderr,"pMesh does not store any hexahedra ");
-        fprintf(stderr,"(pMesh->phex=%p).\n",(void*)pMesh->phex);
+        PRINT_ERROR("In writingHistoryFile: could not allocate memory for ");
+        fprintf(stderr,"the local fileLocation and pRuns variables.\n");
+        free(fileLocation);
+        free(pRuns);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
+    strncpy(fileLocation,pParameters->name_mesh,pParameters->name_length);
+    strcpy(fileLocation+lengthName-5,".hist");
 
-    // Check the number of boundary quadrilaterals and its associated pointer
-    nAdj=pMesh->nadj;
-    if (nAdj<1)
+    // Encode the labels of the hexahedra as (label, length) runs
+    nRuns=0;
+    for (i=0; i<iMax; i++)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
-        fprintf(stderr,"Adjacency structures (=%d) in the structure ",nAdj);
-        fprintf(stderr,"pointed by pMesh should be a positive integer.\n");
-        return 0;
+        if (nRuns && pRuns[2*nRuns-2]==pMesh->phex[i].label)
+        {
+            pRuns[2*nRuns-1]++;
+        }
+        else
+        {
+            pRuns[2*nRuns]=pMesh->phex[i].label;
+            pRuns[2*nRuns+1]=1;
+            nRuns++;
+        }
     }
 
-    if (pMesh->padj==NULL)
+    // Reset the file at initialization, otherwise append the new record
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    if (!iterationInTheLoop)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the structure pointed by ");
-        fprintf(stderr,"pMesh does not store any Adjacency structures ");
-        fprintf(stderr,"(pMesh->padj=%p).\n",(void*)pMesh->padj);
-        return 0;
+        historyFile=fopen(fileLocation,"wb");
     }
-
-    // Check the chemical parameters
-    nMorb=pChemicalSystem->nmorb;
-    if (nMorb<1)
+    else
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
-        fprintf(stderr,"molecular orbitals (=%d) should be a positive ",nMorb);
-        fprintf(stderr,"integer.\n");
-        return 0;
+        historyFile=fopen(fileLocation,"ab");
     }
-
-    if (pChemicalSystem->pmorb==NULL)
+    if (historyFile==NULL)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pmorb variable of ");
-        fprintf(stderr,"the structure pointed by pChemicalSystem is pointing ");
-        fprintf(stderr,"to the %p address.\n",(void*)pChemicalSystem->pmorb);
+        PRINT_ERROR("In writingHistoryFile: could not open and write in the ");
+        fprintf(stderr,"%s file.\n",fileLocation);
+        free(fileLocation);
+        free(pRuns);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    nGauss=pChemicalSystem->ngauss;
-    if (nGauss<1)
+    // Save the size of the file before appending so that the profiler only
+    // counts the bytes written by this call (fseek returns zero on success)
+    if (!fseek(historyFile,0L,SEEK_END))
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
-        fprintf(stderr,"Gaussian-type primitives (=%d) should be a ",nGauss);
-        fprintf(stderr,"positive integer.\n");
-        return 0;
+        offset=ftell(historyFile);
     }
 
-    if (pParameters->orb_rhf)
+    // fwrite returns the number of elements successfully written
+    counter=0;
+    expected=0;
+    if (!iterationInTheLoop)
     {
-        if (nMorb%2!=0)
+        fprintf(stdout,"Writing grid data. ");
+        counter+=fwrite(HIST_MAGIC,sizeof(char),8,historyFile);
+        pInteger[0]=HIST_VERSION;
+        pInteger[1]=pParameters->n_x;
+        pInteger[2]=pParameters->n_y;
+        pInteger[3]=pParameters->n_z;
+        pInteger[4]=pChemicalSystem->nnucl;
+        pInteger[5]=pParameters->nu_electrons;
+        pInteger[6]=pChemicalSystem->nmorb;
+        pInteger[7]=0;
+        counter+=fwrite(pInteger,sizeof(int),8,historyFile);
+        pDouble[0]=pParameters->x_min;
+        pDouble[1]=pParameters->y_min;
+        pDouble[2]=pParameters->z_min;
+        pDouble[3]=pParameters->delta_x;
+        pDouble[4]=pParameters->delta_y;
+        pDouble[5]=pParameters->delta_z;
+        counter+=fwrite(pDouble,sizeof(double),6,historyFile);
+        expected+=22;
+        for (i=0; i<pChemicalSystem->nnucl; i++)
         {
-            PRINT_ERROR("In exhaustiveSearchAlgorithm: since we are dealing ");
-            fprintf(stderr,"with a restricted Hartree-Fock system ");
-            fprintf(stderr,"(pParameters->orb_rhf=%d) ",pParameters->orb_rhf);
-            fprintf(stderr,"the total number of molecular orbitals ");
-            fprintf(stderr," (=%d) should be an even number.\n",nMorb);
-            return 0;
+            pInteger[0]=pChemicalSystem->pnucl[i].charge;
+            pInteger[1]=0;
+            pDouble[0]=pChemicalSystem->pnucl[i].x;
+            pDouble[1]=pChemicalSystem->pnucl[i].y;
+            pDouble[2]=pChemicalSystem->pnucl[i].z;
+            counter+=fwrite(pInteger,sizeof(int),2,historyFile);
+            counter+=fwrite(pDouble,sizeof(double),3,historyFile);
+            expected+=5;
         }
     }
 
-    // Check the size of the overlap matrix and its associated pointer
-    if (pData->nmat!=nMorb)
-    {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the size of the ");
-        fprintf(stderr,"overlap matrix should be (%d)x(%d) ",nMorb,nMorb);
-        fprintf(stderr,"instead of (%d)x(%d).\n",pData->nmat,pData->nmat);
+    fprintf(stdout,"Appending record. ");
+    pInteger[0]=iterationInTheLoop;
+    pInteger[1]=pParameters->opt_mode;
+    pInteger[2]=nRuns;
+    pInteger[3]=0;
+    pDouble[0]=pData->pnu[iterationInTheLoop];
+    pDouble[1]=pData->pop[iterationInTheLoop];
+    pDouble[2]=pData->d0p[iterationInTheLoop];
+    pDouble[3]=pData->d1p[iterationInTheLoop];
+    pDouble[4]=pData->d2p[iterationInTheLoop];
+    pDouble[5]=pData->tim[iterationInTheLoop];
+    pDouble[6]=pData->ctim[iterationInTheLoop];
+    counter+=fwrite(pInteger,sizeof(int),4,historyFile);
+    counter+=fwrite(pDouble,sizeof(double),7,historyFile);
+    counter+=fwrite(pRuns,sizeof(int),2*nRuns,historyFile);
+    expected+=11+2*nRuns;
+
+    free(pRuns);
+    pRuns=NULL;
+
+    // Count the bytes written by this call before closing the file
+    addProfilerBytes(&globalProfiler,0.,(double)(ftell(historyFile)-offset));
+
+    // fclose returns zero if the input FILE* variable is successfully closed
+    if (fclose(historyFile) || counter!=expected)
+    {
+        PRINT_ERROR("In writingHistoryFile: the record of the ");
+        fprintf(stderr,"%d-th iteration could not be ",iterationInTheLoop);
+        fprintf(stderr,"written properly in the %s file.\n",fileLocation);
+        historyFile=NULL;
+        free(fileLocation);
+        fileLocation=NULL;
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
+    historyFile=NULL;
+    fprintf(stdout,"Closing file.\n");
 
-    if (pData->pmat==NULL)
-    {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pmat variable of the ");
-        fprintf(stderr,"structure pointed by pData is pointing to the ");
-        fprintf(stderr,"%p address.\n",(void*)pData->pmat);
-        return 0;
-    }
-    pOverlapMatrix=&pData->pmat[iterationInTheLoop];
-    pOverlapMatrixOld=&pData->pmat[iterationInTheLoop-1];
+    // Free the memory allocated for fileLocation
+    free(fileLocation);
+    fileLocation=NULL;
 
-    // Check the coef pointer variable of pOverlapMatrix and pOverlapMatrixOld
-    if (pOverlapMatrix->coef==NULL)
-    {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the coef variable of the ");
-        fprintf(stderr,"%d-th OverlapMatrix structure ",iterationInTheLoop+1);
-        fprintf(stderr,"is pointing to the %p ",(void*)pOverlapMatrix->coef);
-        fprintf(stderr,"address.\n");
-        return 0;
-    }
+    endProfilerPhase(&globalProfiler,PROF_IO);
 
-    if (pOverlapMatrixOld->coef==NULL)
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function saveDataInTheLoop finishes to evaluate the non-already-computed
+// data at the (iterationInTheLoop)-th iteration of the optimization loop, saves
+// the mesh in a *.(iterationInTheLoop).mesh/ *.(iterationInTheLoop).cube file
+// thanks to the saveOrRemoveMeshInTheLoop function (since saveDataInTheLoop is
+// performed at the end of the optimization loop, this mesh will correspond to
+// the one of the next iteration, thus getting a copy in case of crash), and
+// deletes the *.(iterationInTheLoop-1).mesh/*.(iterationInTheLoop-1).cube
+// previous mesh file except if the pParameters->save_mesh variable is positive
+// and a multiple of (iterationInTheLoop-1). Similarly, if
+// pParameters->save_data is positive and a multiple of iterationInTheLoop,
+// it saves all the calculated values stored in the structure pointed by pData,
+// appending them in the *.data file whose name is stored in the
+// pParameters->name_data variable. It has the Parameters*, Mesh*, Data*,
+// ChemicalSystem* structures (both defined in main.h), the integer
+// iterationInTheLoop as input arguments, and also the three time_t* variables
+// (pGlobalInitialTimer, pStartLocalTimer, pEndLocalTimer) that are used to
+// compute the execution time of one iteration and the cumulated time. The
+// function returns one on success, otherwise zero is returned in case of error
+/* ************************************************************************** */
+int saveDataInTheLoop(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                      ChemicalSystem* pChemicalSystem, int iterationInTheLoop,
+                      time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
+                                                         time_t* pEndLocalTimer)
+{
+    size_t lengthName=0;
+    int boolean=0;
+    long offset=0;
+    FILE *dataFile=NULL;
+
+    // Time the saving of the data in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_IO);
+
+    // Check the input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                           pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
+                                 pStartLocalTimer==NULL || pEndLocalTimer==NULL)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the coef variable of the ");
-        fprintf(stderr,"%d-th OverlapMatrix structure ",iterationInTheLoop);
-        fprintf(stderr,"is pointing to the %p ",(void*)pOverlapMatrixOld->coef);
-        fprintf(stderr,"address.\n");
+        PRINT_ERROR("In saveDataInTheLoop: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pData=%p, pMesh=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pGlobalInitialTimer=%p, ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"pStartLocalTimer=%p or ",(void*)pStartLocalTimer);
+        fprintf(stderr,"pEndLocalTimer=%p, ",(void*)pEndLocalTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    // Check the population pointer
-    if (pData->pop==NULL)
+    // Check the iterationInTheLoop variable
+    if (iterationInTheLoop<0 || iterationInTheLoop>pParameters->iter_max)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pop variable of the ");
-        fprintf(stderr,"structure pointed by pData is pointing to the ");
-        fprintf(stderr,"%p address.\n",(void*)pData->pop);
+        PRINT_ERROR("In saveDataInTheLoop: the input iterationInTheLoop ");
+        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
+        fprintf(stderr,"non-negative integer not (strictly) greater than ");
+        fprintf(stderr,"the maximal number (=%d) ",pParameters->iter_max);
+        fprintf(stderr,"of iterations allowed in the optimizationn loop.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    // Allocate memory for pCoefficient
-    // calloc returns a pointer to the allocated memory, otherwise NULL
-    pCoefficient=(double*)calloc(nMorb*nMorb,sizeof(double));
-    if (pCoefficient==NULL)
+    // Check the pointers variables of the structure pointed by pData
+    if (pData->pnu==NULL || pData->pop==NULL || pData->d0p==NULL ||
+                     pData->d1p==NULL || pData->d2p==NULL || pData->tim==NULL ||
+                                                              pData->ctim==NULL)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: could not allocate memory ");
-        fprintf(stderr,"for the local double* pCoefficient variable.\n");
+        PRINT_ERROR("In saveDataInTheLoop: at least one of the input pointers");
+        fprintf(stderr,"pData->pnu=%p, ",(void*)pData->pnu);
+        fprintf(stderr,"pData->pop=%p, ",(void*)pData->pop);
+        fprintf(stderr,"pData->d0p=%p, ",(void*)pData->d0p);
+        fprintf(stderr,"pData->d1p=%p, ",(void*)pData->d1p);
+        fprintf(stderr,"pData->d2p=%p, ",(void*)pData->d2p);
+        fprintf(stderr,"pData->tim=%p, ",(void*)pData->tim);
+        fprintf(stderr,"pData->ctim=%p, ",(void*)pData->ctim);
+        fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
 
-    // Initializing pCoefficient
-    for (i=0; i<nMorb; i++)
+    // Update the d0p and d1p variables of the structure pointed by pData
+    if (!iterationInTheLoop)
     {
-        for (j=0; j<nMorb; j++)
-        {
-            pCoefficient[i*nMorb+j]=pOverlapMatrixOld->coef[i*nMorb+j];
-            pOverlapMatrix->coef[i*nMorb+j]=0.;
-        }
-    }
+        pData->d0p[iterationInTheLoop]=pParameters->iter_told0p;
+        pData->d2p[iterationInTheLoop]=pParameters->iter_told2p;
 
-    // Set the probability pointers
-    if (pData->pnu==NULL)
-    {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pnu variable of the ");
-        fprintf(stderr,"structure pointed by pData is pointing to the ");
-        fprintf(stderr,"%p address.\n",(void*)pData->pnu);
-        free(pCoefficient);
-        pCoefficient=NULL;
-        return 0;
+//        if (pParameters->opt_mode>0)
+//        {
+//            pData->d2p[iterationInTheLoop]=pData->d1p[iterationInTheLoop];
+//        }
+//        else
+//        {
+//            pData->d2p[iterationInTheLoop]=pData->d0p[iterationInTheLoop];
+//        }
+    }
+    else
+    {
+        pData->d0p[iterationInTheLoop]=DEF_ABS(pData->pnu[iterationInTheLoop]
+                                             -pData->pnu[iterationInTheLoop-1]);
+        if (pParameters->opt_mode>0)
+        {
+            pData->d2p[iterationInTheLoop]=
+                                          DEF_ABS(pData->d1p[iterationInTheLoop]
+                                             -pData->d1p[iterationInTheLoop-1]);
+        }
+        else
+        {
+            pData->d2p[iterationInTheLoop]=
+                                          DEF_ABS(pData->d0p[iterationInTheLoop]
+                                             -pData->d0p[iterationInTheLoop-1]);
+        }
     }
-    pProbabilityOld=&pData->pnu[iterationInTheLoop-1];
-    pProbability=&pData->pnu[iterationInTheLoop];
-    probability=*pProbabilityOld;
-
 
-    fprintf(stdout,"\nModifying exhaustively the internal domain cube by ");
-    fprintf(stdout,"cube.\n");
-    if (!pParameters->verbose)
+    // Save the mesh in case of crash. Important remark: since saveDataInTheLoop
+    // will be placed at the end of the optimization loop, the mesh saved
+    // correspond in fact to the (iterationInTheLoop+1) one in the loop (an
+    // *.0.mesh file is automatically saved at initialization). Hence, if the
+    // program crash, a mesh will be there, and if it do not crash, it will be
+    // deleted at the next iteration by this function (see below) except of
+    // course if the saving options stored in pParameters->save_print is
+    // positive and a multiple of the iterationInTheLoop variable
+    if (!saveOrRemoveMeshInTheLoop(pParameters,pMesh,pChemicalSystem,1,
+                                                            iterationInTheLoop))
     {
-        lPrint=1+nAdj/6;
+        PRINT_ERROR("In saveDataInTheLoop: saveOrRemoveMeshInTheLoop ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
     }
 
-    for (k=0; k<nAdj; k++)
+    // Delete the mesh of the previous iteration if not specified in pParameters
+    if (iterationInTheLoop>1)
     {
-        if (!pParameters->verbose)
+        if (pParameters->save_mesh<=0)
         {
-            if ((k+1)%lPrint==0)
+            if (!saveOrRemoveMeshInTheLoop(pParameters,pMesh,pChemicalSystem,0,
+                                                          iterationInTheLoop-1))
             {
-                fprintf(stdout,"%d %% done.\n",
-                                               (int)(100.*(k+1.)/(double)nAdj));
+                PRINT_ERROR("In saveDataInTheLoop: ");
+                fprintf(stderr,"saveOrRemoverMeshInTheLoop function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                endProfilerPhase(&globalProfiler,PROF_IO);
+                return 0;
             }
         }
-
-        // Try to add kHexahedron to mesh (if not already treated)
-        kHexahedron=pMesh->padj[k].hexout-1;
-
-        if (pMesh->phex[kHexahedron].label!=-3)
+        else
         {
-            // Evaluating S(Omega+kHexahedron)
-            for (i=0; i<nMorb; i++)
+            if ((iterationInTheLoop-1)%pParameters->save_mesh)
             {
-                pMolecularOrbitalI=&pChemicalSystem->pmorb[i];
-
-                // Avoid calculation for restricted Hartree-Fock system
-                if (pParameters->orb_rhf)
+                if (!saveOrRemoveMeshInTheLoop(pParameters,pMesh,
+                                               pChemicalSystem,0,
+                                                          iterationInTheLoop-1))
                 {
-                    if (i>=nMorb/2)
-                    {
-                        continue;
-                    }
+                    PRINT_ERROR("In saveDataInTheLoop: ");
+                    fprintf(stderr,"saveOrRemoverMeshInTheLoop function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    endProfilerPhase(&globalProfiler,PROF_IO);
+                    return 0;
                 }
+            }
+        }
+    }
 
-                for (j=0; j<=i; j++)
-                {
-                    pMolecularOrbitalJ=&pChemicalSystem->pmorb[j];
+    // Check the pParameters->name_data variable
+    if (!checkStringFromLength(pParameters->name_data,7,
+                                                      pParameters->name_length))
+    {
+        PRINT_ERROR("In saveDataInTheLoop: checkStringFromLength function ");
+        fprintf(stderr,"returned zero, which is not the expected value here, ");
+        fprintf(stderr,"after having checked that the charù name_data ");
+        fprintf(stderr,"variable of the structure pointed by pParameters is ");
+        fprintf(stderr,"not a string of length (strictly) less than ");
+        fprintf(stderr,"%d (and more than 5 ",pParameters->name_length);
+        fprintf(stderr,"in order to store at least something more ");
+        fprintf(stderr,"than the *.data extension).\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
 
-                    // Compute the three-dimensional integral analytically
-                    integral=0.;
-                    for (lI=0; lI<nGauss; lI++)
-                    {
-                        for (lJ=0; lJ<nGauss; lJ++)
-                        {
-                            integral+=evaluateTripleIntegralIJ(pParameters,
-                                                             pMesh,
-                                                             pChemicalSystem,
-                                                             pMolecularOrbitalI,
-                                                             pMolecularOrbitalJ,
-                                                             lI,lJ,kHexahedron);
-                        }
-                    }
-                    pOverlapMatrix->coef[i*nMorb+j]=pCoefficient[i*nMorb+j]
-                                                                      +integral;
-                }
-            }
+    // Check the total number of electrons
+    if (pChemicalSystem->nmorb<1)
+    {
+        PRINT_ERROR("In saveDataInTheLoop: the total number of electrons ");
+        fprintf(stderr,"(=%d) in the chemical system ",pChemicalSystem->nmorb);
+        fprintf(stderr,"should be a positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
+    // Check the number of electrons
+    if (pParameters->nu_electrons<1 ||
+                               pParameters->nu_electrons>pChemicalSystem->nmorb)
+    {
+        PRINT_ERROR("In saveDataInTheLoop: the number ");
+        fprintf(stderr,"nu=%d of electrons we are ",pParameters->nu_electrons);
+        fprintf(stderr,"looking for should be a positive integer not ");
+        fprintf(stderr,"(strictly) greater than the total number of ");
+        fprintf(stderr,"electrons (=%d) in the ",pChemicalSystem->nmorb);
+        fprintf(stderr,"chemical system.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
 
-            // Complete using the symmetry of the matrix
-            for (i=0; i<nMorb; i++)
-            {
-                for (j=i+1; j<nMorb; j++)
-                {
-                    pOverlapMatrix->coef[i*nMorb+j]=
-                                                pOverlapMatrix->coef[j*nMorb+i];
-                }
-            }
+    // Check if the *.data name ends with the ".data" extension
+    // strlen returns the length of the string, but not including the char '\0'
+    lengthName=strlen(pParameters->name_data);
+    if (pParameters->name_data[lengthName-5]!='.' ||
+                                    pParameters->name_data[lengthName-4]!='d' ||
+                                    pParameters->name_data[lengthName-3]!='a' ||
+                                    pParameters->name_data[lengthName-2]!='t' ||
+                                    pParameters->name_data[lengthName-1]!='a' ||
+                                       pParameters->name_data[lengthName]!='\0')
+    {
+        PRINT_ERROR("In saveDataInTheLoop: ");
+        fprintf(stderr,"%s file name does not end ",pParameters->name_data);
+        fprintf(stderr,"with the '.data' extension.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
 
-            // Complete matrix in the case of a restricted Hartree-Fock system
-            if (pParameters->orb_rhf)
-            {
-                l=nMorb/2;
-                for (i=0; i<l; i++)
-                {
-                    for (j=0; j<l; j++)
-                    {
-                        pOverlapMatrix->coef[(i+l)*nMorb+(j+l)]=
-                                                pOverlapMatrix->coef[i*nMorb+j];
-                    }
-                }
-            }
+    // Update the tim and ctim variables of the structure pointed by pData
+    time(pEndLocalTimer);
+    pData->tim[iterationInTheLoop]=difftime(*pEndLocalTimer,*pStartLocalTimer);
+    pData->ctim[iterationInTheLoop]=
+                                 difftime(*pEndLocalTimer,*pGlobalInitialTimer);
 
-            // Diagonalize the overlap matrix. Warning here: we use lapacke.h,
-            // and lapacke package must have been previously installed
-            if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
+    // Append the record of the iteration in the *.hist history file (always
+    // saved at initialization, then according to pParameters->save_mesh)
+    if (pParameters->save_type==3)
+    {
+        boolean=(!iterationInTheLoop);
+        if (pParameters->save_mesh>0)
+        {
+            boolean=(boolean || iterationInTheLoop%pParameters->save_mesh==0);
+        }
+        if (boolean)
+        {
+            if (!writingHistoryFile(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
             {
-                PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
-                fprintf(stderr,"diagonalizeOverlapMatrix function returned ");
-                fprintf(stderr,"zero instead of one.\n");
-                free(pCoefficient);
-                pCoefficient=NULL;
+                PRINT_ERROR("In saveDataInTheLoop: writingHistoryFile ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
+        }
+    }
 
-            // Compute the probabilities and total population inside the domain
-            if (!computeProbability(pParameters,pData,iterationInTheLoop))
+    if (pParameters->save_data>0)
+    {
+        if (iterationInTheLoop%pParameters->save_data==0)
+        {
+            // Opening *.data file (append file if already exists otherwise
+            // created) fopen returns a FILE pointer on success, otherwise NULL
+            fprintf(stdout,"\nOpening %s file. ",pParameters->name_data);
+            dataFile=fopen(pParameters->name_data,"a");
+            if (dataFile==NULL)
             {
-                PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
-                fprintf(stderr,"computeProbability function returned zero ");
-                fprintf(stderr,"instead of one.\n");
-                free(pCoefficient);
-                pCoefficient=NULL;
+                PRINT_ERROR("In saveDataInTheLoop: could not open and append ");
+                fprintf(stderr,"in %s file.\n",pParameters->name_data);
+                endProfilerPhase(&globalProfiler,PROF_IO);
                 return 0;
             }
+            if (!fseek(dataFile,0L,SEEK_END))
+            {
+                offset=ftell(dataFile);
+            }
+            fprintf(stdout,"Appending data. ");
 
-            if (*pProbability>probability)
+            if (!iterationInTheLoop)
             {
-                if (pParameters->verbose)
+                fprintf(dataFile,"\n\n%sMaximizing the ",endTimerAtError());
+                fprintf(dataFile,"probability to find ");
+                fprintf(dataFile,"%d electrons ",pParameters->nu_electrons);
+                fprintf(dataFile,"inside the domain and ");
+                fprintf(dataFile,"%d",
+                              pChemicalSystem->nmorb-pParameters->nu_electrons);
+                fprintf(dataFile," outside.\n\nIter. Prob. Pop. Dprob. Res. ");
+                if (pParameters->opt_mode>0)
                 {
-                    fprintf(stdout,"Adding the %d-th ",kHexahedron+1);
-                    fprintf(stdout,"hexahedron to the domain: ");
-                    fprintf(stdout,"P(Omega+Hexa)=%.8lf\n",*pProbability);
+                     fprintf(dataFile,"Dres. ");
                 }
-                pMesh->phex[kHexahedron].label=-3;
-
-                // Update pCoefficient and probability
-                probability=*pProbability;
-                for (i=0; i<nMorb; i++)
+                else
                 {
-                    for (j=0; j<nMorb; j++)
-                    {
-                        pCoefficient[i*nMorb+j]=pOverlapMatrix->coef[i*nMorb+j];
-                    }
+                    fprintf(dataFile,"D2prob. ");
                 }
+                fprintf(dataFile,"Time (in min.) Cumulated time (in min.)\n\n");
             }
-        }
 
-        // Try to remove kHexahedron to mesh (if not already treated)
-        kHexahedron=pMesh->padj[k].hexin-1;
+            fprintf(dataFile,"%d ",iterationInTheLoop);
+            fprintf(dataFile,"%.8lf ",pData->pnu[iterationInTheLoop]);
+            fprintf(dataFile,"%.8lf ",pData->pop[iterationInTheLoop]);
+            fprintf(dataFile,"%.8le ",pData->d0p[iterationInTheLoop]);
+            fprintf(dataFile,"%.8le ",pData->d1p[iterationInTheLoop]);
+            fprintf(dataFile,"%.8le ",pData->d2p[iterationInTheLoop]);
+            fprintf(dataFile,"%.2lf ",pData->tim[iterationInTheLoop]/60.);
+            fprintf(dataFile,"%.2lf \n",pData->ctim[iterationInTheLoop]/60.);
 
-        if (pMesh->phex[kHexahedron].label!=-2)
+            // Count the appended bytes in the profiler, then close the *.data
+            // file: fclose returns zero if the input FILE* variable is
+            // successfully closed, otherwise EOF (end-of-file)
+            addProfilerBytes(&globalProfiler,0.,
+                                              (double)(ftell(dataFile)-offset));
+            if (fclose(dataFile))
+            {
+                PRINT_ERROR("In saveDataInTheLoop: the ");
+                fprintf(stderr,"%s file has not been ",pParameters->name_data);
+                fprintf(stderr,"closed properly.\n");
+                dataFile=NULL;
+                endProfilerPhase(&globalProfiler,PROF_IO);
+                return 0;
+            }
+            dataFile=NULL;
+            fprintf(stdout,"Closing file.\n");
+        }
+    }
+    else
+    {
+        if (!iterationInTheLoop)
         {
-            // Evaluating S(Omega-kHexahedron)
-            for (i=0; i<nMorb; i++)
+            fprintf(stdout,"\nOpening %s file. ",pParameters->name_data);
+            dataFile=fopen(pParameters->name_data,"a");
+            if (dataFile==NULL)
             {
-                pMolecularOrbitalI=&pChemicalSystem->pmorb[i];
-
-                // Avoid calculation for restricted Hartree-Fock system
-                if (pParameters->orb_rhf)
-                {
-                    if (i>=nMorb/2)
-                    {
-                        continue;
-                    }
-                }
-
-                for (j=0; j<=i; j++)
-                {
-                    pMolecularOrbitalJ=&pChemicalSystem->pmorb[j];
-
-                    // Compute the 3-dimensional integral analytically
-                    integral=0.;
-                    for (lI=0; lI<nGauss; lI++)
-                    {
-                        for (lJ=0; lJ<nGauss; lJ++)
-                        {
-                            integral+=evaluateTripleIntegralIJ(pParameters,
-                                                             pMesh,
-                                                             pChemicalSystem,
-                                                             pMolecularOrbitalI,
-                                                             pMolecularOrbitalJ,
-                                                             lI,lJ,kHexahedron);
-                        }
-                    }
-                    pOverlapMatrix->coef[i*nMorb+j]=
-                                               pCoefficient[i*nMorb+j]-integral;
-                }
+                PRINT_ERROR("In saveDataInTheLoop: could not open and append ");
+                fprintf(stderr,"in %s file.\n",pParameters->name_data);
+                endProfilerPhase(&globalProfiler,PROF_IO);
+                return 0;
             }
-
-            // Complete using the symmetry of the matrix
-            for (i=0; i<nMorb; i++)
+            if (!fseek(dataFile,0L,SEEK_END))
             {
-                for (j=i+1; j<nMorb; j++)
-                {
-                    pOverlapMatrix->coef[i*nMorb+j]=
-                                                pOverlapMatrix->coef[j*nMorb+i];
-                }
+                offset=ftell(dataFile);
             }
+            fprintf(stdout,"Appending data. ");
 
-            // Complete matrix for restricted Hartree-Fock system
-            if (pParameters->orb_rhf)
+            fprintf(dataFile,"\n\n%sMaximizing the ",endTimerAtError());
+            fprintf(dataFile,"probability to find ");
+            fprintf(dataFile,"%d electrons ",pParameters->nu_electrons);
+            fprintf(dataFile,"inside the domain and ");
+            fprintf(dataFile,"%d",
+                              pChemicalSystem->nmorb-pParameters->nu_electrons);
+            fprintf(dataFile," outside.\n\nIter. Prob. Pop. Dprob. Res. ");
+            if (pParameters->opt_mode>0)
             {
-                l=nMorb/2;
-                for (i=0; i<l; i++)
-                {
-                    for (j=0; j<l; j++)
-                    {
-                        pOverlapMatrix->coef[(i+l)*nMorb+(j+l)]=
-                                                pOverlapMatrix->coef[i*nMorb+j];
-                    }
-                }
+                 fprintf(dataFile,"Dres. ");
             }
-
-            // Diagonalize overlap matrix. Warning: we use lapacke.h,
-            // and lapacke package must have been previously installed
-            if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
+            else
             {
-                PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
-                fprintf(stderr,"diagonalizeOverlapMatrix function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                free(pCoefficient);
-                pCoefficient=NULL;
-                return 0;
+                fprintf(dataFile,"D2prob. ");
             }
+            fprintf(dataFile,"Time (in sec.) Cumulated time (in sec.)\n\n");
 
-            // Compute probabilities and total population in the domain
-            if (!computeProbability(pParameters,pData,iterationInTheLoop))
-            {
-                PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
-                fprintf(stderr,"computeProbability function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                free(pCoefficient);
-                pCoefficient=NULL;
-                return 0;
-            }
+            fprintf(dataFile,"%d ",iterationInTheLoop);
+            fprintf(dataFile,"%.8lf ",pData->pnu[iterationInTheLoop]);
+            fprintf(dataFile,"%.8lf ",pData->pop[iterationInTheLoop]);
+            fprintf(dataFile,"%.8le ",pData->d0p[iterationInTheLoop]);
+            fprintf(dataFile,"%.8le ",pData->d1p[iterationInTheLoop]);
+            fprintf(dataFile,"%.8le ",pData->d2p[iterationInTheLoop]);
+            fprintf(dataFile,"%d ",(int)pData->tim[iterationInTheLoop]);
+            fprintf(dataFile,"%d \n",(int)pData->ctim[iterationInTheLoop]);
 
-            if (*pProbability>probability)
+            addProfilerBytes(&globalProfiler,0.,
+                                              (double)(ftell(dataFile)-offset));
+            if (fclose(dataFile))
             {
-                if (pParameters->verbose)
-                {
-                    fprintf(stdout,"Removing the %d-th ",kHexahedron+1);
-                    fprintf(stdout,"hexahedron of the domain: ");
-                    fprintf(stdout,"P(Omega-Hexa)=%.8lf\n",*pProbability);
-                }
-                pMesh->phex[kHexahedron].label=-2;
-
-                // Update pCoefficient and probability
-                probability=*pProbability;
-                for (i=0; i<nMorb; i++)
-                {
-                    for (j=0; j<nMorb; j++)
-                    {
-                        pCoefficient[i*nMorb+j]=pOverlapMatrix->coef[i*nMorb+j];
-                    }
-                }
+                PRINT_ERROR("In saveDataInTheLoop: the ");
+                fprintf(stderr,"%s file has not been ",pParameters->name_data);
+                fprintf(stderr,"closed properly.\n");
+                dataFile=NULL;
+                endProfilerPhase(&globalProfiler,PROF_IO);
+                return 0;
             }
+            dataFile=NULL;
+            fprintf(stdout,"Closing file.\n");
         }
     }
 
-    // Update the final overlap matrix coefficients
-    for (i=0; i<nMorb; i++)
+    // At the end of the optimization loop, we keep track of iterationInTheLoop
+    // thanks to the pData->niter
+    pData->niter++;
+
+    endProfilerPhase(&globalProfiler,PROF_IO);
+
+    return 1;
+}
+
+
+/* ************************************************************************** */
+// The function setupInitialData successively allocates memory for the structure
+// pointed by pData i.e. for the saving of data, enlarge of 10 letters the
+// maximal length allowed for path names, reallocates the memory accordingly
+// in the structure pointed by pParameters, write an *.restart file restating
+// all the parameters used (default ones and those prescribed by the user in
+// the *.info file, the name being similar but where the '.info' extension is
+// replaced by the '.restart one), compute all the quantities
+// (probability, ...), save them in the *.data file given by the
+// pParameters->name_data variable, and save also the mesh in a *.0.mesh file.
+// It allows the user to always keep track of all the parameters with the
+// *.info file, always get the initial mesh saved before the optimization loop,
+// and terminates the setting up of the initialization process of the MPD
+// algorithm. It has the Parameters*, Mesh*, Data*, ChemicalSystem* structures
+// (both defined in main.h) as input arguments, and also the three time_t*
+// variables (pGlobalInitialTimer, pStartLocalTimer, pEndLocalTimer) that are
+// used to compute the execution time of the initialization and the one needed
+// for both loading the data, and initialize them. The function returns one on
+// success, otherwise zero is returned if an error is encountered in the process
+/* ************************************************************************** */
+int setupInitialData(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                     ChemicalSystem* pChemicalSystem,
+                     time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
+                                                         time_t* pEndLocalTimer)
+{
+    // Check the input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                           pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
+                                 pStartLocalTimer==NULL || pEndLocalTimer==NULL)
     {
-        for (j=0; j<nMorb; j++)
-        {
-           pOverlapMatrix->coef[i*nMorb+j]=pCoefficient[i*nMorb+j];
-        }
+        PRINT_ERROR("In setupInitialData: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pData=%p, pMesh=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pGlobalInitialTimer=%p, ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"pStartLocalTimer=%p or ",(void*)pStartLocalTimer);
+        fprintf(stderr,"pEndLocalTimer=%p, ",(void*)pEndLocalTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
     }
 
-    if (!pParameters->verbose)
+    // Allocate memory for the saving of data
+    if (!allocateMemoryForData(pParameters,pData,pChemicalSystem))
     {
-        fprintf(stdout,"100 %% done.\n");
+        PRINT_ERROR("In setupInitialData: allocateMemoryForData function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
     }
 
-    // Diagonalize overlap matrix. Warning: we use lapacke.h,
-    // and lapacke package must have been previously installed
-    pParameters->opt_mode=-1;
-    if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
+    // Check we can add 10 letters to the file names for the saving of meshes
+    if (!addLengthForFileName(pParameters,10))
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: diagonalizeOverlapMatrix ");
-        fprintf(stderr,"function returned zero instead of one.\n");
-        free(pCoefficient);
-        pCoefficient=NULL;
+        PRINT_ERROR("In setupInitialData: addLengthForFileName function ");
+        fprintf(stderr,"returned zero instead of one.\n");
         return 0;
     }
 
-    // Compute probabilities and total population in the domain
-    if (!computeProbability(pParameters,pData,iterationInTheLoop))
+    // Write the *.restart file before starting the optimization loop
+    if (!writingRestartFile(pParameters))
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: computeProbability ");
-        fprintf(stderr,"function returned zero instead of one.\n");
-        free(pCoefficient);
-        pCoefficient=NULL;
+        PRINT_ERROR("In setupInitialData: writingRestartFile function ");
+        fprintf(stderr,"returned zero instead of one.\n");
         return 0;
     }
-    pParameters->opt_mode=-2;
 
-    // Free the memory allocated for pCoefficient
-    free(pCoefficient);
-    pCoefficient=NULL;
+    // Compute the overlap matrix, probability, shape gradient, and residual
+    // for the initial domain
+    if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,0))
+    {
+        PRINT_ERROR("In setupInitialData: shapeDerivative function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
 
-    // Act the fact that the new domain can now be considered
-    for (i=0; i<nHex; i++)
+    // Save initial data and mesh
+    if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,0,
+                           pGlobalInitialTimer,pStartLocalTimer,pEndLocalTimer))
     {
-        pMesh->phex[i].label=abs(pMesh->phex[i].label);
+        PRINT_ERROR("In setupInitialData: saveDataInTheLoop function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
     }
 
-    // Free the memory allocated for Adjacency table
-    sizeMemory=sizeof(int)+(pMesh->nadj)*sizeof(Adjacency);
-    fprintf(stdout,"\nCleaning allocated memory ");
-    fprintf(stdout,"(%d,",sizeMemory/1000000);
-    fprintf(stdout,"%d Mo) for the ",sizeMemory%1000000);
-    fprintf(stdout,"Adjacency structures. ");
-    free(pMesh->padj);
-    pMesh->padj=NULL;
-    pMesh->nadj=0;
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function writingArrayInCheckpoint writes in the binary checkpoint file
+// pointed by checkFile the number of items of the array pArray (zero if pArray
+// is pointing to NULL) followed by its numberOfItems items of sizeOfItem bytes.
+// It has the FILE* checkFile, void* pArray, size_t sizeOfItem, and int
+// numberOfItems variables as input arguments and it returns one on success,
+// otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int writingArrayInCheckpoint(FILE* checkFile, void* pArray, size_t sizeOfItem,
+                                                              int numberOfItems)
+{
+    size_t length=0;
 
-    // Rebuild the Adjacency structures and boundary quandrilaterals
-    fprintf(stdout,"\nBuild the new Adjacency structures to get the ");
-    fprintf(stdout,"updated domain.\n");
-    if (!getLevelSetQuadrilaterals(pParameters,pMesh))
+    // Check the input variables
+    if (checkFile==NULL || sizeOfItem<1 || numberOfItems<0)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: getLevelSetQuadrilaterals ");
-        fprintf(stderr,"function returned zero instead of one.\n");
+        PRINT_ERROR("In writingArrayInCheckpoint: the input checkFile ");
+        fprintf(stderr,"variable (=%p) does not point to a ",(void*)checkFile);
+        fprintf(stderr,"valid address or the sizeOfItem ");
+        fprintf(stderr,"(=%lu) and numberOfItems ",(unsigned long)sizeOfItem);
+        fprintf(stderr,"(=%d) variables are not valid.\n",numberOfItems);
         return 0;
     }
 
-    if (!computeShapeResidual(pParameters,pMesh,pData,pChemicalSystem,
-                                                            iterationInTheLoop))
+    if (pArray==NULL)
+    {
+        numberOfItems=0;
+    }
+    length=(size_t)numberOfItems;
+
+    // fwrite returns the number of items successfully written
+    if (fwrite(&numberOfItems,sizeof(int),1,checkFile)!=1)
+    {
+        return 0;
+    }
+    if (length && fwrite(pArray,sizeOfItem,length,checkFile)!=length)
     {
-        PRINT_ERROR("In exhaustiveSearchAlgorithm: computeShapeResidual ");
-        fprintf(stderr,"function returned zero instead of one.\n");
         return 0;
     }
 
@@ -6230,1092 +6571,3287 @@ int exhaustiveSearchAlgorithm(Parameters* pParameters, Mesh* pMesh,
 }
 
 /* ************************************************************************** */
-// The function computeLevelSet computes the signed distance function i.e. the
-// level-set function with unitary gradient norm of the internal domain of pMesh
-// and saves the values in an *.chi.sol file associated with an *.mesh one. It
-// has the Parameters* and Mesh* variables (both defined in main.h) as input
-// arguments and it returns zero if an error occurred, otherwise one is returned
-// on success
+// The function readArrayInCheckpoint reads in the binary checkpoint file
+// pointed by checkFile an array written by the writingArrayInCheckpoint
+// function. If the number of items read is positive, it allocates an array of
+// numberMax items of sizeOfItem bytes, pointed by *pArray, and fills its first
+// items with the ones of the file; otherwise *pArray is left pointing to NULL.
+// It has the FILE* checkFile, void** pArray, size_t sizeOfItem, and int
+// numberMax variables as input arguments and it returns one on success,
+// otherwise zero is returned (e.g. if more than numberMax items are stored)
 /* ************************************************************************** */
-int computeLevelSet(Parameters* pParameters, Mesh* pMesh,
-                                                         int iterationInTheLoop)
+int readArrayInCheckpoint(FILE* checkFile, void** pArray, size_t sizeOfItem,
+                                                                  int numberMax)
 {
-    size_t lengthName=0;
-    char* fileLocation=NULL;
+    size_t length=0;
+    int numberOfItems=0;
 
-    // Check that the input variables are not pointing to NULL
-    if (pParameters==NULL || pMesh==NULL)
+    // Check the input variables
+    if (checkFile==NULL || pArray==NULL || sizeOfItem<1 || numberMax<0)
     {
-        PRINT_ERROR("In computeLevelSet: at least one of the input variable ");
-        fprintf(stderr,"pParameters=%p or",(void*)pParameters);
-        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
-        fprintf(stderr,"address.\n");
+        PRINT_ERROR("In readArrayInCheckpoint: the input variables ");
+        fprintf(stderr,"checkFile=%p and ",(void*)checkFile);
+        fprintf(stderr,"pArray=%p must point to ",(void*)pArray);
+        fprintf(stderr,"valid addresses, and the sizeOfItem ");
+        fprintf(stderr,"(=%lu) and numberMax ",(unsigned long)sizeOfItem);
+        fprintf(stderr,"(=%d) variables must not be negative.\n",numberMax);
         return 0;
     }
+    *pArray=NULL;
 
-    // Check the pParameters->opt_mode variable
-    if (pParameters->opt_mode!=1 && pParameters->opt_mode!=2)
+    // fread returns the number of items successfully read
+    if (fread(&numberOfItems,sizeof(int),1,checkFile)!=1 || numberOfItems<0 ||
+                                                        numberOfItems>numberMax)
     {
-        PRINT_ERROR("In computeLevelSet: the pParameters->opt_mode ");
-        fprintf(stderr,"variable (=%d) can only be set ",pParameters->opt_mode);
-        fprintf(stderr,"to one or two here.\n");
+        PRINT_ERROR("In readArrayInCheckpoint: the number of items ");
+        fprintf(stderr,"(=%d) could not be read or exceeds ",numberOfItems);
+        fprintf(stderr,"the expected one (=%d).\n",numberMax);
         return 0;
     }
+    if (!numberOfItems)
+    {
+        return 1;
+    }
 
-    // Check the iterationInTheLoopVariable variable
-    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    // calloc returns a pointer to the allocated memory, otherwise NULL
+    *pArray=calloc((size_t)numberMax,sizeOfItem);
+    if (*pArray==NULL)
     {
-        PRINT_ERROR("In computeLevelSet: the input iterationInTheLoop ");
-        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
-        fprintf(stderr,"positive integer not (strictly) greater than the ");
-        fprintf(stderr,"maximal number of allowed iterations ");
-        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        PRINT_ERROR("In readArrayInCheckpoint: could not allocate memory ");
+        fprintf(stderr,"for an array of %d items.\n",numberMax);
         return 0;
     }
 
-    // Check the name_mesh and name_length variables
-    if (getMeshFormat(pParameters->name_mesh,pParameters->name_length)!=1)
+    length=(size_t)numberOfItems;
+    if (fread(*pArray,sizeOfItem,length,checkFile)!=length)
     {
-        PRINT_ERROR("In computeLevelSet: getMeshFormat function did not ");
-        fprintf(stderr,"return one, which was the expected value here.\n");
+        PRINT_ERROR("In readArrayInCheckpoint: could not read the ");
+        fprintf(stderr,"%d items of the array.\n",numberOfItems);
         return 0;
     }
 
-    // Store the name of the *.chi.mesh file in fileLocation
-    lengthName=pParameters->name_length;
-    fileLocation=(char*)calloc(lengthName,sizeof(char));
-    if (fileLocation==NULL)
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function getSizeOrTruncateOutputFiles deals with the files to which the
+// optimization loop appends its records: the *.data file (pParameters->
+// name_data) and, if save_type is set to 3, the *.hist file (built on
+// pParameters->name_mesh). If booleanForTruncate is set to zero, it saves
+// their current size (minus one if they do not exist) in the dataSize and
+// histSize variables of the structure pointed by pCheckpoint. Otherwise, they
+// are truncated back to these sizes, so that the records appended by the
+// interrupted run after its checkpoint do not appear twice once it restarts.
+// It has the Parameters*, Checkpoint* (defined in main.h), and int
+// booleanForTruncate variables as input arguments and it returns one on
+// success, otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int getSizeOrTruncateOutputFiles(Parameters* pParameters,
+                                Checkpoint* pCheckpoint, int booleanForTruncate)
+{
+    size_t lengthName=0;
+    char *fileLocation[2]={NULL,NULL};
+    int i=0, returnValue=1;
+    long *pSize[2]={NULL,NULL};
+    struct stat fileStatus;
+
+    // Check the input pointers
+    if (pParameters==NULL || pCheckpoint==NULL || pParameters->name_data==NULL)
     {
-        PRINT_ERROR("In computeLevelSet: could not allocate memory for the ");
-        fprintf(stderr,"local char* fileLocation variable.\n");
+        PRINT_ERROR("In getSizeOrTruncateOutputFiles: the input variables ");
+        fprintf(stderr,"pParameters=%p ",(void*)pParameters);
+        fprintf(stderr,"and pCheckpoint=%p ",(void*)pCheckpoint);
+        fprintf(stderr,"(or its name_data variable) does not point to a ");
+        fprintf(stderr,"valid address.\n");
         return 0;
     }
-    strncpy(fileLocation,pParameters->name_mesh,lengthName);
-    lengthName=strlen(fileLocation);
-    fileLocation[lengthName-5]='.';
-    fileLocation[lengthName-4]='c';
-    fileLocation[lengthName-3]='h';
-    fileLocation[lengthName-2]='i';
-    fileLocation[lengthName-1]='.';
-    fileLocation[lengthName]='m';
-    fileLocation[lengthName+1]='e';
-    fileLocation[lengthName+2]='s';
-    fileLocation[lengthName+3]='h';
-    fileLocation[lengthName+4]='\0';
+    fileLocation[0]=pParameters->name_data;
+    pSize[0]=&pCheckpoint->dataSize;
+    pSize[1]=&pCheckpoint->histSize;
 
-    // Remove the *.chi.mesh file if it already exists.
-    switch (initialFileExists(fileLocation,pParameters->name_length))
+    // The *.hist file name is made of the *.mesh one (see writingHistoryFile)
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    if (pParameters->save_type==3 && pParameters->name_mesh!=NULL)
     {
-        case -1:
-            break;
-
-        case 1:
-            // remove returns 0 on success, otherwise -1
-            if (remove(fileLocation))
+        lengthName=strlen(pParameters->name_mesh);
+        if (lengthName>5 &&
+                        !strcmp(pParameters->name_mesh+lengthName-5,".mesh"))
+        {
+            fileLocation[1]=(char*)calloc(lengthName+1,sizeof(char));
+            if (fileLocation[1]==NULL)
             {
-                PRINT_ERROR("In computeLevelSet: wrong return (=-1) of the ");
-                fprintf(stderr,"standard remove c-function in the attempt of ");
-                fprintf(stderr,"removing the %s file.\n",fileLocation);
-                free(fileLocation);
-                fileLocation=NULL;
+                PRINT_ERROR("In getSizeOrTruncateOutputFiles: could not ");
+                fprintf(stderr,"allocate memory for the local ");
+                fprintf(stderr,"fileLocation[1] variable.\n");
                 return 0;
             }
-            break;
+            strcpy(fileLocation[1],pParameters->name_mesh);
+            strcpy(fileLocation[1]+lengthName-5,".hist");
+        }
+    }
 
-        default:
-            PRINT_ERROR("In computeLevelSet: initialFileExists function ");
-            fprintf(stderr,"returned zero instead of (+/-)one.\n");
-            free(fileLocation);
-            fileLocation=NULL;
-            return 0;
-            break;
+    for (i=0; i<2; i++)
+    {
+        // stat function returns zero on success, otherwise -1 (no file)
+        if (!booleanForTruncate)
+        {
+            *pSize[i]=-1;
+            if (fileLocation[i]!=NULL && !stat(fileLocation[i],&fileStatus))
+            {
+                *pSize[i]=(long)fileStatus.st_size;
+            }
+            continue;
+        }
+
+        if (fileLocation[i]==NULL || *pSize[i]<0 ||
+                                              stat(fileLocation[i],&fileStatus))
+        {
+            continue;
+        }
+        if ((long)fileStatus.st_size<*pSize[i])
+        {
+            fprintf(stdout,"\nWarning in getSizeOrTruncateOutputFiles ");
+            fprintf(stdout,"function: the %s file is ",fileLocation[i]);
+            fprintf(stdout,"shorter (%ld bytes) ",(long)fileStatus.st_size);
+            fprintf(stdout,"than when the checkpoint was written ");
+            fprintf(stdout,"(%ld bytes). It is left unchanged.\n",*pSize[i]);
+        }
+        else if ((long)fileStatus.st_size>*pSize[i])
+        {
+            // truncate function returns zero on success, otherwise -1
+            fprintf(stdout,"\nTruncating %s file ",fileLocation[i]);
+            fprintf(stdout,"to %ld bytes.\n",*pSize[i]);
+            if (truncate(fileLocation[i],(off_t)*pSize[i]))
+            {
+                PRINT_ERROR("In getSizeOrTruncateOutputFiles: wrong return ");
+                fprintf(stderr,"(=-1) of the truncate c-function in the ");
+                fprintf(stderr,"attempt of truncating the ");
+                fprintf(stderr,"%s file.\n",fileLocation[i]);
+                returnValue=0;
+            }
+        }
     }
+    free(fileLocation[1]);
+    fileLocation[1]=NULL;
 
-    // Temporary rename the *.mesh by *.chi.mesh
-    if (!renameFileLocation(pParameters->name_mesh,pParameters->name_length,
-                                                                  fileLocation))
+    return returnValue;
+}
+
+/* ************************************************************************** */
+// The function writingCheckpointFile writes the whole state of the optimization
+// loop (the structures pointed by pParameters, pMesh, pData, and pCheckpoint)
+// in the binary *.chk file associated with pParameters->name_info (the '.info'
+// extension is replaced by the '.chk' one). The file is first written under a
+// temporary name and then renamed, so that a run stopped while writing it
+// (e.g. preempted by the job scheduler) always leaves the previous checkpoint
+// intact. It has the Parameters*, Mesh*, Data*, and Checkpoint* variables
+// (defined in main.h) as input arguments and it returns one on success,
+// otherwise zero is returned if an error is encountered
+/* ************************************************************************** */
+int writingCheckpointFile(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                                                        Checkpoint* pCheckpoint)
+{
+    size_t lengthName=0;
+    char *fileLocation=NULL, *temporaryLocation=NULL;
+    int i=0, boolean=0, header[4]={0};
+    FILE *checkFile=NULL;
+
+    // Time the writing of the checkpoint in the profiler of the run
+    beginProfilerPhase(&globalProfiler,PROF_IO);
+
+    // Check the input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL || pCheckpoint==NULL)
     {
-        PRINT_ERROR("In computeLevelSet: renameFileLocation function ");
-        fprintf(stderr,"returned zero instead of one.\n");
-        free(fileLocation);
-        fileLocation=NULL;
+        PRINT_ERROR("In writingCheckpointFile: at least one of the input ");
+        fprintf(stderr,"variables (pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pCheckpoint=%p) does not ",(void*)pCheckpoint);
+        fprintf(stderr,"point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
-    strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
 
-    // Generate the level-set function from mesh with mshdist
-    if (!renormalizeWithMshdistSoftware(pParameters,"dom"))
+    // Build the *.chk file name from the *.info one
+    if (!checkStringFromLength(pParameters->name_info,7,
+                                                      pParameters->name_length))
     {
-        PRINT_ERROR("In computeLevelSet: renormalizeWithMshdistSoftware ");
-        fprintf(stderr,"function returned zero instead of one.\n");
+        PRINT_ERROR("In writingCheckpointFile: checkStringFromLength ");
+        fprintf(stderr,"function returned zero, which is not the expected ");
+        fprintf(stderr,"value here.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
+    lengthName=strlen(pParameters->name_info);
+    if (strcmp(pParameters->name_info+lengthName-5,".info"))
+    {
+        PRINT_ERROR("In writingCheckpointFile: ");
+        fprintf(stderr,"%s file name does not end ",pParameters->name_info);
+        fprintf(stderr,"with the '.info' extension.\n");
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
+
+    // The temporary name is made of the *.chk one followed by the '~' character
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    fileLocation=(char*)calloc(lengthName+1,sizeof(char));
+    temporaryLocation=(char*)calloc(lengthName+1,sizeof(char));
+    if (fileLocation==NULL || temporaryLocation==NULL)
+    {
+        PRINT_ERROR("In writingCheckpointFile: could not allocate memory ");
+        fprintf(stderr,"for the local fileLocation and temporaryLocation ");
+        fprintf(stderr,"variables.\n");
         free(fileLocation);
-        fileLocation=NULL;
+        free(temporaryLocation);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
+    strcpy(fileLocation,pParameters->name_info);
+    strcpy(fileLocation+lengthName-5,".chk");
+    strcpy(temporaryLocation,fileLocation);
+    strcat(temporaryLocation,"~");
 
-    // Vizualize the shape gradient after renormalization
-    if (pParameters->opt_mode==2)
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    checkFile=fopen(temporaryLocation,"wb");
+    if (checkFile==NULL)
     {
-        if (pParameters->save_print>0)
-        {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==2)
-            {
-                if (!plotMeshWithMeditSoftware(pParameters))
-                {
-                    PRINT_ERROR("In computeLevelSet: ");
-                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    free(fileLocation);
-                    fileLocation=NULL;
-                    return 0;
-                }
-            }
-        }
+        PRINT_ERROR("In writingCheckpointFile: could not open and write ");
+        fprintf(stderr,"into the %s file.\n",temporaryLocation);
+        free(fileLocation);
+        free(temporaryLocation);
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
     }
+    fprintf(stdout,"Writing checkpoint of iteration %d. ",pCheckpoint->iter);
 
-    // Rename the *.mesh file as it was
-    lengthName=strlen(fileLocation);
-    fileLocation[lengthName-9]='.';
-    fileLocation[lengthName-8]='m';
-    fileLocation[lengthName-7]='e';
-    fileLocation[lengthName-6]='s';
-    fileLocation[lengthName-5]='h';
-    fileLocation[lengthName-4]='\0';
-    fileLocation[lengthName-3]='\0';
-    fileLocation[lengthName-2]='\0';
-    fileLocation[lengthName-1]='\0';
-    fileLocation[lengthName]='\0';
-    if (!renameFileLocation(pParameters->name_mesh,pParameters->name_length,
-                                                                  fileLocation))
+    // Save the sizes of the files to which the loop appends its records
+    if (!getSizeOrTruncateOutputFiles(pParameters,pCheckpoint,0))
     {
-        PRINT_ERROR("In computeLevelSet: renameFileLocation function ");
-        fprintf(stderr,"returned zero instead of one.\n");
+        PRINT_ERROR("In writingCheckpointFile: ");
+        fprintf(stderr,"getSizeOrTruncateOutputFiles function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        fclose(checkFile);
+        remove(temporaryLocation);
         free(fileLocation);
-        fileLocation=NULL;
+        free(temporaryLocation);
+        endProfilerPhase(&globalProfiler,PROF_IO);
+        return 0;
+    }
+
+    // The header guards against a checkpoint written by another version of the
+    // MPD program (the structures are written as they are stored in memory)
+    header[0]=CHECK_VERSION;
+    header[1]=(int)sizeof(Parameters);
+    header[2]=(int)sizeof(Mesh);
+    header[3]=(int)sizeof(Data);
+
+    // fwrite returns the number of items successfully written
+    boolean=(fwrite(CHECK_MAGIC,sizeof(char),8,checkFile)==8);
+    boolean=(boolean && fwrite(header,sizeof(int),4,checkFile)==4);
+    boolean=(boolean && fwrite(pCheckpoint,sizeof(Checkpoint),1,checkFile)==1);
+
+    // Parameters structure followed by its strings
+    boolean=(boolean && fwrite(pParameters,sizeof(Parameters),1,checkFile)==1);
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->name_info,
+                                                 sizeof(char),
+                                             strlen(pParameters->name_info)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->name_data,
+                                                 sizeof(char),
+                                             strlen(pParameters->name_data)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->name_chem,
+                                                 sizeof(char),
+                                             strlen(pParameters->name_chem)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->name_mesh,
+                                                 sizeof(char),
+                                       (pParameters->name_mesh==NULL) ? 0 :
+                                             strlen(pParameters->name_mesh)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->name_elas,
+                                                 sizeof(char),
+                                       (pParameters->name_elas==NULL) ? 0 :
+                                             strlen(pParameters->name_elas)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->path_medit,
+                                                 sizeof(char),
+                                            strlen(pParameters->path_medit)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->path_mmg3d,
+                                                 sizeof(char),
+                                            strlen(pParameters->path_mmg3d)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->path_mshdist,
+                                                 sizeof(char),
+                                          strlen(pParameters->path_mshdist)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->path_elastic,
+                                                 sizeof(char),
+                                          strlen(pParameters->path_elastic)+1));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                 pParameters->path_advect,
+                                                 sizeof(char),
+                                           strlen(pParameters->path_advect)+1));
+
+    // Mesh structure followed by its arrays
+    boolean=(boolean && fwrite(pMesh,sizeof(Mesh),1,checkFile)==1);
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->pver,
+                                                    sizeof(Point),pMesh->nver));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->pnorm,
+                                                  sizeof(Vector),pMesh->nnorm));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->ptan,
+                                                   sizeof(Vector),pMesh->ntan));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->pedg,
+                                                     sizeof(Edge),pMesh->nedg));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->ptri,
+                                                 sizeof(Triangle),pMesh->ntri));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->ptet,
+                                              sizeof(Tetrahedron),pMesh->ntet));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->pqua,
+                                            sizeof(Quadrilateral),pMesh->nqua));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->phex,
+                                               sizeof(Hexahedron),pMesh->nhex));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pMesh->padj,
+                                                sizeof(Adjacency),pMesh->nadj));
+
+    // Data structure followed by its arrays and its ring of Probabilities and
+    // OverlapMatrix structures (the ones of the last iterations)
+    boolean=(boolean && fwrite(pData,sizeof(Data),1,checkFile)==1);
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->pnu,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->pop,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->d0p,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->d1p,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->d2p,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->tim,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && writingArrayInCheckpoint(checkFile,pData->ctim,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && pData->pprob!=NULL && pData->pmat!=NULL);
+    for (i=0; i<pData->nring; i++)
+    {
+        boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                     pData->pprob[i].pk,
+                                                     sizeof(double),
+                                                                 pData->nprob));
+        boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                     pData->pprob[i].pkl,
+                                                     sizeof(double),
+                                                    pData->nprob*pData->nprob));
+        boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                     pData->pmat[i].coef,
+                                                     sizeof(double),
+                                                      pData->nmat*pData->nmat));
+        boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                     pData->pmat[i].diag,
+                                                     sizeof(double),
+                                                                  pData->nmat));
+        boolean=(boolean && writingArrayInCheckpoint(checkFile,
+                                                     pData->pmat[i].vect,
+                                                     sizeof(double),
+                                                      pData->nmat*pData->nmat));
+    }
+
+    // Count the written bytes in the profiler before closing the file
+    addProfilerBytes(&globalProfiler,0.,(double)ftell(checkFile));
+
+    // fclose returns zero if the input FILE* variable is successfully closed
+    if (fclose(checkFile))
+    {
+        boolean=0;
+    }
+    checkFile=NULL;
+
+    // rename returns zero on success, otherwise -1 (errno is set)
+    if (!boolean || rename(temporaryLocation,fileLocation))
+    {
+        PRINT_ERROR("In writingCheckpointFile: we were not able to write ");
+        fprintf(stderr,"the %s file properly.\n",fileLocation);
+        remove(temporaryLocation);
+        free(fileLocation);
+        free(temporaryLocation);
+        endProfilerPhase(&globalProfiler,PROF_IO);
         return 0;
     }
-    strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
+    fprintf(stdout,"Closing file.\n");
 
-    // Free the memory allocated for fileLocation
     free(fileLocation);
-    fileLocation=NULL;
+    free(temporaryLocation);
+
+    endProfilerPhase(&globalProfiler,PROF_IO);
 
     return 1;
 }
 
 /* ************************************************************************** */
-// The function saveTheShapeGradient contains successive functions that are
-// used to vizualize the norm of the shape gradient, save it in the vectorial
-// *.sol file, and vizualize it with the medit software. It has the
-// Parameters*, Mesh*, (both defined in main.h), and the int
-// interationInTheLoop variables as input arguments. It returns one on success
-// otherwise zero if an error is encoutnered during the process
+// The function readCheckpointFile loads the whole state of an optimization loop
+// saved in the binary *.chk file located at fileLocation by the
+// writingCheckpointFile function: the structures pointed by pParameters,
+// pMesh, and pData are (freed and) allocated again with the saved values, and
+// the one pointed by pCheckpoint receives the local variables of the loop. It
+// has the char* fileLocation, and the Parameters*, Mesh*, Data*, Checkpoint*
+// variables (defined in main.h) as input arguments and it returns one on
+// success, otherwise zero is returned if an error is encountered
 /* ************************************************************************** */
-int saveTheShapeGradient(Parameters* pParameters, Mesh* pMesh,
-                                                         int iterationInTheLoop)
+int readCheckpointFile(char* fileLocation, Parameters* pParameters,
+                             Mesh* pMesh, Data* pData, Checkpoint* pCheckpoint)
 {
-    // Check that the input variables are not pointing to NULL
-    if (pParameters==NULL || pMesh==NULL)
+    char magic[8]={'\0'};
+    int i=0, boolean=0, header[4]={0};
+    Parameters parameters;
+    Mesh mesh;
+    Data data;
+    FILE *checkFile=NULL;
+
+    // Check the input pointers
+    if (fileLocation==NULL || pParameters==NULL || pMesh==NULL ||
+                                               pData==NULL || pCheckpoint==NULL)
     {
-        PRINT_ERROR("In saveTheShapeGradient: at least one of the input ");
-        fprintf(stderr,"variable pParameters=%p or",(void*)pParameters);
-        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
-        fprintf(stderr,"address.\n");
+        PRINT_ERROR("In readCheckpointFile: at least one of the input ");
+        fprintf(stderr,"variables (fileLocation=%p, ",(void*)fileLocation);
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pCheckpoint=%p) does not ",(void*)pCheckpoint);
+        fprintf(stderr,"point to a valid address.\n");
         return 0;
     }
+    freeParameterMemory(pParameters);
+    freeMeshMemory(pMesh);
+    freeDataMemory(pData);
+    initializeParameterStructure(pParameters);
+    initializeMeshStructure(pMesh);
+    initializeDataStructure(pData);
 
-    // Check the iterationInTheLoopVariable variable
-    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    // fopen returns a FILE pointer on success, otherwise NULL is returned
+    fprintf(stdout,"\nOpening %s file. ",fileLocation);
+    checkFile=fopen(fileLocation,"rb");
+    if (checkFile==NULL)
     {
-        PRINT_ERROR("In saveTheShapeGradient: the input iterationInTheLoop ");
-        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
-        fprintf(stderr,"positive integer not (strictly) greater than the ");
-        fprintf(stderr,"maximal number of allowed iterations ");
-        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        PRINT_ERROR("In readCheckpointFile: could not open and read the ");
+        fprintf(stderr,"%s file.\n",fileLocation);
         return 0;
     }
+    fprintf(stdout,"Reading checkpoint. ");
 
-    if (pParameters->opt_mode==3)
+    // fread returns the number of items successfully read
+    boolean=(fread(magic,sizeof(char),8,checkFile)==8);
+    boolean=(boolean && !memcmp(magic,CHECK_MAGIC,8));
+    boolean=(boolean && fread(header,sizeof(int),4,checkFile)==4);
+    boolean=(boolean && header[0]==CHECK_VERSION);
+    boolean=(boolean && header[1]==(int)sizeof(Parameters));
+    boolean=(boolean && header[2]==(int)sizeof(Mesh));
+    boolean=(boolean && header[3]==(int)sizeof(Data));
+    if (!boolean)
     {
-            fprintf(stdout,"\nSTEP 1: DEFORM THE MESH ACCORDING TO THE ");
-            fprintf(stdout,"COMPUTED SHAPE GRADIENT MOTION.\n");
+        PRINT_ERROR("In readCheckpointFile: the ");
+        fprintf(stderr,"%s file is not a checkpoint ",fileLocation);
+        fprintf(stderr,"written by this version ");
+        fprintf(stderr,"(=%d) of the MPD program.\n",CHECK_VERSION);
+        fclose(checkFile);
+        return 0;
     }
-    else if (pParameters->opt_mode==2)
+    boolean=(fread(pCheckpoint,sizeof(Checkpoint),1,checkFile)==1);
+
+    // Parameters structure: the saved pointers are meaningless and replaced
+    // by the strings allocated just after
+    boolean=(boolean && fread(&parameters,sizeof(Parameters),1,checkFile)==1);
+    if (boolean)
     {
-            fprintf(stdout,"\nSTEP 1: EXTEND THE COMPUTED SHAPE GRADIENT ");
-            fprintf(stdout,"OUTSIDE THE BOUNDARY OF THE DOMAIN.\n");
-    }
+        parameters.name_info=NULL;
+        parameters.name_data=NULL;
+        parameters.name_chem=NULL;
+        parameters.name_mesh=NULL;
+        parameters.name_elas=NULL;
+        parameters.n_start=0;
+        parameters.ls_start=NULL;
+        parameters.n_geom=0;
+        parameters.name_geom=NULL;
+        parameters.path_medit=NULL;
+        parameters.path_mmg3d=NULL;
+        parameters.path_mshdist=NULL;
+        parameters.path_elastic=NULL;
+        parameters.path_advect=NULL;
+        *pParameters=parameters;
+    }
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->name_info,
+                                          sizeof(char),
+                                                     pParameters->name_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->name_data,
+                                          sizeof(char),
+                                                     pParameters->name_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->name_chem,
+                                          sizeof(char),
+                                                     pParameters->name_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->name_mesh,
+                                          sizeof(char),
+                                                     pParameters->name_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->name_elas,
+                                          sizeof(char),
+                                                     pParameters->name_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->path_medit,
+                                          sizeof(char),
+                                                     pParameters->path_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                          (void**)&pParameters->path_mmg3d,
+                                          sizeof(char),
+                                                     pParameters->path_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                        (void**)&pParameters->path_mshdist,
+                                        sizeof(char),
+                                                     pParameters->path_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                        (void**)&pParameters->path_elastic,
+                                        sizeof(char),
+                                                     pParameters->path_length));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                         (void**)&pParameters->path_advect,
+                                         sizeof(char),
+                                                     pParameters->path_length));
+
+    // Mesh structure
+    boolean=(boolean && fread(&mesh,sizeof(Mesh),1,checkFile)==1);
+    if (boolean)
+    {
+        mesh.pver=NULL;
+        mesh.pnorm=NULL;
+        mesh.ptan=NULL;
+        mesh.pedg=NULL;
+        mesh.ptri=NULL;
+        mesh.ptet=NULL;
+        mesh.pqua=NULL;
+        mesh.phex=NULL;
+        mesh.padj=NULL;
+        *pMesh=mesh;
+    }
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->pver,
+                                                    sizeof(Point),pMesh->nver));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->pnorm,
+                                                  sizeof(Vector),pMesh->nnorm));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->ptan,
+                                                   sizeof(Vector),pMesh->ntan));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->pedg,
+                                                     sizeof(Edge),pMesh->nedg));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->ptri,
+                                                 sizeof(Triangle),pMesh->ntri));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->ptet,
+                                              sizeof(Tetrahedron),pMesh->ntet));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->pqua,
+                                            sizeof(Quadrilateral),pMesh->nqua));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->phex,
+                                               sizeof(Hexahedron),pMesh->nhex));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pMesh->padj,
+                                                sizeof(Adjacency),pMesh->nadj));
+
+    // Data structure (the ring of Probabilities and OverlapMatrix structures is
+    // allocated before reading its arrays)
+    boolean=(boolean && fread(&data,sizeof(Data),1,checkFile)==1);
+    boolean=(boolean && data.nring==DATA_RING_SIZE && data.nprob>0 &&
+                                                                   data.nmat>0);
+    if (boolean)
+    {
+        data.pnu=NULL;
+        data.pop=NULL;
+        data.d0p=NULL;
+        data.d1p=NULL;
+        data.d2p=NULL;
+        data.tim=NULL;
+        data.ctim=NULL;
+        data.pprob=(Probabilities*)calloc(data.nring,sizeof(Probabilities));
+        data.pmat=(OverlapMatrix*)calloc(data.nring,sizeof(OverlapMatrix));
+        *pData=data;
+        boolean=(pData->pprob!=NULL && pData->pmat!=NULL);
+    }
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->pnu,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->pop,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->d0p,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->d1p,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->d2p,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->tim,
+                                                  sizeof(double),pData->ndata));
+    boolean=(boolean && readArrayInCheckpoint(checkFile,(void**)&pData->ctim,
+                                                  sizeof(double),pData->ndata));
+    for (i=0; i<pData->nring; i++)
+    {
+        boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                               (void**)&pData->pprob[i].pk,
+                                                  sizeof(double),pData->nprob));
+        boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                               (void**)&pData->pprob[i].pkl,
+                                               sizeof(double),
+                                                    pData->nprob*pData->nprob));
+        boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                               (void**)&pData->pmat[i].coef,
+                                               sizeof(double),
+                                                      pData->nmat*pData->nmat));
+        boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                               (void**)&pData->pmat[i].diag,
+                                                   sizeof(double),pData->nmat));
+        boolean=(boolean && readArrayInCheckpoint(checkFile,
+                                               (void**)&pData->pmat[i].vect,
+                                               sizeof(double),
+                                                      pData->nmat*pData->nmat));
+    }
+
+    // The whole file must have been read (fgetc returns EOF at the end)
+    boolean=(boolean && fgetc(checkFile)==EOF);
+    addProfilerBytes(&globalProfiler,(double)ftell(checkFile),0.);
+    if (fclose(checkFile))
+    {
+        boolean=0;
+    }
+    checkFile=NULL;
+
+    // Check the consistency of the state restored
+    boolean=(boolean && checkStringFromLength(pParameters->name_info,7,
+                                                     pParameters->name_length));
+    boolean=(boolean && checkStringFromLength(pParameters->name_data,7,
+                                                     pParameters->name_length));
+    boolean=(boolean && checkStringFromLength(pParameters->name_chem,7,
+                                                     pParameters->name_length));
+    boolean=(boolean && pCheckpoint->iter>0 &&
+                                      pCheckpoint->iter<=pParameters->iter_max);
+    boolean=(boolean && pData->ndata==pParameters->iter_max+1);
+    boolean=(boolean && pData->pnu!=NULL && pData->ctim!=NULL);
+    if (!boolean)
+    {
+        PRINT_ERROR("In readCheckpointFile: the ");
+        fprintf(stderr,"%s file could not be read ",fileLocation);
+        fprintf(stderr,"properly or does not store a ");
+        fprintf(stderr,"valid state of the optimization loop.\n");
+        return 0;
+    }
+    fprintf(stdout,"Closing file.\n");
 
-    // Vizualize the norm of the shape gradient at the boundary vertices
-    if (pParameters->opt_mode!=1)
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function restartFromCheckpoint prepares the optimization loop to resume
+// after the pCheckpoint->iter iteration, once the state of an interrupted run
+// has been loaded by the readCheckpointFile function and the chemistry by the
+// loadChemistry one. It checks that the data match the chemical system,
+// truncates the *.data and *.hist files back to their size at the checkpoint
+// (getSizeOrTruncateOutputFiles), writes back the current mesh in the
+// pParameters->name_mesh file for the tetrahedral modes (the external softwares
+// work on it), and moves the global initial timer back so that the cumulated
+// times continue the ones of the interrupted run. It has the Parameters*,
+// Mesh*, Data*, ChemicalSystem*, Checkpoint* (defined in main.h), and time_t*
+// pGlobalInitialTimer variables as input arguments and it returns one on
+// success, otherwise zero
+/* ************************************************************************** */
+int restartFromCheckpoint(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                          ChemicalSystem* pChemicalSystem,
+                          Checkpoint* pCheckpoint, time_t* pGlobalInitialTimer)
+{
+    // Check the input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                           pChemicalSystem==NULL || pCheckpoint==NULL ||
+                                                     pGlobalInitialTimer==NULL)
     {
-        if (pParameters->save_print>0)
-        {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==3)
-            {
-                if (!writingSolFile(pParameters,pMesh))
-                {
-                    PRINT_ERROR("In saveTheShapeGradient: writingSolFile ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    return 0;
-                }
+        PRINT_ERROR("In restartFromCheckpoint: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pCheckpoint=%p, or ",(void*)pCheckpoint);
+        fprintf(stderr,"pGlobalInitialTimer=%p ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
 
-                if (!plotMeshWithMeditSoftware(pParameters))
-                {
-                     PRINT_ERROR("In saveTheShapeGradient: ");
-                     fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                     fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
-                }
-            }
-        }
+    // Check that the data were computed with the same chemical system
+    if (pData->nmat!=pChemicalSystem->nmorb ||
+                                       pData->nprob!=pChemicalSystem->nmorb+1 ||
+                   pCheckpoint->iter<1 || pCheckpoint->iter>=pData->ndata)
+    {
+        PRINT_ERROR("In restartFromCheckpoint: the checkpoint stores data ");
+        fprintf(stderr,"for %d molecular orbitals ",pData->nmat);
+        fprintf(stderr,"(at iteration %d) whereas ",pCheckpoint->iter);
+        fprintf(stderr,"the chemical system has ");
+        fprintf(stderr,"%d ones.\n",pChemicalSystem->nmorb);
+        return 0;
     }
 
-    // Save the vectorial shape gradient at the shape vertices
-    if (!writingShapeSolFile(pParameters,pMesh))
+    // Remove the records appended by the interrupted run after its checkpoint
+    if (!getSizeOrTruncateOutputFiles(pParameters,pCheckpoint,1))
     {
-        PRINT_ERROR("In saveTheShapeGradient: writingShapeSolFile function ");
-        fprintf(stderr,"returned zero instead of one.\n");
+        PRINT_ERROR("In restartFromCheckpoint: getSizeOrTruncateOutputFiles ");
+        fprintf(stderr,"function returned zero instead of one.\n");
         return 0;
     }
 
-    // Vizualize the vectorial shape gradient at the shape vertices
-    if (pParameters->opt_mode!=1)
+    // The softwares used in tetrahedral modes read the mesh from the disk
+    if (pParameters->opt_mode>0)
     {
-        if (pParameters->save_print>0)
+        if (!writingMeshFile(pParameters,pMesh))
         {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==4)
-            {
-                if (!plotMeshWithMeditSoftware(pParameters))
-                {
-                    PRINT_ERROR("In saveTheShapeGradient: ");
-                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
-                }
-            }
+            PRINT_ERROR("In restartFromCheckpoint: writingMeshFile function ");
+            fprintf(stderr,"returned zero instead of one.\n");
+            return 0;
         }
     }
 
+    // Continue the cumulated time of the interrupted run
+    *pGlobalInitialTimer-=(time_t)pData->ctim[pCheckpoint->iter];
+
     return 1;
 }
 
 /* ************************************************************************** */
-// The function computeEulerianMode contains successive functions that are
-// used to specifically compute the Eulerian mode in the optimization function
-// It has the Parameters*, Mesh*, (both defined in main.h), and the int
-// interationInTheLoop variables as input arguments. It returns one on success
-// otherwise zero if an error is encoutnered during the process
+// The function compareCandidateHexahedra is the comparison function given to
+// qsort in order to sort the Candidate structures (defined in main.h) by
+// increasing position of their hexahedron. It has two const void* variables
+// (pointing to Candidate structures) as input arguments and it returns a
+// negative (respectively zero, positive) integer if the first hexahedron is
+// located before (resp. at the same position as, after) the second one
 /* ************************************************************************** */
-int computeEulerianMode(Parameters* pParameters, Mesh* pMesh,
-                                                         int iterationInTheLoop)
+int compareCandidateHexahedra(const void* pCandidate1, const void* pCandidate2)
 {
-    // Check that the input variables are not pointing to NULL
-    if (pParameters==NULL || pMesh==NULL)
+    int hex1=((const Candidate*)pCandidate1)->hex;
+    int hex2=((const Candidate*)pCandidate2)->hex;
+
+    return (hex1>hex2)-(hex1<hex2);
+}
+
+/* ************************************************************************** */
+// The function compareCandidateVariations is the comparison function given to
+// qsort in order to sort the Candidate structures (defined in main.h) by
+// decreasing first-order variation of the probability (the position of the
+// hexahedra is used to break ties so that the order does not depend on the
+// qsort implementation). It has two const void* variables (pointing to
+// Candidate structures) as input arguments and it returns a negative
+// (respectively zero, positive) integer if the first candidate must be tried
+// before (resp. at the same time as, after) the second one
+/* ************************************************************************** */
+int compareCandidateVariations(const void* pCandidate1, const void* pCandidate2)
+{
+    const Candidate *pC1=(const Candidate*)pCandidate1;
+    const Candidate *pC2=(const Candidate*)pCandidate2;
+
+    if (pC1->dp!=pC2->dp)
     {
-        PRINT_ERROR("In computeEulerianMode: at least one of the input ");
-        fprintf(stderr,"variable pParameters=%p or",(void*)pParameters);
-        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
-        fprintf(stderr,"address.\n");
-        return 0;
+        return (pC1->dp<pC2->dp)-(pC1->dp>pC2->dp);
     }
 
-    // Check the pParameters->opt_mode variable
-    if (pParameters->opt_mode!=1 && pParameters->opt_mode!=2)
+    return (pC1->hex>pC2->hex)-(pC1->hex<pC2->hex);
+}
+
+/* ************************************************************************** */
+// The function computeProbabilityOfModifiedDomain evaluates the overlap matrix
+// of the domain whose overlap-matrix coefficients are stored in pCoefficient,
+// when the kHexahedron-th hexahedron is added to it (sign=1) or removed from
+// it (sign=-1). The resulting matrix is stored in the coef variable of
+// pData->pmat[iterationInTheLoop%nring], which is then diagonalized in order to
+// compute the associated probability in pData->pnu[iterationInTheLoop]. It has
+// the Parameters*, Mesh*, Data*, ChemicalSystem* (defined in main.h), the
+// double* pCoefficient and the three int variables iterationInTheLoop,
+// kHexahedron, and sign as input arguments. It returns one on success,
+// otherwise zero is returned
+/* ************************************************************************** */
+int computeProbabilityOfModifiedDomain(Parameters* pParameters, Mesh* pMesh,
+                                       Data* pData,
+                                       ChemicalSystem* pChemicalSystem,
+                                       int iterationInTheLoop,
+                                       double* pCoefficient, int kHexahedron,
+                                                                       int sign)
+{
+    int i=0, j=0, l=0, lI=0, lJ=0, nMorb=0, nGauss=0;
+    double integral=0.;
+    MolecularOrbital *pMolecularOrbitalI=NULL, *pMolecularOrbitalJ=NULL;
+    OverlapMatrix *pOverlapMatrix=NULL;
+
+    // Check input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                                 pChemicalSystem==NULL || pCoefficient==NULL)
     {
-        PRINT_ERROR("In computeEulerianMode: the pParameters->opt_mode ");
-        fprintf(stderr,"variable (=%d) can only be set ",pParameters->opt_mode);
-        fprintf(stderr,"to one or two here.\n");
+        PRINT_ERROR("In computeProbabilityOfModifiedDomain: at least one of ");
+        fprintf(stderr,"the input variables pParameters=%p, ",
+                                                           (void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"or pCoefficient=%p ",(void*)pCoefficient);
+        fprintf(stderr,"does not point to a valid address.\n");
         return 0;
     }
 
-    // Check the iterationInTheLoopVariable variable
-    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    // Check the hexahedron and the type of modification
+    if (kHexahedron<0 || kHexahedron>=pMesh->nhex || (sign!=1 && sign!=-1))
     {
-        PRINT_ERROR("In computeEulerianMode: the input iterationInTheLoop ");
-        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
-        fprintf(stderr,"positive integer not (strictly) greater than the ");
-        fprintf(stderr,"maximal number of allowed iterations ");
-        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        PRINT_ERROR("In computeProbabilityOfModifiedDomain: the input ");
+        fprintf(stderr,"kHexahedron variable (=%d) should be ",kHexahedron);
+        fprintf(stderr,"a non-negative integer (strictly) less than the ");
+        fprintf(stderr,"total number of hexahedra (=%d), and ",pMesh->nhex);
+        fprintf(stderr,"the sign variable (=%d) should be set to ",sign);
+        fprintf(stderr,"plus or minus one.\n");
         return 0;
     }
 
-    // Extend the shape gradient outside the domain thanks to the elasticity
-    if (!extendShapeGradientWithElasticSoftware(pParameters))
-    {
-        PRINT_ERROR("In computeEulerianMode: ");
-        fprintf(stderr,"extendLevelSetWithElasticSoftware function returned ");
-        fprintf(stderr,"zero instead of one.\n");
-        return 0;
-    }
+    nMorb=pChemicalSystem->nmorb;
+    nGauss=pChemicalSystem->ngauss;
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
 
-    // Vizualize the extension of the vectorial shape gradient
-    if (pParameters->opt_mode==2)
+    // Evaluating S(Omega+kHexahedron) or S(Omega-kHexahedron)
+    for (i=0; i<nMorb; i++)
     {
-       if (pParameters->save_print>0)
+        pMolecularOrbitalI=&pChemicalSystem->pmorb[i];
+
+        // Avoid calculation for restricted Hartree-Fock system
+        if (pParameters->orb_rhf)
         {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==5)
+            if (i>=nMorb/2)
             {
-                if (!plotMeshWithMeditSoftware(pParameters))
+                continue;
+            }
+        }
+
+        for (j=0; j<=i; j++)
+        {
+            pMolecularOrbitalJ=&pChemicalSystem->pmorb[j];
+
+            // Compute the three-dimensional integral analytically
+            integral=0.;
+            for (lI=0; lI<nGauss; lI++)
+            {
+                for (lJ=0; lJ<nGauss; lJ++)
                 {
-                    PRINT_ERROR("In computeEulerianMode: ");
-                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
+                    integral+=evaluateTripleIntegralIJ(pParameters,pMesh,
+                                                       pChemicalSystem,
+                                                       pMolecularOrbitalI,
+                                                       pMolecularOrbitalJ,
+                                                       lI,lJ,kHexahedron);
                 }
             }
+            pOverlapMatrix->coef[i*nMorb+j]=pCoefficient[i*nMorb+j]+
+                                                                  sign*integral;
         }
-
-        fprintf(stdout,"\nSTEP 2: GET THE LEVEL-SET FUNCTION OF ");
-        fprintf(stdout,"THE DOMAIN WITH A UNITARY GRADIENT NORM.\n");
     }
 
-    // Generate the level-set function from mesh with mshdist
-    if (!computeLevelSet(pParameters,pMesh,iterationInTheLoop))
+    // Complete using the symmetry of the matrix
+    for (i=0; i<nMorb; i++)
     {
-        PRINT_ERROR("In computeEulerianMode: computeLevelSet function ");
-        fprintf(stderr,"returned zero instead of one.\n");
-        return 0;
+        for (j=i+1; j<nMorb; j++)
+        {
+            pOverlapMatrix->coef[i*nMorb+j]=pOverlapMatrix->coef[j*nMorb+i];
+        }
     }
 
-    if (pParameters->opt_mode==2)
+    // Complete matrix in the case of a restricted Hartree-Fock system
+    if (pParameters->orb_rhf)
     {
-        fprintf(stdout,"\nSTEP 3: ADVECT THE LEVEL-SET FUNCTION ");
-        fprintf(stdout,"ACCORDING TO THE EXTENDED SHAPE GRADIENT.\n");
+        l=nMorb/2;
+        for (i=0; i<l; i++)
+        {
+            for (j=0; j<l; j++)
+            {
+                pOverlapMatrix->coef[(i+l)*nMorb+(j+l)]=
+                                                pOverlapMatrix->coef[i*nMorb+j];
+            }
+        }
     }
 
-    // Advect the level-set function according to the parameters
-    if (!advectLevelSetWithAdvectSoftware(pParameters))
+    // Diagonalize the overlap matrix. Warning here: we use lapacke.h,
+    // and lapacke package must have been previously installed
+    if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
     {
-        PRINT_ERROR("In computeEulerianMode:  ");
-        fprintf(stderr,"advectLevelSetWithAdvectSoftware function ");
-        fprintf(stderr,"returned zero instead of one.\n");
+        PRINT_ERROR("In computeProbabilityOfModifiedDomain: ");
+        fprintf(stderr,"diagonalizeOverlapMatrix function returned zero ");
+        fprintf(stderr,"instead of one.\n");
         return 0;
     }
 
-    // Vizualize the advected level-set function on the mesh
-    if (pParameters->opt_mode==2)
+    // Compute the probabilities and total population inside the domain
+    if (!computeProbability(pParameters,pData,iterationInTheLoop))
     {
-        if (pParameters->save_print>0)
-        {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==6)
-            {
-                if (!plotMeshWithMeditSoftware(pParameters))
-                {
-                    PRINT_ERROR("In computeEulerianMode: ");
-                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
-                }
-            }
-        }
+        PRINT_ERROR("In computeProbabilityOfModifiedDomain: ");
+        fprintf(stderr,"computeProbability function returned zero instead ");
+        fprintf(stderr,"of one.\n");
+        return 0;
     }
 
     return 1;
 }
 
 /* ************************************************************************** */
-// The function computeLagrangianMode contains successive functions that are
-// used to specifically compute the Lagrangian mode in the optimization function
-// It has the Parameters*, Mesh*, (both defined in main.h), and the int
-// interationInTheLoop variables as input arguments. It returns one on success
-// otherwise zero if an error is encoutnered during the process
+// The function rankCandidatesWithShapeGradient evaluates the shape gradient of
+// the probability (associated with the domain of the previous iteration) at
+// the center of the boundary quadrilaterals in order to predict, at first
+// order, the variation of the probability when an hexahedron touching the
+// boundary of the domain is added (if outside) or removed (if inside). Each
+// hexahedron is stored once in pCandidate (which must have at least 2*nadj
+// elements) and the candidates are sorted by decreasing predicted variation.
+// It has the Parameters*, Mesh*, Data*, ChemicalSystem*, Candidate* (defined
+// in main.h), the int iterationInTheLoop and int* pNumberOfCandidates (where
+// the number of distinct candidates is stored) variables as input arguments.
+// It returns one on success, otherwise zero is returned
 /* ************************************************************************** */
-int computeLagrangianMode(Parameters* pParameters, Mesh* pMesh,
-                                                         int iterationInTheLoop)
+int rankCandidatesWithShapeGradient(Parameters* pParameters, Mesh* pMesh,
+                                    Data* pData,
+                                    ChemicalSystem* pChemicalSystem,
+                                    int iterationInTheLoop,
+                                    Candidate* pCandidate,
+                                                       int* pNumberOfCandidates)
 {
-    int sizeMemory=0, nIter=0;
+    int k=0, l=0, p=0, p1=0, p3=0, i1=0, i3=0, j1=0, j3=0, nAdj=0;
+    int nCandidate=0;
+    double px=0., py=0., pz=0., value=0., area=0.;
+    Probabilities *pProbabilities=NULL;
+    OverlapMatrix *pOverlapMatrix=NULL;
 
-    // Check that the input variables are not pointing to NULL
-    if (pParameters==NULL || pMesh==NULL)
+    // Check input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                                     pChemicalSystem==NULL ||
+                                 pCandidate==NULL || pNumberOfCandidates==NULL)
     {
-        PRINT_ERROR("In computeLagrangianMode: at least one of the input ");
-        fprintf(stderr,"variable pParameters=%p or",(void*)pParameters);
-        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
-        fprintf(stderr,"address.\n");
+        PRINT_ERROR("In rankCandidatesWithShapeGradient: at least one of ");
+        fprintf(stderr,"the input variables pParameters=%p, ",
+                                                           (void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pCandidate=%p, or ",(void*)pCandidate);
+        fprintf(stderr,"pNumberOfCandidates=%p ",(void*)pNumberOfCandidates);
+        fprintf(stderr,"does not point to a valid address.\n");
         return 0;
     }
+    *pNumberOfCandidates=0;
 
-    // Check the pParameters->opt_mode variable
-    if (pParameters->opt_mode!=1 && pParameters->opt_mode!=3)
+    // Check the iterationInTheLoop variable and the Adjacency structures
+    nAdj=pMesh->nadj;
+    if (iterationInTheLoop<1 || nAdj<1 || pMesh->padj==NULL ||
+                                                            pMesh->pqua==NULL)
     {
-        PRINT_ERROR("In computeLagrangianMode: the pParameters->opt_mode ");
-        fprintf(stderr,"variable (=%d) can only be set ",pParameters->opt_mode);
-        fprintf(stderr,"to one or three here.\n");
+        PRINT_ERROR("In rankCandidatesWithShapeGradient: the input ");
+        fprintf(stderr,"iterationInTheLoop variable (=%d) ",iterationInTheLoop);
+        fprintf(stderr,"and the number of Adjacency structures (=%d) ",nAdj);
+        fprintf(stderr,"should be positive integers, and the structure ");
+        fprintf(stderr,"pointed by pMesh should store the Adjacency ");
+        fprintf(stderr,"(padj=%p) and ",(void*)pMesh->padj);
+        fprintf(stderr,"Quadrilateral (pqua=%p) ",(void*)pMesh->pqua);
+        fprintf(stderr,"structures.\n");
         return 0;
     }
 
-    // Check the iterationInTheLoopVariable variable
-    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    // The shape gradient is associated with the domain of the previous
+    // iteration (overlap matrix diagonalized and probabilities computed)
+    pProbabilities=&pData->pprob[(iterationInTheLoop-1)%pData->nring];
+    pOverlapMatrix=&pData->pmat[(iterationInTheLoop-1)%pData->nring];
+
+    for (k=0; k<nAdj; k++)
     {
-        PRINT_ERROR("In computeLagrangianMode: the input iterationInTheLoop ");
-        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
-        fprintf(stderr,"positive integer not (strictly) greater than the ");
-        fprintf(stderr,"maximal number of allowed iterations ");
-        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
-        return 0;
+        // Load the center point coordinates in the k-th quadrilateral
+        l=pMesh->padj[k].quad;
+
+        p1=pMesh->pqua[l-1].p1;
+        px=pMesh->pver[p1-1].x;
+        py=pMesh->pver[p1-1].y;
+        pz=pMesh->pver[p1-1].z;
+
+        p=pMesh->pqua[l-1].p2;
+        px+=pMesh->pver[p-1].x;
+        py+=pMesh->pver[p-1].y;
+        pz+=pMesh->pver[p-1].z;
+
+        p3=pMesh->pqua[l-1].p3;
+        px+=pMesh->pver[p3-1].x;
+        py+=pMesh->pver[p3-1].y;
+        pz+=pMesh->pver[p3-1].z;
+
+        p=pMesh->pqua[l-1].p4;
+        px+=pMesh->pver[p-1].x;
+        py+=pMesh->pver[p-1].y;
+        pz+=pMesh->pver[p-1].z;
+
+        px*=.25;
+        py*=.25;
+        pz*=.25;
+
+        // Computing the shape gradient of the probability at this point
+        value=evaluateShapeGradientAtThePoint(px,py,pz,pData->nprob,
+                                              pProbabilities,
+                                              pParameters->nu_electrons,
+                                              pOverlapMatrix,pChemicalSystem);
+
+        // Area of the quadrilateral from its orientation in the grid
+        l=(p1-1)/pParameters->n_z;
+        i1=l/pParameters->n_y;
+        j1=l%pParameters->n_y;
+
+        l=(p3-1)/pParameters->n_z;
+        i3=l/pParameters->n_y;
+        j3=l%pParameters->n_y;
+
+        if (i1==i3)
+        {
+            area=pParameters->delta_y*pParameters->delta_z;
+        }
+        else if (j1==j3)
+        {
+            area=pParameters->delta_x*pParameters->delta_z;
+        }
+        else
+        {
+            area=pParameters->delta_x*pParameters->delta_y;
+        }
+
+        // Adding the outer hexahedron (resp. removing the inner one) moves
+        // the boundary along (resp. against) the outward normal
+        pCandidate[2*k].hex=pMesh->padj[k].hexout;
+        pCandidate[2*k].dp=value*area;
+        pCandidate[2*k+1].hex=pMesh->padj[k].hexin;
+        pCandidate[2*k+1].dp=-value*area;
     }
 
-    // Free the memory allocated for the mesh
-    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    // Gather the contributions of the hexahedra having several boundary faces
+    qsort(pCandidate,2*nAdj,sizeof(Candidate),compareCandidateHexahedra);
+    for (k=0; k<2*nAdj; k++)
     {
-        sizeMemory=sizeof(Mesh)+(pMesh->nver)*sizeof(Point);
-        sizeMemory+=(pMesh->nnorm+pMesh->ntan)*sizeof(Vector);
-        sizeMemory+=(pMesh->nedg)*sizeof(Edge);
-        sizeMemory+=(pMesh->ntri)*sizeof(Triangle);
-        sizeMemory+=(pMesh->ntet)*sizeof(Tetrahedron);
-        fprintf(stdout,"\nCleaning the allocated memory ");
-        fprintf(stdout,"(%d,%d Mo) for ",sizeMemory/1000000,sizeMemory%1000000);
-        fprintf(stdout,"a mesh adaptation according to the shape gradient ");
-        fprintf(stdout,"with a Lagrangian approach.\n");
+        if (nCandidate>0 && pCandidate[nCandidate-1].hex==pCandidate[k].hex)
+        {
+            pCandidate[nCandidate-1].dp+=pCandidate[k].dp;
+        }
+        else
+        {
+            pCandidate[nCandidate]=pCandidate[k];
+            nCandidate++;
+        }
     }
-    freeMeshMemory(pMesh);
 
-    // Warning: mmg3d software must have been previously installed
-    if (!adaptMeshWithMmg3dSoftware(pParameters,"lag"))
+    // Sort the candidates by decreasing predicted variation of probability
+    qsort(pCandidate,nCandidate,sizeof(Candidate),compareCandidateVariations);
+    *pNumberOfCandidates=nCandidate;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function prunedSearchAlgorithm is the pruned version of the exhaustive
+// search (used if pParameters->n_prune is positive). The hexahedra touching
+// the boundary of the domain are ranked by the rankCandidatesWithShapeGradient
+// function and tried in this order: those increasing the probability are
+// retained (their label is set to -3 or -2) and the search stops after
+// pParameters->n_prune consecutive candidates that do not increase the
+// probability. The overlap-matrix coefficients of the current domain and its
+// probability are updated in pCoefficient and pProbabilityValue. It has the
+// Parameters*, Mesh*, Data*, ChemicalSystem* (defined in main.h), the int
+// iterationInTheLoop, double* pCoefficient and double* pProbabilityValue
+// variables as input arguments. It returns one on success, otherwise zero
+/* ************************************************************************** */
+int prunedSearchAlgorithm(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                          ChemicalSystem* pChemicalSystem,
+                          int iterationInTheLoop, double* pCoefficient,
+                                                     double* pProbabilityValue)
+{
+    int i=0, j=0, k=0, kHexahedron=0, nMorb=0, nCandidate=0, nFail=0, sign=0;
+    double *pCoefficientNew=NULL;
+    Candidate *pCandidate=NULL;
+
+    // Check input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                                   pChemicalSystem==NULL ||
+                                 pCoefficient==NULL || pProbabilityValue==NULL)
     {
-        PRINT_ERROR("In computeLagrangianMode: adaptMeshWithMmg3dSoftware ");
-        fprintf(stderr,"function returned zero instead of one.\n");;
+        PRINT_ERROR("In prunedSearchAlgorithm: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pCoefficient=%p, or ",(void*)pCoefficient);
+        fprintf(stderr,"pProbabilityValue=%p ",(void*)pProbabilityValue);
+        fprintf(stderr,"does not point to a valid address.\n");
         return 0;
     }
 
-    // Read the intermediate *.mesh file
-    if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+    if (pParameters->n_prune<1 || pMesh->nadj<1)
     {
-        PRINT_ERROR("In computeLagrangianMode: readMeshFileAndAllocateMesh ");
-        fprintf(stderr,"function returned zero instead of one.\n");
+        PRINT_ERROR("In prunedSearchAlgorithm: the n_prune variable ");
+        fprintf(stderr,"(=%d) of the structure ",pParameters->n_prune);
+        fprintf(stderr,"pointed by pParameters and the number of Adjacency ");
+        fprintf(stderr,"structures (=%d) should be positive ",pMesh->nadj);
+        fprintf(stderr,"integers.\n");
         return 0;
     }
 
-    // Update the parameters related to the computational box
-    if (!updateDiscretizationParameters(pParameters,pMesh))
+    // Allocate memory for the candidates (two per boundary quadrilateral)
+    // calloc returns a pointer to the allocated memory, otherwise NULL
+    pCandidate=(Candidate*)calloc(2*pMesh->nadj,sizeof(Candidate));
+    if (pCandidate==NULL)
     {
-        PRINT_ERROR("In computeLagrangianMode: ");
-        fprintf(stderr,"updateDiscretizationParameters function returned ");
+        PRINT_ERROR("In prunedSearchAlgorithm: could not allocate memory ");
+        fprintf(stderr,"for the local Candidate* pCandidate variable.\n");
+        return 0;
+    }
+
+    if (!rankCandidatesWithShapeGradient(pParameters,pMesh,pData,
+                                         pChemicalSystem,iterationInTheLoop,
+                                                      pCandidate,&nCandidate))
+    {
+        PRINT_ERROR("In prunedSearchAlgorithm: ");
+        fprintf(stderr,"rankCandidatesWithShapeGradient function returned ");
         fprintf(stderr,"zero instead of one.\n");
+        free(pCandidate);
+        pCandidate=NULL;
         return 0;
     }
 
-    // Vizualize the intermediate mesh
-    if (pParameters->opt_mode==3)
+    nMorb=pChemicalSystem->nmorb;
+    pCoefficientNew=pData->pmat[iterationInTheLoop%pData->nring].coef;
+
+    fprintf(stdout,"\nModifying the internal domain cube by cube following ");
+    fprintf(stdout,"the shape gradient (%d candidates).\n",nCandidate);
+
+    for (k=0; k<nCandidate; k++)
     {
-        if (pParameters->save_print>0)
+        // Stop after n_prune consecutive candidates that do not improve
+        if (nFail>=pParameters->n_prune)
         {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==7)
-            {
-                if (!plotMeshWithMeditSoftware(pParameters))
-                {
-                    PRINT_ERROR("In computeLagrangianMode: ");
-                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
-                }
-            }
+            break;
         }
-    }
 
-    if (pParameters->opt_mode==3)
-    {
-        fprintf(stdout,"\nSTEP 2: ADAPT THE MESH TO BOTH THE NEW DOMAIN ");
-        fprintf(stdout,"GEOMETRY AND SYSTEM CHEMISTRY.\n");
-    }
+        // Add the hexahedron if outside, otherwise remove it
+        kHexahedron=pCandidate[k].hex-1;
+        sign=(pMesh->phex[kHexahedron].label==2)? 1: -1;
 
-    // Generate a coarse level-set function of the intermediate mesh
-    nIter=pParameters->n_iter;
-    pParameters->n_iter=10;
-    if (!renormalizeWithMshdistSoftware(pParameters,"dom"))
-    {
-        PRINT_ERROR("In computeLagrangianMode: ");
-        fprintf(stderr,"renormalizeWithMshdistSoftware function returned ");
-        fprintf(stderr,"zero instead of one.\n");
-        return 0;
-    }
-    pParameters->n_iter=nIter;
+        if (!computeProbabilityOfModifiedDomain(pParameters,pMesh,pData,
+                                                pChemicalSystem,
+                                                iterationInTheLoop,
+                                                pCoefficient,kHexahedron,sign))
+        {
+            PRINT_ERROR("In prunedSearchAlgorithm: ");
+            fprintf(stderr,"computeProbabilityOfModifiedDomain function ");
+            fprintf(stderr,"returned zero instead of one.\n");
+            free(pCandidate);
+            pCandidate=NULL;
+            return 0;
+        }
 
-    // Vizualize the coarse level-set function of the intermediate mesh
-    if (pParameters->opt_mode==3)
-    {
-        if (pParameters->save_print>0)
+        if (pData->pnu[iterationInTheLoop]>*pProbabilityValue)
         {
-            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==2)
+            if (pParameters->verbose)
             {
-                if (!plotMeshWithMeditSoftware(pParameters))
+                if (sign>0)
                 {
-                    PRINT_ERROR("In computeLagrangianMode: ");
-                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    return 0;
+                    fprintf(stdout,"Adding the %d-th ",kHexahedron+1);
+                    fprintf(stdout,"hexahedron to the domain: ");
+                    fprintf(stdout,"P(Omega+Hexa)=%.8lf\n",
+                                               pData->pnu[iterationInTheLoop]);
+                }
+                else
+                {
+                    fprintf(stdout,"Removing the %d-th ",kHexahedron+1);
+                    fprintf(stdout,"hexahedron of the domain: ");
+                    fprintf(stdout,"P(Omega-Hexa)=%.8lf\n",
+                                               pData->pnu[iterationInTheLoop]);
+                }
+            }
+            pMesh->phex[kHexahedron].label=(sign>0)? -3: -2;
+
+            // Update pCoefficient and probability
+            *pProbabilityValue=pData->pnu[iterationInTheLoop];
+            for (i=0; i<nMorb; i++)
+            {
+                for (j=0; j<nMorb; j++)
+                {
+                    pCoefficient[i*nMorb+j]=pCoefficientNew[i*nMorb+j];
                 }
             }
+            nFail=0;
+        }
+        else
+        {
+            nFail++;
         }
     }
 
+    fprintf(stdout,"%d candidates tried over %d.\n",k,nCandidate);
+
+    free(pCandidate);
+    pCandidate=NULL;
+
     return 1;
 }
 
 /* ************************************************************************** */
-// The function computeProbabilityAndReloadPreviousMesh compute the probability
-// of a given mesh then reload the previous mesh in the structure pointed by
-// pMesh. It has the Parameters*, Mesh*, Data*, ChemicalSystem* (both defined in
-// main.h), and the int interationInTheLoop variables as input arguments. It
-// returns the value of the probability on success otherwise -10000 for an error
-/* ************************************************************************** */
-double computeProbabilityAndReloadPreviousMesh(Parameters* pParameters,
-                                               Mesh* pMesh, Data* pData,
-                                               ChemicalSystem* pChemicalSystem,
+// The function exhaustiveSearchAlgorithm computes the pParameters->opt_mode=-2
+// of the optimization function. It tries to add or remove the hexahedra that
+// are touching the boundary of the domain. Only those increasing the
+// probability are retained. It has the Parameters*, Mesh*, Data*,
+// ChemicalSystem* (both defined in main.h) and the int iterationInTheLoop
+// variables as input arguments. It returns one on success otherwise zero
+/* ************************************************************************** */
+int exhaustiveSearchAlgorithm(Parameters* pParameters, Mesh* pMesh,
+                               Data* pData, ChemicalSystem* pChemicalSystem,
                                                          int iterationInTheLoop)
 {
-    size_t lengthName=0;
-    char *fileLocation=NULL;
-    int sizeMemory=0;
-    double returnValue=0.;
+    int i=0, j=0, k=0, kHexahedron=0, nHex=0, nAdj=0, nMorb=0, nGauss=0;
+    int lPrint=0;
+    double *pCoefficient=NULL, *pProbabilityOld=NULL, *pProbability=NULL;
+    double probability=0.;
+    OverlapMatrix *pOverlapMatrix=NULL, *pOverlapMatrixOld=NULL;
 
-    // Computing overlap matrix. Warning: bounadary triangles are labbelled 10
-    // but not necessarily the related vertices (ok now and checked in
-    // writeShapeSolFile function)
-    if (!computeOverlapMatrix(pParameters,pMesh,pData,pChemicalSystem,2,
-                                                            iterationInTheLoop))
-    {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-        fprintf(stderr,"computeOverlapMatrix function returned zero instead ");
-        fprintf(stderr,"of one.\n");
-        return -10000.;
-    }
+    // Time the search of the hexahedra to add or remove in the profiler
+    beginProfilerPhase(&globalProfiler,PROF_SEARCH);
 
-    // Diagonalize the overlap matrix. Warning: we use lapacke.h
-    // and lapacke package must have been previously installed
-    if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
+    // Check input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                                                          pChemicalSystem==NULL)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-        fprintf(stderr,"diagonalizeOverlapMatrix function returned zero ");
-        fprintf(stderr,"instead of one.\n");
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: at least one of the ");
+        fprintf(stderr,"input variables pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
+        fprintf(stderr,"does not point to a valid address.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    // Compute the probabilities and total population in the domain
-    if (!computeProbability(pParameters,pData,iterationInTheLoop))
+    // Check the iterationInTheLoopVariable variable
+    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-        fprintf(stderr,"computeProbability function returned zero instead ");
-        fprintf(stderr,"of one.\n");
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the input ");
+        fprintf(stderr,"iterationInTheLoop variable (=%d) ",iterationInTheLoop);
+        fprintf(stderr,"should be a positive integer not (strictly) ");
+        fprintf(stderr,"greater than the maximal number of allowed ");
+        fprintf(stderr,"iterations (=%d).\n",pParameters->iter_max);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
-    returnValue=pData->pnu[iterationInTheLoop];
 
-    // Store the name of the *.mesh file in fileLocation
-    lengthName=pParameters->name_length;
-    fileLocation=(char*)calloc(lengthName,sizeof(char));
-    if (fileLocation==NULL)
+    // Check that we are dealing with the right optimization mode
+    if (pParameters->opt_mode!=-2)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: could not ");
-        fprintf(stderr,"allocate memory for the local char* fileLocation ");
-        fprintf(stderr,"variable.\n");
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the function can only be ");
+        fprintf(stderr,"used when the optimization mode ");
+        fprintf(stderr,"(=%d) is set to minus two.\n",pParameters->opt_mode);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    // Store the *.[iterationInTheLoop-1].mesh name in fileLocation
-    strncpy(fileLocation,pParameters->name_mesh,lengthName);
-    lengthName=strlen(fileLocation);
-    fileLocation[lengthName-5]='\0';
-
-    // sprintf returns the total number of characters written
-    // not including the '\0', otherwise a negative number on failure
-    if (sprintf(pParameters->name_mesh,"%s.%d.mesh",fileLocation,
-                                                        iterationInTheLoop-1)<0)
+    // Check the number of hexahedra and its associated pointer
+    nHex=pMesh->nhex;
+    if (nHex<1)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: the ");
-        fprintf(stderr,"standard sprintf c-function returned an unexpected ");
-        fprintf(stderr,"negative value.\n");
-        free(fileLocation);
-        fileLocation=NULL;
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
+        fprintf(stderr,"hexahedra (=%d) in the structure pointed ",nHex);
+        fprintf(stderr,"by pMesh should be a positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
-    fileLocation[lengthName-5]='.';
 
-    // Check if *.[iterationInTheLoop-1].mesh file exists.
-    if (initialFileExists(pParameters->name_mesh,pParameters->name_length)!=1)
+    if (pMesh->phex==NULL)
     {
-            PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-            fprintf(stderr,"initialFileExists function did not return one, ");
-            fprintf(stderr,"which was the expected value here.\n");
-            free(fileLocation);
-            fileLocation=NULL;
-            return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the structure pointed by ");
+        fprintf(stderr,"pMesh does not store any hexahedra ");
+        fprintf(stderr,"(pMesh->phex=%p).\n",(void*)pMesh->phex);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    // Check if *.mesh file exists and remove it
-    if (initialFileExists(fileLocation,pParameters->name_length)!=1)
+    // Check the number of boundary quadrilaterals and its associated pointer
+    nAdj=pMesh->nadj;
+    if (nAdj<1)
     {
-            PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-            fprintf(stderr,"initialFileExists function did not return one, ");
-            fprintf(stderr,"which was the expected value here.\n");
-            free(fileLocation);
-            fileLocation=NULL;
-            return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
+        fprintf(stderr,"Adjacency structures (=%d) in the structure ",nAdj);
+        fprintf(stderr,"pointed by pMesh should be a positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    if (remove(fileLocation))
+    if (pMesh->padj==NULL)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: wrong ");
-        fprintf(stderr,"return (=-1) of the standard remove c-function in ");
-        fprintf(stderr,"the attempt of removing the %s file.\n",fileLocation);
-        free(fileLocation);
-        fileLocation=NULL;
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the structure pointed by ");
+        fprintf(stderr,"pMesh does not store any Adjacency structures ");
+        fprintf(stderr,"(pMesh->padj=%p).\n",(void*)pMesh->padj);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    // Copy the *.[iterationInTheLoop-1].mesh into *.mesh
-    if (!copyFileLocation(pParameters->name_mesh,pParameters->name_length,
-                                                                  fileLocation))
+    // Check the chemical parameters
+    nMorb=pChemicalSystem->nmorb;
+    if (nMorb<1)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-        fprintf(stderr,"copyFileLocation function returned zero instead ");
-        fprintf(stderr,"of one.\n");
-        free(fileLocation);
-        fileLocation=NULL;
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
+        fprintf(stderr,"molecular orbitals (=%d) should be a positive ",nMorb);
+        fprintf(stderr,"integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
-    strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
 
-    // Free the memory allocated for the mesh
-    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    if (pChemicalSystem->pmorb==NULL)
     {
-        sizeMemory=sizeof(Mesh)+(pMesh->nver)*sizeof(Point);
-        sizeMemory+=(pMesh->nnorm+pMesh->ntan)*sizeof(Vector);
-        sizeMemory+=(pMesh->nedg)*sizeof(Edge);
-        sizeMemory+=(pMesh->ntri)*sizeof(Triangle);
-        sizeMemory+=(pMesh->ntet)*sizeof(Tetrahedron);
-        fprintf(stdout,"\nCleaning the allocated memory ");
-        fprintf(stdout,"(%d,%d Mo) for ",sizeMemory/1000000,sizeMemory%1000000);
-        fprintf(stdout,"reloading the %d-th mesh.\n",iterationInTheLoop-1);
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pmorb variable of ");
+        fprintf(stderr,"the structure pointed by pChemicalSystem is pointing ");
+        fprintf(stderr,"to the %p address.\n",(void*)pChemicalSystem->pmorb);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
-    freeMeshMemory(pMesh);
 
-    // Read the new *.mesh file
-    if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+    nGauss=pChemicalSystem->ngauss;
+    if (nGauss<1)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-        fprintf(stderr,"readMeshFileAndAllocateMesh function returned zero ");
-        fprintf(stderr,"instead of one.\n");
-        free(fileLocation);
-        fileLocation=NULL;
-        return -10000.;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the total number of ");
+        fprintf(stderr,"Gaussian-type primitives (=%d) should be a ",nGauss);
+        fprintf(stderr,"positive integer.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    // Update the parameters related to the computational box
-    if (!updateDiscretizationParameters(pParameters,pMesh))
+    if (pParameters->orb_rhf)
     {
-        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
-        fprintf(stderr,"updateDiscretizationParameters function returned ");
-        fprintf(stderr,"zero instead of one.\n");
-        free(fileLocation);
-        fileLocation=NULL;
-        return -10000.;
+        if (nMorb%2!=0)
+        {
+            PRINT_ERROR("In exhaustiveSearchAlgorithm: since we are dealing ");
+            fprintf(stderr,"with a restricted Hartree-Fock system ");
+            fprintf(stderr,"(pParameters->orb_rhf=%d) ",pParameters->orb_rhf);
+            fprintf(stderr,"the total number of molecular orbitals ");
+            fprintf(stderr," (=%d) should be an even number.\n",nMorb);
+            endProfilerPhase(&globalProfiler,PROF_SEARCH);
+            return 0;
+        }
     }
 
-    // Free the memory allocated for fileLocation
-    free(fileLocation);
-    fileLocation=NULL;
-
-    return returnValue;
-}
-
-/* ************************************************************************** */
-// The function optimization modifies the shape of the MPD domain according to
-// the shape derivative in order to increase to probability. This is the
-// function used iteratively in the optimization loop of the main function.
-// It has the Parameters*, Mesh*, Data*, ChemicalSystem* (both defined in
-// main.h), the int interationInTheLoop, and the three time_t* variables as
-// input arguments. It returns one on success otherwise zero for an error
-/* ************************************************************************** */
-int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
-                 ChemicalSystem* pChemicalSystem, int iterationInTheLoop,
-                 time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
-                                                         time_t* pEndLocalTimer)
-{
-    int i=0, counter=0, n=0, nMax=0, boolean=0;
-    double tMin=0, tMax=0, t0=0., t1=0., *pShapeGradient=NULL, pMax=0., pMin=0.;
-    double p0=0., p1=0., h=0., deltaT=0., hMin=0.;
-
-    // Check the input pointers
-    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
-                           pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
-                                 pStartLocalTimer==NULL || pEndLocalTimer==NULL)
+    // Check the size of the overlap matrix and its associated pointer
+    if (pData->nmat!=nMorb)
     {
-        PRINT_ERROR("In optimization: one of the input pointers ");
-        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
-        fprintf(stderr,"pData=%p, pMesh=%p, ",(void*)pMesh,(void*)pData);
-        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
-        fprintf(stderr,"pGlobalInitialTimer=%p, ",(void*)pGlobalInitialTimer);
-        fprintf(stderr,"pStartLocalTimer=%p or ",(void*)pStartLocalTimer);
-        fprintf(stderr,"pEndLocalTimer=%p, ",(void*)pEndLocalTimer);
-        fprintf(stderr,"does not point to a valid address.\n");
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the size of the ");
+        fprintf(stderr,"overlap matrix should be (%d)x(%d) ",nMorb,nMorb);
+        fprintf(stderr,"instead of (%d)x(%d).\n",pData->nmat,pData->nmat);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
         return 0;
     }
 
-    // Check the iteration in the loop variable
-    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    if (pData->pmat==NULL)
     {
-        PRINT_ERROR("In optimization: the input iterationInTheLoop variable ");
-        fprintf(stderr,"(=%d) should be a positive ",iterationInTheLoop);
-        fprintf(stderr,"integer not (strictly) greater than the maximal ");
-        fprintf(stderr,"number (=%d) of iterations ",pParameters->iter_max);
-        fprintf(stderr,"allowed in the optimization loop.\n");
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pmat variable of the ");
+        fprintf(stderr,"structure pointed by pData is pointing to the ");
+        fprintf(stderr,"%p address.\n",(void*)pData->pmat);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
         return 0;
     }
+    pOverlapMatrix=&pData->pmat[iterationInTheLoop%pData->nring];
+    pOverlapMatrixOld=&pData->pmat[(iterationInTheLoop-1)%pData->nring];
 
-    // Check the stop criteria
-    boolean=0;
-    if (pParameters->iter_told0p>0.)
+    // Check the coef pointer variable of pOverlapMatrix and pOverlapMatrixOld
+    if (pOverlapMatrix->coef==NULL)
     {
-        if (DEF_ABS(pData->d0p[iterationInTheLoop-1])<pParameters->iter_told0p)
-        {
-            boolean++;
-        }
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the coef variable of the ");
+        fprintf(stderr,"%d-th OverlapMatrix structure ",iterationInTheLoop+1);
+        fprintf(stderr,"is pointing to the %p ",(void*)pOverlapMatrix->coef);
+        fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
-    else
+
+    if (pOverlapMatrixOld->coef==NULL)
     {
-        return -1;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the coef variable of the ");
+        fprintf(stderr,"%d-th OverlapMatrix structure ",iterationInTheLoop);
+        fprintf(stderr,"is pointing to the %p ",(void*)pOverlapMatrixOld->coef);
+        fprintf(stderr,"address.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    if (pParameters->iter_told1p>0.)
+    // Check the population pointer
+    if (pData->pop==NULL)
     {
-        if (DEF_ABS(pData->d1p[iterationInTheLoop-1])<pParameters->iter_told1p)
-        {
-            boolean++;
-        }
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pop variable of the ");
+        fprintf(stderr,"structure pointed by pData is pointing to the ");
+        fprintf(stderr,"%p address.\n",(void*)pData->pop);
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
-    else
+
+    // Allocate memory for pCoefficient
+    // calloc returns a pointer to the allocated memory, otherwise NULL
+    pCoefficient=(double*)calloc(nMorb*nMorb,sizeof(double));
+    if (pCoefficient==NULL)
     {
-        return -1;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: could not allocate memory ");
+        fprintf(stderr,"for the local double* pCoefficient variable.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
 
-    if (pParameters->iter_told2p>0.)
+    // Initializing pCoefficient
+    for (i=0; i<nMorb; i++)
     {
-        if (DEF_ABS(pData->d2p[iterationInTheLoop-1])<pParameters->iter_told2p)
+        for (j=0; j<nMorb; j++)
         {
-            if (pParameters->opt_mode<=0)
-            {
-                return -1;
-            }
-            else
-            {
-                boolean++;
-            }
+            pCoefficient[i*nMorb+j]=pOverlapMatrixOld->coef[i*nMorb+j];
+            pOverlapMatrix->coef[i*nMorb+j]=0.;
         }
     }
-    else
+
+    // Set the probability pointers
+    if (pData->pnu==NULL)
     {
-        return -1;
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: the pnu variable of the ");
+        fprintf(stderr,"structure pointed by pData is pointing to the ");
+        fprintf(stderr,"%p address.\n",(void*)pData->pnu);
+        free(pCoefficient);
+        pCoefficient=NULL;
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
     }
+    pProbabilityOld=&pData->pnu[iterationInTheLoop-1];
+    pProbability=&pData->pnu[iterationInTheLoop];
+    probability=*pProbabilityOld;
 
-    if (boolean==3)
+
+    if (pParameters->n_prune>0)
     {
-        return -1;
+        if (!prunedSearchAlgorithm(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pCoefficient,
+                                                                  &probability))
+        {
+            PRINT_ERROR("In exhaustiveSearchAlgorithm: prunedSearchAlgorithm ");
+            fprintf(stderr,"function returned zero instead of one.\n");
+            free(pCoefficient);
+            pCoefficient=NULL;
+            endProfilerPhase(&globalProfiler,PROF_SEARCH);
+            return 0;
+        }
     }
-
-    switch (pParameters->opt_mode)
+    else
     {
-// Case where Omega_new={dP/dOmega_old>0}
-        case 4:
-
-            fprintf(stdout,"\nSTEP 1: MAKE THE SHAPE GRADIENT A LEVEL-SET ");
-            fprintf(stdout,"FUNCTION WITH UNITARY GRADIENT.\n");
+        fprintf(stdout,"\nModifying exhaustively the internal domain cube by ");
+        fprintf(stdout,"cube.\n");
+        if (!pParameters->verbose)
+        {
+            lPrint=1+nAdj/6;
+        }
 
-            // Save (the opposite of) the shape gradient at all vertices
-            if (!writingSolFile(pParameters,pMesh))
+        for (k=0; k<nAdj; k++)
+        {
+            if (!pParameters->verbose)
             {
-                PRINT_ERROR("In optimization: writingSolFile function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
+                if ((k+1)%lPrint==0)
+                {
+                    fprintf(stdout,"%d %% done.\n",
+                                               (int)(100.*(k+1.)/(double)nAdj));
+                }
             }
 
-            // Vizualize the shape gradient before renormalization
-            if (pParameters->save_print>0)
+            // Try to add kHexahedron to mesh (if not already treated)
+            kHexahedron=pMesh->padj[k].hexout-1;
+
+            if (pMesh->phex[kHexahedron].label!=-3)
             {
-                if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==3)
+                // Evaluating S(Omega+kHexahedron) and its probability
+                if (!computeProbabilityOfModifiedDomain(pParameters,pMesh,pData,
+                                                        pChemicalSystem,
+                                                        iterationInTheLoop,
+                                                        pCoefficient,
+                                                                 kHexahedron,1))
                 {
-                    if (!plotMeshWithMeditSoftware(pParameters))
+                    PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
+                    fprintf(stderr,"computeProbabilityOfModifiedDomain ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pCoefficient);
+                    pCoefficient=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_SEARCH);
+                    return 0;
+                }
+
+                if (*pProbability>probability)
+                {
+                    if (pParameters->verbose)
                     {
-                        PRINT_ERROR("In optimization: ");
-                        fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                        fprintf(stderr,"returned zero instead of one.\n");
-                        return 0;
+                        fprintf(stdout,"Adding the %d-th ",kHexahedron+1);
+                        fprintf(stdout,"hexahedron to the domain: ");
+                        fprintf(stdout,"P(Omega+Hexa)=%.8lf\n",*pProbability);
+                    }
+                    pMesh->phex[kHexahedron].label=-3;
+
+                    // Update pCoefficient and probability
+                    probability=*pProbability;
+                    for (i=0; i<nMorb; i++)
+                    {
+                        for (j=0; j<nMorb; j++)
+                        {
+                            pCoefficient[i*nMorb+j]=
+                                                pOverlapMatrix->coef[i*nMorb+j];
+                        }
                     }
                 }
             }
 
-            // Renormalize the shape gradient into a level-set function
-            if (pParameters->verbose)
-            {
-                fprintf(stdout,"\nRenormalization of the shape gradient.");
-            }
+            // Try to remove kHexahedron to mesh (if not already treated)
+            kHexahedron=pMesh->padj[k].hexin-1;
 
-            if (!renormalizeWithMshdistSoftware(pParameters,"sol"))
+            if (pMesh->phex[kHexahedron].label!=-2)
             {
-                PRINT_ERROR("In optimization: renormalizeWithMshdistSoftware ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                return 0;
-            }
+                // Evaluating S(Omega-kHexahedron) and its probability
+                if (!computeProbabilityOfModifiedDomain(pParameters,pMesh,pData,
+                                                        pChemicalSystem,
+                                                        iterationInTheLoop,
+                                                        pCoefficient,
+                                                                kHexahedron,-1))
+                {
+                    PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
+                    fprintf(stderr,"computeProbabilityOfModifiedDomain ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pCoefficient);
+                    pCoefficient=NULL;
+                    endProfilerPhase(&globalProfiler,PROF_SEARCH);
+                    return 0;
+                }
 
-            // Vizualize the shape gradient after renormalization
-            if (pParameters->save_print>0)
-            {
-                if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
-                                                     pParameters->save_where==2)
+                if (*pProbability>probability)
                 {
-                    if (!plotMeshWithMeditSoftware(pParameters))
+                    if (pParameters->verbose)
                     {
-                        PRINT_ERROR("In optimization: ");
-                        fprintf(stderr,"plotMeshWithMeditSoftware function ");
-                        fprintf(stderr,"returned zero instead of one.\n");
-                        return 0;
+                        fprintf(stdout,"Removing the %d-th ",kHexahedron+1);
+                        fprintf(stdout,"hexahedron of the domain: ");
+                        fprintf(stdout,"P(Omega-Hexa)=%.8lf\n",*pProbability);
+                    }
+                    pMesh->phex[kHexahedron].label=-2;
+
+                    // Update pCoefficient and probability
+                    probability=*pProbability;
+                    for (i=0; i<nMorb; i++)
+                    {
+                        for (j=0; j<nMorb; j++)
+                        {
+                            pCoefficient[i*nMorb+j]=
+                                                pOverlapMatrix->coef[i*nMorb+j];
+                        }
                     }
                 }
             }
+        }
+    }
 
-            // Adapt the mesh to both molecular orbitals and level set function
-            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                return 0;
-            }
+    // Update the final overlap matrix coefficients
+    for (i=0; i<nMorb; i++)
+    {
+        for (j=0; j<nMorb; j++)
+        {
+           pOverlapMatrix->coef[i*nMorb+j]=pCoefficient[i*nMorb+j];
+        }
+    }
 
-            fprintf(stdout,"\nSTEP 4: COMPUTE THE PROBABILITY, POPULATION ");
-            fprintf(stdout,"AND SHAPE GRADIENT ON NEW DOMAIN.\n");
+    if (!pParameters->verbose && !pParameters->n_prune)
+    {
+        fprintf(stdout,"100 %% done.\n");
+    }
 
-            // Compute the overlap matrix, probability, shape gradient, and
-            // residual for the new domain
-            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: shapeDerivative function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    // Diagonalize overlap matrix. Warning: we use lapacke.h,
+    // and lapacke package must have been previously installed
+    pParameters->opt_mode=-1;
+    if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
+    {
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: diagonalizeOverlapMatrix ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        free(pCoefficient);
+        pCoefficient=NULL;
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
+    }
 
-            // Save data and delete mesh if necessary
-            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
-                                   iterationInTheLoop,pGlobalInitialTimer,
-                                               pStartLocalTimer,pEndLocalTimer))
-            {
-                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
-            break;
+    // Compute probabilities and total population in the domain
+    if (!computeProbability(pParameters,pData,iterationInTheLoop))
+    {
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: computeProbability ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        free(pCoefficient);
+        pCoefficient=NULL;
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
+    }
+    pParameters->opt_mode=-2;
 
-// Case where Omega_new=Lagangian_advection{dP/dOmega_old*Normal}
-        case 3:
+    // Free the memory allocated for pCoefficient
+    free(pCoefficient);
+    pCoefficient=NULL;
 
-            // Save the shape gradient
-            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: saveTheShapeGradient function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    // Act the fact that the new domain can now be considered
+    for (i=0; i<nHex; i++)
+    {
+        pMesh->phex[i].label=abs(pMesh->phex[i].label);
+    }
 
-            // Advect the mesh thanks to Lagrangian mode of mmg3d software
-            if (!computeLagrangianMode(pParameters,pMesh,iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: computeLagrangianMode function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    // Update the Adjacency structures and boundary quandrilaterals
+    // locally (only the previous boundary hexahedra may have changed)
+    fprintf(stdout,"\nUpdate the Adjacency structures to get the ");
+    fprintf(stdout,"new domain.\n");
+    if (!updateLevelSetQuadrilaterals(pParameters,pMesh))
+    {
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: ");
+        fprintf(stderr,"updateLevelSetQuadrilaterals function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
+    }
 
-            // Re-Adapt the mesh to both molecular orbitals and domain geometry
-            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
+    if (!computeShapeResidual(pParameters,pMesh,pData,pChemicalSystem,
                                                             iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                return 0;
-            }
+    {
+        PRINT_ERROR("In exhaustiveSearchAlgorithm: computeShapeResidual ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_SEARCH);
+        return 0;
+    }
 
-            fprintf(stdout,"\nSTEP 3: COMPUTE PROBABILITY, POPULATION ");
-            fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
+    endProfilerPhase(&globalProfiler,PROF_SEARCH);
 
-            // Compute the overlap matrix, probability, shape gradient, and
-            // residual for the new domain
-            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: shapeDerivative function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
-
-            // Save data and delete mesh if necessary
-            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
-                                   iterationInTheLoop,pGlobalInitialTimer,
-                                               pStartLocalTimer,pEndLocalTimer))
-            {
-                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
-
-            break;
-
-// Case where Omega_new=EulerianLevelSet_advection{dP/dOmega_old*Normal}
-        case 2:
-
-            // Hacking with a temporary adaptative mode
-            if (pParameters->nu_spin)
-            {
-                pParameters->delta_t=deltaT;
-                if (pData->d0p[iterationInTheLoop-1]<
-                                         1.e-6*pData->d1p[iterationInTheLoop-1])
-                {
-                    pParameters->delta_t=1.e-6;
-                }
-                else
-                {
-                    pParameters->delta_t=pData->d0p[iterationInTheLoop-1]/
-                                               pData->d1p[iterationInTheLoop-1];
-                }
-                fprintf(stdout,"\nAdaptative step: %lf.\n",
-                                                          pParameters->delta_t);
-            }
-
-            // Save the shape gradient
-            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: saveTheShapeGradient function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    return 1;
+}
 
-            // Advect the mesh thanks to Eulerian mode (level-set approach)
-            if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: computeEulerianMode function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+/* ************************************************************************** */
+// The function computeLevelSet computes the signed distance function i.e. the
+// level-set function with unitary gradient norm of the internal domain of pMesh
+// and saves the values in an *.chi.sol file associated with an *.mesh one. It
+// has the Parameters* and Mesh* variables (both defined in main.h) as input
+// arguments and it returns zero if an error occurred, otherwise one is returned
+// on success
+/* ************************************************************************** */
+int computeLevelSet(Parameters* pParameters, Mesh* pMesh,
+                                                         int iterationInTheLoop)
+{
+    size_t lengthName=0;
+    char* fileLocation=NULL;
 
-            // Adapt the mesh to both molecular orbitals and new domain geometry
-            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                return 0;
-            }
+    // Check that the input variables are not pointing to NULL
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In computeLevelSet: at least one of the input variable ");
+        fprintf(stderr,"pParameters=%p or",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
+        fprintf(stderr,"address.\n");
+        return 0;
+    }
 
-            fprintf(stdout,"\nSTEP 6: COMPUTE PROBABILITY, POPULATION ");
-            fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
+    // Check the pParameters->opt_mode variable
+    if (pParameters->opt_mode!=1 && pParameters->opt_mode!=2)
+    {
+        PRINT_ERROR("In computeLevelSet: the pParameters->opt_mode ");
+        fprintf(stderr,"variable (=%d) can only be set ",pParameters->opt_mode);
+        fprintf(stderr,"to one or two here.\n");
+        return 0;
+    }
 
-            // Compute the overlap matrix, probability, shape gradient, and
-            // residual for the new domain
-            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: shapeDerivative function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    // Check the iterationInTheLoopVariable variable
+    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    {
+        PRINT_ERROR("In computeLevelSet: the input iterationInTheLoop ");
+        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
+        fprintf(stderr,"positive integer not (strictly) greater than the ");
+        fprintf(stderr,"maximal number of allowed iterations ");
+        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        return 0;
+    }
 
-            // Save data and delete mesh if necessary
-            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
-                                   iterationInTheLoop,pGlobalInitialTimer,
-                                               pStartLocalTimer,pEndLocalTimer))
-            {
-                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    // Check the name_mesh and name_length variables
+    if (getMeshFormat(pParameters->name_mesh,pParameters->name_length)!=1)
+    {
+        PRINT_ERROR("In computeLevelSet: getMeshFormat function did not ");
+        fprintf(stderr,"return one, which was the expected value here.\n");
+        return 0;
+    }
 
-            // Hacking with a temporary adaptative mode
-            if (pParameters->nu_spin)
-            {
-                pParameters->delta_t=deltaT;
-            }
+    // Store the name of the *.chi.mesh file in fileLocation
+    lengthName=pParameters->name_length;
+    fileLocation=(char*)calloc(lengthName,sizeof(char));
+    if (fileLocation==NULL)
+    {
+        PRINT_ERROR("In computeLevelSet: could not allocate memory for the ");
+        fprintf(stderr,"local char* fileLocation variable.\n");
+        return 0;
+    }
+    strncpy(fileLocation,pParameters->name_mesh,lengthName);
+    lengthName=strlen(fileLocation);
+    fileLocation[lengthName-5]='.';
+    fileLocation[lengthName-4]='c';
+    fileLocation[lengthName-3]='h';
+    fileLocation[lengthName-2]='i';
+    fileLocation[lengthName-1]='.';
+    fileLocation[lengthName]='m';
+    fileLocation[lengthName+1]='e';
+    fileLocation[lengthName+2]='s';
+    fileLocation[lengthName+3]='h';
+    fileLocation[lengthName+4]='\0';
 
+    // Remove the *.chi.mesh file if it already exists.
+    switch (initialFileExists(fileLocation,pParameters->name_length))
+    {
+        case -1:
             break;
 
-// Golden search algorithm with Eulerian/Lagrangian perturbations
-// now Armijo-Goldstein
         case 1:
-
-            // Save the initial shape gradient computed at the mesh vertices
-            pShapeGradient=(double*)calloc(pMesh->nver,sizeof(double));
-            if (pShapeGradient==NULL)
+            // remove returns 0 on success, otherwise -1
+            if (remove(fileLocation))
             {
-                PRINT_ERROR("In optimization: could not allocate memory for ");
-                fprintf(stderr,"the local double* pShapeGradient variable.\n");
+                PRINT_ERROR("In computeLevelSet: wrong return (=-1) of the ");
+                fprintf(stderr,"standard remove c-function in the attempt of ");
+                fprintf(stderr,"removing the %s file.\n",fileLocation);
+                free(fileLocation);
+                fileLocation=NULL;
                 return 0;
             }
-            for (i=0; i<pMesh->nver; i++)
-            {
-                pShapeGradient[i]=pMesh->pver[i].value;
-            }
-
-//            // Evaluate the metric associated with the molecular orbitals
-//            if (!computeMetric(pParameters,pMesh,pChemicalSystem,
-//                                                          iterationInTheLoop))
-//            {
-//                PRINT_ERROR("In optimization: computeMetric ");
-//                fprintf(stderr,"function returned zero instead of one.\n");
-//                return 0;
-//            }
+            break;
 
+        default:
+            PRINT_ERROR("In computeLevelSet: initialFileExists function ");
+            fprintf(stderr,"returned zero instead of (+/-)one.\n");
+            free(fileLocation);
+            fileLocation=NULL;
+            return 0;
+            break;
+    }
 
-            // Initialize extremal value of tMin: we known that for tMax
-            // Armijo's rule is not satisfied (thus Goldstein yes) with
-            // parameters 0.25 (Armijo) and 0.75 (Goldstein)
-            p0=pData->pnu[iterationInTheLoop-1];
-            h=pData->d1p[iterationInTheLoop-1];
-            hMin=.5*(pParameters->hmin_ls+pParameters->hmin_lag);
+    // Temporary rename the *.mesh by *.chi.mesh
+    if (!renameFileLocation(pParameters->name_mesh,pParameters->name_length,
+                                                                  fileLocation))
+    {
+        PRINT_ERROR("In computeLevelSet: renameFileLocation function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return 0;
+    }
+    strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
 
-            t1=-2.;
-            tMin=DEF_ABS(p0)/h;
-            tMax=4.*DEF_ABS(1.-p0)/h;
-            if (tMin>=tMax)
-            {
-                tMin=tMax/10.;
-            }
+    // Generate the level-set function from mesh with mshdist
+    if (!renormalizeWithMshdistSoftware(pParameters,"dom"))
+    {
+        PRINT_ERROR("In computeLevelSet: renormalizeWithMshdistSoftware ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return 0;
+    }
 
-            nMax=5;
-            counter=-1;
-            do
+    // Vizualize the shape gradient after renormalization
+    if (pParameters->opt_mode==2)
+    {
+        if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==2)
             {
-                counter++;
-
-                // Perform an initial perturbation with intensity tMin
-                // (tMin too big Eulerian perturbations, else Lagrangian's ones)
-                fprintf(stdout,"\nSEARCHING THE STARTING INTERVAL FOR ");
-                fprintf(stdout,"OPTIMAL STEP.\nCOMPUTING p(%lf).\n",tMin);
-                for (i=0; i<pMesh->nver; i++)
+                if (!plotMeshWithMeditSoftware(pParameters))
                 {
-                    pMesh->pver[i].value=tMin*pShapeGradient[i];
+                    PRINT_ERROR("In computeLevelSet: ");
+                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    free(fileLocation);
+                    fileLocation=NULL;
+                    return 0;
                 }
-
+            }
+        }
+    }
+
+    // Rename the *.mesh file as it was
+    lengthName=strlen(fileLocation);
+    fileLocation[lengthName-9]='.';
+    fileLocation[lengthName-8]='m';
+    fileLocation[lengthName-7]='e';
+    fileLocation[lengthName-6]='s';
+    fileLocation[lengthName-5]='h';
+    fileLocation[lengthName-4]='\0';
+    fileLocation[lengthName-3]='\0';
+    fileLocation[lengthName-2]='\0';
+    fileLocation[lengthName-1]='\0';
+    fileLocation[lengthName]='\0';
+    if (!renameFileLocation(pParameters->name_mesh,pParameters->name_length,
+                                                                  fileLocation))
+    {
+        PRINT_ERROR("In computeLevelSet: renameFileLocation function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return 0;
+    }
+    strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
+
+    // Free the memory allocated for fileLocation
+    free(fileLocation);
+    fileLocation=NULL;
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function saveTheShapeGradient contains successive functions that are
+// used to vizualize the norm of the shape gradient, save it in the vectorial
+// *.sol file, and vizualize it with the medit software. It has the
+// Parameters*, Mesh*, (both defined in main.h), and the int
+// interationInTheLoop variables as input arguments. It returns one on success
+// otherwise zero if an error is encoutnered during the process
+/* ************************************************************************** */
+int saveTheShapeGradient(Parameters* pParameters, Mesh* pMesh,
+                                                         int iterationInTheLoop)
+{
+    // Check that the input variables are not pointing to NULL
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In saveTheShapeGradient: at least one of the input ");
+        fprintf(stderr,"variable pParameters=%p or",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
+        fprintf(stderr,"address.\n");
+        return 0;
+    }
+
+    // Check the iterationInTheLoopVariable variable
+    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    {
+        PRINT_ERROR("In saveTheShapeGradient: the input iterationInTheLoop ");
+        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
+        fprintf(stderr,"positive integer not (strictly) greater than the ");
+        fprintf(stderr,"maximal number of allowed iterations ");
+        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        return 0;
+    }
+
+    if (pParameters->opt_mode==3)
+    {
+            fprintf(stdout,"\nSTEP 1: DEFORM THE MESH ACCORDING TO THE ");
+            fprintf(stdout,"COMPUTED SHAPE GRADIENT MOTION.\n");
+    }
+    else if (pParameters->opt_mode==2)
+    {
+            fprintf(stdout,"\nSTEP 1: EXTEND THE COMPUTED SHAPE GRADIENT ");
+            fprintf(stdout,"OUTSIDE THE BOUNDARY OF THE DOMAIN.\n");
+    }
+
+    // Vizualize the norm of the shape gradient at the boundary vertices
+    if (pParameters->opt_mode!=1)
+    {
+        if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==3)
+            {
+                if (!writingSolFile(pParameters,pMesh))
+                {
+                    PRINT_ERROR("In saveTheShapeGradient: writingSolFile ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    return 0;
+                }
+
+                if (!plotMeshWithMeditSoftware(pParameters))
+                {
+                     PRINT_ERROR("In saveTheShapeGradient: ");
+                     fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                     fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+        }
+    }
+
+    // Save the vectorial shape gradient at the shape vertices
+    if (!writingShapeSolFile(pParameters,pMesh))
+    {
+        PRINT_ERROR("In saveTheShapeGradient: writingShapeSolFile function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+
+    // Vizualize the vectorial shape gradient at the shape vertices
+    if (pParameters->opt_mode!=1)
+    {
+        if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==4)
+            {
+                if (!plotMeshWithMeditSoftware(pParameters))
+                {
+                    PRINT_ERROR("In saveTheShapeGradient: ");
+                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function computeEulerianMode contains successive functions that are
+// used to specifically compute the Eulerian mode in the optimization function
+// It has the Parameters*, Mesh*, (both defined in main.h), and the int
+// interationInTheLoop variables as input arguments. It returns one on success
+// otherwise zero if an error is encoutnered during the process
+/* ************************************************************************** */
+int computeEulerianMode(Parameters* pParameters, Mesh* pMesh,
+                                                         int iterationInTheLoop)
+{
+    // Check that the input variables are not pointing to NULL
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In computeEulerianMode: at least one of the input ");
+        fprintf(stderr,"variable pParameters=%p or",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
+        fprintf(stderr,"address.\n");
+        return 0;
+    }
+
+    // Check the pParameters->opt_mode variable
+    if (pParameters->opt_mode!=1 && pParameters->opt_mode!=2)
+    {
+        PRINT_ERROR("In computeEulerianMode: the pParameters->opt_mode ");
+        fprintf(stderr,"variable (=%d) can only be set ",pParameters->opt_mode);
+        fprintf(stderr,"to one or two here.\n");
+        return 0;
+    }
+
+    // Check the iterationInTheLoopVariable variable
+    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    {
+        PRINT_ERROR("In computeEulerianMode: the input iterationInTheLoop ");
+        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
+        fprintf(stderr,"positive integer not (strictly) greater than the ");
+        fprintf(stderr,"maximal number of allowed iterations ");
+        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        return 0;
+    }
+
+    // Extend the shape gradient outside the domain thanks to the elasticity
+    if (!extendShapeGradientWithElasticSoftware(pParameters))
+    {
+        PRINT_ERROR("In computeEulerianMode: ");
+        fprintf(stderr,"extendLevelSetWithElasticSoftware function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
+
+    // Vizualize the extension of the vectorial shape gradient
+    if (pParameters->opt_mode==2)
+    {
+       if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==5)
+            {
+                if (!plotMeshWithMeditSoftware(pParameters))
+                {
+                    PRINT_ERROR("In computeEulerianMode: ");
+                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+        }
+
+        fprintf(stdout,"\nSTEP 2: GET THE LEVEL-SET FUNCTION OF ");
+        fprintf(stdout,"THE DOMAIN WITH A UNITARY GRADIENT NORM.\n");
+    }
+
+    // Generate the level-set function from mesh with mshdist
+    if (!computeLevelSet(pParameters,pMesh,iterationInTheLoop))
+    {
+        PRINT_ERROR("In computeEulerianMode: computeLevelSet function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+
+    if (pParameters->opt_mode==2)
+    {
+        fprintf(stdout,"\nSTEP 3: ADVECT THE LEVEL-SET FUNCTION ");
+        fprintf(stdout,"ACCORDING TO THE EXTENDED SHAPE GRADIENT.\n");
+    }
+
+    // Advect the level-set function according to the parameters
+    if (!advectLevelSetWithAdvectSoftware(pParameters))
+    {
+        PRINT_ERROR("In computeEulerianMode:  ");
+        fprintf(stderr,"advectLevelSetWithAdvectSoftware function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+
+    // Vizualize the advected level-set function on the mesh
+    if (pParameters->opt_mode==2)
+    {
+        if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==6)
+            {
+                if (!plotMeshWithMeditSoftware(pParameters))
+                {
+                    PRINT_ERROR("In computeEulerianMode: ");
+                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function computeLagrangianMode contains successive functions that are
+// used to specifically compute the Lagrangian mode in the optimization function
+// It has the Parameters*, Mesh*, (both defined in main.h), and the int
+// interationInTheLoop variables as input arguments. It returns one on success
+// otherwise zero if an error is encoutnered during the process
+/* ************************************************************************** */
+int computeLagrangianMode(Parameters* pParameters, Mesh* pMesh,
+                                                         int iterationInTheLoop)
+{
+    int sizeMemory=0, nIter=0;
+
+    // Check that the input variables are not pointing to NULL
+    if (pParameters==NULL || pMesh==NULL)
+    {
+        PRINT_ERROR("In computeLagrangianMode: at least one of the input ");
+        fprintf(stderr,"variable pParameters=%p or",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p does not point to a valid ",(void*)pMesh);
+        fprintf(stderr,"address.\n");
+        return 0;
+    }
+
+    // Check the pParameters->opt_mode variable
+    if (pParameters->opt_mode!=1 && pParameters->opt_mode!=3)
+    {
+        PRINT_ERROR("In computeLagrangianMode: the pParameters->opt_mode ");
+        fprintf(stderr,"variable (=%d) can only be set ",pParameters->opt_mode);
+        fprintf(stderr,"to one or three here.\n");
+        return 0;
+    }
+
+    // Check the iterationInTheLoopVariable variable
+    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    {
+        PRINT_ERROR("In computeLagrangianMode: the input iterationInTheLoop ");
+        fprintf(stderr,"variable (=%d) should be a ",iterationInTheLoop);
+        fprintf(stderr,"positive integer not (strictly) greater than the ");
+        fprintf(stderr,"maximal number of allowed iterations ");
+        fprintf(stderr,"(=%d).\n",pParameters->iter_max);
+        return 0;
+    }
+
+    // Free the memory allocated for the mesh
+    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    {
+        sizeMemory=sizeof(Mesh)+(pMesh->nver)*sizeof(Point);
+        sizeMemory+=(pMesh->nnorm+pMesh->ntan)*sizeof(Vector);
+        sizeMemory+=(pMesh->nedg)*sizeof(Edge);
+        sizeMemory+=(pMesh->ntri)*sizeof(Triangle);
+        sizeMemory+=(pMesh->ntet)*sizeof(Tetrahedron);
+        fprintf(stdout,"\nCleaning the allocated memory ");
+        fprintf(stdout,"(%d,%d Mo) for ",sizeMemory/1000000,sizeMemory%1000000);
+        fprintf(stdout,"a mesh adaptation according to the shape gradient ");
+        fprintf(stdout,"with a Lagrangian approach.\n");
+    }
+    freeMeshMemory(pMesh);
+
+    // Warning: mmg3d software must have been previously installed
+    if (!adaptMeshWithMmg3dSoftware(pParameters,"lag"))
+    {
+        PRINT_ERROR("In computeLagrangianMode: adaptMeshWithMmg3dSoftware ");
+        fprintf(stderr,"function returned zero instead of one.\n");;
+        return 0;
+    }
+
+    // Read the intermediate *.mesh file
+    if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+    {
+        PRINT_ERROR("In computeLagrangianMode: readMeshFileAndAllocateMesh ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
+
+    // Update the parameters related to the computational box
+    if (!updateDiscretizationParameters(pParameters,pMesh))
+    {
+        PRINT_ERROR("In computeLagrangianMode: ");
+        fprintf(stderr,"updateDiscretizationParameters function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
+
+    // Vizualize the intermediate mesh
+    if (pParameters->opt_mode==3)
+    {
+        if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==7)
+            {
+                if (!plotMeshWithMeditSoftware(pParameters))
+                {
+                    PRINT_ERROR("In computeLagrangianMode: ");
+                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+        }
+    }
+
+    if (pParameters->opt_mode==3)
+    {
+        fprintf(stdout,"\nSTEP 2: ADAPT THE MESH TO BOTH THE NEW DOMAIN ");
+        fprintf(stdout,"GEOMETRY AND SYSTEM CHEMISTRY.\n");
+    }
+
+    // Generate a coarse level-set function of the intermediate mesh
+    nIter=pParameters->n_iter;
+    pParameters->n_iter=10;
+    if (!renormalizeWithMshdistSoftware(pParameters,"dom"))
+    {
+        PRINT_ERROR("In computeLagrangianMode: ");
+        fprintf(stderr,"renormalizeWithMshdistSoftware function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
+    pParameters->n_iter=nIter;
+
+    // Vizualize the coarse level-set function of the intermediate mesh
+    if (pParameters->opt_mode==3)
+    {
+        if (pParameters->save_print>0)
+        {
+            if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==2)
+            {
+                if (!plotMeshWithMeditSoftware(pParameters))
+                {
+                    PRINT_ERROR("In computeLagrangianMode: ");
+                    fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    return 0;
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function computeProbabilityAndReloadPreviousMesh compute the probability
+// of a given mesh then reload the previous mesh in the structure pointed by
+// pMesh. It has the Parameters*, Mesh*, Data*, ChemicalSystem* (both defined in
+// main.h), and the int interationInTheLoop variables as input arguments. It
+// returns the value of the probability on success otherwise -10000 for an error
+/* ************************************************************************** */
+double computeProbabilityAndReloadPreviousMesh(Parameters* pParameters,
+                                               Mesh* pMesh, Data* pData,
+                                               ChemicalSystem* pChemicalSystem,
+                                                         int iterationInTheLoop)
+{
+    size_t lengthName=0;
+    char *fileLocation=NULL;
+    int sizeMemory=0;
+    double returnValue=0.;
+
+    // Computing overlap matrix. Warning: bounadary triangles are labbelled 10
+    // but not necessarily the related vertices (ok now and checked in
+    // writeShapeSolFile function)
+    if (!computeOverlapMatrix(pParameters,pMesh,pData,pChemicalSystem,2,
+                                                            iterationInTheLoop))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+        fprintf(stderr,"computeOverlapMatrix function returned zero instead ");
+        fprintf(stderr,"of one.\n");
+        return -10000.;
+    }
+
+    // Diagonalize the overlap matrix. Warning: we use lapacke.h
+    // and lapacke package must have been previously installed
+    if (!diagonalizeOverlapMatrix(pParameters,pData,iterationInTheLoop))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+        fprintf(stderr,"diagonalizeOverlapMatrix function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        return -10000.;
+    }
+
+    // Compute the probabilities and total population in the domain
+    if (!computeProbability(pParameters,pData,iterationInTheLoop))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+        fprintf(stderr,"computeProbability function returned zero instead ");
+        fprintf(stderr,"of one.\n");
+        return -10000.;
+    }
+    returnValue=pData->pnu[iterationInTheLoop];
+
+    // Store the name of the *.mesh file in fileLocation
+    lengthName=pParameters->name_length;
+    fileLocation=(char*)calloc(lengthName,sizeof(char));
+    if (fileLocation==NULL)
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: could not ");
+        fprintf(stderr,"allocate memory for the local char* fileLocation ");
+        fprintf(stderr,"variable.\n");
+        return -10000.;
+    }
+
+    // Store the *.[iterationInTheLoop-1].mesh name in fileLocation
+    strncpy(fileLocation,pParameters->name_mesh,lengthName);
+    lengthName=strlen(fileLocation);
+    fileLocation[lengthName-5]='\0';
+
+    // sprintf returns the total number of characters written
+    // not including the '\0', otherwise a negative number on failure
+    if (sprintf(pParameters->name_mesh,"%s.%d.mesh",fileLocation,
+                                                        iterationInTheLoop-1)<0)
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: the ");
+        fprintf(stderr,"standard sprintf c-function returned an unexpected ");
+        fprintf(stderr,"negative value.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return -10000.;
+    }
+    fileLocation[lengthName-5]='.';
+
+    // Check if *.[iterationInTheLoop-1].mesh file exists.
+    if (initialFileExists(pParameters->name_mesh,pParameters->name_length)!=1)
+    {
+            PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+            fprintf(stderr,"initialFileExists function did not return one, ");
+            fprintf(stderr,"which was the expected value here.\n");
+            free(fileLocation);
+            fileLocation=NULL;
+            return -10000.;
+    }
+
+    // Check if *.mesh file exists and remove it
+    if (initialFileExists(fileLocation,pParameters->name_length)!=1)
+    {
+            PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+            fprintf(stderr,"initialFileExists function did not return one, ");
+            fprintf(stderr,"which was the expected value here.\n");
+            free(fileLocation);
+            fileLocation=NULL;
+            return -10000.;
+    }
+
+    if (remove(fileLocation))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: wrong ");
+        fprintf(stderr,"return (=-1) of the standard remove c-function in ");
+        fprintf(stderr,"the attempt of removing the %s file.\n",fileLocation);
+        free(fileLocation);
+        fileLocation=NULL;
+        return -10000.;
+    }
+
+    // Copy the *.[iterationInTheLoop-1].mesh into *.mesh
+    if (!copyFileLocation(pParameters->name_mesh,pParameters->name_length,
+                                                                  fileLocation))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+        fprintf(stderr,"copyFileLocation function returned zero instead ");
+        fprintf(stderr,"of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return -10000.;
+    }
+    strncpy(pParameters->name_mesh,fileLocation,pParameters->name_length);
+
+    // Free the memory allocated for the mesh
+    if (pParameters->opt_mode!=1 || pParameters->verbose)
+    {
+        sizeMemory=sizeof(Mesh)+(pMesh->nver)*sizeof(Point);
+        sizeMemory+=(pMesh->nnorm+pMesh->ntan)*sizeof(Vector);
+        sizeMemory+=(pMesh->nedg)*sizeof(Edge);
+        sizeMemory+=(pMesh->ntri)*sizeof(Triangle);
+        sizeMemory+=(pMesh->ntet)*sizeof(Tetrahedron);
+        fprintf(stdout,"\nCleaning the allocated memory ");
+        fprintf(stdout,"(%d,%d Mo) for ",sizeMemory/1000000,sizeMemory%1000000);
+        fprintf(stdout,"reloading the %d-th mesh.\n",iterationInTheLoop-1);
+    }
+    freeMeshMemory(pMesh);
+
+    // Read the new *.mesh file
+    if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+        fprintf(stderr,"readMeshFileAndAllocateMesh function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return -10000.;
+    }
+
+    // Update the parameters related to the computational box
+    if (!updateDiscretizationParameters(pParameters,pMesh))
+    {
+        PRINT_ERROR("In computeProbabilityAndReloadPreviousMesh: ");
+        fprintf(stderr,"updateDiscretizationParameters function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        free(fileLocation);
+        fileLocation=NULL;
+        return -10000.;
+    }
+
+    // Free the memory allocated for fileLocation
+    free(fileLocation);
+    fileLocation=NULL;
+
+    return returnValue;
+}
+
+/* ************************************************************************** */
+// The function checkStopCriteria checks if the stop criteria of the
+// optimization loop are satisfied by the data computed at the previous
+// iteration (iterationInTheLoop-1), i.e. if the differences in probability
+// (pData->d0p), the residual (pData->d1p) and the differences in residual
+// (pData->d2p) are below the tolerances prescribed in pParameters. It has the
+// Parameters*, Data* (defined in main.h) and the int iterationInTheLoop
+// variables as input arguments. It returns one if the optimization loop must
+// be stopped, otherwise zero is returned
+/* ************************************************************************** */
+int checkStopCriteria(Parameters* pParameters, Data* pData,
+                                                         int iterationInTheLoop)
+{
+    int boolean=0;
+
+    if (pParameters->iter_told0p>0.)
+    {
+        if (DEF_ABS(pData->d0p[iterationInTheLoop-1])<pParameters->iter_told0p)
+        {
+            boolean++;
+        }
+    }
+    else
+    {
+        return 1;
+    }
+
+    if (pParameters->iter_told1p>0.)
+    {
+        if (DEF_ABS(pData->d1p[iterationInTheLoop-1])<pParameters->iter_told1p)
+        {
+            boolean++;
+        }
+    }
+    else
+    {
+        return 1;
+    }
+
+    if (pParameters->iter_told2p>0.)
+    {
+        if (DEF_ABS(pData->d2p[iterationInTheLoop-1])<pParameters->iter_told2p)
+        {
+            if (pParameters->opt_mode<=0)
+            {
+                return 1;
+            }
+            else
+            {
+                boolean++;
+            }
+        }
+    }
+    else
+    {
+        return 1;
+    }
+
+    if (boolean==3)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/* ************************************************************************** */
+// The function refineGridInTheLoop is used in the coarse-to-fine mode of the
+// hexahedral optimization (pParameters->n_level positive) when the stop
+// criteria are satisfied on the current grid. Each hexahedron is divided into
+// eight thanks to the refineHexahedralMesh function, so that the internal
+// domain and its overlap matrix (stored in
+// pData->pmat[(iterationInTheLoop-1)%nring]) are exactly transferred to the
+// refined grid. If pParameters->opt_mode is set to -1, the shape gradient is
+// then evaluated on the new boundary in order to choose the hexahedra to add or
+// remove at the current iteration, so that the optimization continues on the
+// refined grid without recomputing the overlap matrix on the whole domain. It
+// has the Parameters*, Mesh*, Data*, ChemicalSystem* (defined in main.h) and
+// the int iterationInTheLoop variables as input arguments. It returns one on
+// success, otherwise zero
+/* ************************************************************************** */
+int refineGridInTheLoop(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                        ChemicalSystem* pChemicalSystem, int iterationInTheLoop)
+{
+    // Check the input variables
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                                                          pChemicalSystem==NULL)
+    {
+        PRINT_ERROR("In refineGridInTheLoop: at least one of the input ");
+        fprintf(stderr,"variables pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pMesh=%p, pData=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"or pChemicalSystem=%p ",(void*)pChemicalSystem);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
+
+    if (pParameters->opt_mode>=0 || pParameters->n_level<1 ||
+                                                         iterationInTheLoop<1)
+    {
+        PRINT_ERROR("In refineGridInTheLoop: expecting a negative opt_mode ");
+        fprintf(stderr,"(=%d), a positive ",pParameters->opt_mode);
+        fprintf(stderr,"n_level (=%d) and a ",pParameters->n_level);
+        fprintf(stderr,"positive iterationInTheLoop ");
+        fprintf(stderr,"(=%d) variables.\n",iterationInTheLoop);
+        return 0;
+    }
+
+    fprintf(stdout,"\nCONVERGENCE REACHED ON THE CURRENT GRID: REFINE THE ");
+    fprintf(stdout,"HEXAHEDRA (%d LEVEL(S) LEFT).\n",pParameters->n_level-1);
+
+    // Divide each hexahedron into eight (the domain remains the same)
+    if (!refineHexahedralMesh(pParameters,pMesh))
+    {
+        PRINT_ERROR("In refineGridInTheLoop: refineHexahedralMesh function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+    pParameters->n_level--;
+
+    // Choose the boundary hexahedra of the refined grid to add or remove
+    if (pParameters->opt_mode==-1)
+    {
+        if (!computeShapeGradient(pParameters,pMesh,pData,pChemicalSystem,
+                                                          iterationInTheLoop-1))
+        {
+            PRINT_ERROR("In refineGridInTheLoop: computeShapeGradient ");
+            fprintf(stderr,"function returned zero instead of one.\n");
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function optimization modifies the shape of the MPD domain according to
+// the shape derivative in order to increase to probability. This is the
+// function used iteratively in the optimization loop of the main function.
+// It has the Parameters*, Mesh*, Data*, ChemicalSystem* (both defined in
+// main.h), the int interationInTheLoop, and the three time_t* variables as
+// input arguments. It returns one on success otherwise zero for an error
+/* ************************************************************************** */
+int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                 ChemicalSystem* pChemicalSystem, int iterationInTheLoop,
+                 time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
+                                                         time_t* pEndLocalTimer)
+{
+    int i=0, counter=0, n=0, nMax=0;
+    double tMin=0, tMax=0, t0=0., t1=0., *pShapeGradient=NULL, pMax=0., pMin=0.;
+    double p0=0., p1=0., h=0., deltaT=0., hMin=0.;
+
+    // Check the input pointers
+    if (pParameters==NULL || pMesh==NULL || pData==NULL ||
+                           pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
+                                 pStartLocalTimer==NULL || pEndLocalTimer==NULL)
+    {
+        PRINT_ERROR("In optimization: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pData=%p, pMesh=%p, ",(void*)pMesh,(void*)pData);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pGlobalInitialTimer=%p, ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"pStartLocalTimer=%p or ",(void*)pStartLocalTimer);
+        fprintf(stderr,"pEndLocalTimer=%p, ",(void*)pEndLocalTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
+
+    // Check the iteration in the loop variable
+    if (iterationInTheLoop<1 || iterationInTheLoop>pParameters->iter_max)
+    {
+        PRINT_ERROR("In optimization: the input iterationInTheLoop variable ");
+        fprintf(stderr,"(=%d) should be a positive ",iterationInTheLoop);
+        fprintf(stderr,"integer not (strictly) greater than the maximal ");
+        fprintf(stderr,"number (=%d) of iterations ",pParameters->iter_max);
+        fprintf(stderr,"allowed in the optimization loop.\n");
+        return 0;
+    }
+
+    // Check the stop criteria. In the coarse-to-fine mode (n_level positive),
+    // the hexahedral grid is refined instead of stopping the optimization loop
+    if (checkStopCriteria(pParameters,pData,iterationInTheLoop))
+    {
+        if (pParameters->opt_mode>0 || pParameters->n_level<1)
+        {
+            return -1;
+        }
+
+        if (!refineGridInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
+        {
+            PRINT_ERROR("In optimization: refineGridInTheLoop function ");
+            fprintf(stderr,"returned zero instead of one.\n");
+            return 0;
+        }
+    }
+
+    switch (pParameters->opt_mode)
+    {
+// Case where Omega_new={dP/dOmega_old>0}
+        case 4:
+
+            fprintf(stdout,"\nSTEP 1: MAKE THE SHAPE GRADIENT A LEVEL-SET ");
+            fprintf(stdout,"FUNCTION WITH UNITARY GRADIENT.\n");
+
+            // Save (the opposite of) the shape gradient at all vertices
+            if (!writingSolFile(pParameters,pMesh))
+            {
+                PRINT_ERROR("In optimization: writingSolFile function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Vizualize the shape gradient before renormalization
+            if (pParameters->save_print>0)
+            {
+                if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==3)
+                {
+                    if (!plotMeshWithMeditSoftware(pParameters))
+                    {
+                        PRINT_ERROR("In optimization: ");
+                        fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                        fprintf(stderr,"returned zero instead of one.\n");
+                        return 0;
+                    }
+                }
+            }
+
+            // Renormalize the shape gradient into a level-set function
+            if (pParameters->verbose)
+            {
+                fprintf(stdout,"\nRenormalization of the shape gradient.");
+            }
+
+            if (!renormalizeWithMshdistSoftware(pParameters,"sol"))
+            {
+                PRINT_ERROR("In optimization: renormalizeWithMshdistSoftware ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Vizualize the shape gradient after renormalization
+            if (pParameters->save_print>0)
+            {
+                if ((iterationInTheLoop-1)%pParameters->save_print==0 &&
+                                                     pParameters->save_where==2)
+                {
+                    if (!plotMeshWithMeditSoftware(pParameters))
+                    {
+                        PRINT_ERROR("In optimization: ");
+                        fprintf(stderr,"plotMeshWithMeditSoftware function ");
+                        fprintf(stderr,"returned zero instead of one.\n");
+                        return 0;
+                    }
+                }
+            }
+
+            // Adapt the mesh to both molecular orbitals and level set function
+            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+
+            fprintf(stdout,"\nSTEP 4: COMPUTE THE PROBABILITY, POPULATION ");
+            fprintf(stdout,"AND SHAPE GRADIENT ON NEW DOMAIN.\n");
+
+            // Compute the overlap matrix, probability, shape gradient, and
+            // residual for the new domain
+            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: shapeDerivative function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Save data and delete mesh if necessary
+            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pGlobalInitialTimer,
+                                               pStartLocalTimer,pEndLocalTimer))
+            {
+                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+            break;
+
+// Case where Omega_new=Lagangian_advection{dP/dOmega_old*Normal}
+        case 3:
+
+            // Save the shape gradient
+            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: saveTheShapeGradient function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Advect the mesh thanks to Lagrangian mode of mmg3d software
+            if (!computeLagrangianMode(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: computeLagrangianMode function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Re-Adapt the mesh to both molecular orbitals and domain geometry
+            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+
+            fprintf(stdout,"\nSTEP 3: COMPUTE PROBABILITY, POPULATION ");
+            fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
+
+            // Compute the overlap matrix, probability, shape gradient, and
+            // residual for the new domain
+            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: shapeDerivative function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Save data and delete mesh if necessary
+            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pGlobalInitialTimer,
+                                               pStartLocalTimer,pEndLocalTimer))
+            {
+                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            break;
+
+// Case where Omega_new=EulerianLevelSet_advection{dP/dOmega_old*Normal}
+        case 2:
+
+            // Hacking with a temporary adaptative mode
+            if (pParameters->nu_spin)
+            {
+                pParameters->delta_t=deltaT;
+                if (pData->d0p[iterationInTheLoop-1]<
+                                         1.e-6*pData->d1p[iterationInTheLoop-1])
+                {
+                    pParameters->delta_t=1.e-6;
+                }
+                else
+                {
+                    pParameters->delta_t=pData->d0p[iterationInTheLoop-1]/
+                                               pData->d1p[iterationInTheLoop-1];
+                }
+                fprintf(stdout,"\nAdaptative step: %lf.\n",
+                                                          pParameters->delta_t);
+            }
+
+            // Save the shape gradient
+            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: saveTheShapeGradient function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Advect the mesh thanks to Eulerian mode (level-set approach)
+            if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: computeEulerianMode function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Adapt the mesh to both molecular orbitals and new domain geometry
+            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+
+            fprintf(stdout,"\nSTEP 6: COMPUTE PROBABILITY, POPULATION ");
+            fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
+
+            // Compute the overlap matrix, probability, shape gradient, and
+            // residual for the new domain
+            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: shapeDerivative function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Save data and delete mesh if necessary
+            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pGlobalInitialTimer,
+                                               pStartLocalTimer,pEndLocalTimer))
+            {
+                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Hacking with a temporary adaptative mode
+            if (pParameters->nu_spin)
+            {
+                pParameters->delta_t=deltaT;
+            }
+
+            break;
+
+// Golden search algorithm with Eulerian/Lagrangian perturbations
+// now Armijo-Goldstein
+        case 1:
+
+            // Save the initial shape gradient computed at the mesh vertices
+            pShapeGradient=(double*)calloc(pMesh->nver,sizeof(double));
+            if (pShapeGradient==NULL)
+            {
+                PRINT_ERROR("In optimization: could not allocate memory for ");
+                fprintf(stderr,"the local double* pShapeGradient variable.\n");
+                return 0;
+            }
+            for (i=0; i<pMesh->nver; i++)
+            {
+                pShapeGradient[i]=pMesh->pver[i].value;
+            }
+
+//            // Evaluate the metric associated with the molecular orbitals
+//            if (!computeMetric(pParameters,pMesh,pChemicalSystem,
+//                                                          iterationInTheLoop))
+//            {
+//                PRINT_ERROR("In optimization: computeMetric ");
+//                fprintf(stderr,"function returned zero instead of one.\n");
+//                return 0;
+//            }
+
+
+            // Initialize extremal value of tMin: we known that for tMax
+            // Armijo's rule is not satisfied (thus Goldstein yes) with
+            // parameters 0.25 (Armijo) and 0.75 (Goldstein)
+            p0=pData->pnu[iterationInTheLoop-1];
+            h=pData->d1p[iterationInTheLoop-1];
+            hMin=.5*(pParameters->hmin_ls+pParameters->hmin_lag);
+
+            t1=-2.;
+            tMin=DEF_ABS(p0)/h;
+            tMax=4.*DEF_ABS(1.-p0)/h;
+            if (tMin>=tMax)
+            {
+                tMin=tMax/10.;
+            }
+
+            nMax=5;
+            counter=-1;
+            do
+            {
+                counter++;
+
+                // Perform an initial perturbation with intensity tMin
+                // (tMin too big Eulerian perturbations, else Lagrangian's ones)
+                fprintf(stdout,"\nSEARCHING THE STARTING INTERVAL FOR ");
+                fprintf(stdout,"OPTIMAL STEP.\nCOMPUTING p(%lf).\n",tMin);
+                for (i=0; i<pMesh->nver; i++)
+                {
+                    pMesh->pver[i].value=tMin*pShapeGradient[i];
+                }
+
+                // Save the shape gradient
+                if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: saveTheShapeGradient ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                if (tMin*sqrt(h)<hMin*hMin)
+                {
+                    // Advect mesh thanks to Lagrangian mode of mmg3d software
+                    fprintf(stdout,"\nLagrangian mode.\n");
+                    if (!computeLagrangianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                    {
+                        PRINT_ERROR("In optimization: computeLagrangianMode ");
+                        fprintf(stderr,"function returned zero instead of ");
+                        fprintf(stderr,"one.\n");
+                        free(pShapeGradient);
+                        pShapeGradient=NULL;
+                        return 0;
+                    }
+                }
+                else
+                {
+                    // Advect mesh thanks to Eulerian mode (level-set approach)
+                    fprintf(stdout,"\nEulerian mode (level-set).\n");
+                    if (!computeEulerianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                    {
+                        PRINT_ERROR("In optimization: computeEulerianMode ");
+                        fprintf(stderr,"function returned zero instead of ");
+                        fprintf(stderr,"one.\n");
+                        free(pShapeGradient);
+                        pShapeGradient=NULL;
+                        return 0;
+                    }
+                }
+
+                // Adapt mesh to both molecular orbitals and new domain geometry
+                if (!performLevelSetAdaptation(pParameters,pMesh,
+                                            pChemicalSystem,iterationInTheLoop))
+                {
+//                    pMin=p0;
+                    fprintf(stdout,"\nWarning in optimization function: ");
+                    fprintf(stdout,"performLevelSetAdaptation failed.\n");
+
+                    // Read the new *.mesh file
+                    if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+                    {
+                        PRINT_ERROR("In optimization: ");
+                        fprintf(stderr,"readMeshFileAndAllocateMesh function ");
+                        fprintf(stderr,"returned zero instead of one.\n");
+                        return 0;
+                    }
+
+                    // Update the parameters related to the computational box
+                    if (!updateDiscretizationParameters(pParameters,pMesh))
+                    {
+                        PRINT_ERROR("In optimization: ");
+                        fprintf(stderr,"updateDiscretizationParameters ");
+                        fprintf(stderr,"function returned zero instead of ");
+                        fprintf(stderr,"one.\n");
+                        return 0;
+                    }
+
+
+//                   PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+//                   fprintf(stderr,"function returned zero instead of one.\n");
+//                    free(pShapeGradient);
+//                    pShapeGradient=NULL;
+//                    return 0;
+                }
+//                else
+//                {
+                    // Compute pMin and reload the previous mesh
+                    pMin=computeProbabilityAndReloadPreviousMesh(pParameters,
+                                                            pMesh,
+                                                            pData,
+                                                            pChemicalSystem,
+                                                            iterationInTheLoop);
+                    if (pMin==-10000.)
+                    {
+                        PRINT_ERROR("In optimization: ");
+                        fprintf(stderr,
+                                    "computeProbabilityAndReloadPreviousMesh ");
+                        fprintf(stderr,"function returned zero instead of ");
+                        fprintf(stderr,"one.\n");
+                        free(pShapeGradient);
+                        pShapeGradient=NULL;
+                        return 0;
+                    }
+//                }
+
+                // Look if pMin satisfied Armijo's rule or not
+                if (pMin>=p0+.25*tMin*h)
+                {
+                    // Then look if Goldstein rule is satisfied or not
+                    if (pMin<=p0+.75*tMin*h)
+                    {
+                        t1=tMin;
+                    }
+                    else
+                    {
+                        //Try to get better guess for t1 to avoid big advections
+                        t1=.1*(tMax+9.*tMin);
+                        /*if (t1>tMin && t1<tMax)
+                        {
+                            if (t1>.5*(tMax+tMin))
+                            {
+                                t1=.5*(tMax+tMin);
+                            }
+                        }
+                        else
+                        {
+                            t1=.5*(tMax+tMin);
+                        }*/
+                    }
+                }
+                else
+                {
+                    tMax=tMin;
+                    tMin=tMax/100.;
+                }
+
+            } while (t1==-2. && counter<nMax);
+
+            // Case where numerical errors does not yield to Armijo's condition
+            if (t1==-2. && counter==nMax)
+            {
+                t1=tMin;
+            }
+
+            // Now Armijo's rule is satisfied for tMin and not for tMax
+            if (t1!=tMin)
+            {
+                fprintf(stdout,"\nINITIAL INTERVAL FOUND: ");
+                fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
+                fprintf(stdout,"STARTING THE ARMIJO-GOLDSTEIN LINE SEARCH.\n");
+                do
+                {
+                    for (i=0; i<pMesh->nver; i++)
+                    {
+                        pMesh->pver[i].value=t1*pShapeGradient[i];
+                    }
+
+                    // Save the shape gradient
+                    if (!saveTheShapeGradient(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                    {
+                        PRINT_ERROR("In optimization: saveTheShapeGradient ");
+                        fprintf(stderr,"function returned zero instead of ");
+                        fprintf(stderr,"one.\n");
+                        free(pShapeGradient);
+                        pShapeGradient=NULL;
+                        return 0;
+                    }
+
+                    if (t1*sqrt(h)<hMin*hMin)
+                    {
+                        // Advect mesh thanks to Lagrangian mode of mmg3d
+                        fprintf(stdout,"\nLagrangian mode.\n");
+                        if (!computeLagrangianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,"computeLagrangianMode function ");
+                            fprintf(stderr,"returned zero instead of one.\n");
+                            free(pShapeGradient);
+                            pShapeGradient=NULL;
+                            return 0;
+                        }
+                    }
+                    else
+                    {
+                        // Advect mesh thanks to Eulerian mode (level-set)
+                        fprintf(stdout,"\nEulerian mode (level-set).\n");
+                        if (!computeEulerianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,"computeEulerianMode function ");
+                            fprintf(stderr,"returned zero instead of one.\n");
+                            free(pShapeGradient);
+                            pShapeGradient=NULL;
+                            return 0;
+                        }
+                    }
+
+                    // Adapt mesh to molecular orbitals and new domain geometry
+                    if (!performLevelSetAdaptation(pParameters,pMesh,
+                                            pChemicalSystem,iterationInTheLoop))
+                    {
+//                        p1=p0;
+                        fprintf(stdout,"\nWarning in optimization function: ");
+                        fprintf(stdout,"performLevelSetAdaptation failed.\n");
+
+                        // Read the new *.mesh file
+                        if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,"readMeshFileAndAllocateMesh ");
+                            fprintf(stderr,"function returned zero instead ");
+                            fprintf(stderr,"of one.\n");
+                            return 0;
+                        }
+
+                        // Update the parameters of the computational box
+                        if (!updateDiscretizationParameters(pParameters,pMesh))
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,"updateDiscretizationParameters ");
+                            fprintf(stderr,"function returned zero instead ");
+                            fprintf(stderr,"of one.\n");
+                            return 0;
+                        }
+
+//                        PRINT_ERROR("In optimization: ");
+//                        fprintf(stderr,"performLevelSetAdaptation function ");
+//                        fprintf(stderr,"returned zero instead of one.\n");
+//                        free(pShapeGradient);
+//                        pShapeGradient=NULL;
+//                        return 0;
+                    }
+//                    else
+//                    {
+                        // Compute p1 and reload the previous mesh
+                        p1=computeProbabilityAndReloadPreviousMesh(pParameters,
+                                                            pMesh,
+                                                            pData,
+                                                            pChemicalSystem,
+                                                            iterationInTheLoop);
+                        if (p1==-10000.)
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,
+                                    "computeProbabilityAndReloadPreviousMesh ");
+                            fprintf(stderr,"function returned zero instead ");
+                            fprintf(stderr,"of one.\n");
+                            free(pShapeGradient);
+                            pShapeGradient=NULL;
+                            return 0;
+                        }
+//                    }
+
+                    // Look if pMin satisfied Armijo's rule or not
+                    if (p1>=p0+.25*t1*h)
+                    {
+                        // Then look if Goldstein rule is satisfied or not
+                        if (p1<=p0+.75*t1*h)
+                        {
+                            tMin=t1;
+                            tMax=t1;
+                        }
+                        else
+                        {
+                            tMin=t1;
+                            if (p1<p0+pParameters->iter_told0p)
+                            {
+                                // Case where num. errors never yield Golstein
+                                tMax=tMin;
+                            }
+                            else
+                            {
+                                t1=.5*(tMax+tMin);
+                                fprintf(stdout,"\nRESTRICTING LINE SEARCH ");
+                                fprintf(stdout,"TO THE INTERVAL ");
+                                fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
+                                fprintf(stdout,"p(%lf)=%lf AND ",tMin,p1);
+                                fprintf(stdout,"COMPUTING p(%lf).\n",t1);
+
+                            }
+                        }
+                    }
+                    else
+                    {
+                        tMax=t1;
+                        t1=.5*(tMax+tMin);
+                        fprintf(stdout,"\nRESTRICTING LINE SEARCH ");
+                        fprintf(stdout,"TO THE INTERVAL ");
+                        fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
+                        fprintf(stdout,"p(%lf)=%lf AND ",tMax,p1);
+                        fprintf(stdout,"COMPUTING p(%lf).\n",t1);
+                    }
+                } while (tMin!=tMax);
+            }
+
+            // The optimal step has been found, update t0 (used after comments)
+            t0=t1;
+
+/*            tMax=1.;
+            tMin=0.;
+            pMin=pData->pnu[iterationInTheLoop-1];
+
+            // First perform an initial Eulerian perturbation of intensity one
+            fprintf(stdout,"\nSEARCHING THE STARTING INTERVAL FOR THE ");
+            fprintf(stdout,"OPTIMAL STEP.\nCOMPUTING p(%lf).\n",tMax);
+
+            // Save the shape gradient
+            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: saveTheShapeGradient function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                free(pShapeGradient);
+                pShapeGradient=NULL;
+                return 0;
+            }
+
+            // Advect the mesh thanks to Eulerian mode (level-set approach)
+            if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: computeEulerianMode function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                free(pShapeGradient);
+                pShapeGradient=NULL;
+                return 0;
+            }
+
+            // Adapt the mesh to both molecular orbitals and new domain geometry
+            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                free(pShapeGradient);
+                pShapeGradient=NULL;
+                return 0;
+            }
+
+            // Compute pMax and reload the previous mesh
+            pMax=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
+                                                         pData,pChemicalSystem,
+                                                            iterationInTheLoop);
+            if (pMax==-10000.)
+            {
+                PRINT_ERROR("In optimization: ");
+                fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                free(pShapeGradient);
+                pShapeGradient=NULL;
+                return 0;
+            }
+
+            // Trying to enlarge the searching interval
+            t0=tMax;
+            p0=pMax;
+
+            tMax=tMin;
+            pMax=pMin;
+
+            counter=0;
+            while (pMax<p0 && counter<5)
+            {
+                fprintf(stdout,"\nTRYING TO ENLARGE THE SEARCHING INTERVAL ");
+                fprintf(stdout,"[%lf, %lf].\n",tMax,t0);
+                fprintf(stdout,"p(%lf)=%lf p(%lf)=%lf. ",tMax,pMax,t0,p0);
+
+                tMin=tMax;
+                pMin=pMax;
+
+                tMax=t0;
+                pMax=p0;
+
+                counter++;
+                t0=exp(counter);
+                fprintf(stdout,"COMPUTING p(%lf).\n",t0);
+
+                for (i=0; i<pMesh->nver; i++)
+                {
+                    pMesh->pver[i].value=t0*pShapeGradient[i];
+                }
+
+                // Save the shape gradient
+                if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: saveTheShapeGradient ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                // Advect the mesh thanks to Eulerian mode (level-set approach)
+                if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: computeEulerianMode ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                // Adapt mesh to both molecular orbitals and new domain geometry
+                if (!performLevelSetAdaptation(pParameters,pMesh,
+                                               pChemicalSystem,
+                                                            iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                // Compute p0 and reload the previous mesh
+                p0=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
+                                                           pData,
+                                                           pChemicalSystem,
+                                                            iterationInTheLoop);
+                if (p0==-10000.)
+                {
+                    PRINT_ERROR("In optimization: ");
+                    fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+            }
+
+            if (pMax>=p0)
+            {
+
+                tMax=t0;
+                pMax=p0;
+
+                // Starting golden-line search on the initial interval
+                fprintf(stdout,"\nINITIAL INTERVAL FOUND: ");
+                fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
+                fprintf(stdout,"STARTING THE GOLDEN-SECTION LINE SEARCH.\n");
+
+                h=tMax-tMin;
+                if (tMax==1.)
+                {
+                    nMax=2;
+                    //nMax=(int)(floor(log(1.e-1/h)/log(INV_PHI)));
+                }
+                else
+                {
+                    nMax=0;
+                }
+
+                // Evaluation of p0 (t0<1. Lagr. otherwise Eulerian approach)
+                t0=tMin+INV_PHI2*h;
+                for (i=0; i<pMesh->nver; i++)
+                {
+                    pMesh->pver[i].value=t0*pShapeGradient[i];
+                }
+
                 // Save the shape gradient
                 if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
                 {
-                    PRINT_ERROR("In optimization: saveTheShapeGradient ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
+                    PRINT_ERROR("In optimization: saveTheShapeGradient");
+                    fprintf(stderr," function returned zero instead of one.\n");
                     free(pShapeGradient);
                     pShapeGradient=NULL;
                     return 0;
                 }
 
-                if (tMin*sqrt(h)<hMin*hMin)
+                if (t0<1.)
                 {
                     // Advect mesh thanks to Lagrangian mode of mmg3d software
-                    fprintf(stdout,"\nLagrangian mode.\n");
                     if (!computeLagrangianMode(pParameters,pMesh,
                                                             iterationInTheLoop))
                     {
@@ -7330,7 +9866,6 @@ int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 else
                 {
                     // Advect mesh thanks to Eulerian mode (level-set approach)
-                    fprintf(stdout,"\nEulerian mode (level-set).\n");
                     if (!computeEulerianMode(pParameters,pMesh,
                                                             iterationInTheLoop))
                     {
@@ -7347,130 +9882,196 @@ int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
                 if (!performLevelSetAdaptation(pParameters,pMesh,
                                             pChemicalSystem,iterationInTheLoop))
                 {
-//                    pMin=p0;
-                    fprintf(stdout,"\nWarning in optimization function: ");
-                    fprintf(stdout,"performLevelSetAdaptation failed.\n");
+                    PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
 
-                    // Read the new *.mesh file
-                    if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
-                    {
-                        PRINT_ERROR("In optimization: ");
-                        fprintf(stderr,"readMeshFileAndAllocateMesh function ");
-                        fprintf(stderr,"returned zero instead of one.\n");
-                        return 0;
-                    }
+                // Compute p0 and reload the previous mesh
+                p0=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
+                                                           pData,
+                                                           pChemicalSystem,
+                                                            iterationInTheLoop);
+                if (p0==-10000.)
+                {
+                    PRINT_ERROR("In optimization: ");
+                    fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
 
-                    // Update the parameters related to the computational box
-                    if (!updateDiscretizationParameters(pParameters,pMesh))
+                // Evaluation of p1 (t1<1. Lagr. otherwise Eulerian approach)
+                t1=tMin+INV_PHI*h;
+                fprintf(stdout,"\nFIRST EVALUATION ENDED: p(%lf)=%lf; ",t0,p0);
+                fprintf(stdout,"COMPUTING p(%lf).\n",t1);
+                for (i=0; i<pMesh->nver; i++)
+                {
+                    pMesh->pver[i].value=t1*pShapeGradient[i];
+                }
+
+                // Save the shape gradient
+                if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: saveTheShapeGradient ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                if (t1<1.)
+                {
+                    // Advect mesh thanks to Lagrangian mode of mmg3d software
+                    if (!computeLagrangianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
                     {
-                        PRINT_ERROR("In optimization: ");
-                        fprintf(stderr,"updateDiscretizationParameters ");
+                        PRINT_ERROR("In optimization: computeLagrangianMode ");
                         fprintf(stderr,"function returned zero instead of ");
                         fprintf(stderr,"one.\n");
+                        free(pShapeGradient);
+                        pShapeGradient=NULL;
                         return 0;
                     }
-
-
-//                   PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-//                   fprintf(stderr,"function returned zero instead of one.\n");
-//                    free(pShapeGradient);
-//                    pShapeGradient=NULL;
-//                    return 0;
                 }
-//                else
-//                {
-                    // Compute pMin and reload the previous mesh
-                    pMin=computeProbabilityAndReloadPreviousMesh(pParameters,
-                                                            pMesh,
-                                                            pData,
-                                                            pChemicalSystem,
-                                                            iterationInTheLoop);
-                    if (pMin==-10000.)
+                else
+                {
+                    // Advect mesh thanks to Eulerian mode (level-set approach)
+                    if (!computeEulerianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
                     {
-                        PRINT_ERROR("In optimization: ");
-                        fprintf(stderr,
-                                    "computeProbabilityAndReloadPreviousMesh ");
+                        PRINT_ERROR("In optimization: computeEulerianMode ");
                         fprintf(stderr,"function returned zero instead of ");
                         fprintf(stderr,"one.\n");
                         free(pShapeGradient);
                         pShapeGradient=NULL;
                         return 0;
                     }
-//                }
+                }
 
-                // Look if pMin satisfied Armijo's rule or not
-                if (pMin>=p0+.25*tMin*h)
+                // Adapt mesh to both molecular orbitals and new domain geometry
+                if (!performLevelSetAdaptation(pParameters,pMesh,
+                                               pChemicalSystem,
+                                                            iterationInTheLoop))
                 {
-                    // Then look if Goldstein rule is satisfied or not
-                    if (pMin<=p0+.75*tMin*h)
-                    {
-                        t1=tMin;
-                    }
-                    else
+                    PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                // Compute p1 and reload the previous mesh
+                p1=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
+                                                           pData,
+                                                           pChemicalSystem,
+                                                            iterationInTheLoop);
+                if (p1==-10000.)
+                {
+                    PRINT_ERROR("In optimization: ");
+                    fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
+                    fprintf(stderr,"function returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+
+                for (n=0; n<nMax; n++)
+                {
+                    if (p0<p1)
                     {
-                        //Try to get better guess for t1 to avoid big advections
-                        t1=.1*(tMax+9.*tMin);
-                        /*if (t1>tMin && t1<tMax)
+                        tMin=t0;
+                        pMin=p0;
+
+                        t0=t1;
+                        p0=p1;
+
+                        h*=INV_PHI;
+                        t1=tMin+INV_PHI*h;
+
+                        fprintf(stdout,"\nTRYING TO RESTRICT THE LINE SEARCH ");
+                        fprintf(stdout,"ON THE INTERVAL ");
+                        fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
+                        fprintf(stdout,"p(%lf)=%lf ",tMin,pMin);
+                        fprintf(stdout,"p(%lf)=%lf ",t0,p0);
+                        fprintf(stdout,"p(%lf)=%lf.\nCOMPUTING ",tMax,pMax);
+                        fprintf(stdout,"p(%lf).\n",t1);
+
+                        for (i=0; i<pMesh->nver; i++)
                         {
-                            if (t1>.5*(tMax+tMin))
+                            pMesh->pver[i].value=t1*pShapeGradient[i];
+                        }
+
+                       // Save the shape gradient
+                       if (!saveTheShapeGradient(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                       {
+                           PRINT_ERROR("In optimization: ");
+                           fprintf(stderr,"saveTheShapeGradient function ");
+                           fprintf(stderr,"returned zero instead of one.\n");
+                           free(pShapeGradient);
+                           pShapeGradient=NULL;
+                           return 0;
+                       }
+
+                       if (t1<1.)
+                       {
+                            // Advect mesh thanks to Lagrangian mode of mmg3d
+                            if (!computeLagrangianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
                             {
-                                t1=.5*(tMax+tMin);
+                                PRINT_ERROR("In optimization: ");
+                                fprintf(stderr,"computeLagrangianMode ");
+                                fprintf(stderr,"function returned zero ");
+                                fprintf(stderr,"instead of one.\n");
+                                free(pShapeGradient);
+                                pShapeGradient=NULL;
+                                return 0;
                             }
                         }
                         else
                         {
-                            t1=.5*(tMax+tMin);
-                        }*/
-                    }
-                }
-                else
-                {
-                    tMax=tMin;
-                    tMin=tMax/100.;
-                }
-
-            } while (t1==-2. && counter<nMax);
-
-            // Case where numerical errors does not yield to Armijo's condition
-            if (t1==-2. && counter==nMax)
-            {
-                t1=tMin;
-            }
-
-            // Now Armijo's rule is satisfied for tMin and not for tMax
-            if (t1!=tMin)
-            {
-                fprintf(stdout,"\nINITIAL INTERVAL FOUND: ");
-                fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
-                fprintf(stdout,"STARTING THE ARMIJO-GOLDSTEIN LINE SEARCH.\n");
-                do
-                {
-                    for (i=0; i<pMesh->nver; i++)
-                    {
-                        pMesh->pver[i].value=t1*pShapeGradient[i];
-                    }
+                            // Advect mesh thanks to Eul. mode (level-set mode)
+                            if (!computeEulerianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                            {
+                                PRINT_ERROR("In optimization: ");
+                                fprintf(stderr,"computeEulerianMode function ");
+                                fprintf(stderr,"returned zero instead of ");
+                                fprintf(stderr,"one.\n");
+                                free(pShapeGradient);
+                                pShapeGradient=NULL;
+                                return 0;
+                            }
+                        }
 
-                    // Save the shape gradient
-                    if (!saveTheShapeGradient(pParameters,pMesh,
+                        // Adapt mesh to both molecular orbitals and new domain
+                        if (!performLevelSetAdaptation(pParameters,pMesh,
+                                                   pChemicalSystem,
                                                             iterationInTheLoop))
-                    {
-                        PRINT_ERROR("In optimization: saveTheShapeGradient ");
-                        fprintf(stderr,"function returned zero instead of ");
-                        fprintf(stderr,"one.\n");
-                        free(pShapeGradient);
-                        pShapeGradient=NULL;
-                        return 0;
-                    }
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,"performLevelSetAdaptation ");
+                            fprintf(stderr,"function returned zero instead ");
+                            fprintf(stderr,"of one.\n");
+                            free(pShapeGradient);
+                            pShapeGradient=NULL;
+                            return 0;
+                        }
 
-                    if (t1*sqrt(h)<hMin*hMin)
-                    {
-                        // Advect mesh thanks to Lagrangian mode of mmg3d
-                        fprintf(stdout,"\nLagrangian mode.\n");
-                        if (!computeLagrangianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
+                        // Compute p1 and reload the previous mesh
+                        p1=computeProbabilityAndReloadPreviousMesh(pParameters,
+                                                                   pMesh,pData,
+                                                                pChemicalSystem,
+                                                            iterationInTheLoop);
+                        if (p1==-10000.)
                         {
                             PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"computeLagrangianMode function ");
+                            fprintf(stderr,"computeProbability");
+                            fprintf(stderr,"AndReloadPreviousMesh function ");
                             fprintf(stderr,"returned zero instead of one.\n");
                             free(pShapeGradient);
                             pShapeGradient=NULL;
@@ -7479,828 +10080,1223 @@ int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
                     }
                     else
                     {
-                        // Advect mesh thanks to Eulerian mode (level-set)
-                        fprintf(stdout,"\nEulerian mode (level-set).\n");
-                        if (!computeEulerianMode(pParameters,pMesh,
+                        tMax=t1;
+                        pMax=p1;
+
+                        t1=t0;
+                        p1=p0;
+
+                        h*=INV_PHI;
+                        t0=tMin+INV_PHI2*h;
+
+                        fprintf(stdout,"\nTRYING TO RESTRICT THE LINE SEARCH ");
+                        fprintf(stdout,"ON THE INTERVAL ");
+                        fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
+                        fprintf(stdout,"p(%lf)=%lf ",tMin,pMin);
+                        fprintf(stdout,"p(%lf)=%lf ",t1,p1);
+                        fprintf(stdout,"p(%lf)=%lf.\nCOMPUTING ",tMax,pMax);
+                        fprintf(stdout,"p(%lf).\n",t0);
+
+                        for (i=0; i<pMesh->nver; i++)
+                        {
+                            pMesh->pver[i].value=t0*pShapeGradient[i];
+                        }
+
+                        // Save the shape gradient
+                        if (!saveTheShapeGradient(pParameters,pMesh,
                                                             iterationInTheLoop))
                         {
                             PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"computeEulerianMode function ");
+                            fprintf(stderr,"saveTheShapeGradient function ");
                             fprintf(stderr,"returned zero instead of one.\n");
                             free(pShapeGradient);
                             pShapeGradient=NULL;
                             return 0;
                         }
-                    }
 
-                    // Adapt mesh to molecular orbitals and new domain geometry
-                    if (!performLevelSetAdaptation(pParameters,pMesh,
-                                            pChemicalSystem,iterationInTheLoop))
-                    {
-//                        p1=p0;
-                        fprintf(stdout,"\nWarning in optimization function: ");
-                        fprintf(stdout,"performLevelSetAdaptation failed.\n");
+                        if (t0<1.)
+                        {
+                            // Advect mesh thanks to Lagrangian mode of mmg3d
+                            if (!computeLagrangianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                            {
+                                PRINT_ERROR("In optimization: ");
+                                fprintf(stderr,"computeLagrangianMode ");
+                                fprintf(stderr,"function returned zero ");
+                                fprintf(stderr,"instead of one.\n");
+                                free(pShapeGradient);
+                                pShapeGradient=NULL;
+                                return 0;
+                            }
+                        }
+                        else
+                        {
+                            // Advect mesh thanks to Eul. mode (level-set mode)
+                            if (!computeEulerianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                            {
+                                PRINT_ERROR("In optimization: ");
+                                fprintf(stderr,"computeEulerianMode function ");
+                                fprintf(stderr,"returned zero instead of ");
+                                fprintf(stderr,"one.\n");
+                                free(pShapeGradient);
+                                pShapeGradient=NULL;
+                                return 0;
+                            }
+                        }
 
-                        // Read the new *.mesh file
-                        if (!readMeshFileAndAllocateMesh(pParameters,pMesh))
+                        // Adapt mesh to both molecular orbitals and new domain
+                        if (!performLevelSetAdaptation(pParameters,pMesh,
+                                                       pChemicalSystem,
+                                                            iterationInTheLoop))
                         {
                             PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"readMeshFileAndAllocateMesh ");
+                            fprintf(stderr,"performLevelSetAdaptation ");
                             fprintf(stderr,"function returned zero instead ");
                             fprintf(stderr,"of one.\n");
+                            free(pShapeGradient);
+                            pShapeGradient=NULL;
                             return 0;
                         }
 
-                        // Update the parameters of the computational box
-                        if (!updateDiscretizationParameters(pParameters,pMesh))
+                        // Compute p0 and reload the previous mesh
+                        p0=computeProbabilityAndReloadPreviousMesh(pParameters,
+                                                                   pMesh,pData,
+                                                                pChemicalSystem,
+                                                            iterationInTheLoop);
+                        if (p0==-10000.)
                         {
                             PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"updateDiscretizationParameters ");
-                            fprintf(stderr,"function returned zero instead ");
-                            fprintf(stderr,"of one.\n");
+                            fprintf(stderr,"computeProbabilityAnd");
+                            fprintf(stderr,"ReloadPreviousMesh function ");
+                            fprintf(stderr,"returned zero instead of one.\n");
+                            free(pShapeGradient);
+                            pShapeGradient=NULL;
                             return 0;
                         }
-
-//                        PRINT_ERROR("In optimization: ");
-//                        fprintf(stderr,"performLevelSetAdaptation function ");
-//                        fprintf(stderr,"returned zero instead of one.\n");
-//                        free(pShapeGradient);
-//                        pShapeGradient=NULL;
-//                        return 0;
                     }
-//                    else
-//                    {
-                        // Compute p1 and reload the previous mesh
-                        p1=computeProbabilityAndReloadPreviousMesh(pParameters,
-                                                            pMesh,
-                                                            pData,
-                                                            pChemicalSystem,
-                                                            iterationInTheLoop);
-                        if (p1==-10000.)
+                }
+                if (p0<p1)
+                {
+                    t0=t1;
+                }
+            }
+*/
+
+            // Finally compute the optimal line search
+            fprintf(stdout,"\nOPTIMAL STEP FOUND: %lf.\nCOMPUTING THE ",t0);
+            fprintf(stdout,"CORRESPONDING ADVECTED DOMAIN.\n");
+
+            for (i=0; i<pMesh->nver; i++)
+            {
+                pMesh->pver[i].value=t0*pShapeGradient[i];
+            }
+
+            // Free the memory allocated for pShapeGradient
+            free(pShapeGradient);
+            pShapeGradient=NULL;
+
+            if (t0*sqrt(h)<hMin*hMin)
+            {
+                pParameters->opt_mode=3;
+            }
+            else
+            {
+                pParameters->opt_mode=2;
+            }
+
+            // Save the shape gradient
+            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: saveTheShapeGradient ");
+                fprintf(stderr,"function returned zero instead of ");
+                fprintf(stderr,"one.\n");
+                return 0;
+            }
+
+            if (t0*sqrt(h)<hMin*hMin)
+            {
+                // Advect mesh thanks to Lagrangian mode of mmg3d software
+                if (!computeLagrangianMode(pParameters,pMesh,
+                                                            iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: ");
+                    fprintf(stderr,"computeLagrangianMode function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+            }
+            else
+            {
+                // Advect mesh thanks to Eulerian mode (level-set approach)
+                pParameters->opt_mode=2;
+                if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
+                {
+                    PRINT_ERROR("In optimization: ");
+                    fprintf(stderr,"computeEulerianMode function ");
+                    fprintf(stderr,"returned zero instead of one.\n");
+                    free(pShapeGradient);
+                    pShapeGradient=NULL;
+                    return 0;
+                }
+            }
+
+            // Adapt mesh to both molecular orbitals and new domain
+            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                return 0;
+            }
+
+            if (t0*sqrt(h)<hMin*hMin)
+            {
+                fprintf(stdout,"\nSTEP 3: COMPUTE PROBABILITY, POPULATION ");
+                fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
+            }
+            else
+            {
+                fprintf(stdout,"\nSTEP 6: COMPUTE PROBABILITY, POPULATION ");
+                fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
+            }
+
+            if ((iterationInTheLoop+1)%3==0)
+            {
+                pParameters->opt_mode=4;
+            }
+
+            // Compute the overlap matrix, probability, shape gradient, and
+            // residual for the new domain
+            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: shapeDerivative function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            // Save data and delete mesh if necessary
+            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pGlobalInitialTimer,
+                                               pStartLocalTimer,pEndLocalTimer))
+            {
+                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
+                fprintf(stderr,"returned zero instead of one.\n");
+                return 0;
+            }
+
+            pParameters->opt_mode=1;
+            break;
+
+// Omega_new=Omega_Old+Hexa(dP/dOmega_old>0)-Hexa(dP/dOmega_old<0)
+        case -1:
+
+            // Vizualize the mesh of the previous iteration
+            if (iterationInTheLoop>1)
+            {
+                if (pParameters->save_print>0)
+                {
+                    if ((iterationInTheLoop-1)%pParameters->save_print==0)
+                    {
+                        if (!plotMeshWithMeditSoftware(pParameters))
                         {
                             PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,
-                                    "computeProbabilityAndReloadPreviousMesh ");
+                            fprintf(stderr,"plotMeshWithMeditSoftware ");
                             fprintf(stderr,"function returned zero instead ");
                             fprintf(stderr,"of one.\n");
-                            free(pShapeGradient);
-                            pShapeGradient=NULL;
                             return 0;
                         }
-//                    }
-
-                    // Look if pMin satisfied Armijo's rule or not
-                    if (p1>=p0+.25*t1*h)
-                    {
-                        // Then look if Goldstein rule is satisfied or not
-                        if (p1<=p0+.75*t1*h)
-                        {
-                            tMin=t1;
-                            tMax=t1;
-                        }
-                        else
-                        {
-                            tMin=t1;
-                            if (p1<p0+pParameters->iter_told0p)
-                            {
-                                // Case where num. errors never yield Golstein
-                                tMax=tMin;
-                            }
-                            else
-                            {
-                                t1=.5*(tMax+tMin);
-                                fprintf(stdout,"\nRESTRICTING LINE SEARCH ");
-                                fprintf(stdout,"TO THE INTERVAL ");
-                                fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
-                                fprintf(stdout,"p(%lf)=%lf AND ",tMin,p1);
-                                fprintf(stdout,"COMPUTING p(%lf).\n",t1);
-
-                            }
-                        }
-                    }
-                    else
-                    {
-                        tMax=t1;
-                        t1=.5*(tMax+tMin);
-                        fprintf(stdout,"\nRESTRICTING LINE SEARCH ");
-                        fprintf(stdout,"TO THE INTERVAL ");
-                        fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
-                        fprintf(stdout,"p(%lf)=%lf AND ",tMax,p1);
-                        fprintf(stdout,"COMPUTING p(%lf).\n",t1);
                     }
-                } while (tMin!=tMax);
+                }
             }
 
-            // The optimal step has been found, update t0 (used after comments)
-            t0=t1;
-
-/*            tMax=1.;
-            tMin=0.;
-            pMin=pData->pnu[iterationInTheLoop-1];
-
-            // First perform an initial Eulerian perturbation of intensity one
-            fprintf(stdout,"\nSEARCHING THE STARTING INTERVAL FOR THE ");
-            fprintf(stdout,"OPTIMAL STEP.\nCOMPUTING p(%lf).\n",tMax);
-
-            // Save the shape gradient
-            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
+            // Compute the overlap matrix, probability, shape gradient, and
+            // residual for the new domain
+            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
+                                                            iterationInTheLoop))
             {
-                PRINT_ERROR("In optimization: saveTheShapeGradient function ");
+                PRINT_ERROR("In optimization: shapeDerivative function ");
                 fprintf(stderr,"returned zero instead of one.\n");
-                free(pShapeGradient);
-                pShapeGradient=NULL;
                 return 0;
             }
 
-            // Advect the mesh thanks to Eulerian mode (level-set approach)
-            if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
+            // Save data and delete mesh if necessary
+            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pGlobalInitialTimer,
+                                               pStartLocalTimer,pEndLocalTimer))
             {
-                PRINT_ERROR("In optimization: computeEulerianMode function ");
+                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
                 fprintf(stderr,"returned zero instead of one.\n");
-                free(pShapeGradient);
-                pShapeGradient=NULL;
                 return 0;
             }
+            break;
 
-            // Adapt the mesh to both molecular orbitals and new domain geometry
-            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
-                                                            iterationInTheLoop))
+// Omega_new=Omega_Old+Hexa[P(old+Hexa)>P(old)]-Hexa[P(old-Hexa)>P(old)]
+        case -2:
+
+            // Vizualize the mesh of the previous iteration
+            if (iterationInTheLoop>1)
             {
-                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                free(pShapeGradient);
-                pShapeGradient=NULL;
+                if (pParameters->save_print>0)
+                {
+                    if ((iterationInTheLoop-1)%pParameters->save_print==0)
+                    {
+                        if (!plotMeshWithMeditSoftware(pParameters))
+                        {
+                            PRINT_ERROR("In optimization: ");
+                            fprintf(stderr,"plotMeshWithMeditSoftware ");
+                            fprintf(stderr,"function returned zero instead ");
+                            fprintf(stderr,"of one.\n");
+                            return 0;
+                        }
+                    }
+                }
+            }
+
+            // Compute the overlap matrix, probability, shape gradient, and
+            // residual for the new domain after removing or adding hexahedron
+            // close to the boundary one by one according to the probability
+            if (!exhaustiveSearchAlgorithm(pParameters,pMesh,pData,
+                                            pChemicalSystem,iterationInTheLoop))
+            {
+                PRINT_ERROR("In optimization: shapeDerivative function ");
+                fprintf(stderr,"returned zero instead of one.\n");
                 return 0;
             }
 
-            // Compute pMax and reload the previous mesh
-            pMax=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
-                                                         pData,pChemicalSystem,
-                                                            iterationInTheLoop);
-            if (pMax==-10000.)
+            // Save data and delete mesh if necessary
+            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
+                                   iterationInTheLoop,pGlobalInitialTimer,
+                                               pStartLocalTimer,pEndLocalTimer))
             {
-                PRINT_ERROR("In optimization: ");
-                fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                free(pShapeGradient);
-                pShapeGradient=NULL;
+                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
+                fprintf(stderr,"returned zero instead of one.\n");
                 return 0;
             }
+            break;
 
-            // Trying to enlarge the searching interval
-            t0=tMax;
-            p0=pMax;
+            default:
+                PRINT_ERROR("In optimization: the opt_mode variable ");
+                fprintf(stderr,"(=%d) can only take ",pParameters->opt_mode);
+                fprintf(stderr,"the value 4, 3, 2, -1, or -2 inside the");
+                fprintf(stderr,"optimization function.\n ");
+                return 0;
+                break;
+    }
 
-            tMax=tMin;
-            pMax=pMin;
+    return 1;
+}
 
-            counter=0;
-            while (pMax<p0 && counter<5)
-            {
-                fprintf(stdout,"\nTRYING TO ENLARGE THE SEARCHING INTERVAL ");
-                fprintf(stdout,"[%lf, %lf].\n",tMax,t0);
-                fprintf(stdout,"p(%lf)=%lf p(%lf)=%lf. ",tMax,pMax,t0,p0);
 
-                tMin=tMax;
-                pMin=pMax;
+/* ************************************************************************** */
+// The function freeStartMemory frees the memory dynamically allocated for the
+// Parameters, Mesh, and Data structures of a Start structure (defined in
+// main.h) used in multi-start mode. The queued snapshots share the strings of
+// the Parameters structure and the ChemicalSystem structure of their start, so
+// they are all written first (an error is then only displayed). It has the
+// Start* variable as input argument and it does not return any value (void
+// output)
+/* ************************************************************************** */
+void freeStartMemory(Start* pStart)
+{
+    if (pStart!=NULL)
+    {
+        if (!waitForSnapshotWriter(&globalSnapshotWriter))
+        {
+            PRINT_ERROR("In freeStartMemory: waitForSnapshotWriter function ");
+            fprintf(stderr,"returned zero instead of one.\n");
+        }
+        freeMeshMemory(&pStart->mesh);
+        freeDataMemory(&pStart->data);
+        freeParameterMemory(&pStart->parameters);
+    }
 
-                tMax=t0;
-                pMax=p0;
+    return;
+}
 
-                counter++;
-                t0=exp(counter);
-                fprintf(stdout,"COMPUTING p(%lf).\n",t0);
+/* ************************************************************************** */
+// The function initializeStart builds the iStart-th initial domain of a
+// multi-start run: it copies the structure pointed by pParameters into the one
+// of the start, builds the hexahedral grid, initializes the domain from the
+// ls_* values of the start, and computes its initial data. It has the
+// Parameters*, ChemicalSystem*, Start* (all defined in main.h), the position of
+// the start and the time_t* pGlobalInitialTimer variables as input arguments.
+// It returns one on success, otherwise zero is returned if an error occurs
+/* ************************************************************************** */
+int initializeStart(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
+                    Start* pStart, int iStart, time_t* pGlobalInitialTimer)
+{
+    time_t startLocalTimer=0, endLocalTimer=0;
 
-                for (i=0; i<pMesh->nver; i++)
-                {
-                    pMesh->pver[i].value=t0*pShapeGradient[i];
-                }
+    // Check the input pointers
+    if (pParameters==NULL || pChemicalSystem==NULL || pStart==NULL ||
+                                                     pGlobalInitialTimer==NULL)
+    {
+        PRINT_ERROR("In initializeStart: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"pStart=%p, or ",(void*)pStart);
+        fprintf(stderr,"pGlobalInitialTimer=%p ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
 
-                // Save the shape gradient
-                if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: saveTheShapeGradient ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    fprintf(stdout,"\nSETTING UP THE START %d (OVER ",iStart);
+    fprintf(stdout,"%d).\n",pParameters->n_start);
+    time(&startLocalTimer);
+    beginProfilerPhase(&globalProfiler,PROF_SETUP);
 
-                // Advect the mesh thanks to Eulerian mode (level-set approach)
-                if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: computeEulerianMode ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    // Copy the parameters with the initial domain of the start
+    if (!copyParametersForStart(pParameters,&pStart->parameters,iStart))
+    {
+        PRINT_ERROR("In initializeStart: copyParametersForStart function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        return 0;
+    }
+
+    // Build the hexahedral grid (no *.mesh file is given in multi-start mode)
+    if (loadMesh(&pStart->parameters,&pStart->mesh)!=1)
+    {
+        PRINT_ERROR("In initializeStart: loadMesh function did not return ");
+        fprintf(stderr,"one (the default hexahedral grid may not have been ");
+        fprintf(stderr,"approved).\n");
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        return 0;
+    }
+
+    // Initialize the level-set function of the start on the grid
+    if (!adaptMesh(&pStart->parameters,&pStart->mesh,pChemicalSystem))
+    {
+        PRINT_ERROR("In initializeStart: adaptMesh function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        return 0;
+    }
+
+    if (!setupInitialData(&pStart->parameters,&pStart->mesh,&pStart->data,
+                          pChemicalSystem,pGlobalInitialTimer,&startLocalTimer,
+                                                               &endLocalTimer))
+    {
+        PRINT_ERROR("In initializeStart: setupInitialData function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        return 0;
+    }
+
+    // Set up the state of the optimization loop as in the main function
+    initializeStartLoop(pStart);
+
+    endProfilerPhase(&globalProfiler,PROF_SETUP);
+    // Write the record of the setup in the report of the profiler
+    if (!writeProfilerRecord(&globalProfiler,iStart,0))
+    {
+        PRINT_ERROR("In initializeStart: writeProfilerRecord function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        return 0;
+    }
+
+    time(&endLocalTimer);
+    fprintf(stdout,"\nSTART %d READY FOR THE OPTIMIZATION LOOP: ",iStart);
+    printTimer(endLocalTimer,startLocalTimer);
+    fprintf(stdout,".\n");
+
+    return 1;
+}
+
+/* ************************************************************************** */
+// The function initializeStartLoop sets up the state of the optimization loop
+// of a start (multi-start and scan modes) as it is done in the main function
+// before the optimization loop, including the switch from opt_mode=0 to
+// opt_mode=-1. It has the Start* variable (defined in main.h) as input argument
+// and it does not return any value (void output)
+/* ************************************************************************** */
+void initializeStartLoop(Start* pStart)
+{
+    if (pStart!=NULL)
+    {
+        pStart->status=0;
+        pStart->iter=1;
+        pStart->last=0;
+        pStart->optMode=-1;
+        if (!pStart->parameters.opt_mode)
+        {
+            pStart->optMode=pStart->parameters.opt_mode;
+            pStart->parameters.opt_mode=-1;
+        }
+        if (pStart->parameters.iter_max<1)
+        {
+            stopStart(pStart,2);
+        }
+    }
 
-                // Adapt mesh to both molecular orbitals and new domain geometry
-                if (!performLevelSetAdaptation(pParameters,pMesh,
-                                               pChemicalSystem,
-                                                            iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    return;
+}
 
-                // Compute p0 and reload the previous mesh
-                p0=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
-                                                           pData,
-                                                           pChemicalSystem,
-                                                            iterationInTheLoop);
-                if (p0==-10000.)
-                {
-                    PRINT_ERROR("In optimization: ");
-                    fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+/* ************************************************************************** */
+// The function stopStart stops the optimization loop of a start in multi-start
+// mode by setting its status, and restores the opt_mode variable and the data
+// modified at the switch from opt_mode=-1 to opt_mode=-2 (if it occurred). It
+// has the Start* variable (defined in main.h) and the new status (one, two, or
+// minus one) as input arguments and it does not return any value (void output)
+/* ************************************************************************** */
+void stopStart(Start* pStart, int status)
+{
+    if (pStart!=NULL)
+    {
+        pStart->status=status;
+        if (!pStart->optMode)
+        {
+            pStart->optMode=-1;
+            if (pStart->parameters.opt_mode==-2)
+            {
+                pStart->data.d0p[pStart->iStop]=pStart->d0p;
+                pStart->data.d1p[pStart->iStop]=pStart->d1p;
+                pStart->data.d2p[pStart->iStop]=pStart->d2p;
             }
+            pStart->parameters.opt_mode=0;
+        }
+    }
 
-            if (pMax>=p0)
-            {
+    return;
+}
 
-                tMax=t0;
-                pMax=p0;
+/* ************************************************************************** */
+// The function iterateStart performs the next iteration of the optimization
+// loop of a running start in multi-start mode, following exactly what is done
+// in the loop of the main function for the hexahedral optimization (including
+// the switch from opt_mode=-1 to opt_mode=-2 when opt_mode=0). It has the
+// Start*, ChemicalSystem* (both defined in main.h), the position of the start
+// and the time_t* pGlobalInitialTimer variables as input arguments. It returns
+// one on success, otherwise zero is returned if an error occurs
+/* ************************************************************************** */
+int iterateStart(Start* pStart, ChemicalSystem* pChemicalSystem, int iStart,
+                                                    time_t* pGlobalInitialTimer)
+{
+    int i=0, j=0, returnValue=0;
+    time_t startLocalTimer=0, endLocalTimer=0;
+    Parameters *pParameters=NULL;
+    Mesh *pMesh=NULL;
+    Data *pData=NULL;
 
-                // Starting golden-line search on the initial interval
-                fprintf(stdout,"\nINITIAL INTERVAL FOUND: ");
-                fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
-                fprintf(stdout,"STARTING THE GOLDEN-SECTION LINE SEARCH.\n");
+    // Check the input pointers
+    if (pStart==NULL || pChemicalSystem==NULL || pGlobalInitialTimer==NULL)
+    {
+        PRINT_ERROR("In iterateStart: one of the input pointers ");
+        fprintf(stderr,"pStart=%p, ",(void*)pStart);
+        fprintf(stderr,"pChemicalSystem=%p, or ",(void*)pChemicalSystem);
+        fprintf(stderr,"pGlobalInitialTimer=%p ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
 
-                h=tMax-tMin;
-                if (tMax==1.)
-                {
-                    nMax=2;
-                    //nMax=(int)(floor(log(1.e-1/h)/log(INV_PHI)));
-                }
-                else
-                {
-                    nMax=0;
-                }
+    // Nothing to do if the start has already stopped
+    if (pStart->status)
+    {
+        return 1;
+    }
 
-                // Evaluation of p0 (t0<1. Lagr. otherwise Eulerian approach)
-                t0=tMin+INV_PHI2*h;
-                for (i=0; i<pMesh->nver; i++)
-                {
-                    pMesh->pver[i].value=t0*pShapeGradient[i];
-                }
+    pParameters=&pStart->parameters;
+    pMesh=&pStart->mesh;
+    pData=&pStart->data;
+    i=pStart->iter;
 
-                // Save the shape gradient
-                if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: saveTheShapeGradient");
-                    fprintf(stderr," function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    time(&startLocalTimer);
+    beginProfilerPhase(&globalProfiler,PROF_ITERATION);
+    returnValue=optimization(pParameters,pMesh,pData,pChemicalSystem,i,
+                           pGlobalInitialTimer,&startLocalTimer,&endLocalTimer);
+    endProfilerPhase(&globalProfiler,PROF_ITERATION);
+    switch (returnValue)
+    {
+        case 1:
+            time(&endLocalTimer);
+            fprintf(stdout,"\nSTART %d: ITERATION %d COMPLETED: ",iStart,i);
+            printTimer(endLocalTimer,startLocalTimer);
+            fprintf(stdout,".\nSTART %d: PROBABILITY ",iStart);
+            fprintf(stdout,"%.8le\n",pData->pnu[i]);
+            pStart->last=i;
+            pStart->iter++;
+            if (pStart->iter>pParameters->iter_max)
+            {
+                stopStart(pStart,2);
+            }
+            break;
 
-                if (t0<1.)
+        case -1:
+            if (pStart->optMode==0 && pParameters->opt_mode==-1)
+            {
+                // The same iteration is performed again with opt_mode=-2
+                pParameters->opt_mode=-2;
+                pStart->iStop=i-1;
+                pStart->d0p=pData->d0p[i-1];
+                pStart->d1p=pData->d1p[i-1];
+                pStart->d2p=pData->d2p[i-1];
+                pData->d0p[i-1]+=pParameters->iter_told0p;
+                pData->d1p[i-1]+=pParameters->iter_told1p;
+                pData->d2p[i-1]+=pParameters->iter_told2p;
+
+                // At the transition, undo on labels the shape gradient mode
+                for (j=0; j<pMesh->nadj; j++)
                 {
-                    // Advect mesh thanks to Lagrangian mode of mmg3d software
-                    if (!computeLagrangianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
+                    if (abs(pMesh->phex[pMesh->padj[j].hexout-1].label)==3)
                     {
-                        PRINT_ERROR("In optimization: computeLagrangianMode ");
-                        fprintf(stderr,"function returned zero instead of ");
-                        fprintf(stderr,"one.\n");
-                        free(pShapeGradient);
-                        pShapeGradient=NULL;
-                        return 0;
+                        pMesh->phex[pMesh->padj[j].hexout-1].label=2;
                     }
-                }
-                else
-                {
-                    // Advect mesh thanks to Eulerian mode (level-set approach)
-                    if (!computeEulerianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
+                    if (abs(pMesh->phex[pMesh->padj[j].hexin-1].label)==2)
                     {
-                        PRINT_ERROR("In optimization: computeEulerianMode ");
-                        fprintf(stderr,"function returned zero instead of ");
-                        fprintf(stderr,"one.\n");
-                        free(pShapeGradient);
-                        pShapeGradient=NULL;
-                        return 0;
+                        pMesh->phex[pMesh->padj[j].hexin-1].label=3;
                     }
                 }
+            }
+            else
+            {
+                stopStart(pStart,1);
+            }
+            break;
 
-                // Adapt mesh to both molecular orbitals and new domain geometry
-                if (!performLevelSetAdaptation(pParameters,pMesh,
-                                            pChemicalSystem,iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+        default:
+            PRINT_ERROR("In iterateStart: optimization function returned ");
+            fprintf(stderr,"zero instead of (+/-)one for the ");
+            fprintf(stderr,"%d-th iteration of the %d-th start.\n",i,iStart);
+            return 0;
+            break;
+    }
 
-                // Compute p0 and reload the previous mesh
-                p0=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
-                                                           pData,
-                                                           pChemicalSystem,
-                                                            iterationInTheLoop);
-                if (p0==-10000.)
-                {
-                    PRINT_ERROR("In optimization: ");
-                    fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    // Write the record of the iteration in the report of the profiler
+    if (!writeProfilerRecord(&globalProfiler,iStart,i))
+    {
+        PRINT_ERROR("In iterateStart: writeProfilerRecord function returned ");
+        fprintf(stderr,"zero instead of one.\n");
+        return 0;
+    }
 
-                // Evaluation of p1 (t1<1. Lagr. otherwise Eulerian approach)
-                t1=tMin+INV_PHI*h;
-                fprintf(stdout,"\nFIRST EVALUATION ENDED: p(%lf)=%lf; ",t0,p0);
-                fprintf(stdout,"COMPUTING p(%lf).\n",t1);
-                for (i=0; i<pMesh->nver; i++)
-                {
-                    pMesh->pver[i].value=t1*pShapeGradient[i];
-                }
+    return 1;
+}
 
-                // Save the shape gradient
-                if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: saveTheShapeGradient ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+/* ************************************************************************** */
+// The function cutOffStarts stops the running starts of a multi-start run that
+// cannot reach anymore the best probability obtained so far: a start is cut off
+// if its probability, increased at each of its remaining iterations by the
+// largest (positive) variation of its START_CUT_WINDOW last iterations, stays
+// below the best probability minus START_CUT_TOL. It has the Start* variable
+// (defined in main.h) pointing to the array of starts and its size as input
+// arguments, and it returns the number of starts still running (or minus one
+// if an error occurs)
+/* ************************************************************************** */
+int cutOffStarts(Start* pStart, int nStart)
+{
+    int i=0, k=0, nRun=0, last=0;
+    double best=0., growth=0., pMax=0.;
 
-                if (t1<1.)
-                {
-                    // Advect mesh thanks to Lagrangian mode of mmg3d software
-                    if (!computeLagrangianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                    {
-                        PRINT_ERROR("In optimization: computeLagrangianMode ");
-                        fprintf(stderr,"function returned zero instead of ");
-                        fprintf(stderr,"one.\n");
-                        free(pShapeGradient);
-                        pShapeGradient=NULL;
-                        return 0;
-                    }
-                }
-                else
-                {
-                    // Advect mesh thanks to Eulerian mode (level-set approach)
-                    if (!computeEulerianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                    {
-                        PRINT_ERROR("In optimization: computeEulerianMode ");
-                        fprintf(stderr,"function returned zero instead of ");
-                        fprintf(stderr,"one.\n");
-                        free(pShapeGradient);
-                        pShapeGradient=NULL;
-                        return 0;
-                    }
-                }
+    // Check the input variables
+    if (pStart==NULL || nStart<1)
+    {
+        PRINT_ERROR("In cutOffStarts: the input pStart variable ");
+        fprintf(stderr,"(=%p) must point to an array of ",(void*)pStart);
+        fprintf(stderr,"nStart (=%d) starts.\n",nStart);
+        return -1;
+    }
 
-                // Adapt mesh to both molecular orbitals and new domain geometry
-                if (!performLevelSetAdaptation(pParameters,pMesh,
-                                               pChemicalSystem,
-                                                            iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    // Get the best probability obtained so far
+    best=pStart[0].data.pnu[pStart[0].last];
+    for (k=1; k<nStart; k++)
+    {
+        best=DEF_MAX(best,pStart[k].data.pnu[pStart[k].last]);
+    }
 
-                // Compute p1 and reload the previous mesh
-                p1=computeProbabilityAndReloadPreviousMesh(pParameters,pMesh,
-                                                           pData,
-                                                           pChemicalSystem,
-                                                            iterationInTheLoop);
-                if (p1==-10000.)
-                {
-                    PRINT_ERROR("In optimization: ");
-                    fprintf(stderr,"computeProbabilityAndReloadPreviousMesh ");
-                    fprintf(stderr,"function returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
+    // Cut off the running starts that cannot reach the best probability
+    for (k=0; k<nStart; k++)
+    {
+        if (pStart[k].status)
+        {
+            continue;
+        }
+
+        // A single decreasing iteration is not enough to cut off a start: its
+        // best progress over the last START_CUT_WINDOW iterations is used
+        last=pStart[k].last;
+        if (last>=START_CUT_WINDOW)
+        {
+            growth=0.;
+            for (i=last-START_CUT_WINDOW+1; i<=last; i++)
+            {
+                growth=DEF_MAX(growth,
+                            pStart[k].data.pnu[i]-pStart[k].data.pnu[i-1]);
+            }
+            pMax=pStart[k].data.pnu[last]+
+                                (pStart[k].parameters.iter_max-last)*growth;
+            if (pMax+START_CUT_TOL<best)
+            {
+                fprintf(stdout,"\nSTART %d CUT OFF AT ITERATION ",k+1);
+                fprintf(stdout,"%d: its probability ",last);
+                fprintf(stdout,"(=%lf) cannot ",pStart[k].data.pnu[last]);
+                fprintf(stdout,"reach more than %lf before ",pMax);
+                fprintf(stdout,"iter_max, below the best one ");
+                fprintf(stdout,"(=%lf).\n",best);
+                stopStart(&pStart[k],-1);
+                continue;
+            }
+        }
+        nRun++;
+    }
+
+    return nRun;
+}
+
+/* ************************************************************************** */
+// The function printRankingOfStarts prints in the standard output stream the
+// summary of a multi-start run, where the starts are ranked by decreasing order
+// of their final probability. It has the Start* variable (defined in main.h)
+// pointing to the array of starts and its size as input arguments, and it
+// returns zero if an error occurs, otherwise one is returned
+/* ************************************************************************** */
+int printRankingOfStarts(Start* pStart, int nStart)
+{
+    int i=0, j=0, k=0, *pRank=NULL;
+    double pnu=0.;
+    Start *pStartK=NULL;
+
+    // Check the input variables
+    if (pStart==NULL || nStart<1)
+    {
+        PRINT_ERROR("In printRankingOfStarts: the input pStart variable ");
+        fprintf(stderr,"(=%p) must point to an array of ",(void*)pStart);
+        fprintf(stderr,"nStart (=%d) starts.\n",nStart);
+        return 0;
+    }
+
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    pRank=(int*)calloc(nStart,sizeof(int));
+    if (pRank==NULL)
+    {
+        PRINT_ERROR("In printRankingOfStarts: could not allocate memory for ");
+        fprintf(stderr,"the local (int*) pRank variable.\n");
+        return 0;
+    }
+
+    // Insertion sort by decreasing probability (the number of starts is small)
+    for (i=0; i<nStart; i++)
+    {
+        pnu=pStart[i].data.pnu[pStart[i].last];
+        j=i;
+        while (j>0 && pStart[pRank[j-1]].data.pnu[pStart[pRank[j-1]].last]<pnu)
+        {
+            pRank[j]=pRank[j-1];
+            j--;
+        }
+        pRank[j]=i;
+    }
+
+    fprintf(stdout,"\nRANKING OF THE %d STARTS:\n",nStart);
+    for (i=0; i<nStart; i++)
+    {
+        k=pRank[i];
+        pStartK=&pStart[k];
+        fprintf(stdout,"%d) start %d (ls_type %d, ",i+1,k+1,
+                                                pStartK->parameters.ls_type);
+        fprintf(stdout,"center (%lf,",pStartK->parameters.ls_x);
+        fprintf(stdout,"%lf,%lf), ",pStartK->parameters.ls_y,
+                                                   pStartK->parameters.ls_z);
+        fprintf(stdout,"ls_r %lf): ",pStartK->parameters.ls_r);
+        fprintf(stdout,"probability %.8le ",
+                                          pStartK->data.pnu[pStartK->last]);
+        fprintf(stdout,"(population %lf) ",pStartK->data.pop[pStartK->last]);
+        fprintf(stdout,"after %d iteration",pStartK->last);
+        if (pStartK->last!=1)
+        {
+            fprintf(stdout,"s");
+        }
+        switch (pStartK->status)
+        {
+            case 1:
+                fprintf(stdout,", stop criteria satisfied");
+                break;
 
-                for (n=0; n<nMax; n++)
-                {
-                    if (p0<p1)
-                    {
-                        tMin=t0;
-                        pMin=p0;
+            case 2:
+                fprintf(stdout,", maximal number of iterations reached");
+                break;
 
-                        t0=t1;
-                        p0=p1;
+            default:
+                fprintf(stdout,", cut off");
+                break;
+        }
+        fprintf(stdout," (%s).\n",pStartK->parameters.name_mesh);
+    }
 
-                        h*=INV_PHI;
-                        t1=tMin+INV_PHI*h;
+    // Free the memory allocated for pRank
+    free(pRank);
+    pRank=NULL;
 
-                        fprintf(stdout,"\nTRYING TO RESTRICT THE LINE SEARCH ");
-                        fprintf(stdout,"ON THE INTERVAL ");
-                        fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
-                        fprintf(stdout,"p(%lf)=%lf ",tMin,pMin);
-                        fprintf(stdout,"p(%lf)=%lf ",t0,p0);
-                        fprintf(stdout,"p(%lf)=%lf.\nCOMPUTING ",tMax,pMax);
-                        fprintf(stdout,"p(%lf).\n",t1);
+    return 1;
+}
 
-                        for (i=0; i<pMesh->nver; i++)
-                        {
-                            pMesh->pver[i].value=t1*pShapeGradient[i];
-                        }
+/* ************************************************************************** */
+// The function multiStartOptimization optimizes the n_start initial domains
+// given in the *.info file (multi-start mode). All the starts share the same
+// ChemicalSystem structure and are built on the same hexahedral grid. They are
+// optimized in turn, one iteration for each running start per round (each
+// iteration being itself parallelized over the n_cpu threads, running the
+// starts concurrently would only oversubscribe the processors and duplicate the
+// memory of the overlap matrices), and after each round, the starts that cannot
+// reach anymore the best probability are cut off. Finally, the starts are
+// ranked by decreasing order of their final probability. It has the
+// Parameters*, ChemicalSystem* (both defined in main.h), and the time_t*
+// pGlobalInitialTimer variables as input arguments. It returns one on success,
+// otherwise zero is returned if an error occurs
+/* ************************************************************************** */
+int multiStartOptimization(Parameters* pParameters,
+                           ChemicalSystem* pChemicalSystem,
+                                                    time_t* pGlobalInitialTimer)
+{
+    int k=0, nStart=0, nRun=0, round=0;
+    Start *pStart=NULL;
 
-                       // Save the shape gradient
-                       if (!saveTheShapeGradient(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                       {
-                           PRINT_ERROR("In optimization: ");
-                           fprintf(stderr,"saveTheShapeGradient function ");
-                           fprintf(stderr,"returned zero instead of one.\n");
-                           free(pShapeGradient);
-                           pShapeGradient=NULL;
-                           return 0;
-                       }
+    // Check the input pointers
+    if (pParameters==NULL || pChemicalSystem==NULL || pGlobalInitialTimer==NULL)
+    {
+        PRINT_ERROR("In multiStartOptimization: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pChemicalSystem=%p, or ",(void*)pChemicalSystem);
+        fprintf(stderr,"pGlobalInitialTimer=%p ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
 
-                       if (t1<1.)
-                       {
-                            // Advect mesh thanks to Lagrangian mode of mmg3d
-                            if (!computeLagrangianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                            {
-                                PRINT_ERROR("In optimization: ");
-                                fprintf(stderr,"computeLagrangianMode ");
-                                fprintf(stderr,"function returned zero ");
-                                fprintf(stderr,"instead of one.\n");
-                                free(pShapeGradient);
-                                pShapeGradient=NULL;
-                                return 0;
-                            }
-                        }
-                        else
-                        {
-                            // Advect mesh thanks to Eul. mode (level-set mode)
-                            if (!computeEulerianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                            {
-                                PRINT_ERROR("In optimization: ");
-                                fprintf(stderr,"computeEulerianMode function ");
-                                fprintf(stderr,"returned zero instead of ");
-                                fprintf(stderr,"one.\n");
-                                free(pShapeGradient);
-                                pShapeGradient=NULL;
-                                return 0;
-                            }
-                        }
+    nStart=pParameters->n_start;
+    if (nStart<1 || pParameters->opt_mode>0)
+    {
+        PRINT_ERROR("In multiStartOptimization: the n_start variable ");
+        fprintf(stderr,"(=%d) of the structure pointed by ",nStart);
+        fprintf(stderr,"pParameters should be positive and the opt_mode ");
+        fprintf(stderr,"variable (=%d) ",pParameters->opt_mode);
+        fprintf(stderr,"should refer to an hexahedral optimization.\n");
+        return 0;
+    }
 
-                        // Adapt mesh to both molecular orbitals and new domain
-                        if (!performLevelSetAdaptation(pParameters,pMesh,
-                                                   pChemicalSystem,
-                                                            iterationInTheLoop))
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"performLevelSetAdaptation ");
-                            fprintf(stderr,"function returned zero instead ");
-                            fprintf(stderr,"of one.\n");
-                            free(pShapeGradient);
-                            pShapeGradient=NULL;
-                            return 0;
-                        }
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    pStart=(Start*)calloc(nStart,sizeof(Start));
+    if (pStart==NULL)
+    {
+        PRINT_ERROR("In multiStartOptimization: could not allocate memory ");
+        fprintf(stderr,"for the local (Start*) pStart variable.\n");
+        return 0;
+    }
+    for (k=0; k<nStart; k++)
+    {
+        initializeParameterStructure(&pStart[k].parameters);
+        initializeMeshStructure(&pStart[k].mesh);
+        initializeDataStructure(&pStart[k].data);
+    }
 
-                        // Compute p1 and reload the previous mesh
-                        p1=computeProbabilityAndReloadPreviousMesh(pParameters,
-                                                                   pMesh,pData,
-                                                                pChemicalSystem,
-                                                            iterationInTheLoop);
-                        if (p1==-10000.)
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"computeProbability");
-                            fprintf(stderr,"AndReloadPreviousMesh function ");
-                            fprintf(stderr,"returned zero instead of one.\n");
-                            free(pShapeGradient);
-                            pShapeGradient=NULL;
-                            return 0;
-                        }
-                    }
-                    else
-                    {
-                        tMax=t1;
-                        pMax=p1;
+    // Build the initial domains and compute their initial data
+    for (k=0; k<nStart; k++)
+    {
+        if (!initializeStart(pParameters,pChemicalSystem,&pStart[k],k+1,
+                                                          pGlobalInitialTimer))
+        {
+            PRINT_ERROR("In multiStartOptimization: initializeStart ");
+            fprintf(stderr,"function returned zero instead of one for the ");
+            fprintf(stderr,"%d-th start.\n",k+1);
+            for (k=0; k<nStart; k++)
+            {
+                freeStartMemory(&pStart[k]);
+            }
+            free(pStart);
+            pStart=NULL;
+            return 0;
+        }
+    }
 
-                        t1=t0;
-                        p1=p0;
+    // Optimization loop: one iteration per running start in each round
+    nRun=cutOffStarts(pStart,nStart);
+    while (nRun>0)
+    {
+        round++;
+        fprintf(stdout,"\nROUND %d OF THE MULTI-START ",round);
+        fprintf(stdout,"OPTIMIZATION: %d START",nRun);
+        if (nRun>1)
+        {
+            fprintf(stdout,"S");
+        }
+        fprintf(stdout," RUNNING.\n");
+        for (k=0; k<nStart; k++)
+        {
+            if (!iterateStart(&pStart[k],pChemicalSystem,k+1,
+                                                          pGlobalInitialTimer))
+            {
+                PRINT_ERROR("In multiStartOptimization: iterateStart ");
+                fprintf(stderr,"function returned zero instead of one for ");
+                fprintf(stderr,"the %d-th start.\n",k+1);
+                nRun=-1;
+                break;
+            }
+        }
+        if (nRun>=0)
+        {
+            nRun=cutOffStarts(pStart,nStart);
+        }
+    }
 
-                        h*=INV_PHI;
-                        t0=tMin+INV_PHI2*h;
+    // Rank the starts (all the snapshots must have been written before the
+    // memory of the starts is freed)
+    if (!nRun && !printRankingOfStarts(pStart,nStart))
+    {
+        PRINT_ERROR("In multiStartOptimization: printRankingOfStarts ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        nRun=-1;
+    }
+    if (!waitForSnapshotWriter(&globalSnapshotWriter))
+    {
+        PRINT_ERROR("In multiStartOptimization: waitForSnapshotWriter ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        nRun=-1;
+    }
+    for (k=0; k<nStart; k++)
+    {
+        freeStartMemory(&pStart[k]);
+    }
+    free(pStart);
+    pStart=NULL;
 
-                        fprintf(stdout,"\nTRYING TO RESTRICT THE LINE SEARCH ");
-                        fprintf(stdout,"ON THE INTERVAL ");
-                        fprintf(stdout,"[%lf, %lf].\n",tMin,tMax);
-                        fprintf(stdout,"p(%lf)=%lf ",tMin,pMin);
-                        fprintf(stdout,"p(%lf)=%lf ",t1,p1);
-                        fprintf(stdout,"p(%lf)=%lf.\nCOMPUTING ",tMax,pMax);
-                        fprintf(stdout,"p(%lf).\n",t0);
+    return (nRun==0);
+}
 
-                        for (i=0; i<pMesh->nver; i++)
-                        {
-                            pMesh->pver[i].value=t0*pShapeGradient[i];
-                        }
+/* ************************************************************************** */
+// The function initializeGeometry builds the domain of the iGeom-th geometry of
+// a scan and computes its initial data. The first geometry starts from the
+// domain given by the ls_* values, whereas the next ones inherit the
+// hexahedral grid of the previous geometry (possibly refined) and start from
+// its converged domain, moved along the displacements of the nuclei. It has two
+// Start* and ChemicalSystem* (defined in main.h) variables (the previous ones
+// being NULL for the first geometry), the position of the geometry and the
+// time_t* pGlobalInitialTimer variables as input arguments. It returns one on
+// success, otherwise zero is returned if an error occurs
+/* ************************************************************************** */
+int initializeGeometry(Start* pPrevious,
+                      ChemicalSystem* pPreviousChemicalSystem, Start* pGeometry,
+                 ChemicalSystem* pChemicalSystem, int iGeom,
+                                               time_t* pGlobalInitialTimer)
+{
+    time_t startLocalTimer=0, endLocalTimer=0;
+    Parameters *pParameters=NULL;
 
-                        // Save the shape gradient
-                        if (!saveTheShapeGradient(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"saveTheShapeGradient function ");
-                            fprintf(stderr,"returned zero instead of one.\n");
-                            free(pShapeGradient);
-                            pShapeGradient=NULL;
-                            return 0;
-                        }
+    // Check the input pointers
+    if (pGeometry==NULL || pChemicalSystem==NULL || pGlobalInitialTimer==NULL ||
+                          (pPrevious!=NULL && pPreviousChemicalSystem==NULL))
+    {
+        PRINT_ERROR("In initializeGeometry: one of the input pointers ");
+        fprintf(stderr,"pPrevious=%p, ",(void*)pPrevious);
+        fprintf(stderr,"pPreviousChemicalSystem=%p, ",
+                                              (void*)pPreviousChemicalSystem);
+        fprintf(stderr,"pGeometry=%p, ",(void*)pGeometry);
+        fprintf(stderr,"pChemicalSystem=%p, or ",(void*)pChemicalSystem);
+        fprintf(stderr,"pGlobalInitialTimer=%p ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
 
-                        if (t0<1.)
-                        {
-                            // Advect mesh thanks to Lagrangian mode of mmg3d
-                            if (!computeLagrangianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                            {
-                                PRINT_ERROR("In optimization: ");
-                                fprintf(stderr,"computeLagrangianMode ");
-                                fprintf(stderr,"function returned zero ");
-                                fprintf(stderr,"instead of one.\n");
-                                free(pShapeGradient);
-                                pShapeGradient=NULL;
-                                return 0;
-                            }
-                        }
-                        else
-                        {
-                            // Advect mesh thanks to Eul. mode (level-set mode)
-                            if (!computeEulerianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                            {
-                                PRINT_ERROR("In optimization: ");
-                                fprintf(stderr,"computeEulerianMode function ");
-                                fprintf(stderr,"returned zero instead of ");
-                                fprintf(stderr,"one.\n");
-                                free(pShapeGradient);
-                                pShapeGradient=NULL;
-                                return 0;
-                            }
-                        }
+    pParameters=&pGeometry->parameters;
+    fprintf(stdout,"\nSETTING UP THE GEOMETRY %d (%s).\n",iGeom,
+                                                        pParameters->name_chem);
+    time(&startLocalTimer);
+    beginProfilerPhase(&globalProfiler,PROF_SETUP);
 
-                        // Adapt mesh to both molecular orbitals and new domain
-                        if (!performLevelSetAdaptation(pParameters,pMesh,
-                                                       pChemicalSystem,
-                                                            iterationInTheLoop))
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"performLevelSetAdaptation ");
-                            fprintf(stderr,"function returned zero instead ");
-                            fprintf(stderr,"of one.\n");
-                            free(pShapeGradient);
-                            pShapeGradient=NULL;
-                            return 0;
-                        }
+    // The next geometries are optimized on the grid of the previous one
+    if (pPrevious!=NULL)
+    {
+        pParameters->n_x=pPrevious->parameters.n_x;
+        pParameters->n_y=pPrevious->parameters.n_y;
+        pParameters->n_z=pPrevious->parameters.n_z;
+        pParameters->delta_x=pPrevious->parameters.delta_x;
+        pParameters->delta_y=pPrevious->parameters.delta_y;
+        pParameters->delta_z=pPrevious->parameters.delta_z;
+        pParameters->n_level=pPrevious->parameters.n_level;
+    }
 
-                        // Compute p0 and reload the previous mesh
-                        p0=computeProbabilityAndReloadPreviousMesh(pParameters,
-                                                                   pMesh,pData,
-                                                                pChemicalSystem,
-                                                            iterationInTheLoop);
-                        if (p0==-10000.)
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"computeProbabilityAnd");
-                            fprintf(stderr,"ReloadPreviousMesh function ");
-                            fprintf(stderr,"returned zero instead of one.\n");
-                            free(pShapeGradient);
-                            pShapeGradient=NULL;
-                            return 0;
-                        }
-                    }
-                }
-                if (p0<p1)
-                {
-                    t0=t1;
-                }
-            }
-*/
+    // Build the hexahedral grid (no *.mesh file is given in scan mode)
+    if (loadMesh(pParameters,&pGeometry->mesh)!=1)
+    {
+        PRINT_ERROR("In initializeGeometry: loadMesh function did not return ");
+        fprintf(stderr,"one (the default hexahedral grid may not have been ");
+        fprintf(stderr,"approved).\n");
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        return 0;
+    }
+
+    if (pPrevious==NULL)
+    {
+        // Initialize the level-set function of the first geometry on the grid
+        if (!adaptMesh(pParameters,&pGeometry->mesh,pChemicalSystem))
+        {
+            PRINT_ERROR("In initializeGeometry: adaptMesh function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+            endProfilerPhase(&globalProfiler,PROF_SETUP);
+            return 0;
+        }
+    }
+    else
+    {
+        // Move the converged domain of the previous geometry
+        if (!warpHexahedralDomain(&pPrevious->parameters,&pPrevious->mesh,
+                                  pPreviousChemicalSystem,pParameters,
+                                            &pGeometry->mesh,pChemicalSystem))
+        {
+            PRINT_ERROR("In initializeGeometry: warpHexahedralDomain ");
+            fprintf(stderr,"function returned zero instead of one.\n");
+            endProfilerPhase(&globalProfiler,PROF_SETUP);
+            return 0;
+        }
 
-            // Finally compute the optimal line search
-            fprintf(stdout,"\nOPTIMAL STEP FOUND: %lf.\nCOMPUTING THE ",t0);
-            fprintf(stdout,"CORRESPONDING ADVECTED DOMAIN.\n");
+        // Since we have added some quadrilaterals, save the new mesh
+        if (!writingMeshFile(pParameters,&pGeometry->mesh))
+        {
+            PRINT_ERROR("In initializeGeometry: writingMeshFile function ");
+            fprintf(stderr,"returned zero instead of one.\n");
+            endProfilerPhase(&globalProfiler,PROF_SETUP);
+            return 0;
+        }
+    }
 
-            for (i=0; i<pMesh->nver; i++)
-            {
-                pMesh->pver[i].value=t0*pShapeGradient[i];
-            }
+    if (!setupInitialData(pParameters,&pGeometry->mesh,&pGeometry->data,
+                          pChemicalSystem,pGlobalInitialTimer,&startLocalTimer,
+                                                               &endLocalTimer))
+    {
+        PRINT_ERROR("In initializeGeometry: setupInitialData function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        endProfilerPhase(&globalProfiler,PROF_SETUP);
+        return 0;
+    }
 
-            // Free the memory allocated for pShapeGradient
-            free(pShapeGradient);
-            pShapeGradient=NULL;
+    // Set up the state of the optimization loop as in the main function
+    initializeStartLoop(pGeometry);
 
-            if (t0*sqrt(h)<hMin*hMin)
-            {
-                pParameters->opt_mode=3;
-            }
-            else
-            {
-                pParameters->opt_mode=2;
-            }
+    endProfilerPhase(&globalProfiler,PROF_SETUP);
+    // Write the record of the setup in the report of the profiler
+    if (!writeProfilerRecord(&globalProfiler,iGeom,0))
+    {
+        PRINT_ERROR("In initializeGeometry: writeProfilerRecord ");
+        fprintf(stderr,"function returned zero instead of one.\n");
+        return 0;
+    }
 
-            // Save the shape gradient
-            if (!saveTheShapeGradient(pParameters,pMesh,iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: saveTheShapeGradient ");
-                fprintf(stderr,"function returned zero instead of ");
-                fprintf(stderr,"one.\n");
-                return 0;
-            }
+    time(&endLocalTimer);
+    fprintf(stdout,"\nGEOMETRY %d READY FOR THE OPTIMIZATION LOOP: ",iGeom);
+    printTimer(endLocalTimer,startLocalTimer);
+    fprintf(stdout,".\n");
 
-            if (t0*sqrt(h)<hMin*hMin)
-            {
-                // Advect mesh thanks to Lagrangian mode of mmg3d software
-                if (!computeLagrangianMode(pParameters,pMesh,
-                                                            iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: ");
-                    fprintf(stderr,"computeLagrangianMode function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
-            }
-            else
-            {
-                // Advect mesh thanks to Eulerian mode (level-set approach)
-                pParameters->opt_mode=2;
-                if (!computeEulerianMode(pParameters,pMesh,iterationInTheLoop))
-                {
-                    PRINT_ERROR("In optimization: ");
-                    fprintf(stderr,"computeEulerianMode function ");
-                    fprintf(stderr,"returned zero instead of one.\n");
-                    free(pShapeGradient);
-                    pShapeGradient=NULL;
-                    return 0;
-                }
-            }
+    return 1;
+}
 
-            // Adapt mesh to both molecular orbitals and new domain
-            if (!performLevelSetAdaptation(pParameters,pMesh,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: performLevelSetAdaptation ");
-                fprintf(stderr,"function returned zero instead of one.\n");
-                return 0;
-            }
+/* ************************************************************************** */
+// The function scanOptimization optimizes in turn the geometries of a scan
+// (reaction path, bond scan): the one of the name_chem file first, then the
+// n_geom ones given in the *.info file. Each geometry loads its own chemistry
+// and starts from the converged domain of the previous one (see the
+// initializeGeometry function), so that only a few iterations are usually
+// needed. A summary of the scan is finally printed, where the first geometry
+// is referred to by nameChem (the name_chem variable given in the *.info file,
+// replaced by loadChemistry). It has the Parameters*, ChemicalSystem* (both
+// defined in main.h), char* nameChem, and time_t* pGlobalInitialTimer
+// variables as input arguments. It returns one on success, otherwise zero is
+// returned if an error occurs
+/* ************************************************************************** */
+int scanOptimization(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
+                                    char* nameChem, time_t* pGlobalInitialTimer)
+{
+    int g=0, k=0, nGeom=0, boolean=0, *pLast=NULL, *pStatus=NULL;
+    double *pProbability=NULL;
+    Start pGeometry[2];
+    ChemicalSystem pChemical[2], *pChem[2]={NULL,NULL};
 
-            if (t0*sqrt(h)<hMin*hMin)
-            {
-                fprintf(stdout,"\nSTEP 3: COMPUTE PROBABILITY, POPULATION ");
-                fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
-            }
-            else
-            {
-                fprintf(stdout,"\nSTEP 6: COMPUTE PROBABILITY, POPULATION ");
-                fprintf(stdout,"AND SHAPE GRADIENT ON THE NEW DOMAIN.\n");
-            }
+    // Check the input pointers
+    if (pParameters==NULL || pChemicalSystem==NULL || nameChem==NULL ||
+                                                     pGlobalInitialTimer==NULL)
+    {
+        PRINT_ERROR("In scanOptimization: one of the input pointers ");
+        fprintf(stderr,"pParameters=%p, ",(void*)pParameters);
+        fprintf(stderr,"pChemicalSystem=%p, ",(void*)pChemicalSystem);
+        fprintf(stderr,"nameChem=%p, or ",(void*)nameChem);
+        fprintf(stderr,"pGlobalInitialTimer=%p ",(void*)pGlobalInitialTimer);
+        fprintf(stderr,"does not point to a valid address.\n");
+        return 0;
+    }
 
-            if ((iterationInTheLoop+1)%3==0)
-            {
-                pParameters->opt_mode=4;
-            }
+    nGeom=pParameters->n_geom+1;
+    if (nGeom<2 || pParameters->opt_mode>0)
+    {
+        PRINT_ERROR("In scanOptimization: the n_geom variable ");
+        fprintf(stderr,"(=%d) of the structure pointed ",pParameters->n_geom);
+        fprintf(stderr,"by pParameters should be positive and the opt_mode ");
+        fprintf(stderr,"variable (=%d) ",pParameters->opt_mode);
+        fprintf(stderr,"should refer to an hexahedral optimization.\n");
+        return 0;
+    }
 
-            // Compute the overlap matrix, probability, shape gradient, and
-            // residual for the new domain
-            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
-                                                            iterationInTheLoop))
-            {
-                PRINT_ERROR("In optimization: shapeDerivative function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
-            }
+    // calloc function returns a pointer to the allocated memory, otherwise NULL
+    pLast=(int*)calloc(nGeom,sizeof(int));
+    pStatus=(int*)calloc(nGeom,sizeof(int));
+    pProbability=(double*)calloc(nGeom,sizeof(double));
+    if (pLast==NULL || pStatus==NULL || pProbability==NULL)
+    {
+        PRINT_ERROR("In scanOptimization: could not allocate memory for ");
+        fprintf(stderr,"the local (int*) pLast, pStatus, and (double*) ");
+        fprintf(stderr,"pProbability variables.\n");
+        free(pLast);
+        free(pStatus);
+        free(pProbability);
+        return 0;
+    }
+    for (k=0; k<2; k++)
+    {
+        initializeParameterStructure(&pGeometry[k].parameters);
+        initializeMeshStructure(&pGeometry[k].mesh);
+        initializeDataStructure(&pGeometry[k].data);
+        initializeChemicalStructure(&pChemical[k]);
+    }
 
-            // Save data and delete mesh if necessary
-            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
-                                   iterationInTheLoop,pGlobalInitialTimer,
-                                               pStartLocalTimer,pEndLocalTimer))
+    // The geometries are optimized in turn, the previous one being kept until
+    // the domain of the next one has been built
+    boolean=1;
+    for (g=0; g<nGeom && boolean; g++)
+    {
+        k=g%2;
+        boolean=copyParametersForGeometry(pParameters,&pGeometry[k].parameters,
+                                                                           g+1);
+        if (!boolean)
+        {
+            PRINT_ERROR("In scanOptimization: copyParametersForGeometry ");
+            fprintf(stderr,"function returned zero instead of one for the ");
+            fprintf(stderr,"%d-th geometry.\n",g+1);
+            break;
+        }
+
+        // The chemistry of the first geometry has already been loaded
+        pChem[k]=pChemicalSystem;
+        if (g>0)
+        {
+            pChem[k]=&pChemical[k];
+            boolean=loadChemistry(&pGeometry[k].parameters,pChem[k]);
+            if (!boolean)
             {
-                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
+                PRINT_ERROR("In scanOptimization: loadChemistry function ");
+                fprintf(stderr,"returned zero instead of one for the ");
+                fprintf(stderr,"%d-th geometry.\n",g+1);
+                break;
             }
+        }
 
-            pParameters->opt_mode=1;
+        if (g>0)
+        {
+            boolean=initializeGeometry(&pGeometry[1-k],pChem[1-k],
+                                       &pGeometry[k],pChem[k],g+1,
+                                                          pGlobalInitialTimer);
+        }
+        else
+        {
+            boolean=initializeGeometry(NULL,NULL,&pGeometry[k],pChem[k],g+1,
+                                                          pGlobalInitialTimer);
+        }
+        if (!boolean)
+        {
+            PRINT_ERROR("In scanOptimization: initializeGeometry function ");
+            fprintf(stderr,"returned zero instead of one for the ");
+            fprintf(stderr,"%d-th geometry.\n",g+1);
             break;
+        }
 
-// Omega_new=Omega_Old+Hexa(dP/dOmega_old>0)-Hexa(dP/dOmega_old<0)
-        case -1:
-
-            // Vizualize the mesh of the previous iteration
-            if (iterationInTheLoop>1)
-            {
-                if (pParameters->save_print>0)
-                {
-                    if ((iterationInTheLoop-1)%pParameters->save_print==0)
-                    {
-                        if (!plotMeshWithMeditSoftware(pParameters))
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"plotMeshWithMeditSoftware ");
-                            fprintf(stderr,"function returned zero instead ");
-                            fprintf(stderr,"of one.\n");
-                            return 0;
-                        }
-                    }
-                }
+        // The snapshots of the previous geometry must have been written before
+        // its memory is freed
+        if (g>0)
+        {
+            boolean=waitForSnapshotWriter(&globalSnapshotWriter);
+            freeStartMemory(&pGeometry[1-k]);
+            initializeParameterStructure(&pGeometry[1-k].parameters);
+            initializeMeshStructure(&pGeometry[1-k].mesh);
+            initializeDataStructure(&pGeometry[1-k].data);
+            freeChemicalMemory(&pChemical[1-k]);
+            initializeChemicalStructure(&pChemical[1-k]);
+            if (!boolean)
+            {
+                PRINT_ERROR("In scanOptimization: waitForSnapshotWriter ");
+                fprintf(stderr,"function returned zero instead of one.\n");
+                break;
             }
+        }
 
-            // Compute the overlap matrix, probability, shape gradient, and
-            // residual for the new domain
-            if (!shapeDerivative(pParameters,pMesh,pData,pChemicalSystem,
-                                                            iterationInTheLoop))
+        // Optimization loop of the geometry
+        while (!pGeometry[k].status && boolean)
+        {
+            boolean=iterateStart(&pGeometry[k],pChem[k],g+1,
+                                                          pGlobalInitialTimer);
+            if (!boolean)
             {
-                PRINT_ERROR("In optimization: shapeDerivative function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
+                PRINT_ERROR("In scanOptimization: iterateStart function ");
+                fprintf(stderr,"returned zero instead of one for the ");
+                fprintf(stderr,"%d-th geometry.\n",g+1);
             }
+        }
 
-            // Save data and delete mesh if necessary
-            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
-                                   iterationInTheLoop,pGlobalInitialTimer,
-                                               pStartLocalTimer,pEndLocalTimer))
+        if (boolean)
+        {
+            pLast[g]=pGeometry[k].last;
+            pStatus[g]=pGeometry[k].status;
+            pProbability[g]=pGeometry[k].data.pnu[pGeometry[k].last];
+            fprintf(stdout,"\nGEOMETRY %d (OVER %d) ",g+1,nGeom);
+            fprintf(stdout,"OPTIMIZED AFTER ");
+            fprintf(stdout,"%d ITERATION(S): PROBABILITY ",pLast[g]);
+            fprintf(stdout,"%.8le.\n",pProbability[g]);
+        }
+    }
+
+    // Summary of the scan
+    if (boolean)
+    {
+        fprintf(stdout,"\nSUMMARY OF THE SCAN OVER %d GEOMETRIES:\n",nGeom);
+        for (g=0; g<nGeom; g++)
+        {
+            fprintf(stdout,"%d) ",g+1);
+            if (g>0)
             {
-                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
+                fprintf(stdout,"%s: ",pParameters->name_geom[g-1]);
             }
-            break;
-
-// Omega_new=Omega_Old+Hexa[P(old+Hexa)>P(old)]-Hexa[P(old-Hexa)>P(old)]
-        case -2:
-
-            // Vizualize the mesh of the previous iteration
-            if (iterationInTheLoop>1)
+            else
             {
-                if (pParameters->save_print>0)
-                {
-                    if ((iterationInTheLoop-1)%pParameters->save_print==0)
-                    {
-                        if (!plotMeshWithMeditSoftware(pParameters))
-                        {
-                            PRINT_ERROR("In optimization: ");
-                            fprintf(stderr,"plotMeshWithMeditSoftware ");
-                            fprintf(stderr,"function returned zero instead ");
-                            fprintf(stderr,"of one.\n");
-                            return 0;
-                        }
-                    }
-                }
+                fprintf(stdout,"%s: ",nameChem);
             }
-
-            // Compute the overlap matrix, probability, shape gradient, and
-            // residual for the new domain after removing or adding hexahedron
-            // close to the boundary one by one according to the probability
-            if (!exhaustiveSearchAlgorithm(pParameters,pMesh,pData,
-                                            pChemicalSystem,iterationInTheLoop))
+            fprintf(stdout,"probability %.8le after ",pProbability[g]);
+            fprintf(stdout,"%d iteration(s)",pLast[g]);
+            if (pStatus[g]==1)
             {
-                PRINT_ERROR("In optimization: shapeDerivative function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
+                fprintf(stdout,", stop criteria satisfied.\n");
             }
-
-            // Save data and delete mesh if necessary
-            if (!saveDataInTheLoop(pParameters,pMesh,pData,pChemicalSystem,
-                                   iterationInTheLoop,pGlobalInitialTimer,
-                                               pStartLocalTimer,pEndLocalTimer))
+            else
             {
-                PRINT_ERROR("In optimization: saveDataInTheLoop function ");
-                fprintf(stderr,"returned zero instead of one.\n");
-                return 0;
+                fprintf(stdout,", maximal number of iterations reached.\n");
             }
-            break;
+        }
+    }
 
-            default:
-                PRINT_ERROR("In optimization: the opt_mode variable ");
-                fprintf(stderr,"(=%d) can only take ",pParameters->opt_mode);
-                fprintf(stderr,"the value 4, 3, 2, -1, or -2 inside the");
-                fprintf(stderr,"optimization function.\n ");
-                return 0;
-                break;
+    // All the snapshots must have been written before the memory is freed
+    if (!waitForSnapshotWriter(&globalSnapshotWriter))
+    {
+        PRINT_ERROR("In scanOptimization: waitForSnapshotWriter function ");
+        fprintf(stderr,"returned zero instead of one.\n");
+        boolean=0;
     }
+    for (k=0; k<2; k++)
+    {
+        freeStartMemory(&pGeometry[k]);
+        freeChemicalMemory(&pChemical[k]);
+    }
+    free(pLast);
+    pLast=NULL;
+    free(pStatus);
+    pStatus=NULL;
+    free(pProbability);
+    pProbability=NULL;
 
-    return 1;
+    return boolean;
 }
-
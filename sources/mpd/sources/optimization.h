@@ -32,6 +32,80 @@
 */
 #define INV_PHI2 0.381966011250105152
 
+/**
+* \def SNAPSHOT_QUEUE_SIZE
+* \brief Maximal number of mesh snapshots that can be queued in the background
+*        writer (see \ref pushSnapshotInWriter) before the optimization loop
+*        has to wait for a slot to be released. Each snapshot stores a copy of
+*        the whole mesh, so this value bounds the extra memory used.
+*/
+#define SNAPSHOT_QUEUE_SIZE 3
+
+/**
+* \def SNAPSHOT_SIGNAL_WAIT
+* \brief Maximal number of periods of ten milliseconds during which the \ref
+*        waitForSnapshotWriterAtSignal function waits for the queued snapshots
+*        to be written when a signal is caught.
+*/
+#define SNAPSHOT_SIGNAL_WAIT 1000
+
+/**
+* \def HIST_MAGIC
+* \brief Eight characters written at the beginning of the *.hist history files
+*        (see \ref writingHistoryFile) in order to identify them.
+*/
+#define HIST_MAGIC "MPDHISTF"
+
+/**
+* \def HIST_VERSION
+* \brief Version of the binary layout of the *.hist history files, written in
+*        their header; it must be increased if the layout is modified (and
+*        the historyExtractor program of the mpdToolbox updated accordingly).
+*/
+#define HIST_VERSION 1
+
+/**
+* \def CHECK_MAGIC
+* \brief Eight characters written at the beginning of the *.chk checkpoint
+*        files (see \ref writingCheckpointFile) in order to identify them.
+*/
+#define CHECK_MAGIC "MPDCHECK"
+
+/**
+* \def CHECK_VERSION
+* \brief Version of the binary layout of the *.chk checkpoint files, written in
+*        their header; it must be increased if the layout is modified, so that
+*        the checkpoints written by a previous version are rejected.
+*/
+#define CHECK_VERSION 2
+
+/**
+* \def DATA_RING_SIZE
+* \brief Number of Probabilities and OverlapMatrix structures allocated in the
+*        Data structure (see \ref allocateMemoryForData). The optimization loop
+*        only needs the ones of the current and previous iterations (for the
+*        trick_matrix option and the exhaustive search), so the (iteration)-th
+*        ones are stored at the position (iteration)%(\ref DATA_RING_SIZE).
+*/
+#define DATA_RING_SIZE 2
+
+/**
+* \def START_CUT_WINDOW
+* \brief Number of the last iterations of a start of a multi-start run whose
+*        variations of probability are considered by the \ref cutOffStarts
+*        function (no start is cut off before having performed them), so that
+*        a start oscillating from one iteration to the other is not stopped.
+*/
+#define START_CUT_WINDOW 5
+
+/**
+* \def START_CUT_TOL
+* \brief Margin of probability by which a start of a multi-start run must
+*        stay below the best one in order to be cut off (see \ref
+*        cutOffStarts).
+*/
+#define START_CUT_TOL 1.e-3
+
 /* ************************************************************************** */
 // Constants defined in the article of Grundmann and Moller (april 1978) for 3D
 // numerical integration (formula used by default in Freefem++ software for
@@ -319,6 +393,11 @@ void freeDataMemory(Data* pData);
 *                            contained in the Probabilities and OverlapMatrix
 *                            structures pointed by pData->pprob and pData->pmat,
 *                            respectively.
+*
+* The scalar arrays (pnu, pop, d0p, d1p, d2p, tim, ctim) are sized according to
+* iter_max whereas only \ref DATA_RING_SIZE Probabilities and OverlapMatrix
+* structures are allocated, since their size grows like the square of nmorb.
+* They are used cyclically along the iterations of the optimization loop.
 */
 int allocateMemoryForData(Parameters* pParameters, Data* pData,
                                                ChemicalSystem* pChemicalSystem);
@@ -581,7 +660,7 @@ double computeVolumeTetrahedron(Point* pp1, Point* pp2, Point* pp3, Point* pp4);
 *        are not labelled labelToAvoid the coefficients of the overlap matrix
 *        associated with pChemicalSystem, and the corresponding values are
 *        saved in the coef array variable of the OverlapMatrix structure
-*        located at pData->pmat[iterationInTheLoop].
+*        located at pData->pmat[iterationInTheLoop%nring].
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function. Its orb_rhf variable is used
@@ -648,7 +727,7 @@ double computeVolumeTetrahedron(Point* pp1, Point* pp2, Point* pp3, Point* pp4);
 * pChemicalSystem, and where Omega corresponds to the tetrahedra of pMesh that
 * are not labelled labelToAvoid. These coefficients of the overlap matrix are
 * stored in the coef variable of the OverlapMatrix structure located at
-* pData->pmat[iterationInTheLoop]. The computational time is reduced for
+* pData->pmat[iterationInTheLoop%nring]. The computational time is reduced for
 * restricted Hartree-Fock system i.e. when pParameters->orb_rhf is set to one.
 * The evaluation of the integral uses a 14-point formula described in the
 * article of Grundmann and Moller (april 1978, cf. (4.5), p.288) and which is
@@ -909,7 +988,8 @@ double evaluateTripleIntegralIJ(Parameters* pParameters, Mesh *pMesh,
 *        the pParameters->trick_matrix is set to zero, otherwise Omega
 *        corresponds to the hexahedra of pMesh labelled labelToConsiderOrAvoid.
 *        The corresponding values are saved in the coef array variable of the
-*        OverlapMatrix structure located at pData->pmat[iterationInTheLoop].
+*        OverlapMatrix structure located at
+*        pData->pmat[iterationInTheLoop%nring].
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function. Its orb_rhf variable is used
@@ -1029,7 +1109,8 @@ int computeOverlapMatrixOnGrid(Parameters* pParameters, Mesh* pMesh,
 *                                                        int iterationInTheLoop)
 * \brief It computes the eigenvalues and eigenvectors of the (square symmetric)
 *        matrix whose coefficients are stored in the coef array variable of the
-*        OverlapMatrix structure located at pData->pmat[iterationInTheLoop].
+*        OverlapMatrix structure located at
+*        pData->pmat[iterationInTheLoop%nring].
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function. Its orb_rhf variable is used
@@ -1081,8 +1162,8 @@ int diagonalizeOverlapMatrix(Parameters* pParameters, Data* pData,
 * \brief It computes the different probabilities to find exactly
 *        a certain number of electrons in the domain whose values are saved in
 *        the pk array variable of the Probabilities structure located at
-*        pData->pprob[iterationInTheLoop]. The total population of electrons
-*        inside the domain is also computed and saved in
+*        pData->pprob[iterationInTheLoop%nring]. The total population of
+*        electrons inside the domain is also computed and saved in
 *        pData->pop[iterationInTheLoop], while the probability to find
 *        the pParameters->nu_electrons in the domain is saved in
 *        pData->pnu[iterationInTheLoop].
@@ -1285,10 +1366,10 @@ double evaluateShapeGradientAtThePoint(double px, double py, double pz,
 *        the latter case, it also directly modifies the MPD domain depending on
 *        the sign of the shape gradient. The gradient evaluation uses the
 *        eigenvalues and eigenvectors of the overlap matrix associated with
-*        pChemicalSystem and stored in pData->pmat[iterationInTheLoop]. In the
-*        case of tetrahedral meshes i.e. if pParamters->opt_mode is positive,
-*        it also labels 10 the interior points that belongs to the boundary of
-*        the internal domain.
+*        pChemicalSystem and stored in pData->pmat[iterationInTheLoop%nring]. In
+*        the case of tetrahedral meshes i.e. if pParamters->opt_mode is
+*        positive, it also labels 10 the interior points that belongs to the
+*        boundary of the internal domain.
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function. Its opt_mode variable is used
@@ -1402,7 +1483,7 @@ double computeAreaTriangle(Point* pp1, Point* pp2, Point* pp3);
 *        the residual of the first-order optimality conditions for the shape
 *        optimization problem. The integral evaluation uses the
 *        eigenvalues and eigenvectors of the overlap matrix associated with
-*        pChemicalSystem and stored in pData->pmat[iterationInTheLoop].
+*        pChemicalSystem and stored in pData->pmat[iterationInTheLoop%nring].
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function. Its opt_mode variable is used
@@ -1638,6 +1719,188 @@ int writingShapeSolFile(Parameters* pParameters, Mesh* pMesh);
 */
 int writingObjFile(Parameters* pParameters, Mesh* pMesh);
 
+/**
+* \fn int writingSnapshotFiles(Parameters* pParameters, Mesh* pMesh,
+*                              ChemicalSystem* pChemicalSystem,
+*                              char* fileLocation, int booleanForSave,
+*                                                         int booleanForCurrent)
+* \brief It performs the file operations associated with one snapshot of the
+*        optimization loop: it either removes the *.(iteration).mesh file or
+*        writes the mesh in the current *.mesh file and/or in the
+*        *.(iteration).mesh and *.(iteration).cube/ *.obj files.
+*
+* \param[in] pParameters A pointer that points to a Parameters structure. Its
+*                        name_mesh variable refers to the current *.mesh file
+*                        (only written if booleanForCurrent is set to one), its
+*                        save_type variable rules the formats that are saved
+*                        (see \ref saveOrRemoveMeshInTheLoop) and its opt_mode
+*                        one the *.cube (hexahedral) or *.obj (tetrahedral)
+*                        choice.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure that is intended
+*                  to be saved (not used if booleanForSave is set to zero).
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure storing the nuclei needed by the *.cube
+*                            format.
+*
+* \param[in] fileLocation A string storing the *.(iteration).mesh file name on
+*                         which the *.(iteration).cube/ *.obj names are built.
+*
+* \param[in] booleanForSave An integer set to one if the mesh must be saved, or
+*                           to zero if the fileLocation file must be removed
+*                           (nothing is done if it does not exist).
+*
+* \param[in] booleanForCurrent An integer set to one if the mesh must also be
+*                              written in the current *.mesh file.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* The \ref writingSnapshotFiles function is called by the background writer
+* thread (\ref runSnapshotWriter) or directly by the \ref
+* saveOrRemoveMeshInTheLoop function if the writer has not been started. It
+* should be static but has been defined as non-static in order to perform
+* unit-test on it.
+*/
+int writingSnapshotFiles(Parameters* pParameters, Mesh* pMesh,
+                         ChemicalSystem* pChemicalSystem, char* fileLocation,
+                                     int booleanForSave, int booleanForCurrent);
+
+/**
+* \fn void* runSnapshotWriter(void* pSnapshotWriter)
+* \brief Main function of the background thread writing the snapshots of the
+*        optimization loop.
+*
+* \param[in] pSnapshotWriter A (void*) pointer that points to the
+*                            SnapshotWriter structure (defined in main.h)
+*                            whose queue is processed.
+*
+* \return It always returns NULL (as expected by the pthread_create function).
+*
+* The function \ref runSnapshotWriter waits for snapshots in the queue of the
+* structure pointed by pSnapshotWriter, writes them in the order they have been
+* queued with the \ref writingSnapshotFiles function, and frees their memory.
+* It never prints anything in the standard output stream (the snapshots are
+* queued with a verbose variable set to minus one), which is left to the main
+* thread. Errors are recorded in the error variable of the structure and reported by
+* the next call to \ref pushSnapshotInWriter or \ref waitForSnapshotWriter. It
+* ends when the stop variable is set to one and the queue is empty.
+*/
+void* runSnapshotWriter(void* pSnapshotWriter);
+
+/**
+* \fn int startSnapshotWriter(SnapshotWriter* pWriter)
+* \brief It allocates the bounded queue of the structure pointed by pWriter and
+*        starts the background writer thread.
+*
+* \param[in] pWriter A pointer that points to the SnapshotWriter structure
+*                    (defined in main.h) that is intended to be started (the
+*                    \ref globalSnapshotWriter variable).
+*
+* \return It returns one on success (or if the writer is already active),
+*         otherwise zero is returned and the structure remains inactive, which
+*         means that the snapshots will be written synchronously.
+*/
+int startSnapshotWriter(SnapshotWriter* pWriter);
+
+/**
+* \fn int pushSnapshotInWriter(SnapshotWriter* pWriter,
+*                              Parameters* pParameters, Mesh* pMesh,
+*                              ChemicalSystem* pChemicalSystem,
+*                              char* fileLocation, int booleanForSave,
+*                                                         int booleanForCurrent)
+* \brief It queues a snapshot in the structure pointed by pWriter so that the
+*        corresponding files are written by the background thread.
+*
+* \param[in] pWriter A pointer that points to an active SnapshotWriter
+*                    structure (defined in main.h).
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function; it is copied (its name_mesh
+*                        string included) when the snapshot is queued, with
+*                        its verbose variable set to minus one so that the
+*                        background thread does not print anything.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure of the \ref main
+*                  function; it is deep copied (\ref copyMeshStructure) if
+*                  booleanForSave is set to one, so that the optimization loop
+*                  can modify it right after.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function (shared with
+*                            the writer thread and not modified in the loop;
+*                            it, as well as the strings of the Parameters
+*                            structure, must not be freed or reloaded before
+*                            \ref waitForSnapshotWriter has been called).
+*
+* \param[in] fileLocation A string storing the *.(iteration).mesh file name
+*                         (copied when the snapshot is queued).
+*
+* \param[in] booleanForSave See \ref writingSnapshotFiles.
+*
+* \param[in] booleanForCurrent See \ref writingSnapshotFiles.
+*
+* \return It returns one on success, otherwise zero is returned, in particular
+*         if the background thread failed to write a previous snapshot.
+*
+* If the queue is full (\ref SNAPSHOT_QUEUE_SIZE snapshots), the function waits
+* until a slot is released by the background thread. The queued snapshot is
+* reported in the standard output stream by the calling (main) thread.
+*/
+int pushSnapshotInWriter(SnapshotWriter* pWriter, Parameters* pParameters,
+                                   Mesh* pMesh, ChemicalSystem* pChemicalSystem,
+                                         char* fileLocation, int booleanForSave,
+                                                         int booleanForCurrent);
+
+/**
+* \fn int waitForSnapshotWriter(SnapshotWriter* pWriter)
+* \brief Barrier waiting until all the snapshots queued in the structure
+*        pointed by pWriter have been written.
+*
+* \param[in] pWriter A pointer that points to the SnapshotWriter structure
+*                    (defined in main.h); nothing is done if it is inactive.
+*
+* \return It returns one on success, otherwise zero if at least one snapshot
+*         could not be written or removed by the background thread.
+*/
+int waitForSnapshotWriter(SnapshotWriter* pWriter);
+
+/**
+* \fn int stopSnapshotWriter(SnapshotWriter* pWriter)
+* \brief It waits until all the queued snapshots have been written, ends the
+*        background thread, and frees the memory of the structure pointed by
+*        pWriter.
+*
+* \param[in] pWriter A pointer that points to the SnapshotWriter structure
+*                    (defined in main.h); nothing is done if it is inactive.
+*
+* \return It returns one on success, otherwise zero if at least one snapshot
+*         could not be written or removed by the background thread.
+*
+* The \ref stopSnapshotWriter function is called by \ref endTimerAtExit so that
+* all the files are complete when the program ends.
+*/
+int stopSnapshotWriter(SnapshotWriter* pWriter);
+
+/**
+* \fn void waitForSnapshotWriterAtSignal(SnapshotWriter* pWriter)
+* \brief Barrier used by the \ref commentAnormalEnd function when a signal is
+*        caught.
+*
+* \param[in] pWriter A pointer that points to the SnapshotWriter structure
+*                    (defined in main.h); nothing is done if it is inactive.
+*
+* Since the mutex of the structure may be held by the interrupted thread, the
+* \ref waitForSnapshotWriterAtSignal function never blocks on it. It reads the
+* pending variable of the structure under the mutex whenever
+* pthread_mutex_trylock acquires it (a busy mutex counts as a pending
+* snapshot), for at most \ref SNAPSHOT_SIGNAL_WAIT periods of ten milliseconds
+* (nothing is waited if the signal was raised in the writer thread itself) and
+* then deactivates the structure so that the exit process does not wait for it
+* anymore. It does not return any value (void output).
+*/
+void waitForSnapshotWriterAtSignal(SnapshotWriter* pWriter);
+
 /**
 * \fn int saveOrRemoveMeshInTheLoop(Parameters* pParameters, Mesh* pMesh,
 *                                   ChemicalSystem* pChemicalSystem,
@@ -1652,8 +1915,8 @@ int writingObjFile(Parameters* pParameters, Mesh* pMesh);
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function. Its name_mesh variable must
-*                        refer to the name of a valid and existing *.mesh file
-*                        otherwise an error is returned by the \ref
+*                        refer to the name of a valid *.mesh file otherwise an
+*                        error is returned by the \ref
 *                        saveOrRemoveMeshInTheLoop. Its save_type variable
 *                        rules if the mesh file is saved in the *.mesh format
 *                        (one), *.cube/ *.obj format (zero), or both formats
@@ -1699,6 +1962,13 @@ int writingObjFile(Parameters* pParameters, Mesh* pMesh);
 *         the expected content. In the latter case, a description of the problem
 *         is provided in the standard error stream before returning zero.
 *
+* If the \ref globalSnapshotWriter has been started, the file operations are
+* handed over to the background thread with a copy of the mesh (see \ref
+* pushSnapshotInWriter) and the function returns as soon as the snapshot is
+* queued. For tetrahedral meshes (positive opt_mode), the current *.mesh file
+* is always written before returning since it is then read by the external
+* softwares.
+*
 * The \ref saveOrRemoveMeshInTheLoop function should be static but has been
 * defined as non-static in order to perform unit-test on it.
 */
@@ -1706,6 +1976,62 @@ int saveOrRemoveMeshInTheLoop(Parameters* pParameters, Mesh* pMesh,
                               ChemicalSystem* pChemicalSystem,
                                     int booleanForSave, int iterationInTheLoop);
 
+/**
+* \fn int writingHistoryFile(Parameters* pParameters, Mesh* pMesh, Data* pData,
+*                            ChemicalSystem* pChemicalSystem,
+*                                                        int iterationInTheLoop)
+* \brief It appends the record of the (iterationInTheLoop)-th iteration of the
+*        optimization loop in the *.hist history file, which is a compact
+*        replacement of the *.(iteration).mesh/ *.(iteration).cube files for
+*        hexahedral meshes (pParameters->save_type=3).
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function. The name of the *.hist file is
+*                        built on its name_mesh variable where the '.mesh'
+*                        extension is replaced by the '.hist' one. Its opt_mode
+*                        variable must not be positive and its n_x, n_y, n_z,
+*                        x_min, y_min, z_min, delta_x, delta_y, and delta_z
+*                        variables describe the grid saved in the header.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure of the \ref main
+*                  function. It must contain the (n_x-1)*(n_y-1)*(n_z-1)
+*                  hexahedra of the grid, whose labels are saved.
+*
+* \param[in] pData A pointer that points to the Data structure of the \ref main
+*                  function. The pnu, pop, d0p, d1p, d2p, tim, and ctim values
+*                  of the iterationInTheLoop-th iteration are saved in the
+*                  record.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function. The charge
+*                            and center coordinates of its nuclei are saved in
+*                            the header (needed to extract *.cube files).
+*
+* \param[in] iterationInTheLoop It represents the integer counting the number
+*                               of iterations already performed in the
+*                               optimization loop. If it is set to zero, the
+*                               *.hist file is reset and its header is written.
+*
+* \return It returns one on success, otherwise zero is returned.
+*
+* The layout of the *.hist file (native binary representation) is the
+* following. The header contains the \ref HIST_MAGIC characters, eight int
+* (\ref HIST_VERSION, n_x, n_y, n_z, number of nuclei, nu_electrons, number of
+* molecular orbitals, and zero), six double (x_min, y_min, z_min, delta_x,
+* delta_y, delta_z), and for each nucleus two int (charge and zero) followed by
+* three double (coordinates). Each record then contains four int (iteration,
+* opt_mode, number of runs, and zero), seven double (pnu, pop, d0p, d1p, d2p,
+* tim, ctim), and the runs of the hexahedron labels as pairs of int (label and
+* number of successive hexahedra having it). The grid being the same at every
+* iteration, a record only needs a few hundred runs for the usual domains. The
+* records can be converted back into *.cube/ *.mesh files with the
+* historyExtractor program of the mpdToolbox. The \ref writingHistoryFile
+* function should be static but has been defined as non-static in order to
+* perform unit-test on it.
+*/
+int writingHistoryFile(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                      ChemicalSystem* pChemicalSystem, int iterationInTheLoop);
+
 /**
 * \fn int saveDataInTheLoop(Parameters* pParameters, Mesh* pMesh, Data* pData,
 *                           ChemicalSystem* pChemicalSystem,
@@ -1768,17 +2094,19 @@ int saveOrRemoveMeshInTheLoop(Parameters* pParameters, Mesh* pMesh,
 *                  function. In the \ref optimization function, the \ref
 *                  saveDataInTheLoop function is placed after the \ref
 *                  shapeDerivative one. Hence, the overlap matrix coefficients
-*                  (stored in pData->pmat[iterationInTheLoop].coef), eigenvalues
-*                  (pData->pmat[iterationInTheLoop].diag), and eigenvectors
-*                  (pData->pmat[iterationInTheLoop].vect), the probability to
-*                  find exactmy pParameters->nu_electrons inside the domain of
-*                  pMesh and pChemicalSystem->nmorb-pParameters->nu_electrons
+*                  (stored in pData->pmat[iterationInTheLoop%nring].coef),
+*                  eigenvalues (pData->pmat[iterationInTheLoop%nring].diag), and
+*                  eigenvectors (pData->pmat[iterationInTheLoop%nring].vect),
+*                  the probability to find exactmy pParameters->nu_electrons
+*                  inside the domain of pMesh and
+*                  pChemicalSystem->nmorb-pParameters->nu_electrons
 *                  (pData->pnu[iterationInTheLoop]) and the other computed
-*                  probabilities (pData->prob[iterationInTheLoop].pk), the total
-*                  population of electrons (pData->pop[iterationInTheLoop])
-*                  inside the domain, and the shape derivative residual
-*                  (pData->d1p[iterationInTheLoop]) are already computed at the
-*                  (iterationInTheLoop)-th iteration. The \ref saveDataInTheLoop
+*                  probabilities (pData->pprob[iterationInTheLoop%nring].pk),
+*                  the total population of electrons
+*                  (pData->pop[iterationInTheLoop]) inside the domain, and the
+*                  shape derivative residual (pData->d1p[iterationInTheLoop])
+*                  are already computed at the (iterationInTheLoop)-th
+*                  iteration. The \ref saveDataInTheLoop
 *                  thus finishes to compute the Data structure by evaluating the
 *                  probability difference in pData->d0p[iterationInTheLoop] (at
 *                  initialization i.e. if iterationInTheLoop is set to zero, we
@@ -1959,6 +2287,401 @@ int setupInitialData(Parameters* pParameters, Mesh* pMesh, Data* pData,
                      time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
                                                         time_t* pEndLocalTimer);
 
+/**
+* \fn int writingArrayInCheckpoint(FILE* checkFile, void* pArray,
+*                                      size_t sizeOfItem, int numberOfItems)
+* \brief It writes an array in a binary checkpoint (*.chk) file, preceded by its
+*        number of items.
+*
+* \param[in] checkFile A pointer to the *.chk file opened in binary write mode.
+*
+* \param[in] pArray A pointer to the array to write (if it points to NULL, an
+*                   empty array is written).
+*
+* \param[in] sizeOfItem The size (in bytes) of one item of the array.
+*
+* \param[in] numberOfItems The number of items of the array to write.
+*
+* \return It returns one on success, otherwise zero is returned if the input
+*         variables are not valid or if the writing failed.
+*/
+int writingArrayInCheckpoint(FILE* checkFile, void* pArray, size_t sizeOfItem,
+                                                             int numberOfItems);
+
+/**
+* \fn int readArrayInCheckpoint(FILE* checkFile, void** pArray,
+*                                          size_t sizeOfItem, int numberMax)
+* \brief It reads an array written in a binary checkpoint (*.chk) file by the
+*        \ref writingArrayInCheckpoint function.
+*
+* \param[in] checkFile A pointer to the *.chk file opened in binary read mode.
+*
+* \param[out] pArray The address of the pointer that is intended to point to the
+*                    array read. If the array stored in the file is not empty,
+*                    an array of numberMax items is allocated (and filled with
+*                    the items read), otherwise *pArray is set to NULL.
+*
+* \param[in] sizeOfItem The size (in bytes) of one item of the array.
+*
+* \param[in] numberMax The maximal number of items that the array can store
+*                      (e.g. the maximal length allowed for a string, or the
+*                      number of vertices for the array of vertices).
+*
+* \return It returns one on success, otherwise zero is returned if the input
+*         variables are not valid, if the number of items stored exceeds
+*         numberMax, or if the reading failed.
+*/
+int readArrayInCheckpoint(FILE* checkFile, void** pArray, size_t sizeOfItem,
+                                                                 int numberMax);
+
+/**
+* \fn int getSizeOrTruncateOutputFiles(Parameters* pParameters,
+*                               Checkpoint* pCheckpoint, int booleanForTruncate)
+* \brief It saves the sizes of the files to which the optimization loop appends
+*        its records (the *.data file and, if save_type is set to 3, the *.hist
+*        one) in a checkpoint, or truncates these files back to the saved sizes.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function (its name_data, name_mesh, and
+*                        save_type variables locate the files).
+*
+* \param[in,out] pCheckpoint A pointer that points to the Checkpoint structure
+*                           of the \ref main function, whose dataSize and
+*                           histSize variables are set (minus one for a missing
+*                           file) if booleanForTruncate is set to zero, and
+*                           read otherwise.
+*
+* \param[in] booleanForTruncate An integer set to zero when the checkpoint is
+*                               written (\ref writingCheckpointFile) and to one
+*                               when the run is restarted (\ref
+*                               restartFromCheckpoint).
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered (a file shorter than the saved size is only reported by
+*         a warning and left unchanged).
+*/
+int getSizeOrTruncateOutputFiles(Parameters* pParameters,
+                               Checkpoint* pCheckpoint, int booleanForTruncate);
+
+/**
+* \fn int writingCheckpointFile(Parameters* pParameters, Mesh* pMesh,
+*                                      Data* pData, Checkpoint* pCheckpoint)
+* \brief It writes the whole state of the optimization loop in the binary *.chk
+*        file associated with pParameters->name_info (the '.info' extension is
+*        replaced by the '.chk' one), in order to restart the run later.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure of the \ref main
+*                  function.
+*
+* \param[in] pData A pointer that points to the Data structure of the \ref main
+*                  function.
+*
+* \param[in] pCheckpoint A pointer that points to the Checkpoint structure
+*                        storing the last iteration completed and the local
+*                        variables of the optimization loop of the \ref main
+*                        function.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered (the previous *.chk file, if any, is then left intact).
+*
+* The *.chk layout is made of the magic number \ref CHECK_MAGIC, a header of
+* four integers (\ref CHECK_VERSION and the sizes of the Parameters, Mesh, and
+* Data structures) and then of the Checkpoint, Parameters, Mesh, and Data
+* structures, each one being followed by the arrays it points to (written by
+* the \ref writingArrayInCheckpoint function). In particular, the current
+* overlap matrices with their eigenvalues and eigenvectors are saved, so that
+* nothing has to be recomputed at restart, together with the sizes of the *.data
+* and *.hist files (see \ref getSizeOrTruncateOutputFiles). The file is written under a
+* temporary name and then renamed, so that it is never left half-written if the
+* run is stopped meanwhile.
+*/
+int writingCheckpointFile(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                                                       Checkpoint* pCheckpoint);
+
+/**
+* \fn int readCheckpointFile(char* fileLocation, Parameters* pParameters,
+*                             Mesh* pMesh, Data* pData, Checkpoint* pCheckpoint)
+* \brief It loads the whole state of an optimization loop saved in a binary
+*        *.chk file by the \ref writingCheckpointFile function.
+*
+* \param[in] fileLocation A pointer that points to a string storing the path
+*                         name of the *.chk file.
+*
+* \param[out] pParameters A pointer that points to the Parameters structure of
+*                         the \ref main function, which is (freed and) filled
+*                         with the saved parameters.
+*
+* \param[out] pMesh A pointer that points to the Mesh structure of the \ref main
+*                   function, which is (freed and) filled with the saved mesh.
+*
+* \param[out] pData A pointer that points to the Data structure of the \ref main
+*                   function, which is (freed and) filled with the saved data.
+*
+* \param[out] pCheckpoint A pointer that points to the Checkpoint structure of
+*                         the \ref main function, which receives the local
+*                         variables of the optimization loop.
+*
+* \return It returns one on success, otherwise zero is returned if the file
+*         cannot be read, has been written by another \ref CHECK_VERSION of the
+*         MPD program, or does not store a valid state of the optimization loop.
+*         In case of error, the memory already allocated in the structures is
+*         left to be freed by the usual \ref FREE_AND_RETURN macro.
+*/
+int readCheckpointFile(char* fileLocation, Parameters* pParameters,
+                             Mesh* pMesh, Data* pData, Checkpoint* pCheckpoint);
+
+/**
+* \fn int restartFromCheckpoint(Parameters* pParameters, Mesh* pMesh,
+*                               Data* pData, ChemicalSystem* pChemicalSystem,
+*                          Checkpoint* pCheckpoint, time_t* pGlobalInitialTimer)
+* \brief It prepares the optimization loop to resume after the last iteration
+*        saved in a checkpoint, once the \ref readCheckpointFile and \ref
+*        loadChemistry functions have been called.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure of the \ref main
+*                  function.
+*
+* \param[in] pData A pointer that points to the Data structure of the \ref main
+*                  function.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function.
+*
+* \param[in] pCheckpoint A pointer that points to the Checkpoint structure
+*                        filled by the \ref readCheckpointFile function.
+*
+* \param[in,out] pGlobalInitialTimer A pointer that points to the address of the
+*                                    globalInitialTimer variable of the main.c
+*                                    file, which is moved back by the cumulated
+*                                    time of the interrupted run.
+*
+* \return It returns one on success, otherwise zero is returned if the data do
+*         not correspond to the chemical system or if an error is encountered.
+*
+* For the tetrahedral modes (opt_mode positive), the mesh is written back in
+* the pParameters->name_mesh file since the external softwares (mmg3d, mshdist,
+* elastic, advect) read it from the disk. The *.data (and *.hist) files are
+* first truncated back to their size when the checkpoint was written (see \ref
+* getSizeOrTruncateOutputFiles), so that the records of the iterations
+* performed after the checkpoint by the interrupted run are removed before
+* being appended again.
+*/
+int restartFromCheckpoint(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                          ChemicalSystem* pChemicalSystem,
+                         Checkpoint* pCheckpoint, time_t* pGlobalInitialTimer);
+
+/**
+* \fn int compareCandidateHexahedra(const void* pCandidate1,
+*                                                const void* pCandidate2)
+* \brief It is the comparison function given to the qsort standard c-function
+*        in order to sort an array of Candidate structures by increasing
+*        position of their hexahedron.
+*
+* \param[in] pCandidate1 A pointer that points to the first Candidate structure
+*                        to be compared.
+*
+* \param[in] pCandidate2 A pointer that points to the second Candidate structure
+*                        to be compared.
+*
+* \return It returns a negative (respectively zero, positive) integer if the
+*         hexahedron of the first Candidate structure is located before
+*         (respectively at the same position as, after) the one of the second
+*         Candidate structure in the array of mesh hexahedra.
+*/
+int compareCandidateHexahedra(const void* pCandidate1, const void* pCandidate2);
+
+/**
+* \fn int compareCandidateVariations(const void* pCandidate1,
+*                                                const void* pCandidate2)
+* \brief It is the comparison function given to the qsort standard c-function
+*        in order to sort an array of Candidate structures by decreasing
+*        first-order variation of the probability.
+*
+* \param[in] pCandidate1 A pointer that points to the first Candidate structure
+*                        to be compared.
+*
+* \param[in] pCandidate2 A pointer that points to the second Candidate structure
+*                        to be compared.
+*
+* \return It returns a negative (respectively positive) integer if the first
+*         Candidate structure must be tried before (respectively after) the
+*         second one. Equal variations are ordered by increasing position of the
+*         hexahedra so that the result does not depend on the implementation of
+*         qsort, and zero is only returned if both hexahedra are the same.
+*/
+int compareCandidateVariations(const void* pCandidate1,
+                                                       const void* pCandidate2);
+
+/**
+* \fn int computeProbabilityOfModifiedDomain(Parameters* pParameters,
+*                                            Mesh* pMesh, Data* pData,
+*                                            ChemicalSystem* pChemicalSystem,
+*                                            int iterationInTheLoop,
+*                                            double* pCoefficient,
+*                                            int kHexahedron, int sign)
+* \brief It computes the overlap matrix and the probability of the domain
+*        (whose overlap-matrix coefficients are given in pCoefficient) when an
+*        hexahedron is added to or removed from it.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure of the \ref
+*                  main function.
+*
+* \param[out] pData A pointer that points to the Data structure of the \ref main
+*                   function. The coef variable of its
+*                   pmat[iterationInTheLoop%nring] OverlapMatrix structure
+*                   stores the overlap matrix of the modified domain, and the
+*                   probability of the modified domain is stored in
+*                   pnu[iterationInTheLoop].
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function.
+*
+* \param[in] iterationInTheLoop It represents the integer counting the number
+*                               of iterations already performed in the
+*                               optimization loop.
+*
+* \param[in] pCoefficient A pointer that points to the (nmorb)x(nmorb) array
+*                         storing the overlap-matrix coefficients of the domain
+*                         before its modification.
+*
+* \param[in] kHexahedron It is the position (starting from zero) of the
+*                        hexahedron to be added or removed in the array of mesh
+*                        hexahedra.
+*
+* \param[in] sign It must be set to one if the hexahedron is added to the
+*                 domain, and to minus one if it is removed from it.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*
+* The \ref computeProbabilityOfModifiedDomain function is used by the \ref
+* exhaustiveSearchAlgorithm and \ref prunedSearchAlgorithm functions. It calls
+* the \ref evaluateTripleIntegralIJ, \ref diagonalizeOverlapMatrix, and \ref
+* computeProbability functions, so the lapacke library must have been
+* previously installed (see \ref exhaustiveSearchAlgorithm for details).
+*/
+int computeProbabilityOfModifiedDomain(Parameters* pParameters, Mesh* pMesh,
+                                       Data* pData,
+                                       ChemicalSystem* pChemicalSystem,
+                                       int iterationInTheLoop,
+                                       double* pCoefficient, int kHexahedron,
+                                                                      int sign);
+
+/**
+* \fn int rankCandidatesWithShapeGradient(Parameters* pParameters, Mesh* pMesh,
+*                                         Data* pData,
+*                                         ChemicalSystem* pChemicalSystem,
+*                                         int iterationInTheLoop,
+*                                         Candidate* pCandidate,
+*                                         int* pNumberOfCandidates)
+* \brief It sorts the hexahedra touching the boundary of the domain by
+*        decreasing first-order variation of the probability, predicted by the
+*        shape gradient, when they are added to (or removed from) the domain.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function.
+*
+* \param[in] pMesh A pointer that points to the Mesh structure of the \ref
+*                  main function. Its Adjacency structures must describe the
+*                  boundary of the domain of the previous iteration.
+*
+* \param[in] pData A pointer that points to the Data structure of the \ref main
+*                  function. The overlap matrix (diagonalized) and the
+*                  probabilities of the previous iteration are used to
+*                  evaluate the shape gradient.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function.
+*
+* \param[in] iterationInTheLoop It represents the integer counting the number
+*                               of iterations already performed in the
+*                               optimization loop. It must be positive.
+*
+* \param[out] pCandidate A pointer that points to an array of at least 2*nadj
+*                        Candidate structures (nadj is the number of Adjacency
+*                        structures of pMesh). On output, its first
+*                        *pNumberOfCandidates elements store the distinct
+*                        candidates by decreasing predicted variation.
+*
+* \param[out] pNumberOfCandidates A pointer that points to the integer where
+*                                 the number of distinct candidates is stored.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*
+* The predicted variation of an hexahedron is the sum, over its faces lying on
+* the boundary of the domain, of the shape gradient (computed by the \ref
+* evaluateShapeGradientAtThePoint function at the center of the face) times
+* the area of the face, with a negative sign if the hexahedron is located
+* inside the domain (i.e. if it is removed).
+*/
+int rankCandidatesWithShapeGradient(Parameters* pParameters, Mesh* pMesh,
+                                    Data* pData,
+                                    ChemicalSystem* pChemicalSystem,
+                                    int iterationInTheLoop,
+                                    Candidate* pCandidate,
+                                                      int* pNumberOfCandidates);
+
+/**
+* \fn int prunedSearchAlgorithm(Parameters* pParameters, Mesh* pMesh,
+*                               Data* pData, ChemicalSystem* pChemicalSystem,
+*                               int iterationInTheLoop, double* pCoefficient,
+*                                                    double* pProbabilityValue)
+* \brief It is the pruned version of the \ref exhaustiveSearchAlgorithm (used
+*        if the n_prune variable of the Parameters structure is positive). The
+*        hexahedra touching the boundary of the domain are tried by decreasing
+*        first-order variation of the probability, and the search stops after
+*        n_prune consecutive candidates that do not increase the probability.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure of the \ref
+*                      main function. The label of the hexahedra retained is
+*                      set to -3 (added) or -2 (removed).
+*
+* \param[out] pData A pointer that points to the Data structure of the \ref main
+*                   function.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function.
+*
+* \param[in] iterationInTheLoop It represents the integer counting the number
+*                               of iterations already performed in the
+*                               optimization loop. It must be positive.
+*
+* \param[in,out] pCoefficient A pointer that points to the (nmorb)x(nmorb)
+*                             array storing the overlap-matrix coefficients of
+*                             the current domain. It is updated each time a
+*                             candidate is retained.
+*
+* \param[in,out] pProbabilityValue A pointer that points to the probability of
+*                                  the current domain. It is updated each time
+*                                  a candidate is retained.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*
+* Since each candidate is evaluated exactly (thanks to the \ref
+* computeProbabilityOfModifiedDomain function), the probability can only
+* increase as in the exhaustive search, but only a fraction of the boundary
+* hexahedra is evaluated, the most promising ones being tried first (see \ref
+* rankCandidatesWithShapeGradient).
+*/
+int prunedSearchAlgorithm(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                          ChemicalSystem* pChemicalSystem,
+                          int iterationInTheLoop, double* pCoefficient,
+                                                     double* pProbabilityValue);
+
 /**
 * \fn int exhaustiveSearchAlgorithm(Parameters* pParameters, Mesh* pMesh,
 *                                   Data* pData, 
@@ -1967,7 +2690,9 @@ int setupInitialData(Parameters* pParameters, Mesh* pMesh, Data* pData,
 * \brief It computes the pParameters->opt_mode=-2 of the \ref optimization
 *        function. It tries to add or remove the hexahedra that are touching
 *        the boundary of the domain. Only perturbations increasing the
-*        probability are retained.
+*        probability are retained. If the n_prune variable of the Parameters
+*        structure is positive, the candidates are tried in the order given by
+*        the shape gradient (see \ref prunedSearchAlgorithm).
 *
 * \param[in] pParameters A pointer that points to the Parameters structure of
 *                        the \ref main function.
@@ -2165,6 +2890,81 @@ double computeProbabilityAndReloadPreviousMesh(Parameters* pParameters,
                                                ChemicalSystem* pChemicalSystem,
                                                         int iterationInTheLoop);
 
+/**
+* \fn int checkStopCriteria(Parameters* pParameters, Data* pData,
+*                                                        int iterationInTheLoop)
+* \brief It checks if the stop criteria of the optimization loop are satisfied
+*        by the data computed at the previous iteration.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function. Its iter_told0p, iter_told1p,
+*                        and iter_told2p variables store the tolerances.
+*
+* \param[in] pData A pointer that points to the Data structure of the \ref main
+*                  function. Its d0p, d1p, and d2p variables must have been
+*                  computed at the (iterationInTheLoop-1)-th iteration.
+*
+* \param[in] iterationInTheLoop It represents the integer counting the number
+*                               of iterations already performed in the
+*                               optimization loop. It must be a positive
+*                               integer.
+*
+* \return It returns one if the optimization loop must be stopped (or the
+*         hexahedral grid refined in the coarse-to-fine mode, see the n_level
+*         variable of the Parameters structure), otherwise zero is returned.
+*
+* For hexahedral meshes (pParameters->opt_mode non-positive), the criterion on
+* the difference in residual (pData->d2p) is sufficient to stop the loop.
+*/
+int checkStopCriteria(Parameters* pParameters, Data* pData,
+                                                        int iterationInTheLoop);
+
+/**
+* \fn int refineGridInTheLoop(Parameters* pParameters, Mesh* pMesh, Data* pData,
+*                             ChemicalSystem* pChemicalSystem,
+*                                                        int iterationInTheLoop)
+* \brief It refines the hexahedral grid when the optimization has converged on
+*        the current one (coarse-to-fine mode) and prepares the current
+*        iteration on the refined grid.
+*
+* \param[in,out] pParameters A pointer that points to the Parameters structure
+*                            of the \ref main function. Its opt_mode variable
+*                            must be negative and its n_level variable positive
+*                            (it is decreased by one). The discretization of
+*                            the computational box is updated by the \ref
+*                            refineHexahedralMesh function.
+*
+* \param[in,out] pMesh A pointer that points to the Mesh structure of the \ref
+*                      main function. Each hexahedron is divided into eight.
+*
+* \param[in] pData A pointer that points to the Data structure of the \ref main
+*                  function. The overlap matrix (and its diagonalization) and
+*                  the probabilities computed at the (iterationInTheLoop-1)-th
+*                  iteration are used to evaluate the shape gradient on the
+*                  refined grid.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function.
+*
+* \param[in] iterationInTheLoop It represents the integer counting the number
+*                               of iterations already performed in the
+*                               optimization loop. It must be a positive
+*                               integer.
+*
+* \return It returns one on success, otherwise zero is returned if an error is
+*         encountered during the process.
+*
+* Since the internal domain (and thus its overlap matrix) is exactly the same
+* on the two grids, the optimization simply goes on at the current iteration:
+* if opt_mode is set to -1, the \ref computeShapeGradient function is called to
+* label the boundary hexahedra of the refined grid to add or remove, so that
+* the \ref shapeDerivative function only has to integrate on them when the
+* trick_matrix variable of the Parameters structure is set to one. Hence, the
+* fine resolution is essentially paid near the boundary of the domain.
+*/
+int refineGridInTheLoop(Parameters* pParameters, Mesh* pMesh, Data* pData,
+                       ChemicalSystem* pChemicalSystem, int iterationInTheLoop);
+
 /**
 * \fn int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
 *                      ChemicalSystem* pChemicalSystem, int iterationInTheLoop,
@@ -2247,5 +3047,298 @@ int optimization(Parameters* pParameters, Mesh* pMesh, Data* pData,
                  time_t* pGlobalInitialTimer, time_t* pStartLocalTimer,
                                                         time_t* pEndLocalTimer);
 
-#endif
+/**
+* \fn void freeStartMemory(Start* pStart)
+* \brief It frees the memory dynamically allocated for the Parameters, Mesh,
+*        and Data structures of the Start structure pointed by pStart (only
+*        used in multi-start and scan modes).
+*
+* \param[in] pStart A pointer that points to one of the Start structures
+*                   (defined in main.h file) of the \ref multiStartOptimization
+*                   or \ref scanOptimization function.
+*
+* The snapshots queued in the background writer share the strings of the
+* Parameters structure (shallow copy) and the ChemicalSystem structure of their
+* start, so \ref waitForSnapshotWriter is called first (an error is then only
+* displayed). This function does not return any value (void output).
+*/
+void freeStartMemory(Start* pStart);
+
+/**
+* \fn int initializeStart(Parameters* pParameters,
+*                         ChemicalSystem* pChemicalSystem, Start* pStart,
+*                                     int iStart, time_t* pGlobalInitialTimer)
+* \brief It builds the iStart-th initial domain of a multi-start run and
+*        computes its initial data (it performs for one start what is done
+*        before the optimization loop in the \ref main function).
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function. Its n_start variable must be
+*                        positive and its ls_start variable must store the
+*                        initial domains read in the *.info file.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function, shared by
+*                            all the starts.
+*
+* \param[out] pStart A pointer that points to the Start structure (defined in
+*                    main.h file) to build. Its Parameters, Mesh, and Data
+*                    structures must have been initialized to zero before.
+*
+* \param[in] iStart The position of the start, which must be an integer between
+*                   one and pParameters->n_start.
+*
+* \param[in] pGlobalInitialTimer A pointer to the time_t variable storing the
+*                                starting time of the \ref main function.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process (the memory already allocated must
+*         still be freed with the \ref freeStartMemory function).
+*/
+int initializeStart(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
+                     Start* pStart, int iStart, time_t* pGlobalInitialTimer);
+
+/**
+* \fn void initializeStartLoop(Start* pStart)
+* \brief It sets up the state of the optimization loop of a start (multi-start
+*        and scan modes) as it is done before the optimization loop in the
+*        \ref main function.
+*
+* \param[in,out] pStart A pointer that points to the Start structure (defined
+*                       in main.h file) whose initial data have been computed.
+*                       Its loop state is reset to the first iteration; if its
+*                       opt_mode variable is zero, it is saved in the optMode
+*                       variable and set to minus one (the switch to
+*                       opt_mode=-2 is then performed by the \ref iterateStart
+*                       function), and the start is stopped if iter_max is not
+*                       positive.
+*
+* This function does not return any value (void output).
+*/
+void initializeStartLoop(Start* pStart);
+
+/**
+* \fn void stopStart(Start* pStart, int status)
+* \brief It stops the optimization loop of a start in multi-start mode.
+*
+* \param[in,out] pStart A pointer that points to one of the Start structures
+*                       (defined in main.h file) of the \ref
+*                       multiStartOptimization function. Its status variable
+*                       is set to the input status and, if its opt_mode
+*                       variable was initially set to zero, it is restored
+*                       together with the d0p, d1p, d2p values of its Data
+*                       structure modified at the switch from opt_mode=-1 to
+*                       opt_mode=-2 (as done at the end of the \ref main
+*                       function).
+*
+* \param[in] status The new status of the start: one if the stop criteria are
+*                   satisfied, two if the maximal number of iterations has been
+*                   reached, and minus one if the start is cut off.
+*
+* This function does not return any value (void output).
+*/
+void stopStart(Start* pStart, int status);
+
+/**
+* \fn int iterateStart(Start* pStart, ChemicalSystem* pChemicalSystem,
+*                                     int iStart, time_t* pGlobalInitialTimer)
+* \brief It performs the next iteration of the optimization loop of a running
+*        start in multi-start mode (it performs for one start and one
+*        iteration what is done in the optimization loop of the \ref main
+*        function for the hexahedral optimization).
+*
+* \param[in,out] pStart A pointer that points to one of the Start structures
+*                       (defined in main.h file) of the \ref
+*                       multiStartOptimization function. Nothing is done if its
+*                       status variable is not zero; otherwise, its mesh, data,
+*                       and loop state are updated by the \ref optimization
+*                       function, and the start is stopped (see \ref
+*                       stopStart) when the stop criteria are satisfied or when
+*                       the maximal number of iterations is reached.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function.
+*
+* \param[in] iStart The position of the start (only used for printing).
+*
+* \param[in] pGlobalInitialTimer A pointer to the time_t variable storing the
+*                                starting time of the \ref main function.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*/
+int iterateStart(Start* pStart, ChemicalSystem* pChemicalSystem, int iStart,
+                                                   time_t* pGlobalInitialTimer);
+
+/**
+* \fn int cutOffStarts(Start* pStart, int nStart)
+* \brief It cuts off the running starts of a multi-start run that cannot reach
+*        anymore the best probability obtained so far by all the starts.
+*
+* \param[in,out] pStart A pointer that points to the array of Start structures
+*                       (defined in main.h file) of the \ref
+*                       multiStartOptimization function.
+*
+* \param[in] nStart The size of the array pointed by pStart (positive integer).
+*
+* \return It returns the number of starts that are still running, or minus one
+*         if the input variables are not valid.
+*
+* A running start whose last iteration is I (not less than \ref
+* START_CUT_WINDOW) is cut off if p(I) + (iter_max-I) g + \ref START_CUT_TOL is
+* (strictly) less than the best probability of all the starts, where p refers
+* to its probabilities and g=max(p(i)-p(i-1),0) for the \ref START_CUT_WINDOW
+* last iterations i. In other words, the start is stopped if it cannot reach
+* the best probability (up to the margin) even if it kept increasing at the
+* best rate of its last iterations until the end of the optimization loop. A
+* start oscillating from one iteration to the other (e.g. with opt_mode -1) is
+* thus kept, and the best start is never cut off.
+*/
+int cutOffStarts(Start* pStart, int nStart);
+
+/**
+* \fn int printRankingOfStarts(Start* pStart, int nStart)
+* \brief It prints in the standard output stream the summary of a multi-start
+*        run, where the starts are ranked by decreasing order of their final
+*        probability.
+*
+* \param[in] pStart A pointer that points to the array of Start structures
+*                   (defined in main.h file) of the \ref
+*                   multiStartOptimization function.
+*
+* \param[in] nStart The size of the array pointed by pStart (positive integer).
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*/
+int printRankingOfStarts(Start* pStart, int nStart);
+
+/**
+* \fn int multiStartOptimization(Parameters* pParameters,
+*                                ChemicalSystem* pChemicalSystem,
+*                                                 time_t* pGlobalInitialTimer)
+* \brief It optimizes the n_start initial domains given in the *.info file
+*        (multi-start mode) and prints their ranking at the end.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function. Its n_start variable must be
+*                        positive and its opt_mode variable must refer to an
+*                        hexahedral optimization (-2, -1, or 0).
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function, loaded once
+*                            and shared by all the starts.
+*
+* \param[in] pGlobalInitialTimer A pointer to the time_t variable storing the
+*                                starting time of the \ref main function.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*
+* All the starts are built on the same hexahedral grid, and each one writes its
+* own output files (whose names are tagged with '.start' followed by the
+* position of the start). The starts are optimized in turn, one iteration for
+* each running start per round, rather than in separated threads: each
+* iteration is already parallelized over the n_cpu threads, and the \ref
+* optimization function relies on the standard output stream and on the
+* background writer of snapshots, which are shared by all the starts. After
+* each round, the starts that cannot reach anymore the best probability are cut
+* off (see \ref cutOffStarts).
+*/
+int multiStartOptimization(Parameters* pParameters,
+                           ChemicalSystem* pChemicalSystem,
+                                                   time_t* pGlobalInitialTimer);
 
+/**
+* \fn int initializeGeometry(Start* pPrevious,
+*                            ChemicalSystem* pPreviousChemicalSystem,
+*                            Start* pGeometry, ChemicalSystem* pChemicalSystem,
+*                                       int iGeom, time_t* pGlobalInitialTimer)
+* \brief It builds the domain of one geometry of a scan (n_geom positive) and
+*        computes its initial data.
+*
+* \param[in,out] pPrevious A pointer that points to the Start structure
+*                          (defined in main.h file) of the previous geometry,
+*                          whose optimization loop has stopped, or NULL for the
+*                          first geometry. The labels set by the shape gradient
+*                          in its last iteration are undone (see \ref
+*                          warpHexahedralDomain).
+*
+* \param[in] pPreviousChemicalSystem A pointer that points to the
+*                                    ChemicalSystem structure of the previous
+*                                    geometry (NULL for the first geometry).
+*
+* \param[in,out] pGeometry A pointer that points to the Start structure to
+*                          build. Its Parameters structure must have been filled
+*                          by the \ref copyParametersForGeometry function, and
+*                          its Mesh and Data structures must have been
+*                          initialized to zero before. If pPrevious is not NULL,
+*                          the discretization of the grid (n_*, delta_*) and the
+*                          n_level variable are inherited from the previous
+*                          geometry.
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure loaded for the geometry.
+*
+* \param[in] iGeom The position of the geometry (only used for printing).
+*
+* \param[in] pGlobalInitialTimer A pointer to the time_t variable storing the
+*                                starting time of the \ref main function.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process (the memory already allocated must
+*         still be freed with the \ref freeStartMemory function).
+*
+* The first geometry starts from the initial domain given by the ls_* variables
+* (as in the \ref main function), whereas the next ones start from the
+* converged domain of the previous geometry, moved along the displacements of
+* the nuclei by the \ref warpHexahedralDomain function.
+*/
+int initializeGeometry(Start* pPrevious,
+                      ChemicalSystem* pPreviousChemicalSystem, Start* pGeometry,
+                 ChemicalSystem* pChemicalSystem, int iGeom,
+                                               time_t* pGlobalInitialTimer);
+
+/**
+* \fn int scanOptimization(Parameters* pParameters,
+*                          ChemicalSystem* pChemicalSystem, char* nameChem,
+*                                                 time_t* pGlobalInitialTimer)
+* \brief It optimizes in turn the geometries of a scan (the one of the
+*        name_chem file, then the n_geom ones given in the *.info file) and
+*        prints a summary at the end.
+*
+* \param[in] pParameters A pointer that points to the Parameters structure of
+*                        the \ref main function. Its n_geom variable must be
+*                        positive, its name_geom variable must store the
+*                        chemical files of the next geometries, and its
+*                        opt_mode variable must refer to an hexahedral
+*                        optimization (-2, -1, or 0).
+*
+* \param[in] pChemicalSystem A pointer that points to the ChemicalSystem
+*                            structure of the \ref main function, loaded for
+*                            the first geometry.
+*
+* \param[in] nameChem A pointer that points to the name of the chemical file
+*                     of the first geometry as given in the *.info file (the
+*                     \ref loadChemistry function replaces the name_chem
+*                     variable of pParameters by the one of its *.chem copy),
+*                     only used to print the summary.
+*
+* \param[in] pGlobalInitialTimer A pointer to the time_t variable storing the
+*                                starting time of the \ref main function.
+*
+* \return It returns one on success otherwise zero is returned if an error is
+*         encountered during the process.
+*
+* Each geometry writes its own output files (whose names are tagged with '.geom'
+* followed by the position of the geometry) and gets the whole iter_max budget.
+* Since neighbouring geometries of a scan have close optimal domains, starting
+* each geometry from the converged domain of the previous one (see \ref
+* initializeGeometry) usually reduces the optimization loop to a few
+* iterations. Only two geometries (and their chemistry) are kept in memory at
+* the same time.
+*/
+int scanOptimization(Parameters* pParameters, ChemicalSystem* pChemicalSystem,
+                                   char* nameChem, time_t* pGlobalInitialTimer);
+
+#endif
@@ -0,0 +1,1068 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Maximal size allowed for the length of the file names
+// (including the terminating nul character '\0')
+#define NAME_SIZE_MAX 501
+
+// Label of the internal tetrahedra belonging to the domain
+#define LABEL_INTERNAL_TETRA 3
+
+// Label of the external tetrahedra not belonging to the domain
+#define LABEL_EXTERNAL_TETRA 2
+
+// Label of the boundary triangles belonging to the domain boundary
+#define LABEL_BOUNDARY 10
+
+// Characters starting the *.hist file and version of its layout (they must
+// correspond to the HIST_MAGIC and HIST_VERSION constants of MPD software)
+#define HIST_MAGIC "MPDHISTF"
+#define HIST_VERSION 1
+
+#define PRINT_ERROR(stringToPrint)                                             \
+do {                                                                           \
+        fflush(stdout);                                                        \
+        fprintf(stderr,"\nError encountered at line %d in ",__LINE__);         \
+        fprintf(stderr,"%s file on %s",__FILE__,endTimerAtError());            \
+        fprintf(stderr,"%s",stringToPrint);                                    \
+} while (0)
+
+typedef struct {
+    double x;
+    double y;
+    double z;
+    int charge;
+} Nucleus;
+
+typedef struct {
+    int nX;
+    int nY;
+    int nZ;
+    double xMin;
+    double yMin;
+    double zMin;
+    double deltaX;
+    double deltaY;
+    double deltaZ;
+    int nNucl;
+    Nucleus* pNucl;
+    int nHex;
+    int* pLabel;
+} History;
+
+char* endTimerAtError(void);
+void closeTheFile(FILE** pFileToClose);
+int checkStringFromLength(char* stringToCheck, int minimumLength,
+                                                             int maximumLength);
+void freeHistoryMemory(History* pHistory);
+int readingHistoryFile(char nameFile[NAME_SIZE_MAX], int iteration,
+                                                            History* pHistory);
+int writingCubeFile(char nameFile[NAME_SIZE_MAX], History* pHistory);
+int writingHexahedralMesh(char nameFile[NAME_SIZE_MAX], int nDom, int* pDom,
+                          int nVer, int nHex, int nQua, int nX, int nY, int nZ,
+                          double xMin, double yMin, double zMin, double deltaX,
+                                                  double deltaY, double deltaZ);
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+char* endTimerAtError(void)
+{
+    time_t localFinalTimer=0;
+
+    time(&localFinalTimer);
+
+    return ctime(&localFinalTimer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void closeTheFile(FILE** pFileToClose)
+{
+    if (pFileToClose!=NULL)
+    {
+        if (*pFileToClose!=NULL)
+        {
+            if (fclose(*pFileToClose))
+            {
+                fprintf(stdout,"\nWarning in closeTheFile function: ");
+                fprintf(stdout,"in addition, we were not able to close ");
+                fprintf(stdout,"the file properly.\n");
+            }
+            else
+            {
+                fprintf(stdout,"Closing file.\n");
+            }
+            *pFileToClose=NULL;
+        }
+    }
+
+    return;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+int checkStringFromLength(char* stringToCheck, int minimumLength,
+                                                              int maximumLength)
+{
+    int i=0, j=0;
+
+    // Check if stringToCheck is pointing to NULL
+    if (stringToCheck==NULL)
+    {
+        PRINT_ERROR("In checkStringFromLength: the input (char*) variable ");
+        fprintf(stderr,"stringToCheck=%p does not point ",(void*)stringToCheck);
+        fprintf(stderr,"to a valid address.\n");
+        return 0;
+    }
+
+    // Check if the bounds are correct
+    if (minimumLength<1 || maximumLength<minimumLength)
+    {
+        PRINT_ERROR("In checkStringFromLength: the input variable ");
+        fprintf(stderr,"minimumLength (=%d) should be a ",minimumLength);
+        fprintf(stderr,"positive integer less or equal to the other input ");
+        fprintf(stderr,"variable maximumLength (=%d).\n",maximumLength);
+        return 0;
+    }
+
+    // Check if stringToCheck is a string of correct length
+    i=0;
+    while (stringToCheck[i]!='\0' && i<maximumLength)
+    {
+        i++;
+    }
+    if (i==maximumLength)
+    {
+        PRINT_ERROR("In checkStringFromLength: the input (char*) variable ");
+        fprintf(stderr,"stringToCheck=%p is supposed ",(void*)stringToCheck);
+        fprintf(stderr,"to point to a valid string. It seems that ");
+        fprintf(stderr,"stringToCheck is not a string (no terminating NUL ");
+        fprintf(stderr,"character found among the characters ");
+        for (j=0; j<maximumLength; j++)
+        {
+            fprintf(stderr,"%c",stringToCheck[j]);
+        }
+        fprintf(stderr,") or has a length greater or equal to maximumLength ");
+        fprintf(stderr,"(=%d).\n",maximumLength);
+        return 0;
+    }
+    else if (i<minimumLength-1)
+    {
+        PRINT_ERROR("In checkStringFromLength: the input (char*) variable ");
+        fprintf(stderr,"stringToCheck is a string (=%s) of ",stringToCheck);
+        fprintf(stderr,"length %d, which is strictly less than the minimal ",i);
+        fprintf(stderr,"size (=%d) allowed here.\n",minimumLength-1);
+        return 0;
+    }
+
+    // Add the terminating NUL character '\0' to the length size
+    i++;
+
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void freeHistoryMemory(History* pHistory)
+{
+    if (pHistory!=NULL)
+    {
+        free(pHistory->pNucl);
+        pHistory->pNucl=NULL;
+        free(pHistory->pLabel);
+        pHistory->pLabel=NULL;
+    }
+
+    return;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+int readingHistoryFile(char nameFile[NAME_SIZE_MAX], int iteration,
+                                                             History* pHistory)
+{
+    char magic[9]={'\0'};
+    int i=0, j=0, k=0, nRuns=0, *pRuns=NULL, pInteger[8]={0};
+    double pDouble[7]={0.};
+    FILE* historyFile=NULL;
+
+    // Add the terminating NUL characters '\0' to ensure nameFile is a string
+    nameFile[NAME_SIZE_MAX-1]='\0';
+
+    // Check the input variables
+    if (pHistory==NULL)
+    {
+        PRINT_ERROR("In readingHistoryFile: the input (History*) variable ");
+        fprintf(stderr,"pHistory=%p does not point to a ",(void*)pHistory);
+        fprintf(stderr,"valid adress.\n");
+        return 0;
+    }
+
+    // Opening the *.hist file in binary mode (read only)
+    fprintf(stdout,"\nOpening the %s file. ",nameFile);
+    historyFile=fopen(nameFile,"rb");
+    if (historyFile==NULL)
+    {
+        PRINT_ERROR("In readingHistoryFile: we were not able to open and ");
+        fprintf(stderr,"read the %s file properly.\n",nameFile);
+        return 0;
+    }
+    fprintf(stdout,"Reading grid data. ");
+
+    // fread returns the number of elements successfully read
+    if (fread(magic,sizeof(char),8,historyFile)!=8 ||
+                                                     strcmp(magic,HIST_MAGIC) ||
+                                 fread(pInteger,sizeof(int),8,historyFile)!=8 ||
+                                                      pInteger[0]!=HIST_VERSION)
+    {
+        PRINT_ERROR("In readingHistoryFile: the ");
+        fprintf(stderr,"%s file does not start with the ",nameFile);
+        fprintf(stderr,"%s ",HIST_MAGIC);
+        fprintf(stderr,"characters followed by the version number ");
+        fprintf(stderr,"%d of the *.hist format.\n",HIST_VERSION);
+        closeTheFile(&historyFile);
+        return 0;
+    }
+    pHistory->nX=pInteger[1];
+    pHistory->nY=pInteger[2];
+    pHistory->nZ=pInteger[3];
+    pHistory->nNucl=pInteger[4];
+    if (pHistory->nX<3 || pHistory->nY<3 || pHistory->nZ<3 ||
+                                                            pHistory->nNucl<1)
+    {
+        PRINT_ERROR("In readingHistoryFile: the number of points ");
+        fprintf(stderr,"nX (=%d), nY (=%d), nZ ",pHistory->nX,pHistory->nY);
+        fprintf(stderr,"(=%d) should be integers strictly ",pHistory->nZ);
+        fprintf(stderr,"greater than two and the number of nuclei ");
+        fprintf(stderr,"(=%d) a positive integer.\n",pHistory->nNucl);
+        closeTheFile(&historyFile);
+        return 0;
+    }
+    pHistory->nHex=(pHistory->nX-1)*(pHistory->nY-1)*(pHistory->nZ-1);
+    fprintf(stdout,"\n(%d)x(%d)x",pHistory->nX,pHistory->nY);
+    fprintf(stdout,"(%d) grid points, %d nuclei, ",pHistory->nZ,pInteger[4]);
+    fprintf(stdout,"%d electrons in the domain, ",pInteger[5]);
+    fprintf(stdout,"%d molecular orbitals.\n",pInteger[6]);
+
+    if (fread(pDouble,sizeof(double),6,historyFile)!=6)
+    {
+        PRINT_ERROR("In readingHistoryFile: could not read the box ");
+        fprintf(stderr,"origin and discretization steps in the %s ",nameFile);
+        fprintf(stderr,"file.\n");
+        closeTheFile(&historyFile);
+        return 0;
+    }
+    pHistory->xMin=pDouble[0];
+    pHistory->yMin=pDouble[1];
+    pHistory->zMin=pDouble[2];
+    pHistory->deltaX=pDouble[3];
+    pHistory->deltaY=pDouble[4];
+    pHistory->deltaZ=pDouble[5];
+
+    // Reading the nuclei
+    pHistory->pNucl=(Nucleus*)calloc(pHistory->nNucl,sizeof(Nucleus));
+    if (pHistory->pNucl==NULL)
+    {
+        PRINT_ERROR("In readingHistoryFile: could not allocate memory for ");
+        fprintf(stderr,"the (Nucleus*) pHistory->pNucl variable.\n");
+        closeTheFile(&historyFile);
+        return 0;
+    }
+    for (i=0; i<pHistory->nNucl; i++)
+    {
+        if (fread(pInteger,sizeof(int),2,historyFile)!=2 ||
+                                 fread(pDouble,sizeof(double),3,historyFile)!=3)
+        {
+            PRINT_ERROR("In readingHistoryFile: could not read the ");
+            fprintf(stderr,"%d-th nucleus in the %s file.\n",i+1,nameFile);
+            closeTheFile(&historyFile);
+            return 0;
+        }
+        pHistory->pNucl[i].charge=pInteger[0];
+        pHistory->pNucl[i].x=pDouble[0];
+        pHistory->pNucl[i].y=pDouble[1];
+        pHistory->pNucl[i].z=pDouble[2];
+    }
+
+    // Allocating memory for the runs (at most one per hexahedron)
+    pRuns=(int*)calloc(2*pHistory->nHex,sizeof(int));
+    if (pRuns==NULL)
+    {
+        PRINT_ERROR("In readingHistoryFile: could not allocate memory for ");
+        fprintf(stderr,"the local (int*) pRuns variable.\n");
+        closeTheFile(&historyFile);
+        return 0;
+    }
+
+    // Reading the records successively until the prescribed iteration
+    if (iteration<0)
+    {
+        fprintf(stdout,"\n   Iteration   Opt_mode   ");
+        fprintf(stdout,"Probability     Population     Time (s)\n");
+    }
+    while (fread(pInteger,sizeof(int),4,historyFile)==4)
+    {
+        nRuns=pInteger[2];
+        if (nRuns<1 || nRuns>pHistory->nHex ||
+                               fread(pDouble,sizeof(double),7,historyFile)!=7 ||
+                (int)fread(pRuns,sizeof(int),2*nRuns,historyFile)!=2*nRuns)
+        {
+            PRINT_ERROR("In readingHistoryFile: the record following the ");
+            fprintf(stderr,"header of the %d-th iteration ",pInteger[0]);
+            fprintf(stderr,"in the %s file is corrupted.\n",nameFile);
+            closeTheFile(&historyFile);
+            free(pRuns);
+            return 0;
+        }
+
+        if (iteration<0)
+        {
+            fprintf(stdout,"   %9d   %8d   ",pInteger[0],pInteger[1]);
+            fprintf(stdout,"%.9lf   %.9lf   %lf\n",pDouble[0],pDouble[1],
+                                                                   pDouble[6]);
+        }
+        else if (pInteger[0]==iteration)
+        {
+            break;
+        }
+    }
+
+    if (iteration<0)
+    {
+        closeTheFile(&historyFile);
+        free(pRuns);
+        return 1;
+    }
+
+    if (feof(historyFile) || pInteger[0]!=iteration)
+    {
+        PRINT_ERROR("In readingHistoryFile: no record was found for the ");
+        fprintf(stderr,"%d-th iteration in the %s file.\n",iteration,nameFile);
+        closeTheFile(&historyFile);
+        free(pRuns);
+        return 0;
+    }
+    fprintf(stdout,"Decoding the %d-th iteration. ",iteration);
+
+    // Expanding the (label, length) runs into the labels of the hexahedra
+    pHistory->pLabel=(int*)calloc(pHistory->nHex,sizeof(int));
+    if (pHistory->pLabel==NULL)
+    {
+        PRINT_ERROR("In readingHistoryFile: could not allocate memory for ");
+        fprintf(stderr,"the (int*) pHistory->pLabel variable.\n");
+        closeTheFile(&historyFile);
+        free(pRuns);
+        return 0;
+    }
+    k=0;
+    for (i=0; i<nRuns; i++)
+    {
+        if (pRuns[2*i+1]<1 || k+pRuns[2*i+1]>pHistory->nHex)
+        {
+            PRINT_ERROR("In readingHistoryFile: the (label, length) runs ");
+            fprintf(stderr,"of the %d-th iteration do not ",iteration);
+            fprintf(stderr,"cover exactly the %d hexahedra ",pHistory->nHex);
+            fprintf(stderr,"of the grid.\n");
+            closeTheFile(&historyFile);
+            free(pRuns);
+            return 0;
+        }
+        for (j=0; j<pRuns[2*i+1]; j++)
+        {
+            pHistory->pLabel[k]=pRuns[2*i];
+            k++;
+        }
+    }
+    free(pRuns);
+    pRuns=NULL;
+
+    if (k!=pHistory->nHex)
+    {
+        PRINT_ERROR("In readingHistoryFile: expecting ");
+        fprintf(stderr,"%d instead of %d decoded ",pHistory->nHex,k);
+        fprintf(stderr,"labels for the %d-th iteration.\n",iteration);
+        closeTheFile(&historyFile);
+        return 0;
+    }
+
+    // Closing the *.hist file
+    if (fclose(historyFile))
+    {
+        PRINT_ERROR("In readingHistoryFile: the ");
+        fprintf(stderr,"%s file has not been closed properly.\n",nameFile);
+        historyFile=NULL;
+        return 0;
+    }
+    historyFile=NULL;
+    fprintf(stdout,"Closing file.\n");
+
+    return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+int writingCubeFile(char nameFile[NAME_SIZE_MAX], History* pHistory)
+{
+    int i=0;
+    FILE* cubeFile=NULL;
+
+    // Add the terminating NUL characters '\0' to ensure nameFile is a string
+    nameFile[NAME_SIZE_MAX-1]='\0';
+
+    // Check the input variables
+    if (pHistory==NULL)
+    {
+        PRINT_ERROR("In writingCubeFile: the input (History*) variable ");
+        fprintf(stderr,"pHistory=%p does not point to a ",(void*)pHistory);
+        fprintf(stderr,"valid adress.\n");
+        return 0;
+    }
+
+    if (pHistory->pNucl==NULL || pHistory->pLabel==NULL)
+    {
+        PRINT_ERROR("In writingCubeFile: the pNucl=");
+        fprintf(stderr,"%p or pLabel=",(void*)pHistory->pNucl);
+        fprintf(stderr,"%p variables of the ",(void*)pHistory->pLabel);
+        fprintf(stderr,"structure pointed by pHistory does not point to a ");
+        fprintf(stderr,"valid adress.\n");
+        return 0;
+    }
+
+    // Opening *.cube file (warning: reset and overwrite file if already exists)
+    fprintf(stdout,"Opening the %s file. ",nameFile);
+    cubeFile=fopen(nameFile,"w+");
+    if (cubeFile==NULL)
+    {
+        PRINT_ERROR("In writingCubeFile: we were not able to open and ");
+        fprintf(stderr,"write into the %s file properly.\n",nameFile);
+        return 0;
+    }
+    fprintf(stdout,"Writing grid data. ");
+
+    // Same layout as the one of the *.cube files saved by MPD software
+    fprintf(cubeFile,"CubeFile\nNew grid\n    %d",pHistory->nNucl);
+    fprintf(cubeFile,"    %.8le",pHistory->xMin+.5*pHistory->deltaX);
+    fprintf(cubeFile,"    %.8le",pHistory->yMin+.5*pHistory->deltaY);
+    fprintf(cubeFile,"    %.8le\n",pHistory->zMin+.5*pHistory->deltaZ);
+    fprintf(cubeFile,"    %d",pHistory->nX-1);
+    fprintf(cubeFile,"    %lf    %lf    %lf\n",pHistory->deltaX,0.,0.);
+    fprintf(cubeFile,"    %d",pHistory->nY-1);
+    fprintf(cubeFile,"    %lf    %lf    %lf\n",0.,pHistory->deltaY,0.);
+    fprintf(cubeFile,"    %d",pHistory->nZ-1);
+    fprintf(cubeFile,"    %lf    %lf    %lf\n",0.,0.,pHistory->deltaZ);
+
+    for (i=0; i<pHistory->nNucl; i++)
+    {
+        fprintf(cubeFile,"    %d",pHistory->pNucl[i].charge);
+        fprintf(cubeFile,"    %lf",(double)pHistory->pNucl[i].charge);
+        fprintf(cubeFile,"    %.8le",pHistory->pNucl[i].x);
+        fprintf(cubeFile,"    %.8le",pHistory->pNucl[i].y);
+        fprintf(cubeFile,"    %.8le\n",pHistory->pNucl[i].z);
+    }
+
+    for (i=0; i<pHistory->nHex; i++)
+    {
+        if (!(i%6))
+        {
+            fprintf(cubeFile,"\n");
+        }
+
+        // Exterior domain: (+/-)2; Interior domain: (+/-)3
+        if (abs(pHistory->pLabel[i])==3)
+        {
+            fprintf(cubeFile,"    %lf",1.);
+        }
+        else
+        {
+            fprintf(cubeFile,"    %lf",0.);
+        }
+    }
+
+    // Closing the output *.cube file
+    if (fclose(cubeFile))
+    {
+        PRINT_ERROR("In writingCubeFile: the ");
+        fprintf(stderr,"%s file has not been closed properly.\n",nameFile);
+        cubeFile=NULL;
+        return 0;
+    }
+    cubeFile=NULL;
+    fprintf(stdout,"Closing file.\n");
+
+    return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+int writingHexahedralMesh(char nameFile[NAME_SIZE_MAX], int nDom, int* pDom,
+                          int nVer, int nHex, int nQua, int nX, int nY, int nZ,
+                          double xMin, double yMin, double zMin, double deltaX,
+                                                   double deltaY, double deltaZ)
+{
+    int i=0, j=0, k=0, l=0, lPoint=0, counter=0;
+    FILE* meshFile=NULL;
+
+    // Add the terminating NUL characters '\0' to ensure nameFile is a string
+    nameFile[NAME_SIZE_MAX-1]='\0';
+
+    // Check the input variables
+    if (nVer<1 || nHex<1 || nQua<1 || nDom<0)
+    {
+        PRINT_ERROR("In writingHexahedralMesh: the total number of vertices ");
+        fprintf(stderr,"(=%d), hexahedra (=%d), quadrilaterals ",nVer,nHex);
+        if (!nDom)
+        {
+            fprintf(stderr,"(=%d), and hexahedra (=%d) belonging ",nQua,nDom);
+            fprintf(stderr,"to the internal domain should be positive ");
+            fprintf(stderr,"integers.\n");
+        }
+        else
+        {
+            fprintf(stderr,"(=%d) should be positive integers.\n",nQua);
+
+        }
+        return 0;
+    }
+
+    if (pDom==NULL)
+    {
+        PRINT_ERROR("In writingHexahedralMesh: the input (int*) variable ");
+        fprintf(stderr,"pDom=%p does not point to a valid ",(void*)pDom);
+        fprintf(stderr,"adress.\n");
+        return 0;
+    }
+
+    if (nDom>nHex)
+    {
+        PRINT_ERROR("In writingHexahedralMesh: the total number of hexahedra ");
+        fprintf(stderr,"corresponding to the internal domain (=%d) ",nDom);
+        fprintf(stderr,"cannot be (strictly) greater than the total number");
+        fprintf(stderr," of hexahedra in the mesh (=%d).\n",nHex);
+        return 0;
+    }
+
+    if (nX<3 || nY<3 || nZ<3)
+    {
+        PRINT_ERROR("In writingHexahedralMesh: the input variables ");
+        fprintf(stderr,"nX (=%d), nY (=%d), and nZ (=%d) should be ",nX,nY,nZ);
+        fprintf(stderr,"integers strictly greater than two.\n");
+        return 0;
+    }
+    if (nVer!=nX*nY*nZ || nHex!=(nX-1)*(nY-1)*(nZ-1) ||
+                            nQua!=2*((nX-1)*(nY-1)+(nX-1)*(nZ-1)+(nY-1)*(nZ-1)))
+    {
+        PRINT_ERROR("In writingHexahedralMesh: expecting ");
+        fprintf(stderr,"%d instead of %d for the total number ",nX*nY*nZ,nVer);
+        fprintf(stderr,"of vertices, %d instead of ",(nX-1)*(nY-1)*(nZ-1));
+        fprintf(stderr,"%d for the total number of hexahedra, and ",nHex);
+        fprintf(stderr,"%d ",2*((nX-1)*(nY-1)+(nX-1)*(nZ-1)+(nY-1)*(nZ-1)));
+        fprintf(stderr,"instead of %d for the total number of ",nQua);
+        fprintf(stderr,"quadrilaterals.\n");
+        return 0;
+    }
+
+    if (deltaX<=0. || deltaY<=0. || deltaZ<=0.)
+    {
+        PRINT_ERROR("In writingHexahedralMesh: the input variables ");
+        fprintf(stderr,"deltaX (=%lf), deltaY (=%lf), or ",deltaX,deltaY);
+        fprintf(stderr,"deltaZ (=%lf) should be positive values.\n",deltaZ);
+        return 0;
+    }
+
+    // Opening *.mesh file (warning: reset and overwrite file if already exists)
+    fprintf(stdout,"Opening the %s file. ",nameFile);
+    meshFile=fopen(nameFile,"w+");
+    if (meshFile==NULL)
+    {
+        PRINT_ERROR("In writingHexahedralMesh: we were not able to open and ");
+        fprintf(stderr,"write into the %s file properly.\n",nameFile);
+        return 0;
+    }
+    fprintf(stdout,"Writing hexahedral mesh. ");
+
+    // Writing vertices
+    fprintf(meshFile,"MeshVersionFormatted 2\n\nDimension 3\n");
+    fprintf(meshFile,"\nVertices\n%d\n",nVer);
+
+    for (i=0; i<nX; i++)
+    {
+        for (j=0; j<nY; j++)
+        {
+            for (k=0; k<nZ; k++)
+            {
+                fprintf(meshFile,"%.8le %.8le %.8le %d \n",xMin+i*deltaX,
+                                                 yMin+j*deltaY,zMin+k*deltaZ,0);
+            }
+        }
+    }
+
+    // Writing hexahedra
+    fprintf(meshFile,"\nHexahedra\n%d\n",nHex);
+    counter=0;
+    for (i=1; i<nX; i++)
+    {
+        for (j=1; j<nY; j++)
+        {
+            for (k=1; k<nZ; k++)
+            {
+                fprintf(meshFile,"%d ",1+((i-1)*nY+(j-1))*nZ+(k-1));
+                fprintf(meshFile,"%d ",1+(i*nY+(j-1))*nZ+(k-1));
+                fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+(k-1));
+                fprintf(meshFile,"%d ",1+((i-1)*nY+j)*nZ+(k-1));
+                fprintf(meshFile,"%d ",1+((i-1)*nY+(j-1))*nZ+k);
+                fprintf(meshFile,"%d ",1+(i*nY+(j-1))*nZ+k);
+                fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+k);
+                fprintf(meshFile,"%d ",1+((i-1)*nY+j)*nZ+k);
+                if (nDom)
+                {
+                    if (pDom[counter]==1)
+                    {
+                        fprintf(meshFile,"%d \n",LABEL_INTERNAL_TETRA);
+                    }
+                    else
+                    {
+                        fprintf(meshFile,"%d \n",LABEL_EXTERNAL_TETRA);
+                    }
+                }
+                else
+                {
+                    fprintf(meshFile,"%d \n",0);
+                }
+                counter++;
+            }
+        }
+    }
+
+    if (nDom)
+    {
+        // Counting the number of boundary quadrilaterals for the internal cube
+        counter=0;
+        for (l=0; l<nHex; l++)
+        {
+            k=l%(nZ-1);
+            lPoint=l/(nZ-1);
+            j=lPoint%(nY-1);
+            i=lPoint/(nY-1);
+            if (i>0)
+            {
+                lPoint=((i-1)*(nY-1)+j)*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==0 && pDom[lPoint]==1)
+                {
+                    counter++;
+                }
+            }
+            if (i<nX-2)
+            {
+                lPoint=((i+1)*(nY-1)+j)*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==0 && pDom[lPoint]==1)
+                {
+                    counter++;
+                }
+            }
+            if (j>0)
+            {
+                lPoint=(i*(nY-1)+(j-1))*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==0 && pDom[lPoint]==1)
+                {
+                    counter++;
+                }
+            }
+            if (j<nY-2)
+            {
+                lPoint=(i*(nY-1)+(j+1))*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==0 && pDom[lPoint]==1)
+                {
+                    counter++;
+                }
+            }
+            if (k>0)
+            {
+                lPoint=(i*(nY-1)+j)*(nZ-1)+(k-1);
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==0 && pDom[lPoint]==1)
+                {
+                    counter++;
+                }
+            }
+            if (k<nZ-2)
+            {
+                 lPoint=(i*(nY-1)+j)*(nZ-1)+(k+1);
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==0 && pDom[lPoint]==1)
+                {
+                    counter++;
+                }
+            }
+        }
+        fprintf(stdout,"\nAdding %d quadrilaterals for the ",counter);
+        fprintf(stdout,"internal domains (total is now %d). ",counter+nQua);
+    }
+    else
+    {
+        counter=0;
+    }
+
+    // Writing quadrilaterals
+    fprintf(meshFile,"\nQuadrilaterals\n%d\n",nQua+counter);
+
+    // Face 1 (j=0) with reference (a,b,c) in each quadrilateral
+    // corresponding to square cell: 1=(i-1,k-1) 2=(i,k-1) 3=(i,k) 4=(i-1,k)
+    for (i=1; i<nX; i++)
+    {
+        for (k=1; k<nZ; k++)
+        {
+            // Square 1234
+            fprintf(meshFile,"%d ",1+(i-1)*nY*nZ+(k-1));
+            fprintf(meshFile,"%d ",1+i*nY*nZ+(k-1));
+            fprintf(meshFile,"%d ",1+i*nY*nZ+k);
+            fprintf(meshFile,"%d ",1+(i-1)*nY*nZ+k);
+            fprintf(meshFile,"%d \n",1);
+        }
+    }
+
+    // Face 2 (i=nX-1) with reference (a,b,c) in square cell:
+    // 1=(j-1,k-1) 2=(j,k-1) 3=(j,k) 4=(j-1,k)
+    for (j=1; j<nY; j++)
+    {
+        for (k=1; k<nZ; k++)
+        {
+            // Square 1234
+            fprintf(meshFile,"%d ",1+((nX-1)*nY+(j-1))*nZ+(k-1));
+            fprintf(meshFile,"%d ",1+((nX-1)*nY+j)*nZ+(k-1));
+            fprintf(meshFile,"%d ",1+((nX-1)*nY+j)*nZ+k);
+            fprintf(meshFile,"%d ",1+((nX-1)*nY+(j-1))*nZ+k);
+            fprintf(meshFile,"%d \n",2);
+        }
+    }
+
+    // Face 3 (j=nY-1) with reference (a,b,c) in square cell:
+    // 1=(i-1,k-1) 2=(i,k-1) 3=(i,k) 4=(i-1,k)
+    for (i=1; i<nX; i++)
+    {
+        for (k=1; k<nZ; k++)
+        {
+            // Square 1432
+            fprintf(meshFile,"%d ",1+((i-1)*nY+(nY-1))*nZ+(k-1));
+            fprintf(meshFile,"%d ",1+((i-1)*nY+(nY-1))*nZ+k);
+            fprintf(meshFile,"%d ",1+(i*nY+(nY-1))*nZ+k);
+            fprintf(meshFile,"%d ",1+(i*nY+(nY-1))*nZ+(k-1));
+            fprintf(meshFile,"%d \n",3);
+        }
+    }
+
+    // Face 4 (i=0) with reference (a,b,c) in square cell:
+    // 1=(j-1,k-1) 2=(j,k-1) 3=(j,k) 4=(j-1,k)
+    for (j=1; j<nY; j++)
+    {
+        for (k=1; k<nZ; k++)
+        {
+            // Square 1432
+            fprintf(meshFile,"%d ",1+(j-1)*nZ+(k-1));
+            fprintf(meshFile,"%d ",1+(j-1)*nZ+k);
+            fprintf(meshFile,"%d ",1+j*nZ+k);
+            fprintf(meshFile,"%d ",1+j*nZ+(k-1));
+            fprintf(meshFile,"%d \n",4);
+        }
+    }
+
+    // Face 5 (k=0) with reference (a,b,c) in square cell:
+    // 1=(i-1,j-1) 2=(i,j-1) 3=(i,j) 4=(i-1,j)
+    for (i=1; i<nX; i++)
+    {
+        for (j=1; j<nY; j++)
+        {
+            // Square 1432
+            fprintf(meshFile,"%d ",1+((i-1)*nY+(j-1))*nZ);
+            fprintf(meshFile,"%d ",1+((i-1)*nY+j)*nZ);
+            fprintf(meshFile,"%d ",1+(i*nY+j)*nZ);
+            fprintf(meshFile,"%d ",1+(i*nY+(j-1))*nZ);
+            fprintf(meshFile,"%d \n",5);
+        }
+    }
+
+    // Face 6 (k=nZ-1) with reference (a,b,c) in square cell:
+    // 1=(i-1,j-1) 2=(i,j-1) 3=(i,j) 4=(i-1,j)
+    for (i=1; i<nX; i++)
+    {
+        for (j=1; j<nY; j++)
+        {
+            // Square 1234
+            fprintf(meshFile,"%d ",1+((i-1)*nY+(j-1))*nZ+(nZ-1));
+            fprintf(meshFile,"%d ",1+(i*nY+(j-1))*nZ+(nZ-1));
+            fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+(nZ-1));
+            fprintf(meshFile,"%d ",1+((i-1)*nY+j)*nZ+(nZ-1));
+            fprintf(meshFile,"%d \n",6);
+        }
+     }
+
+    if (nDom)
+    {
+        // Saving boundary quadrilaterals for the internal cube
+        for (l=0; l<nHex; l++)
+        {
+            k=l%(nZ-1);
+            lPoint=l/(nZ-1);
+            j=lPoint%(nY-1);
+            i=lPoint/(nY-1);
+            if (i>0)
+            {
+                lPoint=((i-1)*(nY-1)+j)*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==1 && pDom[lPoint]==0)
+                {
+                    fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+k);
+                    fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+(i*nY+(j+1))*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+(i*nY+(j+1))*nZ+k);
+                    fprintf(meshFile,"%d \n",LABEL_BOUNDARY);
+                }
+            }
+            if (i<nX-2)
+            {
+                lPoint=((i+1)*(nY-1)+j)*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==1 && pDom[lPoint]==0)
+                {
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+j)*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+j)*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+(j+1))*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+(j+1))*nZ+k);
+                    fprintf(meshFile,"%d \n",LABEL_BOUNDARY);
+                }
+            }
+            if (j>0)
+            {
+                lPoint=(i*(nY-1)+(j-1))*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==1 && pDom[lPoint]==0)
+                {
+                    fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+j)*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+j)*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+(k+1));
+                    fprintf(meshFile,"%d \n",LABEL_BOUNDARY);
+                }
+            }
+            if (j<nY-2)
+            {
+                 lPoint=(i*(nY-1)+(j+1))*(nZ-1)+k;
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==1 && pDom[lPoint]==0)
+                {
+                    fprintf(meshFile,"%d ",1+(i*nY+(j+1))*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+(j+1))*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+(j+1))*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+(i*nY+(j+1))*nZ+(k+1));
+                    fprintf(meshFile,"%d \n",LABEL_BOUNDARY);
+                }
+            }
+            if (k>0)
+            {
+                lPoint=(i*(nY-1)+j)*(nZ-1)+(k-1);
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==1 && pDom[lPoint]==0)
+                {
+                    fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+k);
+                    fprintf(meshFile,"%d ",1+(i*nY+(j+1))*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+(j+1))*nZ+k);
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+j)*nZ+k);
+                    fprintf(meshFile,"%d \n",LABEL_BOUNDARY);
+                }
+            }
+            if (k<nZ-2)
+            {
+                lPoint=(i*(nY-1)+j)*(nZ-1)+(k+1);
+
+                // Test not to count two times the quadrilaterals
+                if (pDom[l]==1 && pDom[lPoint]==0)
+                {
+                    fprintf(meshFile,"%d ",1+(i*nY+j)*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+j)*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+((i+1)*nY+(j+1))*nZ+(k+1));
+                    fprintf(meshFile,"%d ",1+(i*nY+(j+1))*nZ+(k+1));
+                    fprintf(meshFile,"%d \n",LABEL_BOUNDARY);
+                }
+            }
+        }
+    }
+    fprintf(meshFile,"\nEnd\n\n");
+
+    // Closing the output *.mesh file
+    if (fclose(meshFile))
+    {
+        PRINT_ERROR("In writingHexahedralMesh: the ");
+        fprintf(stderr,"%s file has not been closed properly.\n",nameFile);
+        meshFile=NULL;
+        return 0;
+    }
+    meshFile=NULL;
+    fprintf(stdout,"Closing file.\n");
+
+    return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    char *pEnd=NULL;
+    int length=0, i=0, iteration=0, nDom=0, *pDom=NULL, boolean=0;
+    History history;
+
+    // Check the number of arguments
+    if (argc!=2 && argc!=4)
+    {
+        PRINT_ERROR("In main: the program only takes one or three arguments ");
+        fprintf(stderr,"instead of %d.\n",argc-1);
+        return EXIT_FAILURE;
+    }
+
+    // Check the length and extension of the input file name
+    length=checkStringFromLength(argv[1],7,NAME_SIZE_MAX);
+    if (!length)
+    {
+        PRINT_ERROR("In main: the input *.hist file name should be a string ");
+        fprintf(stderr,"of at most %d characters (and ",NAME_SIZE_MAX-1);
+        fprintf(stderr,"strictly more than 5 to contain at least something ");
+        fprintf(stderr,"more than the *.hist extension).\n");
+        return EXIT_FAILURE;
+    }
+    if (strcmp(argv[1]+length-6,".hist"))
+    {
+        PRINT_ERROR("In main: the input *.hist extension does not ");
+        fprintf(stderr,"correspond to the one of the %s file name.\n",argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    // Check the iteration and the output file name
+    iteration=-1;
+    if (argc==4)
+    {
+        iteration=(int)strtol(argv[2],&pEnd,10);
+        if (pEnd==argv[2] || *pEnd!='\0' || iteration<0)
+        {
+            PRINT_ERROR("In main: the second argument ");
+            fprintf(stderr,"(=%s) should be a non-negative ",argv[2]);
+            fprintf(stderr,"integer (iteration to be extracted).\n");
+            return EXIT_FAILURE;
+        }
+
+        length=checkStringFromLength(argv[3],7,NAME_SIZE_MAX);
+        if (!length)
+        {
+            PRINT_ERROR("In main: the output file name should be a ");
+            fprintf(stderr,"string of at most %d ",NAME_SIZE_MAX-1);
+            fprintf(stderr,"characters (and strictly more than 5 to contain ");
+            fprintf(stderr,"at least something more than the *.cube or ");
+            fprintf(stderr,"*.mesh extension).\n");
+            return EXIT_FAILURE;
+        }
+        boolean=!strcmp(argv[3]+length-6,".cube");
+        if (!boolean && strcmp(argv[3]+length-6,".mesh"))
+        {
+            PRINT_ERROR("In main: the output file name ");
+            fprintf(stderr,"(=%s) does not end with the *.cube ",argv[3]);
+            fprintf(stderr,"or *.mesh extension.\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Reading the *.hist file (only listing the records if no iteration)
+    history.pNucl=NULL;
+    history.pLabel=NULL;
+    if (!readingHistoryFile(argv[1],iteration,&history))
+    {
+        PRINT_ERROR("In main: readingHistoryFile function returned zero ");
+        fprintf(stderr,"instead of one.\n");
+        freeHistoryMemory(&history);
+        return EXIT_FAILURE;
+    }
+    if (argc==2)
+    {
+        freeHistoryMemory(&history);
+        return EXIT_SUCCESS;
+    }
+
+    if (boolean)
+    {
+        if (!writingCubeFile(argv[3],&history))
+        {
+            PRINT_ERROR("In main: writingCubeFile function returned zero ");
+            fprintf(stderr,"instead of one.\n");
+            freeHistoryMemory(&history);
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        // Hexahedra labelled one if they belong to the domain, zero otherwise
+        pDom=(int*)calloc(history.nHex,sizeof(int));
+        if (pDom==NULL)
+        {
+            PRINT_ERROR("In main: could not allocate memory for the local ");
+            fprintf(stderr,"(int*) pDom=%p variable.\n",(void*)pDom);
+            freeHistoryMemory(&history);
+            return EXIT_FAILURE;
+        }
+        nDom=0;
+        for (i=0; i<history.nHex; i++)
+        {
+            if (abs(history.pLabel[i])==3)
+            {
+                pDom[i]=1;
+                nDom++;
+            }
+        }
+
+        if (!writingHexahedralMesh(argv[3],nDom,pDom,
+                                   history.nX*history.nY*history.nZ,
+                                   history.nHex,
+                                   2*((history.nX-1)*(history.nY-1)+
+                                      (history.nX-1)*(history.nZ-1)+
+                                      (history.nY-1)*(history.nZ-1)),
+                                   history.nX,history.nY,history.nZ,
+                                   history.xMin,history.yMin,history.zMin,
+                                   history.deltaX,history.deltaY,
+                                                                history.deltaZ))
+        {
+            PRINT_ERROR("In main: writingHexahedralMesh function returned ");
+            fprintf(stderr,"zero instead of one.\n");
+            free(pDom);
+            pDom=NULL;
+            freeHistoryMemory(&history);
+            return EXIT_FAILURE;
+        }
+        free(pDom);
+        pDom=NULL;
+    }
+
+    // Free the allocated memory
+    freeHistoryMemory(&history);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+#include "mshdist.h"
+
+#define BVH_LEAF   4
+#define BVH_STACK  64
+
+
+/* reorder item[ia..ib-1] so that the k-th one has the median coordinate
+   (along axis) of the centers of the spheres */
+static void selectBvh(int *item,double *circum,int axis,int ia,int ib,int k) {
+  double   piv;
+  int      i,j,tmp;
+
+  ib--;
+  while ( ia < ib ) {
+    piv = circum[4*(item[(ia+ib)/2]-1)+1+axis];
+    i   = ia;
+    j   = ib;
+    while ( i <= j ) {
+      while ( circum[4*(item[i]-1)+1+axis] < piv )  i++;
+      while ( circum[4*(item[j]-1)+1+axis] > piv )  j--;
+      if ( i <= j ) {
+        tmp     = item[i];
+        item[i] = item[j];
+        item[j] = tmp;
+        i++;
+        j--;
+      }
+    }
+    if ( k <= j )       ib = j;
+    else if ( k >= i )  ia = i;
+    else                break;
+  }
+}
+
+
+/* build recursively the node enclosing the spheres of item[ia..ib-1] */
+static int nodeBvh(pBvh bvh,int ia,int ib) {
+  BvhNode  *pn;
+  double   *circ,r,len,lmax;
+  int       i,j,n,axis;
+
+  n  = bvh->nnode++;
+  pn = &bvh->node[n];
+  for (j=0; j<3; j++) {
+    pn->min[j] =  1.e30;
+    pn->max[j] = -1.e30;
+  }
+  for (i=ia; i<ib; i++) {
+    circ = &bvh->circum[4*(bvh->item[i]-1)+1];
+    r    = sqrt(circ[3]);
+    for (j=0; j<3; j++) {
+      pn->min[j] = D_MIN(pn->min[j],circ[j]-r);
+      pn->max[j] = D_MAX(pn->max[j],circ[j]+r);
+    }
+  }
+  pn->ia    = ia;
+  pn->nb    = ib - ia;
+  pn->left  = 0;
+  pn->right = 0;
+  if ( ib - ia <= BVH_LEAF )  return(n);
+
+  /* split along the longest side at the median center */
+  axis = 0;
+  lmax = pn->max[0] - pn->min[0];
+  for (j=1; j<3; j++) {
+    len = pn->max[j] - pn->min[j];
+    if ( len > lmax ) {
+      lmax = len;
+      axis = j;
+    }
+  }
+  i = (ia + ib) / 2;
+  selectBvh(bvh->item,bvh->circum,axis,ia,ib,i);
+
+  pn->left  = nodeBvh(bvh,ia,i);
+  pn->right = nodeBvh(bvh,i,ib);
+
+  return(n);
+}
+
+
+/* create the hierarchy of the nb elements of bndy crossed by the interface,
+   each of them being enclosed in the sphere stored in circum (center and
+   squared radius, see buildcircumredis_3d); degenerated ones are skipped */
+pBvh newBvh_3d(int *bndy,int nb,double *circum) {
+  pBvh     bvh;
+  int      j,n;
+
+  bvh = (Bvh*)M_malloc(sizeof(Bvh),"newBvh");
+  assert(bvh);
+  bvh->bndy   = bndy;
+  bvh->circum = circum;
+  bvh->item   = (int*)M_calloc(nb+1,sizeof(int),"newBvh");
+  assert(bvh->item);
+
+  n = 0;
+  for (j=1; j<=nb; j++) {
+    if ( circum[4*(j-1)+4] == 0.0 )  continue;
+    bvh->item[n++] = j;
+  }
+  bvh->nitem = n;
+  bvh->nnode = 0;
+  bvh->node  = (BvhNode*)M_calloc(2*n+1,sizeof(BvhNode),"newBvh");
+  assert(bvh->node);
+  if ( n )  nodeBvh(bvh,0,n);
+
+  return(bvh);
+}
+
+
+void freeBvh(pBvh bvh) {
+  M_free(bvh->item);
+  M_free(bvh->node);
+  M_free(bvh);
+}
+
+
+/* squared distance from c to the box of node pn */
+static double distBvh(BvhNode *pn,double *c) {
+  double   d,dd;
+  int      j;
+
+  dd = 0.0;
+  for (j=0; j<3; j++) {
+    if ( c[j] < pn->min[j] )       d = pn->min[j] - c[j];
+    else if ( c[j] > pn->max[j] )  d = c[j] - pn->max[j];
+    else                           continue;
+    dd += d*d;
+  }
+  return(dd);
+}
+
+
+/* look for the element of the hierarchy nearest to pa, whose (squared)
+   distance would be less than *dmin; return its position in bndy (and update
+   *dmin), 0 if none is closer */
+int nearelt_3d(pMesh mesh,pSol sol,pBvh bvh,pPoint pa,double *dmin) {
+  BvhNode  *pn,*pl,*pr;
+  double   *circ,d,dl,dr,norm;
+  int       i,j,ie,top,stack[BVH_STACK];
+  char      proj;
+
+  if ( !bvh->nitem )  return(0);
+  ie  = 0;
+  top = 0;
+  stack[top++] = 0;
+
+  while ( top ) {
+    pn = &bvh->node[stack[--top]];
+    if ( distBvh(pn,pa->c) >= *dmin )  continue;
+
+    /* leaf: test the spheres, then the elements */
+    if ( !pn->left ) {
+      for (i=pn->ia; i<pn->ia+pn->nb; i++) {
+        j    = bvh->item[i];
+        circ = &bvh->circum[4*(j-1)+1];
+        norm = (pa->c[0]-circ[0])*(pa->c[0]-circ[0]) + (pa->c[1]-circ[1])*(pa->c[1]-circ[1])
+             + (pa->c[2]-circ[2])*(pa->c[2]-circ[2]);
+        d = sqrt(norm) - sqrt(circ[3]);
+        if ( d > 0.0 && d*d >= *dmin )  continue;
+
+        d = distnv0_3d(mesh,sol,bvh->bndy[j],pa,&proj);
+        if ( d < *dmin ) {
+          *dmin = d;
+          ie    = j;
+        }
+      }
+      continue;
+    }
+
+    /* visit the nearest child first */
+    pl = &bvh->node[pn->left];
+    pr = &bvh->node[pn->right];
+    dl = distBvh(pl,pa->c);
+    dr = distBvh(pr,pa->c);
+    assert(top+2 <= BVH_STACK);
+    if ( dl < dr ) {
+      stack[top++] = pn->right;
+      stack[top++] = pn->left;
+    }
+    else {
+      stack[top++] = pn->left;
+      stack[top++] = pn->right;
+    }
+  }
+
+  return(ie);
+}
@@ -8,13 +8,38 @@ extern Info  info;
 extern hash  hTab;
 char ddb;
 
+/* correct in // the distance of the points near the boundary with their
+ nearest element crossing it; in narrow band mode, the other points closer
+ to the boundary than info.band get their exact distance too */
+static void nearpt_3d(int istart,int istop,int ipth,Param *par) {
+  pMesh    mesh;
+  pPoint   pa;
+  double   d;
+  int      k;
+
+  mesh = par->mesh;
+  for (k=istart; k<=istop; k++) {
+    pa = &mesh->point[k];
+    if ( pa->tag < 1 ) {
+      if ( info.band <= 0.0 )  continue;
+      d = info.band * info.band;
+      if ( !nearelt_3d(mesh,par->sol,par->bvh,pa,&d) )  continue;
+      par->dtmp[k] = d;
+    }
+    else
+      nearelt_3d(mesh,par->sol,par->bvh,pa,&par->dtmp[k]);
+    pa->tag = 1;
+  }
+}
+
 /* find background tetras intersecting the boundary,
  and initialize distance at their vertices */
 int iniredist_3d(pMesh mesh, pSol sol) {
+  Param   par;
   pTetra  pt;
   pPoint  p0,p1,p2,p3,pa;
-  double  *solTmp,d, *circum, xc[3],r,norm;
-  int     *bndy,i,j,nb,nc,i0,i1,i2,i3;
+  double  *solTmp,d, *circum;
+  int     *bndy,i,nb,nc,i0,i1,i2,i3;
   char    proj;
 
   nb   = 0;
@@ -126,37 +151,38 @@ for (i=1; i<=mesh->np; i++) {
   if ( pa->tag == 2 )  pa->tag =1;
 }*/
 
-  for (i=1; i<=mesh->np; i++) {
-	  pa = &mesh->point[i];
-	  if ( pa->tag < 1 )  continue;
-	  for (j=1; j<=nb; j++) {
-	    xc[0] = circum[4*(j-1)+1];
-	    xc[1] = circum[4*(j-1)+2];
-	    xc[2] = circum[4*(j-1)+3];
-	    r = circum[4*(j-1)+4];
-	    norm = (pa->c[0]-xc[0])*(pa->c[0]-xc[0]) + (pa->c[1]-xc[1])*(pa->c[1]-xc[1])\
-	        + (pa->c[2]-xc[2])*(pa->c[2]-xc[2]);
-
-	    if(r==0.0) continue;
-      if((r<norm)&&(2* sol->val[i] *(r + norm) < (norm -r)*(norm-r))) continue;
-
-	    pt = &mesh->tetra[bndy[j]];
-	    d  = distnv0_3d(mesh,sol,bndy[j],pa,&proj);
-	    if (/* proj == 1 &&*/ d < fabs(solTmp[i]) ) {
-	      solTmp[i] = d;
-	      //break;
-	    }
-    }
-    pa->tag = 1;
-    nc++;
+  /* the nearest element of each point is found through a hierarchy of the
+     spheres enclosing the elements, instead of testing all of them */
+  par.mesh = mesh;
+  par.sol  = sol;
+  par.dtmp = solTmp;
+  par.bvh  = newBvh_3d(bndy,nb,circum);
+  assert(par.bvh);
+
+  for (i=1; i<=mesh->np; i++)
+    if ( mesh->point[i].tag >= 1 )  nc++;
+
+  if ( info.ncpu > 1 ) {
+    info.libpid = InitParallel(info.ncpu);
+    assert(info.libpid);
+    info.typ[1] = NewType(info.libpid,mesh->np);
+    LaunchParallel(info.libpid,info.typ[1],0,(void *)nearpt_3d,(void *)&par);
+    FreeType(info.libpid,info.typ[1]);
+    StopParallel(info.libpid);
   }
+  else
+    nearpt_3d(1,mesh->np,0,&par);
+
+  freeBvh(par.bvh);
 
   if ( nc )   fprintf(stdout,"     %d correction(s)\n",nc);
 
+  /* values are clamped beyond the narrow band */
+  d = info.band > 0.0 ? info.band : sqrt(INIVAL_3d);
    for (i=1; i<=mesh->np; i++) {
     pa = &mesh->point[i];
     if ( !pa->tag )
-	  sol->val[i] = sol->val[i] < 0.0 ? -sqrt(INIVAL_3d) : sqrt(INIVAL_3d);
+	  sol->val[i] = sol->val[i] < 0.0 ? -d : d;
     else if ( pa->tag )
 	  sol->val[i] = sol->val[i] < 0.0 ? -sqrt(solTmp[i]) : sqrt(solTmp[i]);
   }
@@ -1576,6 +1602,148 @@ int ppgdistfmm_3d(pMesh mesh,pSol sol) {
   return(1);
 }
 
+/* compute in // a trial value at the points from the elements of their ball
+ having a vertex updated at the previous pass (or frozen, at the first one):
+ the other elements cannot give a smaller value than the current one */
+static void fimval_3d(int istart,int istop,int ipth,Param *par) {
+  pMesh     mesh;
+  pSol      sol;
+  pTetra    pt;
+  pPoint    p0,p1;
+  double    d,dist;
+  int       j,k,l,iel,nk,nu,flag;
+  char      i;
+
+  mesh = par->mesh;
+  sol  = par->sol;
+
+  for (k=istart; k<=istop; k++) {
+    p0   = &mesh->point[k];
+    dist = fabs(sol->val[k]);
+    par->dtmp[k] = dist;
+    if ( p0->flag < 0 )  continue;
+
+    flag = par->it > 1 ? par->it-1 : -1;
+    for (l=par->hball[k]; l<par->hball[k+1]; l++) {
+      iel = par->ball[l] / 4;
+      i   = par->ball[l] % 4;
+      pt  = &mesh->tetra[iel];
+
+      /* at least one known value is needed in the element, and an update */
+      nk = nu = 0;
+      for (j=0; j<4; j++) {
+        if ( j == i )  continue;
+        p1 = &mesh->point[pt->v[j]];
+        if ( p1->tag == 1 )  nk++;
+        if ( p1->flag == flag )  nu++;
+      }
+      if ( !nk || !nu )  continue;
+
+      d = actival_3d(mesh,sol,iel,i);
+      if ( d < dist )  dist = d;
+    }
+    par->dtmp[k] = dist;
+  }
+}
+
+/* accept in // the trial values decreasing the distance */
+static void fimupd_3d(int istart,int istop,int ipth,Param *par) {
+  pMesh    mesh;
+  pSol     sol;
+  pPoint   p0;
+  int      k;
+
+  mesh = par->mesh;
+  sol  = par->sol;
+
+  for (k=istart; k<=istop; k++) {
+    p0 = &mesh->point[k];
+    if ( p0->flag < 0 )  continue;
+    if ( fabs(sol->val[k]) - par->dtmp[k] <= EPS2 )  continue;
+
+    sol->val[k] = sol->val[k] > 0.0 ? par->dtmp[k] : -par->dtmp[k];
+    p0->tag  = 1;
+    p0->flag = par->it;
+    par->res[ipth] += 1.0;
+  }
+}
+
+/* Propagation of the signed distance function by the Fast Iterative Method:
+ at each pass, the points next to the ones updated at the previous pass are
+ updated at once (Jacobi like), so that passes are parallel */
+int ppgdistfim_3d(pMesh mesh,pSol sol) {
+  Param     par;
+  pTetra    pt;
+  pPoint    p0;
+  int       k,i,ip,nup;
+
+  par.mesh = mesh;
+  par.sol  = sol;
+  par.dtmp = (double*)malloc((mesh->np+1)*sizeof(double));
+  assert(par.dtmp);
+  par.res  = (double*)calloc(info.ncpu,sizeof(double));
+  assert(par.res);
+
+  /* ball of each point, stored as 4*iel+i in ball[hball[ip]..hball[ip+1]-1] */
+  par.hball = (int*)calloc(mesh->np+2,sizeof(int));
+  assert(par.hball);
+  par.ball  = (int*)malloc(4*mesh->ne*sizeof(int));
+  assert(par.ball);
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    for (i=0; i<4; i++)  par.hball[pt->v[i]]++;
+  }
+  for (ip=1; ip<=mesh->np+1; ip++)  par.hball[ip] += par.hball[ip-1];
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    for (i=0; i<4; i++)  par.ball[--par.hball[pt->v[i]]] = 4*k+i;
+  }
+
+  /* the initial values (tag 1) are frozen */
+  for (k=1; k<=mesh->np; k++) {
+    p0 = &mesh->point[k];
+    p0->flag = p0->tag == 1 ? -1 : 0;
+  }
+
+  if ( info.ncpu > 1 ) {
+    info.libpid = InitParallel(info.ncpu);
+    assert(info.libpid);
+    info.typ[1] = NewType(info.libpid,mesh->np);
+  }
+
+  /* main loop: stop when no value has decreased */
+  par.it = 1;
+  do {
+    memset(par.res,0,info.ncpu*sizeof(double));
+    if ( info.ncpu > 1 ) {
+      LaunchParallel(info.libpid,info.typ[1],0,(void *)fimval_3d,(void *)&par);
+      LaunchParallel(info.libpid,info.typ[1],0,(void *)fimupd_3d,(void *)&par);
+      for (i=1; i<info.ncpu; i++)  par.res[0] += par.res[i];
+    }
+    else {
+      fimval_3d(1,mesh->np,0,&par);
+      fimupd_3d(1,mesh->np,0,&par);
+    }
+    nup = (int)par.res[0];
+
+    fprintf(stdout,"     %8d  %8d\r",nup,par.it);  fflush(stdout);
+  }
+  while ( nup && ++par.it < info.maxit );
+  fprintf(stdout,"     %d passes\n",par.it);
+
+  if ( info.ncpu > 1 ) {
+    FreeType(info.libpid,info.typ[1]);
+    StopParallel(info.libpid);
+  }
+
+  free(par.hball);
+  free(par.ball);
+  free(par.res);
+  free(par.dtmp);
+
+  return(1);
+}
+
 /* compute new distance at points in // */
 static void tmpdist_3d(int istart,int istop,int ipth,Param *par) {
   pMesh     mesh;
@@ -28,9 +28,11 @@ static void usage(char *prog) {
   fprintf(stdout,"usage: %s [-v[n]] [-h] file1[.mesh] [file2[.mesh]] options\n",prog);
 
   fprintf(stdout,"\n** Generic options :\n");
+  fprintf(stdout,"-band w Redistance only in a band of width w (3d)\n");
   fprintf(stdout,"-d      Turn on debug mode\n");
   fprintf(stdout,"-h      Print this message\n");
   fprintf(stdout,"-dt     Time stepping (hmin)\n");
+  fprintf(stdout,"-fim    Propagate with the // fast iterative method (3d)\n");
   fprintf(stdout,"-it n   Max number of iterations\n");
   fprintf(stdout,"-ncpu n Use n CPUs\n");
   fprintf(stdout,"-r res  Residual\n");
@@ -103,6 +105,13 @@ static int parsar(int argc,char *argv[],pMesh mesh1,pSol sol1,pMesh mesh2) {
 		if ( !strcmp(argv[i],"-bbbc") ) {
 		  info.bbbc = 1;
 		}
+		else if ( !strcmp(argv[i],"-band") ) {
+		  ++i;
+		  if ( i < argc && isdigit(argv[i][0]) )
+			info.band = atof(argv[i]);
+		  else
+			--i;
+		}
 		break;
 
       case 'd':
@@ -131,6 +140,8 @@ static int parsar(int argc,char *argv[],pMesh mesh1,pSol sol1,pMesh mesh2) {
       case 'f':
         if ( !strcmp(argv[i],"-fmm") )
           info.fmm = 1;
+        else if ( !strcmp(argv[i],"-fim") )
+          info.fim = 1;
         break;
 
       /* Calculate Hausdorff distance */
@@ -434,6 +445,7 @@ int setfunc(int dim) {
 
     ppgdist = ppgdist_3d;
     ppgdistfmm = ppgdistfmm_3d;
+    ppgdistfim = ppgdistfim_3d;
   }
 
   return(1);
@@ -538,13 +550,18 @@ int mshdis1(pMesh mesh1,pMesh mesh2,pSol sol1) {
     return(0);
   }
 
-  /* Signed distance propagation */
-  if ( ier > 0 ) {
+  /* Signed distance propagation, useless in the narrow band (exact values) */
+  if ( ier > 0 && info.band > 0.0 ) {
+    if ( info.imprim )  fprintf(stdout,"  ** Narrow band: no propagation\n");
+  }
+  else if ( ier > 0 ) {
     chrono(ON,&info.ctim[4]);
     if ( info.imprim )  fprintf(stdout,"  ** Propagation [%d cpu]\n",info.ncpu);
     
     if ( info.fmm )
       ier = ppgdistfmm(mesh1,sol1);
+    else if ( info.fim )
+      ier = ppgdistfim(mesh1,sol1);
     else
       ier = ppgdist(mesh1,sol1);
     chrono(OFF,&info.ctim[4]);
@@ -609,6 +626,16 @@ int main(int argc,char **argv) {
 
   if ( !setfunc(mesh1.dim) )  return(1);
 
+  /* The narrow band is only available when redistancing in 3d */
+  if ( info.band > 0.0 && ( info.option != 2 || mesh1.dim != 3 ) ) {
+    fprintf(stdout,"  ## Option -band ignored (redistancing in 3d only)\n");
+    info.band = 0.0;
+  }
+  if ( info.fim && mesh1.dim != 3 ) {
+    fprintf(stdout,"  ## Option -fim ignored (3d only)\n");
+    info.fim = 0;
+  }
+
   chrono(OFF,&info.ctim[1]);
   if ( info.imprim )
     stats(&mesh1,&mesh2);
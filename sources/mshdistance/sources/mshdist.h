@@ -81,11 +81,11 @@ typedef Tetra * pTetra;
 
 typedef struct {
   double   delta1[3],delta2[3],min1[3],max1[3],min2[3],max2[3],cen1[3],cen2[3];
-  double   dt,ray,res,size,*exp;
+  double   dt,ray,res,size,band,*exp;
   int      ncpu,libpid,typ[2];          /* for // purposes */
   int      maxit,ref,nsref,*sref;
   int      nexp,nintel,*intel,nst,*st,nsa,*sa,nsp,*sp; /* for -dom option */
-  char     imprim,ddebug,option,bbbc,fmm,hausdorff,pcloud,specdist,startref,noscale;
+  char     imprim,ddebug,option,bbbc,fmm,fim,hausdorff,pcloud,specdist,startref,noscale;
   mytime   ctim[TIMEMAX];
 } Info;
 
@@ -111,10 +111,25 @@ typedef struct {
 } Sol;
 typedef Sol * pSol;
 
+/* bounding volume hierarchy of the elements crossed by the interface */
+typedef struct {
+  double   min[3],max[3];
+  int      ia,nb,left,right;
+} BvhNode;
+
+typedef struct {
+  BvhNode *node;
+  double  *circum;
+  int     *bndy,*item,nitem,nnode;
+} Bvh;
+typedef Bvh * pBvh;
+
 typedef struct {
 	pMesh    mesh;
 	pSol     sol;
+	pBvh     bvh;
 	double  *grad,*dtmp,*res,dt,dtfin;
+	int     *hball,*ball,it;
 } Param;
 
 typedef struct {
@@ -174,6 +189,10 @@ double distnv0_3d(pMesh,pSol,int,pPoint,char*);
 double distnv0approx_3d(pMesh,pSol,int,pPoint);
 int buildcircumredis_3d(pMesh,pSol,int*,int,double*);
 
+pBvh    newBvh_3d(int *,int ,double *);
+void    freeBvh(pBvh );
+int     nearelt_3d(pMesh ,pSol ,pBvh ,pPoint ,double *);
+
 pBucket newBucket_2d(pMesh ,int );
 pBucket newBucket_3d(pMesh ,int );
 int     buckin_2d(pMesh ,pBucket ,double *);
@@ -200,6 +219,7 @@ int     ppgdist_2d(pMesh mesh, pSol sol);
 int     ppgdist_3d(pMesh mesh, pSol sol);
 int     ppgdistfmm_2d(pMesh mesh, pSol sol);
 int     ppgdistfmm_3d(pMesh mesh, pSol sol);
+int     ppgdistfim_3d(pMesh mesh, pSol sol);
 int     iniencdomain_2d(pMesh mesh, pSol sol);
 int     iniencdomain_3d(pMesh mesh, pSol sol);
 int     inireftrias_2d(pMesh mesh, pSol sol);
@@ -266,5 +286,6 @@ int     (*inireftrias)(pMesh, pSol);
 int     (*sgndist)(pMesh ,pMesh ,pSol ,pBucket );
 int     (*ppgdist)(pMesh mesh, pSol sol);
 int     (*ppgdistfmm)(pMesh mesh, pSol sol);
+int     (*ppgdistfim)(pMesh mesh, pSol sol);
 
 #endif
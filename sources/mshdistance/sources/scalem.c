@@ -45,8 +45,9 @@ int scaleMesh(pMesh mesh1,pMesh mesh2,pSol sol1) {
   for (i=0; i<mesh1->dim; i++)
     info.delta1[i] =  (info.max1[i]-info.min1[i]);  /* Bug fix 27/12/2015: old dd* */
   
-  /* scale initial solution */
+  /* scale initial solution, and the width of the narrow band */
   if ( info.option == 2 ) {
+    info.band *= dd;
     for (k=1; k<=sol1->np; k++) {
 	    sol1->val[k] *= dd;
   	}